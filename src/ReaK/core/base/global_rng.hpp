@@ -45,14 +45,31 @@ typedef boost::random::mt19937 global_rng_type;
 
 /**
  * This function returns the global (static) instance of the random-number generator (seeded at first use).
+ * When the compiler supports thread-local storage, each thread gets its own instance (seeded at its first use),
+ * such that the random-number generation is safe to use from concurrent threads (e.g., parallel planners).
  * \return A reference to the global (static) instance of the random-number generator (seeded at first use).
  */
 inline global_rng_type& get_global_rng() {
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+  static thread_local global_rng_type instance = global_rng_type(boost::random::random_device()());
+#else
   static boost::random::random_device rd;
   static global_rng_type instance = global_rng_type(rd());
+#endif
   return instance;
 };
 
+/**
+ * This function re-seeds the global random-number generator of the calling thread (see get_global_rng).
+ * This is useful to give reproducible and independent random streams to tasks that may be executed
+ * on any thread (e.g., Monte-Carlo trials run on a thread-pool), by seeding at the start of each task.
+ * \note Without thread-local storage, the generator is shared by all threads, and re-seeding it is not thread-safe.
+ * \param aSeed The seed value to use.
+ */
+inline void seed_global_rng(global_rng_type::result_type aSeed) {
+  get_global_rng().seed(aSeed);
+};
+
 
 };
 
@@ -0,0 +1,409 @@
+/**
+ * \file memory_arena.hpp
+ *
+ * This library provides a simple memory arena (a chunked "bump" allocator) along with a
+ * scoped-reset mechanism (arena_scope) and a standard allocator class (arena_allocator) that
+ * draws its memory from the arena of the innermost active scope of the calling thread. The
+ * arena_allocator can be used as the Allocator parameter of any STL container, and of the
+ * ReaK::mat<> and ReaK::vect_n<> class templates, such that short-lived temporaries created
+ * within a scope do not require any heap allocation once the arena has grown to its working size.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MEMORY_ARENA_HPP
+#define REAK_MEMORY_ARENA_HPP
+
+#include "defs.hpp"
+
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace ReaK {
+
+
+/**
+ * This class implements a memory arena, i.e., a list of large memory blocks from which
+ * allocations are made by simply bumping an offset. Individual deallocations are no-ops,
+ * except for the most recent allocation, which is reclaimed (stack-like). The memory is
+ * reclaimed in bulk by rewinding the arena to a marker (see arena_scope), and the blocks
+ * are kept for later use, i.e., once the arena has grown to the size needed by a given
+ * computation, repeating that computation requires no additional heap allocation.
+ */
+class memory_arena {
+  public:
+    /**
+     * This POD-type records a position in the arena, to which it can be rewound.
+     */
+    struct marker {
+      std::size_t block_index;
+      std::size_t offset;
+    };
+
+  private:
+    struct block {
+      char* data;
+      std::size_t size;
+    };
+
+    std::vector<block> blocks;
+    std::size_t cur_block;
+    std::size_t cur_offset;
+    std::size_t min_block_size;
+
+    memory_arena(const memory_arena&);
+    memory_arena& operator=(const memory_arena&);
+
+    void release_blocks() {
+      for(std::size_t i = 0; i < blocks.size(); ++i)
+        ::operator delete(blocks[i].data);
+      blocks.clear();
+      cur_block = 0;
+      cur_offset = 0;
+    };
+
+    void add_block(std::size_t aSize) {
+      block b;
+      b.data = static_cast<char*>(::operator new(aSize));
+      b.size = aSize;
+      blocks.push_back(b);
+    };
+
+  public:
+
+    /**
+     * Default constructor.
+     * \param aMinBlockSize The minimum size (in bytes) of the blocks of memory requested from the heap.
+     */
+    explicit memory_arena(std::size_t aMinBlockSize = 65536) :
+                          blocks(), cur_block(0), cur_offset(0), min_block_size(aMinBlockSize) { };
+
+    /**
+     * Destructor, releases all the blocks of memory.
+     */
+    ~memory_arena() { release_blocks(); };
+
+    /**
+     * Allocates a chunk of memory from the arena.
+     * \param aSize The number of bytes to allocate.
+     * \param aAlign The alignment (in bytes, a power of two) required for the chunk of memory.
+     * \return A pointer to the allocated chunk of memory.
+     * \throw std::bad_alloc if a new block of memory could not be obtained.
+     */
+    void* allocate(std::size_t aSize, std::size_t aAlign = sizeof(void*)) {
+      while(true) {
+        if(cur_block < blocks.size()) {
+          std::size_t addr = reinterpret_cast<std::size_t>(blocks[cur_block].data + cur_offset);
+          std::size_t aligned_offset = cur_offset + ((aAlign - (addr & (aAlign - 1))) & (aAlign - 1));
+          if(aligned_offset + aSize <= blocks[cur_block].size) {
+            cur_offset = aligned_offset + aSize;
+            return blocks[cur_block].data + aligned_offset;
+          };
+          cur_offset = 0;
+          if(++cur_block < blocks.size())
+            continue;
+        };
+        // grow geometrically, such that the number of blocks remains small:
+        std::size_t new_size = get_capacity();
+        if(new_size < min_block_size)
+          new_size = min_block_size;
+        if(new_size < aSize + aAlign)
+          new_size = aSize + aAlign;
+        add_block(new_size);
+        cur_block = blocks.size() - 1;
+        cur_offset = 0;
+      };
+    };
+
+    /**
+     * Deallocates a chunk of memory from the arena. This is a no-op unless the chunk
+     * is the most recent allocation, in which case, its memory is reclaimed immediately.
+     * \param p The pointer to the chunk of memory.
+     * \param aSize The number of bytes of the chunk of memory.
+     */
+    void deallocate(void* p, std::size_t aSize) {
+      if(cur_block >= blocks.size())
+        return;
+      char* pc = static_cast<char*>(p);
+      if((pc + aSize == blocks[cur_block].data + cur_offset) && (pc >= blocks[cur_block].data))
+        cur_offset = pc - blocks[cur_block].data;
+    };
+
+    /**
+     * Checks if a pointer is within the blocks of memory of this arena.
+     * \param p The pointer to check.
+     * \return True if the pointer points to memory owned by this arena.
+     */
+    bool owns(const void* p) const {
+      const char* pc = static_cast<const char*>(p);
+      std::less<const char*> lt;
+      for(std::size_t i = 0; i < blocks.size(); ++i)
+        if(!lt(pc, blocks[i].data) && lt(pc, blocks[i].data + blocks[i].size))
+          return true;
+      return false;
+    };
+
+    /**
+     * Returns a marker for the current position of the arena.
+     * \return A marker for the current position of the arena.
+     */
+    marker get_marker() const {
+      marker m;
+      m.block_index = cur_block;
+      m.offset = cur_offset;
+      return m;
+    };
+
+    /**
+     * Rewinds the arena to a given marker, i.e., all the memory allocated since the marker
+     * was obtained is reclaimed.
+     * \param m The marker to which the arena should be rewound.
+     */
+    void rewind(const marker& m) {
+      cur_block = m.block_index;
+      cur_offset = m.offset;
+    };
+
+    /**
+     * Reclaims all the memory of the arena. If the arena has grown into more than one block,
+     * the blocks are merged into a single block (of the same total capacity), such that later
+     * uses of the arena are served by a single, contiguous block.
+     * \note All memory previously allocated from the arena must no longer be in use.
+     */
+    void reset() {
+      if(blocks.size() > 1) {
+        std::size_t total = get_capacity();
+        release_blocks();
+        add_block(total);
+      };
+      cur_block = 0;
+      cur_offset = 0;
+    };
+
+    /**
+     * Returns the total number of bytes held by the arena (used or not).
+     * \return The total number of bytes held by the arena.
+     */
+    std::size_t get_capacity() const {
+      std::size_t total = 0;
+      for(std::size_t i = 0; i < blocks.size(); ++i)
+        total += blocks[i].size;
+      return total;
+    };
+
+    /**
+     * Returns the number of bytes currently in use in the arena (including padding and abandoned block tails).
+     * \return The number of bytes currently in use in the arena.
+     */
+    std::size_t get_size() const {
+      std::size_t total = cur_offset;
+      for(std::size_t i = 0; (i < cur_block) && (i < blocks.size()); ++i)
+        total += blocks[i].size;
+      return total;
+    };
+
+};
+
+
+/**
+ * This function returns the memory arena of the calling thread (created at first use).
+ * Without thread-local storage, a single arena is shared by all threads, and using it
+ * from concurrent threads is not safe.
+ * \return A reference to the memory arena of the calling thread.
+ */
+inline memory_arena& get_thread_arena() {
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+  static thread_local memory_arena instance;
+#else
+  static memory_arena instance;
+#endif
+  return instance;
+};
+
+
+/**
+ * This class is a scope-guard that activates a memory arena for the arena_allocator's of
+ * the calling thread, and rewinds the arena to its original position upon destruction. Scopes
+ * can be nested, and the innermost scope is the one from which allocations are made. All the
+ * objects that use memory allocated within a scope must be destroyed before the end of that scope.
+ * \code
+ * {
+ *   arena_scope scope;  // activates the thread's arena.
+ *   arena_mat<double>::type M(N, N);
+ *   ...                 // temporaries with arena_allocator are drawn from the arena.
+ * }                     // the arena is rewound (and its blocks are kept for later use).
+ * \endcode
+ */
+class arena_scope {
+  private:
+    memory_arena* arena;
+    memory_arena::marker start;
+    arena_scope* enclosing;
+
+    static arena_scope*& get_active_ptr() {
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+      static thread_local arena_scope* active = NULL;
+#else
+      static arena_scope* active = NULL;
+#endif
+      return active;
+    };
+
+    arena_scope(const arena_scope&);
+    arena_scope& operator=(const arena_scope&);
+
+  public:
+
+    /**
+     * Activates the memory arena of the calling thread (see get_thread_arena()).
+     */
+    arena_scope() : arena(&get_thread_arena()), start(arena->get_marker()), enclosing(get_active_ptr()) {
+      get_active_ptr() = this;
+    };
+
+    /**
+     * Activates a given memory arena.
+     * \param aArena The memory arena to activate, must outlive this scope.
+     */
+    explicit arena_scope(memory_arena& aArena) : arena(&aArena), start(arena->get_marker()), enclosing(get_active_ptr()) {
+      get_active_ptr() = this;
+    };
+
+    /**
+     * Deactivates the memory arena and rewinds it to its position at the start of the scope.
+     */
+    ~arena_scope() {
+      get_active_ptr() = enclosing;
+      if((start.block_index == 0) && (start.offset == 0))
+        arena->reset();
+      else
+        arena->rewind(start);
+    };
+
+    /**
+     * Returns the memory arena activated by this scope.
+     * \return The memory arena activated by this scope.
+     */
+    memory_arena& get_arena() const { return *arena; };
+
+    /**
+     * Returns the scope enclosing this one (or NULL if none).
+     * \return The scope enclosing this one (or NULL if none).
+     */
+    arena_scope* get_enclosing_scope() const { return enclosing; };
+
+    /**
+     * Returns the innermost active scope of the calling thread (or NULL if none).
+     * \return The innermost active scope of the calling thread (or NULL if none).
+     */
+    static arena_scope* get_active_scope() { return get_active_ptr(); };
+
+};
+
+
+/**
+ * This class template is a standard allocator that draws its memory from the memory arena
+ * of the innermost active arena_scope of the calling thread, or from the heap (operator new)
+ * if no scope is active. It is stateless (all instances compare equal), and memory obtained
+ * from it is always returned to where it came from. This allocator can be used for the
+ * Allocator parameter of STL containers and of the ReaK::mat<> and ReaK::vect_n<> class templates
+ * (see arena_mat and arena_vect_n). Objects using this allocator must not outlive the scope in
+ * which their memory was allocated, nor be destroyed by another thread.
+ * \tparam T The value-type of the allocator.
+ */
+template <typename T>
+class arena_allocator {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+      typedef arena_allocator<U> other;
+    };
+
+    arena_allocator() throw() { };
+    template <typename U>
+    arena_allocator(const arena_allocator<U>&) throw() { };
+
+    pointer address(reference x) const { return &x; };
+    const_pointer address(const_reference x) const { return &x; };
+
+    /**
+     * Allocates memory for a number of objects, from the active arena if any, or from the heap.
+     * \param n The number of objects to allocate memory for.
+     * \return A pointer to the allocated memory.
+     */
+    pointer allocate(size_type n, const void* = NULL) {
+      arena_scope* s = arena_scope::get_active_scope();
+      if(s)
+        return static_cast<pointer>(s->get_arena().allocate(n * sizeof(T), boost::alignment_of<T>::value));
+      return static_cast<pointer>(::operator new(n * sizeof(T)));
+    };
+
+    /**
+     * Deallocates memory for a number of objects (returned to the arena that owns it, or to the heap).
+     * \param p The pointer to the memory to deallocate.
+     * \param n The number of objects for which the memory was allocated.
+     */
+    void deallocate(pointer p, size_type n) {
+      for(arena_scope* s = arena_scope::get_active_scope(); s; s = s->get_enclosing_scope()) {
+        if(s->get_arena().owns(p)) {
+          s->get_arena().deallocate(p, n * sizeof(T));
+          return;
+        };
+      };
+      ::operator delete(p);
+    };
+
+    size_type max_size() const throw() { return std::numeric_limits<size_type>::max() / sizeof(T); };
+
+    void construct(pointer p, const_reference val) { new(static_cast<void*>(p)) T(val); };
+    void destroy(pointer p) { p->~T(); };
+
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>&, const arena_allocator<U>&) throw() { return true; };
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>&, const arena_allocator<U>&) throw() { return false; };
+
+
+};
+
+#endif
+
@@ -0,0 +1,160 @@
+/**
+ * \file shared_mutex.hpp
+ *
+ * This library declares a reader-writer mutex (shared_mutex) built on top of the mutex and
+ * condition-variable imported in the ReaKaux namespace (see thread_incl.hpp), along with
+ * a scoped lock-guard for its shared (reader) ownership.
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_SHARED_MUTEX_HPP
+#define REAK_SHARED_MUTEX_HPP
+
+#include "defs.hpp"
+#include "thread_incl.hpp"
+
+namespace ReaK {
+
+
+/**
+ * This class implements a writer-preferring reader-writer mutex. Any number of readers can
+ * hold the shared ownership at the same time, while the exclusive ownership is only granted
+ * to one writer at a time, when no reader holds it. Once a writer is waiting, new readers
+ * are held back, such that writers cannot be starved by a continuous flow of readers.
+ * The exclusive ownership functions (lock / unlock) make this class usable with
+ * ReaKaux::unique_lock and ReaKaux::lock_guard, and the shared_lock_guard class template
+ * can be used for the shared ownership.
+ */
+class shared_mutex {
+  private:
+    ReaKaux::mutex m_mutex;
+    ReaKaux::condition_variable m_readers_gate;
+    ReaKaux::condition_variable m_writers_gate;
+    std::size_t m_active_readers;
+    std::size_t m_waiting_writers;
+    bool m_active_writer;
+
+    // non-copyable:
+    shared_mutex(const shared_mutex&);
+    shared_mutex& operator=(const shared_mutex&);
+
+  public:
+
+    shared_mutex() : m_active_readers(0), m_waiting_writers(0), m_active_writer(false) { };
+
+    /**
+     * Obtains the exclusive (writer) ownership, blocks until it is available.
+     */
+    void lock() {
+      ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+      ++m_waiting_writers;
+      while(m_active_writer || (m_active_readers != 0))
+        m_writers_gate.wait(lock_here);
+      --m_waiting_writers;
+      m_active_writer = true;
+    };
+
+    /**
+     * Attempts to obtain the exclusive (writer) ownership, without blocking.
+     * \return True if the exclusive ownership was obtained.
+     */
+    bool try_lock() {
+      ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+      if(m_active_writer || (m_active_readers != 0))
+        return false;
+      m_active_writer = true;
+      return true;
+    };
+
+    /**
+     * Releases the exclusive (writer) ownership.
+     */
+    void unlock() {
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        m_active_writer = false;
+      };
+      m_writers_gate.notify_one();
+      m_readers_gate.notify_all();
+    };
+
+    /**
+     * Obtains a shared (reader) ownership, blocks until it is available.
+     */
+    void lock_shared() {
+      ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+      while(m_active_writer || (m_waiting_writers != 0))
+        m_readers_gate.wait(lock_here);
+      ++m_active_readers;
+    };
+
+    /**
+     * Releases a shared (reader) ownership.
+     */
+    void unlock_shared() {
+      bool last_reader = false;
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        last_reader = (--m_active_readers == 0);
+      };
+      if(last_reader)
+        m_writers_gate.notify_one();
+    };
+
+};
+
+
+/**
+ * This class template is a scoped lock-guard that holds the shared (reader) ownership
+ * of a reader-writer mutex (such as shared_mutex) for the duration of its lifetime.
+ * \tparam SharedMutex The reader-writer mutex type, should have lock_shared / unlock_shared functions.
+ */
+template <typename SharedMutex>
+class shared_lock_guard {
+  private:
+    SharedMutex* p_mutex;
+
+    // non-copyable:
+    shared_lock_guard(const shared_lock_guard<SharedMutex>&);
+    shared_lock_guard<SharedMutex>& operator=(const shared_lock_guard<SharedMutex>&);
+
+  public:
+
+    explicit shared_lock_guard(SharedMutex& aMutex) : p_mutex(&aMutex) {
+      p_mutex->lock_shared();
+    };
+
+    ~shared_lock_guard() {
+      p_mutex->unlock_shared();
+    };
+};
+
+
+};
+
+#endif
+
@@ -0,0 +1,211 @@
+/**
+ * \file task_graph.hpp
+ *
+ * This library declares a simple directed acyclic graph of tasks (with dependencies between
+ * them) that can be executed on a thread_pool, such that each task is scheduled as soon as all
+ * the tasks it depends on have been completed. This is useful for tiled (blocked) numerical
+ * algorithms whose tile-operations form a dependency graph rather than a sequence of
+ * independent batches.
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_TASK_GRAPH_HPP
+#define REAK_TASK_GRAPH_HPP
+
+#include "thread_pool.hpp"
+
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+namespace ReaK {
+
+
+/**
+ * This class implements a directed acyclic graph of tasks. Tasks are added one after the other,
+ * and a dependency can only be added from an earlier task to a later one, such that the insertion
+ * order is always a valid (topological) execution order and the graph cannot contain cycles.
+ * The graph can be executed sequentially (in insertion order) or on a thread_pool, in which case
+ * a task is scheduled on the pool as soon as all its predecessors have been completed.
+ * If a task throws an exception, the remaining tasks are skipped (but still accounted for) and the
+ * first such exception is re-thrown by the executing function once all the scheduled tasks are done.
+ */
+class task_graph {
+  public:
+    typedef thread_pool::task_type task_type;
+    typedef std::size_t task_id;
+
+  private:
+    struct task_node {
+      task_type task;
+      std::vector< task_id > successors;
+      std::size_t predecessor_count;
+
+      explicit task_node(const task_type& aTask) : task(aTask), predecessor_count(0) { };
+    };
+
+    std::vector< task_node > m_nodes;
+
+    /* Book-keeping shared by the tasks of a single execution of the graph. */
+    struct run_state {
+      ReaKaux::mutex m_mutex;
+      ReaKaux::condition_variable m_done;
+      std::vector< task_node >* p_nodes;
+      thread_pool* p_pool;
+      std::vector< std::size_t > m_waiting_on;  ///< Number of uncompleted predecessors of each task.
+      std::size_t m_remaining;
+      std::exception_ptr m_first_error;
+
+      run_state(std::vector< task_node >& aNodes, thread_pool& aPool) :
+                p_nodes(&aNodes), p_pool(&aPool), m_waiting_on(aNodes.size()), m_remaining(aNodes.size()) {
+        for(std::size_t i = 0; i < aNodes.size(); ++i)
+          m_waiting_on[i] = aNodes[i].predecessor_count;
+      };
+
+      void wait() {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        while(m_remaining != 0)
+          m_done.wait(lock_here);
+        if(m_first_error)
+          std::rethrow_exception(m_first_error);
+      };
+    };
+
+    struct run_task {
+      run_state* p_state;
+      task_id id;
+
+      run_task(run_state* aState, task_id aId) : p_state(aState), id(aId) { };
+
+      void operator()() const {
+        task_node& node = (*p_state->p_nodes)[id];
+        bool skip_task = false;
+        {
+          ReaKaux::unique_lock< ReaKaux::mutex > lock_here(p_state->m_mutex);
+          skip_task = bool(p_state->m_first_error);
+        };
+        std::exception_ptr cur_error;
+        if(!skip_task) {
+          try {
+            node.task();
+          } catch(...) {
+            cur_error = std::current_exception();
+          };
+        };
+        std::vector< task_id > ready;
+        {
+          ReaKaux::unique_lock< ReaKaux::mutex > lock_here(p_state->m_mutex);
+          if(cur_error && !p_state->m_first_error)
+            p_state->m_first_error = cur_error;
+          for(std::size_t i = 0; i < node.successors.size(); ++i)
+            if(--(p_state->m_waiting_on[node.successors[i]]) == 0)
+              ready.push_back(node.successors[i]);
+          if(--(p_state->m_remaining) == 0)
+            p_state->m_done.notify_all();
+        };
+        // the ready tasks are not completed yet, so the state (on the waiter's stack) is still alive.
+        for(std::size_t i = 0; i < ready.size(); ++i)
+          p_state->p_pool->schedule(run_task(p_state, ready[i]));
+      };
+    };
+
+  public:
+
+    /**
+     * Default constructor, creates an empty graph.
+     */
+    task_graph() { };
+
+    /**
+     * Returns the number of tasks in the graph.
+     * \return The number of tasks in the graph.
+     */
+    std::size_t size() const { return m_nodes.size(); };
+
+    /**
+     * Removes all the tasks from the graph.
+     */
+    void clear() { m_nodes.clear(); };
+
+    /**
+     * Adds a task to the graph.
+     * \param aTask The task to be added.
+     * \return The identifier of the new task, to be used to add dependencies.
+     */
+    task_id add_task(const task_type& aTask) {
+      m_nodes.push_back(task_node(aTask));
+      return m_nodes.size() - 1;
+    };
+
+    /**
+     * Adds a dependency between two tasks, such that aAfter cannot start before aBefore is completed.
+     * \param aBefore The task that must be completed first.
+     * \param aAfter The task that depends on aBefore, which must have been added after aBefore.
+     * \throw std::invalid_argument if aBefore was not added before aAfter, or if either is not in the graph.
+     */
+    void add_dependency(task_id aBefore, task_id aAfter) {
+      if((aBefore >= aAfter) || (aAfter >= m_nodes.size()))
+        throw std::invalid_argument("A task can only depend on a task that was added before it!");
+      m_nodes[aBefore].successors.push_back(aAfter);
+      ++(m_nodes[aAfter].predecessor_count);
+    };
+
+    /**
+     * Executes all the tasks of the graph sequentially, in the order in which they were added.
+     * If a task throws an exception, the remaining tasks are not executed and the exception propagates.
+     */
+    void run() {
+      for(std::size_t i = 0; i < m_nodes.size(); ++i)
+        m_nodes[i].task();
+    };
+
+    /**
+     * Executes all the tasks of the graph on a thread-pool, respecting the dependencies, and waits for
+     * their completion. If any task threw an exception, the first such exception is re-thrown by this function.
+     * \note Like the other waiting functions of thread_pool, this must not be called from within a task
+     *       running on the same pool.
+     * \param aPool The thread-pool on which to execute the tasks.
+     */
+    void run(thread_pool& aPool) {
+      if(m_nodes.empty())
+        return;
+      run_state state(m_nodes, aPool);
+      std::vector< task_id > roots;
+      for(std::size_t i = 0; i < m_nodes.size(); ++i)
+        if(m_nodes[i].predecessor_count == 0)
+          roots.push_back(i);
+      for(std::size_t i = 0; i < roots.size(); ++i)
+        aPool.schedule(run_task(&state, roots[i]));
+      state.wait();
+    };
+
+};
+
+
+};
+
+#endif
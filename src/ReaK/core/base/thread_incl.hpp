@@ -55,6 +55,7 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 
 
 namespace ReaKaux {
@@ -107,6 +108,19 @@ namespace ReaKaux {
 
   //using std::notify_all_at_thread_exit;
 
+  // atomic:
+
+  using std::atomic;
+
+  using std::memory_order;
+  using std::memory_order_relaxed;
+  using std::memory_order_acquire;
+  using std::memory_order_release;
+  using std::memory_order_acq_rel;
+  using std::memory_order_seq_cst;
+
+  using std::atomic_thread_fence;
+
 
 };
 
@@ -120,6 +134,7 @@ namespace ReaKaux {
 #include <boost/thread/once.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/version.hpp>
+#include <boost/atomic.hpp>
 
 
 namespace ReaKaux {
@@ -174,6 +189,19 @@ namespace ReaKaux {
 
   //using boost::notify_all_at_thread_exit;
 
+  // atomic:
+
+  using boost::atomic;
+
+  using boost::memory_order;
+  using boost::memory_order_relaxed;
+  using boost::memory_order_acquire;
+  using boost::memory_order_release;
+  using boost::memory_order_acq_rel;
+  using boost::memory_order_seq_cst;
+
+  using boost::atomic_thread_fence;
+
 };
 
 #endif
@@ -0,0 +1,276 @@
+/**
+ * \file thread_pool.hpp
+ *
+ * This library declares a simple fixed-size pool of worker threads to which tasks can be
+ * submitted, as well as a block-partitioning utility to split an index range over the
+ * workers of the pool (e.g., to run a batch of independent queries concurrently, with
+ * one set of scratch buffers per block).
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_THREAD_POOL_HPP
+#define REAK_THREAD_POOL_HPP
+
+#include "defs.hpp"
+#include "thread_incl.hpp"
+
+#include <vector>
+#include <queue>
+#include <exception>
+
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+#include <functional>
+#else
+#include <boost/function.hpp>
+#endif
+
+namespace ReaK {
+
+
+/**
+ * This class implements a fixed-size pool of worker threads that execute the tasks
+ * that are scheduled on it, in FIFO order. Exceptions thrown by the tasks are captured
+ * and re-thrown (only the first one) by the thread that waits for the completion of
+ * the tasks. The pool is non-copyable, and joins all its workers upon destruction
+ * (after the remaining scheduled tasks are completed).
+ * \note The waiting functions (wait, for_each_block) must not be called from within a
+ *       task running on the same pool, as this could deadlock the pool.
+ */
+class thread_pool {
+  public:
+#ifndef BOOST_NO_CXX11_HDR_FUNCTIONAL
+    typedef std::function< void() > task_type;
+#else
+    typedef boost::function< void() > task_type;
+#endif
+
+  private:
+    std::vector< shared_ptr< ReaKaux::thread > > m_workers;
+    std::queue< task_type > m_tasks;
+    std::size_t m_pending;  ///< Number of tasks that are queued or currently running.
+    bool m_stopping;
+    std::exception_ptr m_first_error;
+
+    ReaKaux::mutex m_mutex;
+    ReaKaux::condition_variable m_task_available;
+    ReaKaux::condition_variable m_all_done;
+
+    // non-copyable:
+    thread_pool(const thread_pool&);
+    thread_pool& operator=(const thread_pool&);
+
+    void worker_loop() {
+      while(true) {
+        task_type cur_task;
+        {
+          ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+          while(!m_stopping && m_tasks.empty())
+            m_task_available.wait(lock_here);
+          if(m_tasks.empty())
+            return;  // m_stopping is set and no more work remains.
+          cur_task = m_tasks.front();
+          m_tasks.pop();
+        };
+        std::exception_ptr cur_error;
+        try {
+          cur_task();
+        } catch(...) {
+          cur_error = std::current_exception();
+        };
+        {
+          ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+          if(cur_error && !m_first_error)
+            m_first_error = cur_error;
+          if(--m_pending == 0)
+            m_all_done.notify_all();
+        };
+      };
+    };
+
+    /* Completion latch shared by the blocks of a single for_each_block call. */
+    struct block_latch {
+      ReaKaux::mutex m_mutex;
+      ReaKaux::condition_variable m_done;
+      std::size_t m_remaining;
+      std::exception_ptr m_first_error;
+
+      explicit block_latch(std::size_t aCount) : m_remaining(aCount) { };
+
+      void count_down(std::exception_ptr aError) {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        if(aError && !m_first_error)
+          m_first_error = aError;
+        if(--m_remaining == 0)
+          m_done.notify_all();
+      };
+
+      void wait() {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        while(m_remaining != 0)
+          m_done.wait(lock_here);
+        if(m_first_error)
+          std::rethrow_exception(m_first_error);
+      };
+    };
+
+    /* Task of a single block, which holds its own copy of the block function. */
+    template <typename BlockFunction>
+    struct block_task {
+      mutable BlockFunction func;
+      block_latch* p_latch;
+      std::size_t block_id;
+      std::size_t first;
+      std::size_t last;
+
+      block_task(const BlockFunction& aFunc, block_latch* aLatch, std::size_t aBlockId, std::size_t aFirst, std::size_t aLast) :
+                 func(aFunc), p_latch(aLatch), block_id(aBlockId), first(aFirst), last(aLast) { };
+
+      void operator()() const {
+        std::exception_ptr cur_error;
+        try {
+          func(block_id, first, last);
+        } catch(...) {
+          cur_error = std::current_exception();
+        };
+        p_latch->count_down(cur_error);
+      };
+    };
+
+  public:
+
+    /**
+     * Constructs a pool with a given number of worker threads.
+     * \param aThreadCount The number of worker threads, if 0, the number of hardware threads is used.
+     */
+    explicit thread_pool(std::size_t aThreadCount = 0) : m_pending(0), m_stopping(false) {
+      if(aThreadCount == 0)
+        aThreadCount = ReaKaux::thread::hardware_concurrency();
+      if(aThreadCount == 0)
+        aThreadCount = 1;
+      m_workers.reserve(aThreadCount);
+      for(std::size_t i = 0; i < aThreadCount; ++i)
+        m_workers.push_back(shared_ptr< ReaKaux::thread >(new ReaKaux::thread(&thread_pool::worker_loop, this)));
+    };
+
+    /**
+     * Destructor, completes the remaining tasks and joins all the worker threads.
+     */
+    ~thread_pool() {
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        m_stopping = true;
+      };
+      m_task_available.notify_all();
+      for(std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->join();
+    };
+
+    /**
+     * Returns the number of worker threads in the pool.
+     * \return The number of worker threads in the pool.
+     */
+    std::size_t size() const { return m_workers.size(); };
+
+    /**
+     * Schedules a task to be executed by one of the worker threads.
+     * \param aTask The task to be executed.
+     */
+    void schedule(const task_type& aTask) {
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        m_tasks.push(aTask);
+        ++m_pending;
+      };
+      m_task_available.notify_one();
+    };
+
+    /**
+     * Waits until all the scheduled tasks have been completed. If any of the tasks
+     * threw an exception, the first such exception is re-thrown by this function.
+     */
+    void wait() {
+      std::exception_ptr cur_error;
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_mutex);
+        while(m_pending != 0)
+          m_all_done.wait(lock_here);
+        cur_error = m_first_error;
+        m_first_error = std::exception_ptr();
+      };
+      if(cur_error)
+        std::rethrow_exception(cur_error);
+    };
+
+    /**
+     * Returns the number of blocks into which a range of a given size would be partitioned
+     * by the for_each_block function. This can be used to allocate per-block scratch buffers.
+     * \param aCount The number of elements in the range.
+     * \return The number of blocks into which the range would be partitioned.
+     */
+    std::size_t block_count(std::size_t aCount) const {
+      return (aCount < m_workers.size() ? aCount : m_workers.size());
+    };
+
+    /**
+     * Partitions the index range [0, aCount) into contiguous blocks (at most one per worker
+     * thread) and executes the given function on each block, concurrently, and then waits
+     * for all the blocks to be completed. The partitioning only depends on the range size
+     * and the pool size, so that per-block results can be merged deterministically.
+     * If a block throws an exception, the first such exception is re-thrown by this function.
+     * Each block is executed on its own copy of the function, so that functors with internal state
+     * (e.g., scratch buffers) are never shared between threads, and so, the results of the blocks
+     * must be written through pointers or references held by the function.
+     * \tparam BlockFunction A copyable callable type with signature void(std::size_t block_id, std::size_t first, std::size_t last).
+     * \param aCount The number of elements in the range.
+     * \param aFunc The function to call for each block.
+     */
+    template <typename BlockFunction>
+    void for_each_block(std::size_t aCount, BlockFunction aFunc) {
+      std::size_t blocks = block_count(aCount);
+      if(blocks == 0)
+        return;
+      if(blocks == 1) {
+        aFunc(std::size_t(0), std::size_t(0), aCount);
+        return;
+      };
+      block_latch latch(blocks);
+      std::size_t first = 0;
+      for(std::size_t i = 0; i < blocks; ++i) {
+        std::size_t last = first + (aCount - first) / (blocks - i);
+        schedule(block_task<BlockFunction>(aFunc, &latch, i, first, last));
+        first = last;
+      };
+      latch.wait();
+    };
+
+};
+
+
+};
+
+#endif
+
@@ -35,6 +35,7 @@
 #include "rotations_2D.hpp"
 
 #include <ReaK/core/base/shared_object.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
 
 
 namespace ReaK {
@@ -64,10 +65,96 @@ class pose_2D : public shared_object {
     position_type Position; ///< Position vector of the pose.
     rotation_type Rotation; ///< Rotation matrix of the coordinate axes.
 
+  private:
+
+    /*
+     * Cache of the global pose, with the same validation scheme as for pose_3D (local pose and generation
+     * of the parent's global pose, generations shared by all poses, an odd generation while the cache
+     * is being written, and cached values stored as relaxed atomics: position, then rotation). As for 
+     * pose_3D, a query still walks up the parent chain to validate the cache.
+     */
+    mutable ReaKaux::atomic< std::size_t > mCacheGeneration;
+    mutable ReaKaux::atomic< T > mCachedLocal[4];
+    mutable ReaKaux::atomic< std::size_t > mCachedParentGeneration;
+    mutable ReaKaux::atomic< T > mCachedGlobal[4];
+
+    static std::size_t getNextGeneration() {
+      static ReaKaux::atomic< std::size_t > next_generation(0);
+      return 2 * (next_generation.fetch_add(1, ReaKaux::memory_order_relaxed) + 1);
+    };
+
+    static void storeTransform(ReaKaux::atomic< T >* aDest, const position_type& aPosition, const rotation_type& aRotation) {
+      aDest[0].store(aPosition[0], ReaKaux::memory_order_relaxed);
+      aDest[1].store(aPosition[1], ReaKaux::memory_order_relaxed);
+      aDest[2].store(aRotation[0], ReaKaux::memory_order_relaxed);
+      aDest[3].store(aRotation[1], ReaKaux::memory_order_relaxed);
+    };
+
+    static void loadTransform(const ReaKaux::atomic< T >* aSrc, T* aDest) {
+      for(std::size_t i = 0; i < 4; ++i)
+        aDest[i] = aSrc[i].load(ReaKaux::memory_order_relaxed);
+    };
+
+    bool isLocalPose(const T* aValues) const {
+      return (Position[0] == aValues[0]) && (Position[1] == aValues[1]) &&
+             (Rotation[0] == aValues[2]) && (Rotation[1] == aValues[3]);
+    };
+
+    /*
+     * Computes the global transform of this pose, from the cache if it is still valid, and returns the
+     * generation of the cache (or zero if the result could not be cached).
+     */
+    std::size_t getCachedGlobalTransform(position_type& aPosition, rotation_type& aRotation) const {
+      shared_ptr< self > parent = Parent.lock();
+      position_type parent_pos;
+      rotation_type parent_rot;
+      std::size_t parent_gen = 0;
+      if(parent)
+        parent_gen = parent->getCachedGlobalTransform(parent_pos, parent_rot);
+
+      std::size_t gen = mCacheGeneration.load(ReaKaux::memory_order_acquire);
+      if(gen && !(gen & 1) && (!parent || parent_gen)) {
+        T cached_local[4];
+        T cached_global[4];
+        loadTransform(mCachedLocal, cached_local);
+        std::size_t cached_parent_gen = mCachedParentGeneration.load(ReaKaux::memory_order_relaxed);
+        loadTransform(mCachedGlobal, cached_global);
+        ReaKaux::atomic_thread_fence(ReaKaux::memory_order_acquire);
+        if((mCacheGeneration.load(ReaKaux::memory_order_relaxed) == gen) && 
+           (cached_parent_gen == parent_gen) && isLocalPose(cached_local)) {
+          aPosition = position_type(cached_global[0], cached_global[1]);
+          aRotation = rotation_type(cached_global[2], cached_global[3]);
+          return gen;
+        };
+      };
+
+      if(parent) {
+        aPosition = parent_pos + parent_rot * Position;
+        aRotation = parent_rot;
+        aRotation *= Rotation;
+      } else {
+        aPosition = Position;
+        aRotation = Rotation;
+      };
+      if((parent && !parent_gen) || (gen & 1) || 
+         !mCacheGeneration.compare_exchange_strong(gen, gen + 1, ReaKaux::memory_order_acquire))
+        return 0;
+      ReaKaux::atomic_thread_fence(ReaKaux::memory_order_release);
+      storeTransform(mCachedLocal, Position, Rotation);
+      mCachedParentGeneration.store(parent_gen, ReaKaux::memory_order_relaxed);
+      storeTransform(mCachedGlobal, aPosition, aRotation);
+      std::size_t new_gen = getNextGeneration();
+      mCacheGeneration.store(new_gen, ReaKaux::memory_order_release);
+      return new_gen;
+    };
+
+  public:
+
     /**
      * Default constructor, all is set to zero.
      */
-    pose_2D() : shared_object(), Parent(), Position(), Rotation() { };
+    pose_2D() : shared_object(), Parent(), Position(), Rotation(),
+                mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
      * Parametrized constructor, all is set to corresponding parameters.
@@ -76,15 +163,17 @@ class pose_2D : public shared_object {
                 shared_object(),
                 Parent(aParent),
                 Position(aPosition),
-                Rotation(aRotation) { };
+                Rotation(aRotation),
+                mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
-     * Copy-constructor.
+     * Copy-constructor (the cached global pose is not copied).
      */
     pose_2D(const self& aPose) : shared_object(),
                                           Parent(aPose.Parent),
                                           Position(aPose.Position),
-                                          Rotation(aPose.Rotation) { };
+                                          Rotation(aPose.Rotation),
+                                          mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
      * Default destructor.
@@ -93,16 +182,13 @@ class pose_2D : public shared_object {
 
 
     /**
-     * Returns this 2D pose relative to the global (null) coordinate system.
+     * Returns this 2D pose relative to the global (null) coordinate system. The global pose is cached 
+     * (see pose_3D::getGlobalPose()).
      */
     self getGlobalPose() const {
-      if(!Parent.expired()) {
-        self result = Parent.lock()->getGlobalPose();
-        result.Position += result.Rotation * Position;
-        result.Rotation *= Rotation;
-        return result;
-      } else
-        return *this;
+      self result;
+      getCachedGlobalTransform(result.Position, result.Rotation);
+      return result;
     };
 
     /**
@@ -137,10 +223,8 @@ class pose_2D : public shared_object {
           return Parent.lock()->getPoseRelativeTo(P) * (*this);
       } else if(P->isParentPose( rtti::rk_static_ptr_cast< const self >(mThis)))
         return ~(P->getPoseRelativeTo( rtti::rk_static_ptr_cast< const self >(mThis)));
-      else if(Parent.expired())
-        return (~(P->getGlobalPose())) * (*this);
       else
-        return Parent.lock()->getPoseRelativeTo(P) * (*this);
+        return (~(P->getGlobalPose())) * getGlobalPose();
     };
 
     /**
@@ -154,7 +238,9 @@ class pose_2D : public shared_object {
      * Returns the free vector V (expressed in this coordinate system) expressed in the global coordinate system.
      */
     vector_type rotateToGlobal(const vector_type& V) const {
-      return getGlobalPose().Rotation * V;
+      position_type p; rotation_type r;
+      getCachedGlobalTransform(p, r);
+      return r * V;
     };
 
     /**
@@ -168,7 +254,9 @@ class pose_2D : public shared_object {
      * Returns the free vector V (expressed in the global coordinate system) expressed in this coordinate system.
      */
     vector_type rotateFromGlobal(const vector_type& V) const {
-      return V * getGlobalPose().Rotation; // getGlobalPose().Rotation.invert() * V;
+      position_type p; rotation_type r;
+      getCachedGlobalTransform(p, r);
+      return V * r; // r.invert() * V;
     };
 
     /**
@@ -182,7 +270,9 @@ class pose_2D : public shared_object {
      * Returns the position vector V (expressed in this coordinate system) expressed in the global coordinate system.
      */
     position_type transformToGlobal(const position_type& V) const {
-      return getGlobalPose().transformToParent(V);
+      position_type p; rotation_type r;
+      getCachedGlobalTransform(p, r);
+      return p + r * V;
     };
 
     /**
@@ -196,7 +286,9 @@ class pose_2D : public shared_object {
      * Returns the position vector V (expressed in the global coordinate system) expressed in this coordinate system.
      */
     position_type transformFromGlobal(const position_type& V) const {
-      return getGlobalPose().transformFromParent(V);
+      position_type p; rotation_type r;
+      getCachedGlobalTransform(p, r);
+      return (V - p) * r;
     };
 
     /**
@@ -35,6 +35,7 @@
 #include "rotations_3D.hpp"
 
 #include <ReaK/core/base/shared_object.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
 
 
 namespace ReaK {
@@ -64,6 +65,98 @@ class pose_3D : public shared_object {
     position_type Position; ///< Position vector of this coordinate system, expressed in parent coordinates.
     rotation_type Quat; ///< Rotation quaternion of this coordinate system, expressed in this coordinates (local).
 
+  private:
+
+    /*
+     * Cache of the global pose. It is valid as long as the local pose is the one it was computed from, and
+     * the global pose of the parent has the same generation as it had then. The generations are drawn from
+     * a counter shared by all the poses, such that the generation of the parent also identifies the parent
+     * (a re-parented pose, or a new parent at the address of a destroyed one, never matches the cache).
+     * The generation is even (and non-zero) when the cache is valid, and odd while it is being written (as a
+     * sequence lock, so that concurrent queries remain safe, they only use the values read between two
+     * equal loads of the generation, and skip the cache while it is written). The cached values are stored
+     * as relaxed atomics (position, then quaternion), such that reading them while they are written is not a data race.
+     * NOTE: A query still locks every parent of the chain and validates its cache, because the local poses 
+     *       (Position, Quat, Parent) are public members that can be changed without notice. The cache saves 
+     *       the compositions of the poses, not the walk up the chain.
+     */
+    mutable ReaKaux::atomic< std::size_t > mCacheGeneration;
+    mutable ReaKaux::atomic< T > mCachedLocal[7];
+    mutable ReaKaux::atomic< std::size_t > mCachedParentGeneration;
+    mutable ReaKaux::atomic< T > mCachedGlobal[7];
+
+    static std::size_t getNextGeneration() {
+      static ReaKaux::atomic< std::size_t > next_generation(0);
+      return 2 * (next_generation.fetch_add(1, ReaKaux::memory_order_relaxed) + 1);
+    };
+
+    static void storeTransform(ReaKaux::atomic< T >* aDest, const position_type& aPosition, const rotation_type& aQuat) {
+      for(std::size_t i = 0; i < 3; ++i)
+        aDest[i].store(aPosition[i], ReaKaux::memory_order_relaxed);
+      for(std::size_t i = 0; i < 4; ++i)
+        aDest[i + 3].store(aQuat[i], ReaKaux::memory_order_relaxed);
+    };
+
+    static void loadTransform(const ReaKaux::atomic< T >* aSrc, T* aDest) {
+      for(std::size_t i = 0; i < 7; ++i)
+        aDest[i] = aSrc[i].load(ReaKaux::memory_order_relaxed);
+    };
+
+    bool isLocalPose(const T* aValues) const {
+      return (Position[0] == aValues[0]) && (Position[1] == aValues[1]) && (Position[2] == aValues[2]) &&
+             (Quat[0] == aValues[3]) && (Quat[1] == aValues[4]) && (Quat[2] == aValues[5]) && (Quat[3] == aValues[6]);
+    };
+
+    /*
+     * Computes the global transform of this pose, from the cache if it is still valid, and returns the
+     * generation of the cache (or zero if the result could not be cached).
+     */
+    std::size_t getCachedGlobalTransform(position_type& aPosition, rotation_type& aQuat) const {
+      shared_ptr< self > parent = Parent.lock();
+      position_type parent_pos;
+      rotation_type parent_quat;
+      std::size_t parent_gen = 0;
+      if(parent)
+        parent_gen = parent->getCachedGlobalTransform(parent_pos, parent_quat);
+
+      std::size_t gen = mCacheGeneration.load(ReaKaux::memory_order_acquire);
+      if(gen && !(gen & 1) && (!parent || parent_gen)) {
+        T cached_local[7];
+        T cached_global[7];
+        loadTransform(mCachedLocal, cached_local);
+        std::size_t cached_parent_gen = mCachedParentGeneration.load(ReaKaux::memory_order_relaxed);
+        loadTransform(mCachedGlobal, cached_global);
+        ReaKaux::atomic_thread_fence(ReaKaux::memory_order_acquire);
+        if((mCacheGeneration.load(ReaKaux::memory_order_relaxed) == gen) && 
+           (cached_parent_gen == parent_gen) && isLocalPose(cached_local)) {
+          aPosition = position_type(cached_global[0], cached_global[1], cached_global[2]);
+          aQuat = rotation_type(cached_global[3], cached_global[4], cached_global[5], cached_global[6]);
+          return gen;
+        };
+      };
+
+      if(parent) {
+        aPosition = parent_pos + parent_quat * Position;
+        aQuat = parent_quat * Quat;
+      } else {
+        aPosition = Position;
+        aQuat = Quat;
+      };
+      // the cache is not updated if the parent's result is not cached, or if another thread is updating it.
+      if((parent && !parent_gen) || (gen & 1) || 
+         !mCacheGeneration.compare_exchange_strong(gen, gen + 1, ReaKaux::memory_order_acquire))
+        return 0;
+      // the odd generation must be visible before any of the cached values is overwritten.
+      ReaKaux::atomic_thread_fence(ReaKaux::memory_order_release);
+      storeTransform(mCachedLocal, Position, Quat);
+      mCachedParentGeneration.store(parent_gen, ReaKaux::memory_order_relaxed);
+      storeTransform(mCachedGlobal, aPosition, aQuat);
+      std::size_t new_gen = getNextGeneration();
+      mCacheGeneration.store(new_gen, ReaKaux::memory_order_release);
+      return new_gen;
+    };
+
+  public:
 
     /**
      * Default constructor, all is set to zero.
@@ -71,7 +164,8 @@ class pose_3D : public shared_object {
     pose_3D() : shared_object(),
                 Parent(),
                 Position(),
-                Quat() { };
+                Quat(),
+                mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
      * Parametrized constructor, all is set to corresponding parameters.
@@ -80,15 +174,17 @@ class pose_3D : public shared_object {
                shared_object(),
                Parent(aParent),
                Position(aPosition),
-               Quat(aQuat) { };
+               Quat(aQuat),
+               mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
-     * Copy-constructor.
+     * Copy-constructor (the cached global pose is not copied).
      */
     pose_3D(const self& aPose) : shared_object(),
                                        Parent(aPose.Parent),
                                        Position(aPose.Position),
-                                       Quat(aPose.Quat) { };
+                                       Quat(aPose.Quat),
+                                       mCacheGeneration(0), mCachedParentGeneration(0) { };
 
     /**
      * Default virtual destructor.
@@ -97,16 +193,16 @@ class pose_3D : public shared_object {
 
 
     /**
-     * Returns this 2D pose relative to the global (null) coordinate system.
+     * Returns this 3D pose relative to the global (null) coordinate system. The global pose is cached, 
+     * such that it is only re-computed when this pose, or a pose on its parent chain, has changed since the 
+     * last call (which is detected from the generations of the cached global poses, without composing the poses). 
+     * The parent chain is still walked (and each parent locked) to validate the cache.
+     * \note Concurrent calls are safe, as long as the poses of the chain are not modified (or re-parented) meanwhile.
      */
     self getGlobalPose() const {
-      if(!Parent.expired()) {
-        self result = Parent.lock()->getGlobalPose();
-        result.Position += result.Quat * Position;
-        result.Quat *= Quat;
-        return result;
-      } else
-        return *this;
+      self result;
+      getCachedGlobalTransform(result.Position, result.Quat);
+      return result;
     };
 
     /**
@@ -135,10 +231,8 @@ class pose_3D : public shared_object {
           return Parent.lock()->getPoseRelativeTo(P) * (*this);
       } else if(P->isParentPose(rtti::rk_static_ptr_cast< const self >(mThis)))
         return ~(P->getPoseRelativeTo(rtti::rk_static_ptr_cast< const self >(mThis)));
-      else if(Parent.expired())
-        return (~(P->getGlobalPose())) * (*this);
       else
-        return Parent.lock()->getPoseRelativeTo(P) * (*this);
+        return (~(P->getGlobalPose())) * getGlobalPose();
     };
 
     /**
@@ -152,7 +246,9 @@ class pose_3D : public shared_object {
      * Returns the free vector V (expressed in this coordinate system) expressed in the global coordinate system.
      */
     vector_type rotateToGlobal(const vector_type& V) const {
-      return getGlobalPose().Quat * V;
+      position_type p; rotation_type q;
+      getCachedGlobalTransform(p, q);
+      return q * V;
     };
 
     /**
@@ -166,7 +262,9 @@ class pose_3D : public shared_object {
      * Returns the free vector V (expressed in the global coordinate system) expressed in this coordinate system.
      */
     vector_type rotateFromGlobal(const vector_type& V) const {
-      return invert(getGlobalPose().Quat) * V;
+      position_type p; rotation_type q;
+      getCachedGlobalTransform(p, q);
+      return invert(q) * V;
     };
 
     /**
@@ -180,7 +278,9 @@ class pose_3D : public shared_object {
      * Returns the position vector V (expressed in this coordinate system) expressed in the global coordinate system.
      */
     position_type transformToGlobal(const position_type& V) const {
-      return getGlobalPose().transformToParent(V);
+      position_type p; rotation_type q;
+      getCachedGlobalTransform(p, q);
+      return p + q * V;
     };
 
     /**
@@ -194,7 +294,9 @@ class pose_3D : public shared_object {
      * Returns the position vector V (expressed in the global coordinate system) expressed in this coordinate system.
      */
     position_type transformFromGlobal(const position_type& V) const {
-      return getGlobalPose().transformFromParent(V);
+      position_type p; rotation_type q;
+      getCachedGlobalTransform(p, q);
+      return invert(q) * (V - p);
     };
 
     /**
@@ -50,6 +50,7 @@ namespace ReaK {
 
 //forward declaration, for friend declaration.
 template <class T> class trans_mat_2D;
+template <typename T> class pose_2D;
 
 /**
  * This class is a rotation matrix (proper orthogonal) of dimension 2 by 2.
@@ -90,6 +91,7 @@ class rot_mat_2D : public serialization::serializable {
 
   public:
     friend class trans_mat_2D<T>;
+    friend class pose_2D<T>;  // copies the components of its cached global rotation.
 
 /*******************************************************************************
                          Constructors / Destructors
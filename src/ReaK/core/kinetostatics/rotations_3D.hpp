@@ -63,6 +63,9 @@ class axis_angle;
 template <class T>
 class trans_mat_3D;
 
+template <typename T>
+class pose_3D;
+
 
 
 /**
@@ -575,6 +578,7 @@ class quaternion : public serialization::serializable {
     friend class axis_angle<value_type>;
     friend class trans_mat_3D<value_type>;
     friend class unit_quat<value_type>;
+    friend class pose_3D<value_type>;  // copies the components of its cached global rotation.
     
     class xrot {
       private:
@@ -0,0 +1,207 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/kinetostatics/pose_2D.hpp>
+#include <ReaK/core/kinetostatics/pose_3D.hpp>
+#include <ReaK/core/kinetostatics/frame_3D.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE poses
+#include <boost/test/unit_test.hpp>
+
+
+namespace {
+
+/* Reference global pose, composed along the parent chain without any caching. */
+ReaK::pose_3D<double> compose_chain(const ReaK::pose_3D<double>& aPose) {
+  using namespace ReaK;
+  if(aPose.Parent.expired())
+    return pose_3D<double>(weak_ptr< pose_3D<double> >(), aPose.Position, aPose.Quat);
+  pose_3D<double> result = compose_chain(*aPose.Parent.lock());
+  result.Position += result.Quat * aPose.Position;
+  result.Quat *= aPose.Quat;
+  return result;
+};
+
+bool is_close(const ReaK::pose_3D<double>& aPose1, const ReaK::pose_3D<double>& aPose2, double aTol) {
+  return (ReaK::norm_2(aPose1.Position - aPose2.Position) < aTol) &&
+         (std::fabs(aPose1.Quat[0] - aPose2.Quat[0]) < aTol) && (std::fabs(aPose1.Quat[1] - aPose2.Quat[1]) < aTol) &&
+         (std::fabs(aPose1.Quat[2] - aPose2.Quat[2]) < aTol) && (std::fabs(aPose1.Quat[3] - aPose2.Quat[3]) < aTol);
+};
+
+};
+
+
+BOOST_AUTO_TEST_CASE( pose_3D_cache_tests )
+{
+  using namespace ReaK;
+  const double tol = 100.0 * std::numeric_limits<double>::epsilon();
+
+  shared_ptr< pose_3D<double> > base(new pose_3D<double>(weak_ptr< pose_3D<double> >(), vect<double,3>(1.0,0.0,0.0), quaternion<double>()));
+  shared_ptr< pose_3D<double> > link1(new pose_3D<double>(base, vect<double,3>(0.0,0.5,0.0),
+    axis_angle<double>(0.3, vect<double,3>(0.0,0.0,1.0)).getQuaternion()));
+  shared_ptr< frame_3D<double> > link2(new frame_3D<double>(pose_3D<double>(link1, vect<double,3>(0.0,0.0,0.4),
+    axis_angle<double>(-0.7, vect<double,3>(0.0,1.0,0.0)).getQuaternion())));
+  pose_3D<double> tip(link2, vect<double,3>(0.2,0.0,0.0), quaternion<double>());
+
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+  // a repeated query (served from the cache) gives the same result.
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+
+  // changing a pose in the middle of the chain invalidates the poses below it.
+  link1->Quat = axis_angle<double>(1.1, vect<double,3>(0.0,0.0,1.0)).getQuaternion();
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+  BOOST_CHECK( is_close(link2->getGlobalPose(), compose_chain(*link2), tol) );
+
+  // and so does changing the root of the chain.
+  base->Position = vect<double,3>(-2.0,0.5,3.0);
+  BOOST_CHECK( norm_2(tip.transformToGlobal(vect<double,3>(0.1,0.2,0.3))
+                      - compose_chain(tip).transformToParent(vect<double,3>(0.1,0.2,0.3))) < tol );
+  BOOST_CHECK( norm_2(tip.transformFromGlobal(vect<double,3>(0.1,0.2,0.3))
+                      - compose_chain(tip).transformFromParent(vect<double,3>(0.1,0.2,0.3))) < tol );
+
+  // re-parenting a pose invalidates it too.
+  shared_ptr< pose_3D<double> > other(new pose_3D<double>(weak_ptr< pose_3D<double> >(), vect<double,3>(0.0,0.0,5.0), quaternion<double>()));
+  link1->Parent = other;
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+
+  // a destroyed parent is treated as the global frame.
+  link1->Parent = weak_ptr< pose_3D<double> >();
+  other.reset();
+  BOOST_CHECK( is_close(link1->getGlobalPose(), *link1, tol) );
+
+  // the relative pose between two branches of a tree.
+  shared_ptr< pose_3D<double> > branch(new pose_3D<double>(link1, vect<double,3>(0.3,-0.2,0.1),
+    axis_angle<double>(0.4, vect<double,3>(1.0,0.0,0.0)).getQuaternion()));
+  pose_3D<double> rel = tip.getPoseRelativeTo(branch);
+  BOOST_CHECK( is_close(compose_chain(*branch) * rel, compose_chain(tip), tol) );
+};
+
+
+BOOST_AUTO_TEST_CASE( pose_3D_cache_parent_identity_tests )
+{
+  using namespace ReaK;
+  const double tol = 100.0 * std::numeric_limits<double>::epsilon();
+
+  // two fresh roots that went through the same number of cache updates.
+  shared_ptr< pose_3D<double> > root1(new pose_3D<double>(weak_ptr< pose_3D<double> >(), vect<double,3>(1.0,0.0,0.0), quaternion<double>()));
+  shared_ptr< pose_3D<double> > root2(new pose_3D<double>(weak_ptr< pose_3D<double> >(), vect<double,3>(0.0,2.0,0.0), quaternion<double>()));
+  root1->getGlobalPose();
+  root2->getGlobalPose();
+
+  pose_3D<double> tip(root1, vect<double,3>(0.2,0.0,0.0), axis_angle<double>(0.5, vect<double,3>(0.0,0.0,1.0)).getQuaternion());
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+  tip.Parent = root2;
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+  tip.Parent = root1;
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+
+  // a new parent, likely allocated at the address of the destroyed one.
+  root1.reset();
+  shared_ptr< pose_3D<double> > root3(new pose_3D<double>(weak_ptr< pose_3D<double> >(), vect<double,3>(0.0,0.0,3.0), quaternion<double>()));
+  tip.Parent = root3;
+  BOOST_CHECK( is_close(tip.getGlobalPose(), compose_chain(tip), tol) );
+};
+
+
+namespace {
+
+/* Queries the global poses of a set of poses many times, and counts the results that differ from the references. */
+struct concurrent_pose_query {
+  const std::vector< ReaK::shared_ptr< ReaK::pose_3D<double> > >* p_poses;
+  const std::vector< ReaK::pose_3D<double> >* p_refs;
+  int* p_error_count;
+
+  void operator()() const {
+    const double tol = 100.0 * std::numeric_limits<double>::epsilon();
+    for(std::size_t k = 0; k < 2000; ++k) {
+      std::size_t i = (k * 7) % p_poses->size();
+      if(!is_close((*p_poses)[i]->getGlobalPose(), (*p_refs)[i], tol))
+        ++(*p_error_count);
+    };
+  };
+};
+
+};
+
+
+BOOST_AUTO_TEST_CASE( pose_3D_concurrent_cache_tests )
+{
+  using namespace ReaK;
+
+  // a chain of poses, queried concurrently from cold caches, and again after each change of the root.
+  std::vector< shared_ptr< pose_3D<double> > > poses;
+  for(std::size_t i = 0; i < 12; ++i)
+    poses.push_back(shared_ptr< pose_3D<double> >(new pose_3D<double>(
+      (i == 0 ? weak_ptr< pose_3D<double> >() : weak_ptr< pose_3D<double> >(poses.back())), vect<double,3>(0.1 * i, 0.2, 0.0),
+      axis_angle<double>(0.1 + 0.05 * i, vect<double,3>(0.0,0.6,0.8)).getQuaternion())));
+
+  for(std::size_t round = 0; round < 5; ++round) {
+    poses[0]->Position = vect<double,3>(double(round), 0.0, -1.0);
+    std::vector< pose_3D<double> > refs;
+    for(std::size_t i = 0; i < poses.size(); ++i)
+      refs.push_back(compose_chain(*poses[i]));
+
+    std::vector< int > error_counts(4, 0);
+    std::vector< shared_ptr< ReaKaux::thread > > threads;
+    for(std::size_t t = 0; t < error_counts.size(); ++t) {
+      concurrent_pose_query query = { &poses, &refs, &error_counts[t] };
+      threads.push_back(shared_ptr< ReaKaux::thread >(new ReaKaux::thread(query)));
+    };
+    for(std::size_t t = 0; t < threads.size(); ++t) {
+      threads[t]->join();
+      BOOST_CHECK_EQUAL( error_counts[t], 0 );
+    };
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( pose_2D_cache_tests )
+{
+  using namespace ReaK;
+  const double tol = 100.0 * std::numeric_limits<double>::epsilon();
+
+  shared_ptr< pose_2D<double> > base(new pose_2D<double>(weak_ptr< pose_2D<double> >(), vect<double,2>(1.0,0.0), rot_mat_2D<double>(0.2)));
+  shared_ptr< pose_2D<double> > link1(new pose_2D<double>(base, vect<double,2>(0.0,0.5), rot_mat_2D<double>(0.3)));
+  pose_2D<double> tip(link1, vect<double,2>(0.2,0.0), rot_mat_2D<double>(-0.1));
+
+  BOOST_CHECK( norm_2(tip.transformToGlobal(vect<double,2>(0.0,0.0)) - base->transformToParent(link1->transformToParent(tip.Position))) < tol );
+  BOOST_CHECK( std::fabs(tip.getGlobalPose().Rotation.getAngle() - 0.4) < tol );
+
+  link1->Rotation = rot_mat_2D<double>(1.3);
+  BOOST_CHECK( std::fabs(tip.getGlobalPose().Rotation.getAngle() - 1.4) < tol );
+  BOOST_CHECK( norm_2(tip.transformToGlobal(vect<double,2>(0.0,0.0)) - base->transformToParent(link1->transformToParent(tip.Position))) < tol );
+
+  base->Position = vect<double,2>(-3.0,2.0);
+  BOOST_CHECK( norm_2(tip.transformToGlobal(vect<double,2>(0.0,0.0)) - base->transformToParent(link1->transformToParent(tip.Position))) < tol );
+  BOOST_CHECK( norm_2(tip.transformFromGlobal(tip.transformToGlobal(vect<double,2>(0.7,-0.4))) - vect<double,2>(0.7,-0.4)) < tol );
+};
+
+
@@ -5,7 +5,6 @@
  * in the ReaK platform. These are all STL-vector based storage matrices or special matrices
  * such as nil or identity, or matrix adaptors, views, compositions and slices.
  * 
- * \todo Implement a suite of statically-sized matrix classes.
  * \todo Port the code related to the upper-triangular and lower-triangular matrices.
  * \todo Implement expression templates to optimize compound matrix expressions.
  * \todo Implement additional matrix views, for example, transposed view.
@@ -53,6 +52,10 @@
 #include "mat_alg_lower_triangular.hpp"
 #include "mat_alg_upper_triangular.hpp"
 #include "mat_alg_permutation.hpp"
+#include "mat_alg_sparse.hpp"
+#include "mat_alg_rectangular_fixed.hpp"
+#include "mat_alg_square_fixed.hpp"
+#include "mat_alg_symmetric_fixed.hpp"
 
 #include "mat_operators.hpp"
 
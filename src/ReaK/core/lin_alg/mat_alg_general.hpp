@@ -182,6 +182,37 @@ struct is_diagonal_matrix< mat<T,Structure,Alignment,Allocator> > {
 };
 
 
+/**
+ * This meta-function gives the matrix type whose elements are drawn from the memory arena of
+ * the active arena_scope (see ReaK/core/base/memory_arena.hpp), e.g., for temporaries (or
+ * workspaces) that are local to a computation. Outside of any arena_scope, the elements are
+ * allocated on the heap, as with the default allocator.
+ * \tparam T Arithmetic type of the elements of the matrix.
+ * \tparam Structure Enum which defines the structure of the matrix, see mat_structure::tag.
+ * \tparam Alignment Enum which defines the memory alignment of the matrix.
+ */
+template <typename T,
+          mat_structure::tag Structure = mat_structure::rectangular,
+          mat_alignment::tag Alignment = mat_alignment::column_major>
+struct arena_mat {
+  typedef mat<T,Structure,Alignment,arena_allocator<T> > type;
+};
+
+namespace detail {
+
+/*
+ * This meta-function checks if a matrix type has an allocator of a given type (e.g., such that
+ * its allocator can be used to construct another matrix).
+ */
+template <typename Matrix, typename Allocator, bool HasAllocator = has_allocator_matrix<Matrix>::value>
+struct has_same_allocator : boost::false_type { };
+
+template <typename Matrix, typename Allocator>
+struct has_same_allocator<Matrix,Allocator,true> : boost::is_same<typename mat_traits<Matrix>::allocator_type, Allocator> { };
+
+};
+
+
 
 
 
@@ -611,13 +611,13 @@ class mat<T,mat_structure::rectangular,mat_alignment::column_major,Allocator> :
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount)
         & std::pair<std::string, unsigned int>("colCount",colCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
       unsigned int tmp;
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",tmp);
       rowCount = tmp;
       A & std::pair<std::string, unsigned int&>("colCount",tmp);
@@ -1233,13 +1233,13 @@ class mat<T,mat_structure::rectangular,mat_alignment::row_major,Allocator> : pub
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount)
         & std::pair<std::string, unsigned int>("colCount",colCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
       unsigned int tmp;
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",tmp);
       rowCount = tmp;
       A & std::pair<std::string, unsigned int&>("colCount",tmp);
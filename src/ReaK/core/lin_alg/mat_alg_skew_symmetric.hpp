@@ -771,11 +771,11 @@ class mat<T,mat_structure::skew_symmetric,Alignment,Allocator> : public serializ
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",rowCount);
     };
     
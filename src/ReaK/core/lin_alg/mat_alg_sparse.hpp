@@ -0,0 +1,554 @@
+/**
+ * \file mat_alg_sparse.hpp
+ *
+ * This library declares the matrix specialization for representing and manipulating general
+ * sparse matrices, i.e., matrices in which only the non-zero entries are stored. The storage
+ * is the standard compressed format, that is, compressed-sparse-column (CSC) for column-major
+ * alignment and compressed-sparse-row (CSR) for row-major alignment. This class is mainly meant
+ * to be constructed once (from triplets or from another matrix) and then used in matrix-vector
+ * products and sparse factorizations (see mat_sparse_cholesky.hpp), which all run in time
+ * proportional to the number of non-zero entries instead of the full matrix dimensions.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_ALG_SPARSE_HPP
+#define REAK_MAT_ALG_SPARSE_HPP
+
+#include "mat_alg_general.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace ReaK {
+
+
+/**
+ * This class holds a general sparse matrix, in compressed storage. The non-zero entries are stored
+ * one "outer" vector after the other (columns if column-major, rows if row-major), and, within each
+ * outer vector, in increasing order of "inner" index (rows if column-major, columns if row-major).
+ * The sparsity pattern is fixed on construction, thus, this matrix is read-only (element-wise), but
+ * it supports the scaling, negation and transposition operations, as well as efficient products with
+ * vectors. This class is serializable and registered to the ReaK::rtti system.
+ *
+ * Models: ReadableMatrixConcept and DynAllocMatrixConcept.
+ *
+ * \tparam T Arithmetic type of the elements of the matrix.
+ * \tparam Alignment Enum which defines the memory alignment of the matrix. Either mat_alignment::row_major (CSR) or mat_alignment::column_major (CSC, default).
+ * \tparam Allocator Standard allocator class (as in the STL), the default is std::allocator<T>.
+ */
+template <typename T, mat_alignment::tag Alignment, typename Allocator>
+class mat<T,mat_structure::sparse,Alignment,Allocator> : public serialization::serializable {
+  public:
+
+    typedef mat<T,mat_structure::sparse,Alignment,Allocator> self;
+    typedef Allocator allocator_type;
+
+    typedef T value_type;
+    typedef std::vector<value_type,allocator_type> container_type;
+
+    typedef void reference;
+    typedef T const_reference;
+    typedef void pointer;
+    typedef void const_pointer;
+
+    typedef void col_iterator;
+    typedef void const_col_iterator;
+    typedef void row_iterator;
+    typedef void const_row_iterator;
+
+    typedef std::size_t size_type;
+    typedef typename container_type::difference_type difference_type;
+
+    typedef std::vector<size_type, typename allocator_type::template rebind<size_type>::other > index_container_type;
+
+    BOOST_STATIC_CONSTANT(std::size_t, static_row_count = 0);
+    BOOST_STATIC_CONSTANT(std::size_t, static_col_count = 0);
+    BOOST_STATIC_CONSTANT(mat_alignment::tag, alignment = Alignment);
+    BOOST_STATIC_CONSTANT(mat_structure::tag, structure = mat_structure::sparse);
+
+  private:
+    container_type q; ///< Holds the values of the non-zero entries, one outer vector after the other.
+    index_container_type inner; ///< Holds the inner index (row if column-major, column if row-major) of each non-zero entry.
+    index_container_type outer; ///< Holds the position in q of the start of each outer vector, followed by the number of non-zero entries.
+    size_type rowCount; ///< Row Count.
+    size_type colCount; ///< Column Count.
+
+    size_type outer_count() const { return (Alignment == mat_alignment::column_major ? colCount : rowCount); };
+    size_type inner_count() const { return (Alignment == mat_alignment::column_major ? rowCount : colCount); };
+
+    /* Fills the compressed storage from a list of (outer, inner, value) triplets, summing duplicates. */
+    template <typename IndexVector, typename ValueVector>
+    void assemble_triplets(const IndexVector& aOuter, const IndexVector& aInner, const ValueVector& aValues) {
+      size_type nnz = aValues.size();
+      size_type outer_n = outer_count();
+      outer.assign(outer_n + 1, 0);
+      for(size_type k = 0; k < nnz; ++k)
+        ++outer[aOuter[k] + 1];
+      for(size_type j = 0; j < outer_n; ++j)
+        outer[j + 1] += outer[j];
+      index_container_type next(outer.begin(), outer.end() - 1, outer.get_allocator());
+      inner.resize(nnz);
+      q.resize(nnz);
+      for(size_type k = 0; k < nnz; ++k) {
+        size_type p = next[aOuter[k]]++;
+        inner[p] = aInner[k];
+        q[p] = aValues[k];
+      };
+      // sort each outer vector by inner index (insertion-sort, outer vectors are short) and merge duplicates.
+      size_type new_nnz = 0;
+      for(size_type j = 0; j < outer_n; ++j) {
+        size_type first = outer[j];
+        size_type last = outer[j + 1];
+        for(size_type p = first + 1; p < last; ++p) {
+          size_type idx = inner[p];
+          value_type val = q[p];
+          size_type r = p;
+          for(; (r > first) && (inner[r - 1] > idx); --r) {
+            inner[r] = inner[r - 1];
+            q[r] = q[r - 1];
+          };
+          inner[r] = idx;
+          q[r] = val;
+        };
+        outer[j] = new_nnz;
+        for(size_type p = first; p < last; ++p) {
+          if((new_nnz > outer[j]) && (inner[new_nnz - 1] == inner[p])) {
+            q[new_nnz - 1] += q[p];
+          } else {
+            inner[new_nnz] = inner[p];
+            q[new_nnz] = q[p];
+            ++new_nnz;
+          };
+        };
+      };
+      outer[outer_n] = new_nnz;
+      inner.resize(new_nnz);
+      q.resize(new_nnz);
+    };
+
+  public:
+
+/*******************************************************************************
+                         Constructors / Destructors
+*******************************************************************************/
+
+    /**
+     * Default constructor: creates an empty matrix.
+     */
+    mat(const allocator_type& aAlloc = allocator_type()) :
+        q(aAlloc), inner(aAlloc), outer(1, 0, aAlloc), rowCount(0), colCount(0) { };
+
+    /**
+     * Constructor for a sized matrix with no non-zero entries.
+     * \param aRowCount The number of rows of the matrix.
+     * \param aColCount The number of columns of the matrix.
+     */
+    mat(size_type aRowCount, size_type aColCount, const allocator_type& aAlloc = allocator_type()) :
+        q(aAlloc), inner(aAlloc), outer((Alignment == mat_alignment::column_major ? aColCount : aRowCount) + 1, 0, aAlloc),
+        rowCount(aRowCount), colCount(aColCount) { };
+
+    /**
+     * Constructor from a list of triplets (row index, column index, value), in any order. Duplicate
+     * entries (with the same row and column) are summed together. All the triplets are kept in the
+     * sparsity pattern, even if their value is zero.
+     * \param aRowCount The number of rows of the matrix.
+     * \param aColCount The number of columns of the matrix.
+     * \param aRows The row indices of the triplets.
+     * \param aCols The column indices of the triplets.
+     * \param aValues The values of the triplets.
+     * \throw std::range_error if the triplet lists do not have the same size or if an index is out of range.
+     */
+    mat(size_type aRowCount, size_type aColCount,
+        const std::vector<size_type>& aRows, const std::vector<size_type>& aCols,
+        const std::vector<value_type>& aValues, const allocator_type& aAlloc = allocator_type()) :
+        q(aAlloc), inner(aAlloc), outer(aAlloc), rowCount(aRowCount), colCount(aColCount) {
+      if((aRows.size() != aValues.size()) || (aCols.size() != aValues.size()))
+        throw std::range_error("Sparse matrix triplet lists must have the same size!");
+      for(size_type k = 0; k < aValues.size(); ++k)
+        if((aRows[k] >= rowCount) || (aCols[k] >= colCount))
+          throw std::range_error("Sparse matrix triplet index out of range!");
+      if(Alignment == mat_alignment::column_major)
+        assemble_triplets(aCols, aRows, aValues);
+      else
+        assemble_triplets(aRows, aCols, aValues);
+    };
+
+    /**
+     * Standard Copy Constructor with standard semantics.
+     */
+    mat(const self& M) : q(M.q), inner(M.inner), outer(M.outer), rowCount(M.rowCount), colCount(M.colCount) { };
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    /**
+     * Standard Move Constructor with standard semantics.
+     */
+    mat(self&& M) : q(std::move(M.q)), inner(std::move(M.inner)), outer(std::move(M.outer)),
+                    rowCount(M.rowCount), colCount(M.colCount) { };
+#endif
+
+    /**
+     * Constructor from a general matrix, storing only its non-zero entries.
+     */
+    template <typename Matrix>
+    explicit mat(const Matrix& M, const allocator_type& aAlloc = allocator_type(),
+                 typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                              !(boost::is_same<Matrix,self>::value) , void* >::type dummy = NULL) :
+                 q(aAlloc), inner(aAlloc), outer(aAlloc), rowCount(M.get_row_count()), colCount(M.get_col_count()) {
+      size_type outer_n = outer_count();
+      size_type inner_n = inner_count();
+      outer.resize(outer_n + 1);
+      for(size_type j = 0; j < outer_n; ++j) {
+        outer[j] = q.size();
+        for(size_type i = 0; i < inner_n; ++i) {
+          value_type val = (Alignment == mat_alignment::column_major ? M(i,j) : M(j,i));
+          if(val != value_type(0)) {
+            inner.push_back(i);
+            q.push_back(val);
+          };
+        };
+      };
+      outer[outer_n] = q.size();
+    };
+
+    /**
+     * Destructor.
+     */
+    ~mat() { };
+
+    /**
+     * Swap friend-function that allows ADL and efficient swapping of two matrices.
+     */
+    friend void swap(self& lhs, self& rhs) throw() {
+      using std::swap;
+      swap(lhs.q,rhs.q);
+      swap(lhs.inner,rhs.inner);
+      swap(lhs.outer,rhs.outer);
+      swap(lhs.rowCount,rhs.rowCount);
+      swap(lhs.colCount,rhs.colCount);
+    };
+
+/*******************************************************************************
+                         Accessors and Methods
+*******************************************************************************/
+
+    /**
+     * Matrix indexing accessor for read-only access. This requires a binary search
+     * within the row or column, and is thus not meant for traversing the matrix.
+     * \param i Row index.
+     * \param j Column index.
+     * \return the element at the given position.
+     */
+    value_type operator()(size_type i,size_type j) const {
+      size_type o = (Alignment == mat_alignment::column_major ? j : i);
+      size_type n = (Alignment == mat_alignment::column_major ? i : j);
+      typename index_container_type::const_iterator first = inner.begin() + outer[o];
+      typename index_container_type::const_iterator last = inner.begin() + outer[o + 1];
+      typename index_container_type::const_iterator it = std::lower_bound(first, last, n);
+      if((it == last) || (*it != n))
+        return value_type(0);
+      return q[it - inner.begin()];
+    };
+
+    /**
+     * Sub-matrix operator, accessor for read only.
+     */
+    mat_const_sub_block<self> operator()(const std::pair<size_type,size_type>& r, const std::pair<size_type,size_type>& c) const {
+      return sub(*this)(r,c);
+    };
+
+    /**
+     * Gets the row-count (number of rows) of the matrix.
+     * \return number of rows of the matrix.
+     */
+    size_type get_row_count() const throw() { return rowCount; };
+
+    /**
+     * Gets the column-count (number of columns) of the matrix.
+     * \return number of columns of the matrix.
+     */
+    size_type get_col_count() const throw() { return colCount; };
+
+    /**
+     * Gets the row-count and column-count of the matrix, as a std::pair of values.
+     * \return the row-count and column-count of the matrix, as a std::pair of values.
+     */
+    std::pair<size_type,size_type> size() const throw() { return std::make_pair(rowCount,colCount); };
+
+    /**
+     * Gets the number of stored (non-zero) entries of the matrix.
+     * \return the number of stored (non-zero) entries of the matrix.
+     */
+    size_type get_nonzero_count() const throw() { return q.size(); };
+
+    /**
+     * Returns the allocator object of the underlying container.
+     * \return the allocator object of the underlying container.
+     */
+    allocator_type get_allocator() const { return q.get_allocator(); };
+
+    /**
+     * Gets the positions of the start of each outer vector (columns if column-major, rows if row-major)
+     * within the arrays of inner indices and values, followed by the number of non-zero entries.
+     * \return the array of outer vector starts (of size outer-count + 1).
+     */
+    const index_container_type& get_outer_starts() const { return outer; };
+
+    /**
+     * Gets the inner index (row index if column-major, column index if row-major) of each stored entry.
+     * \return the array of inner indices of the stored entries.
+     */
+    const index_container_type& get_inner_indices() const { return inner; };
+
+    /**
+     * Gets the value of each stored entry.
+     * \return the array of values of the stored entries.
+     */
+    const container_type& get_values() const { return q; };
+
+/*******************************************************************************
+                         Assignment Operators
+*******************************************************************************/
+
+    /**
+     * Standard Assignment operator with a sparse matrix.
+     */
+    self& operator =(self M) {
+      swap(*this,M);
+      return *this;
+    };
+
+    /**
+     * Standard Assignment operator with a general matrix, storing only its non-zero entries.
+     */
+    template <typename Matrix>
+    typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                 !(boost::is_same<Matrix,self>::value),
+    self& >::type operator =(const Matrix& M) {
+      self tmp(M);
+      swap(*this,tmp);
+      return *this;
+    };
+
+    /**
+     * Scalar-multiply-and-store operator with standard semantics.
+     * \param S the scalar to be multiplied to this.
+     * \return this matrix by reference.
+     */
+    self& operator *=(const value_type& S) {
+      for(size_type k = 0; k < q.size(); ++k)
+        q[k] *= S;
+      return *this;
+    };
+
+    /**
+     * Negation operator with standard semantics.
+     * \return the negative of this matrix.
+     */
+    self operator -() const {
+      self result(*this);
+      for(size_type k = 0; k < result.q.size(); ++k)
+        result.q[k] = -result.q[k];
+      return result;
+    };
+
+/*******************************************************************************
+                         Special Methods
+*******************************************************************************/
+
+    /**
+     * Transposes the matrix M (in time proportional to the number of non-zero entries).
+     * \param M The sparse matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose(const self& M) {
+      self result(M.colCount, M.rowCount, M.get_allocator());
+      size_type nnz = M.q.size();
+      size_type outer_n = M.outer_count();
+      size_type new_outer_n = result.outer_count();
+      result.inner.resize(nnz);
+      result.q.resize(nnz);
+      for(size_type k = 0; k < nnz; ++k)
+        ++result.outer[M.inner[k] + 1];
+      for(size_type i = 0; i < new_outer_n; ++i)
+        result.outer[i + 1] += result.outer[i];
+      index_container_type next(result.outer.begin(), result.outer.end() - 1, M.outer.get_allocator());
+      for(size_type j = 0; j < outer_n; ++j) {
+        for(size_type k = M.outer[j]; k < M.outer[j + 1]; ++k) {
+          size_type p = next[M.inner[k]]++;
+          result.inner[p] = j;
+          result.q[p] = M.q[k];
+        };
+      };
+      return result;
+    };
+
+    /**
+     * Transposes the matrix M.
+     * \param M The sparse matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose_move(const self& M) {
+      return transpose(M);
+    };
+
+    /**
+     * Returns the trace of matrix M.
+     * \param M A sparse matrix.
+     * \return the trace of matrix M.
+     */
+    friend value_type trace(const self& M) {
+      value_type sum = value_type(0);
+      size_type n = (M.rowCount < M.colCount ? M.rowCount : M.colCount);
+      for(size_type i = 0; i < n; ++i)
+        sum += M(i,i);
+      return sum;
+    };
+
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+
+    virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
+      A & RK_SERIAL_SAVE_WITH_NAME(q)
+        & RK_SERIAL_SAVE_WITH_NAME(inner)
+        & RK_SERIAL_SAVE_WITH_NAME(outer)
+        & RK_SERIAL_SAVE_WITH_NAME(rowCount)
+        & RK_SERIAL_SAVE_WITH_NAME(colCount);
+    };
+    virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
+      A & RK_SERIAL_LOAD_WITH_NAME(q)
+        & RK_SERIAL_LOAD_WITH_NAME(inner)
+        & RK_SERIAL_LOAD_WITH_NAME(outer)
+        & RK_SERIAL_LOAD_WITH_NAME(rowCount)
+        & RK_SERIAL_LOAD_WITH_NAME(colCount);
+    };
+
+    RK_RTTI_REGISTER_CLASS_1BASE(self,1,serialization::serializable)
+
+};
+
+
+template <typename T, mat_alignment::tag Alignment, typename Allocator>
+struct is_writable_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef bool value_type;
+  BOOST_STATIC_CONSTANT( bool, value = false );
+  typedef is_writable_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > type;
+};
+
+template <typename T, mat_alignment::tag Alignment, typename Allocator>
+struct is_resizable_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef bool value_type;
+  BOOST_STATIC_CONSTANT( bool, value = false );
+  typedef is_resizable_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > type;
+};
+
+template <typename T, mat_alignment::tag Alignment, typename Allocator>
+struct is_square_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef bool value_type;
+  BOOST_STATIC_CONSTANT( bool, value = false );
+  typedef is_square_matrix< mat<T,mat_structure::sparse,Alignment,Allocator> > type;
+};
+
+
+/**
+ * Column-vector multiplication with a sparse matrix, in time proportional to the number of
+ * non-zero entries of the matrix.
+ * \param M some sparse matrix.
+ * \param V some column vector.
+ * \return The column vector M * V, by value.
+ * \throw std::range_error if matrix and vector dimensions are not proper for multiplication.
+ */
+template <typename T, typename Vector, mat_alignment::tag Alignment, typename Allocator>
+typename boost::enable_if< is_readable_vector<Vector>,
+vect_copy<Vector> >::type::type operator *(const mat<T,mat_structure::sparse,Alignment,Allocator>& M,
+                                           const Vector& V) {
+  if(V.size() != M.get_col_count())
+    throw std::range_error("Matrix dimension mismatch.");
+  typedef typename vect_copy<Vector>::type result_type;
+  typedef typename mat<T,mat_structure::sparse,Alignment,Allocator>::size_type size_type;
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& outer = M.get_outer_starts();
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& inner = M.get_inner_indices();
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::container_type& q = M.get_values();
+
+  result_type result(M.get_row_count());
+  for(size_type i = 0; i < result.size(); ++i)
+    result[i] = T(0);
+  if(Alignment == mat_alignment::column_major) {
+    for(size_type j = 0; j < M.get_col_count(); ++j)
+      for(size_type k = outer[j]; k < outer[j + 1]; ++k)
+        result[inner[k]] += q[k] * V[j];
+  } else {
+    for(size_type i = 0; i < M.get_row_count(); ++i)
+      for(size_type k = outer[i]; k < outer[i + 1]; ++k)
+        result[i] += q[k] * V[inner[k]];
+  };
+  return result;
+};
+
+/**
+ * Row-vector multiplication with a sparse matrix, in time proportional to the number of
+ * non-zero entries of the matrix.
+ * \param V some row vector.
+ * \param M some sparse matrix.
+ * \return The row vector V * M, by value.
+ * \throw std::range_error if matrix and vector dimensions are not proper for multiplication.
+ */
+template <typename T, typename Vector, mat_alignment::tag Alignment, typename Allocator>
+typename boost::enable_if< is_readable_vector<Vector>,
+vect_copy<Vector> >::type::type operator *(const Vector& V,
+                                           const mat<T,mat_structure::sparse,Alignment,Allocator>& M) {
+  if(V.size() != M.get_row_count())
+    throw std::range_error("Matrix dimension mismatch.");
+  typedef typename vect_copy<Vector>::type result_type;
+  typedef typename mat<T,mat_structure::sparse,Alignment,Allocator>::size_type size_type;
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& outer = M.get_outer_starts();
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& inner = M.get_inner_indices();
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::container_type& q = M.get_values();
+
+  result_type result(M.get_col_count());
+  for(size_type j = 0; j < result.size(); ++j)
+    result[j] = T(0);
+  if(Alignment == mat_alignment::column_major) {
+    for(size_type j = 0; j < M.get_col_count(); ++j)
+      for(size_type k = outer[j]; k < outer[j + 1]; ++k)
+        result[j] += V[inner[k]] * q[k];
+  } else {
+    for(size_type i = 0; i < M.get_row_count(); ++i)
+      for(size_type k = outer[i]; k < outer[i + 1]; ++k)
+        result[inner[k]] += V[i] * q[k];
+  };
+  return result;
+};
+
+
+};
+
+
+#endif
@@ -154,7 +154,7 @@ class mat<T,mat_structure::square,mat_alignment::column_major,Allocator> : publi
     explicit mat(const Matrix&  M,const allocator_type& aAlloc = allocator_type(),
                  typename boost::enable_if_c< is_readable_matrix<Matrix>::value && 
                                               !(boost::is_same<Matrix,self>::value) &&
-                                              !(has_allocator_matrix<Matrix>::value), void* >::type dummy = NULL) :
+                                              !(detail::has_same_allocator<Matrix,allocator_type>::value), void* >::type dummy = NULL) :
                  q(M.get_row_count()*M.get_row_count(),T(0.0),aAlloc),
                  rowCount(M.get_row_count()) {
       if(M.get_col_count() != M.get_row_count())
@@ -172,7 +172,7 @@ class mat<T,mat_structure::square,mat_alignment::column_major,Allocator> : publi
     template <typename Matrix>
     explicit mat(const Matrix&  M,typename boost::enable_if_c< is_readable_matrix<Matrix>::value && 
                                                                !(boost::is_same<Matrix,self>::value) &&
-                                                               has_allocator_matrix<Matrix>::value, void* >::type dummy = NULL) :
+                                                               detail::has_same_allocator<Matrix,allocator_type>::value, void* >::type dummy = NULL) :
                  q(M.get_row_count()*M.get_row_count(),T(0.0),M.get_allocator()),
                  rowCount(M.get_row_count()) {
       if(M.get_col_count() != M.get_row_count())
@@ -635,12 +635,12 @@ class mat<T,mat_structure::square,mat_alignment::column_major,Allocator> : publi
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
       unsigned int tmp;
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",tmp);
       rowCount = tmp;
     };
@@ -1211,12 +1211,12 @@ class mat<T,mat_structure::square,mat_alignment::row_major,Allocator> : public s
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
       unsigned int tmp;
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",tmp);
       rowCount = tmp;
     };
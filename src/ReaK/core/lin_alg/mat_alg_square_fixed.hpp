@@ -0,0 +1,206 @@
+/**
+ * \file mat_alg_square_fixed.hpp
+ *
+ * This library implements the specialization of the mat_fix<> template for a
+ * general square matrix (fixed dimension) of both column-major and row-major
+ * alignment. This matrix type fulfills the general matrix concepts (Readable,
+ * Writable, and Fully-Writable), and its elements are stored in a fixed-size array,
+ * i.e., it never requires dynamic memory allocations.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_ALG_SQUARE_FIXED_HPP
+#define REAK_MAT_ALG_SQUARE_FIXED_HPP
+
+#include "mat_alg_rectangular_fixed.hpp"
+
+namespace ReaK {
+
+
+template <typename T,
+          unsigned int Size,
+          mat_alignment::tag Alignment>
+struct is_fully_writable_matrix< mat_fix<T,mat_structure::square,Size,Size,Alignment> > {
+  BOOST_STATIC_CONSTANT( bool, value = true );
+  typedef is_fully_writable_matrix< mat_fix<T,mat_structure::square,Size,Size,Alignment> > type;
+};
+
+
+/**
+ * This class template specialization implements a matrix with square structure, fixed
+ * dimension and either column-major or row-major alignment. It has the same storage as the
+ * fixed-size rectangular matrix (of which it is a refinement), i.e., it never requires any
+ * dynamic memory allocation. This class is serializable and registered to the ReaK::rtti system.
+ *
+ * Models: ReadableMatrixConcept, WritableMatrixConcept, and FullyWritableMatrixConcept.
+ *
+ * \tparam T Arithmetic type of the elements of the matrix.
+ * \tparam Size The number of rows and columns of the matrix.
+ * \tparam Alignment Enum which defines the memory alignment of the matrix. Either mat_alignment::row_major or mat_alignment::column_major (default).
+ */
+template <typename T,
+          unsigned int Size,
+          mat_alignment::tag Alignment>
+class mat_fix<T,mat_structure::square,Size,Size,Alignment> : public mat_fix<T,mat_structure::rectangular,Size,Size,Alignment> {
+  public:
+
+    typedef mat_fix<T,mat_structure::square,Size,Size,Alignment> self;
+    typedef mat_fix<T,mat_structure::rectangular,Size,Size,Alignment> base_type;
+
+    typedef typename base_type::value_type value_type;
+    typedef typename base_type::size_type size_type;
+
+    BOOST_STATIC_CONSTANT(mat_structure::tag, structure = mat_structure::square);
+
+/*******************************************************************************
+                         Constructors / Destructors
+*******************************************************************************/
+
+    /**
+     * Default constructor: sets all to zero.
+     */
+    mat_fix() : base_type() { };
+
+    /**
+     * Constructor for a matrix filled with a given value.
+     */
+    explicit mat_fix(const value_type& aFill) : base_type(aFill) { };
+
+    /**
+     * Explicit constructor from any type of matrix (e.g., from an identity matrix).
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    explicit mat_fix(const Matrix& M, typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                                                   !(boost::is_same<Matrix,self>::value), void* >::type dummy = NULL) :
+                     base_type(M) { };
+
+    /**
+     * Constructor from an array of values (with the same alignment as this matrix).
+     */
+    explicit mat_fix(const value_type* Q) : base_type(Q) { };
+
+/*******************************************************************************
+                         Assignment Operators
+*******************************************************************************/
+
+    /**
+     * Assignment operator from any type of matrix.
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                 !(boost::is_same<Matrix,self>::value),
+    self& >::type operator =(const Matrix& M) {
+      self tmp(M);
+      *this = tmp;
+      return *this;
+    };
+
+    /**
+     * Add-and-store operator with standard semantics.
+     */
+    template <typename Matrix>
+    self& operator +=(const Matrix& M) {
+      base_type::operator+=(M);
+      return *this;
+    };
+
+    /**
+     * Sub-and-store operator with standard semantics.
+     */
+    template <typename Matrix>
+    self& operator -=(const Matrix& M) {
+      base_type::operator-=(M);
+      return *this;
+    };
+
+    /**
+     * Scalar-multiply-and-store operator with standard semantics.
+     */
+    self& operator *=(const value_type& S) {
+      base_type::operator*=(S);
+      return *this;
+    };
+
+    /**
+     * Negation operator.
+     * \return The negative of this matrix.
+     */
+    self operator -() const {
+      self result;
+      for(size_type i = 0; i < Size * Size; ++i)
+        result.q[i] = -this->q[i];
+      return result;
+    };
+
+    /**
+     * Transposes the matrix M.
+     * \param M The matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose(const self& M) {
+      self result;
+      for(size_type j = 0; j < Size; ++j)
+        for(size_type i = 0; i < Size; ++i)
+          result(j,i) = M(i,j);
+      return result;
+    };
+
+    /**
+     * Transposes the matrix M (same as transpose(), since there is no storage to move).
+     * \param M The matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose_move(const self& M) {
+      return transpose(M);
+    };
+
+    /**
+     * Returns the trace of matrix M.
+     * \param M A matrix.
+     * \return the trace of matrix M.
+     */
+    friend value_type trace(const self& M) {
+      value_type sum = value_type(0);
+      for(size_type i = 0; i < Size; ++i)
+        sum += M(i,i);
+      return sum;
+    };
+
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+
+    RK_RTTI_REGISTER_CLASS_1BASE(self,1,base_type)
+
+};
+
+
+};
+
+#endif
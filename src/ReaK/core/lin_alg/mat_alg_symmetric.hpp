@@ -859,12 +859,12 @@ class mat<T,mat_structure::symmetric,Alignment,Allocator> : public serialization
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q)
+      A & std::pair<std::string, const container_type&>("q",q)
         & std::pair<std::string, unsigned int>("rowCount",rowCount);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
       unsigned int temp;
-      A & std::pair<std::string, std::vector<T>&>("q",q)
+      A & std::pair<std::string, container_type&>("q",q)
         & std::pair<std::string, unsigned int&>("rowCount",temp);
       rowCount = temp;
     };
@@ -0,0 +1,348 @@
+/**
+ * \file mat_alg_symmetric_fixed.hpp
+ *
+ * This library implements the specialization of the mat_fix<> template for a
+ * symmetric matrix (fixed dimension). Only the upper-triangular part of the matrix
+ * is stored (packed), in a fixed-size array, i.e., it never requires dynamic memory
+ * allocations. This matrix type fulfills the Readable and Writable matrix concepts.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_ALG_SYMMETRIC_FIXED_HPP
+#define REAK_MAT_ALG_SYMMETRIC_FIXED_HPP
+
+#include "mat_alg_rectangular_fixed.hpp"
+
+namespace ReaK {
+
+
+/**
+ * This class template specialization implements a symmetric matrix of fixed dimension. This
+ * class holds only the upper-triangular part (packed) since the lower part is assumed to be
+ * equal to the upper one. The elements are stored in a fixed-size array, thus, this matrix type
+ * never requires any dynamic memory allocation. This class is serializable and registered to the
+ * ReaK::rtti system.
+ *
+ * Models: ReadableMatrixConcept and WritableMatrixConcept.
+ *
+ * \tparam T Arithmetic type of the elements of the matrix.
+ * \tparam Size The number of rows and columns of the matrix.
+ * \tparam Alignment Enum which defines the memory alignment of the matrix (has no effect on the storage).
+ */
+template <typename T,
+          unsigned int Size,
+          mat_alignment::tag Alignment>
+class mat_fix<T,mat_structure::symmetric,Size,Size,Alignment> : public serialization::serializable {
+  public:
+
+    typedef mat_fix<T,mat_structure::symmetric,Size,Size,Alignment> self;
+    typedef void allocator_type;
+
+    typedef T value_type;
+    typedef void container_type;
+
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+
+    typedef void col_iterator;
+    typedef void const_col_iterator;
+    typedef void row_iterator;
+    typedef void const_row_iterator;
+
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    BOOST_STATIC_CONSTANT(std::size_t, static_row_count = Size);
+    BOOST_STATIC_CONSTANT(std::size_t, static_col_count = Size);
+    BOOST_STATIC_CONSTANT(mat_alignment::tag, alignment = Alignment);
+    BOOST_STATIC_CONSTANT(mat_structure::tag, structure = mat_structure::symmetric);
+
+  private:
+    value_type q[(Size * (Size + 1)) / 2]; ///< Array which holds the upper-triangular part of the matrix.
+
+    static size_type mat_triangular_size(size_type aSize) {
+      return (aSize * (aSize + 1)) / 2;
+    };
+
+    static size_type index(size_type i, size_type j) {
+      if(i > j)
+        return mat_triangular_size(i) + j;
+      else
+        return mat_triangular_size(j) + i;
+    };
+
+  public:
+
+/*******************************************************************************
+                         Constructors / Destructors
+*******************************************************************************/
+
+    /**
+     * Default constructor: sets all to zero.
+     */
+    mat_fix() {
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        q[i] = value_type(0);
+    };
+
+    /**
+     * Constructor for a matrix filled with a given value.
+     */
+    explicit mat_fix(const value_type& aFill) {
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        q[i] = aFill;
+    };
+
+    /**
+     * Explicit constructor from any type of symmetric matrix.
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    explicit mat_fix(const Matrix& M, typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                                                   is_symmetric_matrix<Matrix>::value &&
+                                                                   !(boost::is_same<Matrix,self>::value), void* >::type dummy = NULL) {
+      if((M.get_row_count() != Size) || (M.get_col_count() != Size))
+        throw std::range_error("Matrix dimension mismatch.");
+      for(size_type j = 0; j < Size; ++j)
+        for(size_type i = 0; i <= j; ++i)
+          q[index(i,j)] = M(i,j);
+    };
+
+    /**
+     * Explicit constructor from any type of matrix. The "(M + M.transpose) / 2" is applied to guarantee symmetry.
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    explicit mat_fix(const Matrix& M, typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                                                   !is_symmetric_matrix<Matrix>::value, void* >::type dummy = NULL) {
+      if((M.get_row_count() != Size) || (M.get_col_count() != Size))
+        throw std::range_error("Matrix dimension mismatch.");
+      for(size_type j = 0; j < Size; ++j) {
+        for(size_type i = 0; i < j; ++i)
+          q[index(i,j)] = value_type(0.5) * (M(i,j) + M(j,i));
+        q[index(j,j)] = M(j,j);
+      };
+    };
+
+    /**
+     * The standard swap function (works with ADL).
+     */
+    friend void swap(self& m1, self& m2) throw() {
+      using std::swap;
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        swap(m1.q[i],m2.q[i]);
+    };
+
+
+/*******************************************************************************
+                         Accessors and Methods
+*******************************************************************************/
+
+    /**
+     * Matrix indexing accessor for read-write access (writing (i,j) also writes (j,i)).
+     * \param i Row index.
+     * \param j Column index.
+     * \return the element at the given position.
+     */
+    reference operator()(size_type i,size_type j) { return q[index(i,j)]; };
+    /**
+     * Matrix indexing accessor for read-only access.
+     * \param i Row index.
+     * \param j Column index.
+     * \return the element at the given position.
+     */
+    const_reference operator()(size_type i,size_type j) const { return q[index(i,j)]; };
+
+    /**
+     * Gets the row-count (number of rows) of the matrix.
+     * \return number of rows of the matrix.
+     */
+    size_type get_row_count() const throw() { return Size; };
+    /**
+     * Gets the column-count (number of columns) of the matrix.
+     * \return number of columns of the matrix.
+     */
+    size_type get_col_count() const throw() { return Size; };
+
+    /**
+     * Gets the row-count and column-count of the matrix, as a std::pair of values.
+     * \return the row-count and column-count of the matrix, as a std::pair of values.
+     */
+    std::pair<size_type,size_type> size() const throw() { return std::make_pair(Size,Size); };
+
+    /**
+     * Checks that the requested dimensions are those of the matrix (which cannot be resized).
+     * \param sz requested dimensions for the matrix.
+     * \throw std::range_error if the dimensions do not match those of the matrix.
+     */
+    void resize(const std::pair<size_type,size_type>& sz) {
+      set_row_count(sz.first);
+      set_col_count(sz.second);
+    };
+    /**
+     * Checks that the requested row-count is that of the matrix (which cannot be resized).
+     * \param aRowCount requested number of rows for the matrix.
+     * \throw std::range_error if the row-count does not match that of the matrix.
+     */
+    void set_row_count(size_type aRowCount, bool = false) {
+      if(aRowCount != Size)
+        throw std::range_error("Cannot resize a fixed-size matrix!");
+    };
+    /**
+     * Checks that the requested column-count is that of the matrix (which cannot be resized).
+     * \param aColCount requested number of columns for the matrix.
+     * \throw std::range_error if the column-count does not match that of the matrix.
+     */
+    void set_col_count(size_type aColCount, bool = false) {
+      if(aColCount != Size)
+        throw std::range_error("Cannot resize a fixed-size matrix!");
+    };
+
+
+/*******************************************************************************
+                         Assignment Operators
+*******************************************************************************/
+
+    /**
+     * Assignment operator from any type of matrix (non-symmetric matrices are symmetrized).
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                 !(boost::is_same<Matrix,self>::value),
+    self& >::type operator =(const Matrix& M) {
+      self tmp(M);
+      *this = tmp;
+      return *this;
+    };
+
+    /**
+     * Add-and-store operator with standard semantics.
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                 is_symmetric_matrix<Matrix>::value,
+    self& >::type operator +=(const Matrix& M) {
+      if((M.get_row_count() != Size) || (M.get_col_count() != Size))
+        throw std::range_error("Matrix dimension mismatch.");
+      for(size_type j = 0; j < Size; ++j)
+        for(size_type i = 0; i <= j; ++i)
+          q[index(i,j)] += M(i,j);
+      return *this;
+    };
+
+    /**
+     * Sub-and-store operator with standard semantics.
+     * \throw std::range_error if the dimensions of M do not match those of this matrix.
+     */
+    template <typename Matrix>
+    typename boost::enable_if_c< is_readable_matrix<Matrix>::value &&
+                                 is_symmetric_matrix<Matrix>::value,
+    self& >::type operator -=(const Matrix& M) {
+      if((M.get_row_count() != Size) || (M.get_col_count() != Size))
+        throw std::range_error("Matrix dimension mismatch.");
+      for(size_type j = 0; j < Size; ++j)
+        for(size_type i = 0; i <= j; ++i)
+          q[index(i,j)] -= M(i,j);
+      return *this;
+    };
+
+    /**
+     * Scalar-multiply-and-store operator with standard semantics.
+     */
+    self& operator *=(const value_type& S) {
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        q[i] *= S;
+      return *this;
+    };
+
+    /**
+     * Negation operator.
+     * \return The negative of this matrix.
+     */
+    self operator -() const {
+      self result;
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        result.q[i] = -q[i];
+      return result;
+    };
+
+    /**
+     * Transposes the matrix M (which is a no-op for a symmetric matrix).
+     * \param M The matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose(const self& M) {
+      return M;
+    };
+
+    /**
+     * Transposes the matrix M (which is a no-op for a symmetric matrix).
+     * \param M The matrix to be transposed.
+     * \return The transpose of M.
+     */
+    friend self transpose_move(const self& M) {
+      return M;
+    };
+
+    /**
+     * Returns the trace of matrix M.
+     * \param M A matrix.
+     * \return the trace of matrix M.
+     */
+    friend value_type trace(const self& M) {
+      value_type sum = value_type(0);
+      for(size_type i = 0; i < Size; ++i)
+        sum += M.q[mat_triangular_size(i) + i];
+      return sum;
+    };
+
+
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+
+    virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        A & std::pair<std::string, typename ReaK::rtti::get_type_id<T>::save_type >("q",q[i]);
+    };
+    virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
+      for(size_type i = 0; i < (Size * (Size + 1)) / 2; ++i)
+        A & std::pair<std::string, typename ReaK::rtti::get_type_id<T>::load_type >("q",q[i]);
+    };
+
+    RK_RTTI_REGISTER_CLASS_1BASE(self,1,serialization::serializable)
+
+};
+
+
+};
+
+#endif
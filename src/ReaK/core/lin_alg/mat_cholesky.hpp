@@ -50,6 +50,8 @@
 
 #include "mat_alg.hpp"
 #include "mat_num_exceptions.hpp"
+#include "mat_lapack_backend.hpp"
+#include "mat_fixed_decomp.hpp"
 
 namespace ReaK {
 
@@ -65,6 +67,8 @@ void decompose_Cholesky_impl(const Matrix1& A, Matrix2& L, typename mat_traits<M
 {
   using std::sqrt;
   typedef typename mat_traits<Matrix1>::size_type SizeType;
+  if(lapack_decompose_Cholesky(A,L,NumTol))
+    return;
   SizeType N = A.get_row_count();
   for(SizeType i=0;i<N;++i) {
     for(SizeType j=0;j<i;++j) {
@@ -421,9 +425,11 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
                               (mat_traits<Matrix1>::structure == mat_structure::symmetric) ||
                               (mat_traits<Matrix1>::structure == mat_structure::tridiagonal)) &&
                              is_writable_matrix<Matrix2>::value &&
-                             is_resizable_matrix<Matrix2>::value &&
+                             (is_resizable_matrix<Matrix2>::value || is_fixed_size_matrix<Matrix2>::value) &&
                              (mat_traits<Matrix2>::structure != mat_structure::lower_triangular),
 void >::type decompose_Cholesky(const Matrix1& A, Matrix2& L, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
+  if(detail::fixed_decompose_Cholesky(A,L,NumTol))
+    return;
   L.set_col_count(A.get_col_count());
   detail::decompose_Cholesky_impl(A,L,NumTol);
 };
@@ -452,8 +458,10 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
                              is_writable_matrix<Matrix2>::value &&
                              (mat_traits<Matrix2>::structure == mat_structure::lower_triangular),
 void >::type decompose_Cholesky(const Matrix1& A, Matrix2& L, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
+  if(detail::fixed_decompose_Cholesky(A,L,NumTol))
+    return;
   typedef typename mat_traits<Matrix1>::value_type ValueType;
-  mat<ValueType, mat_structure::square> L_tmp(A.get_row_count(),ValueType(0));
+  typename arena_mat<ValueType, mat_structure::square>::type L_tmp(A.get_row_count(),ValueType(0));
   detail::decompose_Cholesky_impl(A,L_tmp,NumTol);
   L = L_tmp;
 };
@@ -507,7 +515,7 @@ typename boost::enable_if_c< is_readable_matrix<Matrix>::value,
 typename mat_traits<Matrix>::value_type >::type determinant_Cholesky(const Matrix& A, typename mat_traits<Matrix>::value_type NumTol = 1E-8) {
   typedef typename mat_traits<Matrix>::value_type ValueType;
   typedef typename mat_traits<Matrix>::value_type SizeType;
-  mat<ValueType, mat_structure::square> L(A.get_row_count(),ValueType(0));
+  typename arena_mat<ValueType, mat_structure::square>::type L(A.get_row_count(),ValueType(0));
   try {
     decompose_Cholesky(A,L,NumTol);
   } catch(singularity_error& e) {
@@ -546,9 +554,13 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
 void >::type linsolve_Cholesky(const Matrix1& A, Matrix2& b, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
   if(b.get_row_count() != A.get_col_count())
     throw std::range_error("For linear equation solution, matrix b must have same row count as A!");
+  if(detail::fixed_linsolve_Cholesky(A,b,NumTol))
+    return;
+  if(detail::lapack_linsolve_Cholesky(A,b,NumTol))
+    return;
 
   typedef typename mat_traits<Matrix1>::value_type ValueType;
-  mat<ValueType,mat_structure::square> L(A.get_row_count(),ValueType(0));
+  typename arena_mat<ValueType,mat_structure::square>::type L(A.get_row_count(),ValueType(0));
   detail::decompose_Cholesky_impl(A,L,NumTol);
   detail::backsub_Cholesky_impl(L,b);
 };
@@ -583,9 +595,9 @@ void >::type linsolve_Cholesky(const Matrix1& A, Matrix2& b, typename mat_traits
     throw std::range_error("For linear equation solution, matrix b must have same row count as A!");
 
   typedef typename mat_traits<Matrix1>::value_type ValueType;
-  mat<ValueType,mat_structure::square> L(A.get_row_count(),ValueType(0));
+  typename arena_mat<ValueType,mat_structure::square>::type L(A.get_row_count(),ValueType(0));
   detail::decompose_Cholesky_impl(A,L,NumTol);
-  mat<typename mat_traits<Matrix2>::value_type, mat_structure::rectangular> b_tmp(b);
+  typename arena_mat<typename mat_traits<Matrix2>::value_type, mat_structure::rectangular>::type b_tmp(b);
   detail::backsub_Cholesky_impl(L,b_tmp);
   b = b_tmp;
 };
@@ -656,7 +668,7 @@ void >::type linsolve_Cholesky(const Matrix1& A, Matrix2& b, typename mat_traits
 
   typedef typename mat_traits<Matrix1>::value_type ValueType;
   typedef typename mat_traits<Matrix1>::size_type SizeType;
-  mat<ValueType,mat_structure::rectangular> b_tmp(b);
+  typename arena_mat<ValueType,mat_structure::rectangular>::type b_tmp(b);
   for(SizeType i = 0; i < A.get_row_count(); ++i) {
     if(A(i,i) < NumTol)
       throw singularity_error("A");
@@ -772,10 +784,12 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
                              is_writable_matrix<Matrix2>::value,
 void >::type invert_Cholesky(const Matrix1& A, Matrix2& A_inv, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
   typedef typename mat_traits<Matrix1>::value_type ValueType;
+  if(detail::fixed_invert_Cholesky(A,A_inv,NumTol))
+    return;
   
-  mat<ValueType,mat_structure::square> L;
+  typename arena_mat<ValueType,mat_structure::square>::type L;
   decompose_Cholesky(A,L,NumTol);
-  mat<ValueType,mat_structure::square> result(mat<ValueType,mat_structure::identity>(A.get_col_count()));
+  typename arena_mat<ValueType,mat_structure::square>::type result(mat<ValueType,mat_structure::identity>(A.get_col_count()));
   detail::backsub_Cholesky_impl(L,result);
   A_inv = result;
 };
@@ -0,0 +1,766 @@
+/**
+ * \file mat_expression_templates.hpp
+ *
+ * This library provides a lazy (expression-template) layer over the matrix and vector arithmetic.
+ * The operators of mat_operators.hpp and vect_alg.hpp evaluate eagerly, meaning that every sum,
+ * difference or product allocates a new matrix (or vector) for its result. With the expressions
+ * of this library, created by wrapping the operands with lazy_expr, the operators only record the
+ * expression, which is then evaluated with evaluate_into into an existing matrix (or vector), which
+ * is only re-allocated if its dimensions change. During the evaluation, the element-wise operations
+ * are fused into a single pass over the destination and the products are computed element by element,
+ * only the nested products (e.g., the A * B in (A * B) * C) are evaluated into a temporary matrix
+ * (drawn from the memory arena of the active arena_scope, if any).
+ * Sandwich products A * B * transpose(A), with a symmetric B, are recognized as symmetric, and only
+ * half of a symmetric result is computed.
+ *
+ * The expressions deliberately do not model the ReadableMatrixConcept (or ReadableVectorConcept), such
+ * that the eager operators never capture them, which also means that all the operands of an expression
+ * must be wrapped with lazy_expr. The operands are held by reference, and so, an expression should not
+ * outlive the matrices it refers to. Finally, the destination of an evaluation should not be one of the
+ * operands of the expression, unless it only appears in element-wise operations or as a factor of a
+ * nested product (the nested products are evaluated before any element of the destination is written).
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_EXPRESSION_TEMPLATES_HPP
+#define REAK_MAT_EXPRESSION_TEMPLATES_HPP
+
+#include <ReaK/core/base/defs.hpp>
+
+#include "mat_alg_general.hpp"
+#include "mat_gemm.hpp"
+#include "vect_alg.hpp"
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+
+/**
+ * This is the base class of all the matrix expressions (CRTP), which is used by the operators
+ * to recognize the matrix expressions.
+ */
+template <typename Derived>
+struct mat_expr_base {
+  const Derived& derived() const { return *static_cast<const Derived*>(this); };
+};
+
+/**
+ * This is the base class of all the vector expressions (CRTP), which is used by the operators
+ * to recognize the vector expressions.
+ */
+template <typename Derived>
+struct vect_expr_base {
+  const Derived& derived() const { return *static_cast<const Derived*>(this); };
+};
+
+
+/**
+ * This class template is the leaf of the matrix expressions, it refers to a readable matrix.
+ */
+template <typename Matrix>
+class mat_expr_leaf : public mat_expr_base< mat_expr_leaf<Matrix> > {
+  public:
+    typedef typename mat_traits<Matrix>::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    const Matrix* m;
+
+  public:
+    explicit mat_expr_leaf(const Matrix& aM) : m(&aM) { };
+
+    value_type operator()(size_type i, size_type j) const { return (*m)(i,j); };
+    size_type get_row_count() const { return m->get_row_count(); };
+    size_type get_col_count() const { return m->get_col_count(); };
+    /// Returns true if the expression is known to evaluate to a symmetric matrix.
+    bool is_symmetric() const { return is_symmetric_matrix<Matrix>::value; };
+    /// Returns the address of the matrix to which this leaf refers (used to recognize sandwich products).
+    const void* get_source() const { return m; };
+    /// Prepares the expression for evaluation (evaluates the nested products).
+    void prepare() const { };
+
+    const Matrix& get_matrix() const { return *m; };
+};
+
+/**
+ * This class template is a matrix expression which holds the value of a (nested) matrix expression,
+ * evaluated (with the given storage alignment) when the enclosing expression is prepared for evaluation.
+ */
+template <typename Expr, mat_alignment::tag Alignment>
+class mat_expr_temporary : public mat_expr_base< mat_expr_temporary<Expr,Alignment> > {
+  public:
+    typedef typename Expr::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr e;
+    mutable typename arena_mat<value_type,mat_structure::rectangular,Alignment>::type m;
+
+  public:
+    explicit mat_expr_temporary(const Expr& aExpr) : e(aExpr), m() { };
+
+    value_type operator()(size_type i, size_type j) const { return m(i,j); };
+    size_type get_row_count() const { return e.get_row_count(); };
+    size_type get_col_count() const { return e.get_col_count(); };
+    bool is_symmetric() const { return e.is_symmetric(); };
+    const void* get_source() const { return NULL; };
+    /// Evaluates the nested expression, must be called before accessing the elements.
+    void prepare() const;
+};
+
+/**
+ * This class template is a matrix expression for the transpose of a matrix expression.
+ */
+template <typename Expr>
+class mat_expr_transpose : public mat_expr_base< mat_expr_transpose<Expr> > {
+  public:
+    typedef typename Expr::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr e;
+
+  public:
+    explicit mat_expr_transpose(const Expr& aExpr) : e(aExpr) { };
+
+    value_type operator()(size_type i, size_type j) const { return e(j,i); };
+    size_type get_row_count() const { return e.get_col_count(); };
+    size_type get_col_count() const { return e.get_row_count(); };
+    bool is_symmetric() const { return e.is_symmetric(); };
+    const void* get_source() const { return NULL; };
+    void prepare() const { e.prepare(); };
+
+    const Expr& get_operand() const { return e; };
+};
+
+/**
+ * This class template is a matrix expression for a matrix expression multiplied by a scalar.
+ */
+template <typename Expr>
+class mat_expr_scaled : public mat_expr_base< mat_expr_scaled<Expr> > {
+  public:
+    typedef typename Expr::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr e;
+    value_type s;
+
+  public:
+    mat_expr_scaled(const Expr& aExpr, const value_type& aScalar) : e(aExpr), s(aScalar) { };
+
+    value_type operator()(size_type i, size_type j) const { return s * e(i,j); };
+    size_type get_row_count() const { return e.get_row_count(); };
+    size_type get_col_count() const { return e.get_col_count(); };
+    bool is_symmetric() const { return e.is_symmetric(); };
+    const void* get_source() const { return NULL; };
+    void prepare() const { e.prepare(); };
+};
+
+
+namespace detail {
+
+struct mat_expr_add {
+  template <typename T>
+  T operator()(const T& a, const T& b) const { return a + b; };
+};
+
+struct mat_expr_sub {
+  template <typename T>
+  T operator()(const T& a, const T& b) const { return a - b; };
+};
+
+};
+
+/**
+ * This class template is a matrix expression for an element-wise operation (sum or difference)
+ * of two matrix expressions.
+ */
+template <typename Expr1, typename Expr2, typename Op>
+class mat_expr_binary : public mat_expr_base< mat_expr_binary<Expr1,Expr2,Op> > {
+  public:
+    typedef typename Expr1::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr1 e1;
+    Expr2 e2;
+
+  public:
+    mat_expr_binary(const Expr1& aExpr1, const Expr2& aExpr2) : e1(aExpr1), e2(aExpr2) {
+      if((e1.get_row_count() != e2.get_row_count()) || (e1.get_col_count() != e2.get_col_count()))
+        throw std::range_error("Matrix dimension mismatch.");
+    };
+
+    value_type operator()(size_type i, size_type j) const { return Op()(e1(i,j), value_type(e2(i,j))); };
+    size_type get_row_count() const { return e1.get_row_count(); };
+    size_type get_col_count() const { return e1.get_col_count(); };
+    bool is_symmetric() const { return e1.is_symmetric() && e2.is_symmetric(); };
+    const void* get_source() const { return NULL; };
+    void prepare() const { e1.prepare(); e2.prepare(); };
+};
+
+
+template <typename Expr1, typename Expr2>
+class mat_expr_product;
+
+
+namespace detail {
+
+/* Evaluates whether a matrix expression contains a product (which would be expensive to re-compute for each element). */
+template <typename Expr>
+struct mat_expr_has_product : boost::mpl::false_ { };
+
+template <typename Expr>
+struct mat_expr_has_product< mat_expr_transpose<Expr> > : mat_expr_has_product<Expr> { };
+
+template <typename Expr>
+struct mat_expr_has_product< mat_expr_scaled<Expr> > : mat_expr_has_product<Expr> { };
+
+template <typename Expr1, typename Expr2, typename Op>
+struct mat_expr_has_product< mat_expr_binary<Expr1,Expr2,Op> > :
+  boost::mpl::bool_< mat_expr_has_product<Expr1>::value || mat_expr_has_product<Expr2>::value > { };
+
+template <typename Expr1, typename Expr2>
+struct mat_expr_has_product< mat_expr_product<Expr1,Expr2> > : boost::mpl::true_ { };
+
+/* The type used to hold an operand of a product, expressions with products are evaluated into a temporary,
+ * stored along the direction in which the product reads it. */
+template <typename Expr, mat_alignment::tag Alignment>
+struct mat_expr_operand {
+  typedef typename boost::mpl::if_< mat_expr_has_product<Expr>,
+    mat_expr_temporary< Expr, Alignment >,
+    Expr >::type type;
+};
+
+/* Recognizes the sandwich products, i.e., A * B * transpose(A) with a symmetric B. */
+template <typename Expr1, typename Expr2>
+bool mat_expr_is_sandwich(const Expr1&, const Expr2&) {
+  return false;
+};
+
+template <typename Expr1, typename Expr2, typename Expr3>
+bool mat_expr_is_sandwich(const mat_expr_product<Expr1,Expr2>& aLeft, const mat_expr_transpose<Expr3>& aRight) {
+  return (aLeft.get_lhs_source() != NULL) && (aLeft.get_lhs_source() == aRight.get_operand().get_source()) && aLeft.is_rhs_symmetric();
+};
+
+};
+
+/**
+ * This class template is a matrix expression for the product of two matrix expressions. The elements
+ * are computed on demand, except for the operands that contain products themselves, which are evaluated
+ * at construction.
+ */
+template <typename Expr1, typename Expr2>
+class mat_expr_product : public mat_expr_base< mat_expr_product<Expr1,Expr2> > {
+  public:
+    typedef typename Expr1::value_type value_type;
+    typedef std::size_t size_type;
+
+    typedef typename detail::mat_expr_operand<Expr1, mat_alignment::row_major>::type lhs_type;
+    typedef typename detail::mat_expr_operand<Expr2, mat_alignment::column_major>::type rhs_type;
+
+  private:
+    const void* lhs_source;
+    bool rhs_sym;
+    bool sym;
+    lhs_type e1;
+    rhs_type e2;
+
+  public:
+    mat_expr_product(const Expr1& aExpr1, const Expr2& aExpr2) :
+                     lhs_source(aExpr1.get_source()), rhs_sym(aExpr2.is_symmetric()),
+                     sym(detail::mat_expr_is_sandwich(aExpr1, aExpr2)), e1(aExpr1), e2(aExpr2) {
+      if(e1.get_col_count() != e2.get_row_count())
+        throw std::range_error("Matrix dimension mismatch.");
+    };
+
+    value_type operator()(size_type i, size_type j) const {
+      value_type result = value_type(0);
+      for(size_type k = 0; k < e1.get_col_count(); ++k)
+        result += e1(i,k) * e2(k,j);
+      return result;
+    };
+    size_type get_row_count() const { return e1.get_row_count(); };
+    size_type get_col_count() const { return e2.get_col_count(); };
+    bool is_symmetric() const { return sym; };
+    const void* get_source() const { return NULL; };
+    void prepare() const { e1.prepare(); e2.prepare(); };
+
+    const void* get_lhs_source() const { return lhs_source; };
+    bool is_rhs_symmetric() const { return rhs_sym; };
+    const lhs_type& get_lhs() const { return e1; };
+    const rhs_type& get_rhs() const { return e2; };
+};
+
+
+/**
+ * This class template is the leaf of the vector expressions, it refers to a readable vector.
+ */
+template <typename Vector>
+class vect_expr_leaf : public vect_expr_base< vect_expr_leaf<Vector> > {
+  public:
+    typedef typename vect_traits<Vector>::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    const Vector* v;
+
+  public:
+    explicit vect_expr_leaf(const Vector& aV) : v(&aV) { };
+
+    value_type operator[](size_type i) const { return (*v)[i]; };
+    size_type size() const { return v->size(); };
+    void prepare() const { };
+};
+
+/**
+ * This class template is a vector expression which holds the value of a (nested) vector expression,
+ * evaluated when the enclosing expression is prepared for evaluation.
+ */
+template <typename Expr>
+class vect_expr_temporary : public vect_expr_base< vect_expr_temporary<Expr> > {
+  public:
+    typedef typename Expr::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr e;
+    mutable typename arena_vect_n<value_type>::type v;
+
+  public:
+    explicit vect_expr_temporary(const Expr& aExpr) : e(aExpr), v() { };
+
+    value_type operator[](size_type i) const { return v[i]; };
+    size_type size() const { return e.size(); };
+    /// Evaluates the nested expression, must be called before accessing the elements.
+    void prepare() const;
+};
+
+/**
+ * This class template is a vector expression for a vector expression multiplied by a scalar.
+ */
+template <typename Expr>
+class vect_expr_scaled : public vect_expr_base< vect_expr_scaled<Expr> > {
+  public:
+    typedef typename Expr::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr e;
+    value_type s;
+
+  public:
+    vect_expr_scaled(const Expr& aExpr, const value_type& aScalar) : e(aExpr), s(aScalar) { };
+
+    value_type operator[](size_type i) const { return s * e[i]; };
+    size_type size() const { return e.size(); };
+    void prepare() const { e.prepare(); };
+};
+
+/**
+ * This class template is a vector expression for an element-wise operation (sum or difference)
+ * of two vector expressions.
+ */
+template <typename Expr1, typename Expr2, typename Op>
+class vect_expr_binary : public vect_expr_base< vect_expr_binary<Expr1,Expr2,Op> > {
+  public:
+    typedef typename Expr1::value_type value_type;
+    typedef std::size_t size_type;
+
+  private:
+    Expr1 e1;
+    Expr2 e2;
+
+  public:
+    vect_expr_binary(const Expr1& aExpr1, const Expr2& aExpr2) : e1(aExpr1), e2(aExpr2) {
+      if(e1.size() != e2.size())
+        throw std::range_error("Vector size mismatch.");
+    };
+
+    value_type operator[](size_type i) const { return Op()(e1[i], value_type(e2[i])); };
+    size_type size() const { return e1.size(); };
+    void prepare() const { e1.prepare(); e2.prepare(); };
+};
+
+
+template <typename MatExpr, typename VectExpr>
+class mat_vect_expr_product;
+
+
+namespace detail {
+
+/* Evaluates whether a vector expression contains a matrix-vector product. */
+template <typename Expr>
+struct vect_expr_has_product : boost::mpl::false_ { };
+
+template <typename Expr>
+struct vect_expr_has_product< vect_expr_scaled<Expr> > : vect_expr_has_product<Expr> { };
+
+template <typename Expr1, typename Expr2, typename Op>
+struct vect_expr_has_product< vect_expr_binary<Expr1,Expr2,Op> > :
+  boost::mpl::bool_< vect_expr_has_product<Expr1>::value || vect_expr_has_product<Expr2>::value > { };
+
+template <typename MatExpr, typename VectExpr>
+struct vect_expr_has_product< mat_vect_expr_product<MatExpr,VectExpr> > : boost::mpl::true_ { };
+
+template <typename Expr>
+struct vect_expr_operand {
+  typedef typename boost::mpl::if_< vect_expr_has_product<Expr>,
+    vect_expr_temporary< Expr >,
+    Expr >::type type;
+};
+
+};
+
+/**
+ * This class template is a vector expression for the product of a matrix expression and a vector
+ * expression. The elements are computed on demand, except for the operands that contain products
+ * themselves, which are evaluated at construction.
+ */
+template <typename MatExpr, typename VectExpr>
+class mat_vect_expr_product : public vect_expr_base< mat_vect_expr_product<MatExpr,VectExpr> > {
+  public:
+    typedef typename MatExpr::value_type value_type;
+    typedef std::size_t size_type;
+
+    typedef typename detail::mat_expr_operand<MatExpr, mat_alignment::row_major>::type lhs_type;
+    typedef typename detail::vect_expr_operand<VectExpr>::type rhs_type;
+
+  private:
+    lhs_type e1;
+    rhs_type e2;
+
+  public:
+    mat_vect_expr_product(const MatExpr& aExpr1, const VectExpr& aExpr2) : e1(aExpr1), e2(aExpr2) {
+      if(e1.get_col_count() != e2.size())
+        throw std::range_error("Matrix dimension mismatch.");
+    };
+
+    value_type operator[](size_type i) const {
+      value_type result = value_type(0);
+      for(size_type k = 0; k < e1.get_col_count(); ++k)
+        result += e1(i,k) * e2[k];
+      return result;
+    };
+    size_type size() const { return e1.get_row_count(); };
+    void prepare() const { e1.prepare(); e2.prepare(); };
+};
+
+
+/*******************************************************************************
+                         Creation of the Expressions
+*******************************************************************************/
+
+/**
+ * Wraps a matrix such that it can be used as an operand of the lazy matrix expressions.
+ * \param M The matrix.
+ * \return The leaf expression which refers to M.
+ */
+template <typename Matrix>
+typename boost::enable_if_c< is_readable_matrix<Matrix>::value,
+mat_expr_leaf<Matrix> >::type lazy_expr(const Matrix& M) {
+  return mat_expr_leaf<Matrix>(M);
+};
+
+/**
+ * Wraps a vector such that it can be used as an operand of the lazy vector expressions.
+ * \param V The vector.
+ * \return The leaf expression which refers to V.
+ */
+template <typename Vector>
+typename boost::enable_if_c< is_readable_vector<Vector>::value && !is_readable_matrix<Vector>::value,
+vect_expr_leaf<Vector> >::type lazy_expr(const Vector& V) {
+  return vect_expr_leaf<Vector>(V);
+};
+
+/**
+ * Lazy transpose of a matrix expression.
+ */
+template <typename Expr>
+mat_expr_transpose<Expr> transpose(const mat_expr_base<Expr>& E) {
+  return mat_expr_transpose<Expr>(E.derived());
+};
+
+/**
+ * Lazy sum of two matrix expressions.
+ */
+template <typename Expr1, typename Expr2>
+mat_expr_binary<Expr1,Expr2,detail::mat_expr_add> operator +(const mat_expr_base<Expr1>& E1, const mat_expr_base<Expr2>& E2) {
+  return mat_expr_binary<Expr1,Expr2,detail::mat_expr_add>(E1.derived(), E2.derived());
+};
+
+/**
+ * Lazy difference of two matrix expressions.
+ */
+template <typename Expr1, typename Expr2>
+mat_expr_binary<Expr1,Expr2,detail::mat_expr_sub> operator -(const mat_expr_base<Expr1>& E1, const mat_expr_base<Expr2>& E2) {
+  return mat_expr_binary<Expr1,Expr2,detail::mat_expr_sub>(E1.derived(), E2.derived());
+};
+
+/**
+ * Lazy negation of a matrix expression.
+ */
+template <typename Expr>
+mat_expr_scaled<Expr> operator -(const mat_expr_base<Expr>& E) {
+  return mat_expr_scaled<Expr>(E.derived(), typename Expr::value_type(-1));
+};
+
+/**
+ * Lazy product of a matrix expression with a scalar.
+ */
+template <typename Expr, typename Scalar>
+typename boost::enable_if< boost::is_convertible< Scalar, typename Expr::value_type >,
+mat_expr_scaled<Expr> >::type operator *(const mat_expr_base<Expr>& E, const Scalar& S) {
+  return mat_expr_scaled<Expr>(E.derived(), S);
+};
+
+/**
+ * Lazy product of a scalar with a matrix expression.
+ */
+template <typename Expr, typename Scalar>
+typename boost::enable_if< boost::is_convertible< Scalar, typename Expr::value_type >,
+mat_expr_scaled<Expr> >::type operator *(const Scalar& S, const mat_expr_base<Expr>& E) {
+  return mat_expr_scaled<Expr>(E.derived(), S);
+};
+
+/**
+ * Lazy product of two matrix expressions.
+ */
+template <typename Expr1, typename Expr2>
+mat_expr_product<Expr1,Expr2> operator *(const mat_expr_base<Expr1>& E1, const mat_expr_base<Expr2>& E2) {
+  return mat_expr_product<Expr1,Expr2>(E1.derived(), E2.derived());
+};
+
+/**
+ * This meta-function gives the type of the sandwich product expression A * B * transpose(A).
+ */
+template <typename Matrix1, typename Matrix2>
+struct mat_sandwich_expr {
+  typedef mat_expr_product< mat_expr_product< mat_expr_leaf<Matrix1>, mat_expr_leaf<Matrix2> >,
+                            mat_expr_transpose< mat_expr_leaf<Matrix1> > > type;
+};
+
+/**
+ * Creates the lazy sandwich product A * B * transpose(A), which is recognized as symmetric when B is a
+ * symmetric matrix (e.g., the propagation of a covariance matrix through a linear map). Only A * B is
+ * evaluated into a temporary, at construction.
+ * \param A The outer matrix of the product.
+ * \param B The inner matrix of the product.
+ * \return The lazy expression for A * B * transpose(A).
+ */
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_readable_matrix<Matrix1>::value && is_readable_matrix<Matrix2>::value,
+typename mat_sandwich_expr<Matrix1,Matrix2>::type >::type sandwich_product(const Matrix1& A, const Matrix2& B) {
+  return lazy_expr(A) * lazy_expr(B) * transpose(lazy_expr(A));
+};
+
+/**
+ * Lazy sum of two vector expressions.
+ */
+template <typename Expr1, typename Expr2>
+vect_expr_binary<Expr1,Expr2,detail::mat_expr_add> operator +(const vect_expr_base<Expr1>& E1, const vect_expr_base<Expr2>& E2) {
+  return vect_expr_binary<Expr1,Expr2,detail::mat_expr_add>(E1.derived(), E2.derived());
+};
+
+/**
+ * Lazy difference of two vector expressions.
+ */
+template <typename Expr1, typename Expr2>
+vect_expr_binary<Expr1,Expr2,detail::mat_expr_sub> operator -(const vect_expr_base<Expr1>& E1, const vect_expr_base<Expr2>& E2) {
+  return vect_expr_binary<Expr1,Expr2,detail::mat_expr_sub>(E1.derived(), E2.derived());
+};
+
+/**
+ * Lazy negation of a vector expression.
+ */
+template <typename Expr>
+vect_expr_scaled<Expr> operator -(const vect_expr_base<Expr>& E) {
+  return vect_expr_scaled<Expr>(E.derived(), typename Expr::value_type(-1));
+};
+
+/**
+ * Lazy product of a vector expression with a scalar.
+ */
+template <typename Expr, typename Scalar>
+typename boost::enable_if< boost::is_convertible< Scalar, typename Expr::value_type >,
+vect_expr_scaled<Expr> >::type operator *(const vect_expr_base<Expr>& E, const Scalar& S) {
+  return vect_expr_scaled<Expr>(E.derived(), S);
+};
+
+/**
+ * Lazy product of a scalar with a vector expression.
+ */
+template <typename Expr, typename Scalar>
+typename boost::enable_if< boost::is_convertible< Scalar, typename Expr::value_type >,
+vect_expr_scaled<Expr> >::type operator *(const Scalar& S, const vect_expr_base<Expr>& E) {
+  return vect_expr_scaled<Expr>(E.derived(), S);
+};
+
+/**
+ * Lazy product of a matrix expression with a vector expression.
+ */
+template <typename MatExpr, typename VectExpr>
+mat_vect_expr_product<MatExpr,VectExpr> operator *(const mat_expr_base<MatExpr>& M, const vect_expr_base<VectExpr>& V) {
+  return mat_vect_expr_product<MatExpr,VectExpr>(M.derived(), V.derived());
+};
+
+
+/*******************************************************************************
+                         Evaluation of the Expressions
+*******************************************************************************/
+
+namespace detail {
+
+template <typename Matrix>
+typename boost::enable_if_c< is_resizable_matrix<Matrix>::value,
+void >::type mat_expr_prepare_result(Matrix& M, std::size_t aRowCount, std::size_t aColCount) {
+  if((M.get_row_count() != aRowCount) || (M.get_col_count() != aColCount))
+    M.resize(std::make_pair(aRowCount, aColCount));
+};
+
+template <typename Matrix>
+typename boost::enable_if_c< !is_resizable_matrix<Matrix>::value,
+void >::type mat_expr_prepare_result(Matrix& M, std::size_t aRowCount, std::size_t aColCount) {
+  if((M.get_row_count() != aRowCount) || (M.get_col_count() != aColCount))
+    throw std::range_error("Matrix dimension mismatch.");
+};
+
+template <typename Vector>
+typename boost::enable_if_c< is_resizable_vector<Vector>::value,
+void >::type vect_expr_prepare_result(Vector& V, std::size_t aSize) {
+  if(V.size() != aSize)
+    V.resize(aSize);
+};
+
+template <typename Vector>
+typename boost::enable_if_c< !is_resizable_vector<Vector>::value,
+void >::type vect_expr_prepare_result(Vector& V, std::size_t aSize) {
+  if(V.size() != aSize)
+    throw std::range_error("Vector size mismatch.");
+};
+
+};
+
+/**
+ * Evaluates a matrix expression into a matrix, which is resized if needed (if it is resizable).
+ * All elements are computed in a single pass. If the expression is known to be symmetric, or if the
+ * destination is a symmetric matrix, only the upper triangle of the result is computed.
+ * \param aExpr The matrix expression.
+ * \param aResult The matrix in which to store the result.
+ */
+template <typename Expr, typename Matrix>
+void evaluate_into(const mat_expr_base<Expr>& aExpr, Matrix& aResult) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  const Expr& e = aExpr.derived();
+  e.prepare();
+  const std::size_t rows = e.get_row_count();
+  const std::size_t cols = e.get_col_count();
+  detail::mat_expr_prepare_result(aResult, rows, cols);
+  if(mat_traits<Matrix>::structure == mat_structure::symmetric) {
+    for(std::size_t j = 0; j < cols; ++j)
+      for(std::size_t i = 0; (i <= j) && (i < rows); ++i)
+        aResult(i,j) = ValueType(e(i,j));
+  } else if(e.is_symmetric()) {
+    for(std::size_t j = 0; j < cols; ++j) {
+      for(std::size_t i = 0; i < j; ++i) {
+        ValueType v = ValueType(e(i,j));
+        aResult(i,j) = v;
+        aResult(j,i) = v;
+      };
+      aResult(j,j) = ValueType(e(j,j));
+    };
+  } else {
+    for(std::size_t j = 0; j < cols; ++j)
+      for(std::size_t i = 0; i < rows; ++i)
+        aResult(i,j) = ValueType(e(i,j));
+  };
+};
+
+/**
+ * Evaluates the product of two dense matrices into a dense matrix, using the cache-blocked product kernel.
+ * \param aExpr The matrix product expression.
+ * \param aResult The matrix in which to store the result.
+ */
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+typename boost::enable_if_c< detail::is_dense_gemm_compatible<Matrix1,Matrix2,ResultMatrix>::value,
+void >::type evaluate_into(const mat_expr_product< mat_expr_leaf<Matrix1>, mat_expr_leaf<Matrix2> >& aExpr, ResultMatrix& aResult) {
+  typedef typename mat_traits<ResultMatrix>::value_type ValueType;
+  const Matrix1& M1 = aExpr.get_lhs().get_matrix();
+  const Matrix2& M2 = aExpr.get_rhs().get_matrix();
+  if((static_cast<const void*>(&aResult) == aExpr.get_lhs().get_source()) ||
+     (static_cast<const void*>(&aResult) == aExpr.get_rhs().get_source())) {
+    // the destination is an operand, the product must go through a temporary.
+    typename arena_mat<ValueType,mat_structure::rectangular>::type tmp(M1.get_row_count(), M2.get_col_count());
+    detail::dense_gemm_impl(M1, M2, tmp);
+    aResult = tmp;
+    return;
+  };
+  detail::mat_expr_prepare_result(aResult, M1.get_row_count(), M2.get_col_count());
+  detail::dense_gemm_impl(M1, M2, aResult);
+};
+
+/**
+ * Evaluates a vector expression into a vector, which is resized if needed (if it is resizable).
+ * \param aExpr The vector expression.
+ * \param aResult The vector in which to store the result.
+ */
+template <typename Expr, typename Vector>
+void evaluate_into(const vect_expr_base<Expr>& aExpr, Vector& aResult) {
+  typedef typename vect_traits<Vector>::value_type ValueType;
+  const Expr& e = aExpr.derived();
+  e.prepare();
+  const std::size_t n = e.size();
+  detail::vect_expr_prepare_result(aResult, n);
+  for(std::size_t i = 0; i < n; ++i)
+    aResult[i] = ValueType(e[i]);
+};
+
+
+template <typename Expr, mat_alignment::tag Alignment>
+void mat_expr_temporary<Expr,Alignment>::prepare() const {
+  evaluate_into(e, m);
+};
+
+template <typename Expr>
+void vect_expr_temporary<Expr>::prepare() const {
+  evaluate_into(e, v);
+};
+
+
+};
+
+#endif
@@ -0,0 +1,403 @@
+/**
+ * \file mat_fixed_decomp.hpp
+ *
+ * This library provides the fixed-size versions of the Cholesky, PLU (Crout) and QR (Householder)
+ * decompositions, and of the linear solvers and inversions based on them. These are selected
+ * (through the static row and column counts of the mat_traits) by the general methods (from
+ * mat_cholesky.hpp, mat_gaussian_elim.hpp and mat_qr_decomp.hpp) whenever the input matrix has
+ * dimensions fixed at compile-time (e.g., mat_fix, or the rotation matrices). All the loops have
+ * compile-time bounds (which allows the compiler to unroll them completely for small matrices) and
+ * all the temporaries are fixed-size matrices and arrays, such that, if the outputs are also
+ * fixed-size matrices, no dynamic memory allocation is ever performed, as required for hard
+ * real-time applications.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_FIXED_DECOMP_HPP
+#define REAK_MAT_FIXED_DECOMP_HPP
+
+#include "mat_alg.hpp"
+#include "mat_num_exceptions.hpp"
+
+#include <boost/utility/enable_if.hpp>
+
+#include <cmath>
+
+namespace ReaK {
+
+
+/**
+ * This meta-function evaluates whether a matrix type has both of its dimensions fixed at
+ * compile-time (as given by the static row and column counts of its mat_traits).
+ */
+template <typename Matrix>
+struct is_fixed_size_matrix {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef bool value_type;
+  BOOST_STATIC_CONSTANT( bool, value = ((mat_traits<Matrix>::static_row_count != 0) &&
+                                        (mat_traits<Matrix>::static_col_count != 0)) );
+  typedef is_fixed_size_matrix<Matrix> type;
+};
+
+/**
+ * This meta-function evaluates whether a matrix type is square with a dimension fixed at compile-time.
+ */
+template <typename Matrix>
+struct is_fixed_square_matrix {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef bool value_type;
+  BOOST_STATIC_CONSTANT( bool, value = ((mat_traits<Matrix>::static_row_count != 0) &&
+                                        (mat_traits<Matrix>::static_row_count == mat_traits<Matrix>::static_col_count)) );
+  typedef is_fixed_square_matrix<Matrix> type;
+};
+
+
+namespace detail {
+
+
+/*************************************************************************
+                        Fixed-size kernels
+*************************************************************************/
+
+template <unsigned int Size, typename Matrix1, typename Matrix2>
+void fixed_decompose_Cholesky_impl(const Matrix1& A, Matrix2& L, typename mat_traits<Matrix1>::value_type NumTol) {
+  using std::sqrt;
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  for(std::size_t i = 0; i < Size; ++i) {
+    for(std::size_t j = 0; j < i; ++j) {
+      ValueType sum = A(i,j);
+      for(std::size_t k = 0; k < j; ++k)
+        sum -= L(i,k) * L(j,k);
+      L(i,j) = sum / L(j,j);
+    };
+    ValueType sum = A(i,i);
+    for(std::size_t k = 0; k < i; ++k)
+      sum -= L(i,k) * L(i,k);
+    if(sum < NumTol)
+      throw singularity_error("A");
+    L(i,i) = sqrt(sum);
+  };
+};
+
+template <unsigned int Size, typename Matrix1, typename Matrix2>
+void fixed_backsub_Cholesky_impl(const Matrix1& L, Matrix2& B) {
+  typedef typename mat_traits<Matrix2>::value_type ValueType;
+  for(std::size_t j = 0; j < B.get_col_count(); ++j) {
+    // solve L * Y = B
+    for(std::size_t i = 0; i < Size; ++i) {
+      ValueType sum = B(i,j);
+      for(std::size_t k = 0; k < i; ++k)
+        sum -= L(i,k) * B(k,j);
+      B(i,j) = sum / L(i,i);
+    };
+    // then solve L^T * X = Y
+    for(std::size_t i = Size; i-- > 0; ) {
+      ValueType sum = B(i,j);
+      for(std::size_t k = i + 1; k < Size; ++k)
+        sum -= L(k,i) * B(k,j);
+      B(i,j) = sum / L(i,i);
+    };
+  };
+};
+
+/* Crout's method with scaled partial pivoting (as in linsolve_PLU_impl), with a fixed-size workspace. */
+template <unsigned int Size, unsigned int ColCount, typename Matrix1, typename Matrix2, typename IndexVector>
+void fixed_linsolve_PLU_impl(Matrix1& A, Matrix2& b, IndexVector& P, typename mat_traits<Matrix1>::value_type NumTol) {
+  using std::swap;
+  using std::fabs;
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+
+  mat_fix<ValueType,mat_structure::rectangular,Size,ColCount> s;
+
+  for(std::size_t i = 0; i < Size; ++i) {
+    P[i] = i;
+    for(std::size_t j = 0; j < Size; ++j)
+      if(s(i,0) < fabs(A(i,j)))
+        s(i,0) = fabs(A(i,j));
+  };
+
+  for(std::size_t k = 0; k < Size; ++k) {
+
+    for(std::size_t i = k; i < Size; ++i)
+      for(std::size_t j = 0; j < k; ++j)
+        A(i,k) -= A(i,j) * A(j,k);
+
+    std::size_t temp_i = k;
+    for(std::size_t i = k + 1; i < Size; ++i)
+      if(fabs(A(i,k) / s(i,0)) > fabs(A(temp_i,k) / s(temp_i,0)))
+        temp_i = i;
+
+    if(k != temp_i) {
+      for(std::size_t i = 0; i < Size; ++i)
+        swap(A(k,i),A(temp_i,i));
+      swap(s(k,0), s(temp_i,0));
+      swap(P[k], P[temp_i]);
+    };
+
+    if(fabs(A(k,k)) < NumTol)
+      throw singularity_error("A");
+    for(std::size_t j = k + 1; j < Size; ++j) {
+      for(std::size_t i = 0; i < k; ++i)
+        A(k,j) -= A(k,i) * A(i,j);
+      A(k,j) /= A(k,k);
+    };
+  };
+
+  // Back-substitution
+  for(std::size_t k = 0; k < Size; ++k) {
+    for(std::size_t l = 0; l < ColCount; ++l) {
+      ValueType sum = b(P[k],l);
+      for(std::size_t j = 0; j < k; ++j)
+        sum -= A(k,j) * s(j,l);
+      s(k,l) = sum / A(k,k);
+    };
+  };
+
+  for(std::size_t k = Size; k-- > 0; ) {
+    for(std::size_t l = 0; l < ColCount; ++l) {
+      ValueType sum = s(k,l);
+      for(std::size_t j = k + 1; j < Size; ++j)
+        sum -= A(k,j) * b(j,l);
+      b(k,l) = sum;
+    };
+  };
+};
+
+/* Householder QR decomposition of R (in-place), accumulating the reflections into Q and applying them to B. */
+template <unsigned int RowCount, unsigned int ColCount, typename Matrix1, typename Matrix2, typename Matrix3>
+void fixed_decompose_QR_impl(Matrix1& R, Matrix2* Q, Matrix3* B, typename mat_traits<Matrix1>::value_type NumTol) {
+  using std::sqrt;
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+
+  ValueType v[RowCount];
+  const std::size_t t = (RowCount - 1 > ColCount ? ColCount : RowCount - 1);
+
+  for(std::size_t i = 0; i < t; ++i) {
+    ValueType x_norm = ValueType(0);
+    for(std::size_t k = i; k < RowCount; ++k) {
+      v[k] = R(k,i);
+      x_norm += v[k] * v[k];
+    };
+    x_norm = sqrt(x_norm);
+    if(x_norm < NumTol)
+      continue;
+    ValueType alpha = (v[i] > ValueType(0) ? -x_norm : x_norm);
+    v[i] -= alpha;
+    ValueType v_scale = ValueType(0);
+    for(std::size_t k = i; k < RowCount; ++k)
+      v_scale += v[k] * v[k];
+    v_scale = ValueType(2) / v_scale;
+
+    R(i,i) = alpha;
+    for(std::size_t k = i + 1; k < RowCount; ++k)
+      R(k,i) = ValueType(0);
+    for(std::size_t j = i + 1; j < ColCount; ++j) {
+      ValueType s = ValueType(0);
+      for(std::size_t k = i; k < RowCount; ++k)
+        s += v[k] * R(k,j);
+      s *= v_scale;
+      for(std::size_t k = i; k < RowCount; ++k)
+        R(k,j) -= s * v[k];
+    };
+    if(Q) {
+      for(std::size_t j = 0; j < RowCount; ++j) {
+        ValueType s = ValueType(0);
+        for(std::size_t k = i; k < RowCount; ++k)
+          s += (*Q)(j,k) * v[k];
+        s *= v_scale;
+        for(std::size_t k = i; k < RowCount; ++k)
+          (*Q)(j,k) -= s * v[k];
+      };
+    };
+    if(B) {
+      for(std::size_t j = 0; j < B->get_col_count(); ++j) {
+        ValueType s = ValueType(0);
+        for(std::size_t k = i; k < RowCount; ++k)
+          s += v[k] * (*B)(k,j);
+        s *= v_scale;
+        for(std::size_t k = i; k < RowCount; ++k)
+          (*B)(k,j) -= s * v[k];
+      };
+    };
+  };
+};
+
+
+/*************************************************************************
+      Dispatch functions (used by the general numerical methods)
+*************************************************************************/
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_decompose_Cholesky(const Matrix1& A, Matrix2& L, typename mat_traits<Matrix1>::value_type NumTol) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  mat_fix<ValueType,mat_structure::square,mat_traits<Matrix1>::static_row_count> L_tmp;
+  fixed_decompose_Cholesky_impl<mat_traits<Matrix1>::static_row_count>(A,L_tmp,NumTol);
+  L = L_tmp;
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_decompose_Cholesky(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_linsolve_Cholesky(const Matrix1& A, Matrix2& b, typename mat_traits<Matrix1>::value_type NumTol) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  mat_fix<ValueType,mat_structure::square,mat_traits<Matrix1>::static_row_count> L;
+  fixed_decompose_Cholesky_impl<mat_traits<Matrix1>::static_row_count>(A,L,NumTol);
+  fixed_backsub_Cholesky_impl<mat_traits<Matrix1>::static_row_count>(L,b);
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_linsolve_Cholesky(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_invert_Cholesky(const Matrix1& A, Matrix2& A_inv, typename mat_traits<Matrix1>::value_type NumTol) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  const unsigned int Size = mat_traits<Matrix1>::static_row_count;
+  mat_fix<ValueType,mat_structure::square,Size> L;
+  fixed_decompose_Cholesky_impl<Size>(A,L,NumTol);
+  mat_fix<ValueType,mat_structure::square,Size> result((mat<ValueType,mat_structure::identity>(Size)));
+  fixed_backsub_Cholesky_impl<Size>(L,result);
+  A_inv = result;
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_invert_Cholesky(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename IndexVector>
+typename boost::enable_if_c< is_fixed_square_matrix<Matrix1>::value &&
+                             is_fixed_size_matrix<Matrix2>::value,
+bool >::type fixed_linsolve_PLU(Matrix1& A, Matrix2& b, IndexVector& P, typename mat_traits<Matrix1>::value_type NumTol) {
+  fixed_linsolve_PLU_impl<mat_traits<Matrix1>::static_row_count, mat_traits<Matrix2>::static_col_count>(A,b,P,NumTol);
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2, typename IndexVector>
+typename boost::enable_if_c< !(is_fixed_square_matrix<Matrix1>::value &&
+                               is_fixed_size_matrix<Matrix2>::value),
+bool >::type fixed_linsolve_PLU(Matrix1&, Matrix2&, IndexVector&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_invert_PLU(const Matrix1& A, Matrix2& A_inv, typename mat_traits<Matrix1>::value_type NumTol) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  const unsigned int Size = mat_traits<Matrix1>::static_row_count;
+  mat_fix<ValueType,mat_structure::square,Size> LU(A);
+  mat_fix<ValueType,mat_structure::square,Size> result((mat<ValueType,mat_structure::identity>(Size)));
+  std::size_t P[Size];
+  fixed_linsolve_PLU_impl<Size,Size>(LU,result,P,NumTol);
+  A_inv = result;
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_fixed_square_matrix<Matrix1>::value,
+bool >::type fixed_invert_PLU(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_fixed_size_matrix<Matrix1>::value,
+bool >::type fixed_decompose_QR(const Matrix1& A, Matrix2& Q, Matrix3& R, typename mat_traits<Matrix1>::value_type NumTol) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  const unsigned int RowCount = mat_traits<Matrix1>::static_row_count;
+  const unsigned int ColCount = mat_traits<Matrix1>::static_col_count;
+  typedef mat_fix<ValueType,mat_structure::rectangular,RowCount,ColCount> RMatrix;
+  typedef mat_fix<ValueType,mat_structure::square,RowCount> QMatrix;
+  RMatrix R_tmp(A);
+  QMatrix Q_tmp((mat<ValueType,mat_structure::identity>(RowCount)));
+  fixed_decompose_QR_impl<RowCount,ColCount>(R_tmp,&Q_tmp,static_cast<RMatrix*>(NULL),NumTol);
+  Q = Q_tmp;
+  R = R_tmp;
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< !is_fixed_size_matrix<Matrix1>::value,
+bool >::type fixed_decompose_QR(const Matrix1&, Matrix2&, Matrix3&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_fixed_size_matrix<Matrix1>::value &&
+                             is_fixed_size_matrix<Matrix3>::value,
+bool >::type fixed_linlsq_QR(const Matrix1& A, Matrix2& x, const Matrix3& b, typename mat_traits<Matrix1>::value_type NumTol) {
+  using std::fabs;
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  const unsigned int RowCount = mat_traits<Matrix1>::static_row_count;
+  const unsigned int ColCount = mat_traits<Matrix1>::static_col_count;
+  const unsigned int RHSCount = mat_traits<Matrix3>::static_col_count;
+  mat_fix<ValueType,mat_structure::rectangular,RowCount,ColCount> R(A);
+  mat_fix<ValueType,mat_structure::rectangular,RowCount,RHSCount> b_store(b);
+  fixed_decompose_QR_impl<RowCount,ColCount>(R,static_cast<mat_fix<ValueType,mat_structure::square,RowCount>*>(NULL),&b_store,NumTol);
+
+  //back-substitution
+  x.set_row_count(ColCount);
+  x.set_col_count(RHSCount);
+  for(std::size_t i = ColCount; i-- > 0; ) {
+    if(fabs(R(i,i)) < NumTol)
+      throw singularity_error("R");
+    for(std::size_t j = 0; j < RHSCount; ++j) {
+      ValueType sum = b_store(i,j);
+      for(std::size_t k = i + 1; k < ColCount; ++k)
+        sum -= x(k,j) * R(i,k);
+      x(i,j) = sum / R(i,i);
+    };
+  };
+  return true;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< !(is_fixed_size_matrix<Matrix1>::value &&
+                               is_fixed_size_matrix<Matrix3>::value),
+bool >::type fixed_linlsq_QR(const Matrix1&, Matrix2&, const Matrix3&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+
+};
+
+
+};
+
+#endif
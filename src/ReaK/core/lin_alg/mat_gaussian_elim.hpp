@@ -47,6 +47,7 @@
 
 #include "mat_alg.hpp"
 #include "mat_num_exceptions.hpp"
+#include "mat_fixed_decomp.hpp"
 
 namespace ReaK {
 
@@ -82,6 +83,8 @@ void >::type invert_gaussian(const Matrix1& A, Matrix2& A_inv, typename mat_trai
    
   if(A.get_col_count() != A.get_row_count())
     throw std::range_error("Inversion impossible! Matrix A is not square!");
+  if(detail::fixed_invert_PLU(A,A_inv,NumTol))
+    return;
   
   SizeType Size = A.get_col_count();
   Matrix2 tmp(A);
@@ -234,6 +237,8 @@ template <typename Matrix1, typename Matrix2, typename IndexVector>
 typename boost::enable_if_c< is_fully_writable_matrix< Matrix1 >::value && 
                              is_fully_writable_matrix< Matrix2 >::value, 
 void >::type linsolve_PLU_dispatch(Matrix1& A, Matrix2& b, IndexVector& P, typename mat_traits<Matrix1>::value_type NumTol) {
+  if(fixed_linsolve_PLU(A,b,P,NumTol))
+    return;
   linsolve_PLU_impl(A,b,P,NumTol);
 };
 
@@ -330,7 +335,7 @@ void >::type linsolve_PLU(Matrix1& A, Matrix2& b, IndexVector& P, typename mat_t
  *
  * \author Mikael Persson
  */
-template <typename Matrix1, typename Matrix2, typename IndexVector>
+template <typename Matrix1, typename Matrix2>
 typename boost::enable_if_c< is_writable_matrix< Matrix1 >::value && 
                              is_writable_matrix< Matrix2 >::value, 
 void >::type linsolve_PLU(Matrix1& A, Matrix2& b, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
@@ -436,6 +441,8 @@ void >::type invert_PLU(Matrix1 A,Matrix2& A_inv, typename mat_traits<Matrix1>::
   
   if(A.get_col_count() != A.get_row_count())
     throw std::range_error("PLU decomposition impossible! Matrix A is not square!");
+  if(detail::fixed_invert_PLU(A,A_inv,NumTol))
+    return;
 
   A_inv = mat<ValueType,mat_structure::identity>(A.get_col_count());
   vect_n<unsigned int> P(A.get_col_count());
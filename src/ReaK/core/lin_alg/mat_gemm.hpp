@@ -0,0 +1,367 @@
+/**
+ * \file mat_gemm.hpp
+ *
+ * This library provides the dense matrix-multiplication kernels that are used by the matrix
+ * operators for matrices with contiguous storage (see detail::dense_mat_multiply_impl). The
+ * kernels work on raw arrays with arbitrary row and column strides, such that the same code
+ * handles the column-major and row-major matrices (and their combinations). Large products are
+ * computed with a packed, cache-blocked algorithm (in the style of GotoBLAS), built around a small
+ * register-blocked micro-kernel, which uses AVX2 / FMA (or SSE2) instructions when these are enabled
+ * at compile-time. Small products use a simple loop ordered along the storage of the matrices.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_GEMM_HPP
+#define REAK_MAT_GEMM_HPP
+
+#include <ReaK/core/base/defs.hpp>
+
+#include "mat_alg_general.hpp"
+
+#include <boost/type_traits.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+
+namespace detail {
+
+/*
+ * Blocking parameters of the packed matrix product. The micro-kernel computes a gemm_mr x gemm_nr
+ * block of the result, from packed panels of gemm_kc columns of the first matrix and gemm_kc rows
+ * of the second matrix. The panels of the first matrix (gemm_mc x gemm_kc) are sized to stay in
+ * the L2 cache, and those of the second matrix (gemm_kc x gemm_nc) to stay in the L3 cache.
+ */
+const std::size_t gemm_mr = 8;
+const std::size_t gemm_nr = 6;
+const std::size_t gemm_mc = 96;
+const std::size_t gemm_kc = 256;
+const std::size_t gemm_nc = 2040;
+
+/* Products with fewer multiply-adds than this are computed without packing. */
+const std::size_t gemm_packing_threshold = 16 * 16 * 16;
+
+
+/* Packs a block (mc x kc) of the first matrix into panels of gemm_mr rows, zero-padded, where each panel is stored column by column. */
+template <typename T>
+void gemm_pack_lhs(std::size_t mc, std::size_t kc, const T* A, std::ptrdiff_t rsA, std::ptrdiff_t csA, T* buf) {
+  for(std::size_t ir = 0; ir < mc; ir += gemm_mr) {
+    std::size_t mr = (mc - ir < gemm_mr ? mc - ir : gemm_mr);
+    const T* a = A + std::ptrdiff_t(ir) * rsA;
+    for(std::size_t p = 0; p < kc; ++p, buf += gemm_mr) {
+      const T* a_p = a + std::ptrdiff_t(p) * csA;
+      std::size_t i = 0;
+      for(; i < mr; ++i)
+        buf[i] = a_p[std::ptrdiff_t(i) * rsA];
+      for(; i < gemm_mr; ++i)
+        buf[i] = T(0.0);
+    };
+  };
+};
+
+/* Packs a block (kc x nc) of the second matrix into panels of gemm_nr columns, zero-padded, where each panel is stored row by row. */
+template <typename T>
+void gemm_pack_rhs(std::size_t kc, std::size_t nc, const T* B, std::ptrdiff_t rsB, std::ptrdiff_t csB, T* buf) {
+  for(std::size_t jr = 0; jr < nc; jr += gemm_nr) {
+    std::size_t nr = (nc - jr < gemm_nr ? nc - jr : gemm_nr);
+    const T* b = B + std::ptrdiff_t(jr) * csB;
+    for(std::size_t p = 0; p < kc; ++p, buf += gemm_nr) {
+      const T* b_p = b + std::ptrdiff_t(p) * rsB;
+      std::size_t j = 0;
+      for(; j < nr; ++j)
+        buf[j] = b_p[std::ptrdiff_t(j) * csB];
+      for(; j < gemm_nr; ++j)
+        buf[j] = T(0.0);
+    };
+  };
+};
+
+/* Computes the (gemm_mr x gemm_nr) product of a packed panel pair, into C (column-major, leading dimension gemm_mr). */
+template <typename T>
+void gemm_micro_kernel(std::size_t kc, const T* a, const T* b, T* C) {
+  T acc[gemm_nr][gemm_mr];
+  for(std::size_t j = 0; j < gemm_nr; ++j)
+    for(std::size_t i = 0; i < gemm_mr; ++i)
+      acc[j][i] = T(0.0);
+  for(std::size_t p = 0; p < kc; ++p, a += gemm_mr, b += gemm_nr)
+    for(std::size_t j = 0; j < gemm_nr; ++j)
+      for(std::size_t i = 0; i < gemm_mr; ++i)
+        acc[j][i] += a[i] * b[j];
+  for(std::size_t j = 0; j < gemm_nr; ++j)
+    for(std::size_t i = 0; i < gemm_mr; ++i)
+      C[j * gemm_mr + i] = acc[j][i];
+};
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+/* AVX2 / FMA version of the micro-kernel for doubles: 12 accumulators of 4 doubles (8 rows by 6 columns). */
+inline void gemm_micro_kernel(std::size_t kc, const double* a, const double* b, double* C) {
+  __m256d c00 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd();
+  __m256d c01 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c02 = _mm256_setzero_pd(), c12 = _mm256_setzero_pd();
+  __m256d c03 = _mm256_setzero_pd(), c13 = _mm256_setzero_pd();
+  __m256d c04 = _mm256_setzero_pd(), c14 = _mm256_setzero_pd();
+  __m256d c05 = _mm256_setzero_pd(), c15 = _mm256_setzero_pd();
+  for(std::size_t p = 0; p < kc; ++p, a += gemm_mr, b += gemm_nr) {
+    __m256d a0 = _mm256_loadu_pd(a);
+    __m256d a1 = _mm256_loadu_pd(a + 4);
+    __m256d bj = _mm256_broadcast_sd(b);
+    c00 = _mm256_fmadd_pd(a0, bj, c00); c10 = _mm256_fmadd_pd(a1, bj, c10);
+    bj = _mm256_broadcast_sd(b + 1);
+    c01 = _mm256_fmadd_pd(a0, bj, c01); c11 = _mm256_fmadd_pd(a1, bj, c11);
+    bj = _mm256_broadcast_sd(b + 2);
+    c02 = _mm256_fmadd_pd(a0, bj, c02); c12 = _mm256_fmadd_pd(a1, bj, c12);
+    bj = _mm256_broadcast_sd(b + 3);
+    c03 = _mm256_fmadd_pd(a0, bj, c03); c13 = _mm256_fmadd_pd(a1, bj, c13);
+    bj = _mm256_broadcast_sd(b + 4);
+    c04 = _mm256_fmadd_pd(a0, bj, c04); c14 = _mm256_fmadd_pd(a1, bj, c14);
+    bj = _mm256_broadcast_sd(b + 5);
+    c05 = _mm256_fmadd_pd(a0, bj, c05); c15 = _mm256_fmadd_pd(a1, bj, c15);
+  };
+  _mm256_storeu_pd(C,      c00); _mm256_storeu_pd(C + 4,  c10);
+  _mm256_storeu_pd(C + 8,  c01); _mm256_storeu_pd(C + 12, c11);
+  _mm256_storeu_pd(C + 16, c02); _mm256_storeu_pd(C + 20, c12);
+  _mm256_storeu_pd(C + 24, c03); _mm256_storeu_pd(C + 28, c13);
+  _mm256_storeu_pd(C + 32, c04); _mm256_storeu_pd(C + 36, c14);
+  _mm256_storeu_pd(C + 40, c05); _mm256_storeu_pd(C + 44, c15);
+};
+
+#elif defined(__SSE2__)
+
+/* SSE2 version of the micro-kernel for doubles: two passes over 4 rows, with 12 accumulators of 2 doubles (4 rows by 6 columns). */
+inline void gemm_micro_kernel(std::size_t kc, const double* a, const double* b, double* C) {
+  for(std::size_t h = 0; h < gemm_mr; h += 4) {
+    __m128d c00 = _mm_setzero_pd(), c10 = _mm_setzero_pd();
+    __m128d c01 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+    __m128d c02 = _mm_setzero_pd(), c12 = _mm_setzero_pd();
+    __m128d c03 = _mm_setzero_pd(), c13 = _mm_setzero_pd();
+    __m128d c04 = _mm_setzero_pd(), c14 = _mm_setzero_pd();
+    __m128d c05 = _mm_setzero_pd(), c15 = _mm_setzero_pd();
+    const double* a_h = a + h;
+    const double* b_p = b;
+    for(std::size_t p = 0; p < kc; ++p, a_h += gemm_mr, b_p += gemm_nr) {
+      __m128d a0 = _mm_loadu_pd(a_h);
+      __m128d a1 = _mm_loadu_pd(a_h + 2);
+      __m128d bj = _mm_set1_pd(b_p[0]);
+      c00 = _mm_add_pd(c00, _mm_mul_pd(a0, bj)); c10 = _mm_add_pd(c10, _mm_mul_pd(a1, bj));
+      bj = _mm_set1_pd(b_p[1]);
+      c01 = _mm_add_pd(c01, _mm_mul_pd(a0, bj)); c11 = _mm_add_pd(c11, _mm_mul_pd(a1, bj));
+      bj = _mm_set1_pd(b_p[2]);
+      c02 = _mm_add_pd(c02, _mm_mul_pd(a0, bj)); c12 = _mm_add_pd(c12, _mm_mul_pd(a1, bj));
+      bj = _mm_set1_pd(b_p[3]);
+      c03 = _mm_add_pd(c03, _mm_mul_pd(a0, bj)); c13 = _mm_add_pd(c13, _mm_mul_pd(a1, bj));
+      bj = _mm_set1_pd(b_p[4]);
+      c04 = _mm_add_pd(c04, _mm_mul_pd(a0, bj)); c14 = _mm_add_pd(c14, _mm_mul_pd(a1, bj));
+      bj = _mm_set1_pd(b_p[5]);
+      c05 = _mm_add_pd(c05, _mm_mul_pd(a0, bj)); c15 = _mm_add_pd(c15, _mm_mul_pd(a1, bj));
+    };
+    double* C_h = C + h;
+    _mm_storeu_pd(C_h,      c00); _mm_storeu_pd(C_h + 2,  c10);
+    _mm_storeu_pd(C_h + 8,  c01); _mm_storeu_pd(C_h + 10, c11);
+    _mm_storeu_pd(C_h + 16, c02); _mm_storeu_pd(C_h + 18, c12);
+    _mm_storeu_pd(C_h + 24, c03); _mm_storeu_pd(C_h + 26, c13);
+    _mm_storeu_pd(C_h + 32, c04); _mm_storeu_pd(C_h + 34, c14);
+    _mm_storeu_pd(C_h + 40, c05); _mm_storeu_pd(C_h + 42, c15);
+  };
+};
+
+#endif
+
+
+/*
+ * Computes C = A * B, where A is m x k, B is k x n and C is m x n, and the element (i,j) of each
+ * matrix X is stored at X[i * rsX + j * csX]. C must not overlap A or B.
+ */
+template <typename T>
+void dense_gemm_kernel(std::size_t m, std::size_t n, std::size_t k,
+                       const T* A, std::ptrdiff_t rsA, std::ptrdiff_t csA,
+                       const T* B, std::ptrdiff_t rsB, std::ptrdiff_t csB,
+                       T* C, std::ptrdiff_t rsC, std::ptrdiff_t csC) {
+  if((m == 0) || (n == 0))
+    return;
+  for(std::size_t j = 0; j < n; ++j)
+    for(std::size_t i = 0; i < m; ++i)
+      C[std::ptrdiff_t(i) * rsC + std::ptrdiff_t(j) * csC] = T(0.0);
+  if(k == 0)
+    return;
+
+  if(m * n * k < gemm_packing_threshold) {
+    // small product: accumulate along the storage order of the result.
+    if(rsC == 1) {
+      for(std::size_t j = 0; j < n; ++j) {
+        T* c_j = C + std::ptrdiff_t(j) * csC;
+        for(std::size_t p = 0; p < k; ++p) {
+          const T b_pj = B[std::ptrdiff_t(p) * rsB + std::ptrdiff_t(j) * csB];
+          const T* a_p = A + std::ptrdiff_t(p) * csA;
+          for(std::size_t i = 0; i < m; ++i)
+            c_j[i] += a_p[std::ptrdiff_t(i) * rsA] * b_pj;
+        };
+      };
+    } else {
+      for(std::size_t i = 0; i < m; ++i) {
+        T* c_i = C + std::ptrdiff_t(i) * rsC;
+        for(std::size_t p = 0; p < k; ++p) {
+          const T a_ip = A[std::ptrdiff_t(i) * rsA + std::ptrdiff_t(p) * csA];
+          const T* b_p = B + std::ptrdiff_t(p) * rsB;
+          for(std::size_t j = 0; j < n; ++j)
+            c_i[std::ptrdiff_t(j) * csC] += a_ip * b_p[std::ptrdiff_t(j) * csB];
+        };
+      };
+    };
+    return;
+  };
+
+  std::size_t mc_max = (m < gemm_mc ? m : gemm_mc);
+  std::size_t kc_max = (k < gemm_kc ? k : gemm_kc);
+  std::size_t nc_max = (n < gemm_nc ? n : gemm_nc);
+  std::vector<T> a_buf(((mc_max + gemm_mr - 1) / gemm_mr) * gemm_mr * kc_max);
+  std::vector<T> b_buf(((nc_max + gemm_nr - 1) / gemm_nr) * gemm_nr * kc_max);
+  T c_tile[gemm_mr * gemm_nr];
+
+  for(std::size_t jc = 0; jc < n; jc += gemm_nc) {
+    std::size_t nc = (n - jc < gemm_nc ? n - jc : gemm_nc);
+    for(std::size_t pc = 0; pc < k; pc += gemm_kc) {
+      std::size_t kc = (k - pc < gemm_kc ? k - pc : gemm_kc);
+      gemm_pack_rhs(kc, nc, B + std::ptrdiff_t(pc) * rsB + std::ptrdiff_t(jc) * csB, rsB, csB, &b_buf[0]);
+      for(std::size_t ic = 0; ic < m; ic += gemm_mc) {
+        std::size_t mc = (m - ic < gemm_mc ? m - ic : gemm_mc);
+        gemm_pack_lhs(mc, kc, A + std::ptrdiff_t(ic) * rsA + std::ptrdiff_t(pc) * csA, rsA, csA, &a_buf[0]);
+        for(std::size_t jr = 0; jr < nc; jr += gemm_nr) {
+          std::size_t nr = (nc - jr < gemm_nr ? nc - jr : gemm_nr);
+          for(std::size_t ir = 0; ir < mc; ir += gemm_mr) {
+            std::size_t mr = (mc - ir < gemm_mr ? mc - ir : gemm_mr);
+            gemm_micro_kernel(kc, &a_buf[ir * kc], &b_buf[jr * kc], c_tile);
+            T* c = C + std::ptrdiff_t(ic + ir) * rsC + std::ptrdiff_t(jc + jr) * csC;
+            for(std::size_t j = 0; j < nr; ++j)
+              for(std::size_t i = 0; i < mr; ++i)
+                c[std::ptrdiff_t(i) * rsC + std::ptrdiff_t(j) * csC] += c_tile[j * gemm_mr + i];
+          };
+        };
+      };
+    };
+  };
+};
+
+
+/*
+ * This meta-function tells if a matrix type stores its elements contiguously, and gives the strides
+ * of its storage, such that the element (i,j) is found at the address of (0,0) plus (i * row_stride + j * col_stride).
+ */
+template <typename Matrix>
+struct dense_mat_storage {
+  BOOST_STATIC_CONSTANT( bool, value = false );
+};
+
+template <typename T, typename Allocator>
+struct dense_mat_storage< mat<T,mat_structure::rectangular,mat_alignment::column_major,Allocator> > {
+  BOOST_STATIC_CONSTANT( bool, value = true );
+  template <typename Matrix>
+  static std::ptrdiff_t row_stride(const Matrix&) { return 1; };
+  template <typename Matrix>
+  static std::ptrdiff_t col_stride(const Matrix& M) { return std::ptrdiff_t(M.get_row_count()); };
+};
+
+template <typename T, typename Allocator>
+struct dense_mat_storage< mat<T,mat_structure::rectangular,mat_alignment::row_major,Allocator> > {
+  BOOST_STATIC_CONSTANT( bool, value = true );
+  template <typename Matrix>
+  static std::ptrdiff_t row_stride(const Matrix& M) { return std::ptrdiff_t(M.get_col_count()); };
+  template <typename Matrix>
+  static std::ptrdiff_t col_stride(const Matrix&) { return 1; };
+};
+
+template <typename T, typename Allocator>
+struct dense_mat_storage< mat<T,mat_structure::square,mat_alignment::column_major,Allocator> > {
+  BOOST_STATIC_CONSTANT( bool, value = true );
+  template <typename Matrix>
+  static std::ptrdiff_t row_stride(const Matrix&) { return 1; };
+  template <typename Matrix>
+  static std::ptrdiff_t col_stride(const Matrix& M) { return std::ptrdiff_t(M.get_row_count()); };
+};
+
+template <typename T, typename Allocator>
+struct dense_mat_storage< mat<T,mat_structure::square,mat_alignment::row_major,Allocator> > {
+  BOOST_STATIC_CONSTANT( bool, value = true );
+  template <typename Matrix>
+  static std::ptrdiff_t row_stride(const Matrix& M) { return std::ptrdiff_t(M.get_col_count()); };
+  template <typename Matrix>
+  static std::ptrdiff_t col_stride(const Matrix&) { return 1; };
+};
+
+/*
+ * This meta-function tells if the product of two matrices, into a result matrix, can be computed
+ * by the dense_gemm_kernel, i.e., if all three matrices have contiguous storage of the same
+ * floating-point type (float or double).
+ */
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+struct is_dense_gemm_compatible {
+  typedef typename mat_traits<ResultMatrix>::value_type value_type;
+  BOOST_STATIC_CONSTANT( bool, value = (dense_mat_storage<Matrix1>::value &&
+                                        dense_mat_storage<Matrix2>::value &&
+                                        dense_mat_storage<ResultMatrix>::value &&
+                                        boost::is_same< typename mat_traits<Matrix1>::value_type, value_type >::value &&
+                                        boost::is_same< typename mat_traits<Matrix2>::value_type, value_type >::value &&
+                                        (boost::is_same< value_type, double >::value ||
+                                         boost::is_same< value_type, float >::value)) );
+  typedef is_dense_gemm_compatible<Matrix1,Matrix2,ResultMatrix> type;
+};
+
+/* Computes MR = M1 * M2 with the dense_gemm_kernel, for matrices with contiguous storage (see is_dense_gemm_compatible). */
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+void dense_gemm_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR) {
+  typedef typename mat_traits<ResultMatrix>::value_type ValueType;
+  if((M1.get_row_count() == 0) || (M2.get_col_count() == 0))
+    return;
+  if(M1.get_col_count() == 0) {
+    for(std::size_t j = 0; j < M2.get_col_count(); ++j)
+      for(std::size_t i = 0; i < M1.get_row_count(); ++i)
+        MR(i,j) = ValueType(0.0);
+    return;
+  };
+  dense_gemm_kernel(M1.get_row_count(), M2.get_col_count(), M1.get_col_count(),
+                    &M1(0,0), dense_mat_storage<Matrix1>::row_stride(M1), dense_mat_storage<Matrix1>::col_stride(M1),
+                    &M2(0,0), dense_mat_storage<Matrix2>::row_stride(M2), dense_mat_storage<Matrix2>::col_stride(M2),
+                    &MR(0,0), dense_mat_storage<ResultMatrix>::row_stride(MR), dense_mat_storage<ResultMatrix>::col_stride(MR));
+};
+
+
+};
+
+
+};
+
+#endif
+
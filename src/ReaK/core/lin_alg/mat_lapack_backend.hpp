@@ -0,0 +1,419 @@
+/**
+ * \file mat_lapack_backend.hpp
+ *
+ * This library provides an optional backend for the matrix numerical methods, which forwards some
+ * of the decompositions (Cholesky, QR, least-squares, SVD and real Schur) on matrices of doubles to
+ * a system LAPACK library (e.g., OpenBLAS, or the reference LAPACK). The backend is only compiled-in
+ * when the REAK_HAS_LAPACK macro is defined (see the ENABLE_LAPACK_BACKEND CMake flag), and the
+ * generic methods (from mat_cholesky.hpp, mat_qr_decomp.hpp, mat_svd_method.hpp and mat_schur_decomp.hpp)
+ * remain the fallback for all other value-types, for small matrices, when the backend is disabled,
+ * and when LAPACK fails to converge.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_LAPACK_BACKEND_HPP
+#define REAK_MAT_LAPACK_BACKEND_HPP
+
+#include "mat_alg.hpp"
+#include "mat_num_exceptions.hpp"
+
+#include <boost/type_traits.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <cmath>
+#include <vector>
+
+
+#ifdef REAK_HAS_LAPACK
+
+extern "C" {
+
+void dpotrf_(const char* uplo, const int* n, double* a, const int* lda, int* info);
+
+void dposv_(const char* uplo, const int* n, const int* nrhs, double* a, const int* lda,
+            double* b, const int* ldb, int* info);
+
+void dgeqrf_(const int* m, const int* n, double* a, const int* lda, double* tau,
+             double* work, const int* lwork, int* info);
+
+void dorgqr_(const int* m, const int* n, const int* k, double* a, const int* lda, const double* tau,
+             double* work, const int* lwork, int* info);
+
+void dgels_(const char* trans, const int* m, const int* n, const int* nrhs, double* a, const int* lda,
+            double* b, const int* ldb, double* work, const int* lwork, int* info);
+
+void dgesdd_(const char* jobz, const int* m, const int* n, double* a, const int* lda, double* s,
+             double* u, const int* ldu, double* vt, const int* ldvt,
+             double* work, const int* lwork, int* iwork, int* info);
+
+void dgees_(const char* jobvs, const char* sort, int (*select)(const double*, const double*),
+            const int* n, double* a, const int* lda, int* sdim, double* wr, double* wi,
+            double* vs, const int* ldvs, double* work, const int* lwork, int* bwork, int* info);
+
+};
+
+#endif
+
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+
+/**
+ * Checks if the LAPACK backend was compiled-in (see the ENABLE_LAPACK_BACKEND CMake flag).
+ */
+inline bool has_lapack_backend() {
+#ifdef REAK_HAS_LAPACK
+  return true;
+#else
+  return false;
+#endif
+};
+
+namespace detail {
+
+inline bool& lapack_backend_switch() {
+  static bool enabled = true;
+  return enabled;
+};
+
+};
+
+/**
+ * Enables or disables, at run-time, the dispatch of the decompositions to the LAPACK backend (it is
+ * enabled by default, when compiled-in). This is mostly useful to compare against the generic methods,
+ * and should be set before any decomposition is performed, as it is not synchronized between threads.
+ * \param aEnabled Set to true to enable the LAPACK backend, false to use the generic methods.
+ */
+inline void enable_lapack_backend(bool aEnabled = true) {
+  detail::lapack_backend_switch() = aEnabled;
+};
+
+/**
+ * Checks if the decompositions are currently dispatched to the LAPACK backend.
+ */
+inline bool is_lapack_backend_enabled() {
+  return has_lapack_backend() && detail::lapack_backend_switch();
+};
+
+
+namespace detail {
+
+
+/*
+ * This meta-function tells if a set of matrices can be handled by the LAPACK backend, i.e., if it is
+ * compiled-in and all the matrices hold doubles. The matrices are copied to (and from) column-major
+ * work matrices, which LAPACK overwrites anyways, such that their structure and storage is irrelevant.
+ */
+template <typename Matrix1, typename Matrix2 = Matrix1, typename Matrix3 = Matrix1, typename Matrix4 = Matrix1>
+struct is_lapack_compatible {
+  BOOST_STATIC_CONSTANT( bool, value = (
+#ifdef REAK_HAS_LAPACK
+    boost::is_same< typename mat_traits<Matrix1>::value_type, double >::value &&
+    boost::is_same< typename mat_traits<Matrix2>::value_type, double >::value &&
+    boost::is_same< typename mat_traits<Matrix3>::value_type, double >::value &&
+    boost::is_same< typename mat_traits<Matrix4>::value_type, double >::value
+#else
+    false
+#endif
+    ) );
+  typedef is_lapack_compatible<Matrix1,Matrix2,Matrix3,Matrix4> type;
+};
+
+
+/*
+ * Below this size, the generic methods are as fast as LAPACK (which has some overhead in copying the
+ * matrices and querying the work-space sizes), and they are kept for their exact, established results.
+ */
+const std::size_t lapack_min_size = 16;
+
+inline bool use_lapack_backend(std::size_t aRowCount, std::size_t aColCount) {
+  return is_lapack_backend_enabled() && (aRowCount > 0) && (aColCount > 0) &&
+         ((aRowCount >= lapack_min_size) || (aColCount >= lapack_min_size));
+};
+
+
+/*
+ * Each of the following functions returns false (without touching its outputs) if the decomposition
+ * must be done by the generic method instead.
+ */
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2>::value,
+bool >::type lapack_decompose_Cholesky(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2>::value,
+bool >::type lapack_linsolve_Cholesky(const Matrix1&, Matrix2&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_decompose_QR(const Matrix1&, Matrix2&, Matrix3&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_linlsq_QR(const Matrix1&, Matrix2&, const Matrix3&, typename mat_traits<Matrix1>::value_type) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3, typename Matrix4>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2,Matrix3,Matrix4>::value,
+bool >::type lapack_decompose_SVD(const Matrix1&, Matrix2&, Matrix3&, Matrix4&) {
+  return false;
+};
+
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< !is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_decompose_RealSchur(const Matrix1&, Matrix2*, Matrix3&) {
+  return false;
+};
+
+
+#ifdef REAK_HAS_LAPACK
+
+/* Cholesky decomposition (dpotrf), only the lower-triangular part of L is written (as in decompose_Cholesky_impl). */
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2>::value,
+bool >::type lapack_decompose_Cholesky(const Matrix1& A, Matrix2& L, double NumTol) {
+  std::size_t N = A.get_row_count();
+  if(!use_lapack_backend(N,N))
+    return false;
+  mat<double,mat_structure::rectangular> W(N,N);
+  for(std::size_t j = 0; j < N; ++j)
+    for(std::size_t i = j; i < N; ++i)
+      W(i,j) = A(i,j);
+  int n = int(N);
+  int info = 0;
+  dpotrf_("L", &n, &W(0,0), &n, &info);
+  if(info != 0)
+    throw singularity_error("A");
+  for(std::size_t j = 0; j < N; ++j) {
+    if(W(j,j) * W(j,j) < NumTol)
+      throw singularity_error("A");
+    for(std::size_t i = j; i < N; ++i)
+      L(i,j) = W(i,j);
+  };
+  return true;
+};
+
+/* Solution of A X = B by Cholesky decomposition (dposv), B is overwritten by X. */
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2>::value,
+bool >::type lapack_linsolve_Cholesky(const Matrix1& A, Matrix2& b, double NumTol) {
+  std::size_t N = A.get_row_count();
+  if(!use_lapack_backend(N,N) || (b.get_col_count() == 0))
+    return false;
+  mat<double,mat_structure::rectangular> W(N,N);
+  for(std::size_t j = 0; j < N; ++j)
+    for(std::size_t i = j; i < N; ++i)
+      W(i,j) = A(i,j);
+  mat<double,mat_structure::rectangular> X(b);
+  int n = int(N);
+  int nrhs = int(X.get_col_count());
+  int info = 0;
+  dposv_("L", &n, &nrhs, &W(0,0), &n, &X(0,0), &n, &info);
+  if(info != 0)
+    throw singularity_error("A");
+  for(std::size_t j = 0; j < N; ++j)
+    if(W(j,j) * W(j,j) < NumTol)
+      throw singularity_error("A");
+  for(std::size_t j = 0; j < X.get_col_count(); ++j)
+    for(std::size_t i = 0; i < N; ++i)
+      b(i,j) = X(i,j);
+  return true;
+};
+
+/* QR decomposition (dgeqrf and dorgqr), with the full square Q, as in decompose_QR. */
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_decompose_QR(const Matrix1& A, Matrix2& Q, Matrix3& R, double) {
+  std::size_t N = A.get_row_count();
+  std::size_t M = A.get_col_count();
+  if(!use_lapack_backend(N,M))
+    return false;
+  mat<double,mat_structure::rectangular> R_tmp(A);
+  std::size_t K = (N < M ? N : M);
+  int m = int(N);
+  int n = int(M);
+  int k = int(K); // the number of elementary reflectors is min(m,n).
+  std::vector<double> tau(K);
+  int lwork = -1;
+  int info = 0;
+  double work_query = 0.0;
+  dgeqrf_(&m, &n, &R_tmp(0,0), &m, &tau[0], &work_query, &lwork, &info);
+  lwork = int(work_query) + 1;
+  std::vector<double> work(lwork);
+  dgeqrf_(&m, &n, &R_tmp(0,0), &m, &tau[0], &work[0], &lwork, &info);
+  if(info != 0)
+    return false;
+
+  // the reflectors are below the diagonal of R_tmp, expanded into the full Q.
+  mat<double,mat_structure::rectangular> Q_tmp(N,N);
+  for(std::size_t j = 0; j < K; ++j)
+    for(std::size_t i = j + 1; i < N; ++i)
+      Q_tmp(i,j) = R_tmp(i,j);
+  lwork = -1;
+  dorgqr_(&m, &m, &k, &Q_tmp(0,0), &m, &tau[0], &work_query, &lwork, &info);
+  if(int(work_query) + 1 > int(work.size()))
+    work.resize(int(work_query) + 1);
+  lwork = int(work.size());
+  dorgqr_(&m, &m, &k, &Q_tmp(0,0), &m, &tau[0], &work[0], &lwork, &info);
+  if(info != 0)
+    return false;
+
+  for(std::size_t j = 0; j < M; ++j)
+    for(std::size_t i = j + 1; i < N; ++i)
+      R_tmp(i,j) = 0.0;
+  Q = Q_tmp;
+  R = R_tmp;
+  return true;
+};
+
+/* Linear least-squares solution by QR decomposition (dgels), as in linlsq_QR_impl. */
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_linlsq_QR(const Matrix1& A, Matrix2& x, const Matrix3& b, double NumTol) {
+  using std::fabs;
+  std::size_t N = A.get_row_count();
+  std::size_t M = A.get_col_count();
+  if(!use_lapack_backend(N,M) || (b.get_col_count() == 0))
+    return false;
+  mat<double,mat_structure::rectangular> W(A);
+  mat<double,mat_structure::rectangular> X(b);
+  int m = int(N);
+  int n = int(M);
+  int nrhs = int(X.get_col_count());
+  int lwork = -1;
+  int info = 0;
+  double work_query = 0.0;
+  dgels_("N", &m, &n, &nrhs, &W(0,0), &m, &X(0,0), &m, &work_query, &lwork, &info);
+  lwork = int(work_query) + 1;
+  std::vector<double> work(lwork);
+  dgels_("N", &m, &n, &nrhs, &W(0,0), &m, &X(0,0), &m, &work[0], &lwork, &info);
+  if(info != 0)
+    throw singularity_error("R");
+  // on exit, W holds R in its upper-triangular part.
+  for(std::size_t i = 0; i < M; ++i)
+    if(fabs(W(i,i)) < NumTol)
+      throw singularity_error("R");
+  x.set_row_count(M);
+  x.set_col_count(X.get_col_count());
+  for(std::size_t j = 0; j < X.get_col_count(); ++j)
+    for(std::size_t i = 0; i < M; ++i)
+      x(i,j) = X(i,j);
+  return true;
+};
+
+/* Thin singular value decomposition (dgesdd), as in decompose_SVD (U is N x K, E is K x K and V is M x K, with K = min(N,M)). */
+template <typename Matrix1, typename Matrix2, typename Matrix3, typename Matrix4>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2,Matrix3,Matrix4>::value,
+bool >::type lapack_decompose_SVD(const Matrix1& A, Matrix2& U, Matrix3& E, Matrix4& V) {
+  std::size_t N = A.get_row_count();
+  std::size_t M = A.get_col_count();
+  if(!use_lapack_backend(N,M))
+    return false;
+  std::size_t K = (N < M ? N : M);
+  mat<double,mat_structure::rectangular> W(A);
+  mat<double,mat_structure::rectangular> U_tmp(N,K);
+  mat<double,mat_structure::rectangular> Vt_tmp(K,M);
+  std::vector<double> s(K);
+  std::vector<int> iwork(8 * K);
+  int m = int(N);
+  int n = int(M);
+  int k = int(K);
+  int lwork = -1;
+  int info = 0;
+  double work_query = 0.0;
+  dgesdd_("S", &m, &n, &W(0,0), &m, &s[0], &U_tmp(0,0), &m, &Vt_tmp(0,0), &k, &work_query, &lwork, &iwork[0], &info);
+  lwork = int(work_query) + 1;
+  std::vector<double> work(lwork);
+  dgesdd_("S", &m, &n, &W(0,0), &m, &s[0], &U_tmp(0,0), &m, &Vt_tmp(0,0), &k, &work[0], &lwork, &iwork[0], &info);
+  if(info != 0)
+    return false;
+
+  mat<double,mat_structure::diagonal> E_tmp(K);
+  for(std::size_t i = 0; i < K; ++i)
+    E_tmp(i,i) = s[i];
+  U = U_tmp;
+  E = E_tmp;
+  V = transpose_view(Vt_tmp);
+  return true;
+};
+
+inline int lapack_schur_select(const double*, const double*) {
+  return 0;
+};
+
+/* Real Schur decomposition (dgees, without reordering), as in decompose_RealSchur (Q may be null). */
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_lapack_compatible<Matrix1,Matrix2,Matrix3>::value,
+bool >::type lapack_decompose_RealSchur(const Matrix1& A, Matrix2* Q, Matrix3& T) {
+  std::size_t N = A.get_row_count();
+  if(!use_lapack_backend(N,N))
+    return false;
+  mat<double,mat_structure::rectangular> T_tmp(A);
+  mat<double,mat_structure::rectangular> Q_tmp(Q ? N : 1, Q ? N : 1);
+  std::vector<double> wr(N), wi(N);
+  std::vector<int> bwork(N);
+  int n = int(N);
+  int ldvs = int(Q_tmp.get_row_count());
+  int sdim = 0;
+  int lwork = -1;
+  int info = 0;
+  double work_query = 0.0;
+  const char* jobvs = (Q ? "V" : "N");
+  dgees_(jobvs, "N", lapack_schur_select, &n, &T_tmp(0,0), &n, &sdim, &wr[0], &wi[0],
+         &Q_tmp(0,0), &ldvs, &work_query, &lwork, &bwork[0], &info);
+  lwork = int(work_query) + 1;
+  std::vector<double> work(lwork);
+  dgees_(jobvs, "N", lapack_schur_select, &n, &T_tmp(0,0), &n, &sdim, &wr[0], &wi[0],
+         &Q_tmp(0,0), &ldvs, &work[0], &lwork, &bwork[0], &info);
+  if(info != 0)
+    return false;
+
+  T = T_tmp;
+  if(Q)
+    *Q = Q_tmp;
+  return true;
+};
+
+#endif
+
+
+};
+
+
+};
+
+#endif
+
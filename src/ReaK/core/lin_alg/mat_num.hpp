@@ -45,6 +45,7 @@
 #include "mat_damped_matrix.hpp"
 #include "mat_gaussian_elim.hpp"
 #include "mat_cholesky.hpp"
+#include "mat_sparse_cholesky.hpp"
 #include "mat_jacobi_method.hpp"
 #include "mat_qr_decomp.hpp"
 #include "mat_svd_method.hpp"
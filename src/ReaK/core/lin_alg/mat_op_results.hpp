@@ -185,6 +185,79 @@ struct product_result_structure<mat_structure::identity,mat_structure::identity>
 };
 
 
+/* The products involving a sparse matrix are general (dense) matrices (except with nil matrices). */
+template <mat_structure::tag Structure2>
+struct product_result_structure<mat_structure::sparse,Structure2> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::sparse,Structure2> type;
+};
+
+template <mat_structure::tag Structure1>
+struct product_result_structure<Structure1,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<Structure1,mat_structure::sparse> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::sparse,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::sparse,mat_structure::sparse> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::sparse,mat_structure::rectangular> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::sparse,mat_structure::rectangular> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::rectangular,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::rectangular,mat_structure::sparse> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::sparse,mat_structure::identity> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::sparse,mat_structure::identity> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::identity,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef product_result_structure<mat_structure::identity,mat_structure::sparse> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::sparse,mat_structure::nil> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::nil);
+  typedef product_result_structure<mat_structure::sparse,mat_structure::nil> type;
+};
+
+template <>
+struct product_result_structure<mat_structure::nil,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::nil);
+  typedef product_result_structure<mat_structure::nil,mat_structure::sparse> type;
+};
+
 template <bool AreTheseMatrices, typename ResultValueType, typename Matrix1, typename Matrix2>
 struct mat_product_result_impl {
   typedef mat< 
@@ -408,6 +481,49 @@ struct addition_result_structure<mat_structure::skew_symmetric, mat_structure::s
 
 
 
+/* The sums involving a sparse matrix are general (dense) matrices. */
+template <mat_structure::tag Structure2>
+struct addition_result_structure<mat_structure::sparse,Structure2> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef addition_result_structure<mat_structure::sparse,Structure2> type;
+};
+
+template <mat_structure::tag Structure1>
+struct addition_result_structure<Structure1,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef addition_result_structure<Structure1,mat_structure::sparse> type;
+};
+
+template <>
+struct addition_result_structure<mat_structure::sparse,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef addition_result_structure<mat_structure::sparse,mat_structure::sparse> type;
+};
+
+template <>
+struct addition_result_structure<mat_structure::sparse,mat_structure::nil> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef addition_result_structure<mat_structure::sparse,mat_structure::nil> type;
+};
+
+template <>
+struct addition_result_structure<mat_structure::nil,mat_structure::sparse> {
+  typedef boost::mpl::integral_c_tag tag;
+  typedef mat_structure::tag value_type;
+  BOOST_STATIC_CONSTANT(mat_structure::tag, value = mat_structure::rectangular);
+  typedef addition_result_structure<mat_structure::nil,mat_structure::sparse> type;
+};
+
+
+
 template <bool AreTheseMatrices, typename ResultValueType, typename Matrix1, typename Matrix2>
 struct mat_addition_result_impl {
   typedef mat< 
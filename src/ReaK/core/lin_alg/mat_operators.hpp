@@ -42,11 +42,13 @@
 #include "mat_traits.hpp"
 
 #include "mat_op_results.hpp"
+#include "mat_gemm.hpp"
 
 #include <boost/type_traits.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/concept_check.hpp>
 
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/or.hpp>
 #include <boost/mpl/not.hpp>
 #include <boost/mpl/logical.hpp>
@@ -102,7 +104,7 @@ namespace detail {
 
 
 template <typename Matrix1, typename Matrix2, typename ResultMatrix>
-void dense_mat_multiply_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR) {
+void dense_mat_multiply_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR, boost::mpl::false_) {
   typedef typename mat_traits<ResultMatrix>::value_type ValueType;
   typedef typename mat_traits<ResultMatrix>::size_type SizeType;
   for(SizeType i=0;i<M1.get_row_count();++i) {
@@ -114,6 +116,17 @@ void dense_mat_multiply_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix&
   };
 };
 
+/* Dense matrices of float or double (with contiguous storage) go through the packed, cache-blocked kernel. */
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+void dense_mat_multiply_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR, boost::mpl::true_) {
+  dense_gemm_impl(M1,M2,MR);
+};
+
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+void dense_mat_multiply_impl(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR) {
+  dense_mat_multiply_impl(M1,M2,MR,boost::mpl::bool_< is_dense_gemm_compatible<Matrix1,Matrix2,ResultMatrix>::value >());
+};
+
 template <typename Matrix1, typename MatrixDiag, typename ResultMatrix>
 void dense_diag_mat_multiply_impl(const Matrix1& M1, const MatrixDiag& M2, ResultMatrix& MR) {
   typedef typename mat_traits<ResultMatrix>::size_type SizeType;
@@ -0,0 +1,558 @@
+/**
+ * \file mat_parallel_decomp.hpp
+ *
+ * This library provides multi-threaded versions of the Cholesky and QR decompositions, as
+ * overloads of decompose_Cholesky and decompose_QR which take a thread-pool as first argument.
+ * The matrices are partitioned into tiles (blocks) and the decompositions are expressed as
+ * a graph of tile-operations (see ReaK/core/base/task_graph.hpp) which is executed on the
+ * thread-pool, such that each tile-operation starts as soon as the tiles it needs are ready.
+ * This is worthwhile for large matrices (a few hundreds of rows and more, e.g., the covariance
+ * matrices of map-augmented state estimators), while smaller matrices are simply decomposed
+ * by the single-threaded functions (see mat_cholesky.hpp and mat_qr_decomp.hpp).
+ *
+ * The Cholesky decomposition is a right-looking tiled algorithm: the factorization of a diagonal
+ * tile is followed by the triangular solves of the tiles below it and the (symmetric) rank-k updates
+ * of the trailing tiles. The QR decomposition is a blocked Householder algorithm: the factorization
+ * of a column-panel (with a sequence of Householder reflections) is followed by the application of
+ * those reflections to each trailing column-block and to each row-block of Q.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_PARALLEL_DECOMP_HPP
+#define REAK_MAT_PARALLEL_DECOMP_HPP
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/core/base/task_graph.hpp>
+
+#include "mat_alg.hpp"
+#include "mat_num_exceptions.hpp"
+#include "mat_cholesky.hpp"
+#include "mat_qr_decomp.hpp"
+
+#include <vector>
+#include <limits>
+
+namespace ReaK {
+
+
+namespace detail {
+
+/* Matrices with fewer rows than this are decomposed by the single-threaded functions. */
+inline bool parallel_decomp_is_worthwhile(std::size_t aSize, const thread_pool& aPool) {
+  return (aPool.size() > 1) && (aSize >= 128);
+};
+
+/* Picks a tile size such that there are at least aTilesPerThread tiles (along one dimension) per thread. */
+inline std::size_t parallel_decomp_tile_size(std::size_t aSize, std::size_t aThreadCount, std::size_t aTilesPerThread) {
+  std::size_t result = aSize / (aThreadCount * aTilesPerThread);
+  if(result < 16)
+    result = 16;
+  if(result > 128)
+    result = 128;
+  return result;
+};
+
+inline void parallel_decomp_add_dependency(task_graph& aGraph, task_graph::task_id aBefore, task_graph::task_id aAfter) {
+  if(aBefore < aAfter)
+    aGraph.add_dependency(aBefore, aAfter);
+};
+
+
+/*************************************************************************
+                        Tiled Cholesky Decomposition
+*************************************************************************/
+
+template <typename Matrix>
+struct tiled_Cholesky_data {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+
+  Matrix* p_L;         ///< The (column-major) matrix which holds A on input and L on output (lower part).
+  SizeType size;
+  SizeType tile_size;
+  ValueType num_tol;
+
+  SizeType tile_begin(SizeType k) const { return k * tile_size; };
+  SizeType tile_end(SizeType k) const { return ((k + 1) * tile_size < size ? (k + 1) * tile_size : size); };
+};
+
+/* Cholesky factorization of the diagonal tile (k,k). */
+template <typename Matrix>
+void tiled_Cholesky_factor(const tiled_Cholesky_data<Matrix>& D, std::size_t k) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  using std::sqrt;
+  Matrix& L = *D.p_L;
+  SizeType c0 = D.tile_begin(k);
+  SizeType c1 = D.tile_end(k);
+  for(SizeType j = c0; j < c1; ++j) {
+    if(L(j,j) < D.num_tol)
+      throw singularity_error("A");
+    ValueType d = sqrt(L(j,j));
+    L(j,j) = d;
+    for(SizeType i = j + 1; i < c1; ++i)
+      L(i,j) /= d;
+    for(SizeType c = j + 1; c < c1; ++c) {
+      ValueType l = L(c,j);
+      for(SizeType i = c; i < c1; ++i)
+        L(i,c) -= L(i,j) * l;
+    };
+  };
+};
+
+/* Triangular solve of the tile (i,k) with the factored diagonal tile (k,k), i.e., L_ik = A_ik * inv(L_kk)^T. */
+template <typename Matrix>
+void tiled_Cholesky_solve(const tiled_Cholesky_data<Matrix>& D, std::size_t i, std::size_t k) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  Matrix& L = *D.p_L;
+  SizeType r0 = D.tile_begin(i);
+  SizeType r1 = D.tile_end(i);
+  SizeType c0 = D.tile_begin(k);
+  SizeType c1 = D.tile_end(k);
+  for(SizeType j = c0; j < c1; ++j) {
+    ValueType d = L(j,j);
+    for(SizeType r = r0; r < r1; ++r)
+      L(r,j) /= d;
+    for(SizeType c = j + 1; c < c1; ++c) {
+      ValueType l = L(c,j);
+      for(SizeType r = r0; r < r1; ++r)
+        L(r,c) -= L(r,j) * l;
+    };
+  };
+};
+
+/* Update of the tile (i,j) with the factored tiles (i,k) and (j,k), i.e., A_ij -= L_ik * L_jk^T (lower part only if i == j). */
+template <typename Matrix>
+void tiled_Cholesky_update(const tiled_Cholesky_data<Matrix>& D, std::size_t i, std::size_t j, std::size_t k) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  Matrix& L = *D.p_L;
+  SizeType r0 = D.tile_begin(i);
+  SizeType r1 = D.tile_end(i);
+  SizeType b0 = D.tile_begin(j);
+  SizeType b1 = D.tile_end(j);
+  SizeType c0 = D.tile_begin(k);
+  SizeType c1 = D.tile_end(k);
+  for(SizeType col = b0; col < b1; ++col) {
+    SizeType r_first = (i == j ? col : r0);
+    for(SizeType c = c0; c < c1; ++c) {
+      ValueType l = L(col,c);
+      for(SizeType r = r_first; r < r1; ++r)
+        L(r,col) -= L(r,c) * l;
+    };
+  };
+};
+
+template <typename Matrix>
+struct tiled_Cholesky_task {
+  enum op_kind { factor_op, solve_op, update_op };
+
+  const tiled_Cholesky_data<Matrix>* p_data;
+  op_kind op;
+  std::size_t i;
+  std::size_t j;
+  std::size_t k;
+
+  tiled_Cholesky_task(const tiled_Cholesky_data<Matrix>* aData, op_kind aOp, std::size_t aI, std::size_t aJ, std::size_t aK) :
+                      p_data(aData), op(aOp), i(aI), j(aJ), k(aK) { };
+
+  void operator()() const {
+    switch(op) {
+      case factor_op:
+        tiled_Cholesky_factor(*p_data, k);
+        break;
+      case solve_op:
+        tiled_Cholesky_solve(*p_data, i, k);
+        break;
+      case update_op:
+        tiled_Cholesky_update(*p_data, i, j, k);
+        break;
+    };
+  };
+};
+
+/* Computes, in-place, the lower-triangular Cholesky factor of the (column-major) matrix L (only the lower part is used). */
+template <typename Matrix>
+void decompose_Cholesky_tiled_impl(thread_pool& aPool, Matrix& L, typename mat_traits<Matrix>::value_type NumTol) {
+  typedef tiled_Cholesky_task<Matrix> TaskType;
+  tiled_Cholesky_data<Matrix> data;
+  data.p_L = &L;
+  data.size = L.get_row_count();
+  data.tile_size = parallel_decomp_tile_size(data.size, aPool.size(), 1);
+  data.num_tol = NumTol;
+  std::size_t nt = (data.size + data.tile_size - 1) / data.tile_size;
+
+  // last_op[i*(i+1)/2 + j] is the last tile-operation that wrote the tile (i,j), i >= j.
+  task_graph graph;
+  std::vector< task_graph::task_id > last_op((nt * (nt + 1)) / 2, std::numeric_limits<task_graph::task_id>::max());
+  for(std::size_t k = 0; k < nt; ++k) {
+    std::size_t kk = (k * (k + 1)) / 2 + k;
+    task_graph::task_id f = graph.add_task(TaskType(&data, TaskType::factor_op, k, k, k));
+    parallel_decomp_add_dependency(graph, last_op[kk], f);
+    last_op[kk] = f;
+    for(std::size_t i = k + 1; i < nt; ++i) {
+      std::size_t ik = (i * (i + 1)) / 2 + k;
+      task_graph::task_id s = graph.add_task(TaskType(&data, TaskType::solve_op, i, k, k));
+      parallel_decomp_add_dependency(graph, last_op[ik], s);
+      parallel_decomp_add_dependency(graph, f, s);
+      last_op[ik] = s;
+    };
+    for(std::size_t j = k + 1; j < nt; ++j) {
+      std::size_t jk = (j * (j + 1)) / 2 + k;
+      for(std::size_t i = j; i < nt; ++i) {
+        std::size_t ij = (i * (i + 1)) / 2 + j;
+        std::size_t ik = (i * (i + 1)) / 2 + k;
+        task_graph::task_id u = graph.add_task(TaskType(&data, TaskType::update_op, i, j, k));
+        parallel_decomp_add_dependency(graph, last_op[ij], u);
+        parallel_decomp_add_dependency(graph, last_op[ik], u);
+        if(i != j)
+          parallel_decomp_add_dependency(graph, last_op[jk], u);
+        last_op[ij] = u;
+      };
+    };
+  };
+  graph.run(aPool);
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< (mat_traits<Matrix2>::structure == mat_structure::lower_triangular),
+void >::type parallel_Cholesky_store(const Matrix1& L_tmp, Matrix2& L) {
+  L = L_tmp;
+};
+
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< (mat_traits<Matrix2>::structure != mat_structure::lower_triangular),
+void >::type parallel_Cholesky_store(const Matrix1& L_tmp, Matrix2& L) {
+  typedef typename mat_traits<Matrix1>::size_type SizeType;
+  SizeType N = L_tmp.get_row_count();
+  L.set_col_count(N);
+  for(SizeType j = 0; j < N; ++j)
+    for(SizeType i = j; i < N; ++i)
+      L(i,j) = L_tmp(i,j);
+};
+
+
+/*************************************************************************
+                        Blocked QR Decomposition
+*************************************************************************/
+
+template <typename Matrix>
+struct blocked_QR_data {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+
+  Matrix* p_R;   ///< Holds A on input, R (upper part) and the Householder vectors (lower part) on output.
+  Matrix* p_Q;   ///< Holds the identity on input, Q on output.
+  std::vector<ValueType> v_head;  ///< The first element of each Householder vector.
+  std::vector<ValueType> beta;    ///< The coefficient of each Householder reflection.
+  SizeType reflection_count;
+  SizeType tile_size;
+  ValueType num_tol;
+
+  SizeType col_begin(SizeType k) const { return k * tile_size; };
+  SizeType col_end(SizeType k) const {
+    return ((k + 1) * tile_size < p_R->get_col_count() ? (k + 1) * tile_size : p_R->get_col_count());
+  };
+  SizeType row_begin(SizeType r) const { return r * tile_size; };
+  SizeType row_end(SizeType r) const {
+    return ((r + 1) * tile_size < p_Q->get_row_count() ? (r + 1) * tile_size : p_Q->get_row_count());
+  };
+  /* Reflections of the panel k (clipped to the number of reflections). */
+  SizeType refl_end(SizeType k) const {
+    return (col_end(k) < reflection_count ? col_end(k) : reflection_count);
+  };
+};
+
+/* Applies the Householder reflection c (stored in column c of R) to the column col of R. */
+template <typename Matrix>
+void blocked_QR_reflect_col(const blocked_QR_data<Matrix>& D, std::size_t c, std::size_t col) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  using std::fabs;
+  if(fabs(D.beta[c]) < std::numeric_limits<ValueType>::epsilon())
+    return;
+  Matrix& R = *D.p_R;
+  SizeType N = R.get_row_count();
+  ValueType temp = D.v_head[c] * R(c,col);
+  for(SizeType i = c + 1; i < N; ++i)
+    temp += R(i,c) * R(i,col);
+  temp *= D.beta[c];
+  R(c,col) -= temp * D.v_head[c];
+  for(SizeType i = c + 1; i < N; ++i)
+    R(i,col) -= temp * R(i,c);
+};
+
+/* Computes the Householder reflections of the column-panel k and applies them within the panel. */
+template <typename Matrix>
+void blocked_QR_panel(blocked_QR_data<Matrix>& D, std::size_t k) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  using std::sqrt;
+  Matrix& R = *D.p_R;
+  SizeType N = R.get_row_count();
+  SizeType c_end = D.refl_end(k);
+  for(SizeType c = D.col_begin(k); c < c_end; ++c) {
+    // same Householder vector as householder_matrix::set, but the tail of the vector is the tail of the column.
+    ValueType sigma = ValueType(0);
+    for(SizeType i = c + 1; i < N; ++i)
+      sigma += R(i,c) * R(i,c);
+    ValueType x0 = R(c,c);
+    if(sigma < D.num_tol * D.num_tol) {
+      D.v_head[c] = ValueType(1);
+      D.beta[c] = ValueType(0);
+    } else {
+      ValueType mu = sqrt(sigma + x0 * x0);
+      if(x0 < D.num_tol)
+        D.v_head[c] = x0 - mu;
+      else
+        D.v_head[c] = -sigma / (x0 + mu);
+      D.beta[c] = ValueType(2) / (sigma + D.v_head[c] * D.v_head[c]);
+      R(c,c) = x0 - D.beta[c] * (D.v_head[c] * x0 + sigma) * D.v_head[c];
+    };
+    for(SizeType col = c + 1; col < D.col_end(k); ++col)
+      blocked_QR_reflect_col(D, c, col);
+  };
+};
+
+/* Applies the Householder reflections of the panel k to the column-block j (j > k). */
+template <typename Matrix>
+void blocked_QR_update(const blocked_QR_data<Matrix>& D, std::size_t k, std::size_t j) {
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  SizeType c_end = D.refl_end(k);
+  SizeType col_end = D.col_end(j);
+  for(SizeType c = D.col_begin(k); c < c_end; ++c)
+    for(SizeType col = D.col_begin(j); col < col_end; ++col)
+      blocked_QR_reflect_col(D, c, col);
+};
+
+/* Post-multiplies the row-block r of Q by the Householder reflections of the panel k. */
+template <typename Matrix>
+void blocked_QR_update_Q(const blocked_QR_data<Matrix>& D, std::size_t k, std::size_t r) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  using std::fabs;
+  const Matrix& R = *D.p_R;
+  Matrix& Q = *D.p_Q;
+  SizeType N = R.get_row_count();
+  SizeType r0 = D.row_begin(r);
+  SizeType r1 = D.row_end(r);
+  std::vector<ValueType> temp(r1 - r0);
+  SizeType c_end = D.refl_end(k);
+  for(SizeType c = D.col_begin(k); c < c_end; ++c) {
+    if(fabs(D.beta[c]) < std::numeric_limits<ValueType>::epsilon())
+      continue;
+    for(SizeType row = r0; row < r1; ++row)
+      temp[row - r0] = Q(row,c) * D.v_head[c];
+    for(SizeType i = c + 1; i < N; ++i) {
+      ValueType v_i = R(i,c);
+      for(SizeType row = r0; row < r1; ++row)
+        temp[row - r0] += Q(row,i) * v_i;
+    };
+    for(SizeType row = r0; row < r1; ++row) {
+      temp[row - r0] *= D.beta[c];
+      Q(row,c) -= temp[row - r0] * D.v_head[c];
+    };
+    for(SizeType i = c + 1; i < N; ++i) {
+      ValueType v_i = R(i,c);
+      for(SizeType row = r0; row < r1; ++row)
+        Q(row,i) -= temp[row - r0] * v_i;
+    };
+  };
+};
+
+template <typename Matrix>
+struct blocked_QR_task {
+  enum op_kind { panel_op, update_op, update_Q_op };
+
+  blocked_QR_data<Matrix>* p_data;
+  op_kind op;
+  std::size_t k;
+  std::size_t j;
+
+  blocked_QR_task(blocked_QR_data<Matrix>* aData, op_kind aOp, std::size_t aK, std::size_t aJ) :
+                  p_data(aData), op(aOp), k(aK), j(aJ) { };
+
+  void operator()() const {
+    switch(op) {
+      case panel_op:
+        blocked_QR_panel(*p_data, k);
+        break;
+      case update_op:
+        blocked_QR_update(*p_data, k, j);
+        break;
+      case update_Q_op:
+        blocked_QR_update_Q(*p_data, k, j);
+        break;
+    };
+  };
+};
+
+/* Computes, in-place, the QR decomposition of the (column-major) matrix R, with Q initially set to identity. */
+template <typename Matrix>
+void decompose_QR_blocked_impl(thread_pool& aPool, Matrix& R, Matrix& Q, typename mat_traits<Matrix>::value_type NumTol) {
+  typedef typename mat_traits<Matrix>::value_type ValueType;
+  typedef typename mat_traits<Matrix>::size_type SizeType;
+  typedef blocked_QR_task<Matrix> TaskType;
+  SizeType N = R.get_row_count();
+  SizeType M = R.get_col_count();
+  blocked_QR_data<Matrix> data;
+  data.p_R = &R;
+  data.p_Q = &Q;
+  data.reflection_count = (N - 1 > M ? M : N - 1);
+  data.v_head.resize(data.reflection_count, ValueType(1));
+  data.beta.resize(data.reflection_count, ValueType(0));
+  data.tile_size = parallel_decomp_tile_size(M, aPool.size(), 2);
+  data.num_tol = NumTol;
+  std::size_t panel_count = (data.reflection_count + data.tile_size - 1) / data.tile_size;
+  std::size_t col_blocks = (M + data.tile_size - 1) / data.tile_size;
+  std::size_t row_blocks = (N + data.tile_size - 1) / data.tile_size;
+
+  task_graph graph;
+  std::vector< task_graph::task_id > last_col_op(col_blocks, std::numeric_limits<task_graph::task_id>::max());
+  std::vector< task_graph::task_id > last_row_op(row_blocks, std::numeric_limits<task_graph::task_id>::max());
+  for(std::size_t k = 0; k < panel_count; ++k) {
+    task_graph::task_id p = graph.add_task(TaskType(&data, TaskType::panel_op, k, k));
+    parallel_decomp_add_dependency(graph, last_col_op[k], p);
+    last_col_op[k] = p;
+    for(std::size_t j = k + 1; j < col_blocks; ++j) {
+      task_graph::task_id u = graph.add_task(TaskType(&data, TaskType::update_op, k, j));
+      parallel_decomp_add_dependency(graph, last_col_op[j], u);
+      parallel_decomp_add_dependency(graph, p, u);
+      last_col_op[j] = u;
+    };
+    for(std::size_t r = 0; r < row_blocks; ++r) {
+      task_graph::task_id u = graph.add_task(TaskType(&data, TaskType::update_Q_op, k, r));
+      parallel_decomp_add_dependency(graph, last_row_op[r], u);
+      parallel_decomp_add_dependency(graph, p, u);
+      last_row_op[r] = u;
+    };
+  };
+  graph.run(aPool);
+
+  // clear the Householder vectors to leave only R.
+  for(SizeType j = 0; j < M; ++j)
+    for(SizeType i = j + 1; i < N; ++i)
+      R(i,j) = ValueType(0);
+};
+
+};
+
+
+/**
+ * Performs the Cholesky decomposition of A (positive-definite symmetric matrix), using a tiled
+ * algorithm whose tile-operations are executed concurrently on a thread-pool.
+ * Returns a Lower-triangular matrix such that A = L * transpose(L). If the matrix is small
+ * or the pool has a single thread, this is the same as the single-threaded decompose_Cholesky function.
+ *
+ * \param aPool The thread-pool on which to execute the decomposition (must not be called from one of its tasks).
+ * \param A real, positive-definite, symmetric, square, full-rank matrix to be decomposed.
+ * \param L stores, as output, the lower-triangular matrix in A = L * transpose(L).
+ * \param NumTol tolerance for considering a value to be zero in avoiding divisions
+ *               by zero and singularities.
+ *
+ * \throws singularity_error if the matrix A is singular (or rank-deficient) or not positive-definite.
+ *
+ * \note the symmetry or positive-definitiveness of the matrix A is not checked and thus it is
+ *       the caller's responsibility to ensure it's correct.
+ *
+ * \author Mikael Persson
+ */
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
+                             ((mat_traits<Matrix1>::structure == mat_structure::square) ||
+                              (mat_traits<Matrix1>::structure == mat_structure::symmetric) ||
+                              (mat_traits<Matrix1>::structure == mat_structure::tridiagonal)) &&
+                             is_writable_matrix<Matrix2>::value &&
+                             (is_resizable_matrix<Matrix2>::value || is_fixed_size_matrix<Matrix2>::value ||
+                              (mat_traits<Matrix2>::structure == mat_structure::lower_triangular)),
+void >::type decompose_Cholesky(thread_pool& aPool, const Matrix1& A, Matrix2& L, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  typedef typename mat_traits<Matrix1>::size_type SizeType;
+  SizeType N = A.get_row_count();
+  if(!detail::parallel_decomp_is_worthwhile(N, aPool)) {
+    decompose_Cholesky(A,L,NumTol);
+    return;
+  };
+  typename arena_mat<ValueType, mat_structure::rectangular>::type L_tmp(N,N,ValueType(0));
+  for(SizeType j = 0; j < N; ++j)
+    for(SizeType i = j; i < N; ++i)
+      L_tmp(i,j) = A(i,j);
+  detail::decompose_Cholesky_tiled_impl(aPool,L_tmp,NumTol);
+  detail::parallel_Cholesky_store(L_tmp,L);
+};
+
+
+/**
+ * Performs the QR decomposition on a matrix, using a blocked Householder reflections approach
+ * whose block-operations are executed concurrently on a thread-pool. If the matrix is small or
+ * the pool has a single thread, this is the same as the single-threaded decompose_QR function.
+ *
+ * \tparam Matrix1 A readable matrix type.
+ * \tparam Matrix2 A fully-writable matrix type.
+ * \tparam Matrix3 A fully-writable matrix type, or a writable upper-triangular matrix type.
+ * \param aPool The thread-pool on which to execute the decomposition (must not be called from one of its tasks).
+ * \param A rectangular matrix with row-count >= column-count, a real full-rank matrix.
+ * \param Q holds as output, the orthogonal rectangular matrix Q.
+ * \param R holds as output, the upper-triangular or right-triangular matrix R in A = QR.
+ * \param NumTol tolerance for considering a value to be zero in avoiding divisions
+ *               by zero and singularities.
+ *
+ * \throws std::range_error if the matrix A does not have equal-or-more rows than columns.
+ *
+ * \author Mikael Persson
+ */
+template <typename Matrix1, typename Matrix2, typename Matrix3>
+typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
+                             is_fully_writable_matrix<Matrix2>::value &&
+                             (is_fully_writable_matrix<Matrix3>::value ||
+                              (is_writable_matrix<Matrix3>::value &&
+                               (mat_traits<Matrix3>::structure == mat_structure::upper_triangular))),
+void >::type decompose_QR(thread_pool& aPool, const Matrix1& A, Matrix2& Q, Matrix3& R, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
+  if(A.get_row_count() < A.get_col_count())
+    throw std::range_error("QR decomposition is only possible on a matrix with row-count >= column-count!");
+  if(!detail::parallel_decomp_is_worthwhile(A.get_col_count(), aPool)) {
+    decompose_QR(A,Q,R,NumTol);
+    return;
+  };
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  typedef typename arena_mat<ValueType, mat_structure::rectangular>::type WorkMatrix;
+
+  WorkMatrix R_tmp(A);
+  WorkMatrix Q_tmp(A.get_row_count(),A.get_row_count(),ValueType(0));
+  for(std::size_t i = 0; i < A.get_row_count(); ++i)
+    Q_tmp(i,i) = ValueType(1);
+  detail::decompose_QR_blocked_impl(aPool,R_tmp,Q_tmp,NumTol);
+  Q = Q_tmp;
+  R = R_tmp;
+};
+
+
+};
+
+#endif
@@ -49,6 +49,8 @@
 
 #include "mat_alg.hpp"
 #include "mat_num_exceptions.hpp"
+#include "mat_lapack_backend.hpp"
+#include "mat_fixed_decomp.hpp"
 
 #include "mat_householder.hpp"
 
@@ -497,23 +499,28 @@ void linlsq_QR_impl(const Matrix1& A, Matrix2& x,const Matrix3& b, typename mat_
   using std::fabs;
   typedef typename mat_traits<Matrix1>::value_type ValueType;
   typedef typename mat_traits<Matrix1>::size_type SizeType;
+  if(fixed_linlsq_QR(A,x,b,NumTol))
+    return;
+  if(lapack_linlsq_QR(A,x,b,NumTol))
+    return;
+  typedef typename arena_mat<ValueType,mat_structure::rectangular>::type WorkMatrix;
   SizeType N = A.get_row_count();
   SizeType M = A.get_col_count();
-  mat<ValueType,mat_structure::rectangular> R = mat<ValueType,mat_structure::rectangular>(A);
-  householder_matrix< vect_n<ValueType> > hhm;
+  WorkMatrix R(A);
+  householder_matrix< typename arena_vect_n<ValueType>::type > hhm;
   
-  mat<ValueType, mat_structure::rectangular> b_store = mat<ValueType, mat_structure::rectangular>(b);
+  WorkMatrix b_store(b);
 
   SizeType t = (N-1 > M ? M : N-1);
 
   for(SizeType i=0;i<t;++i) {
     
-    hhm.set(mat_row_slice< mat<ValueType,mat_structure::rectangular> >(R,i,i,N - i),NumTol);
+    hhm.set(mat_row_slice< WorkMatrix >(R,i,i,N - i),NumTol);
     
-    mat_sub_block< mat<ValueType,mat_structure::rectangular> > subR(R,N - i,M - i,i,i);
+    mat_sub_block< WorkMatrix > subR(R,N - i,M - i,i,i);
     householder_prod(hhm,subR); // P * R
     
-    mat_sub_block< mat<ValueType, mat_structure::rectangular> > subb(b_store,b_store.get_row_count() - i,b_store.get_col_count(),i,0);
+    mat_sub_block< WorkMatrix > subb(b_store,b_store.get_row_count() - i,b_store.get_col_count(),i,0);
     householder_prod(hhm,subb); // P * b
     
   };
@@ -560,6 +567,10 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
 void >::type decompose_QR(const Matrix1& A, Matrix2& Q, Matrix3& R, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
   if(A.get_row_count() < A.get_col_count())
     throw std::range_error("QR decomposition is only possible on a matrix with row-count >= column-count!");
+  if(detail::fixed_decompose_QR(A,Q,R,NumTol))
+    return;
+  if(detail::lapack_decompose_QR(A,Q,R,NumTol))
+    return;
 
   typedef typename mat_traits<Matrix1>::value_type ValueType;
   
@@ -710,13 +721,14 @@ void >::type minnorm_QR(const Matrix1& A, Matrix2& x, const Matrix3& b, typename
     throw std::range_error("Linear Minimum-Norm solution is only possible if row count of b is equal to row count of A!");
   
   typedef typename mat_traits<Matrix1>::value_type ValueType;
+  typedef typename arena_mat<ValueType,mat_structure::rectangular>::type WorkMatrix;
   
-  mat<ValueType,mat_structure::rectangular> R(A);
-  mat_transpose_view< mat<ValueType,mat_structure::rectangular> > R_t(R);
-  mat<ValueType,mat_structure::square> Q = mat<ValueType,mat_structure::square>(mat<ValueType,mat_structure::identity>(A.get_col_count()));
+  WorkMatrix R(A);
+  mat_transpose_view< WorkMatrix > R_t(R);
+  typename arena_mat<ValueType,mat_structure::square>::type Q(mat<ValueType,mat_structure::identity>(A.get_col_count()));
   detail::decompose_QR_impl(R_t, &Q, NumTol);
   
-  mat<ValueType,mat_structure::rectangular> b_tmp(b);
+  WorkMatrix b_tmp(b);
   detail::forwardsub_L_impl(R, b_tmp, NumTol);
   x = sub(Q)(range(0, A.get_col_count()),range(0, A.get_row_count())) * b_tmp;
   
@@ -38,6 +38,7 @@
 
 #include "mat_alg.hpp"
 #include "mat_num_exceptions.hpp"
+#include "mat_lapack_backend.hpp"
 
 #include "mat_householder.hpp"
 #include "mat_hess_decomp.hpp"
@@ -1078,6 +1079,8 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
 void >::type decompose_RealSchur(const Matrix1& A, Matrix2& Q, Matrix3& T, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
   if(A.get_row_count() != A.get_col_count())
     throw std::range_error("Real Schur decomposition is only possible on a square matrix!");
+  if(detail::lapack_decompose_RealSchur(A,&Q,T))
+    return;
 
   Q = mat< typename mat_traits<Matrix2>::value_type, mat_structure::identity>(A.get_row_count());
   T = A;
@@ -1106,6 +1109,8 @@ typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
 void >::type decompose_RealSchur(const Matrix1& A, Matrix2& T, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
   if(A.get_row_count() != A.get_col_count())
     throw std::range_error("Real Schur decomposition is only possible on a square matrix!");
+  if(detail::lapack_decompose_RealSchur(A,static_cast<Matrix2*>(NULL),T))
+    return;
 
   T = A;
   detail::schur_decomp_impl(T,static_cast<Matrix2*>(NULL),NumTol);
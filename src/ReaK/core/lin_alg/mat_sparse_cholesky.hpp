@@ -0,0 +1,426 @@
+/**
+ * \file mat_sparse_cholesky.hpp
+ *
+ * This library provides a sparse LDL^T (square-root-free Cholesky) decomposition for symmetric
+ * matrices stored as sparse matrices (see mat_alg_sparse.hpp). The rows and columns of the matrix
+ * are first re-ordered with a minimum-degree ordering in order to limit the fill-in of the factor,
+ * then the elimination tree and the pattern of the factor are computed (symbolic analysis), and
+ * finally the numerical factorization is performed with an up-looking algorithm. The cost of the
+ * factorization and of the solutions is thus proportional to the number of non-zero entries (and
+ * operations) of the factor, instead of the cube of the matrix dimension. The symbolic analysis can
+ * be re-used to factorize other matrices with the same sparsity pattern, which is typical of the
+ * KKT systems solved at every iteration of an optimization method. Because the diagonal factor D is
+ * allowed to have negative entries, this decomposition also applies to symmetric quasi-definite
+ * matrices (e.g., regularized KKT matrices), for which any symmetric ordering is stable.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_MAT_SPARSE_CHOLESKY_HPP
+#define REAK_MAT_SPARSE_CHOLESKY_HPP
+
+#include "mat_alg.hpp"
+#include "mat_num_exceptions.hpp"
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+namespace ReaK {
+
+
+namespace detail {
+
+/* Computes a minimum-degree ordering of a graph given by (sorted) adjacency lists without self-loops,
+ * by simulating the elimination on the elimination graph (the neighbors of an eliminated node become
+ * a clique). Ties are broken by the lowest index. The adjacency lists are consumed. */
+inline void minimum_degree_ordering_impl(std::vector< std::vector<std::size_t> >& adj, std::vector<std::size_t>& perm) {
+  std::size_t n = adj.size();
+  perm.clear();
+  perm.reserve(n);
+  std::set< std::pair<std::size_t, std::size_t> > queue;
+  for(std::size_t i = 0; i < n; ++i)
+    queue.insert(std::make_pair(adj[i].size(), i));
+  std::vector<std::size_t> merged;
+  while(!queue.empty()) {
+    std::size_t v = queue.begin()->second;
+    queue.erase(queue.begin());
+    perm.push_back(v);
+    const std::vector<std::size_t>& nv = adj[v];
+    for(std::size_t k = 0; k < nv.size(); ++k) {
+      std::size_t u = nv[k];
+      queue.erase(std::make_pair(adj[u].size(), u));
+      merged.clear();
+      std::set_union(adj[u].begin(), adj[u].end(), nv.begin(), nv.end(), std::back_inserter(merged));
+      adj[u].clear();
+      for(std::size_t m = 0; m < merged.size(); ++m)
+        if((merged[m] != u) && (merged[m] != v))
+          adj[u].push_back(merged[m]);
+      queue.insert(std::make_pair(adj[u].size(), u));
+    };
+    std::vector<std::size_t>().swap(adj[v]);
+  };
+};
+
+/* Calls the functor with the (row, column, position) of each stored entry of a sparse matrix. */
+template <typename T, mat_alignment::tag Alignment, typename Allocator, typename EntryVisitor>
+void for_each_sparse_entry(const mat<T,mat_structure::sparse,Alignment,Allocator>& A, EntryVisitor& vis) {
+  typedef typename mat<T,mat_structure::sparse,Alignment,Allocator>::size_type SizeType;
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& outer = A.get_outer_starts();
+  const typename mat<T,mat_structure::sparse,Alignment,Allocator>::index_container_type& inner = A.get_inner_indices();
+  for(SizeType o = 0; o + 1 < outer.size(); ++o)
+    for(SizeType p = outer[o]; p < outer[o + 1]; ++p) {
+      if(Alignment == mat_alignment::column_major)
+        vis(inner[p], o, p);
+      else
+        vis(o, inner[p], p);
+    };
+};
+
+struct sparse_upper_adjacency_builder {
+  std::vector< std::vector<std::size_t> >* p_adj;
+  explicit sparse_upper_adjacency_builder(std::vector< std::vector<std::size_t> >& aAdj) : p_adj(&aAdj) { };
+  void operator()(std::size_t i, std::size_t j, std::size_t) {
+    if(i < j) {
+      (*p_adj)[i].push_back(j);
+      (*p_adj)[j].push_back(i);
+    };
+  };
+};
+
+struct sparse_upper_permuted_builder {
+  const std::vector<std::size_t>* p_perm_inv;
+  std::vector<std::size_t>* p_start;
+  std::vector<std::size_t>* p_idx;
+  std::vector<std::size_t>* p_src;
+  bool counting;
+  sparse_upper_permuted_builder(const std::vector<std::size_t>& aPermInv, std::vector<std::size_t>& aStart,
+                                std::vector<std::size_t>& aIdx, std::vector<std::size_t>& aSrc) :
+                                p_perm_inv(&aPermInv), p_start(&aStart), p_idx(&aIdx), p_src(&aSrc), counting(true) { };
+  void operator()(std::size_t i, std::size_t j, std::size_t p) {
+    if(i > j)
+      return;
+    std::size_t pi = (*p_perm_inv)[i];
+    std::size_t pj = (*p_perm_inv)[j];
+    if(pi > pj)
+      std::swap(pi, pj);
+    if(counting) {
+      ++(*p_start)[pj + 1];
+    } else {
+      std::size_t q = (*p_start)[pj]++;
+      (*p_idx)[q] = pi;
+      (*p_src)[q] = p;
+    };
+  };
+};
+
+};
+
+
+/**
+ * Computes a fill-reducing (minimum-degree) ordering of the rows and columns of a symmetric sparse matrix.
+ * Only the upper-triangular part of A (entries with i <= j) is used, the lower part is assumed to be symmetric.
+ *
+ * \param A symmetric, square sparse matrix.
+ * \param perm stores, as output, the ordering, such that perm[k] is the index of the k-th pivot.
+ *
+ * \throws std::range_error if the matrix A is not square.
+ *
+ * \author Mikael Persson
+ */
+template <typename T, mat_alignment::tag Alignment, typename Allocator>
+void minimum_degree_ordering(const mat<T,mat_structure::sparse,Alignment,Allocator>& A, std::vector<std::size_t>& perm) {
+  if(A.get_row_count() != A.get_col_count())
+    throw std::range_error("Minimum-degree ordering is only possible on a square matrix!");
+  std::vector< std::vector<std::size_t> > adj(A.get_row_count());
+  detail::sparse_upper_adjacency_builder builder(adj);
+  detail::for_each_sparse_entry(A, builder);
+  for(std::size_t i = 0; i < adj.size(); ++i) {
+    std::sort(adj[i].begin(), adj[i].end());
+    adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+  };
+  detail::minimum_degree_ordering_impl(adj, perm);
+};
+
+
+/**
+ * This class template holds a sparse LDL^T decomposition of a symmetric matrix, that is, P A P^T = L D L^T,
+ * where P is a fill-reducing (minimum-degree) permutation, L is a sparse unit-lower-triangular matrix and D
+ * is a diagonal matrix. The decomposition is done in two phases: the symbolic analysis (see analyze()), which
+ * only depends on the sparsity pattern of the matrix, and the numerical factorization (see factorize()), which
+ * can be repeated for any matrix with the same sparsity pattern. Only the upper-triangular part of the matrix
+ * (entries with i <= j) is used, the lower part is assumed to be symmetric.
+ *
+ * \tparam T The value-type of the matrix.
+ */
+template <typename T>
+class sparse_LDL {
+  public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+  private:
+    size_type n;
+    size_type nnzA;
+    std::vector<size_type> perm;     ///< perm[k] is the original index of the k-th pivot.
+    std::vector<size_type> perm_inv; ///< perm_inv[i] is the pivot position of the original index i.
+    std::vector<size_type> C_start;  ///< Column starts of the upper part of P A P^T (compressed columns).
+    std::vector<size_type> C_idx;    ///< Row indices of the upper part of P A P^T.
+    std::vector<size_type> C_src;    ///< Position, in the values of A, of each entry of the upper part of P A P^T.
+    std::vector<size_type> parent;   ///< Elimination tree (parent[k] == n for a root).
+    std::vector<size_type> L_start;  ///< Column starts of L (compressed columns, the unit diagonal is not stored).
+    std::vector<size_type> L_idx;    ///< Row indices of L.
+    std::vector<value_type> L_val;   ///< Values of L.
+    std::vector<value_type> D;       ///< Diagonal factor.
+
+  public:
+
+    /**
+     * Default constructor, creates an empty decomposition.
+     */
+    sparse_LDL() : n(0), nnzA(0), C_start(1,0), L_start(1,0) { };
+
+    /**
+     * Constructs the decomposition of a sparse matrix (both the symbolic analysis and the numerical factorization).
+     * \param A symmetric, square sparse matrix to be decomposed.
+     * \param NumTol tolerance on the magnitude of the pivots (entries of D) for considering the matrix singular.
+     * \throws singularity_error if the matrix A is singular.
+     * \throws std::range_error if the matrix A is not square.
+     */
+    template <mat_alignment::tag Alignment, typename Allocator>
+    explicit sparse_LDL(const mat<T,mat_structure::sparse,Alignment,Allocator>& A, value_type NumTol = value_type(1E-8)) :
+                        n(0), nnzA(0), C_start(1,0), L_start(1,0) {
+      analyze(A);
+      factorize(A,NumTol);
+    };
+
+    /**
+     * Performs the symbolic analysis of a sparse matrix, i.e., computes the fill-reducing ordering,
+     * the elimination tree and the sparsity pattern of the factor L.
+     * \param A symmetric, square sparse matrix whose pattern is to be analyzed.
+     * \throws std::range_error if the matrix A is not square.
+     */
+    template <mat_alignment::tag Alignment, typename Allocator>
+    void analyze(const mat<T,mat_structure::sparse,Alignment,Allocator>& A) {
+      minimum_degree_ordering(A, perm);
+      n = A.get_row_count();
+      nnzA = A.get_nonzero_count();
+      perm_inv.resize(n);
+      for(size_type k = 0; k < n; ++k)
+        perm_inv[perm[k]] = k;
+
+      // gather the upper part of P A P^T, by columns.
+      C_start.assign(n + 1, 0);
+      detail::sparse_upper_permuted_builder builder(perm_inv, C_start, C_idx, C_src);
+      detail::for_each_sparse_entry(A, builder);
+      for(size_type k = 0; k < n; ++k)
+        C_start[k + 1] += C_start[k];
+      C_idx.resize(C_start[n]);
+      C_src.resize(C_start[n]);
+      builder.counting = false;
+      detail::for_each_sparse_entry(A, builder);
+      for(size_type k = n; k > 0; --k)
+        C_start[k] = C_start[k - 1];
+      C_start[0] = 0;
+
+      // elimination tree and column counts of L.
+      parent.assign(n, n);
+      std::vector<size_type> flag(n);
+      std::vector<size_type> col_count(n, 0);
+      for(size_type k = 0; k < n; ++k) {
+        flag[k] = k;
+        for(size_type p = C_start[k]; p < C_start[k + 1]; ++p) {
+          for(size_type i = C_idx[p]; (i < k) && (flag[i] != k); i = parent[i]) {
+            if(parent[i] == n)
+              parent[i] = k;
+            ++col_count[i];
+            flag[i] = k;
+          };
+        };
+      };
+      L_start.resize(n + 1);
+      L_start[0] = 0;
+      for(size_type k = 0; k < n; ++k)
+        L_start[k + 1] = L_start[k] + col_count[k];
+      L_idx.resize(L_start[n]);
+      L_val.resize(L_start[n]);
+      D.resize(n);
+    };
+
+    /**
+     * Performs the numerical factorization of a sparse matrix with the same sparsity pattern as
+     * the matrix given to the last call to analyze().
+     * \param A symmetric, square sparse matrix to be decomposed.
+     * \param NumTol tolerance on the magnitude of the pivots (entries of D) for considering the matrix singular.
+     * \throws singularity_error if the matrix A is singular.
+     * \throws std::range_error if the matrix A does not have the analyzed sparsity pattern.
+     */
+    template <mat_alignment::tag Alignment, typename Allocator>
+    void factorize(const mat<T,mat_structure::sparse,Alignment,Allocator>& A, value_type NumTol = value_type(1E-8)) {
+      using std::fabs;
+      if((A.get_row_count() != n) || (A.get_col_count() != n) || (A.get_nonzero_count() != nnzA))
+        throw std::range_error("The sparsity pattern of the matrix does not match the analyzed pattern!");
+      const typename mat<T,mat_structure::sparse,Alignment,Allocator>::container_type& Ax = A.get_values();
+
+      std::vector<value_type> y(n, value_type(0));
+      std::vector<size_type> pattern(n);
+      std::vector<size_type> flag(n);
+      std::vector<size_type> L_count(n, 0);
+      for(size_type k = 0; k < n; ++k) {
+        // scatter column k of the upper part of P A P^T and find the pattern of row k of L (reach in the etree).
+        size_type top = n;
+        flag[k] = k;
+        for(size_type p = C_start[k]; p < C_start[k + 1]; ++p) {
+          size_type i = C_idx[p];
+          y[i] += Ax[C_src[p]];
+          size_type len = 0;
+          for(; (i < k) && (flag[i] != k); i = parent[i]) {
+            pattern[len++] = i;
+            flag[i] = k;
+          };
+          while(len > 0)
+            pattern[--top] = pattern[--len];
+        };
+        // sparse triangular solve for row k of L, and the pivot D(k).
+        D[k] = y[k];
+        y[k] = value_type(0);
+        for(; top < n; ++top) {
+          size_type i = pattern[top];
+          value_type yi = y[i];
+          y[i] = value_type(0);
+          size_type p_end = L_start[i] + L_count[i];
+          for(size_type p = L_start[i]; p < p_end; ++p)
+            y[L_idx[p]] -= L_val[p] * yi;
+          value_type l_ki = yi / D[i];
+          D[k] -= l_ki * yi;
+          L_idx[p_end] = k;
+          L_val[p_end] = l_ki;
+          ++L_count[i];
+        };
+        if(fabs(D[k]) < NumTol)
+          throw singularity_error("A");
+      };
+    };
+
+    /**
+     * Solves the linear system A x = b, in-place.
+     * \tparam Vector A writable vector type.
+     * \param b stores, as input, the right-hand-side of the system and, as output, the solution x.
+     * \throws std::range_error if the size of b does not match the matrix dimension.
+     */
+    template <typename Vector>
+    void solve(Vector& b) const {
+      if(b.size() != n)
+        throw std::range_error("For linear equation solution, vector b must have the same size as the matrix!");
+      std::vector<value_type> x(n);
+      for(size_type k = 0; k < n; ++k)
+        x[k] = b[perm[k]];
+      for(size_type j = 0; j < n; ++j)
+        for(size_type p = L_start[j]; p < L_start[j + 1]; ++p)
+          x[L_idx[p]] -= L_val[p] * x[j];
+      for(size_type j = 0; j < n; ++j)
+        x[j] /= D[j];
+      for(size_type j = n; j > 0; --j)
+        for(size_type p = L_start[j - 1]; p < L_start[j]; ++p)
+          x[j - 1] -= L_val[p] * x[L_idx[p]];
+      for(size_type k = 0; k < n; ++k)
+        b[perm[k]] = x[k];
+    };
+
+    /**
+     * Gets the dimension of the decomposed matrix.
+     * \return The dimension of the decomposed matrix.
+     */
+    size_type size() const { return n; };
+
+    /**
+     * Gets the number of stored (non-zero, off-diagonal) entries of the factor L.
+     * \return The number of stored entries of the factor L.
+     */
+    size_type get_nonzero_count() const { return L_idx.size(); };
+
+    /**
+     * Gets the fill-reducing ordering, such that perm[k] is the original index of the k-th pivot.
+     * \return The fill-reducing ordering.
+     */
+    const std::vector<size_type>& get_permutation() const { return perm; };
+
+    /**
+     * Gets the diagonal factor D (in the pivot order).
+     * \return The diagonal factor D.
+     */
+    const std::vector<value_type>& get_diagonal() const { return D; };
+
+};
+
+
+/**
+ * Solves the linear problem AX = B using a sparse Cholesky (LDL^T) decomposition.
+ *
+ * \param A real, positive-definite, symmetric, square, full-rank sparse matrix (only the upper part is used).
+ * \param b stores, as input, the RHS of the linear system of equation and stores, as output,
+ *          the solution matrix x (Size x B_ColCount).
+ * \param NumTol tolerance for considering a value to be zero in avoiding divisions
+ *               by zero and singularities.
+ *
+ * \throws singularity_error if the matrix A is singular (or not positive-definite).
+ * \throws std::range_error if the matrix A is not square or if b's row count does not match that of A.
+ *
+ * \note if you wish to apply this method with a vector on the RHS, then use ReaK::mat_vect_adaptor (and related classes).
+ *
+ * \author Mikael Persson
+ */
+template <typename Matrix1, typename Matrix2>
+typename boost::enable_if_c< is_readable_matrix<Matrix1>::value &&
+                             (mat_traits<Matrix1>::structure == mat_structure::sparse) &&
+                             is_writable_matrix<Matrix2>::value,
+void >::type linsolve_Cholesky(const Matrix1& A, Matrix2& b, typename mat_traits<Matrix1>::value_type NumTol = 1E-8) {
+  if(b.get_row_count() != A.get_col_count())
+    throw std::range_error("For linear equation solution, matrix b must have same row count as A!");
+
+  typedef typename mat_traits<Matrix1>::value_type ValueType;
+  typedef typename mat_traits<Matrix1>::size_type SizeType;
+  sparse_LDL<ValueType> LDL(A, NumTol);
+  for(SizeType i = 0; i < LDL.size(); ++i)
+    if(LDL.get_diagonal()[i] < NumTol)
+      throw singularity_error("A");
+  vect_n<ValueType> x(b.get_row_count());
+  for(SizeType j = 0; j < b.get_col_count(); ++j) {
+    for(SizeType i = 0; i < x.size(); ++i)
+      x[i] = b(i,j);
+    LDL.solve(x);
+    for(SizeType i = 0; i < x.size(); ++i)
+      b(i,j) = x[i];
+  };
+};
+
+
+};
+
+
+#endif
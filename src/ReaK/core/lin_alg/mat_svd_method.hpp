@@ -46,6 +46,7 @@
 
 #include "mat_alg.hpp"
 #include "mat_num_exceptions.hpp"
+#include "mat_lapack_backend.hpp"
 
 
 namespace ReaK {
@@ -106,6 +107,9 @@ void >::type decompose_SVD(const Matrix1& A, Matrix2& U, Matrix3& E, Matrix4& V,
   using std::fabs; 
   using std::sqrt;
 
+  if(detail::lapack_decompose_SVD(A,U,E,V))
+    return;
+
   mat<ValueType,mat_structure::rectangular> At, Ut, Vt;
   if(A.get_row_count() < A.get_col_count())
     At = transpose_view(A);
@@ -43,6 +43,7 @@
 #include <boost/config.hpp>
 #include <boost/concept_check.hpp>
 #include <boost/type_traits.hpp>
+#include <boost/mpl/has_xxx.hpp>
 
 namespace ReaK {
   
@@ -68,7 +69,9 @@ namespace mat_structure {
    * populated). Then, the frequently used tags are square, symmetric, skew_symmetric, and 
    * diagonal. Additionally, the nil and identity tags signify that a matrix type is constraint
    * to never be anything other than nil or identity (obviously, these types will be read-only
-   * and do not require storage other than the size information).
+   * and do not require storage other than the size information). Finally, the sparse tag
+   * signifies a general (rectangular) matrix in which only the non-zero entries are stored
+   * (compressed storage, see mat_alg_sparse.hpp).
    */
   enum tag {
     rectangular = 1,
@@ -83,7 +86,8 @@ namespace mat_structure {
     nil = 10,
     identity = 11,
     scalar = 12,
-    permutation = 13
+    permutation = 13,
+    sparse = 14
   };
 };
   
@@ -207,6 +211,13 @@ struct get_type_id< boost::mpl::integral_c<mat_structure::tag, mat_structure::pe
   static construct_ptr CreatePtr() { return NULL; };
 };
 
+template <>
+struct get_type_id< boost::mpl::integral_c<mat_structure::tag, mat_structure::sparse > > {
+  BOOST_STATIC_CONSTANT(unsigned int, ID = 14);
+  static std::string type_name() { return "sparse"; };
+  static construct_ptr CreatePtr() { return NULL; };
+};
+
 
 template <mat_structure::tag U, typename Tail>
 struct get_type_info< boost::mpl::integral_c<mat_structure::tag, U >, Tail > {
@@ -218,6 +229,13 @@ struct get_type_info< boost::mpl::integral_c<mat_structure::tag, U >, Tail > {
 };
 
 
+namespace detail {
+  
+  BOOST_MPL_HAS_XXX_TRAIT_NAMED_DEF(has_nested_value_type, value_type, false)
+  
+};
+
+
 /**
  * This type-traits definition describes the nested typedefs that are expected 
  * from an implementation of a matrix class. They are mostly inspired from 
@@ -226,8 +244,11 @@ struct get_type_info< boost::mpl::integral_c<mat_structure::tag, U >, Tail > {
  * nested typedefs and static constants. The other alternative, which is non-intrusive,
  * is to define a specialization for mat_traits for the new matrix class, providing
  * all the public members as seen in this general trait template.
+ * \note For a type which does not have the nested typedefs of a matrix (e.g., when the
+ *       matrix functions are looked up for a call with a thread-pool as first argument),
+ *       the trait is empty, such that the function templates using it are discarded (SFINAE).
  */
-template <typename Matrix>
+template <typename Matrix, bool HasMatrixTypedefs = detail::has_nested_value_type<Matrix>::value>
 struct mat_traits {
   /// The type of the elements of the matrix.
   typedef typename Matrix::value_type value_type;
@@ -267,6 +288,9 @@ struct mat_traits {
   
 };
 
+template <typename Matrix>
+struct mat_traits<Matrix, false> { };
+
 
 
 /*
@@ -398,6 +422,14 @@ namespace detail {
     typedef product_priority<mat_structure::permutation> type;
   };
   
+  template <>
+  struct product_priority<mat_structure::sparse> {
+    typedef boost::mpl::integral_c_tag tag;
+    typedef std::size_t value_type;
+    BOOST_STATIC_CONSTANT(std::size_t, value = 1);
+    typedef product_priority<mat_structure::sparse> type;
+  };
+  
   
   
   
@@ -473,6 +505,14 @@ namespace detail {
     typedef addition_priority<mat_structure::permutation> type;
   };
   
+  template <>
+  struct addition_priority<mat_structure::sparse> {
+    typedef boost::mpl::integral_c_tag tag;
+    typedef std::size_t value_type;
+    BOOST_STATIC_CONSTANT(std::size_t, value = 1);
+    typedef addition_priority<mat_structure::sparse> type;
+  };
+  
   template <>
   struct addition_priority<mat_structure::upper_triangular> {
     typedef boost::mpl::integral_c_tag tag;
@@ -0,0 +1,181 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/lin_alg/mat_alg.hpp>
+
+#include <ReaK/core/base/chrono_incl.hpp>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <fstream>
+
+
+/*
+ * This program compares the matrix products computed by the packed, cache-blocked kernel (which
+ * is used by operator* on dense matrices of doubles) with those of the element-wise triple loop
+ * (which is still used for all other matrix types, such as the matrix slices and views), for
+ * square matrices of increasing sizes and for the different storage alignments.
+ */
+
+namespace {
+
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+void naive_multiply(const Matrix1& M1, const Matrix2& M2, ResultMatrix& MR) {
+  for(std::size_t i = 0; i < M1.get_row_count(); ++i) {
+    for(std::size_t jj = 0; jj < M2.get_col_count(); ++jj) {
+      MR(i,jj) = 0.0;
+      for(std::size_t j = 0; j < M1.get_col_count(); ++j)
+        MR(i,jj) += M1(i,j) * M2(j,jj);
+    };
+  };
+};
+
+template <typename Matrix1, typename Matrix2>
+double max_rel_difference(const Matrix1& M1, const Matrix2& M2) {
+  double result = 0.0;
+  for(std::size_t i = 0; i < M1.get_row_count(); ++i) {
+    for(std::size_t j = 0; j < M1.get_col_count(); ++j) {
+      double d = std::fabs(M1(i,j) - M2(i,j)) / (1.0 + std::fabs(M2(i,j)));
+      if(d > result)
+        result = d;
+    };
+  };
+  return result;
+};
+
+template <typename Matrix>
+void fill_random(Matrix& M, boost::random::mt19937& aGen) {
+  boost::random::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for(std::size_t j = 0; j < M.get_col_count(); ++j)
+    for(std::size_t i = 0; i < M.get_row_count(); ++i)
+      M(i,j) = dist(aGen);
+};
+
+};
+
+
+int main() {
+
+  using namespace ReaK;
+
+  using namespace ReaKaux::chrono;
+
+  boost::random::mt19937 gen(42);
+  unsigned int failed = 0;
+
+  std::ofstream out_stream;
+  out_stream.open("gemm_performance_data.dat");
+  out_stream << "N\tNaive\tGEMM\tGEMM_RowMajor\tGEMM_Mixed" << std::endl;
+  std::cout << "Recording performance (in GFLOPS)..." << std::endl;
+  std::cout << "N\tNaive\tGEMM\tGEMM_RowMajor\tGEMM_Mixed" << std::endl;
+
+  const std::size_t sizes[] = {4, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024};
+  for(std::size_t s = 0; s < sizeof(sizes) / sizeof(std::size_t); ++s) {
+    std::size_t n = sizes[s];
+    // repeat the small products enough to get meaningful timings.
+    std::size_t reps = 1 + (64 * 64 * 64 * 16) / (n * n * n);
+    double flops = 2.0 * double(n) * double(n) * double(n) * double(reps);
+
+    mat<double,mat_structure::rectangular> A(n,n), B(n,n), C_naive(n,n), C(n,n);
+    fill_random(A, gen);
+    fill_random(B, gen);
+    mat<double,mat_structure::rectangular,mat_alignment::row_major> A_r(A), B_r(B), C_r(n,n);
+    mat<double,mat_structure::square> B_sq(B);
+
+    high_resolution_clock::duration dt[4];
+
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    naive_multiply(A, B, C_naive);
+    for(std::size_t r = 1; r < reps; ++r)
+      naive_multiply(A, B, C_naive);
+    dt[0] = high_resolution_clock::now() - t1;
+
+    t1 = high_resolution_clock::now();
+    for(std::size_t r = 0; r < reps; ++r)
+      C = A * B;
+    dt[1] = high_resolution_clock::now() - t1;
+    if(max_rel_difference(C, C_naive) > 1e-12 * double(n)) {
+      std::cout << "The column-major product of size " << n << " does not match the naive product!" << std::endl;
+      ++failed;
+    };
+
+    t1 = high_resolution_clock::now();
+    for(std::size_t r = 0; r < reps; ++r)
+      C_r = A_r * B_r;
+    dt[2] = high_resolution_clock::now() - t1;
+    if(max_rel_difference(C_r, C_naive) > 1e-12 * double(n)) {
+      std::cout << "The row-major product of size " << n << " does not match the naive product!" << std::endl;
+      ++failed;
+    };
+
+    t1 = high_resolution_clock::now();
+    for(std::size_t r = 0; r < reps; ++r)
+      C_r = A_r * B_sq;
+    dt[3] = high_resolution_clock::now() - t1;
+    if(max_rel_difference(C_r, C_naive) > 1e-12 * double(n)) {
+      std::cout << "The mixed-alignment product of size " << n << " does not match the naive product!" << std::endl;
+      ++failed;
+    };
+
+    out_stream << n;
+    std::cout << n;
+    for(std::size_t k = 0; k < 4; ++k) {
+      double gflops = flops / double(duration_cast<nanoseconds>(dt[k]).count());
+      out_stream << "\t" << gflops;
+      std::cout << "\t" << gflops;
+    };
+    out_stream << std::endl;
+    std::cout << std::endl;
+  };
+  out_stream.close();
+
+  // non-square and thin products, which exercise the edges of the blocking.
+  const std::size_t shapes[][3] = {{1,1,1}, {1,300,1}, {300,1,300}, {7,513,5}, {257,3,129}, {130,270,97}, {9,2100,13}};
+  for(std::size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); ++s) {
+    mat<double,mat_structure::rectangular> A(shapes[s][0],shapes[s][1]), B(shapes[s][1],shapes[s][2]), C_naive(shapes[s][0],shapes[s][2]);
+    fill_random(A, gen);
+    fill_random(B, gen);
+    naive_multiply(A, B, C_naive);
+    mat<double,mat_structure::rectangular> C = A * B;
+    mat<double,mat_structure::rectangular,mat_alignment::row_major> A_r(A);
+    mat<double,mat_structure::rectangular,mat_alignment::row_major> C_r = A_r * B;
+    if((max_rel_difference(C, C_naive) > 1e-12 * double(shapes[s][1])) ||
+       (max_rel_difference(C_r, C_naive) > 1e-12 * double(shapes[s][1]))) {
+      std::cout << "The product of sizes " << shapes[s][0] << "x" << shapes[s][1] << " and "
+                << shapes[s][1] << "x" << shapes[s][2] << " does not match the naive product!" << std::endl;
+      ++failed;
+    };
+  };
+
+  if(failed) {
+    std::cout << failed << " products did not match the naive products!" << std::endl;
+    return 1;
+  };
+  std::cout << "All products matched the naive products." << std::endl;
+
+  return 0;
+};
+
@@ -29,9 +29,13 @@
 #include <ReaK/core/lin_alg/mat_qr_decomp.hpp>
 #include <ReaK/core/lin_alg/mat_svd_method.hpp>
 #include <ReaK/core/lin_alg/mat_schur_decomp.hpp>
+#include <ReaK/core/lin_alg/mat_lapack_backend.hpp>
 
 #include <ReaK/core/base/chrono_incl.hpp>
 
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
 #include <iostream>
 #include <fstream>
 #include <cstdio>
@@ -146,6 +150,60 @@ int main() {
     };
     std::cout << "Done!" << std::endl;
     out_stream.close();
+    
+    // compare the generic methods with the LAPACK backend (if compiled-in), on dense matrices.
+    out_stream.open("performance_backend_data.dat");
+    out_stream << "N\tChol\tChol_LAPACK\tQR\tQR_LAPACK\tSVD\tSVD_LAPACK\tSchur\tSchur_LAPACK" << std::endl;
+    std::cout << "Recording performance of the LAPACK backend (" << (has_lapack_backend() ? "available" : "not available") << ")..." << std::endl;
+    boost::random::mt19937 rand_gen(42);
+    boost::random::uniform_real_distribution<double> rand_dist(-1.0,1.0);
+    for(unsigned int i = 50; i <= 500; i += 50) {
+      mat<double,mat_structure::square> m_rand(i);
+      for(unsigned int j = 0; j < i; ++j)
+        for(unsigned int k = 0; k < i; ++k)
+          m_rand(j,k) = rand_dist(rand_gen) + (j == k ? 2.0 : 0.0);
+      mat<double,mat_structure::square> m_spd = transpose_view(m_rand) * m_rand;
+      mat<double,mat_structure::square> m_rhs(m_rand);
+      
+      high_resolution_clock::duration dt_b[8];
+      for(unsigned int b = 0; b < 8; ++b)
+        dt_b[b] = high_resolution_clock::duration(0);
+      for(unsigned int use_lapack = 0; use_lapack < 2; ++use_lapack) {
+        if(use_lapack && !has_lapack_backend())
+          break;
+        enable_lapack_backend(use_lapack != 0);
+        
+        mat<double,mat_structure::square> m_x(m_rhs);
+        t1 = high_resolution_clock::now();
+        linsolve_Cholesky(m_spd,m_x,double(1E-15));
+        dt_b[use_lapack] = high_resolution_clock::now() - t1;
+        
+        mat<double,mat_structure::square> m_Q(i), m_R(i);
+        t1 = high_resolution_clock::now();
+        decompose_QR(m_rand,m_Q,m_R,double(1E-15));
+        dt_b[2 + use_lapack] = high_resolution_clock::now() - t1;
+        
+        mat<double,mat_structure::diagonal> m_E(i);
+        mat<double,mat_structure::square> m_U(i), m_V(i);
+        t1 = high_resolution_clock::now();
+        decompose_SVD(m_rand,m_U,m_E,m_V,double(1E-15));
+        dt_b[4 + use_lapack] = high_resolution_clock::now() - t1;
+        
+        mat<double,mat_structure::square> m_Z(i), m_T(i);
+        t1 = high_resolution_clock::now();
+        decompose_RealSchur(m_rand,m_Z,m_T,double(1E-8));
+        dt_b[6 + use_lapack] = high_resolution_clock::now() - t1;
+      };
+      enable_lapack_backend(true);
+      
+      out_stream << i;
+      for(unsigned int b = 0; b < 8; ++b)
+        out_stream << "\t" << duration_cast<microseconds>(dt_b[b]).count();
+      out_stream << std::endl;
+      std::cout << i << std::endl;
+    };
+    std::cout << "Done!" << std::endl;
+    out_stream.close();
   
   } catch(std::exception& e) {
     RK_ERROR("An exception has occurred during the math_gen test: '" << e.what() << "'");
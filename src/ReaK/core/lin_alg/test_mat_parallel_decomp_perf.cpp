@@ -0,0 +1,128 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/core/lin_alg/mat_alg.hpp>
+#include <ReaK/core/lin_alg/mat_cholesky.hpp>
+#include <ReaK/core/lin_alg/mat_qr_decomp.hpp>
+#include <ReaK/core/lin_alg/mat_parallel_decomp.hpp>
+
+#include <ReaK/core/base/chrono_incl.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <fstream>
+
+
+/*
+ * This program records the speedup of the tiled Cholesky and blocked QR decompositions (on a 
+ * thread-pool) over the single-threaded decompositions, for matrices of increasing sizes and
+ * for pools of 1, 2, 4, 8, ... threads (up to the number of hardware threads, or 8 at least).
+ */
+
+namespace {
+
+template <typename Matrix>
+void fill_random(Matrix& M, boost::random::mt19937& aGen) {
+  boost::random::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for(std::size_t j = 0; j < M.get_col_count(); ++j)
+    for(std::size_t i = 0; i < M.get_row_count(); ++i)
+      M(i,j) = dist(aGen);
+};
+
+double to_seconds(ReaKaux::chrono::high_resolution_clock::duration dt) {
+  return double(ReaKaux::chrono::duration_cast<ReaKaux::chrono::nanoseconds>(dt).count()) * 1e-9;
+};
+
+};
+
+
+int main() {
+
+  using namespace ReaK;
+
+  using namespace ReaKaux::chrono;
+
+  boost::random::mt19937 gen(42);
+
+  std::size_t max_threads = ReaKaux::thread::hardware_concurrency();
+  if(max_threads < 8)
+    max_threads = 8;
+  std::vector<std::size_t> thread_counts;
+  for(std::size_t t = 1; t <= max_threads; t *= 2)
+    thread_counts.push_back(t);
+
+  std::ofstream out_stream;
+  out_stream.open("parallel_decomp_performance_data.dat");
+  out_stream << "N\tThreads\tCholesky_Serial\tCholesky_Tiled\tCholesky_Speedup\tQR_Serial\tQR_Blocked\tQR_Speedup" << std::endl;
+  std::cout << "Recording performance (times in seconds)..." << std::endl;
+  std::cout << "N\tThreads\tCholesky_Serial\tCholesky_Tiled\tCholesky_Speedup\tQR_Serial\tQR_Blocked\tQR_Speedup" << std::endl;
+
+  const std::size_t sizes[] = {256, 512, 1024};
+  for(std::size_t s = 0; s < sizeof(sizes) / sizeof(std::size_t); ++s) {
+    std::size_t n = sizes[s];
+
+    mat<double,mat_structure::rectangular> A(n,n);
+    fill_random(A, gen);
+    mat<double,mat_structure::symmetric> A_spd(transpose_view(A) * A);
+    for(std::size_t i = 0; i < n; ++i)
+      A_spd(i,i) += double(n);
+
+    mat<double,mat_structure::square> L(n);
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    decompose_Cholesky(A_spd, L, 1E-8);
+    double chol_serial = to_seconds(high_resolution_clock::now() - t1);
+
+    mat<double,mat_structure::rectangular> Q, R;
+    t1 = high_resolution_clock::now();
+    decompose_QR(A, Q, R, 1E-8);
+    double qr_serial = to_seconds(high_resolution_clock::now() - t1);
+
+    for(std::size_t t = 0; t < thread_counts.size(); ++t) {
+      thread_pool pool(thread_counts[t]);
+
+      t1 = high_resolution_clock::now();
+      decompose_Cholesky(pool, A_spd, L, 1E-8);
+      double chol_tiled = to_seconds(high_resolution_clock::now() - t1);
+
+      t1 = high_resolution_clock::now();
+      decompose_QR(pool, A, Q, R, 1E-8);
+      double qr_blocked = to_seconds(high_resolution_clock::now() - t1);
+
+      out_stream << n << "\t" << thread_counts[t]
+                 << "\t" << chol_serial << "\t" << chol_tiled << "\t" << (chol_serial / chol_tiled)
+                 << "\t" << qr_serial << "\t" << qr_blocked << "\t" << (qr_serial / qr_blocked) << std::endl;
+      std::cout << n << "\t" << thread_counts[t]
+                << "\t" << chol_serial << "\t" << chol_tiled << "\t" << (chol_serial / chol_tiled)
+                << "\t" << qr_serial << "\t" << qr_blocked << "\t" << (qr_serial / qr_blocked) << std::endl;
+    };
+  };
+  out_stream.close();
+
+  return 0;
+};
@@ -23,10 +23,13 @@
 
 #include <ReaK/core/base/defs.hpp>
 #include <ReaK/core/lin_alg/mat_alg.hpp>
+#include <ReaK/core/lin_alg/mat_cholesky.hpp>
+#include <ReaK/core/lin_alg/mat_expression_templates.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <cmath>
 
 #define BOOST_TEST_DYN_LINK
 
@@ -314,3 +317,308 @@ BOOST_AUTO_TEST_CASE( mat_operator_tests )
 };
 
 
+/* Fills a matrix with deterministic values in [-1,1]. */
+template <typename Matrix>
+void fill_gemm_test_matrix(Matrix& M, std::size_t aSeed) {
+  typedef typename ReaK::mat_traits<Matrix>::value_type ValueType;
+  for(std::size_t i = 0; i < M.get_row_count(); ++i)
+    for(std::size_t j = 0; j < M.get_col_count(); ++j)
+      M(i,j) = ValueType(std::sin(double(i * 131 + j * 17 + aSeed)));
+};
+
+/* Checks a product against the naive triple loop (accumulated in double), relative to the sum of absolute terms. */
+template <typename Matrix1, typename Matrix2, typename ResultMatrix>
+bool matches_naive_product(const Matrix1& M1, const Matrix2& M2, const ResultMatrix& MR, double aTol) {
+  using std::fabs;
+  if((MR.get_row_count() != M1.get_row_count()) || (MR.get_col_count() != M2.get_col_count()))
+    return false;
+  for(std::size_t i = 0; i < M1.get_row_count(); ++i) {
+    for(std::size_t j = 0; j < M2.get_col_count(); ++j) {
+      double sum = 0.0, abs_sum = 0.0;
+      for(std::size_t l = 0; l < M1.get_col_count(); ++l) {
+        sum += double(M1(i,l)) * double(M2(l,j));
+        abs_sum += fabs(double(M1(i,l)) * double(M2(l,j)));
+      };
+      if(fabs(double(MR(i,j)) - sum) > aTol * (abs_sum + 1.0))
+        return false;
+    };
+  };
+  return true;
+};
+
+typedef boost::mpl::list< float, double > gemm_test_value_types;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( mat_gemm_kernel_tests, T, gemm_test_value_types )
+{
+  using namespace ReaK;
+  
+  typedef mat<T,mat_structure::rectangular,mat_alignment::column_major> ColMat;
+  typedef mat<T,mat_structure::rectangular,mat_alignment::row_major> RowMat;
+  
+  const double tol = 10.0 * double(std::numeric_limits<T>::epsilon());
+  
+  // sizes above the packing threshold, not multiples of the micro-kernel size (8 x 6), 
+  // with k above the panel depth (256), and with m above the panel height (96).
+  const std::size_t shapes[][3] = {{37, 29, 41}, {19, 300, 23}, {101, 263, 55}, {9, 531, 7}, {130, 17, 97}};
+  
+  for(std::size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); ++s) {
+    const std::size_t m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+    ColMat A_c(m,k), B_c(k,n);
+    RowMat A_r(m,k), B_r(k,n);
+    fill_gemm_test_matrix(A_c, 1); fill_gemm_test_matrix(A_r, 1);
+    fill_gemm_test_matrix(B_c, 7); fill_gemm_test_matrix(B_r, 7);
+    
+    // through the product operators:
+    BOOST_CHECK( matches_naive_product(A_c, B_c, ColMat(A_c * B_c), tol) );
+    BOOST_CHECK( matches_naive_product(A_r, B_r, ColMat(A_r * B_r), tol) );
+    BOOST_CHECK( matches_naive_product(A_c, B_r, ColMat(A_c * B_r), tol) );
+    BOOST_CHECK( matches_naive_product(A_r, B_c, ColMat(A_r * B_c), tol) );
+    
+    // directly into results of either alignment:
+    ColMat C_c(m,n);
+    RowMat C_r(m,n);
+    detail::dense_mat_multiply_impl(A_r, B_c, C_c);
+    BOOST_CHECK( matches_naive_product(A_r, B_c, C_c, tol) );
+    detail::dense_mat_multiply_impl(A_c, B_r, C_r);
+    BOOST_CHECK( matches_naive_product(A_c, B_r, C_r, tol) );
+    detail::dense_mat_multiply_impl(A_r, B_r, C_r);
+    BOOST_CHECK( matches_naive_product(A_r, B_r, C_r, tol) );
+    detail::dense_mat_multiply_impl(A_c, B_c, C_r);
+    BOOST_CHECK( matches_naive_product(A_c, B_c, C_r, tol) );
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( mat_expression_template_tests )
+{
+  using namespace ReaK;
+  using std::fabs;
+  const double tol = 1e-12;
+  
+  mat<double,mat_structure::rectangular> A(4,4), B(4,2);
+  mat<double,mat_structure::symmetric> P(4), Q(2);
+  for(std::size_t i = 0; i < 4; ++i) {
+    for(std::size_t j = 0; j < 4; ++j) {
+      A(i,j) = std::sin(double(3 * i + j + 1));
+      if(j >= i)
+        P(i,j) = std::cos(double(i + 2 * j)) + (i == j ? 4.0 : 0.0);
+    };
+    B(i,0) = std::cos(double(i + 1)); 
+    B(i,1) = std::sin(double(2 * i + 5));
+  };
+  Q(0,0) = 2.0; Q(0,1) = 0.5; Q(1,1) = 1.0;
+  
+  // sandwich products (covariance propagation), fused with a sum into a symmetric matrix.
+  mat<double,mat_structure::rectangular> P_eager = A * P * transpose_view(A) + B * Q * transpose_view(B);
+  mat<double,mat_structure::symmetric> P_lazy;
+  evaluate_into(sandwich_product(A, P) + sandwich_product(B, Q), P_lazy);
+  BOOST_CHECK( sandwich_product(A, P).is_symmetric() );
+  BOOST_CHECK( !(lazy_expr(A) * lazy_expr(P) * transpose(lazy_expr(B * transpose_view(B)))).is_symmetric() );
+  BOOST_CHECK( ( P_lazy.get_row_count() == 4 ) && ( P_lazy.get_col_count() == 4 ) );
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( fabs(P_lazy(i,j) - P_eager(i,j)) < tol );
+  
+  // the same, into a rectangular matrix (only half is computed, and mirrored).
+  mat<double,mat_structure::rectangular> P_rect(4,4);
+  evaluate_into(sandwich_product(A, P) + sandwich_product(B, Q), P_rect);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( fabs(P_rect(i,j) - P_eager(i,j)) < tol );
+  
+  // evaluation into one of the factors of a nested product.
+  mat<double,mat_structure::symmetric> P2(P);
+  evaluate_into(sandwich_product(A, P2) + sandwich_product(B, Q), P2);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( fabs(P2(i,j) - P_eager(i,j)) < tol );
+  
+  // element-wise operations, transposes, scaling and nested products.
+  mat<double,mat_structure::rectangular> R_eager((A - transpose(A)) * 2.0 - A * A * B * transpose(B) + (-P));
+  mat<double,mat_structure::rectangular> R_lazy;
+  evaluate_into((lazy_expr(A) - transpose(lazy_expr(A))) * 2.0 - lazy_expr(A) * lazy_expr(A) * lazy_expr(B) * transpose(lazy_expr(B)) + (-lazy_expr(P)), R_lazy);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( fabs(R_lazy(i,j) - R_eager(i,j)) < tol );
+  
+  // a plain product of dense matrices (goes to the blocked kernel), and into one of its operands.
+  mat<double,mat_structure::rectangular> AB_eager = A * B;
+  mat<double,mat_structure::rectangular> AB_lazy(4,2);
+  evaluate_into(lazy_expr(A) * lazy_expr(B), AB_lazy);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 2; ++j)
+      BOOST_CHECK( fabs(AB_lazy(i,j) - AB_eager(i,j)) < tol );
+  mat<double,mat_structure::rectangular> AA_eager = A * A;
+  evaluate_into(lazy_expr(A) * lazy_expr(A), A);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( fabs(A(i,j) - AA_eager(i,j)) < tol );
+  
+  // vector expressions.
+  vect_n<double> x(1.0, -2.0, 0.5, 3.0), y(0.1, 0.2, 0.3, 0.4);
+  vect_n<double> z_eager = A * (P * x) + 2.0 * y - x;
+  vect_n<double> z_lazy;
+  evaluate_into(lazy_expr(A) * (lazy_expr(P) * lazy_expr(x)) + 2.0 * lazy_expr(y) - lazy_expr(x), z_lazy);
+  BOOST_CHECK( z_lazy.size() == 4 );
+  for(std::size_t i = 0; i < 4; ++i)
+    BOOST_CHECK( fabs(z_lazy[i] - z_eager[i]) < tol );
+  
+  // dimension mismatches are reported at the creation of the expression.
+  BOOST_CHECK_THROW( lazy_expr(A) + lazy_expr(B), std::range_error );
+  BOOST_CHECK_THROW( lazy_expr(B) * lazy_expr(A), std::range_error );
+};
+
+
+
+
+BOOST_AUTO_TEST_CASE( mat_arena_allocator_tests )
+{
+  using namespace ReaK;
+  using std::fabs;
+  const double tol = 1e-12;
+  
+  memory_arena arena(1024);
+  
+  // outside of any scope, the arena allocator uses the heap.
+  {
+    arena_mat<double>::type M(4,4,1.0);
+    BOOST_CHECK( arena.get_capacity() == 0 );
+    BOOST_CHECK( arena_scope::get_active_scope() == NULL );
+  };
+  
+  mat<double,mat_structure::square> A(4);
+  for(std::size_t i = 0; i < 4; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      A(i,j) = 1.0 / double(i + j + 1);
+  vect_n<double> x(1.0, -2.0, 0.5, 3.0);
+  mat<double,mat_structure::square> AA = A * A;
+  vect_n<double> Ax = A * x;
+  
+  {
+    arena_scope scope(arena);
+    BOOST_CHECK( arena_scope::get_active_scope() == &scope );
+    
+    arena_mat<double,mat_structure::square>::type A_a(A);
+    arena_vect_n<double>::type x_a(x);
+    BOOST_CHECK( arena.owns(&A_a(0,0)) );
+    BOOST_CHECK( arena.owns(&x_a[0]) );
+    std::size_t used = arena.get_size();
+    BOOST_CHECK( used >= 20 * sizeof(double) );
+    
+    arena_mat<double,mat_structure::square>::type AA_a = A_a * A_a;
+    arena_vect_n<double>::type Ax_a = A_a * x_a;
+    for(std::size_t i = 0; i < 4; ++i) {
+      BOOST_CHECK( fabs(Ax_a[i] - Ax[i]) < tol );
+      for(std::size_t j = 0; j < 4; ++j)
+        BOOST_CHECK( fabs(AA_a(i,j) - AA(i,j)) < tol );
+    };
+    
+    // the most recent allocation is reclaimed immediately.
+    std::size_t before = arena.get_size();
+    {
+      arena_vect_n<double>::type tmp(16, 0.0);
+      BOOST_CHECK( arena.get_size() > before );
+    };
+    BOOST_CHECK( arena.get_size() == before );
+    
+    // a nested scope is rewound at its end, and can grow the arena beyond one block.
+    {
+      arena_scope inner(arena);
+      arena_mat<double>::type big(40,40,1.0);
+      BOOST_CHECK( arena.owns(&big(0,0)) );
+      BOOST_CHECK( arena.get_capacity() > 1024 );
+    };
+    BOOST_CHECK( arena.get_size() == before );
+    BOOST_CHECK( arena_scope::get_active_scope() == &scope );
+    
+    // decompositions use the arena for their work matrices.
+    mat<double,mat_structure::symmetric> S(A * transpose_view(A) + mat<double,mat_structure::identity>(4));
+    arena_mat<double>::type b_a(4,1,1.0);
+    linsolve_Cholesky(S, b_a);
+    arena_mat<double>::type r(S * b_a);
+    for(std::size_t i = 0; i < 4; ++i)
+      BOOST_CHECK( fabs(r(i,0) - 1.0) < 1e-10 );
+  };
+  BOOST_CHECK( arena_scope::get_active_scope() == NULL );
+  BOOST_CHECK( arena.get_size() == 0 );
+  
+  // once grown, the arena serves the same computation without any new block.
+  std::size_t cap = 0;
+  for(std::size_t k = 0; k < 3; ++k) {
+    {
+      arena_scope scope(arena);
+      arena_mat<double>::type big(40,40,1.0);
+      arena_mat<double>::type big2 = big * big;
+      BOOST_CHECK( fabs(big2(3,5) - 40.0) < tol );
+    };
+    if(k > 0)
+      BOOST_CHECK( arena.get_capacity() == cap );
+    cap = arena.get_capacity();
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( mat_sparse_tests )
+{
+  using namespace ReaK;
+  using std::fabs;
+  
+  // triplets, with a duplicated entry that must be summed.
+  std::vector<std::size_t> rows, cols;
+  std::vector<double> vals;
+  rows.push_back(0); cols.push_back(0); vals.push_back(1.0);
+  rows.push_back(2); cols.push_back(1); vals.push_back(2.0);
+  rows.push_back(0); cols.push_back(0); vals.push_back(3.0);
+  rows.push_back(1); cols.push_back(3); vals.push_back(-1.0);
+  mat<double,mat_structure::sparse> S(3,4,rows,cols,vals);
+  BOOST_CHECK( S.get_row_count() == 3 );
+  BOOST_CHECK( S.get_col_count() == 4 );
+  BOOST_CHECK( S.get_nonzero_count() == 3 );
+  BOOST_CHECK( S(0,0) == 4.0 );
+  BOOST_CHECK( S(2,1) == 2.0 );
+  BOOST_CHECK( S(1,3) == -1.0 );
+  BOOST_CHECK( S(1,1) == 0.0 );
+  
+  rows.push_back(3); cols.push_back(0); vals.push_back(1.0);
+  BOOST_CHECK_THROW( (mat<double,mat_structure::sparse>(3,4,rows,cols,vals)), std::range_error );
+  
+  mat<double,mat_structure::rectangular> D(3,4);
+  for(std::size_t i = 0; i < 3; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      D(i,j) = ((i + 2 * j) % 3 == 0 ? 0.0 : double(i + 1) - double(j));
+  mat<double,mat_structure::sparse> S_c(D);
+  mat<double,mat_structure::sparse,mat_alignment::row_major> S_r(D);
+  std::size_t nnz = 0;
+  for(std::size_t i = 0; i < 3; ++i)
+    for(std::size_t j = 0; j < 4; ++j) {
+      if(D(i,j) != 0.0) ++nnz;
+      BOOST_CHECK( S_c(i,j) == D(i,j) );
+      BOOST_CHECK( S_r(i,j) == D(i,j) );
+    };
+  BOOST_CHECK( S_c.get_nonzero_count() == nnz );
+  BOOST_CHECK( S_r.get_nonzero_count() == nnz );
+  
+  vect_n<double> x(1.0, -2.0, 0.5, 3.0);
+  vect_n<double> y(2.0, 1.0, -1.0);
+  vect_n<double> Dx = D * x, yD = y * D;
+  vect_n<double> Sx_c = S_c * x, Sx_r = S_r * x, yS_c = y * S_c, yS_r = y * S_r;
+  for(std::size_t i = 0; i < 3; ++i) {
+    BOOST_CHECK( fabs(Sx_c[i] - Dx[i]) < 1e-12 );
+    BOOST_CHECK( fabs(Sx_r[i] - Dx[i]) < 1e-12 );
+  };
+  for(std::size_t j = 0; j < 4; ++j) {
+    BOOST_CHECK( fabs(yS_c[j] - yD[j]) < 1e-12 );
+    BOOST_CHECK( fabs(yS_r[j] - yD[j]) < 1e-12 );
+  };
+  
+  mat<double,mat_structure::sparse> St = transpose(S_c);
+  BOOST_CHECK( St.get_row_count() == 4 );
+  BOOST_CHECK( St.get_col_count() == 3 );
+  for(std::size_t i = 0; i < 3; ++i)
+    for(std::size_t j = 0; j < 4; ++j)
+      BOOST_CHECK( St(j,i) == D(i,j) );
+  BOOST_CHECK( is_null_mat(S_c * transpose_view(D) - D * transpose_view(D), 1e-12) );
+  
+  mat<double,mat_structure::sparse> S_sq(mat<double,mat_structure::square>(get_block(D,0,0,3,3)));
+  BOOST_CHECK( fabs(trace(S_sq) - (D(0,0) + D(1,1) + D(2,2))) < 1e-12 );
+};
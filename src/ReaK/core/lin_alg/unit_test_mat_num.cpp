@@ -31,10 +31,13 @@
 #include <ReaK/core/lin_alg/mat_schur_decomp.hpp>
 #include <ReaK/core/lin_alg/mat_ctrl_decomp.hpp>
 #include <ReaK/core/lin_alg/mat_balance.hpp>
+#include <ReaK/core/lin_alg/mat_parallel_decomp.hpp>
+#include <ReaK/core/lin_alg/mat_sparse_cholesky.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <cmath>
 
 
 #define BOOST_TEST_DYN_LINK
@@ -633,3 +636,256 @@ BOOST_AUTO_TEST_CASE( mat_balancing_tests )
 
 
 
+
+
+
+BOOST_AUTO_TEST_CASE( mat_lapack_backend_tests )
+{
+  using namespace ReaK;
+  
+  // large enough for the LAPACK backend (when compiled-in), compared to the generic methods.
+  const std::size_t N = 40;
+  mat<double,mat_structure::rectangular> A(N + 5, N);
+  for(std::size_t i = 0; i < N + 5; ++i)
+    for(std::size_t j = 0; j < N; ++j)
+      A(i,j) = std::cos(double(i * i + 3 * j + 1)) + (i == j ? 2.0 : 0.0);
+  mat<double,mat_structure::square> A_sq(get_block(A,0,0,N,N));
+  mat<double,mat_structure::symmetric> A_spd(transpose_view(A) * A);
+  mat<double,mat_structure::rectangular> X(N,2);
+  for(std::size_t i = 0; i < N; ++i) {
+    X(i,0) = 1.0;
+    X(i,1) = double(i);
+  };
+  
+  for(int use_lapack = 0; use_lapack < 2; ++use_lapack) {
+    enable_lapack_backend(use_lapack != 0);
+    
+    mat<double,mat_structure::square> L(N);
+    BOOST_CHECK_NO_THROW( decompose_Cholesky(A_spd,L,1E-8) );
+    BOOST_CHECK( is_null_mat(L * transpose_view(L) - A_spd, 1e-10) );
+    
+    mat<double,mat_structure::rectangular> B(A_spd * X);
+    BOOST_CHECK_NO_THROW( linsolve_Cholesky(A_spd,B,1E-8) );
+    BOOST_CHECK( is_null_mat(B - X, 1e-8) );
+    
+    mat<double,mat_structure::rectangular> Q, R;
+    BOOST_CHECK_NO_THROW( decompose_QR(A,Q,R,1E-8) );
+    BOOST_CHECK( is_null_mat(Q * R - A, 1e-10) );
+    BOOST_CHECK( is_identity_mat(transpose_view(Q) * Q, 1e-10) );
+    
+    // the backend itself must also handle a wide matrix (with min(M,N) elementary reflectors).
+    mat<double,mat_structure::rectangular> A_wide(transpose_view(A)), Q_wide, R_wide;
+    bool wide_done = detail::lapack_decompose_QR(A_wide,Q_wide,R_wide,1E-8);
+#ifdef REAK_HAS_LAPACK
+    BOOST_CHECK( wide_done == (use_lapack != 0) );
+#endif
+    if( wide_done ) {
+      BOOST_CHECK( is_null_mat(Q_wide * R_wide - A_wide, 1e-10) );
+      BOOST_CHECK( is_identity_mat(transpose_view(Q_wide) * Q_wide, 1e-10) );
+    };
+    
+    mat<double,mat_structure::rectangular> x_lsq;
+    BOOST_CHECK_NO_THROW( linlsq_QR(A,x_lsq,mat<double,mat_structure::rectangular>(A * X),1E-8) );
+    BOOST_CHECK( is_null_mat(x_lsq - X, 1e-8) );
+    
+    mat<double,mat_structure::rectangular> U, V;
+    mat<double,mat_structure::diagonal> E;
+    BOOST_CHECK_NO_THROW( decompose_SVD(A,U,E,V,1E-15) );
+    BOOST_CHECK( is_null_mat(U * E * transpose_view(V) - A, 1e-10) );
+    for(std::size_t i = 1; i < N; ++i)
+      BOOST_CHECK( E(i-1,i-1) >= E(i,i) );
+    
+    mat<double,mat_structure::square> Z(N), T(N);
+    BOOST_CHECK_NO_THROW( decompose_RealSchur(A_sq,Z,T,1E-8) );
+    BOOST_CHECK( is_null_mat(Z * T * transpose_view(Z) - A_sq, 1e-8) );
+    for(std::size_t i = 2; i < N; ++i)
+      for(std::size_t j = 0; j + 1 < i; ++j)
+        BOOST_CHECK( std::fabs(T(i,j)) < 1e-8 );
+  };
+  enable_lapack_backend(true);
+  
+};
+
+
+
+
+BOOST_AUTO_TEST_CASE( mat_fixed_size_tests )
+{
+  using namespace ReaK;
+  
+  const double A_vals[] = { 4.0, 1.0, 0.5, 0.2,
+                            1.0, 5.0, 0.3, 0.1,
+                            0.5, 0.3, 6.0, 0.4,
+                            0.2, 0.1, 0.4, 3.0 };
+  mat_fix<double,mat_structure::square,4,4> A(A_vals);
+  mat<double,mat_structure::square> A_dyn(A);
+  
+  mat_fix<double,mat_structure::symmetric,4,4> A_sym(A);
+  BOOST_CHECK( is_null_mat(A_sym - A_dyn, 1e-12) );
+  BOOST_CHECK_CLOSE( trace(A), 18.0, 1e-10 );
+  BOOST_CHECK( is_null_mat(transpose(A) - A_dyn, 1e-12) );
+  
+  const double B_vals[] = { 1.0, 2.0, 3.0, 4.0,  0.5, -1.0, 2.0, 1.5 };
+  mat_fix<double,mat_structure::rectangular,4,2> B(B_vals);
+  mat<double,mat_structure::rectangular> B_dyn(B);
+  BOOST_CHECK( is_null_mat(mat<double,mat_structure::rectangular>(A * B) - A_dyn * B_dyn, 1e-12) );
+  BOOST_CHECK( is_null_mat(mat<double,mat_structure::square>(A + A) - 2.0 * A_dyn, 1e-12) );
+  BOOST_CHECK( is_null_mat(transpose(B) - transpose(B_dyn), 1e-12) );
+  BOOST_CHECK_THROW( B.set_row_count(5), std::range_error );
+  
+  vect<double,4> v(1.0, -2.0, 0.5, 3.0);
+  vect<double,4> Av = A * v;
+  vect_n<double> Av_dyn = A_dyn * vect_n<double>(v.begin(), v.end());
+  for(std::size_t i = 0; i < 4; ++i)
+    BOOST_CHECK_CLOSE( Av[i], Av_dyn[i], 1e-10 );
+  
+  mat_fix<double,mat_structure::square,4,4> L;
+  BOOST_CHECK_NO_THROW( decompose_Cholesky(A_sym,L,1E-12) );
+  BOOST_CHECK( is_null_mat(L * transpose(L) - A_dyn, 1e-10) );
+  
+  mat_fix<double,mat_structure::rectangular,4,2> X(B);
+  BOOST_CHECK_NO_THROW( linsolve_Cholesky(A_sym,X,1E-12) );
+  BOOST_CHECK( is_null_mat(A * X - B_dyn, 1e-10) );
+  
+  mat_fix<double,mat_structure::symmetric,4,4> A_sym_inv;
+  BOOST_CHECK_NO_THROW( invert_Cholesky(A_sym,A_sym_inv,1E-12) );
+  BOOST_CHECK( is_identity_mat(A * A_sym_inv, 1e-10) );
+  
+  mat_fix<double,mat_structure::square,4,4> A_inv;
+  BOOST_CHECK_NO_THROW( invert_gaussian(A,A_inv,1E-12) );
+  BOOST_CHECK( is_identity_mat(A * A_inv, 1e-10) );
+  BOOST_CHECK_NO_THROW( invert_PLU(A,A_inv,1E-12) );
+  BOOST_CHECK( is_identity_mat(A * A_inv, 1e-10) );
+  
+  mat_fix<double,mat_structure::square,4,4> A_lu(A);
+  X = B;
+  BOOST_CHECK_NO_THROW( linsolve_PLU(A_lu,X,1E-12) );
+  BOOST_CHECK( is_null_mat(A * X - B_dyn, 1e-10) );
+  
+  const double C_vals[] = { 1.0, 2.0, 0.5, -1.0, 3.0, 0.2,
+                            0.3, -1.0, 2.0, 1.0, 0.5, 4.0,
+                            2.0, 0.1, 1.0, 0.7, -2.0, 1.0 };
+  mat_fix<double,mat_structure::rectangular,6,3> C(C_vals);
+  mat_fix<double,mat_structure::square,6,6> Q;
+  mat_fix<double,mat_structure::rectangular,6,3> R;
+  BOOST_CHECK_NO_THROW( decompose_QR(C,Q,R,1E-12) );
+  BOOST_CHECK( is_null_mat(Q * R - mat<double,mat_structure::rectangular>(C), 1e-10) );
+  BOOST_CHECK( is_identity_mat(transpose(Q) * Q, 1e-10) );
+  for(std::size_t j = 0; j < 3; ++j)
+    for(std::size_t i = j + 1; i < 6; ++i)
+      BOOST_CHECK( std::fabs(R(i,j)) < 1e-10 );
+  
+  const double x_vals[] = { 1.0, -0.5, 2.0 };
+  mat_fix<double,mat_structure::rectangular,3,1> x_true(x_vals), x_lsq;
+  mat_fix<double,mat_structure::rectangular,6,1> d(C * x_true);
+  BOOST_CHECK_NO_THROW( linlsq_QR(C,x_lsq,d,1E-12) );
+  BOOST_CHECK( is_null_mat(x_lsq - mat<double,mat_structure::rectangular>(x_true), 1e-10) );
+  
+};
+
+
+
+BOOST_AUTO_TEST_CASE( mat_parallel_decomp_tests )
+{
+  using namespace ReaK;
+  
+  // large enough for the tiled decompositions, with sizes that are not multiples of the tile size.
+  const std::size_t N = 301;
+  mat<double,mat_structure::rectangular> A(N + 7, N);
+  for(std::size_t i = 0; i < N + 7; ++i)
+    for(std::size_t j = 0; j < N; ++j)
+      A(i,j) = std::cos(double(i * i + 3 * j + 1)) + (i == j ? 2.0 : 0.0);
+  mat<double,mat_structure::symmetric> A_spd(transpose_view(A) * A);
+  
+  thread_pool pool(4);
+  enable_lapack_backend(false);  // compare to the generic methods (same conventions for the signs).
+  
+  mat<double,mat_structure::square> L(N), L_par(N);
+  BOOST_CHECK_NO_THROW( decompose_Cholesky(A_spd,L,1E-8) );
+  BOOST_CHECK_NO_THROW( decompose_Cholesky(pool,A_spd,L_par,1E-8) );
+  BOOST_CHECK( is_null_mat(L_par - L, 1e-8) );
+  BOOST_CHECK( is_null_mat(L_par * transpose_view(L_par) - A_spd, 1e-8) );
+  
+  mat<double,mat_structure::symmetric> A_neg(-1.0 * A_spd);
+  BOOST_CHECK_THROW( decompose_Cholesky(pool,A_neg,L_par,1E-8), singularity_error );
+  
+  mat<double,mat_structure::rectangular> Q, R, Q_par, R_par;
+  BOOST_CHECK_NO_THROW( decompose_QR(A,Q,R,1E-8) );
+  BOOST_CHECK_NO_THROW( decompose_QR(pool,A,Q_par,R_par,1E-8) );
+  BOOST_CHECK( is_null_mat(Q_par - Q, 1e-8) );
+  BOOST_CHECK( is_null_mat(R_par - R, 1e-8) );
+  BOOST_CHECK( is_null_mat(Q_par * R_par - A, 1e-8) );
+  BOOST_CHECK( is_identity_mat(transpose_view(Q_par) * Q_par, 1e-8) );
+  for(std::size_t j = 0; j < N; ++j)
+    for(std::size_t i = j + 1; i < N + 7; ++i)
+      BOOST_CHECK( R_par(i,j) == 0.0 );
+  
+  mat<double,mat_structure::square> A_sq(get_block(A,0,0,N,N)), Q_sq, R_sq, Q_sq_par, R_sq_par;
+  BOOST_CHECK_NO_THROW( decompose_QR(A_sq,Q_sq,R_sq,1E-8) );
+  BOOST_CHECK_NO_THROW( decompose_QR(pool,A_sq,Q_sq_par,R_sq_par,1E-8) );
+  BOOST_CHECK( is_null_mat(Q_sq_par - Q_sq, 1e-8) );
+  BOOST_CHECK( is_null_mat(R_sq_par - R_sq, 1e-8) );
+  enable_lapack_backend(true);
+  
+};
+
+
+BOOST_AUTO_TEST_CASE( mat_sparse_cholesky_tests )
+{
+  using namespace ReaK;
+  
+  // a 2D grid Laplacian (plus identity), which is sparse and positive-definite.
+  const std::size_t M = 8, N = M * M;
+  std::vector<std::size_t> rows, cols;
+  std::vector<double> vals;
+  for(std::size_t i = 0; i < M; ++i)
+    for(std::size_t j = 0; j < M; ++j) {
+      std::size_t k = i * M + j;
+      rows.push_back(k); cols.push_back(k); vals.push_back(5.0);
+      if(i + 1 < M) {
+        rows.push_back(k); cols.push_back(k + M); vals.push_back(-1.0);
+        rows.push_back(k + M); cols.push_back(k); vals.push_back(-1.0);
+      };
+      if(j + 1 < M) {
+        rows.push_back(k); cols.push_back(k + 1); vals.push_back(-1.0);
+        rows.push_back(k + 1); cols.push_back(k); vals.push_back(-1.0);
+      };
+    };
+  mat<double,mat_structure::sparse> A(N,N,rows,cols,vals);
+  mat<double,mat_structure::symmetric> A_dense(N);
+  for(std::size_t i = 0; i < N; ++i)
+    for(std::size_t j = i; j < N; ++j)
+      A_dense(i,j) = A(i,j);
+  
+  sparse_LDL<double> ldl;
+  BOOST_CHECK_NO_THROW( ldl = sparse_LDL<double>(A,1E-8) );
+  BOOST_CHECK( ldl.size() == N );
+  // the fill-reducing ordering must do better than the dense (banded) factor.
+  BOOST_CHECK( ldl.get_nonzero_count() < N * M );
+  
+  vect_n<double> b(N), x(N);
+  for(std::size_t i = 0; i < N; ++i)
+    b[i] = std::sin(double(i + 1));
+  x = b;
+  ldl.solve(x);
+  BOOST_CHECK( norm_2(A * x - b) < 1e-10 );
+  
+  mat<double,mat_structure::rectangular> B(N,2), X(N,2);
+  for(std::size_t i = 0; i < N; ++i) {
+    B(i,0) = b[i];
+    B(i,1) = std::cos(double(i));
+  };
+  X = B;
+  BOOST_CHECK_NO_THROW( linsolve_Cholesky(A,X,1E-8) );
+  BOOST_CHECK( is_null_mat(A_dense * X - B, 1e-10) );
+  
+  // a negative-definite matrix is factorized by the LDL, but is rejected by the Cholesky solver.
+  mat<double,mat_structure::sparse> A_neg(-1.0 * A_dense);
+  BOOST_CHECK_NO_THROW( ldl = sparse_LDL<double>(A_neg,1E-8) );
+  X = B;
+  BOOST_CHECK_THROW( linsolve_Cholesky(A_neg,X,1E-8), singularity_error );
+  
+  // a singular matrix.
+  mat<double,mat_structure::sparse> A_sing(mat<double,mat_structure::symmetric>(N,1.0));
+  BOOST_CHECK_THROW( (sparse_LDL<double>(A_sing,1E-8)), singularity_error );
+};
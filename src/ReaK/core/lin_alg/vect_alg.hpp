@@ -44,6 +44,7 @@
 #include <limits>
 
 #include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/base/memory_arena.hpp>
 #include <ReaK/core/base/serializable.hpp>
 #include <ReaK/core/rtti/so_register_type.hpp>
 #include <ReaK/core/rtti/typed_primitives.hpp>
@@ -1897,10 +1898,10 @@ class vect_n : public serialization::serializable {
 *******************************************************************************/
 
     virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
-      A & std::pair<std::string, const std::vector<T>&>("q",q);
+      A & std::pair<std::string, const std::vector<T,Allocator>&>("q",q);
     };
     virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
-      A & std::pair<std::string, std::vector<T>&>("q",q);
+      A & std::pair<std::string, std::vector<T,Allocator>&>("q",q);
     };
     
     RK_RTTI_REGISTER_CLASS_1BASE(self,1,serialization::serializable)
@@ -1908,6 +1909,18 @@ class vect_n : public serialization::serializable {
 };
 
 
+/**
+ * This meta-function gives the variable-size vector type whose components are drawn from the
+ * memory arena of the active arena_scope (see ReaK/core/base/memory_arena.hpp), e.g., for
+ * temporaries that are local to a computation.
+ * \tparam T The value-type of the vector.
+ */
+template <typename T>
+struct arena_vect_n {
+  typedef vect_n<T, arena_allocator<T> > type;
+};
+
+
 namespace rtti {
 
 template <typename T,typename Allocator>
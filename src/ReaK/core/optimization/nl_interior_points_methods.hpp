@@ -6,6 +6,9 @@
  * that first solves a quadratic program within a trust-region and then solves an 
  * equality-constrained quadratic program by the projected conjugate gradient method (this 
  * method is essentially an extension of the SQP method to also include inequality constraints).
+ * The internal work matrices of these methods (and of the decompositions they rely on) are drawn
+ * from the memory arena of the active arena_scope, if any (see ReaK/core/base/memory_arena.hpp),
+ * such that a whole optimization can be run within one arena.
  *
  * \author Mikael Persson <mikael.s.persson@gmail.com>
  * \date December 2011
@@ -507,11 +510,11 @@ namespace detail {
   
   template <typename Function, typename GradFunction, typename HessianFunction, 
             typename Vector, typename EqFunction, typename EqJacFunction, 
-            typename IneqFunction, typename IneqJacFunction>
+            typename IneqFunction, typename IneqJacFunction, typename QPSolver>
   void nl_intpoint_method_ls_impl(Function f, GradFunction df, HessianFunction fill_hessian,  
                                   EqFunction g, EqJacFunction fill_g_jac,
                                   IneqFunction h, IneqJacFunction fill_h_jac,
-                                  Vector& x, 
+                                  QPSolver solve_qp, Vector& x, 
                                   typename vect_traits<Vector>::value_type mu = typename vect_traits<Vector>::value_type(0.1), 
                                   unsigned int max_iter = 100,
                                   typename vect_traits<Vector>::value_type abs_tol = typename vect_traits<Vector>::value_type(1e-6), 
@@ -633,19 +636,20 @@ namespace detail {
     Vector lt = l;
     norm_star = norm_2(l);
     
-    mat<ValueType,mat_structure::diagonal> muSES_inv(K);
+    // the internal work matrices are drawn from the active memory arena (if any), see arena_scope.
+    typename arena_mat<ValueType,mat_structure::diagonal>::type muSES_inv(K);
     for(SizeType i = 0; i < K; ++i)
       muSES_inv(i,i) = mu / (z[i] * s[i]);
     
-    mat<ValueType,mat_structure::rectangular> ZJac_h(Jac_h);
-    mat<ValueType,mat_structure::rectangular> SJac_h(Jac_h);
+    typename arena_mat<ValueType,mat_structure::rectangular>::type ZJac_h(Jac_h);
+    typename arena_mat<ValueType,mat_structure::rectangular>::type SJac_h(Jac_h);
     for(SizeType i = 0; i < K; ++i)
       for(SizeType j = 0; j < N; ++j) {
         ZJac_h(i,j) *= z[i];
         SJac_h(i,j) /= s[i];
       };
     
-    mat<ValueType,mat_structure::symmetric> qp_G(H + transpose_view(SJac_h) * ZJac_h);
+    typename arena_mat<ValueType,mat_structure::symmetric>::type qp_G(H + transpose_view(SJac_h) * ZJac_h);
     
     Vector qp_c(x_grad);
     Vector c_h_s = c_h;
@@ -754,13 +758,7 @@ namespace detail {
         
         
         
-        try {
-          null_space_QP_method(Jac_g, -c_g, qp_G, qp_c, p_x, abs_tol, std::numeric_limits<ValueType>::infinity(), &p_y);
-        } catch(singularity_error&) {
-          try {
-            projected_CG_method(Jac_g, -c_g, qp_G, qp_c, p_x, max_iter, abs_tol_mu, &p_y);
-          } catch(maximum_iteration&) { };
-        };
+        solve_qp(Jac_g, -c_g, qp_G, qp_c, p_x, p_y, abs_tol, max_iter, abs_tol_mu);
         
 //         p_s = Jac_h * p_x + c_h - s;
         ValueType alpha_s_max(1.0);
@@ -812,7 +810,10 @@ namespace detail {
           nu *= 1.1;
         
 //         p_z = muSES_inv * vect_scalar<ValueType>(K,ValueType(1.0)) - c_h_s - SJac_h * p_x;
-        ValueType alpha_z((mu * ValueType(K) - s * z) / (s * p_z));
+        // without inequalities, the multipliers take a full step (the ratio below would be 0 / 0).
+        ValueType alpha_z(1.0);
+        if(K > 0)
+          alpha_z = (mu * ValueType(K) - s * z) / (s * p_z);
         for(SizeType i = 0; i < K; ++i) {
           if( alpha_z * p_z[i] < -tau )
             alpha_z = -tau / p_z[i];
@@ -1561,10 +1562,12 @@ nlip_quasi_newton_tr_factory<Function,GradFunction,T>
  * \tparam EqJacFunction The functor type of the equality constraints jacobian function.
  * \tparam IneqFunction The functor type of the inequality constraints function (vector function).
  * \tparam IneqJacFunction The functor type of the inequality constraints jacobian function.
+ * \tparam QPSolver A functor type that can solve the equality-constrained quadratic program of each step (see null_space_QP_solver or sparse_KKT_QP_solver).
  */
 template <typename Function, typename GradFunction, typename HessianFunction, typename T,
           typename EqFunction = no_constraint_functor, typename EqJacFunction = no_constraint_jac_functor, 
-          typename IneqFunction = no_constraint_functor, typename IneqJacFunction = no_constraint_jac_functor>
+          typename IneqFunction = no_constraint_functor, typename IneqJacFunction = no_constraint_jac_functor,
+          typename QPSolver = null_space_QP_solver>
 struct nlip_newton_ls_factory {
   Function f;
   GradFunction df;
@@ -1578,9 +1581,10 @@ struct nlip_newton_ls_factory {
   EqJacFunction fill_g_jac;
   IneqFunction h;
   IneqJacFunction fill_h_jac;
+  QPSolver solve_qp;
   
   typedef nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
-                                 EqFunction,EqJacFunction,IneqFunction,IneqJacFunction> self;
+                                 EqFunction,EqJacFunction,IneqFunction,IneqJacFunction,QPSolver> self;
   
   /**
    * Parametrized constructor of the factory object.
@@ -1596,17 +1600,20 @@ struct nlip_newton_ls_factory {
    * \param aTol The tolerance on the norm of the gradient (and thus the step size).
    * \param aEta The tolerance on the sufficient decrease in order to accept a line-search step.
    * \param aTau The portion (close to 1.0) of a total step to do without coming too close to the inequality constraint (barrier).
+   * \param aSolveQP The functor object that can solve the equality-constrained quadratic program of each step.
    */
   nlip_newton_ls_factory(Function aF, GradFunction aDf, HessianFunction aFillHessian, 
                          T aMu, unsigned int aMaxIter,
                          EqFunction aG = EqFunction(), EqJacFunction aFillGJac = EqJacFunction(),
                          IneqFunction aH = EqFunction(), IneqJacFunction aFillHJac = IneqJacFunction(),
-                         T aTol = T(1e-6), T aEta = T(1e-4), T aTau = T(0.995)) :
+                         T aTol = T(1e-6), T aEta = T(1e-4), T aTau = T(0.995),
+                         QPSolver aSolveQP = QPSolver()) :
                          f(aF), df(aDf), fill_hessian(aFillHessian),
                          mu(aMu), max_iter(aMaxIter), 
                          tol(aTol), eta(aEta), tau(aTau), 
                          g(aG), fill_g_jac(aFillGJac), 
-                         h(aH), fill_h_jac(aFillHJac) { };
+                         h(aH), fill_h_jac(aFillHJac),
+                         solve_qp(aSolveQP) { };
   /**
    * This function finds the minimum of a function, given its derivative and Hessian, 
    * using a newton search direction and using a trust-region approach.
@@ -1617,7 +1624,7 @@ struct nlip_newton_ls_factory {
   void operator()(Vector& x) const {
     detail::nl_intpoint_method_ls_impl(
       f, df, hessian_update_dual_exact<HessianFunction>(fill_hessian), 
-      g, fill_g_jac, h, fill_h_jac,
+      g, fill_g_jac, h, fill_h_jac, solve_qp,
       x, mu, max_iter, tol,eta,tau);
   };
   
@@ -1657,15 +1664,15 @@ struct nlip_newton_ls_factory {
   template <typename NewEqFunction, typename NewEqJacFunction>
   nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
                          NewEqFunction, NewEqJacFunction,
-                         IneqFunction, IneqJacFunction>
+                         IneqFunction, IneqJacFunction, QPSolver>
     set_eq_constraints(NewEqFunction new_g, NewEqJacFunction new_fill_g_jac) const {
     return nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
                                   NewEqFunction, NewEqJacFunction,
-                                  IneqFunction, IneqJacFunction>(f,df,fill_hessian,
-                                                                 mu, max_iter,
-                                                                 new_g, new_fill_g_jac, 
-                                                                 h, fill_h_jac, 
-                                                                 tol, eta, tau);
+                                  IneqFunction, IneqJacFunction, QPSolver>(f,df,fill_hessian,
+                                                                           mu, max_iter,
+                                                                           new_g, new_fill_g_jac, 
+                                                                           h, fill_h_jac, 
+                                                                           tol, eta, tau, solve_qp);
   };
     
   /**
@@ -1679,15 +1686,35 @@ struct nlip_newton_ls_factory {
   template <typename NewIneqFunction, typename NewIneqJacFunction>
   nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
                          EqFunction, EqJacFunction,
-                         NewIneqFunction, NewIneqJacFunction>
+                         NewIneqFunction, NewIneqJacFunction, QPSolver>
     set_ineq_constraints(NewIneqFunction new_h, NewIneqJacFunction new_fill_h_jac) const {
     return nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
                                   EqFunction, EqJacFunction,
-                                  NewIneqFunction, NewIneqJacFunction>(f,df,fill_hessian,
-                                                                       mu, max_iter,
-                                                                       g, fill_g_jac, 
-                                                                       new_h, new_fill_h_jac, 
-                                                                       tol, eta, tau);
+                                  NewIneqFunction, NewIneqJacFunction, QPSolver>(f,df,fill_hessian,
+                                                                                 mu, max_iter,
+                                                                                 g, fill_g_jac, 
+                                                                                 new_h, new_fill_h_jac, 
+                                                                                 tol, eta, tau, solve_qp);
+  };
+    
+  /**
+   * This function remaps the factory to one which will use the given solver for the equality-constrained 
+   * quadratic program of each step, e.g., sparse_KKT_QP_solver for large and sparse problems.
+   * \tparam NewQPSolver A functor type that can solve the equality-constrained quadratic program of each step.
+   * \param new_solve_qp The functor object that can solve the equality-constrained quadratic program of each step.
+   */
+  template <typename NewQPSolver>
+  nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
+                         EqFunction, EqJacFunction,
+                         IneqFunction, IneqJacFunction, NewQPSolver>
+    set_qp_solver(NewQPSolver new_solve_qp) const {
+    return nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T,
+                                  EqFunction, EqJacFunction,
+                                  IneqFunction, IneqJacFunction, NewQPSolver>(f,df,fill_hessian,
+                                                                              mu, max_iter,
+                                                                              g, fill_g_jac, 
+                                                                              h, fill_h_jac, 
+                                                                              tol, eta, tau, new_solve_qp);
   };
     
 };
@@ -1758,11 +1785,12 @@ nlip_newton_ls_factory<Function,GradFunction,HessianFunction,T>
  * \tparam HessianUpdater The functor type to update the Hessian approximation of the function to optimize.
  * \tparam TrustRegionSolver A functor type that can solve for a solution step within a trust-region (see trust_region_solver_dogleg for an example).
  * \tparam LimitFunction A functor type that can impose limits on a proposed solution step (see no_limit_functor or box_limit_function for examples).
+ * \tparam QPSolver A functor type that can solve the equality-constrained quadratic program of each step (see null_space_QP_solver or sparse_KKT_QP_solver).
  */
 template <typename Function, typename GradFunction, typename T,
           typename EqFunction = no_constraint_functor, typename EqJacFunction = no_constraint_jac_functor, 
           typename IneqFunction = no_constraint_functor, typename IneqJacFunction = no_constraint_jac_functor, 
-          typename HessianUpdater = hessian_update_bfgs>
+          typename HessianUpdater = hessian_update_bfgs, typename QPSolver = null_space_QP_solver>
 struct nlip_quasi_newton_ls_factory {
   Function f;
   GradFunction df;
@@ -1776,11 +1804,12 @@ struct nlip_quasi_newton_ls_factory {
   IneqFunction h;
   IneqJacFunction fill_h_jac;
   HessianUpdater update_hessian;
+  QPSolver solve_qp;
   
   typedef nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                        EqFunction,EqJacFunction,
                                        IneqFunction,IneqJacFunction,
-                                       HessianUpdater> self;
+                                       HessianUpdater,QPSolver> self;
   
   /**
    * Parametrized constructor of the factory object.
@@ -1794,19 +1823,22 @@ struct nlip_quasi_newton_ls_factory {
    * \param aEta The tolerance on the sufficient decrease in order to accept a line-search step.
    * \param aTau The portion (close to 1.0) of a total step to do without coming too close to the inequality constraint (barrier).
    * \param aUpdateHessian The functor object that can update the approximate Hessian matrix of the function to be optimized. 
+   * \param aSolveQP The functor object that can solve the equality-constrained quadratic program of each step.
    */
   nlip_quasi_newton_ls_factory(Function aF, GradFunction aDf,
                                T aMu, unsigned int aMaxIter,
                                EqFunction aG = EqFunction(), EqJacFunction aFillGJac = EqJacFunction(),
                                IneqFunction aH = IneqFunction(), IneqJacFunction aFillHJac = IneqJacFunction(),
                                T aTol = T(1e-6), T aEta = T(1e-4), T aTau = T(0.995),
-                               HessianUpdater aUpdateHessian = HessianUpdater()) :
+                               HessianUpdater aUpdateHessian = HessianUpdater(),
+                               QPSolver aSolveQP = QPSolver()) :
                                f(aF), df(aDf), 
                                mu(aMu), max_iter(aMaxIter), 
                                tol(aTol), eta(aEta), tau(aTau),
                                g(aG), fill_g_jac(aFillGJac), 
                                h(aH), fill_h_jac(aFillHJac), 
-                               update_hessian(aUpdateHessian) { };
+                               update_hessian(aUpdateHessian),
+                               solve_qp(aSolveQP) { };
   /**
    * This function finds the minimum of a function, given its derivative and Hessian, 
    * using a newton search direction and using a trust-region approach.
@@ -1816,7 +1848,7 @@ struct nlip_quasi_newton_ls_factory {
   template <typename Vector>
   void operator()(Vector& x) const {
     detail::nl_intpoint_method_ls_impl(
-      f, df, hessian_update_dual_quasi<HessianUpdater>(update_hessian), g, fill_g_jac, h, fill_h_jac, 
+      f, df, hessian_update_dual_quasi<HessianUpdater>(update_hessian), g, fill_g_jac, h, fill_h_jac, solve_qp,
       x, mu, max_iter, tol,eta,tau);
   };
   
@@ -1857,15 +1889,15 @@ struct nlip_quasi_newton_ls_factory {
   nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                NewEqFunction,NewEqJacFunction,
                                IneqFunction, IneqJacFunction, 
-                               HessianUpdater>
+                               HessianUpdater, QPSolver>
     set_eq_constraints(NewEqFunction new_g, NewEqJacFunction new_fill_g_jac) const {
     return nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                         NewEqFunction, NewEqJacFunction,
                                         IneqFunction, IneqJacFunction, 
-                                        HessianUpdater>(f, df, mu, max_iter,
-                                                        new_g, new_fill_g_jac, 
-                                                        h, fill_h_jac,
-                                                        tol, eta, tau, update_hessian);
+                                        HessianUpdater, QPSolver>(f, df, mu, max_iter,
+                                                                  new_g, new_fill_g_jac, 
+                                                                  h, fill_h_jac,
+                                                                  tol, eta, tau, update_hessian, solve_qp);
   };
     
   /**
@@ -1880,15 +1912,15 @@ struct nlip_quasi_newton_ls_factory {
   nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                EqFunction,EqJacFunction,
                                NewIneqFunction, NewIneqJacFunction, 
-                               HessianUpdater>
+                               HessianUpdater, QPSolver>
     set_ineq_constraints(NewIneqFunction new_h, NewIneqJacFunction new_fill_h_jac) const {
     return nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                         EqFunction, EqJacFunction,
                                         NewIneqFunction, NewIneqJacFunction, 
-                                        HessianUpdater>(f, df, mu, max_iter,
-                                                        g, fill_g_jac, 
-                                                        new_h, new_fill_h_jac,
-                                                        tol, eta, tau, update_hessian);
+                                        HessianUpdater, QPSolver>(f, df, mu, max_iter,
+                                                                  g, fill_g_jac, 
+                                                                  new_h, new_fill_h_jac,
+                                                                  tol, eta, tau, update_hessian, solve_qp);
   };
     
   /**
@@ -1900,16 +1932,38 @@ struct nlip_quasi_newton_ls_factory {
   nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                EqFunction, EqJacFunction, 
                                IneqFunction, IneqJacFunction, 
-                               NewHessianUpdater>
+                               NewHessianUpdater, QPSolver>
     set_hessian_updater(NewHessianUpdater new_update_hessian) const {
     return nlip_quasi_newton_ls_factory<Function,GradFunction,T,
                                         EqFunction, EqJacFunction, 
                                         IneqFunction, IneqJacFunction, 
-                                        NewHessianUpdater>(f, df, mu, max_iter,
-                                                           g, fill_g_jac, 
-                                                           h, fill_h_jac,
-                                                           tol, eta, tau, 
-                                                           new_update_hessian);
+                                        NewHessianUpdater, QPSolver>(f, df, mu, max_iter,
+                                                                     g, fill_g_jac, 
+                                                                     h, fill_h_jac,
+                                                                     tol, eta, tau, 
+                                                                     new_update_hessian, solve_qp);
+  };
+    
+  /**
+   * This function remaps the factory to one which will use the given solver for the equality-constrained 
+   * quadratic program of each step, e.g., sparse_KKT_QP_solver for large and sparse problems.
+   * \tparam NewQPSolver A functor type that can solve the equality-constrained quadratic program of each step.
+   * \param new_solve_qp The functor object that can solve the equality-constrained quadratic program of each step.
+   */
+  template <typename NewQPSolver>
+  nlip_quasi_newton_ls_factory<Function,GradFunction,T,
+                               EqFunction, EqJacFunction, 
+                               IneqFunction, IneqJacFunction, 
+                               HessianUpdater, NewQPSolver>
+    set_qp_solver(NewQPSolver new_solve_qp) const {
+    return nlip_quasi_newton_ls_factory<Function,GradFunction,T,
+                                        EqFunction, EqJacFunction, 
+                                        IneqFunction, IneqJacFunction, 
+                                        HessianUpdater, NewQPSolver>(f, df, mu, max_iter,
+                                                                     g, fill_g_jac, 
+                                                                     h, fill_h_jac,
+                                                                     tol, eta, tau, 
+                                                                     update_hessian, new_solve_qp);
   };
     
 };
@@ -36,6 +36,7 @@
 #include <ReaK/core/base/defs.hpp>
 #include <ReaK/core/lin_alg/mat_alg.hpp>
 #include <ReaK/core/lin_alg/mat_qr_decomp.hpp>
+#include <ReaK/core/lin_alg/mat_sparse_cholesky.hpp>
 #include <ReaK/core/lin_alg/mat_views.hpp>
 
 #include "optim_exceptions.hpp"
@@ -87,15 +88,18 @@ void null_space_QP_method(const Matrix1& A, const Vector1& b,
   SizeType N = c.size();
   SizeType M = b.size();
   
-  mat<ValueType,mat_structure::rectangular> A_tmp(transpose_view(A));
-  mat<ValueType,mat_structure::rectangular> R(N,M);
-  mat<ValueType,mat_structure::square> Q(N);
+  typedef typename arena_mat<ValueType,mat_structure::rectangular>::type WorkMatrix;
+  typedef typename arena_mat<ValueType,mat_structure::square>::type WorkSqMatrix;
+  
+  WorkMatrix A_tmp(transpose_view(A));
+  WorkMatrix R(N,M);
+  WorkSqMatrix Q(N);
   decompose_QR(A_tmp,Q,R,abs_tol);
-  mat<ValueType,mat_structure::rectangular> L = mat<ValueType,mat_structure::rectangular>(transpose_view(R));
+  WorkMatrix L(transpose_view(R));
   L.set_col_count(M,true);
   
-  mat_const_sub_block< mat<ValueType,mat_structure::square> > Y(Q, N, M, 0, 0);
-  mat_const_sub_block< mat<ValueType,mat_structure::square> > Z(Q, N, N - M, 0, M);
+  mat_const_sub_block< WorkSqMatrix > Y(Q, N, M, 0, 0);
+  mat_const_sub_block< WorkSqMatrix > Z(Q, N, N - M, 0, M);
   //RK_NOTICE(2," Found the null-space basis to be Z = " << Z);
   
   Vector2 x_tmp(x);
@@ -113,13 +117,13 @@ void null_space_QP_method(const Matrix1& A, const Vector1& b,
   
   //solve for p_z:
   mat_vect_adaptor< Vector2 > p_z(x_tmp,N - M,1,M);
-  mat<ValueType,mat_structure::rectangular> GY_py = G * Y * p_y;
+  WorkMatrix GY_py(G * Y * p_y);
   for(SizeType i = 0; i < N-M; ++i) {
     p_z(i,0) = ValueType(0.0);
     for(SizeType j = 0; j < N; ++j)
       p_z(i,0) -= Z(j,i) * (c[j] + GY_py(j,0));
   };
-  mat<ValueType, mat_structure::symmetric> ZGZ = mat<ValueType, mat_structure::symmetric>(transpose_view(Z) * G * Z);
+  typename arena_mat<ValueType, mat_structure::symmetric>::type ZGZ(transpose_view(Z) * G * Z);
 
   try {
     linsolve_Cholesky(ZGZ, p_z, abs_tol);
@@ -370,6 +374,256 @@ void projected_CG_method(const Matrix1& A, const Vector1& b,
 
 
 
+namespace detail {
+
+/* Collects the (row, column, value) triplets of the entries of a KKT matrix block. */
+template <typename T>
+struct KKT_triplet_collector {
+  std::vector<std::size_t> rows;
+  std::vector<std::size_t> cols;
+  std::vector<T> values;
+
+  void add(std::size_t i, std::size_t j, T value) {
+    rows.push_back(i);
+    cols.push_back(j);
+    values.push_back(value);
+  };
+
+  /* Adds the non-zero entries of M, offset by the given row and column, and, if aMirror is true,
+   * also the transposed entries (for the symmetric counter-part of an off-diagonal block). */
+  template <typename Matrix>
+  typename boost::enable_if_c< (mat_traits<Matrix>::structure != mat_structure::sparse),
+  void >::type add_block(const Matrix& M, std::size_t aRowOffset, std::size_t aColOffset, bool aMirror) {
+    for(std::size_t j = 0; j < M.get_col_count(); ++j)
+      for(std::size_t i = 0; i < M.get_row_count(); ++i) {
+        T value = M(i,j);
+        if(value == T(0))
+          continue;
+        add(aRowOffset + i, aColOffset + j, value);
+        if(aMirror)
+          add(aColOffset + j, aRowOffset + i, value);
+      };
+  };
+
+  struct sparse_block_adder {
+    KKT_triplet_collector<T>* p_parent;
+    const std::vector<T>* p_values;
+    std::size_t row_offset;
+    std::size_t col_offset;
+    bool mirror;
+    void operator()(std::size_t i, std::size_t j, std::size_t p) {
+      p_parent->add(row_offset + i, col_offset + j, (*p_values)[p]);
+      if(mirror)
+        p_parent->add(col_offset + j, row_offset + i, (*p_values)[p]);
+    };
+  };
+
+  template <typename Matrix>
+  typename boost::enable_if_c< (mat_traits<Matrix>::structure == mat_structure::sparse),
+  void >::type add_block(const Matrix& M, std::size_t aRowOffset, std::size_t aColOffset, bool aMirror) {
+    std::vector<T> vals(M.get_values().begin(), M.get_values().end());
+    sparse_block_adder adder;
+    adder.p_parent = this;
+    adder.p_values = &vals;
+    adder.row_offset = aRowOffset;
+    adder.col_offset = aColOffset;
+    adder.mirror = aMirror;
+    ReaK::detail::for_each_sparse_entry(M, adder);
+  };
+};
+
+};
+
+
+/**
+ * This function is an implementation of the sparse KKT (or augmented system) direct method for
+ * solving a quadratic optimization problem with equality constraints. It solves the following problem: \n
+ * \n
+ *           min c'x + 0.5 * x' G x \n
+ *               Ax = b \n
+ * \n
+ * by assembling the KKT matrix [G A'; A 0] in sparse storage, regularizing it (by +delta on the
+ * diagonal of G and -delta on the diagonal of the zero block, with delta = max(abs_tol, sqrt(eps) * max|K_ij|)) 
+ * such that it is quasi-definite, and solving it with a fill-reducing sparse LDL^T decomposition followed by 
+ * a few steps of iterative refinement against the unregularized KKT matrix. The cost of the decomposition is 
+ * thus governed by the number of non-zero entries of A, G and of the factor, instead of the cube of the 
+ * number of variables, which makes this method suitable for large and sparse problems (e.g., trajectory 
+ * optimization). If A or G are sparse matrices (see mat_alg_sparse.hpp), their entries are gathered directly, 
+ * in O(nnz). Otherwise, their non-zero entries are gathered by scanning them, i.e., the assembly then costs 
+ * O(N * (N + M)) regardless of their sparsity.
+ * The implementation was inspired from the augmented system approach described in the book:\n
+ *   Nocedal, Numerical Optimization, 2nd Ed..
+ *
+ * \tparam Matrix1 A readable matrix type.
+ * \tparam Vector1 A vector type, should model the WritableVectorConcept.
+ * \tparam Matrix2 A readable matrix type.
+ * \tparam Vector2 A vector type, should model the WritableVectorConcept.
+ * \param A The constraint matrix of dimension M*N.
+ * \param b The b vector of dimension M.
+ * \param G The G matrix of dimension NxN (defines the quadratic function to minimize, should be positive semi-definite).
+ * \param c The cost vector of dimension N.
+ * \param x Stores, as output, the optimal vector.
+ * \param abs_tol The tolerance on the singularity of components of the matrices involved (also the least regularization).
+ * \param max_norm The maximum norm of the solution vector x (it is scaled down if it exceeds it).
+ * \param lambda Stores, as output, the Lagrange multipliers (such that A' lambda = c + G x), if not NULL.
+ *
+ * \throws singularity_error if the KKT matrix is singular.
+ *
+ * \author Mikael Persson
+ */
+template <typename Matrix1, typename Vector1, typename Matrix2, typename Vector2>
+void sparse_KKT_QP_method(const Matrix1& A, const Vector1& b,
+                          const Matrix2&  G, const Vector2& c, Vector2& x,
+                          typename vect_traits<Vector1>::value_type abs_tol = std::numeric_limits<typename vect_traits<Vector1>::value_type>::epsilon(),
+                          typename vect_traits<Vector1>::value_type max_norm = std::numeric_limits<typename vect_traits<Vector1>::value_type>::infinity(),
+                          Vector1* lambda = NULL) {
+  typedef typename vect_traits<Vector1>::value_type ValueType;
+  typedef typename vect_traits<Vector1>::size_type SizeType;
+  using std::sqrt;
+
+  SizeType N = c.size();
+  SizeType M = b.size();
+  if((A.get_row_count() != M) || (A.get_col_count() != N) ||
+     (G.get_row_count() != N) || (G.get_col_count() != N))
+    throw std::range_error("Matrix dimension mismatch.");
+
+  using std::fabs;
+
+  detail::KKT_triplet_collector<ValueType> trip;
+  trip.add_block(G, 0, 0, false);
+  trip.add_block(A, N, 0, true);
+  
+  // the regularization is scaled to the magnitude of the KKT matrix, because the fill-reducing ordering 
+  // can eliminate a constraint before its variables, which makes a pivot of the size of the regularization.
+  ValueType K_max(0.0);
+  for(std::size_t k = 0; k < trip.values.size(); ++k)
+    if(fabs(trip.values[k]) > K_max)
+      K_max = fabs(trip.values[k]);
+  ValueType reg = sqrt(std::numeric_limits<ValueType>::epsilon()) * K_max;
+  if(reg < abs_tol)
+    reg = abs_tol;
+  
+  std::size_t reg_start = trip.values.size();
+  for(SizeType i = 0; i < N; ++i)
+    trip.add(i, i, reg);
+  for(SizeType i = 0; i < M; ++i)
+    trip.add(N + i, N + i, -reg);
+  mat<ValueType,mat_structure::sparse> K(N + M, N + M, trip.rows, trip.cols, trip.values);
+  for(std::size_t k = reg_start; k < trip.values.size(); ++k)
+    trip.values[k] = ValueType(0);
+  mat<ValueType,mat_structure::sparse> K0(N + M, N + M, trip.rows, trip.cols, trip.values);
+
+  sparse_LDL<ValueType> LDL(K, abs_tol * reg);
+
+  vect_n<ValueType> rhs(N + M);
+  for(SizeType i = 0; i < N; ++i)
+    rhs[i] = -c[i];
+  for(SizeType i = 0; i < M; ++i)
+    rhs[N + i] = b[i];
+  vect_n<ValueType> z = rhs;
+  LDL.solve(z);
+
+  // iterative refinement towards the solution of the unregularized KKT system.
+  ValueType rhs_norm = norm_2(rhs);
+  for(unsigned int k = 0; k < 3; ++k) {
+    vect_n<ValueType> r = rhs - K0 * z;
+    if(norm_2(r) <= std::numeric_limits<ValueType>::epsilon() * (rhs_norm + ValueType(1.0)))
+      break;
+    LDL.solve(r);
+    z += r;
+  };
+
+  ValueType x_norm(0.0);
+  for(SizeType i = 0; i < N; ++i)
+    x_norm += z[i] * z[i];
+  x_norm = sqrt(x_norm);
+  ValueType x_scale(1.0);
+  if(x_norm > max_norm)
+    x_scale = max_norm / x_norm;
+  x = c;
+  for(SizeType i = 0; i < N; ++i)
+    x[i] = x_scale * z[i];
+
+  if(lambda) {
+    (*lambda) = b;
+    for(SizeType i = 0; i < M; ++i)
+      (*lambda)[i] = -z[N + i];
+  };
+
+};
+
+
+
+/**
+ * This functor solves the equality-constrained quadratic program of a step of an SQP-type method
+ * (e.g., the interior-point methods) with the null-space method (see null_space_QP_method), and
+ * falls back to the projected CG method (see projected_CG_method) if the reduced Hessian is singular.
+ * This is suitable for small and dense problems.
+ */
+struct null_space_QP_solver {
+  /**
+   * This function solves the equality-constrained quadratic program: min c'x + 0.5 * x' G x, s.t. Ax = b.
+   * \param A The constraint matrix of dimension M*N.
+   * \param b The b vector of dimension M.
+   * \param G The G matrix of dimension NxN.
+   * \param c The cost vector of dimension N.
+   * \param x Stores, as output, the optimal vector.
+   * \param lambda Stores, as output, the Lagrange multipliers (such that A' lambda = c + G x).
+   * \param abs_tol The tolerance on the singularity of components of the matrices involved.
+   * \param max_iter The maximum number of iterations of the fall-back iterative method.
+   * \param iter_tol The tolerance on the residual of the fall-back iterative method.
+   */
+  template <typename Matrix1, typename Vector1, typename Matrix2, typename Vector2>
+  void operator()(const Matrix1& A, const Vector1& b, const Matrix2& G, const Vector2& c, Vector2& x, Vector1& lambda,
+                  typename vect_traits<Vector1>::value_type abs_tol, unsigned int max_iter,
+                  typename vect_traits<Vector1>::value_type iter_tol) const {
+    try {
+      null_space_QP_method(A, b, G, c, x, abs_tol, std::numeric_limits<typename vect_traits<Vector1>::value_type>::infinity(), &lambda);
+    } catch(singularity_error&) {
+      try {
+        projected_CG_method(A, b, G, c, x, max_iter, iter_tol, &lambda);
+      } catch(maximum_iteration&) { };
+    };
+  };
+};
+
+/**
+ * This functor solves the equality-constrained quadratic program of a step of an SQP-type method
+ * (e.g., the interior-point methods) with the sparse KKT method (see sparse_KKT_QP_method), and
+ * falls back to the projected CG method (see projected_CG_method) if the KKT matrix is singular.
+ * This is suitable for large and sparse problems. Note that the interior-point methods give their 
+ * Hessian and constraint Jacobian as dense matrices, which are scanned to assemble the KKT matrix, 
+ * so that the assembly costs O(N * (N + M)) (the decomposition remains governed by the sparsity).
+ */
+struct sparse_KKT_QP_solver {
+  /**
+   * This function solves the equality-constrained quadratic program: min c'x + 0.5 * x' G x, s.t. Ax = b.
+   * \param A The constraint matrix of dimension M*N.
+   * \param b The b vector of dimension M.
+   * \param G The G matrix of dimension NxN.
+   * \param c The cost vector of dimension N.
+   * \param x Stores, as output, the optimal vector.
+   * \param lambda Stores, as output, the Lagrange multipliers (such that A' lambda = c + G x).
+   * \param abs_tol The tolerance on the singularity of components of the matrices involved.
+   * \param max_iter The maximum number of iterations of the fall-back iterative method.
+   * \param iter_tol The tolerance on the residual of the fall-back iterative method.
+   */
+  template <typename Matrix1, typename Vector1, typename Matrix2, typename Vector2>
+  void operator()(const Matrix1& A, const Vector1& b, const Matrix2& G, const Vector2& c, Vector2& x, Vector1& lambda,
+                  typename vect_traits<Vector1>::value_type abs_tol, unsigned int max_iter,
+                  typename vect_traits<Vector1>::value_type iter_tol) const {
+    try {
+      sparse_KKT_QP_method(A, b, G, c, x, abs_tol, std::numeric_limits<typename vect_traits<Vector1>::value_type>::infinity(), &lambda);
+    } catch(singularity_error&) {
+      try {
+        projected_CG_method(A, b, G, c, x, max_iter, iter_tol, &lambda);
+      } catch(maximum_iteration&) { };
+    };
+  };
+};
+
+
+
 
 
 
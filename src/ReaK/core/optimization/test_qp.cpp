@@ -88,6 +88,18 @@ int main() {
                 << "    and with xGx + cx = " << (0.5 * (x * Gs[i]) * x + cs[i] * x) << " so A(Gx + c) = " << (As[i] * (Gs[i] * x + cs[i])) << std::endl;
     };
     
+    x = xs[i];
+    try {
+      optim::sparse_KKT_QP_method(As[i],bs[i],Gs[i],cs[i],x,1e-8);
+      std::cout << "  Sparse KKT QP method gives:\n"
+                << "    x = " << x << " with |Ax - b| = " << norm_2(As[i] * x - bs[i]) << "\n"
+                << "    and with xGx + cx = " << (0.5 * (x * Gs[i]) * x + cs[i] * x) << " so A(Gx + c) = " << (As[i] * (Gs[i] * x + cs[i])) << std::endl;
+    } catch(std::exception& e) {
+      std::cout << "  Sparse KKT QP method failed with error: " << e.what() << std::endl
+                << "    x = " << x << " with |Ax - b| = " << norm_2(As[i] * x - bs[i]) << "\n"
+                << "    and with xGx + cx = " << (0.5 * (x * Gs[i]) * x + cs[i] * x) << " so A(Gx + c) = " << (As[i] * (Gs[i] * x + cs[i])) << std::endl;
+    };
+
     x = xs[i];
     try {
       optim::projected_CG_method(As[i],bs[i],Gs[i],cs[i],x,100,1e-8);
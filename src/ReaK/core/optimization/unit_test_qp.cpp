@@ -0,0 +1,199 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <ReaK/core/optimization/quadratic_programs.hpp>
+#include <ReaK/core/optimization/nl_interior_points_methods.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE quadratic_programs
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+
+static const std::size_t test_N = 12;
+static const std::size_t test_M = 4;
+
+/* A sparse (banded) positive-definite Hessian. */
+mat<double,mat_structure::symmetric> get_test_G() {
+  mat<double,mat_structure::symmetric> G(mat<double,mat_structure::nil>(test_N,test_N));
+  for(std::size_t i = 0; i < test_N; ++i) {
+    G(i,i) = 4.0 + 0.1 * i;
+    if(i + 1 < test_N)
+      G(i,i+1) = -1.0;
+  };
+  return G;
+};
+
+/* A sparse full-rank constraint matrix. */
+mat<double,mat_structure::rectangular> get_test_A() {
+  mat<double,mat_structure::rectangular> A(test_M,test_N,0.0);
+  for(std::size_t i = 0; i < test_M; ++i) {
+    A(i,3*i) = 1.0;
+    A(i,3*i+1) = -2.0;
+    A(i,(3*i+5) % test_N) = 0.5;
+  };
+  return A;
+};
+
+vect_n<double> get_test_b() {
+  vect_n<double> b(test_M);
+  for(std::size_t i = 0; i < test_M; ++i)
+    b[i] = 1.0 - 0.5 * i;
+  return b;
+};
+
+vect_n<double> get_test_c() {
+  vect_n<double> c(test_N);
+  for(std::size_t i = 0; i < test_N; ++i)
+    c[i] = std::sin(double(i)) - 0.5;
+  return c;
+};
+
+
+/* The non-linear program: min 0.5 x'Gx + c'x + sum(x_i^4) / 12, s.t. Ax = b. */
+double nlp_f(const vect_n<double>& x) {
+  double result = 0.5 * (x * (get_test_G() * x)) + get_test_c() * x;
+  for(std::size_t i = 0; i < x.size(); ++i)
+    result += x[i] * x[i] * x[i] * x[i] / 12.0;
+  return result;
+};
+
+vect_n<double> nlp_grad(const vect_n<double>& x) {
+  vect_n<double> result = get_test_G() * x + get_test_c();
+  for(std::size_t i = 0; i < x.size(); ++i)
+    result[i] += x[i] * x[i] * x[i] / 3.0;
+  return result;
+};
+
+void nlp_H(mat<double,mat_structure::symmetric>& H, const vect_n<double>& x, double, const vect_n<double>&) {
+  H = get_test_G();
+  for(std::size_t i = 0; i < x.size(); ++i)
+    H(i,i) += x[i] * x[i];
+};
+
+vect_n<double> nlp_g(const vect_n<double>& x) {
+  return get_test_A() * x - get_test_b();
+};
+
+void nlp_g_jac(mat<double,mat_structure::rectangular>& J, const vect_n<double>&, const vect_n<double>&) {
+  J = get_test_A();
+};
+
+
+BOOST_AUTO_TEST_CASE( sparse_KKT_QP_method_test )
+{
+  mat<double,mat_structure::symmetric> G = get_test_G();
+  mat<double,mat_structure::rectangular> A = get_test_A();
+  vect_n<double> b = get_test_b();
+  vect_n<double> c = get_test_c();
+  
+  vect_n<double> x_ns(test_N, 0.0), x_kkt(test_N, 0.0);
+  vect_n<double> l_ns(test_M, 0.0), l_kkt(test_M, 0.0);
+  BOOST_CHECK_NO_THROW( optim::null_space_QP_method(A, b, G, c, x_ns, 1e-8, std::numeric_limits<double>::infinity(), &l_ns) );
+  BOOST_CHECK_NO_THROW( optim::sparse_KKT_QP_method(A, b, G, c, x_kkt, 1e-8, std::numeric_limits<double>::infinity(), &l_kkt) );
+  
+  BOOST_CHECK( norm_2(A * x_kkt - b) < 1e-10 );
+  BOOST_CHECK( norm_2(x_kkt - x_ns) < 1e-8 );
+  BOOST_CHECK( norm_2(l_kkt - l_ns) < 1e-8 );
+  BOOST_CHECK( norm_2(G * x_kkt + c - transpose_view(A) * l_kkt) < 1e-8 );
+  
+  // the solver functors used by the interior-point methods must agree as well:
+  vect_n<double> x_ns2(test_N, 0.0), x_kkt2(test_N, 0.0);
+  vect_n<double> l_ns2(test_M, 0.0), l_kkt2(test_M, 0.0);
+  optim::null_space_QP_solver()(A, b, G, c, x_ns2, l_ns2, 1e-8, 100, 1e-8);
+  optim::sparse_KKT_QP_solver()(A, b, G, c, x_kkt2, l_kkt2, 1e-8, 100, 1e-8);
+  BOOST_CHECK( norm_2(x_kkt2 - x_ns2) < 1e-8 );
+  BOOST_CHECK( norm_2(l_kkt2 - l_ns2) < 1e-8 );
+};
+
+
+BOOST_AUTO_TEST_CASE( sparse_KKT_QP_method_ordering_test )
+{
+  // constraints with fewer entries than their variables have neighbors are eliminated first by the minimum-degree 
+  // ordering (before their primal variables), and the default tolerance is the machine epsilon, 
+  // so the regularization must be scaled to the magnitude of the KKT matrix to keep the pivots sound.
+  mat<double,mat_structure::symmetric> G = get_test_G();
+  for(std::size_t i = 0; i + 2 < test_N; ++i) {
+    G(i,i+2) = -0.5;
+    if(i + 3 < test_N)
+      G(i,i+3) = 0.25;
+  };
+  mat<double,mat_structure::rectangular> A(test_M,test_N,0.0);
+  vect_n<double> b(test_M);
+  for(std::size_t i = 0; i < test_M; ++i) {
+    A(i,3*i) = 1.0;
+    A(i,3*i+1) = -2.0 - i;
+    b[i] = 0.5 - 0.25 * i;
+  };
+  vect_n<double> c = get_test_c();
+  
+  vect_n<double> x_ns(test_N, 0.0), x_kkt(test_N, 0.0);
+  vect_n<double> l_ns(test_M, 0.0), l_kkt(test_M, 0.0);
+  BOOST_CHECK_NO_THROW( optim::null_space_QP_method(A, b, G, c, x_ns, 1e-8, std::numeric_limits<double>::infinity(), &l_ns) );
+  BOOST_CHECK_NO_THROW( optim::sparse_KKT_QP_method(A, b, G, c, x_kkt) );
+  BOOST_CHECK_NO_THROW( optim::sparse_KKT_QP_method(A, b, G, c, x_kkt, std::numeric_limits<double>::epsilon(), 
+                                                    std::numeric_limits<double>::infinity(), &l_kkt) );
+  
+  BOOST_CHECK( norm_2(A * x_kkt - b) < 1e-10 );
+  BOOST_CHECK( norm_2(x_kkt - x_ns) < 1e-8 );
+  BOOST_CHECK( norm_2(l_kkt - l_ns) < 1e-8 );
+  
+  // the same, with the matrices given in sparse storage (gathered without scanning):
+  mat<double,mat_structure::sparse> G_sp(G), A_sp(A);
+  vect_n<double> x_sp(test_N, 0.0), l_sp(test_M, 0.0);
+  BOOST_CHECK_NO_THROW( optim::sparse_KKT_QP_method(A_sp, b, G_sp, c, x_sp, std::numeric_limits<double>::epsilon(), 
+                                                    std::numeric_limits<double>::infinity(), &l_sp) );
+  BOOST_CHECK( norm_2(x_sp - x_ns) < 1e-8 );
+  BOOST_CHECK( norm_2(l_sp - l_ns) < 1e-8 );
+};
+
+
+BOOST_AUTO_TEST_CASE( nlip_sparse_KKT_solver_test )
+{
+  vect_n<double> x_ns(test_N, 0.0), x_kkt(test_N, 0.0);
+  
+  BOOST_CHECK_NO_THROW( optim::make_nlip_newton_ls(nlp_f, nlp_grad, nlp_H, 1.0, 200, 1e-8)
+                          .set_eq_constraints(nlp_g, nlp_g_jac)(x_ns) );
+  BOOST_CHECK_NO_THROW( optim::make_nlip_newton_ls(nlp_f, nlp_grad, nlp_H, 1.0, 200, 1e-8)
+                          .set_eq_constraints(nlp_g, nlp_g_jac)
+                          .set_qp_solver(optim::sparse_KKT_QP_solver())(x_kkt) );
+  
+  BOOST_CHECK( norm_2(nlp_g(x_kkt)) < 1e-6 );
+  BOOST_CHECK( norm_2(x_kkt - x_ns) < 1e-6 );
+  
+  // the solution must be stationary on the constraint manifold, i.e., the gradient 
+  // must lie in the range of A':
+  mat<double,mat_structure::rectangular> A = get_test_A();
+  vect_n<double> grad = nlp_grad(x_kkt);
+  vect_n<double> x_proj(test_N, 0.0), l_proj(test_M, 0.0);
+  optim::null_space_QP_method(A, vect_n<double>(test_M, 0.0), mat<double,mat_structure::identity>(test_N), 
+                              -grad, x_proj, 1e-8, std::numeric_limits<double>::infinity(), &l_proj);
+  BOOST_CHECK( norm_2(x_proj) < 1e-5 );
+};
+
+
@@ -42,6 +42,7 @@
 #include <ReaK/core/lin_alg/vect_concepts.hpp>
 #include <ReaK/core/lin_alg/mat_alg.hpp>
 #include <ReaK/core/lin_alg/mat_cholesky.hpp>
+#include <ReaK/core/lin_alg/mat_expression_templates.hpp>
 
 #include <ReaK/ctrl/topologies/metric_space_concept.hpp>
 
@@ -100,6 +101,7 @@ void >::type kalman_predict(const LinearSystem& sys,
   
   typedef typename pp::topology_traits<StateSpaceType>::point_type StateType;
   typedef typename continuous_belief_state_traits<BeliefState>::covariance_type CovType;
+  typedef typename covariance_mat_traits< CovType >::matrix_type MatType;
   
   typename discrete_linear_sss_traits<LinearSystem>::matrixA_type A;
   typename discrete_linear_sss_traits<LinearSystem>::matrixB_type B;
@@ -107,7 +109,10 @@ void >::type kalman_predict(const LinearSystem& sys,
   
   b_x.set_mean_state( sys.get_next_state(state_space, x, b_u.get_mean_state(), t) );
   sys.get_state_transition_blocks(A, B, state_space, t, t + sys.get_time_step(), x, b_x.get_mean_state(), b_u.get_mean_state(), b_u.get_mean_state());
-  b_x.set_covariance( CovType( ( A * b_x.get_covariance().get_matrix() * transpose_view(A) ) + B * b_u.get_covariance().get_matrix() * transpose_view(B) ) );
+  // the sandwich products are fused into a single pass over (half of) the new covariance matrix.
+  MatType P;
+  evaluate_into(sandwich_product(A, b_x.get_covariance().get_matrix()) + sandwich_product(B, b_u.get_covariance().get_matrix()), P);
+  b_x.set_covariance( CovType( P ) );
 };
 
 
@@ -169,20 +174,27 @@ void >::type kalman_update(const LinearSystem& sys,
   sys.get_output_function_blocks(C, D, state_space, t, x, b_u.get_mean_state());
   
   vect_n<ValueType> y = to_vect<ValueType>(b_z.get_mean_state() - sys.get_output(state_space, x, b_u.get_mean_state(), t));
-  mat< ValueType, mat_structure::rectangular, mat_alignment::column_major > CP = C * P;
-  mat< ValueType, mat_structure::symmetric > S( CP * transpose_view(C) + b_z.get_covariance().get_matrix() );
+  // the gain computations are done in work matrices drawn from the active memory arena (if any).
+  typename arena_mat< ValueType, mat_structure::rectangular, mat_alignment::column_major >::type CP;
+  evaluate_into(lazy_expr(C) * lazy_expr(P), CP);
+  typename arena_mat< ValueType, mat_structure::symmetric >::type S;
+  evaluate_into(lazy_expr(CP) * transpose(lazy_expr(C)) + lazy_expr(b_z.get_covariance().get_matrix()), S);
   linsolve_Cholesky(S,CP);
-  mat< ValueType, mat_structure::rectangular, mat_alignment::row_major > K( transpose_view(CP) );
+  typename arena_mat< ValueType, mat_structure::rectangular, mat_alignment::row_major >::type K( transpose_view(CP) );
    
   b_x.set_mean_state( state_space.adjust(x, from_vect<StateDiffType>(K * y) ) );
-  b_x.set_covariance( CovType( MatType( (mat< ValueType, mat_structure::identity>(K.get_row_count()) - K * C) * P ) ) );
+  MatType P_post;
+  evaluate_into(lazy_expr(P) - lazy_expr(K) * lazy_expr(C) * lazy_expr(P), P_post);
+  b_x.set_covariance( CovType( P_post ) );
 };
 
 
 /**
  * This function template performs one complete estimation step using the (Extended) Kalman 
  * Filter method, which includes a prediction and measurement update step. This function is, 
- * in general, more efficient than applying the prediction and update separately.
+ * in general, more efficient than applying the prediction and update separately. The work
+ * matrices of the gain computation are drawn from the memory arena of the active arena_scope, if
+ * any, e.g., a filtering loop can run each step within an arena_scope to avoid those heap allocations.
  * \tparam LinearSystem A discrete state-space system modeling the DiscreteLinearSSSConcept 
  *         at least as a DiscreteLinearizedSystemType.
  * \tparam StateSpaceType A topology type on which the state-vectors can reside, should model
@@ -241,17 +253,23 @@ void >::type kalman_filter_step(const LinearSystem& sys,
 
   x = sys.get_next_state(state_space, x, b_u.get_mean_state(), t);
   sys.get_state_transition_blocks(A, B, state_space, t, t + sys.get_time_step(), b_x.get_mean_state(), x, b_u.get_mean_state(), b_u.get_mean_state());
-  P = ( A * P * transpose_view(A)) + B * b_u.get_covariance().get_matrix() * transpose_view(B);
+  // A * P is evaluated before P is overwritten.
+  evaluate_into(sandwich_product(A, P) + sandwich_product(B, b_u.get_covariance().get_matrix()), P);
   
   sys.get_output_function_blocks(C, D, state_space, t + sys.get_time_step(), x, b_u.get_mean_state());
   vect_n<ValueType> y = to_vect<ValueType>(b_z.get_mean_state() - sys.get_output(state_space, x, b_u.get_mean_state(), t + sys.get_time_step()));
-  mat< ValueType, mat_structure::rectangular, mat_alignment::column_major > CP = C * P;
-  mat< ValueType, mat_structure::symmetric > S(CP * transpose_view(C) + b_z.get_covariance().get_matrix());  
+  // the gain computations are done in work matrices drawn from the active memory arena (if any).
+  typename arena_mat< ValueType, mat_structure::rectangular, mat_alignment::column_major >::type CP;
+  evaluate_into(lazy_expr(C) * lazy_expr(P), CP);
+  typename arena_mat< ValueType, mat_structure::symmetric >::type S;
+  evaluate_into(lazy_expr(CP) * transpose(lazy_expr(C)) + lazy_expr(b_z.get_covariance().get_matrix()), S);
   linsolve_Cholesky(S,CP);
-  mat< ValueType, mat_structure::rectangular, mat_alignment::row_major > K( transpose_view(CP) );
+  typename arena_mat< ValueType, mat_structure::rectangular, mat_alignment::row_major >::type K( transpose_view(CP) );
    
   b_x.set_mean_state( state_space.adjust( x, from_vect<StateDiffType>(K * y) ) );
-  b_x.set_covariance( CovType( MatType( (mat< ValueType, mat_structure::identity>(K.get_row_count()) - K * C) * P ) ) );
+  MatType P_post;
+  evaluate_into(lazy_expr(P) - lazy_expr(K) * lazy_expr(C) * lazy_expr(P), P_post);
+  b_x.set_covariance( CovType( P_post ) );
 };
 
 
@@ -456,7 +456,7 @@ namespace graph {
         typename graph_traits<VertexListGraph>::out_edge_iterator eig, eig_end;
         typename graph_traits<VertexListGraph>::in_edge_iterator eii, eii_end;
 
-        while (! Q.empty()) {
+        while (! Q.empty() && bfs_vis.keep_going()) {
           Vertex u = Q.top(); Q.pop();  
           bfs_vis.examine_vertex(u, g);
           DistanceValue g_u = get(distance, u); //RK_NOTICE(1," reached!");
@@ -0,0 +1,1063 @@
+/**
+ * \file concurrent_adjacency_list.hpp
+ *
+ * This library provides an adjacency-list class template that supports concurrent insertions
+ * of vertices and edges (lock-free, except for the occasional allocation of a new storage segment),
+ * concurrently with the traversal of the graph and the reading of vertex / edge properties.
+ * The vertex and edge descriptors are stable indices that are never invalidated by insertions
+ * or removals, which makes this graph suitable as a motion-graph (roadmap) shared by several
+ * worker threads of a sampling-based motion planner.
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_CONCURRENT_ADJACENCY_LIST_HPP
+#define REAK_CONCURRENT_ADJACENCY_LIST_HPP
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/graph_selectors.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/graph/adjacency_iterator.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/mpl/if.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+// BGL-Extra includes:
+#include <boost/graph/more_property_maps.hpp>
+
+
+namespace ReaK {
+
+namespace graph {
+
+
+namespace detail {
+
+
+/*
+ * This class template stores slots in a sequence of geometrically growing segments that are
+ * never moved or re-allocated once created, such that references to the slots remain valid
+ * while other threads append new slots. Slot indices are reserved atomically, and only the
+ * allocation of a new segment takes a lock (with double-checked locking).
+ */
+template <typename Slot>
+class concurrent_slot_storage {
+  public:
+    static const std::size_t first_segment_size = 64;
+    static const std::size_t max_segments = 40;
+
+  private:
+    ReaKaux::atomic< Slot* > m_segments[max_segments];
+    ReaKaux::atomic< std::size_t > m_size;
+    ReaKaux::mutex m_alloc_mutex;
+
+    // non-copyable (use assign):
+    concurrent_slot_storage(const concurrent_slot_storage<Slot>&);
+    concurrent_slot_storage<Slot>& operator=(const concurrent_slot_storage<Slot>&);
+
+    static std::size_t get_segment(std::size_t aId, std::size_t& aOffset) {
+      std::size_t x = aId / first_segment_size + 1;
+      std::size_t k = 0;
+      while(x >>= 1)
+        ++k;
+      aOffset = aId - first_segment_size * ((std::size_t(1) << k) - 1);
+      return k;
+    };
+
+  public:
+
+    concurrent_slot_storage() : m_size(0) {
+      for(std::size_t k = 0; k < max_segments; ++k)
+        m_segments[k].store(NULL, ReaKaux::memory_order_relaxed);
+    };
+
+    ~concurrent_slot_storage() {
+      clear();
+    };
+
+    /**
+     * Returns the number of slots reserved so far (including those not yet published).
+     */
+    std::size_t size() const { return m_size.load(ReaKaux::memory_order_acquire); };
+
+    /**
+     * Reserves a new slot and makes sure that its storage segment exists.
+     * This function is thread-safe.
+     * \return The index of the newly reserved slot.
+     */
+    std::size_t reserve() {
+      std::size_t id = m_size.fetch_add(1, ReaKaux::memory_order_acq_rel);
+      std::size_t offset = 0;
+      std::size_t k = get_segment(id, offset);
+      if(k >= max_segments)
+        throw std::length_error("Exceeded the maximum capacity of a concurrent adjacency-list!");
+      if(m_segments[k].load(ReaKaux::memory_order_acquire) == NULL) {
+        ReaKaux::unique_lock< ReaKaux::mutex > lock_here(m_alloc_mutex);
+        if(m_segments[k].load(ReaKaux::memory_order_relaxed) == NULL)
+          m_segments[k].store(new Slot[first_segment_size << k], ReaKaux::memory_order_release);
+      };
+      return id;
+    };
+
+    /**
+     * Returns a pointer to a slot, or NULL if the slot's segment has not been allocated yet.
+     */
+    Slot* find(std::size_t aId) const {
+      if(aId >= size())
+        return NULL;
+      std::size_t offset = 0;
+      Slot* seg = m_segments[get_segment(aId, offset)].load(ReaKaux::memory_order_acquire);
+      return (seg ? seg + offset : NULL);
+    };
+
+    /**
+     * Returns a reference to a slot that is known to have been reserved.
+     */
+    Slot& operator[](std::size_t aId) const {
+      std::size_t offset = 0;
+      return m_segments[get_segment(aId, offset)].load(ReaKaux::memory_order_acquire)[offset];
+    };
+
+    /**
+     * Destroys all the slots. This function is NOT thread-safe.
+     */
+    void clear() {
+      for(std::size_t k = 0; k < max_segments; ++k) {
+        delete[] m_segments[k].load(ReaKaux::memory_order_relaxed);
+        m_segments[k].store(NULL, ReaKaux::memory_order_relaxed);
+      };
+      m_size.store(0, ReaKaux::memory_order_release);
+    };
+
+    /**
+     * Replaces the content of this storage with a copy of another, preserving the slot indices.
+     * This function is NOT thread-safe.
+     */
+    void assign(const concurrent_slot_storage<Slot>& rhs) {
+      if(&rhs == this)
+        return;
+      clear();
+      std::size_t n = rhs.size();
+      for(std::size_t i = 0; i < n; ++i) {
+        reserve();
+        const Slot* p = rhs.find(i);
+        if(p)
+          (*this)[i].assign(*p);
+      };
+    };
+
+};
+
+
+static const std::size_t concurrent_null_id = ~std::size_t(0);
+
+enum concurrent_slot_state {
+  concurrent_slot_reserved = 0,
+  concurrent_slot_live,
+  concurrent_slot_removed
+};
+
+
+template <typename VertexProperty>
+struct concurrent_vertex_slot {
+  ReaKaux::atomic< int > state;
+  ReaKaux::atomic< std::size_t > out_head;
+  ReaKaux::atomic< std::size_t > in_head;
+  ReaKaux::atomic< std::size_t > out_count;
+  ReaKaux::atomic< std::size_t > in_count;
+  VertexProperty data;
+
+  concurrent_vertex_slot() : state(concurrent_slot_reserved),
+                             out_head(concurrent_null_id), in_head(concurrent_null_id),
+                             out_count(0), in_count(0), data() { };
+
+  void assign(const concurrent_vertex_slot<VertexProperty>& rhs) {
+    out_head.store(rhs.out_head.load(ReaKaux::memory_order_relaxed), ReaKaux::memory_order_relaxed);
+    in_head.store(rhs.in_head.load(ReaKaux::memory_order_relaxed), ReaKaux::memory_order_relaxed);
+    out_count.store(rhs.out_count.load(ReaKaux::memory_order_relaxed), ReaKaux::memory_order_relaxed);
+    in_count.store(rhs.in_count.load(ReaKaux::memory_order_relaxed), ReaKaux::memory_order_relaxed);
+    data = rhs.data;
+    state.store(rhs.state.load(ReaKaux::memory_order_acquire), ReaKaux::memory_order_release);
+  };
+};
+
+
+template <typename EdgeProperty>
+struct concurrent_edge_slot {
+  ReaKaux::atomic< int > state;
+  std::size_t source;
+  std::size_t target;
+  std::size_t next_out;  ///< Next edge in the out-edge list of the source (immutable once linked).
+  std::size_t next_in;   ///< Next edge in the in-edge list of the target (immutable once linked).
+  EdgeProperty data;
+
+  concurrent_edge_slot() : state(concurrent_slot_reserved),
+                           source(concurrent_null_id), target(concurrent_null_id),
+                           next_out(concurrent_null_id), next_in(concurrent_null_id), data() { };
+
+  void assign(const concurrent_edge_slot<EdgeProperty>& rhs) {
+    source = rhs.source;
+    target = rhs.target;
+    next_out = rhs.next_out;
+    next_in = rhs.next_in;
+    data = rhs.data;
+    state.store(rhs.state.load(ReaKaux::memory_order_acquire), ReaKaux::memory_order_release);
+  };
+};
+
+
+struct concurrent_edge_desc {
+  std::size_t id;
+  bool reversed;  ///< True if the edge is seen from its target (undirected out-edges, or in-edges).
+
+  concurrent_edge_desc(std::size_t aId = concurrent_null_id, bool aReversed = false) :
+                       id(aId), reversed(aReversed) { };
+
+  friend bool operator ==(const concurrent_edge_desc& lhs, const concurrent_edge_desc& rhs) {
+    return lhs.id == rhs.id;
+  };
+  friend bool operator !=(const concurrent_edge_desc& lhs, const concurrent_edge_desc& rhs) {
+    return lhs.id != rhs.id;
+  };
+  friend bool operator <(const concurrent_edge_desc& lhs, const concurrent_edge_desc& rhs) {
+    return lhs.id < rhs.id;
+  };
+};
+
+
+template <typename VertexSlotStorage>
+class concurrent_vertex_iterator :
+  public boost::iterator_facade< concurrent_vertex_iterator<VertexSlotStorage>,
+                                 std::size_t, std::forward_iterator_tag, std::size_t > {
+  private:
+    const VertexSlotStorage* p_storage;
+    std::size_t m_id;
+    std::size_t m_end;
+
+    friend class boost::iterator_core_access;
+
+    void skip_dead() {
+      while(m_id < m_end) {
+        const typename VertexSlotStorage::slot_type* p = p_storage->find(m_id);
+        if(p && (p->state.load(ReaKaux::memory_order_acquire) == concurrent_slot_live))
+          return;
+        ++m_id;
+      };
+    };
+
+    std::size_t dereference() const { return m_id; };
+    bool equal(const concurrent_vertex_iterator<VertexSlotStorage>& rhs) const { return m_id == rhs.m_id; };
+    void increment() { ++m_id; skip_dead(); };
+
+  public:
+    concurrent_vertex_iterator() : p_storage(NULL), m_id(0), m_end(0) { };
+    concurrent_vertex_iterator(const VertexSlotStorage* aStorage, std::size_t aId, std::size_t aEnd) :
+                               p_storage(aStorage), m_id(aId), m_end(aEnd) { skip_dead(); };
+};
+
+
+template <typename EdgeSlotStorage>
+class concurrent_edge_iterator :
+  public boost::iterator_facade< concurrent_edge_iterator<EdgeSlotStorage>,
+                                 concurrent_edge_desc, std::forward_iterator_tag, concurrent_edge_desc > {
+  private:
+    const EdgeSlotStorage* p_storage;
+    std::size_t m_id;
+    std::size_t m_end;
+
+    friend class boost::iterator_core_access;
+
+    void skip_dead() {
+      while(m_id < m_end) {
+        const typename EdgeSlotStorage::slot_type* p = p_storage->find(m_id);
+        if(p && (p->state.load(ReaKaux::memory_order_acquire) == concurrent_slot_live))
+          return;
+        ++m_id;
+      };
+    };
+
+    concurrent_edge_desc dereference() const { return concurrent_edge_desc(m_id, false); };
+    bool equal(const concurrent_edge_iterator<EdgeSlotStorage>& rhs) const { return m_id == rhs.m_id; };
+    void increment() { ++m_id; skip_dead(); };
+
+  public:
+    concurrent_edge_iterator() : p_storage(NULL), m_id(0), m_end(0) { };
+    concurrent_edge_iterator(const EdgeSlotStorage* aStorage, std::size_t aId, std::size_t aEnd) :
+                             p_storage(aStorage), m_id(aId), m_end(aEnd) { skip_dead(); };
+};
+
+
+/*
+ * This iterator walks the (up to two) intrusive edge lists attached to a vertex, i.e., the
+ * out-edge list (linked through next_out) and / or the in-edge list (linked through next_in),
+ * skipping the removed edges. Because edges are only ever prepended to those lists, and their
+ * links are immutable once published, the walk is safe concurrently with insertions.
+ */
+template <typename EdgeSlotStorage>
+class concurrent_incident_edge_iterator :
+  public boost::iterator_facade< concurrent_incident_edge_iterator<EdgeSlotStorage>,
+                                 concurrent_edge_desc, std::forward_iterator_tag, concurrent_edge_desc > {
+  private:
+    const EdgeSlotStorage* p_storage;
+    std::size_t m_cur;
+    bool m_cur_follow_in;
+    bool m_cur_reversed;
+    std::size_t m_next_head;
+    bool m_next_follow_in;
+    bool m_next_reversed;
+
+    friend class boost::iterator_core_access;
+
+    void skip_dead() {
+      while(true) {
+        while(m_cur != concurrent_null_id) {
+          const typename EdgeSlotStorage::slot_type& e = (*p_storage)[m_cur];
+          if(e.state.load(ReaKaux::memory_order_acquire) == concurrent_slot_live)
+            return;
+          m_cur = (m_cur_follow_in ? e.next_in : e.next_out);
+        };
+        if(m_next_head == concurrent_null_id)
+          return;
+        m_cur = m_next_head;
+        m_cur_follow_in = m_next_follow_in;
+        m_cur_reversed = m_next_reversed;
+        m_next_head = concurrent_null_id;
+      };
+    };
+
+    concurrent_edge_desc dereference() const { return concurrent_edge_desc(m_cur, m_cur_reversed); };
+    bool equal(const concurrent_incident_edge_iterator<EdgeSlotStorage>& rhs) const {
+      return (m_cur == rhs.m_cur) && (m_next_head == rhs.m_next_head) &&
+             ((m_cur == concurrent_null_id) || (m_cur_follow_in == rhs.m_cur_follow_in));
+    };
+    void increment() {
+      const typename EdgeSlotStorage::slot_type& e = (*p_storage)[m_cur];
+      m_cur = (m_cur_follow_in ? e.next_in : e.next_out);
+      skip_dead();
+    };
+
+  public:
+    concurrent_incident_edge_iterator() : p_storage(NULL), m_cur(concurrent_null_id), m_cur_follow_in(false),
+                                          m_cur_reversed(false), m_next_head(concurrent_null_id),
+                                          m_next_follow_in(false), m_next_reversed(false) { };
+    concurrent_incident_edge_iterator(const EdgeSlotStorage* aStorage,
+                                      std::size_t aFirstHead, bool aFirstFollowIn, bool aFirstReversed,
+                                      std::size_t aSecondHead = concurrent_null_id,
+                                      bool aSecondFollowIn = false, bool aSecondReversed = false) :
+                                      p_storage(aStorage), m_cur(aFirstHead), m_cur_follow_in(aFirstFollowIn),
+                                      m_cur_reversed(aFirstReversed), m_next_head(aSecondHead),
+                                      m_next_follow_in(aSecondFollowIn), m_next_reversed(aSecondReversed) {
+      skip_dead();
+    };
+};
+
+
+template <typename Slot>
+struct concurrent_storage_with_slot : concurrent_slot_storage<Slot> {
+  typedef Slot slot_type;
+};
+
+
+};
+
+
+struct concurrent_adjacency_list_traversal_tag :
+  public virtual boost::bidirectional_graph_tag,
+  public virtual boost::adjacency_graph_tag,
+  public virtual boost::vertex_list_graph_tag,
+  public virtual boost::edge_list_graph_tag { };
+
+
+/**
+ * This class template is an adjacency-list (in BGL-style) that allows several threads to add
+ * vertices and edges concurrently, and to traverse the graph and read its vertex and edge properties
+ * while other threads are inserting. Vertices and edges are stored in segmented arrays that never
+ * move, such that descriptors (indices) and references to properties remain valid for the
+ * lifetime of the graph (or until it is cleared). Edge insertion is lock-free: each edge is
+ * published and then atomically prepended to the out-edge list of its source and the in-edge list
+ * of its target.
+ *
+ * Removals (of edges or vertices) are logical only: the element is marked as removed, is skipped
+ * by all traversals and no longer counts towards the sizes and degrees, but its storage is only
+ * reclaimed when the graph is cleared or destroyed. Removing a vertex while other threads add
+ * edges to it is not supported.
+ *
+ * Writing to the vertex or edge properties must be synchronized by the user (with respect to
+ * other readers or writers of the same properties), only the graph structure is synchronized.
+ *
+ * This graph models the BidirectionalGraphConcept (in-edges are always tracked, even for directedS),
+ * the AdjacencyGraphConcept, the VertexListGraphConcept, the EdgeListGraphConcept, the MutableGraph
+ * and MutablePropertyGraph concepts, and provides the create_root / add_child_vertex functions
+ * used by the tree-growing planners (as adjacency_list_BC does).
+ *
+ * \tparam DirectedS The directionality of the graph (boost::undirectedS, boost::directedS or boost::bidirectionalS).
+ * \tparam VertexProperty The bundled vertex property type.
+ * \tparam EdgeProperty The bundled edge property type.
+ */
+template <typename DirectedS = boost::undirectedS,
+          typename VertexProperty = boost::no_property,
+          typename EdgeProperty = boost::no_property>
+class concurrent_adjacency_list {
+  public:
+    typedef concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty> self;
+
+  private:
+    typedef detail::concurrent_vertex_slot<VertexProperty> vertex_slot;
+    typedef detail::concurrent_edge_slot<EdgeProperty> edge_slot;
+    typedef detail::concurrent_storage_with_slot<vertex_slot> vertex_storage;
+    typedef detail::concurrent_storage_with_slot<edge_slot> edge_storage;
+
+    static const bool is_undirected = boost::is_same< DirectedS, boost::undirectedS >::value;
+
+  public:
+
+    // Graph traits:
+    typedef std::size_t vertex_descriptor;
+    typedef detail::concurrent_edge_desc edge_descriptor;
+    typedef typename boost::mpl::if_c< is_undirected,
+      boost::undirected_tag, boost::bidirectional_tag >::type directed_category;
+    typedef boost::allow_parallel_edge_tag edge_parallel_category;
+    typedef concurrent_adjacency_list_traversal_tag traversal_category;
+
+    static vertex_descriptor null_vertex() { return detail::concurrent_null_id; };
+
+    // IncidenceGraph traits:
+    typedef detail::concurrent_incident_edge_iterator<edge_storage> out_edge_iterator;
+    typedef std::size_t degree_size_type;
+
+    // BidirectionalGraph traits:
+    typedef detail::concurrent_incident_edge_iterator<edge_storage> in_edge_iterator;
+
+    // VertexListGraph traits:
+    typedef detail::concurrent_vertex_iterator<vertex_storage> vertex_iterator;
+    typedef std::size_t vertices_size_type;
+
+    // EdgeListGraph traits:
+    typedef detail::concurrent_edge_iterator<edge_storage> edge_iterator;
+    typedef std::size_t edges_size_type;
+
+    // AdjacencyGraph traits:
+    typedef typename boost::adjacency_iterator_generator<self, vertex_descriptor, out_edge_iterator>::type adjacency_iterator;
+
+    // PropertyGraph traits:
+    typedef EdgeProperty edge_property_type;
+    typedef VertexProperty vertex_property_type;
+
+    typedef VertexProperty vertex_bundled;
+    typedef EdgeProperty edge_bundled;
+
+    typedef void graph_bundled;
+
+  private:
+
+    vertex_storage m_vertices;
+    edge_storage m_edges;
+    ReaKaux::atomic< std::size_t > m_num_vertices;
+    ReaKaux::atomic< std::size_t > m_num_edges;
+
+    vertex_descriptor publish_vertex(vertex_descriptor v) {
+      m_vertices[v].state.store(detail::concurrent_slot_live, ReaKaux::memory_order_release);
+      m_num_vertices.fetch_add(1, ReaKaux::memory_order_acq_rel);
+      return v;
+    };
+
+    edge_descriptor link_edge(std::size_t e_id, vertex_descriptor u, vertex_descriptor v) {
+      edge_slot& e = m_edges[e_id];
+      e.source = u;
+      e.target = v;
+      e.state.store(detail::concurrent_slot_live, ReaKaux::memory_order_release);
+
+      vertex_slot& us = m_vertices[u];
+      e.next_out = us.out_head.load(ReaKaux::memory_order_acquire);
+      while(!us.out_head.compare_exchange_weak(e.next_out, e_id, ReaKaux::memory_order_acq_rel, ReaKaux::memory_order_acquire)) { };
+      us.out_count.fetch_add(1, ReaKaux::memory_order_acq_rel);
+
+      vertex_slot& vs = m_vertices[v];
+      e.next_in = vs.in_head.load(ReaKaux::memory_order_acquire);
+      while(!vs.in_head.compare_exchange_weak(e.next_in, e_id, ReaKaux::memory_order_acq_rel, ReaKaux::memory_order_acquire)) { };
+      vs.in_count.fetch_add(1, ReaKaux::memory_order_acq_rel);
+
+      m_num_edges.fetch_add(1, ReaKaux::memory_order_acq_rel);
+      return edge_descriptor(e_id, false);
+    };
+
+  public:
+
+    concurrent_adjacency_list() : m_num_vertices(0), m_num_edges(0) { };
+
+    /**
+     * Copy-constructor, NOT thread-safe with respect to concurrent modifications of the source graph.
+     * Descriptors of the source graph remain valid for the copy.
+     */
+    concurrent_adjacency_list(const self& rhs) : m_num_vertices(0), m_num_edges(0) {
+      *this = rhs;
+    };
+
+    /**
+     * Copy-assignment, NOT thread-safe (with respect to either graph).
+     * Descriptors of the source graph remain valid for the destination graph.
+     */
+    self& operator=(const self& rhs) {
+      if(&rhs == this)
+        return *this;
+      m_vertices.assign(rhs.m_vertices);
+      m_edges.assign(rhs.m_edges);
+      m_num_vertices.store(rhs.m_num_vertices.load(ReaKaux::memory_order_acquire), ReaKaux::memory_order_release);
+      m_num_edges.store(rhs.m_num_edges.load(ReaKaux::memory_order_acquire), ReaKaux::memory_order_release);
+      return *this;
+    };
+
+    /**
+     * Removes all the vertices and edges, and releases the storage. NOT thread-safe.
+     */
+    void clear() {
+      m_edges.clear();
+      m_vertices.clear();
+      m_num_vertices.store(0, ReaKaux::memory_order_release);
+      m_num_edges.store(0, ReaKaux::memory_order_release);
+    };
+
+
+    // Bundled Property-map functions (used by the boost::property_map< self, T Bundle::* > classes).
+
+    vertex_bundled& operator[]( const vertex_descriptor& v_i) {
+      return m_vertices[v_i].data;
+    };
+    const vertex_bundled& operator[]( const vertex_descriptor& v_i) const {
+      return m_vertices[v_i].data;
+    };
+    edge_bundled& operator[]( const edge_descriptor& e_i) {
+      return m_edges[e_i.id].data;
+    };
+    const edge_bundled& operator[]( const edge_descriptor& e_i) const {
+      return m_edges[e_i.id].data;
+    };
+
+    friend const vertex_bundled& get( const self& g, const vertex_descriptor& v_i) {
+      return g[v_i];
+    };
+
+    friend void put( self& g, const vertex_descriptor& v_i, const vertex_bundled& value) {
+      g[v_i] = value;
+    };
+
+    friend const edge_bundled& get( const self& g, const edge_descriptor& e_i) {
+      return g[e_i];
+    };
+
+    friend void put( self& g, const edge_descriptor& e_i, const edge_bundled& value) {
+      g[e_i] = value;
+    };
+
+    template <typename T, typename Bundle>
+    friend
+    typename boost::property_map< self, T Bundle::* >::type
+    get( T Bundle::* p, self& g) {
+      return typename boost::property_map< self, T Bundle::* >::type(&g, p);
+    };
+
+    template <typename T, typename Bundle>
+    friend
+    typename boost::property_map< self, T Bundle::* >::const_type
+    get( T Bundle::* p, const self& g) {
+      return typename boost::property_map< self, T Bundle::* >::const_type(&g, p);
+    };
+
+
+
+
+    // IncidenceGraph concept
+
+    std::pair<out_edge_iterator, out_edge_iterator> out_edges_impl(vertex_descriptor u) const {
+      const vertex_slot& us = m_vertices[u];
+      if(is_undirected)
+        return std::pair<out_edge_iterator, out_edge_iterator>(
+          out_edge_iterator(&m_edges, us.out_head.load(ReaKaux::memory_order_acquire), false, false,
+                                      us.in_head.load(ReaKaux::memory_order_acquire), true, true),
+          out_edge_iterator());
+      return std::pair<out_edge_iterator, out_edge_iterator>(
+        out_edge_iterator(&m_edges, us.out_head.load(ReaKaux::memory_order_acquire), false, false),
+        out_edge_iterator());
+    };
+    vertex_descriptor source_impl(edge_descriptor e) const {
+      const edge_slot& es = m_edges[e.id];
+      return (e.reversed ? es.target : es.source);
+    };
+    vertex_descriptor target_impl(edge_descriptor e) const {
+      const edge_slot& es = m_edges[e.id];
+      return (e.reversed ? es.source : es.target);
+    };
+    degree_size_type out_degree_impl(vertex_descriptor u) const {
+      const vertex_slot& us = m_vertices[u];
+      if(is_undirected)
+        return us.out_count.load(ReaKaux::memory_order_acquire) + us.in_count.load(ReaKaux::memory_order_acquire);
+      return us.out_count.load(ReaKaux::memory_order_acquire);
+    };
+
+    // BidirectionalGraph concept
+
+    std::pair<in_edge_iterator, in_edge_iterator> in_edges_impl(vertex_descriptor v) const {
+      const vertex_slot& vs = m_vertices[v];
+      if(is_undirected)
+        return std::pair<in_edge_iterator, in_edge_iterator>(
+          in_edge_iterator(&m_edges, vs.in_head.load(ReaKaux::memory_order_acquire), true, false,
+                                     vs.out_head.load(ReaKaux::memory_order_acquire), false, true),
+          in_edge_iterator());
+      return std::pair<in_edge_iterator, in_edge_iterator>(
+        in_edge_iterator(&m_edges, vs.in_head.load(ReaKaux::memory_order_acquire), true, false),
+        in_edge_iterator());
+    };
+    degree_size_type in_degree_impl(vertex_descriptor v) const {
+      const vertex_slot& vs = m_vertices[v];
+      if(is_undirected)
+        return vs.out_count.load(ReaKaux::memory_order_acquire) + vs.in_count.load(ReaKaux::memory_order_acquire);
+      return vs.in_count.load(ReaKaux::memory_order_acquire);
+    };
+
+    // VertexListGraph concept
+
+    std::pair< vertex_iterator, vertex_iterator > vertices_impl() const {
+      std::size_t n = m_vertices.size();
+      return std::pair< vertex_iterator, vertex_iterator >(vertex_iterator(&m_vertices, 0, n),
+                                                           vertex_iterator(&m_vertices, n, n));
+    };
+    vertices_size_type num_vertices_impl() const {
+      return m_num_vertices.load(ReaKaux::memory_order_acquire);
+    };
+
+    // EdgeListGraph concept
+
+    std::pair< edge_iterator, edge_iterator > edges_impl() const {
+      std::size_t n = m_edges.size();
+      return std::pair< edge_iterator, edge_iterator >(edge_iterator(&m_edges, 0, n),
+                                                       edge_iterator(&m_edges, n, n));
+    };
+    edges_size_type num_edges_impl() const {
+      return m_num_edges.load(ReaKaux::memory_order_acquire);
+    };
+
+    // MutableGraph concept
+
+    vertex_descriptor add_vertex_impl() {
+      return publish_vertex(m_vertices.reserve());
+    };
+
+    vertex_descriptor add_vertex_impl(const vertex_property_type& vp) {
+      vertex_descriptor v = m_vertices.reserve();
+      m_vertices[v].data = vp;
+      return publish_vertex(v);
+    };
+
+    std::pair<edge_descriptor, bool> add_edge_impl(vertex_descriptor u, vertex_descriptor v,
+                                                   const edge_property_type& ep = edge_property_type()) {
+      std::size_t e_id = m_edges.reserve();
+      m_edges[e_id].data = ep;
+      return std::pair<edge_descriptor, bool>(link_edge(e_id, u, v), true);
+    };
+
+    bool remove_edge_impl(edge_descriptor e) {
+      edge_slot& es = m_edges[e.id];
+      int expected = detail::concurrent_slot_live;
+      if(!es.state.compare_exchange_strong(expected, int(detail::concurrent_slot_removed), ReaKaux::memory_order_acq_rel))
+        return false;
+      m_vertices[es.source].out_count.fetch_sub(1, ReaKaux::memory_order_acq_rel);
+      m_vertices[es.target].in_count.fetch_sub(1, ReaKaux::memory_order_acq_rel);
+      m_num_edges.fetch_sub(1, ReaKaux::memory_order_acq_rel);
+      return true;
+    };
+
+    void remove_edge_impl(vertex_descriptor u, vertex_descriptor v) {
+      out_edge_iterator ei, ei_end;
+      for(boost::tie(ei, ei_end) = out_edges_impl(u); ei != ei_end; ++ei)
+        if(target_impl(*ei) == v)
+          remove_edge_impl(*ei);
+    };
+
+    void clear_vertex_impl(vertex_descriptor v) {
+      out_edge_iterator ei, ei_end;
+      for(boost::tie(ei, ei_end) = out_edges_impl(v); ei != ei_end; ++ei)
+        remove_edge_impl(*ei);
+      in_edge_iterator iei, iei_end;
+      for(boost::tie(iei, iei_end) = in_edges_impl(v); iei != iei_end; ++iei)
+        remove_edge_impl(*iei);
+    };
+
+    void remove_vertex_impl(vertex_descriptor v) {
+      clear_vertex_impl(v);
+      int expected = detail::concurrent_slot_live;
+      if(m_vertices[v].state.compare_exchange_strong(expected, int(detail::concurrent_slot_removed), ReaKaux::memory_order_acq_rel))
+        m_num_vertices.fetch_sub(1, ReaKaux::memory_order_acq_rel);
+    };
+
+    // Tree-growing functions (same as for the adjacency_list_BC)
+
+    vertex_descriptor create_root_impl(const vertex_property_type& vp) {
+      return add_vertex_impl(vp);
+    };
+
+    std::pair< vertex_descriptor, edge_descriptor>
+      add_child_vertex_impl(vertex_descriptor u,
+                            const vertex_property_type& vp,
+                            const edge_property_type& ep = edge_property_type()) {
+      vertex_descriptor v = add_vertex_impl(vp);
+      return std::pair< vertex_descriptor, edge_descriptor>(v, add_edge_impl(u, v, ep).first);
+    };
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    vertex_descriptor add_vertex_impl(vertex_property_type&& vp) {
+      vertex_descriptor v = m_vertices.reserve();
+      m_vertices[v].data = std::move(vp);
+      return publish_vertex(v);
+    };
+
+    std::pair<edge_descriptor, bool> add_edge_impl(vertex_descriptor u, vertex_descriptor v,
+                                                   edge_property_type&& ep) {
+      std::size_t e_id = m_edges.reserve();
+      m_edges[e_id].data = std::move(ep);
+      return std::pair<edge_descriptor, bool>(link_edge(e_id, u, v), true);
+    };
+
+    vertex_descriptor create_root_impl(vertex_property_type&& vp) {
+      return add_vertex_impl(std::move(vp));
+    };
+
+    std::pair< vertex_descriptor, edge_descriptor>
+      add_child_vertex_impl(vertex_descriptor u, vertex_property_type&& vp) {
+      vertex_descriptor v = add_vertex_impl(std::move(vp));
+      return std::pair< vertex_descriptor, edge_descriptor>(v, add_edge_impl(u, v).first);
+    };
+
+    std::pair< vertex_descriptor, edge_descriptor>
+      add_child_vertex_impl(vertex_descriptor u, vertex_property_type&& vp, edge_property_type&& ep) {
+      vertex_descriptor v = add_vertex_impl(std::move(vp));
+      return std::pair< vertex_descriptor, edge_descriptor>(v, add_edge_impl(u, v, std::move(ep)).first);
+    };
+#endif
+
+};
+
+
+
+/*******************************************************************************************
+ *                  IncidenceGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::out_edge_iterator,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::out_edge_iterator >
+  out_edges(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+            const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.out_edges_impl(u);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  source(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor e,
+         const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.source_impl(e);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  target(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor e,
+         const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.target_impl(e);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::degree_size_type
+  out_degree(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+             const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.out_degree_impl(u);
+};
+
+
+/*******************************************************************************************
+ *                  BidirectionalGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::in_edge_iterator,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::in_edge_iterator >
+  in_edges(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+           const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.in_edges_impl(v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::degree_size_type
+  in_degree(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+            const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.in_degree_impl(v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::degree_size_type
+  degree(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+         const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  if(boost::is_same< DirectedS, boost::undirectedS >::value)
+    return g.out_degree_impl(v);
+  return g.out_degree_impl(v) + g.in_degree_impl(v);
+};
+
+
+/*******************************************************************************************
+ *                  AdjacencyGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::adjacency_iterator,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::adjacency_iterator >
+  adjacent_vertices(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                    const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  typedef typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::adjacency_iterator AdjIter;
+  typedef typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::out_edge_iterator OutEdgeIter;
+  std::pair< OutEdgeIter, OutEdgeIter > oe = g.out_edges_impl(u);
+  return std::pair< AdjIter, AdjIter >(AdjIter(oe.first, &g), AdjIter(oe.second, &g));
+};
+
+
+/*******************************************************************************************
+ *                  VertexListGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_iterator,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_iterator >
+  vertices(const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.vertices_impl();
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertices_size_type
+  num_vertices(const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.num_vertices_impl();
+};
+
+
+/*******************************************************************************************
+ *                  EdgeListGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_iterator,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_iterator >
+  edges(const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.edges_impl();
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edges_size_type
+  num_edges(const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.num_edges_impl();
+};
+
+
+/*******************************************************************************************
+ *                  MutableGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  add_vertex(concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_vertex_impl();
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+void clear_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+                  concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  g.clear_vertex_impl(v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+void remove_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+                   concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  g.remove_vertex_impl(v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor, bool >
+  add_edge(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+           concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_edge_impl(u, v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+void remove_edge(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                 typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+                 concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  g.remove_edge_impl(u, v);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+void remove_edge(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor e,
+                 concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  g.remove_edge_impl(e);
+};
+
+
+/*******************************************************************************************
+ *                  MutablePropertyGraph concept
+ ******************************************************************************************/
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  add_vertex(const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type& vp,
+             concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_vertex_impl(vp);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor, bool >
+  add_edge(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+           const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_property_type& ep,
+           concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_edge_impl(u, v, ep);
+};
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  add_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type&& vp,
+             concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_vertex_impl(std::move(vp));
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor, bool >
+  add_edge(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor v,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_property_type&& ep,
+           concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_edge_impl(u, v, std::move(ep));
+};
+#endif
+
+
+/***********************************************************************************************
+ *                             MutablePropertyTreeConcept
+ * ********************************************************************************************/
+
+/* The root of a tree grown in the graph is its first (live) vertex. */
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  get_root_vertex(const concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  typedef typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_iterator VertexIter;
+  std::pair< VertexIter, VertexIter > vp = g.vertices_impl();
+  if(vp.first == vp.second)
+    return concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::null_vertex();
+  return *(vp.first);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  create_root(const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type& vp,
+              concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.create_root_impl(vp);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor >
+  add_child_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                   const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type& vp,
+                   concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_child_vertex_impl(u, vp);
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor >
+  add_child_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                   const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type& vp,
+                   const typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_property_type& ep,
+                   concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_child_vertex_impl(u, vp, ep);
+};
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor
+  create_root(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type&& vp,
+              concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.create_root_impl(std::move(vp));
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor >
+  add_child_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                   typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type&& vp,
+                   concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_child_vertex_impl(u, std::move(vp));
+};
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty>
+std::pair< typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor,
+           typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_descriptor >
+  add_child_vertex(typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_descriptor u,
+                   typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::vertex_property_type&& vp,
+                   typename concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>::edge_property_type&& ep,
+                   concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>& g) {
+  return g.add_child_vertex_impl(u, std::move(vp), std::move(ep));
+};
+#endif
+
+
+};  // end namespace graph
+
+};  // end namespace ReaK
+
+
+namespace boost {
+
+template <typename DirectedS, typename VertexProperty, typename EdgeProperty, typename T, typename Bundle>
+struct property_map< ReaK::graph::concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>, T Bundle::* > {
+  typedef typename remove_const< Bundle >::type non_const_Bundle;
+  typedef typename remove_const< T >::type non_const_T;
+  typedef is_convertible< VertexProperty*, non_const_Bundle* > is_vertex_bundle;
+  typedef bundle_member_property_map< non_const_T, ReaK::graph::concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>,
+    typename mpl::if_< is_vertex_bundle, vertex_bundle_t, edge_bundle_t >::type > type;
+  typedef bundle_member_property_map< const non_const_T, const ReaK::graph::concurrent_adjacency_list<DirectedS, VertexProperty, EdgeProperty>,
+    typename mpl::if_< is_vertex_bundle, vertex_bundle_t, edge_bundle_t >::type > const_type;
+};
+
+};
+
+
+#endif
+
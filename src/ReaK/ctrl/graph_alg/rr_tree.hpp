@@ -28,6 +28,12 @@
  * The user can thus record successful connections as paths and decide whether it's worth continuing 
  * with the generation the Bi-RRT in the hopes of finding a better path with richer trees.
  * 
+ * Finally, this library provides parallel versions of both algorithms, in which a number of 
+ * worker threads concurrently perform the sampling, nearest-neighbor queries, steering and 
+ * collision-checking, while the additions of vertices and edges to the shared tree(s) are 
+ * synchronized with a reader-writer mutex. This is mostly useful when the steering and 
+ * collision-checking dominate the run-time, which is typical of complex free-spaces.
+ * 
  * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
  * \date February 2011
  */
@@ -65,6 +71,9 @@
 #include <ReaK/ctrl/topologies/metric_space_concept.hpp>
 #include <ReaK/ctrl/topologies/random_sampler_concept.hpp>
 
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/core/base/shared_mutex.hpp>
+
 // BGL-Extra includes:
 #include <boost/graph/tree_adaptor.hpp>
 #include <boost/graph/more_property_maps.hpp>
@@ -140,6 +149,193 @@ namespace detail {
     };
   };
   
+  
+  /* Shared state of the workers of a parallel RRT, protected by its graph mutex. */
+  struct parallel_rrt_state {
+    shared_mutex graph_mutex;
+    bool must_stop;
+    
+    parallel_rrt_state() : must_stop(false) { };
+    
+    template <typename Visitor>
+    bool keep_going(const Visitor& vis) { 
+      shared_lock_guard< shared_mutex > lock_here(graph_mutex);
+      return !must_stop && vis.keep_going();
+    };
+    
+    void stop() {
+      ReaKaux::lock_guard< shared_mutex > lock_here(graph_mutex);
+      must_stop = true;
+    };
+  };
+  
+  
+  /* Same as expand_rrt_vertex, but the nearest-neighbor query and the steering (collision-checking) 
+   * are done under a shared lock, and only the addition of the new vertex is done under an exclusive lock. 
+   * The nearest vertex is carried over from the shared lock to the exclusive lock by its descriptor, which 
+   * requires that the vertex descriptors of the graph remain valid when other vertices are added (as for 
+   * all the motion-graph storages, including the adjacency-list of the DVP layout), while references to 
+   * vertex properties do not. The position of the new vertex is returned in p_v. */
+  template <typename Graph,
+            typename Topology,
+            typename RRTVisitor,
+            typename PositionMap,
+            typename NNFinder>
+  inline std::pair< typename boost::graph_traits<Graph>::vertex_descriptor, bool>
+    expand_rrt_vertex_concurrently(Graph& g, const Topology& space, const RRTVisitor& vis, PositionMap position,
+                                   NNFinder& find_nearest_neighbor, parallel_rrt_state& state,
+                                   const typename boost::property_traits<PositionMap>::value_type& p_target,
+                                   typename boost::property_traits<PositionMap>::value_type& p_v) {
+    typedef typename boost::property_traits<PositionMap>::value_type PositionValue;
+    typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+    typedef typename Graph::vertex_bundled VertexProp;
+    typedef typename Graph::edge_bundled EdgeProp;
+    typedef typename boost::graph_traits<Graph>::edge_descriptor Edge;
+    
+    Vertex u;
+    bool reached_new; EdgeProp ep;
+    {
+      shared_lock_guard< shared_mutex > lock_here(state.graph_mutex);
+      u = find_nearest_neighbor(p_target, g, space, boost::bundle_prop_to_vertex_prop(position, g));
+      boost::tie(p_v, reached_new, ep) = vis.steer_towards_position(p_target,u,g);
+    };
+    if(!reached_new)
+      return std::make_pair(u,false);
+    
+    ReaKaux::lock_guard< shared_mutex > lock_here(state.graph_mutex);
+    VertexProp vp; 
+    put(position, vp, p_v);
+    Vertex v; Edge e;
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    boost::tie(v,e) = add_child_vertex(u, std::move(vp), std::move(ep), g);
+#else
+    boost::tie(v,e) = add_child_vertex(u, vp, ep, g);
+#endif
+    vis.vertex_added(v,g);
+    vis.edge_added(e, g);
+    return std::make_pair(v,true);
+  };
+  
+  template <typename Graph,
+            typename Topology,
+            typename RRTVisitor,
+            typename PositionMap,
+            typename RandomSampler,
+            typename NNFinder>
+  struct parallel_rrt_worker {
+    typedef typename boost::property_traits<PositionMap>::value_type PositionValue;
+    
+    Graph* p_g;
+    const Topology* p_space;
+    const RRTVisitor* p_vis;
+    PositionMap position;
+    RandomSampler get_sample;
+    NNFinder find_nearest_neighbor;
+    parallel_rrt_state* p_state;
+    
+    parallel_rrt_worker(Graph& g, const Topology& space, const RRTVisitor& vis, PositionMap aPosition, 
+                        RandomSampler aGetSample, NNFinder aFindNN, parallel_rrt_state& state) : 
+                        p_g(&g), p_space(&space), p_vis(&vis), position(aPosition), 
+                        get_sample(aGetSample), find_nearest_neighbor(aFindNN), p_state(&state) { };
+    
+    void operator()(std::size_t, std::size_t, std::size_t) {
+      try {
+        while(p_state->keep_going(*p_vis)) {
+          PositionValue p_rnd = get_sample(*p_space);
+          PositionValue p_new;
+          expand_rrt_vertex_concurrently(*p_g, *p_space, *p_vis, position, find_nearest_neighbor, 
+                                         *p_state, p_rnd, p_new);
+        };
+      } catch(...) {
+        p_state->stop();
+        throw;
+      };
+    };
+  };
+  
+  template <typename Graph,
+            typename Topology,
+            typename BiRRTVisitor,
+            typename PositionMap,
+            typename RandomSampler,
+            typename NNFinder>
+  struct parallel_birrt_worker {
+    typedef typename boost::property_traits<PositionMap>::value_type PositionValue;
+    typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+    
+    Graph* p_g1;
+    Graph* p_g2;
+    const Topology* p_space;
+    const BiRRTVisitor* p_vis;
+    PositionMap position;
+    RandomSampler get_sample;
+    NNFinder find_nearest_neighbor;
+    parallel_rrt_state* p_state;
+    Vertex root1;
+    Vertex root2;
+    PositionValue p_root1;
+    PositionValue p_root2;
+    
+    parallel_birrt_worker(Graph& g1, Graph& g2, const Topology& space, const BiRRTVisitor& vis, PositionMap aPosition, 
+                          RandomSampler aGetSample, NNFinder aFindNN, parallel_rrt_state& state, 
+                          Vertex aRoot1, Vertex aRoot2) : 
+                          p_g1(&g1), p_g2(&g2), p_space(&space), p_vis(&vis), position(aPosition), 
+                          get_sample(aGetSample), find_nearest_neighbor(aFindNN), p_state(&state),
+                          root1(aRoot1), root2(aRoot2), 
+                          p_root1(get(aPosition, g1[aRoot1])), p_root2(get(aPosition, g2[aRoot2])) { };
+    
+    void joining_vertex_found(Vertex u1, Vertex u2) {
+      ReaKaux::lock_guard< shared_mutex > lock_here(p_state->graph_mutex);
+      p_vis->joining_vertex_found(u1, u2, *p_g1, *p_g2);
+    };
+    
+    void operator()(std::size_t, std::size_t, std::size_t) {
+      try {
+        // each worker alternates between the two trees, with its own targets (see generate_bidirectional_rrt).
+        // the positions of the target vertices are kept, such that they are read without locking the graph.
+        std::pair<Vertex,bool> v_target2(root1, true);
+        PositionValue p_target2 = p_root1;
+        std::pair<Vertex,bool> v_target1(root2, true);
+        PositionValue p_target1 = p_root2;
+        
+        while(p_state->keep_going(*p_vis)) {
+          PositionValue p_v1;
+          std::pair< Vertex, bool> v1 = expand_rrt_vertex_concurrently(
+            *p_g1, *p_space, *p_vis, position, find_nearest_neighbor, *p_state, p_target1, p_v1);
+          if((v1.second) && (v_target1.second)) {
+            joining_vertex_found(v1.first, v_target1.first);
+            p_target2 = get_sample(*p_space);
+            v_target2.second = false;
+          } else if(!v1.second) {
+            p_target2 = get_sample(*p_space);
+            v_target2.second = false;
+          } else {
+            p_target2 = p_v1;
+            v_target2.first = v1.first; v_target2.second = true;
+          };
+          
+          PositionValue p_v2;
+          std::pair< Vertex, bool> v2 = expand_rrt_vertex_concurrently(
+            *p_g2, *p_space, *p_vis, position, find_nearest_neighbor, *p_state, p_target2, p_v2);
+          if((v2.second) && (v_target2.second)) {
+            joining_vertex_found(v_target2.first, v2.first);
+            p_target1 = get_sample(*p_space);
+            v_target1.second = false;
+          } else if(!v2.second) {
+            p_target1 = get_sample(*p_space);
+            v_target1.second = false;
+          } else {
+            p_target1 = p_v2;
+            v_target1.first = v2.first; v_target1.second = true;
+          };
+        };
+      } catch(...) {
+        p_state->stop();
+        throw;
+      };
+    };
+  };
+  
 }; //namespace detail
 
 
@@ -334,6 +530,137 @@ namespace detail {
     };
   };
 
+  
+  
+  /**
+   * This function template is the parallel version of the unidirectional RRT algorithm (refer to rr_tree.hpp dox).
+   * A number of worker threads each repeatedly sample a random point, find its nearest neighbor in the tree and 
+   * steer towards it (the expensive collision-checking part), concurrently, and only the additions of the new 
+   * vertices and edges to the tree (and the visitor callbacks at that point) are mutually exclusive.
+   * \note The nearest-neighbor finder, the visitor's steer_towards_position and keep_going functions, and the 
+   *       random sampler must be safe to call from concurrent threads (as long as the graph is not modified).
+   *       The vertex_added and edge_added visitor callbacks are always called by one thread at a time.
+   *       The vertex descriptors of the graph must remain valid when other vertices are added, as for all the 
+   *       motion-graph storages (e.g., the adjacency-list of the DVP layout moves the vertex properties, 
+   *       but not the vertex descriptors), such that the nearest-neighbor finder can also be approximate.
+   * \tparam Graph A mutable graph type that will represent the generated tree, should model boost::VertexListGraphConcept and boost::MutableGraphConcept
+   * \tparam Topology A topology type that will represent the space in which the configurations (or positions) exist, should model BGL's Topology concept
+   * \tparam RRTVisitor An RRT visitor type that implements the customizations to this RRT algorithm, should model the RRTVisitorConcept.
+   * \tparam PositionMap A property-map type that can store the configurations (or positions) of the vertices.
+   * \tparam RandomSampler This is a random-sampler over the topology (see pp::RandomSamplerConcept).
+   * \tparam NNFinder A functor type which can perform a nearest-neighbor search of a point to a graph in the topology (see topological_search.hpp).
+   * \param g A mutable graph that should initially store the starting 
+   *        vertex (if not it will be randomly generated) and will store 
+   *        the generated tree once the algorithm has finished.
+   * \param space A topology (as defined by the Boost Graph Library). Note 
+   *        that it is not required to generate only random points in 
+   *        the free-space.
+   * \param vis A RRT visitor implementing the RRTVisitorConcept. This is the 
+   *        main point of customization and recording of results that the 
+   *        user can implement.
+   * \param position A mapping that implements the MutablePropertyMap Concept. Also,
+   *        the value_type of this map should be the same type as the topology's 
+   *        value_type. This map should allow read-write access to the position associated 
+   *        to a vertex's property (Graph::vertex_property_type).
+   * \param get_sample A random sampler of positions in the free-space (obstacle-free sub-set of the topology).
+   * \param find_nearest_neighbor A callable object (functor) which can perform a 
+   *        nearest neighbor search of a point to a graph in the topology. (see topological_search.hpp)
+   * \param num_workers The number of worker threads to use (0 means the number of hardware threads).
+   * 
+   */
+  template <typename Graph,
+            typename Topology,
+            typename RRTVisitor,
+            typename PositionMap,
+            typename RandomSampler,
+            typename NNFinder>
+  inline void generate_parallel_rrt(Graph& g,
+                                    const Topology& space,
+                                    RRTVisitor vis,
+                                    PositionMap position,
+                                    RandomSampler get_sample,
+                                    NNFinder find_nearest_neighbor,
+                                    std::size_t num_workers = 0) {
+    BOOST_CONCEPT_ASSERT((RRTVisitorConcept<RRTVisitor,Graph,Topology>));
+    BOOST_CONCEPT_ASSERT((ReaK::pp::RandomSamplerConcept<RandomSampler,Topology>));
+    
+    detail::rrt_get_or_create_root(g, space, vis, get_sample, position);
+    
+    detail::parallel_rrt_state state;
+    thread_pool workers(num_workers);
+    workers.for_each_block(workers.size(), 
+      detail::parallel_rrt_worker<Graph, Topology, RRTVisitor, PositionMap, RandomSampler, NNFinder>(
+        g, space, vis, position, get_sample, find_nearest_neighbor, state));
+    
+  };
+  
+  
+  /**
+   * This function is the parallel version of the bidirectional RRT algorithm (refer to rr_tree.hpp dox).
+   * Each worker thread alternates between the expansions of the two trees (as in generate_bidirectional_rrt), 
+   * with its own targets, such that the nearest-neighbor queries and the steering (collision-checking) of 
+   * all the workers are done concurrently, and only the additions to the trees and the notifications of 
+   * joining vertices are mutually exclusive.
+   * \note The same thread-safety requirements as for generate_parallel_rrt apply, and the joining_vertex_found
+   *       visitor callback is also called by one thread at a time.
+   * \tparam Graph A mutable graph type that will represent the generated tree, should model boost::VertexListGraphConcept and boost::MutableGraphConcept
+   * \tparam Topology A topology type that will represent the space in which the configurations (or positions) exist, should model BGL's Topology concept
+   * \tparam BiRRTVisitor A Bi-RRT visitor type that implements the customizations to this Bi-RRT algorithm, should model the BiRRTVisitorConcept.
+   * \tparam PositionMap A property-map type that can store the configurations (or positions) of the vertices.
+   * \tparam RandomSampler This is a random-sampler over the topology (see pp::RandomSamplerConcept).
+   * \tparam NNFinder A functor type which can perform a nearest-neighbor search of a point to a graph in the topology (see topological_search.hpp).
+   * \param g1 A mutable graph that should initially store the starting 
+   *        vertex (if not it will be randomly generated) and will store 
+   *        the generated tree once the algorithm has finished.
+   * \param g2 A mutable graph that should initially store the goal 
+   *        vertex (if not it will be randomly generated) and will store 
+   *        the generated tree once the algorithm has finished.
+   * \param space A topology (as defined by the Boost Graph Library). Note 
+   *        that it is not required to generate only random points in 
+   *        the free-space.
+   * \param vis A RRT visitor implementing the RRTVisitorConcept. This is the 
+   *        main point of customization and recording of results that the 
+   *        user can implement.
+   * \param position A mapping for the graph vertex properties that implements the MutablePropertyMap Concept. 
+   *        Also, the value_type of this map should be the same type as the topology's 
+   *        value_type. This map should allow read-write access to the position associated 
+   *        to a vertex's property (Graph::vertex_property_type).
+   * \param get_sample A random sampler of positions in the free-space (obstacle-free sub-set of the topology).
+   * \param find_nearest_neighbor A callable object (functor) which can perform a 
+   *        nearest neighbor search of a point to a graph in the 
+   *        topology. (see topological_search.hpp)
+   * \param num_workers The number of worker threads to use (0 means the number of hardware threads).
+   * 
+   */
+  template <typename Graph,
+            typename Topology,
+            typename BiRRTVisitor,
+            typename PositionMap,
+            typename RandomSampler,
+            typename NNFinder>
+  inline void generate_parallel_bidirectional_rrt(Graph& g1, Graph& g2,
+                                                  const Topology& space,
+                                                  BiRRTVisitor vis,
+                                                  PositionMap position,
+                                                  RandomSampler get_sample,
+                                                  NNFinder find_nearest_neighbor,
+                                                  std::size_t num_workers = 0) {
+    BOOST_CONCEPT_ASSERT((BiRRTVisitorConcept<BiRRTVisitor,Graph,Topology>));
+    BOOST_CONCEPT_ASSERT((ReaK::pp::RandomSamplerConcept<RandomSampler,Topology>));
+    
+    typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+    
+    Vertex root1 = detail::rrt_get_or_create_root(g1, space, vis, get_sample, position);
+    Vertex root2 = detail::rrt_get_or_create_root(g2, space, vis, get_sample, position);
+    
+    detail::parallel_rrt_state state;
+    thread_pool workers(num_workers);
+    workers.for_each_block(workers.size(), 
+      detail::parallel_birrt_worker<Graph, Topology, BiRRTVisitor, PositionMap, RandomSampler, NNFinder>(
+        g1, g2, space, vis, position, get_sample, find_nearest_neighbor, state, root1, root2));
+    
+  };
+
 
 };
 
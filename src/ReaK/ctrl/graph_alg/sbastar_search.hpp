@@ -47,6 +47,9 @@
 #define REAK_SBASTAR_SEARCH_HPP
 
 #include <utility>
+#include <vector>
+#include <algorithm>
+#include <limits>
 #include <boost/tuple/tuple.hpp>
 
 #include <ReaK/ctrl/topologies/metric_space_concept.hpp>
@@ -59,6 +62,9 @@
 #include <boost/graph/more_property_tags.hpp>
 #include <boost/graph/more_property_maps.hpp>
 
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/core/base/shared_mutex.hpp>
+
 #include "pruned_connector.hpp"
 #include "lazy_connector.hpp"
 #include "branch_and_bound_connector.hpp"
@@ -546,6 +552,170 @@ namespace detail {
   };
   
   
+  /* Shared state of the workers of a parallel SBA* search, protected by its graph mutex. */
+  template <typename Vertex>
+  struct sbastar_parallel_state {
+    shared_mutex graph_mutex;
+    ReaKaux::condition_variable_any expansion_done;
+    std::vector< Vertex > in_flight;  ///< Vertices being expanded (popped, not yet re-queued).
+    bool must_stop;
+    
+    sbastar_parallel_state() : must_stop(false) { };
+    
+    bool is_in_flight(Vertex u) const {
+      return std::find(in_flight.begin(), in_flight.end(), u) != in_flight.end();
+    };
+    
+    void stop() {
+      {
+        ReaKaux::lock_guard< shared_mutex > lock_here(graph_mutex);
+        must_stop = true;
+      };
+      expansion_done.notify_all();
+    };
+  };
+  
+  template <typename Graph, typename Topology, typename SBAStarVisitor, typename MotionGraphConnector, 
+            typename MutableQueue, typename NcSelector>
+  struct sbastar_parallel_worker {
+    typedef typename ReaK::pp::topology_traits<Topology>::point_type PositionValue;
+    typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+    typedef typename Graph::edge_bundled EdgeProp;
+    typedef sbastar_parallel_state<Vertex> state_type;
+    
+    Graph* p_g;
+    const Topology* p_super_space;
+    SBAStarVisitor* p_sba_vis;
+    MotionGraphConnector connect_vertex;
+    MutableQueue* p_Q;
+    NcSelector select_neighborhood;
+    state_type* p_state;
+    
+    sbastar_parallel_worker(Graph& g, const Topology& super_space, SBAStarVisitor& sba_vis, 
+                            MotionGraphConnector aConnectVertex, MutableQueue& Q, 
+                            NcSelector aSelectNeighborhood, state_type& state) : 
+                            p_g(&g), p_super_space(&super_space), p_sba_vis(&sba_vis), 
+                            connect_vertex(aConnectVertex), p_Q(&Q), 
+                            select_neighborhood(aSelectNeighborhood), p_state(&state) { };
+    
+    /* Pops the next vertex to expand, or returns false if the search is over. */
+    bool pop_next_vertex(Vertex& u) {
+      ReaKaux::unique_lock< shared_mutex > lock_here(p_state->graph_mutex);
+      while(true) {
+        // wait for other expansions to refill the OPEN queue, if needed.
+        while(!p_state->must_stop && p_Q->empty() && !p_state->in_flight.empty())
+          p_state->expansion_done.wait(lock_here);
+        if(p_state->must_stop)
+          return false;
+        if(p_Q->empty() || !p_sba_vis->keep_going()) {
+          p_state->must_stop = true;
+          p_state->expansion_done.notify_all();
+          return false;
+        };
+        u = p_Q->top(); p_Q->pop();
+        // a vertex that is being expanded by another worker can be re-queued (as an affected vertex) 
+        // by the connections of other workers, but it will be re-queued by its own worker when done.
+        if(!p_state->is_in_flight(u))
+          break;
+      };
+      
+      // stop if the best node does not meet the potential threshold.
+      if( ! p_sba_vis->has_search_potential(u, *p_g) ) {
+        p_state->must_stop = true;
+        p_state->expansion_done.notify_all();
+        return false;
+      };
+      
+      p_sba_vis->examine_vertex(u, *p_g);
+      p_state->in_flight.push_back(u);
+      return true;
+    };
+    
+    /* Removes a vertex from the in-flight list and re-queues it. The vertex descriptors remain valid 
+     * when other workers add vertices (see generate_parallel_sbastar), so the in-flight list and the 
+     * OPEN queue can hold them while the graph lock is released. */
+    void finish_expansion(Vertex u) {
+      p_state->in_flight.erase(std::find(p_state->in_flight.begin(), p_state->in_flight.end(), u));
+      // then push it back on the OPEN queue.
+      p_sba_vis->requeue_vertex(u, *p_g);
+    };
+    
+    void operator()(std::size_t, std::size_t, std::size_t) {
+      try {
+        Vertex u;
+        while(pop_next_vertex(u)) {
+          PositionValue p_new; Vertex x_near; EdgeProp eprop;
+          {
+            shared_lock_guard< shared_mutex > lock_here(p_state->graph_mutex);
+            boost::tie(x_near, p_new, eprop) = sba_node_generator()(u, *p_g, *p_sba_vis, p_sba_vis->m_position);
+          };
+          
+          {
+            ReaKaux::lock_guard< shared_mutex > lock_here(p_state->graph_mutex);
+            finish_expansion(u);
+            
+            if(x_near != boost::graph_traits<Graph>::null_vertex()) {
+              connect_vertex(p_new, x_near, eprop, *p_g, 
+                             *p_super_space, *p_sba_vis, p_sba_vis->m_position, 
+                             p_sba_vis->m_distance, p_sba_vis->m_predecessor, 
+                             p_sba_vis->m_weight, select_neighborhood);
+            };
+          };
+          p_state->expansion_done.notify_all();
+        };
+      } catch(...) {
+        p_state->stop();
+        throw;
+      };
+    };
+  };
+  
+  template <typename Graph, typename Topology, typename SBAStarVisitor,
+            typename NodeConnector, typename KeyMap, typename PositionMap, typename WeightMap,
+            typename DensityMap, typename ConstrictionMap, typename DistanceMap, typename PredecessorMap,
+            typename FwdDistanceMap, typename NcSelector>
+  void generate_parallel_sbastar_no_init_impl(Graph &g, 
+      typename boost::graph_traits<Graph>::vertex_descriptor start_vertex, 
+      const Topology& super_space, SBAStarVisitor vis, 
+      NodeConnector connect_vertex, KeyMap key, PositionMap position, WeightMap weight, 
+      DensityMap density, ConstrictionMap constriction, 
+      DistanceMap distance, PredecessorMap predecessor, 
+      FwdDistanceMap fwd_distance, NcSelector select_neighborhood, 
+      std::size_t num_workers)
+  {
+    typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+    
+    typedef std::less<double> KeyCompareType;  // <---- this is a min-heap.
+    typedef boost::vector_property_map<std::size_t> IndexInHeapMap;
+    IndexInHeapMap index_in_heap;
+    {
+      typename boost::graph_traits<Graph>::vertex_iterator ui, ui_end;
+      for (boost::tie(ui, ui_end) = vertices(g); ui != ui_end; ++ui) {
+        put(index_in_heap,*ui, static_cast<std::size_t>(-1)); 
+      };
+    };
+    
+    typedef boost::d_ary_heap_indirect<Vertex, 4, IndexInHeapMap, KeyMap, KeyCompareType> MutableQueue;
+    MutableQueue Q(key, index_in_heap, KeyCompareType()); //priority queue holding the OPEN set.
+    
+    typedef sbastar_bfs_visitor<Graph, SBAStarVisitor, MutableQueue, IndexInHeapMap,
+                                KeyMap, PositionMap, WeightMap, DensityMap, ConstrictionMap, 
+                                DistanceMap, PredecessorMap, FwdDistanceMap> SBAVisitorType;
+    SBAVisitorType sba_bfs_vis(vis, Q, index_in_heap, key, position, weight, 
+                               density, constriction, distance, predecessor, fwd_distance);
+    
+    put(distance, g[start_vertex], 0.0);
+    put(predecessor, g[start_vertex], start_vertex);
+    sba_bfs_vis.requeue_vertex(start_vertex,g);
+    
+    sbastar_parallel_state<Vertex> state;
+    thread_pool workers(num_workers);
+    workers.for_each_block(workers.size(), 
+      sbastar_parallel_worker<Graph, Topology, SBAVisitorType, NodeConnector, MutableQueue, NcSelector>(
+        g, super_space, sba_bfs_vis, connect_vertex, Q, select_neighborhood, state));
+  };
+  
+  
   template <typename Graph, typename SBAStarVisitor, typename KeyMap, 
             typename DistanceMap, typename PredecessorMap>
   void initialize_sbastar_nodes(Graph &g, SBAStarVisitor vis, KeyMap key, 
@@ -934,6 +1104,54 @@ void generate_lazy_sbastar(const SBAStarBundle& bdl) {
 };
 
 
+
+/**
+ * This function template generates a roadmap to connect a goal location to a start location
+ * using the SBA* algorithm, with several worker threads expanding the roadmap concurrently, 
+ * and with initialization of the existing graph to (re)start the search. Each worker pops the 
+ * best vertex from the OPEN queue and performs its random-walk (steering and collision-checking) 
+ * concurrently with the other workers, while the connection of the new vertex to the roadmap 
+ * and the updates of the OPEN queue are mutually exclusive. A vertex is never expanded by two 
+ * workers at the same time, even if it is re-queued by the connections made by other workers.
+ * \note The visitor's random_walk function (and the random sampling it uses) must be safe to call 
+ *       from concurrent threads (as long as the graph is not modified), all the other visitor callbacks 
+ *       are always called by one thread at a time. The vertex descriptors of the graph must remain 
+ *       valid when other vertices are added, as for all the motion-graph storages (e.g., the adjacency-list 
+ *       of the DVP layout moves the vertex properties, but not the vertex descriptors).
+ * \tparam SBAStarBundle A SBA* bundle type (see make_sbastar_bundle()).
+ * \param bdl A const-reference to a SBA* bundle of parameters, see make_sbastar_bundle().
+ * \param num_workers The number of worker threads to use (0 means the number of hardware threads).
+ */
+template <typename SBAStarBundle>
+void generate_parallel_sbastar(const SBAStarBundle& bdl, std::size_t num_workers = 0) {
+  detail::initialize_sbastar_nodes(*(bdl.m_g), bdl.m_vis, bdl.m_key, bdl.m_distance, bdl.m_predecessor);
+  detail::generate_parallel_sbastar_no_init_impl(
+    *(bdl.m_g), bdl.m_start_vertex, *(bdl.m_super_space), bdl.m_vis, 
+    pruned_node_connector(), bdl.m_key, bdl.m_position, bdl.m_weight, 
+    bdl.m_density, bdl.m_constriction, bdl.m_distance, bdl.m_predecessor, 
+    bdl.m_fwd_distance, bdl.m_select_neighborhood, num_workers);
+};
+
+/**
+ * This function template generates a roadmap to connect a goal location to a start location
+ * using the Lazy-SBA* algorithm, with several worker threads expanding the roadmap concurrently, 
+ * and with initialization of the existing graph to (re)start the search.
+ * See generate_parallel_sbastar for the synchronization and thread-safety requirements.
+ * \tparam SBAStarBundle A SBA* bundle type (see make_sbastar_bundle()).
+ * \param bdl A const-reference to a SBA* bundle of parameters, see make_sbastar_bundle().
+ * \param num_workers The number of worker threads to use (0 means the number of hardware threads).
+ */
+template <typename SBAStarBundle>
+void generate_parallel_lazy_sbastar(const SBAStarBundle& bdl, std::size_t num_workers = 0) {
+  detail::initialize_sbastar_nodes(*(bdl.m_g), bdl.m_vis, bdl.m_key, bdl.m_distance, bdl.m_predecessor);
+  detail::generate_parallel_sbastar_no_init_impl(
+    *(bdl.m_g), bdl.m_start_vertex, *(bdl.m_super_space), bdl.m_vis, 
+    lazy_node_connector(), bdl.m_key, bdl.m_position, bdl.m_weight, 
+    bdl.m_density, bdl.m_constriction, bdl.m_distance, bdl.m_predecessor, 
+    bdl.m_fwd_distance, bdl.m_select_neighborhood, num_workers);
+};
+
+
 /**
  * This function template generates a roadmap to connect a goal location to a start location
  * using the Bi-directional Lazy-SBA* algorithm, without initialization of the existing graph.
@@ -0,0 +1,224 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <vector>
+#include <set>
+
+#include <ReaK/core/base/thread_incl.hpp>
+#include <ReaK/ctrl/graph_alg/concurrent_adjacency_list.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE concurrent_graph
+#include <boost/test/unit_test.hpp>
+
+
+
+struct test_vertex_prop {
+  int value;
+};
+
+struct test_edge_prop {
+  int weight;
+};
+
+typedef ReaK::graph::concurrent_adjacency_list< boost::undirectedS, test_vertex_prop, test_edge_prop > undirected_graph;
+typedef ReaK::graph::concurrent_adjacency_list< boost::bidirectionalS, test_vertex_prop, test_edge_prop > bidir_graph;
+
+
+BOOST_AUTO_TEST_CASE( concurrent_graph_sequential_test )
+{
+  bidir_graph g;
+  BOOST_CHECK_EQUAL( num_vertices(g), 0 );
+
+  std::vector< bidir_graph::vertex_descriptor > vs;
+  for(int i = 0; i < 200; ++i) {
+    test_vertex_prop vp; vp.value = i;
+    vs.push_back( add_vertex(vp, g) );
+  };
+  BOOST_CHECK_EQUAL( num_vertices(g), 200 );
+  for(int i = 0; i < 200; ++i) {
+    BOOST_CHECK_EQUAL( g[vs[i]].value, i );
+  };
+
+  for(int i = 1; i < 200; ++i) {
+    test_edge_prop ep; ep.weight = i;
+    add_edge(vs[0], vs[i], ep, g);
+  };
+  BOOST_CHECK_EQUAL( num_edges(g), 199 );
+  BOOST_CHECK_EQUAL( out_degree(vs[0], g), 199 );
+  BOOST_CHECK_EQUAL( in_degree(vs[0], g), 0 );
+  BOOST_CHECK_EQUAL( in_degree(vs[5], g), 1 );
+
+  int weight_sum = 0;
+  bidir_graph::out_edge_iterator ei, ei_end;
+  for(boost::tie(ei, ei_end) = out_edges(vs[0], g); ei != ei_end; ++ei) {
+    BOOST_CHECK( source(*ei, g) == vs[0] );
+    BOOST_CHECK_EQUAL( g[*ei].weight, g[target(*ei, g)].value );
+    weight_sum += g[*ei].weight;
+  };
+  BOOST_CHECK_EQUAL( weight_sum, 199 * 100 );
+
+  remove_edge(vs[0], vs[5], g);
+  BOOST_CHECK_EQUAL( num_edges(g), 198 );
+  BOOST_CHECK_EQUAL( out_degree(vs[0], g), 198 );
+  BOOST_CHECK_EQUAL( in_degree(vs[5], g), 0 );
+
+  remove_vertex(vs[7], g);
+  BOOST_CHECK_EQUAL( num_vertices(g), 199 );
+  BOOST_CHECK_EQUAL( num_edges(g), 197 );
+  // descriptors remain valid after a removal:
+  BOOST_CHECK_EQUAL( g[vs[8]].value, 8 );
+
+  std::size_t v_count = 0;
+  bidir_graph::vertex_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    BOOST_CHECK( *vi != vs[7] );
+    ++v_count;
+  };
+  BOOST_CHECK_EQUAL( v_count, 199 );
+
+  std::size_t e_count = 0;
+  bidir_graph::edge_iterator eit, eit_end;
+  for(boost::tie(eit, eit_end) = edges(g); eit != eit_end; ++eit)
+    ++e_count;
+  BOOST_CHECK_EQUAL( e_count, 197 );
+
+  bidir_graph g2(g);
+  BOOST_CHECK_EQUAL( num_vertices(g2), 199 );
+  BOOST_CHECK_EQUAL( num_edges(g2), 197 );
+  BOOST_CHECK_EQUAL( g2[vs[150]].value, 150 );
+};
+
+
+BOOST_AUTO_TEST_CASE( concurrent_graph_undirected_test )
+{
+  undirected_graph g;
+  test_vertex_prop vp; vp.value = 0;
+  undirected_graph::vertex_descriptor u = create_root(vp, g);
+  vp.value = 1;
+  std::pair< undirected_graph::vertex_descriptor, undirected_graph::edge_descriptor > r = add_child_vertex(u, vp, g);
+  vp.value = 2;
+  undirected_graph::vertex_descriptor w = add_vertex(vp, g);
+  test_edge_prop ep; ep.weight = 12;
+  add_edge(w, r.first, ep, g);
+
+  BOOST_CHECK_EQUAL( out_degree(r.first, g), 2 );
+  BOOST_CHECK_EQUAL( out_degree(u, g), 1 );
+
+  std::set< undirected_graph::vertex_descriptor > nbrs;
+  undirected_graph::out_edge_iterator ei, ei_end;
+  for(boost::tie(ei, ei_end) = out_edges(r.first, g); ei != ei_end; ++ei) {
+    BOOST_CHECK( source(*ei, g) == r.first );
+    nbrs.insert( target(*ei, g) );
+  };
+  BOOST_CHECK_EQUAL( nbrs.size(), 2 );
+  BOOST_CHECK( nbrs.count(u) == 1 );
+  BOOST_CHECK( nbrs.count(w) == 1 );
+
+  std::size_t adj_count = 0;
+  undirected_graph::adjacency_iterator ai, ai_end;
+  for(boost::tie(ai, ai_end) = adjacent_vertices(w, g); ai != ai_end; ++ai) {
+    BOOST_CHECK( *ai == r.first );
+    ++adj_count;
+  };
+  BOOST_CHECK_EQUAL( adj_count, 1 );
+};
+
+
+namespace {
+
+struct concurrent_inserter {
+  bidir_graph* p_g;
+  bidir_graph::vertex_descriptor root;
+  int thread_id;
+  int count;
+
+  void operator()() const {
+    bidir_graph::vertex_descriptor prev = root;
+    for(int i = 0; i < count; ++i) {
+      test_vertex_prop vp; vp.value = thread_id * count + i;
+      test_edge_prop ep; ep.weight = thread_id;
+      std::pair< bidir_graph::vertex_descriptor, bidir_graph::edge_descriptor > r = add_child_vertex(prev, vp, ep, *p_g);
+      // also connect every new vertex to the shared root, to stress the edge-list insertions:
+      add_edge(root, r.first, ep, *p_g);
+      // read back through the stable handle, concurrently with other insertions:
+      if((*p_g)[r.first].value != thread_id * count + i)
+        throw std::runtime_error("Corrupted vertex property!");
+      prev = r.first;
+    };
+  };
+};
+
+};
+
+
+BOOST_AUTO_TEST_CASE( concurrent_graph_multithread_test )
+{
+  const int thread_count = 4;
+  const int per_thread = 5000;
+
+  bidir_graph g;
+  test_vertex_prop vp; vp.value = -1;
+  bidir_graph::vertex_descriptor root = create_root(vp, g);
+
+  std::vector< ReaKaux::thread* > threads;
+  for(int t = 0; t < thread_count; ++t) {
+    concurrent_inserter ins;
+    ins.p_g = &g;
+    ins.root = root;
+    ins.thread_id = t;
+    ins.count = per_thread;
+    threads.push_back(new ReaKaux::thread(ins));
+  };
+  for(int t = 0; t < thread_count; ++t) {
+    threads[t]->join();
+    delete threads[t];
+  };
+
+  BOOST_CHECK_EQUAL( num_vertices(g), 1 + thread_count * per_thread );
+  BOOST_CHECK_EQUAL( num_edges(g), 2 * thread_count * per_thread );
+  BOOST_CHECK_EQUAL( out_degree(root, g), thread_count * (per_thread + 1) );
+
+  std::size_t root_out_count = 0;
+  bidir_graph::out_edge_iterator ei, ei_end;
+  for(boost::tie(ei, ei_end) = out_edges(root, g); ei != ei_end; ++ei)
+    ++root_out_count;
+  BOOST_CHECK_EQUAL( root_out_count, thread_count * (per_thread + 1) );
+
+  std::vector< int > seen(thread_count * per_thread, 0);
+  bidir_graph::vertex_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    if(*vi == root)
+      continue;
+    BOOST_CHECK_EQUAL( in_degree(*vi, g), 2 );
+    int val = g[*vi].value;
+    BOOST_REQUIRE( (val >= 0) && (val < thread_count * per_thread) );
+    ++seen[val];
+  };
+  for(std::size_t i = 0; i < seen.size(); ++i)
+    BOOST_CHECK_EQUAL( seen[i], 1 );
+};
+
+
@@ -0,0 +1,388 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <vector>
+#include <set>
+#include <limits>
+
+#include <ReaK/core/base/chrono_incl.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/ctrl/graph_alg/concurrent_adjacency_list.hpp>
+#include <ReaK/ctrl/graph_alg/neighborhood_functors.hpp>
+#include <ReaK/ctrl/graph_alg/rr_tree.hpp>
+#include <ReaK/ctrl/graph_alg/sbastar_search.hpp>
+#include <ReaK/ctrl/path_planning/topological_search.hpp>
+
+#include <boost/property_map/vector_property_map.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE parallel_planners
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+typedef vect<double,2> point_type;
+typedef pp::hyperbox_topology< point_type > space_type;
+
+struct test_vertex_prop {
+  point_type position;
+  double density;
+  double constriction;
+  double distance_accum;
+  double heuristic_value;
+  std::size_t predecessor;
+
+  test_vertex_prop() : position(), density(0.0), constriction(0.0),
+                       distance_accum(0.0), heuristic_value(0.0), predecessor(0) { };
+};
+
+struct test_edge_prop {
+  double weight;
+
+  explicit test_edge_prop(double aWeight = 0.0) : weight(aWeight) { };
+};
+
+typedef graph::concurrent_adjacency_list< boost::undirectedS, test_vertex_prop, test_edge_prop > test_graph;
+typedef boost::graph_traits< test_graph >::vertex_descriptor test_vertex;
+
+typedef boost::data_member_property_map< point_type, test_vertex_prop > test_position_map;
+
+static const double test_step = 0.05;
+
+
+/* Counts the visitor callbacks that must be called by one thread at a time, and the overlaps between them. */
+struct exclusive_section_counter {
+  ReaKaux::mutex m_mutex;
+  std::size_t m_active;
+  std::size_t m_overlaps;
+
+  exclusive_section_counter() : m_active(0), m_overlaps(0) { };
+
+  void enter() {
+    ReaKaux::lock_guard< ReaKaux::mutex > lock_here(m_mutex);
+    if(++m_active != 1)
+      ++m_overlaps;
+  };
+  void leave() {
+    ReaKaux::lock_guard< ReaKaux::mutex > lock_here(m_mutex);
+    --m_active;
+  };
+};
+
+/* Simulates the (expensive) collision-checking of a motion. */
+static void simulate_collision_check() {
+  ReaKaux::this_thread::sleep_for(ReaKaux::chrono::microseconds(100));
+};
+
+static point_type step_towards(const point_type& p_from, const point_type& p_to) {
+  point_type d = p_to - p_from;
+  double n = norm_2(d);
+  if(n > test_step)
+    d *= test_step / n;
+  return p_from + d;
+};
+
+
+struct test_rrt_visitor : graph::rrt_visitor_archetype {
+  const space_type* p_space;
+  std::size_t max_vertices;
+  exclusive_section_counter* p_counter;
+  ReaKaux::mutex* p_join_mutex;
+  std::size_t* p_join_count;
+
+  test_rrt_visitor(const space_type& aSpace, std::size_t aMaxVertices, exclusive_section_counter& aCounter,
+                   ReaKaux::mutex& aJoinMutex, std::size_t& aJoinCount) :
+                   p_space(&aSpace), max_vertices(aMaxVertices), p_counter(&aCounter),
+                   p_join_mutex(&aJoinMutex), p_join_count(&aJoinCount) { };
+
+  void vertex_added(test_vertex, test_graph&) const { p_counter->enter(); p_counter->leave(); };
+  template <typename Edge>
+  void edge_added(Edge, test_graph&) const { p_counter->enter(); p_counter->leave(); };
+
+  bool keep_going() const { return true; };
+  bool is_position_free(const point_type&) const { return true; };
+
+  boost::tuple<point_type, bool, test_edge_prop> steer_towards_position(const point_type& p, test_vertex u, test_graph& g) const {
+    simulate_collision_check();
+    point_type p_new = step_towards(g[u].position, p);
+    return boost::tuple<point_type, bool, test_edge_prop>(p_new, true, test_edge_prop(norm_2(p_new - g[u].position)));
+  };
+
+  void joining_vertex_found(test_vertex, test_vertex, test_graph&, test_graph&) const {
+    ReaKaux::lock_guard< ReaKaux::mutex > lock_here(*p_join_mutex);
+    ++(*p_join_count);
+  };
+};
+
+/* Stops the search once enough vertices were added to the graph(s). */
+struct test_rrt_limited_visitor : test_rrt_visitor {
+  const test_graph* p_g1;
+  const test_graph* p_g2;
+
+  test_rrt_limited_visitor(const test_rrt_visitor& aVis, const test_graph& g1, const test_graph& g2) :
+                           test_rrt_visitor(aVis), p_g1(&g1), p_g2(&g2) { };
+
+  bool keep_going() const { return num_vertices(*p_g1) + num_vertices(*p_g2) < max_vertices; };
+};
+
+
+static void check_rrt_tree(const test_graph& g, std::size_t& edge_count) {
+  edge_count = 0;
+  test_graph::edge_iterator ei, ei_end;
+  for(boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+    double d = norm_2(g[target(*ei, g)].position - g[source(*ei, g)].position);
+    BOOST_CHECK( d <= test_step + 1e-8 );
+    BOOST_CHECK( std::fabs(d - g[*ei].weight) < 1e-8 );
+    ++edge_count;
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_rrt_test )
+{
+  space_type space("test_space", point_type(0.0, 0.0), point_type(1.0, 1.0));
+  test_graph g, g_empty;
+  test_vertex_prop vp; vp.position = point_type(0.5, 0.5);
+  create_root(vp, g);
+
+  exclusive_section_counter counter;
+  ReaKaux::mutex join_mutex; std::size_t join_count = 0;
+  test_rrt_limited_visitor vis(test_rrt_visitor(space, 400, counter, join_mutex, join_count), g, g_empty);
+
+  graph::generate_parallel_rrt(g, space, vis, test_position_map(&test_vertex_prop::position),
+                               pp::get(pp::random_sampler, space),
+                               pp::linear_neighbor_search< test_graph >(), 4);
+
+  // each worker can add one last vertex after the others have seen the limit.
+  BOOST_CHECK( num_vertices(g) >= 400 );
+  BOOST_CHECK( num_vertices(g) < 400 + 4 );
+  BOOST_CHECK_EQUAL( counter.m_overlaps, 0 );
+  std::size_t edge_count = 0;
+  check_rrt_tree(g, edge_count);
+  BOOST_CHECK_EQUAL( edge_count + 1, num_vertices(g) );
+};
+
+
+/* An approximate nearest-neighbor finder, which returns the second-nearest vertex when there is one. 
+ * The parallel RRT must connect each new vertex to the vertex it was steered from, which would not be 
+ * the case if that vertex was looked up again (by position) with this finder. */
+struct test_second_nearest_search {
+  template <typename Topology, typename PositionMap>
+  test_vertex operator()(const point_type& p, test_graph& g, const Topology& space, PositionMap position) const {
+    test_vertex best = boost::graph_traits< test_graph >::null_vertex();
+    test_vertex second = best;
+    double best_dist = std::numeric_limits<double>::infinity();
+    double second_dist = best_dist;
+    test_graph::vertex_iterator vi, vi_end;
+    for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+      double d = get(pp::distance_metric, space)(p, get(position, *vi), space);
+      if(d < best_dist) {
+        second = best; second_dist = best_dist;
+        best = *vi; best_dist = d;
+      } else if(d < second_dist) {
+        second = *vi; second_dist = d;
+      };
+    };
+    if(second == boost::graph_traits< test_graph >::null_vertex())
+      return best;
+    return second;
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_rrt_approx_nn_test )
+{
+  space_type space("test_space", point_type(0.0, 0.0), point_type(1.0, 1.0));
+  test_graph g, g_empty;
+  test_vertex_prop vp; vp.position = point_type(0.5, 0.5);
+  create_root(vp, g);
+
+  exclusive_section_counter counter;
+  ReaKaux::mutex join_mutex; std::size_t join_count = 0;
+  test_rrt_limited_visitor vis(test_rrt_visitor(space, 400, counter, join_mutex, join_count), g, g_empty);
+
+  graph::generate_parallel_rrt(g, space, vis, test_position_map(&test_vertex_prop::position),
+                               pp::get(pp::random_sampler, space),
+                               test_second_nearest_search(), 4);
+
+  BOOST_CHECK( num_vertices(g) >= 400 );
+  BOOST_CHECK_EQUAL( counter.m_overlaps, 0 );
+  // the edges are checked against the distances computed when steering from the parent vertices.
+  std::size_t edge_count = 0;
+  check_rrt_tree(g, edge_count);
+  BOOST_CHECK_EQUAL( edge_count + 1, num_vertices(g) );
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_birrt_test )
+{
+  space_type space("test_space", point_type(0.0, 0.0), point_type(1.0, 1.0));
+  test_graph g1, g2;
+  test_vertex_prop vp;
+  vp.position = point_type(0.1, 0.1);
+  create_root(vp, g1);
+  vp.position = point_type(0.9, 0.9);
+  create_root(vp, g2);
+
+  exclusive_section_counter counter;
+  ReaKaux::mutex join_mutex; std::size_t join_count = 0;
+  test_rrt_limited_visitor vis(test_rrt_visitor(space, 600, counter, join_mutex, join_count), g1, g2);
+
+  graph::generate_parallel_bidirectional_rrt(g1, g2, space, vis, test_position_map(&test_vertex_prop::position),
+                                             pp::get(pp::random_sampler, space),
+                                             pp::linear_neighbor_search< test_graph >(), 4);
+
+  BOOST_CHECK( num_vertices(g1) + num_vertices(g2) >= 600 );
+  BOOST_CHECK_EQUAL( counter.m_overlaps, 0 );
+  // with free space and greedy connections, the trees must have met.
+  BOOST_CHECK( join_count > 0 );
+  std::size_t edge_count1 = 0, edge_count2 = 0;
+  check_rrt_tree(g1, edge_count1);
+  check_rrt_tree(g2, edge_count2);
+  BOOST_CHECK_EQUAL( edge_count1 + 1, num_vertices(g1) );
+  BOOST_CHECK_EQUAL( edge_count2 + 1, num_vertices(g2) );
+};
+
+
+
+/* SBA* visitor that records the vertices being expanded, to detect concurrent expansions of the same vertex. */
+struct test_sbastar_visitor : graph::sbastar_visitor_archetype<space_type> {
+  const space_type* p_space;
+  point_type goal;
+  std::size_t max_vertices;
+  exclusive_section_counter* p_counter;
+  ReaKaux::mutex* p_expand_mutex;
+  std::multiset< test_vertex >* p_expanding;
+  std::size_t* p_double_expansions;
+  std::size_t* p_expansions;
+
+  test_sbastar_visitor(const space_type& aSpace, const point_type& aGoal, std::size_t aMaxVertices,
+                       exclusive_section_counter& aCounter, ReaKaux::mutex& aExpandMutex,
+                       std::multiset< test_vertex >& aExpanding, std::size_t& aDoubleExpansions,
+                       std::size_t& aExpansions) :
+                       p_space(&aSpace), goal(aGoal), max_vertices(aMaxVertices), p_counter(&aCounter),
+                       p_expand_mutex(&aExpandMutex), p_expanding(&aExpanding),
+                       p_double_expansions(&aDoubleExpansions), p_expansions(&aExpansions) { };
+
+  void vertex_added(test_vertex u, test_graph& g) const {
+    p_counter->enter();
+    g[u].heuristic_value = norm_2(goal - g[u].position);
+    p_counter->leave();
+  };
+  template <typename Edge>
+  void edge_added(Edge, test_graph&) const { p_counter->enter(); p_counter->leave(); };
+  void affected_vertex(test_vertex, test_graph&) const { p_counter->enter(); p_counter->leave(); };
+  void vertex_to_be_removed(test_vertex, test_graph&) const { };
+
+  // the search is stopped by the vertex limit (see test_sbastar_limited_visitor).
+  bool keep_going() const { return true; };
+
+  boost::tuple<point_type, bool, test_edge_prop> random_walk(test_vertex u, test_graph& g) const {
+    {
+      ReaKaux::lock_guard< ReaKaux::mutex > lock_here(*p_expand_mutex);
+      if(p_expanding->count(u))
+        ++(*p_double_expansions);
+      p_expanding->insert(u);
+      ++(*p_expansions);
+    };
+    point_type p_rnd = pp::get(pp::random_sampler, *p_space)(*p_space);
+    simulate_collision_check();
+    point_type p_new = step_towards(g[u].position, p_rnd);
+    {
+      ReaKaux::lock_guard< ReaKaux::mutex > lock_here(*p_expand_mutex);
+      p_expanding->erase(p_expanding->find(u));
+    };
+    return boost::tuple<point_type, bool, test_edge_prop>(p_new, true, test_edge_prop(norm_2(p_new - g[u].position)));
+  };
+
+  std::pair<bool, test_edge_prop> can_be_connected(test_vertex u, test_vertex v, test_graph& g) const {
+    double d = norm_2(g[v].position - g[u].position);
+    return std::pair<bool, test_edge_prop>(d <= 2.0 * test_step, test_edge_prop(d));
+  };
+};
+
+struct test_sbastar_limited_visitor : test_sbastar_visitor {
+  const test_graph* p_g;
+
+  test_sbastar_limited_visitor(const test_sbastar_visitor& aVis, const test_graph& g) :
+                               test_sbastar_visitor(aVis), p_g(&g) { };
+
+  bool keep_going() const { return num_vertices(*p_g) < max_vertices; };
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_sbastar_test )
+{
+  space_type space("test_space", point_type(0.0, 0.0), point_type(1.0, 1.0));
+  point_type goal(0.9, 0.9);
+  test_graph g;
+  test_vertex_prop vp; vp.position = point_type(0.1, 0.1);
+  vp.heuristic_value = norm_2(goal - vp.position);
+  test_vertex start = add_vertex(vp, g);
+
+  exclusive_section_counter counter;
+  ReaKaux::mutex expand_mutex; std::multiset< test_vertex > expanding;
+  std::size_t double_expansions = 0, expansions = 0;
+  test_sbastar_limited_visitor vis(test_sbastar_visitor(space, goal, 300, counter, expand_mutex,
+                                                        expanding, double_expansions, expansions), g);
+
+  boost::vector_property_map<double> key_map;
+
+  graph::generate_parallel_sbastar(
+    graph::make_sbastar_bundle(g, start, space, vis,
+      graph::fixed_neighborhood< pp::linear_neighbor_search< test_graph > >(
+        pp::linear_neighbor_search< test_graph >(), 5, 2.0 * test_step),
+      key_map,
+      test_position_map(&test_vertex_prop::position),
+      boost::data_member_property_map< double, test_edge_prop >(&test_edge_prop::weight),
+      boost::data_member_property_map< double, test_vertex_prop >(&test_vertex_prop::density),
+      boost::data_member_property_map< double, test_vertex_prop >(&test_vertex_prop::constriction),
+      boost::data_member_property_map< double, test_vertex_prop >(&test_vertex_prop::distance_accum),
+      boost::data_member_property_map< std::size_t, test_vertex_prop >(&test_vertex_prop::predecessor),
+      boost::data_member_property_map< double, test_vertex_prop >(&test_vertex_prop::heuristic_value)), 4);
+
+  BOOST_CHECK( num_vertices(g) >= 300 );
+  BOOST_CHECK( expansions + 1 >= num_vertices(g) );
+  BOOST_CHECK_EQUAL( double_expansions, 0 );
+  BOOST_CHECK_EQUAL( counter.m_overlaps, 0 );
+
+  // all the vertices must have a valid predecessor, and an accumulated distance consistent with it.
+  test_graph::vertex_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    if(*vi == start)
+      continue;
+    std::size_t pred = g[*vi].predecessor;
+    BOOST_CHECK( pred != boost::graph_traits<test_graph>::null_vertex() );
+    if(pred == boost::graph_traits<test_graph>::null_vertex())
+      continue;
+    double d = norm_2(g[*vi].position - g[pred].position);
+    BOOST_CHECK( g[*vi].distance_accum <= g[pred].distance_accum + d + 1e-8 );
+  };
+};
+
+
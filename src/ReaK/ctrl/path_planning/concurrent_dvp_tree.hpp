@@ -0,0 +1,392 @@
+/**
+ * \file concurrent_dvp_tree.hpp
+ *
+ * This library provides a class that wraps a Dynamic Vantage-Point Tree (DVP-Tree) such that
+ * insertions and nearest-neighbor queries can be performed concurrently from several threads.
+ * Insertions are first recorded in a small write-buffer (only guarded by a light-weight mutex)
+ * and are periodically flushed into the DVP-tree in small chunks, each under the exclusive ownership
+ * of a reader-writer lock. Queries hold the shared ownership of that lock and merge the results
+ * of the DVP-tree search with a linear scan of the write-buffer.
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_CONCURRENT_DVP_TREE_HPP
+#define REAK_CONCURRENT_DVP_TREE_HPP
+
+#include <ReaK/core/base/thread_incl.hpp>
+#include <ReaK/core/base/shared_mutex.hpp>
+
+#include <ReaK/ctrl/topologies/metric_space_concept.hpp>
+#include <ReaK/ctrl/topologies/proper_metric_concept.hpp>
+
+#include "metric_space_search.hpp"
+
+#include <utility>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+
+namespace ReaK {
+
+namespace pp {
+
+
+/**
+ * This class implements a Dynamic Vantage-Point Tree (DVP-Tree) which supports concurrent
+ * insertions and nearest-neighbor queries (reader-writer semantics). The inserted vertices are
+ * first recorded (with a copy of their position) into a write-buffer which is shared by all threads,
+ * and which is flushed into the underlying DVP-tree (see dvp_tree) once it reaches a given size.
+ * Only the flushing (and erasures) require the exclusive ownership of the tree, such that
+ * sampler threads rarely block the threads performing queries, and vice versa.
+ * \note The position-map must support concurrent reads (e.g., the storage of the vertices
+ *       must not be re-allocated while this DVP-tree is being used).
+ * \tparam Key The key type for the tree, essentially the key value is the vertex descriptor type.
+ * \tparam Topology The topology type on which the points can reside, should model the MetricSpaceConcept.
+ * \tparam PositionMap The property-map type that can map the vertex descriptors (which should be the value-type of the iterators) to a point (position).
+ * \tparam Arity The arity of the tree, e.g., 2 means a binary-tree.
+ * \tparam VPChooser The functor type to use to choose the vantage-point out of a set of vertices.
+ */
+template <typename Key,
+          typename Topology,
+          typename PositionMap,
+          unsigned int Arity = 2,
+          typename VPChooser = random_vp_chooser,
+          typename TreeStorageTag = boost::bfl_d_ary_tree_storage<Arity>,
+          typename PositionCachingPolicy = position_caching_policy>
+class concurrent_dvp_tree
+{
+  public:
+    BOOST_CONCEPT_ASSERT((MetricSpaceConcept<Topology>));
+
+    typedef concurrent_dvp_tree<Key, Topology, PositionMap, Arity, VPChooser, TreeStorageTag, PositionCachingPolicy> self;
+    typedef dvp_tree<Key, Topology, PositionMap, Arity, VPChooser, TreeStorageTag, PositionCachingPolicy> tree_type;
+
+    typedef typename boost::property_traits<PositionMap>::value_type point_type;
+    typedef double distance_type;
+
+  private:
+
+    typedef typename get_proper_metric<Topology>::type proper_metric_type;
+    typedef std::pair< distance_type, Key > candidate_type;
+
+    struct candidate_compare {
+      bool operator()(const candidate_type& x, const candidate_type& y) const {
+        return (x.first < y.first);
+      };
+    };
+
+    shared_ptr<const Topology> m_space;
+    proper_metric_type m_distance;
+    PositionMap m_position;
+    std::size_t m_max_pending;
+    std::size_t m_flush_chunk;  ///< The maximum number of insertions flushed per exclusive ownership of m_tree_mutex.
+
+    tree_type m_tree;
+    mutable shared_mutex m_tree_mutex;  ///< Guards the DVP-tree (shared for queries, exclusive for flushes and erasures).
+
+    std::vector< std::pair< Key, point_type > > m_pending;  ///< Write-buffer of inserted vertices (with cached positions).
+    mutable ReaKaux::mutex m_pending_mutex;  ///< Guards the write-buffer (always locked after m_tree_mutex, if both are needed).
+
+    // non-copyable:
+    concurrent_dvp_tree(const self&);
+    self& operator=(const self&);
+
+    /* Moves at most aMaxCount of the buffered insertions into the DVP-tree, holding the exclusive
+     * ownership of m_tree_mutex only for that chunk. Returns the number of vertices moved. */
+    std::size_t flush_pending_chunk(std::size_t aMaxCount) {
+      ReaKaux::unique_lock< shared_mutex > tree_lock(m_tree_mutex);
+      std::vector< Key > keys;
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+        std::size_t n = std::min(aMaxCount, m_pending.size());
+        keys.reserve(n);
+        // take from the back of the write-buffer, such that removing the chunk is cheap.
+        typename std::vector< std::pair< Key, point_type > >::iterator it_first = m_pending.end() - n;
+        for(typename std::vector< std::pair< Key, point_type > >::iterator it = it_first; it != m_pending.end(); ++it)
+          keys.push_back(it->first);
+        m_pending.erase(it_first, m_pending.end());
+      };
+      m_tree.insert(keys.begin(), keys.end());
+      return keys.size();
+    };
+
+    /* Collects the candidates from the write-buffer, m_tree_mutex must be owned (shared) by the caller. */
+    void collect_pending_candidates(const point_type& aPoint, distance_type R, std::vector< candidate_type >& aCandidates) const {
+      ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+      for(typename std::vector< std::pair< Key, point_type > >::const_iterator it = m_pending.begin(); it != m_pending.end(); ++it) {
+        distance_type d = m_distance(aPoint, it->second, *m_space);
+        if(d < R)
+          aCandidates.push_back(candidate_type(d, it->first));
+      };
+    };
+
+    /* Computes the candidates from a list of vertices found in the DVP-tree. */
+    void collect_tree_candidates(const point_type& aPoint, const std::vector< Key >& aTreeResults, std::vector< candidate_type >& aCandidates) const {
+      for(typename std::vector< Key >::const_iterator it = aTreeResults.begin(); it != aTreeResults.end(); ++it)
+        aCandidates.push_back(candidate_type(m_distance(aPoint, get(m_position, *it), *m_space), *it));
+    };
+
+  public:
+
+    /**
+     * Construct the concurrent DVP-tree from a graph, topology and property-map.
+     * \tparam Graph The graph type on which the vertices are taken from, should model the boost::VertexListGraphConcept.
+     * \param g The graph from which to take the initial vertices.
+     * \param aSpace The topology on which the positions of the vertices reside.
+     * \param aPosition The property-map that can be used to obtain the positions of the vertices.
+     * \param aMaxPending The number of buffered insertions that triggers a flush into the DVP-tree.
+     * \param aVPChooser The vantage-point chooser functor (policy class).
+     */
+    template <typename Graph>
+    concurrent_dvp_tree(const Graph& g,
+                        const shared_ptr<const Topology>& aSpace,
+                        PositionMap aPosition,
+                        std::size_t aMaxPending = 64,
+                        VPChooser aVPChooser = VPChooser()) :
+                        m_space(aSpace), m_distance(get(proper_metric, *aSpace)),
+                        m_position(aPosition), m_max_pending(aMaxPending), m_flush_chunk(8),
+                        m_tree(g, aSpace, aPosition, aVPChooser) { };
+
+    /**
+     * Construct the concurrent DVP-tree from a range, topology and property-map.
+     * \tparam ForwardIterator The forward-iterator type from which the vertices can be obtained.
+     * \param aBegin The start of the range from which to take the initial vertices.
+     * \param aEnd The end of the range from which to take the initial vertices (one-past-last).
+     * \param aSpace The topology on which the positions of the vertices reside.
+     * \param aPosition The property-map that can be used to obtain the positions of the vertices.
+     * \param aMaxPending The number of buffered insertions that triggers a flush into the DVP-tree.
+     * \param aVPChooser The vantage-point chooser functor (policy class).
+     */
+    template <typename ForwardIterator>
+    concurrent_dvp_tree(ForwardIterator aBegin,
+                        ForwardIterator aEnd,
+                        const shared_ptr<const Topology>& aSpace,
+                        PositionMap aPosition,
+                        std::size_t aMaxPending = 64,
+                        VPChooser aVPChooser = VPChooser()) :
+                        m_space(aSpace), m_distance(get(proper_metric, *aSpace)),
+                        m_position(aPosition), m_max_pending(aMaxPending), m_flush_chunk(8),
+                        m_tree(aBegin, aEnd, aSpace, aPosition, aVPChooser) { };
+
+    /**
+     * Checks if the DVP-tree is empty.
+     * \return True if the DVP-tree is empty.
+     */
+    bool empty() const { return (size() == 0); };
+
+    /**
+     * Returns the size of the DVP-tree (the number of vertices it contains, including buffered insertions).
+     * \return The size of the DVP-tree.
+     */
+    std::size_t size() const {
+      shared_lock_guard< shared_mutex > tree_lock(m_tree_mutex);
+      ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+      return m_tree.size() + m_pending.size();
+    };
+
+    /**
+     * Sets the approximation parameters of the nearest-neighbor queries (see dvp_tree_impl::set_approximation).
+     * \param aEpsilon The relative error allowed on the distances to the nearest-neighbors.
+     * \param aMaxVisits The maximum number of nodes visited by a query (0: no limit).
+     */
+    void set_approximation(double aEpsilon, std::size_t aMaxVisits = 0) {
+      ReaKaux::unique_lock< shared_mutex > tree_lock(m_tree_mutex);
+      m_tree.set_approximation(aEpsilon, aMaxVisits);
+    };
+
+    /**
+     * Inserts a key-value (vertex). This function can be called concurrently with
+     * any other function of this class.
+     * \param u The vertex to be added to the DVP-tree.
+     */
+    void insert(Key u) {
+      point_type u_pt = get(m_position, u);
+      bool needs_flush = false;
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+        m_pending.push_back(std::pair< Key, point_type >(u, u_pt));
+        needs_flush = (m_pending.size() >= m_max_pending);
+      };
+      if(needs_flush)
+        flush();
+    };
+
+    /**
+     * Inserts a range of key-values (vertices).
+     * \tparam ForwardIterator A forward-iterator type that can be used to obtain the vertices.
+     * \param aBegin The start of the range from which to take the vertices.
+     * \param aEnd The end of the range from which to take the vertices (one-past-last).
+     */
+    template <typename ForwardIterator>
+    void insert(ForwardIterator aBegin, ForwardIterator aEnd) {
+      for(; aBegin != aEnd; ++aBegin)
+        insert(*aBegin);
+    };
+
+    /**
+     * Sets the number of buffered insertions that are moved into the DVP-tree each time the 
+     * exclusive ownership of the tree is acquired during a flush. Smaller chunks bound the time 
+     * during which the queries are blocked by a flush, at the expense of more locking.
+     * \param aFlushChunk The maximum number of insertions flushed per exclusive lock (at least 1).
+     */
+    void set_flush_chunk_size(std::size_t aFlushChunk) {
+      ReaKaux::unique_lock< shared_mutex > tree_lock(m_tree_mutex);
+      m_flush_chunk = (aFlushChunk > 0 ? aFlushChunk : 1);
+    };
+
+    /**
+     * Flushes the buffered insertions into the DVP-tree, in chunks (see set_flush_chunk_size), 
+     * releasing the exclusive ownership of the tree between chunks such that concurrent queries 
+     * can proceed. Only the insertions buffered before the call are guaranteed to be flushed.
+     */
+    void flush() {
+      std::size_t remaining = 0;
+      std::size_t chunk = 0;
+      {
+        shared_lock_guard< shared_mutex > tree_lock(m_tree_mutex);
+        ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+        remaining = m_pending.size();
+        chunk = m_flush_chunk;
+      };
+      while(remaining > 0) {
+        std::size_t moved = flush_pending_chunk(std::min(chunk, remaining));
+        if(moved == 0)
+          break;
+        remaining -= moved;
+      };
+    };
+
+    /**
+     * Erases the given vertex from the DVP-tree.
+     * \param u The vertex to be removed from the DVP-tree.
+     */
+    void erase(Key u) {
+      ReaKaux::unique_lock< shared_mutex > tree_lock(m_tree_mutex);
+      {
+        ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+        for(typename std::vector< std::pair< Key, point_type > >::iterator it = m_pending.begin(); it != m_pending.end(); ++it) {
+          if(it->first == u) {
+            m_pending.erase(it);
+            return;
+          };
+        };
+      };
+      m_tree.erase(u);
+    };
+
+    /**
+     * Clears the DVP-tree.
+     */
+    void clear() {
+      ReaKaux::unique_lock< shared_mutex > tree_lock(m_tree_mutex);
+      ReaKaux::unique_lock< ReaKaux::mutex > pending_lock(m_pending_mutex);
+      m_pending.clear();
+      m_tree.clear();
+    };
+
+    /**
+     * Finds the nearest neighbor to a given position.
+     * \param aPoint The position from which to find the nearest-neighbor of.
+     * \return The vertex in the DVP-tree that is closest to the given point.
+     */
+    Key find_nearest(const point_type& aPoint) const {
+      std::vector< Key > result;
+      find_nearest(aPoint, std::back_inserter(result), 1);
+      if(result.size())
+        return result.front();
+      else
+        return Key();
+    };
+
+    /**
+     * Finds the K nearest-neighbors to a given position.
+     * \tparam OutputIterator The forward- output-iterator type which can contain the
+     *         list of nearest-neighbors.
+     * \param aPoint The position from which to find the nearest-neighbors.
+     * \param aOutputBegin An iterator to the first place where to put the sorted list of
+     *        elements with the smallest distance.
+     * \param K The number of nearest-neighbors.
+     * \param R The maximum distance value for the nearest-neighbors.
+     * \return The output-iterator to the end of the list of nearest neighbors (starting from "output_first").
+     */
+    template <typename OutputIterator>
+    OutputIterator find_nearest(const point_type& aPoint, OutputIterator aOutputBegin, std::size_t K, distance_type R = std::numeric_limits<distance_type>::infinity()) const {
+      std::vector< candidate_type > candidates;
+      {
+        shared_lock_guard< shared_mutex > tree_lock(m_tree_mutex);
+        std::vector< Key > tree_results;
+        m_tree.find_nearest(aPoint, std::back_inserter(tree_results), K, R);
+        collect_tree_candidates(aPoint, tree_results, candidates);
+        collect_pending_candidates(aPoint, R, candidates);
+      };
+      if(candidates.size() > K) {
+        std::partial_sort(candidates.begin(), candidates.begin() + K, candidates.end(), candidate_compare());
+        candidates.resize(K);
+      } else
+        std::sort(candidates.begin(), candidates.end(), candidate_compare());
+      for(typename std::vector< candidate_type >::iterator it = candidates.begin(); it != candidates.end(); ++it)
+        *(aOutputBegin++) = it->second;
+      return aOutputBegin;
+    };
+
+    /**
+     * Finds the nearest-neighbors to a given position within a given range (radius).
+     * \tparam OutputIterator The forward- output-iterator type which can contain the
+     *         list of nearest-neighbors.
+     * \param aPoint The position from which to find the nearest-neighbors.
+     * \param aOutputBegin An iterator to the first place where to put the sorted list of
+     *        elements with the smallest distance.
+     * \param R The maximum distance value for the nearest-neighbors.
+     * \return The output-iterator to the end of the list of nearest neighbors (starting from "output_first").
+     */
+    template <typename OutputIterator>
+    OutputIterator find_in_range(const point_type& aPoint, OutputIterator aOutputBegin, distance_type R) const {
+      std::vector< candidate_type > candidates;
+      {
+        shared_lock_guard< shared_mutex > tree_lock(m_tree_mutex);
+        std::vector< Key > tree_results;
+        m_tree.find_in_range(aPoint, std::back_inserter(tree_results), R);
+        collect_tree_candidates(aPoint, tree_results, candidates);
+        collect_pending_candidates(aPoint, R, candidates);
+      };
+      std::sort(candidates.begin(), candidates.end(), candidate_compare());
+      for(typename std::vector< candidate_type >::iterator it = candidates.begin(); it != candidates.end(); ++it)
+        *(aOutputBegin++) = it->second;
+      return aOutputBegin;
+    };
+
+};
+
+
+};
+
+};
+
+
+#endif
+
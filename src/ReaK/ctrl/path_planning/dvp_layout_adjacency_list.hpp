@@ -45,6 +45,8 @@
 #include <boost/property_map/property_map.hpp>
 #include <boost/graph/properties.hpp>
 
+#include <boost/static_assert.hpp>
+
 #include <utility>  // for pair and move
 #include <vector>   // for vector
 #include <limits>   // for numeric_limits
@@ -86,6 +88,9 @@ namespace pp {
  * \tparam OutEdgeListS The out-edge list container specifier for the adjacency-list (same as OutEdgeListS in boost::adjacency_list_BC).
  * \tparam DirectedS The edge's directional specifier for the adjacency-list (same as DirectedS in boost::adjacency_list_BC).
  * \tparam EdgeListS The edge list container specifier for the adjacency-list (same as EdgeListS in boost::adjacency_list_BC).
+ * \tparam PositionStorage The policy for the storage of the positions used by the nearest-neighbor searches, 
+ *         either dvp_inline_positions (read from the vertex bundles) or dvp_packed_positions (a separate packed 
+ *         array of whole points indexed by tree slot, which requires a tree storage with stable slots, see dvp_has_stable_tree_slots).
  */
 template <typename VertexProperty,
           typename EdgeProperty,
@@ -96,14 +101,16 @@ template <typename VertexProperty,
           typename TreeStorageTag = boost::bfl_d_ary_tree_storage<Arity>,
           typename OutEdgeListS = boost::vecBC,
           typename DirectedS = boost::directedS,
-          typename EdgeListS = boost::vecBC >
+          typename EdgeListS = boost::vecBC,
+          typename PositionStorage = dvp_inline_positions >
 class dvp_adjacency_list
 {
   public:
     BOOST_CONCEPT_ASSERT((MetricSpaceConcept<Topology>));
+    BOOST_STATIC_ASSERT((dvp_is_position_storage_supported<PositionStorage, TreeStorageTag>::value));
     
     typedef dvp_adjacency_list<VertexProperty, EdgeProperty, Topology, PositionMap,
-                               Arity, VPChooser, TreeStorageTag, OutEdgeListS, DirectedS, EdgeListS> self;
+                               Arity, VPChooser, TreeStorageTag, OutEdgeListS, DirectedS, EdgeListS, PositionStorage> self;
     
     typedef typename topology_traits<Topology>::point_type point_type;
     typedef typename topology_traits<Topology>::point_difference_type point_difference_type;
@@ -143,7 +150,8 @@ class dvp_adjacency_list
       distance_map_type,
       position_map_type,
       Arity,
-      VPChooser> dvp_impl_type;
+      VPChooser,
+      PositionStorage> dvp_impl_type;
       
     typedef typename dvp_impl_type::mutation_visitor dvp_visitor_type;
     
@@ -255,6 +263,29 @@ class dvp_adjacency_list
      */
     double get_characteristic_size() const { return m_impl.get_characteristic_size(); };
     
+    /**
+     * Sets the approximation parameters of the nearest-neighbor queries (see dvp_tree_impl::set_approximation).
+     * \param aEpsilon The relative error allowed on the distances to the nearest-neighbors.
+     * \param aMaxVisits The maximum number of nodes visited by a query (0: no limit).
+     */
+    void set_approximation(double aEpsilon, std::size_t aMaxVisits = 0) { m_impl.set_approximation(aEpsilon, aMaxVisits); };
+    
+    /**
+     * Sets the maximum size of the sub-trees that can be reconstructed by a single insertion (see dvp_tree_impl::set_max_rebuild_size).
+     * \param aMaxRebuildSize The maximum number of vertices in a reconstructed sub-tree (0: no limit, the default).
+     */
+    void set_max_rebuild_size(std::size_t aMaxRebuildSize) { m_impl.set_max_rebuild_size(aMaxRebuildSize); };
+    
+    /**
+     * Returns the maximum size of the sub-trees that can be reconstructed by a single insertion (0: no limit).
+     */
+    std::size_t get_max_rebuild_size() const { return m_impl.get_max_rebuild_size(); };
+    
+    /**
+     * Reconstructs the entire tree such that it is balanced (see dvp_tree_impl::rebalance).
+     */
+    void rebalance() { m_impl.rebalance(); };
+    
     
     /**
      * Finds the nearest neighbor to a given position.
@@ -42,27 +42,31 @@
 #include <ReaK/ctrl/topologies/proper_metric_concept.hpp>
 
 #include <ReaK/core/base/global_rng.hpp>
+#include <ReaK/core/base/thread_pool.hpp>
 
 // BGL-Extra includes:
 #include <boost/graph/tree_traits.hpp>
 #include <boost/graph/tree_adaptor.hpp>
+#include <boost/graph/bfl_d_ary_tree.hpp>
 
 // Pending inclusion in BGL-Extra:
 #include <ReaK/ctrl/graph_alg/bgl_raw_property_graph.hpp>
 
 
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/if.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
 #include <vector>
-#include <stack>
 #include <queue>
+#include <map>
 #include <cmath>
 #include <utility>
 #include <functional>
 #include <algorithm>
+#include <stdexcept>
 
 
 namespace ReaK {
@@ -176,6 +180,102 @@ namespace detail {
 };
 
 
+/**
+ * This class is the default position-storage policy for the DVP-tree implementation. The positions 
+ * of the vantage-points are read from the vertex-properties stored in the tree (through the position-map).
+ */
+struct dvp_inline_positions {
+  
+  template <typename Vertex, typename Point>
+  struct cache {
+    template <typename Tree, typename PositionMap>
+    void record(Vertex, const Tree&, const PositionMap&) { };
+    const Point* find(Vertex) const { return NULL; };
+    void clear() { };
+  };
+  
+};
+
+/**
+ * This class is a position-storage policy for the DVP-tree implementation which keeps a copy of 
+ * the positions of the vantage-points in a packed array indexed by the tree vertex (slot), separate 
+ * from the vertex-properties stored in the tree. The nearest-neighbor searches then only touch 
+ * the positions and the edge distances, instead of dragging the whole vertex-properties through the cache.
+ * \note This requires a tree storage whose vertex descriptors are indices that do not change 
+ *       when other vertices are added or removed (e.g., the breadth-first layout, boost::bfl_d_ary_tree_storage), 
+ *       see dvp_has_stable_tree_slots. Other layouts (e.g., the cache-oblivious layout) are rejected at compile-time.
+ * \note The positions are copied when the vertices are added to the tree, and therefore, the position of 
+ *       a vertex should not be modified while it is in the tree (which is already required by the DVP-tree structure).
+ * \note The positions are packed as whole points (array-of-structures), not split per coordinate, because 
+ *       the searches evaluate the distance metric on one whole vantage-point at a time, and the distance 
+ *       metrics take points (not coordinate spans). For points with inline coordinates (e.g., vect<double,N>), 
+ *       this is the same memory layout as a flat array of coordinates with a stride of N. For points that own 
+ *       a heap buffer (e.g., vect_n<double>), each packed point still refers to its own buffer, and this 
+ *       policy then only saves the reads of the other members of the vertex-properties.
+ */
+struct dvp_packed_positions {
+  
+  template <typename Vertex, typename Point>
+  class cache {
+    private:
+      std::vector<Point> m_positions;
+    public:
+      template <typename Tree, typename PositionMap>
+      void record(Vertex v, const Tree& aTree, const PositionMap& aPosition) {
+        std::size_t i = static_cast<std::size_t>(v);
+        if(i >= m_positions.size())
+          m_positions.resize(2 * i + 1);
+        m_positions[i] = get(aPosition, get_raw_vertex_property(aTree, v));
+      };
+      const Point* find(Vertex v) const { return &m_positions[static_cast<std::size_t>(v)]; };
+      void clear() { m_positions.clear(); };
+  };
+  
+};
+
+/**
+ * This traits class tells if a tree-storage tag produces trees whose vertex descriptors are 
+ * stable indices, as required by the dvp_packed_positions policy.
+ * \tparam TreeStorageTag The tree-storage tag.
+ */
+template <typename TreeStorageTag>
+struct dvp_has_stable_tree_slots : boost::mpl::false_ { };
+
+template <std::size_t Arity>
+struct dvp_has_stable_tree_slots< boost::bfl_d_ary_tree_storage<Arity> > : boost::mpl::true_ { };
+
+/**
+ * This traits class tells if a position-storage policy can be used with a tree-storage tag.
+ * \tparam PositionStorage The position-storage policy (dvp_inline_positions or dvp_packed_positions).
+ * \tparam TreeStorageTag The tree-storage tag.
+ */
+template <typename PositionStorage, typename TreeStorageTag>
+struct dvp_is_position_storage_supported : boost::mpl::true_ { };
+
+template <typename TreeStorageTag>
+struct dvp_is_position_storage_supported< dvp_packed_positions, TreeStorageTag > : dvp_has_stable_tree_slots<TreeStorageTag> { };
+
+
+
+/**
+ * This class template is a flat record of one node of a DVP-tree layout, as exported 
+ * (in pre-order) by the dvp_tree_impl::export_layout function and as consumed by the 
+ * dvp_tree_impl::import_layout function. A sequence of such records is sufficient to 
+ * re-create a DVP-tree without recomputing any of its vantage-point partitions.
+ * \tparam Key The key type that identifies the entries of the DVP-tree.
+ * \tparam DistanceValue The distance type used to store the partition radii (mu-values).
+ */
+template <typename Key, typename DistanceValue>
+struct dvp_tree_layout_record {
+  Key key;                  ///< The key of the entry stored at this node.
+  std::size_t child_count;  ///< The number of children of this node.
+  DistanceValue mu;         ///< The mu-value of the edge from the parent to this node (ignored for the root).
+  
+  dvp_tree_layout_record() : key(), child_count(0), mu(0) { };
+  dvp_tree_layout_record(const Key& aKey, std::size_t aChildCount, DistanceValue aMu) : 
+                         key(aKey), child_count(aChildCount), mu(aMu) { };
+};
+
 
 /**
  * This class implements a Dynamic Vantage-Point Tree (DVP-Tree) that
@@ -189,6 +289,7 @@ namespace detail {
  * \tparam PositionMap The property-map type that can map vertex properties of the tree to associated position values (positions in the topology).
  * \tparam Arity The arity of the tree, e.g., 2 means a binary-tree.
  * \tparam VPChooser The functor type to use to choose the vantage-point out of a set of vertices.
+ * \tparam PositionStorage The policy for the storage of the vantage-point positions used during the searches (dvp_inline_positions or dvp_packed_positions).
  */
 template <typename TreeType,
           typename Topology,
@@ -196,12 +297,13 @@ template <typename TreeType,
           typename DistanceMap,
           typename PositionMap,
           unsigned int Arity,
-          typename VPChooser>
+          typename VPChooser,
+          typename PositionStorage = dvp_inline_positions>
 class dvp_tree_impl
 {
   public:
     
-    typedef dvp_tree_impl<TreeType, Topology, VertexKeyMap, DistanceMap, PositionMap, Arity, VPChooser> self;
+    typedef dvp_tree_impl<TreeType, Topology, VertexKeyMap, DistanceMap, PositionMap, Arity, VPChooser, PositionStorage> self;
     
     /** Type of the points in the topology. */ 
     typedef typename boost::property_traits<PositionMap>::value_type point_type;
@@ -221,6 +323,11 @@ class dvp_tree_impl
       double proper_distance(const point_type& a, const point_type& b) const {
         return m_distance(a, b, *p_space);
       };
+      template <typename ForwardIter, typename OutputIter>
+      OutputIter proper_distances(const point_type& a, ForwardIter first, ForwardIter last, 
+                                  PositionMap pos, OutputIter out) const {
+        return get_distances(m_distance, a, first, last, pos, out, *p_space);
+      };
       double operator()(const point_type& a, const point_type& b) const {
         return proper_distance(a, b, *p_space);
       };
@@ -239,6 +346,11 @@ class dvp_tree_impl
       double proper_distance(const point_type& a, const point_type& b) const {
         return m_proper_distance(a, b, *p_space);
       };
+      template <typename ForwardIter, typename OutputIter>
+      OutputIter proper_distances(const point_type& a, ForwardIter first, ForwardIter last, 
+                                  PositionMap pos, OutputIter out) const {
+        return get_distances(m_proper_distance, a, first, last, pos, out, *p_space);
+      };
       double operator()(const point_type& a, const point_type& b) const {
         return proper_distance(a, b, *p_space);
       };
@@ -269,12 +381,15 @@ class dvp_tree_impl
     typedef typename tree_indexer::vertex_property_type vertex_property;
     typedef typename tree_indexer::edge_property_type edge_property;
     
+    typedef typename PositionStorage::template cache<vertex_type, point_type> position_cache_type;
+    
     struct priority_compare_type {
       bool operator()(const std::pair<distance_type, vertex_type>& x, const std::pair<distance_type, vertex_type>& y) const {
         return (x.first < y.first);
       };
     };
     typedef std::vector< std::pair< distance_type, vertex_type > > priority_queue_type;
+    typedef std::vector< std::pair< vertex_type, distance_type > > search_task_stack;
     
     
     
@@ -318,6 +433,13 @@ class dvp_tree_impl
     
     VPChooser m_vp_chooser;  ///< The vantage-point chooser (functor).
     
+    position_cache_type m_vp_positions;  ///< The storage of vantage-point positions used by the searches.
+    
+    distance_type m_approx_epsilon;   ///< The relative error allowed in approximate nearest-neighbor queries.
+    std::size_t m_approx_max_visits;  ///< The maximum number of nodes visited in approximate nearest-neighbor queries (0: no limit).
+    
+    std::size_t m_max_rebuild_size;   ///< The maximum size of the sub-trees that are reconstructed by a single insertion (0: no limit).
+    
     //non-copyable.
     dvp_tree_impl(const self&);
     self& operator=(const self&); 
@@ -350,6 +472,32 @@ class dvp_tree_impl
       return chosen_vp_it;
     };
     
+    void record_vp_position(vertex_type aNode) {
+      m_vp_positions.record(aNode, *m_tree, m_position);
+    };
+    
+    distance_type distance_to_vp(const point_type& aPoint, vertex_type aNode) const {
+      const point_type* packed_vp = m_vp_positions.find(aNode);
+      if(packed_vp)
+        return m_distance.proper_distance(aPoint, *packed_vp);
+      return m_distance.proper_distance(aPoint, get(m_position, get_raw_vertex_property(*m_tree, aNode)));
+    };
+    
+    /* NOTE Invalidates vertices */
+    /* This function constructs the entire tree from the vertices in the iterator range (the tree must be empty). */
+    void construct_root(prop_vector_iter aBegin, prop_vector_iter aEnd) {
+      if(aBegin == aEnd)
+        return;
+      rearrange_with_chosen_vp(aBegin, aEnd);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+      m_root = create_root(std::move(*aBegin), *m_tree);
+#else
+      m_root = create_root(*aBegin, *m_tree);
+#endif
+      record_vp_position(m_root);
+      construct_node(m_root, ++aBegin, aEnd);
+    };
+    
     
     /* NOTE Invalidates vertices */
     /* NOTE This is a non-recursive version of the construct-node algorithm */
@@ -360,6 +508,7 @@ class dvp_tree_impl
     void construct_node(vertex_type aNode, prop_vector_iter aBegin, prop_vector_iter aEnd) {
       
       temporary_dist_map_type dist_map;
+      std::vector<distance_type> dist_buffer;
       std::queue<construction_task> tasks;
       tasks.push(construction_task(aNode, aBegin, aEnd));
       
@@ -369,8 +518,11 @@ class dvp_tree_impl
         // update values in the dist-map with the distances to the new chosen vantage-point:
         {
           const point_type& chosen_vp_pt = get(m_position, get_raw_vertex_property(*m_tree, cur_task.node));
-          for(prop_vector_iter it = cur_task.first; it != cur_task.last; ++it)
-            dist_map[ get(m_key, *it) ] = m_distance.proper_distance(chosen_vp_pt, get(m_position, *it));
+          dist_buffer.resize(cur_task.last - cur_task.first);
+          m_distance.proper_distances(chosen_vp_pt, cur_task.first, cur_task.last, m_position, dist_buffer.begin());
+          typename std::vector<distance_type>::iterator dist_it = dist_buffer.begin();
+          for(prop_vector_iter it = cur_task.first; it != cur_task.last; ++it, ++dist_it)
+            dist_map[ get(m_key, *it) ] = *dist_it;
         };
         
         // this loop splits up the children into as equal as possible partitions.
@@ -396,6 +548,7 @@ class dvp_tree_impl
 #else
             add_child_vertex(cur_task.node, *temp, ep, *m_tree);
 #endif
+          record_vp_position(new_vp_node);
           ++temp;
           if(temp != cur_task.first)
             tasks.push(construction_task(new_vp_node, temp, cur_task.first));
@@ -413,6 +566,13 @@ class dvp_tree_impl
       
       nearest_search_result_set(std::size_t aK, distance_type aRadius) : Neighbors(), K(aK), Radius(aRadius) { };
       
+      // re-initializes the result-set for a new query, keeping the memory already allocated.
+      void reset(std::size_t aK, distance_type aRadius) {
+        Neighbors.clear();
+        K = aK;
+        Radius = aRadius;
+      };
+      
       void register_vantage_point(const point_type&, const point_type&,
                                   distance_type current_dist, vertex_type current_vp, const parting_metrics_type&) {
         
@@ -488,20 +648,23 @@ class dvp_tree_impl
     /* NOTE This is a non-recursive version. */
     /* This is the main nearest-neighbor query function. This takes a query point, a maximum 
      * neighborhood radius (aSigma), aNode to start recursing from, the current max-heap of neighbors,
-     * and the maximum number of neighbors. This function can be used for any kind of NN query (single, kNN, or ranged). */
+     * and the maximum number of neighbors. This function can be used for any kind of NN query (single, kNN, or ranged). 
+     * The task stacks are scratch buffers which can be re-used from one query to the next (e.g., one per thread). */
     template <typename SearchResultSet>
-    void find_nearest_impl(const point_type& aPoint, SearchResultSet& aResult) const {
+    void find_nearest_impl(const point_type& aPoint, SearchResultSet& aResult, 
+                           search_task_stack& tasks, search_task_stack& temp_invtasks) const {
       
-      std::stack< std::pair<vertex_type, distance_type> > tasks;
-      tasks.push(std::pair<vertex_type, distance_type>(m_root,0.0));
+      tasks.clear();
+      tasks.push_back(std::pair<vertex_type, distance_type>(m_root,0.0));
       
       while(!tasks.empty()) {
-        std::pair<vertex_type, distance_type> cur_node = tasks.top(); tasks.pop();
+        std::pair<vertex_type, distance_type> cur_node = tasks.back(); tasks.pop_back();
         
         if( cur_node.second > aResult.Radius )
           continue;
         
-        const point_type& current_vp = get(m_position, get_raw_vertex_property(*m_tree,cur_node.first));
+        const point_type* packed_vp = m_vp_positions.find(cur_node.first);
+        const point_type& current_vp = (packed_vp ? *packed_vp : get(m_position, get_raw_vertex_property(*m_tree,cur_node.first)));
         distance_type current_dist = m_distance.proper_distance(aPoint, current_vp);
         
         aResult.register_vantage_point(aPoint, current_vp, current_dist, cur_node.first, m_distance);
@@ -517,9 +680,9 @@ class dvp_tree_impl
         if(ei == ei_end) 
           --ei; //back-track if the end was reached.
         
-        std::stack< std::pair<vertex_type, distance_type> > temp_invtasks;
+        temp_invtasks.clear();
         //search in the most likely node.
-        temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei,*m_tree),0.0));
+        temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei,*m_tree),0.0));
         
         out_edge_iter ei_left = ei;
         out_edge_iter ei_right = ei; ++ei_right;
@@ -532,7 +695,7 @@ class dvp_tree_impl
             distance_type temp_dist = 0.0;
             while((ei_right != ei_end) && 
                   ((temp_dist = get(m_mu,get_raw_edge_property(*m_tree,*ei_rightleft)) - current_dist) < aResult.Radius)) {
-              temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), temp_dist));
+              temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), temp_dist));
               ++ei_rightleft; ++ei_right;
             };
             break;
@@ -541,7 +704,7 @@ class dvp_tree_impl
             distance_type temp_dist = 0.0;
             while((ei_left != ei) && 
                   ((temp_dist = current_dist - get(m_mu,get_raw_edge_property(*m_tree,*(--ei_leftleft)))) < aResult.Radius)) {
-              temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), temp_dist));
+              temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), temp_dist));
               --ei_left;
             };
             break;
@@ -552,10 +715,10 @@ class dvp_tree_impl
             distance_type d2 = get(m_mu,get_raw_edge_property(*m_tree,*ei_rightleft)); //less than 0 if ei_right should be searched.
             if(d1 + d2 > 2.0 * current_dist) { //this means that ei_leftleft's boundary is closer to aPoint.
               if(d1 + aResult.Radius - current_dist > 0) {
-                temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), current_dist - d1));
+                temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), current_dist - d1));
                 ei_left = ei_leftleft;
                 if(d2 - aResult.Radius - current_dist < 0) {
-                  temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), d2 - current_dist));
+                  temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), d2 - current_dist));
                   ++ei_right;
                 } else
                   right_stopped = true;
@@ -563,10 +726,10 @@ class dvp_tree_impl
                 break;
             } else {
               if(d2 - aResult.Radius - current_dist < 0) {
-                temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), d2 - current_dist));
+                temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_right,*m_tree), d2 - current_dist));
                 ++ei_right;
                 if(d1 + aResult.Radius - current_dist > 0) {
-                  temp_invtasks.push(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), current_dist - d1));
+                  temp_invtasks.push_back(std::pair<vertex_type, distance_type>(target(*ei_leftleft,*m_tree), current_dist - d1));
                   ei_left = ei_leftleft;
                 } else 
                   left_stopped = true;
@@ -580,12 +743,100 @@ class dvp_tree_impl
         
         // reverse the temporary stack into the main stack.
         while(!temp_invtasks.empty()) {
-          tasks.push(temp_invtasks.top());
-          temp_invtasks.pop();
+          tasks.push_back(temp_invtasks.back());
+          temp_invtasks.pop_back();
+        };
+      };
+    };
+    
+    template <typename SearchResultSet>
+    void find_nearest_impl(const point_type& aPoint, SearchResultSet& aResult) const {
+      search_task_stack tasks;
+      search_task_stack temp_invtasks;
+      find_nearest_impl(aPoint, aResult, tasks, temp_invtasks);
+    };
+    
+    /* Orders the search tasks by increasing lower-bound distance (as a min-heap). */
+    struct task_bound_compare {
+      bool operator()(const std::pair<vertex_type, distance_type>& x, const std::pair<vertex_type, distance_type>& y) const {
+        return (x.second > y.second);
+      };
+    };
+    
+    /* Does not invalidate vertices */
+    /* Does not require persistent vertices */
+    /* NOTE This is a non-recursive version. */
+    /* This is the approximate nearest-neighbor query function. It does a best-bin-first search, i.e., 
+     * the nodes are visited in order of increasing lower-bound distance to the query point, and a node 
+     * is only visited if its lower-bound, inflated by (1 + epsilon), is within the current radius of 
+     * the result set. This guarantees that the neighbors found are within a factor (1 + epsilon) of 
+     * the true nearest-neighbors. The search also stops after visiting a maximum number of nodes (if not 0), 
+     * in which case no such guarantee holds. The task stack is a scratch buffer (used as a priority-queue). */
+    template <typename SearchResultSet>
+    void find_nearest_bbf_impl(const point_type& aPoint, SearchResultSet& aResult, 
+                               search_task_stack& tasks) const {
+      
+      const distance_type inflation = 1.0 + m_approx_epsilon;
+      std::size_t visit_count = 0;
+      
+      tasks.clear();
+      tasks.push_back(std::pair<vertex_type, distance_type>(m_root,0.0));
+      
+      while(!tasks.empty()) {
+        std::pop_heap(tasks.begin(), tasks.end(), task_bound_compare());
+        std::pair<vertex_type, distance_type> cur_node = tasks.back(); tasks.pop_back();
+        
+        // all the remaining nodes have a greater lower-bound:
+        if( cur_node.second * inflation > aResult.Radius )
+          break;
+        if( (m_approx_max_visits != 0) && (visit_count >= m_approx_max_visits) )
+          break;
+        ++visit_count;
+        
+        const point_type* packed_vp = m_vp_positions.find(cur_node.first);
+        const point_type& current_vp = (packed_vp ? *packed_vp : get(m_position, get_raw_vertex_property(*m_tree,cur_node.first)));
+        distance_type current_dist = m_distance.proper_distance(aPoint, current_vp);
+        
+        aResult.register_vantage_point(aPoint, current_vp, current_dist, cur_node.first, m_distance);
+        
+        // the children partition the points by their distance to the vantage-point, 
+        // between the previous child's mu-value and their own mu-value (see find_nearest_impl).
+        distance_type lower_mu = 0.0;
+        out_edge_iter ei,ei_end;
+        for(boost::tie(ei,ei_end) = out_edges(cur_node.first,*m_tree); ei != ei_end; ++ei) {
+          distance_type upper_mu = get(m_mu, get_raw_edge_property(*m_tree,*ei));
+          distance_type child_bound = cur_node.second;
+          if(child_bound < lower_mu - current_dist)
+            child_bound = lower_mu - current_dist;
+          out_edge_iter ei_next = ei; ++ei_next;
+          if((ei_next != ei_end) && (child_bound < current_dist - upper_mu))  // the last child is unbounded.
+            child_bound = current_dist - upper_mu;
+          if(child_bound * inflation <= aResult.Radius) {
+            tasks.push_back(std::pair<vertex_type, distance_type>(target(*ei,*m_tree), child_bound));
+            std::push_heap(tasks.begin(), tasks.end(), task_bound_compare());
+          };
+          lower_mu = upper_mu;
         };
       };
     };
     
+    /* This function dispatches a nearest-neighbor query to the exact or approximate search. */
+    template <typename SearchResultSet>
+    void find_knn_impl(const point_type& aPoint, SearchResultSet& aResult, 
+                       search_task_stack& tasks, search_task_stack& temp_invtasks) const {
+      if( (m_approx_epsilon > 0.0) || (m_approx_max_visits != 0) )
+        find_nearest_bbf_impl(aPoint, aResult, tasks);
+      else
+        find_nearest_impl(aPoint, aResult, tasks, temp_invtasks);
+    };
+    
+    template <typename SearchResultSet>
+    void find_knn_impl(const point_type& aPoint, SearchResultSet& aResult) const {
+      search_task_stack tasks;
+      search_task_stack temp_invtasks;
+      find_knn_impl(aPoint, aResult, tasks, temp_invtasks);
+    };
+    
     
     
     /* Does not invalidate vertices */
@@ -596,7 +847,7 @@ class dvp_tree_impl
     vertex_type get_leaf(const point_type& aPoint, vertex_type aNode) const {
       while(out_degree(aNode,*m_tree) != 0) {
         //first, locate the partition in which aPoint is:
-        distance_type current_dist = m_distance.proper_distance(aPoint, get(m_position, get_raw_vertex_property(*m_tree,aNode)));
+        distance_type current_dist = distance_to_vp(aPoint, aNode);
         vertex_type result = aNode;
         out_edge_iter ei,ei_end;
         for(boost::tie(ei,ei_end) = out_edges(aNode,*m_tree); ei != ei_end; ++ei) {
@@ -617,7 +868,7 @@ class dvp_tree_impl
       vertex_type aAlternateBranch = boost::graph_traits<tree_indexer>::null_vertex();
 //       std::cout << "\n ------ Looking for node " << aKey << " at position: " << aPoint << std::endl;
       while(get(m_key, get_raw_vertex_property(*m_tree,aNode)) != aKey) { 
-        distance_type current_dist = m_distance.proper_distance(aPoint, get(m_position, get_raw_vertex_property(*m_tree,aNode)));
+        distance_type current_dist = distance_to_vp(aPoint, aNode);
 //         std::cout << " ---- Looking at node " << get(m_key, get_raw_vertex_property(*m_tree,aNode)) 
 //                   << " at position: " << get(m_position, get_raw_vertex_property(*m_tree,aNode))
 //                   << " at distance " << current_dist << std::endl;
@@ -657,7 +908,7 @@ class dvp_tree_impl
     void update_mu_upwards(const point_type& aPoint, vertex_type aNode) {
       while(aNode != m_root) {
         vertex_type parent = source(*(in_edges(aNode,*m_tree).first), *m_tree);
-        distance_type dist = m_distance.proper_distance(aPoint, get(m_position, get_raw_vertex_property(*m_tree,parent)));
+        distance_type dist = distance_to_vp(aPoint, parent);
         if(dist > get(m_mu, get_raw_edge_property(*m_tree, *(in_edges(aNode,*m_tree).first))))
           put(m_mu, get_raw_edge_property(*m_tree, *(in_edges(aNode,*m_tree).first)), dist);
         aNode = parent;
@@ -712,6 +963,102 @@ class dvp_tree_impl
       return (depth_limit == 0);
     };
     
+    /* Does not invalidate vertices */
+    /* Does not require persistent vertices */
+    /* NOTE This is a non-recursive version. */
+    /* This function determines if the sub-tree rooted at a given node (inclusively) has more than 
+     * a given number of vertices. It stops as soon as the count exceeds the limit, i.e., it is O(aLimit). */
+    bool is_subtree_larger_than(vertex_type aNode, std::size_t aLimit) const {
+      std::size_t count = 0;
+      std::vector< vertex_type > tasks;
+      tasks.push_back(aNode);
+      while(!tasks.empty()) {
+        vertex_type cur_node = tasks.back(); tasks.pop_back();
+        if(++count > aLimit)
+          return true;
+        out_edge_iter ei,ei_end;
+        for(boost::tie(ei,ei_end) = out_edges(cur_node,*m_tree); ei != ei_end; ++ei)
+          tasks.push_back(target(*ei,*m_tree));
+      };
+      return false;
+    };
+    
+    /* Does not invalidate vertices */
+    /* Does not require persistent vertices */
+    /* NOTE This is a non-recursive version. */
+    /* This function computes the number of vertices and the depth of the sub-tree rooted at a given node 
+     * (inclusively). It stops as soon as the count exceeds the limit (returning a count of aLimit + 1), 
+     * i.e., it is O(aLimit). */
+    std::size_t get_bounded_subtree_size(vertex_type aNode, std::size_t aLimit, std::size_t& aDepth) const {
+      std::size_t count = 0;
+      aDepth = 0;
+      std::vector< std::pair< vertex_type, std::size_t > > tasks;
+      tasks.push_back(std::pair< vertex_type, std::size_t >(aNode, 1));
+      while(!tasks.empty()) {
+        std::pair< vertex_type, std::size_t > cur_task = tasks.back(); tasks.pop_back();
+        if(++count > aLimit)
+          return count;
+        if(cur_task.second > aDepth)
+          aDepth = cur_task.second;
+        out_edge_iter ei,ei_end;
+        for(boost::tie(ei,ei_end) = out_edges(cur_task.first,*m_tree); ei != ei_end; ++ei)
+          tasks.push_back(std::pair< vertex_type, std::size_t >(target(*ei,*m_tree), cur_task.second + 1));
+      };
+      return count;
+    };
+    
+    /* NOTE Invalidates vertices */
+    /* Does not require persistent vertices */
+    /* This function reconstructs the sub-tree below a given node (which remains the vantage-point of that sub-tree). */
+    void reconstruct_node(vertex_type aNode) {
+      std::vector<vertex_property> prop_list;
+      while( out_degree(aNode, *m_tree) > 0 ) {
+        edge_type e = *(out_edges(aNode, *m_tree).first);
+        remove_branch(target(e, *m_tree), back_inserter(prop_list), *m_tree);
+      };
+      construct_node(aNode, prop_list.begin(), prop_list.end());
+    };
+    
+    /* NOTE Invalidates vertices */
+    /* Does not require persistent vertices */
+    /* This function performs one bounded step of re-balancing after an insertion that expanded the leaf aNode 
+     * because the sub-tree that should have been reconstructed was larger than m_max_rebuild_size. It climbs 
+     * to the largest ancestor of aNode whose sub-tree has at most m_max_rebuild_size vertices, and reconstructs 
+     * it if it is deeper than a balanced tree of that size (by more than one level). Because the sub-tree 
+     * sizes are accumulated while climbing, this visits at most m_max_rebuild_size + Arity vertices. */
+    void rebalance_step(vertex_type aNode) {
+      std::size_t sub_depth = 0;
+      std::size_t sub_size = get_bounded_subtree_size(aNode, m_max_rebuild_size, sub_depth);
+      if(sub_size > m_max_rebuild_size)
+        return;
+      while(aNode != m_root) {
+        vertex_type parent = source(*(in_edges(aNode, *m_tree).first), *m_tree);
+        std::size_t p_size = 1 + sub_size;
+        std::size_t p_depth = sub_depth;
+        out_edge_iter ei,ei_end;
+        for(boost::tie(ei,ei_end) = out_edges(parent,*m_tree); (ei != ei_end) && (p_size <= m_max_rebuild_size); ++ei) {
+          vertex_type v = target(*ei,*m_tree);
+          if(v == aNode)
+            continue;
+          std::size_t v_depth = 0;
+          p_size += get_bounded_subtree_size(v, m_max_rebuild_size + 1 - p_size, v_depth);
+          if(v_depth > p_depth)
+            p_depth = v_depth;
+        };
+        if(p_size > m_max_rebuild_size)
+          break;
+        aNode = parent;
+        sub_size = p_size;
+        sub_depth = p_depth + 1;
+      };
+      // the depth of a balanced (complete) tree with sub_size vertices:
+      std::size_t balanced_depth = 0;
+      for(std::size_t level_count = 1, total_count = 0; total_count < sub_size; level_count *= Arity, ++balanced_depth)
+        total_count += level_count;
+      if(sub_depth > balanced_depth + 1)
+        reconstruct_node(aNode);
+    };
+    
     /* Does not invalidate vertices */
     /* Does not require persistent vertices */
     /* NOTE This is a non-recursive version. */
@@ -772,7 +1119,9 @@ class dvp_tree_impl
                   m_tree(&aTree), m_root(boost::graph_traits<tree_indexer>::null_vertex()), 
                   m_key(aKey), m_mu(aMu), m_position(aPosition),
                   m_distance(aSpace), 
-                  m_vp_chooser(aVPChooser) {
+                  m_vp_chooser(aVPChooser),
+                  m_approx_epsilon(0.0), m_approx_max_visits(0),
+                  m_max_rebuild_size(0) {
       
       if(num_vertices(g) == 0) return;
       
@@ -799,6 +1148,7 @@ class dvp_tree_impl
 #else
       m_root = create_root(*v_first, *m_tree);
 #endif
+      record_vp_position(m_root);
       construct_node(m_root, ++v_first, v_last);
     };
     
@@ -830,7 +1180,9 @@ class dvp_tree_impl
                   m_tree(&aTree), m_root(boost::graph_traits<tree_indexer>::null_vertex()), 
                   m_key(aKey), m_mu(aMu), m_position(aPosition),
                   m_distance(aSpace), 
-                  m_vp_chooser(aVPChooser) {
+                  m_vp_chooser(aVPChooser),
+                  m_approx_epsilon(0.0), m_approx_max_visits(0),
+                  m_max_rebuild_size(0) {
       if(aBegin == aEnd) return;
       
       std::vector<vertex_property> v_bin; //Copy the list of vertices to random access memory.
@@ -853,6 +1205,7 @@ class dvp_tree_impl
 #else
       m_root = create_root(*v_first, *m_tree);
 #endif
+      record_vp_position(m_root);
       construct_node(m_root, ++v_first, v_last);
     };
     
@@ -874,7 +1227,9 @@ class dvp_tree_impl
                   m_tree(&aTree), m_root(boost::graph_traits<tree_indexer>::null_vertex()), 
                   m_key(aKey), m_mu(aMu), m_position(aPosition),
                   m_distance(aSpace), 
-                  m_vp_chooser(aVPChooser) { };
+                  m_vp_chooser(aVPChooser),
+                  m_approx_epsilon(0.0), m_approx_max_visits(0),
+                  m_max_rebuild_size(0) { };
     
     
     //sort-of copyable:
@@ -885,7 +1240,11 @@ class dvp_tree_impl
         m_mu(rhs.m_mu), 
         m_position(rhs.m_position), 
         m_distance(rhs.m_distance),
-        m_vp_chooser(rhs.m_vp_chooser) { };
+        m_vp_chooser(rhs.m_vp_chooser),
+        m_vp_positions(rhs.m_vp_positions),
+        m_approx_epsilon(rhs.m_approx_epsilon),
+        m_approx_max_visits(rhs.m_approx_max_visits),
+        m_max_rebuild_size(rhs.m_max_rebuild_size) { };
     void reassign_copied(tree_indexer& aTree, const self& rhs) BOOST_NOEXCEPT {
       m_tree = &aTree;
       m_root = get_root_vertex(aTree);
@@ -894,6 +1253,10 @@ class dvp_tree_impl
       m_position = rhs.m_position;
       m_distance = rhs.m_distance;
       m_vp_chooser = rhs.m_vp_chooser;
+      m_vp_positions = rhs.m_vp_positions;
+      m_approx_epsilon = rhs.m_approx_epsilon;
+      m_approx_max_visits = rhs.m_approx_max_visits;
+      m_max_rebuild_size = rhs.m_max_rebuild_size;
     };
     
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
@@ -905,7 +1268,11 @@ class dvp_tree_impl
         m_mu(std::move(rhs.m_mu)), 
         m_position(std::move(rhs.m_position)), 
         m_distance(std::move(rhs.m_distance)),
-        m_vp_chooser(std::move(rhs.m_vp_chooser)) {
+        m_vp_chooser(std::move(rhs.m_vp_chooser)),
+        m_vp_positions(std::move(rhs.m_vp_positions)),
+        m_approx_epsilon(rhs.m_approx_epsilon),
+        m_approx_max_visits(rhs.m_approx_max_visits),
+        m_max_rebuild_size(rhs.m_max_rebuild_size) {
       rhs.m_tree = NULL;
       rhs.m_root = boost::graph_traits<tree_indexer>::null_vertex();
     };
@@ -919,6 +1286,10 @@ class dvp_tree_impl
       m_position = std::move(rhs.m_position);
       m_distance = std::move(rhs.m_distance);
       m_vp_chooser = std::move(rhs.m_vp_chooser);
+      m_vp_positions = std::move(rhs.m_vp_positions);
+      m_approx_epsilon = rhs.m_approx_epsilon;
+      m_approx_max_visits = rhs.m_approx_max_visits;
+      m_max_rebuild_size = rhs.m_max_rebuild_size;
     };
 #endif
     
@@ -963,6 +1334,32 @@ class dvp_tree_impl
         return std::numeric_limits<double>::infinity();
     };
     
+    /**
+     * Sets the approximation parameters of the nearest-neighbor queries. With a non-zero epsilon or 
+     * a non-zero maximum number of visited nodes, the nearest-neighbor queries use a best-bin-first 
+     * search which returns neighbors within a factor (1 + epsilon) of the true nearest-neighbors 
+     * (unless the maximum number of visits is reached first). With both set to zero (the default), 
+     * the queries are exact. The range queries are always exact.
+     * \param aEpsilon The relative error allowed on the distances to the nearest-neighbors.
+     * \param aMaxVisits The maximum number of nodes visited by a query (0: no limit).
+     */
+    void set_approximation(double aEpsilon, std::size_t aMaxVisits = 0) {
+      m_approx_epsilon = (aEpsilon > 0.0 ? aEpsilon : 0.0);
+      m_approx_max_visits = aMaxVisits;
+    };
+    
+    /**
+     * Returns the relative error allowed on the distances to the nearest-neighbors.
+     * \return The relative error allowed on the distances to the nearest-neighbors.
+     */
+    double get_approximation_epsilon() const { return m_approx_epsilon; };
+    
+    /**
+     * Returns the maximum number of nodes visited by a nearest-neighbor query (0: no limit).
+     * \return The maximum number of nodes visited by a nearest-neighbor query (0: no limit).
+     */
+    std::size_t get_approximation_max_visits() const { return m_approx_max_visits; };
+    
     /**
      * Inserts a vertex into the tree.
      * \param up The vertex-property to be added to the DVP-tree.
@@ -978,11 +1375,13 @@ class dvp_tree_impl
 #else
         m_root = create_root(up, *m_tree); 
 #endif
+        record_vp_position(m_root);
         return;
       };
       
       point_type u_pt = get(m_position, up); 
       vertex_type u_subroot = get_leaf(u_pt,m_root); // <-- to store the root of subtree to reconstruct.
+      bool was_capped = false;  // <-- set if the sub-tree to reconstruct was limited by m_max_rebuild_size.
       // NOTE: if the root is the leaf, it requires special attention since no parent exists.
       if(u_subroot != m_root) {
         vertex_type u_leaf = source(*(in_edges(u_subroot, *m_tree).first),*m_tree);
@@ -991,21 +1390,32 @@ class dvp_tree_impl
           // we should then find a non-full parent.
           int actual_depth_limit = 1;
           int last_depth_limit = actual_depth_limit;
+          std::size_t subtree_size = 1 + Arity;  // <-- size of the (full) sub-tree below u_leaf.
+          bool is_capped = false;
           while((u_leaf != m_root) && (is_node_full(u_leaf, last_depth_limit))) {
+            // do not climb to a sub-tree larger than what a single insertion is allowed to reconstruct:
+            subtree_size = 1 + Arity * subtree_size;
+            if((m_max_rebuild_size != 0) && (subtree_size > m_max_rebuild_size)) {
+              is_capped = true;
+              break;
+            };
             u_leaf = source(*(in_edges(u_leaf, *m_tree).first), *m_tree);
             last_depth_limit = ++actual_depth_limit;
           };
-          bool is_p_full = false; 
-          if(u_leaf == m_root)
+          bool is_p_full = is_capped; 
+          if((u_leaf == m_root) && !is_capped)
             is_p_full = is_node_full(u_leaf, last_depth_limit);
           if((!is_p_full) && (last_depth_limit >= 0)) {
             // this means that we can add our key to the sub-tree of u_leaf and reconstruct from there.
             u_subroot = u_leaf;
           };
+          was_capped = is_capped;
           // else:
-          //  this means that either the root node is full or there are 
-          //  branches of the tree that are deeper than u_subroot, 
-          //  and thus, in either case, u_subroot should be expanded.
+          //  this means that either the root node is full, or there are 
+          //  branches of the tree that are deeper than u_subroot, or the 
+          //  non-full parent is too large to be reconstructed by a single insertion, 
+          //  and thus, in any case, u_subroot should be expanded (the deferred 
+          //  rebalancing can be done with the rebalance() function).
         } else {
           //  leaf node is not full of children, an additional child can be added 
           //  (must be reconstructed to keep ordering, but this is a trivial operation O(Arity)).
@@ -1013,7 +1423,12 @@ class dvp_tree_impl
           //  if leaf is not really a leaf, then it means that this sub-tree is definitely 
           //  not balanced and not full either,
           //  then all the Keys ought to be collected and u_leaf ought to be reconstructed.
-          u_subroot = u_leaf;
+          //  Unless the sub-tree of u_leaf is too large to be reconstructed by a single insertion, 
+          //  in which case, u_subroot should be expanded (as for a capped full-leaf, above).
+          if((m_max_rebuild_size == 0) || !is_subtree_larger_than(u_leaf, m_max_rebuild_size))
+            u_subroot = u_leaf;
+          else
+            was_capped = true;
         };
       };
       
@@ -1030,6 +1445,10 @@ class dvp_tree_impl
       };
       construct_node(u_subroot, prop_list.begin(), prop_list.end());
       
+      // the sub-tree that should have been reconstructed was too large, re-balance the 
+      // surroundings of the expanded leaf within the same bound instead.
+      if(was_capped)
+        rebalance_step(u_subroot);
     };
     /**
      * Inserts a range of vertices.
@@ -1039,11 +1458,100 @@ class dvp_tree_impl
      */
     template <typename ForwardIterator>
     void insert(ForwardIterator aBegin, ForwardIterator aEnd) { 
-      for(; aBegin != aEnd; ++aBegin) 
-        insert(*aBegin);
-      //TODO: There's got to be a better way to insert many elements (most likely a similar strategy to the erase multiple function).
+      std::vector<vertex_property> new_props(aBegin, aEnd);
+      if(new_props.empty())
+        return;
+      
+      if(new_props.size() >= num_vertices(*m_tree)) {
+        // there are more new vertices than existing ones, the entire tree is reconstructed in one pass.
+        if(num_vertices(*m_tree) != 0)
+          remove_branch(m_root, back_inserter(new_props), *m_tree);
+        m_vp_positions.clear();
+        construct_root(new_props.begin(), new_props.end());
+        return;
+      };
+      
+      // First, find the trunk of the sub-tree to which each new vertex should be added 
+      //  (as for a single insertion, the parent of the leaf in which it falls).
+      std::vector<vertex_type> new_trunks;
+      new_trunks.reserve(new_props.size());
+      for(prop_vector_iter it = new_props.begin(); it != new_props.end(); ++it) {
+        vertex_type u_trunk = get_leaf(get(m_position, *it), m_root);
+        if(u_trunk != m_root)
+          u_trunk = source(*(in_edges(u_trunk, *m_tree).first), *m_tree);
+        new_trunks.push_back(u_trunk);
+      };
+      
+      // Then, merge the trunks that are contained in the sub-tree of another trunk:
+      std::vector<vertex_type> unique_trunks(new_trunks);
+      std::sort(unique_trunks.begin(), unique_trunks.end());
+      unique_trunks.erase(std::unique(unique_trunks.begin(), unique_trunks.end()), unique_trunks.end());
+      typedef std::map< vertex_type, std::vector<std::size_t> > trunk_listing;
+      trunk_listing t_lists;
+      for(std::size_t i = 0; i < new_trunks.size(); ++i) {
+        vertex_type u_trunk = new_trunks[i];
+        for(vertex_type u_up = new_trunks[i]; u_up != m_root; ) {
+          u_up = source(*(in_edges(u_up, *m_tree).first), *m_tree);
+          if(std::binary_search(unique_trunks.begin(), unique_trunks.end(), u_up))
+            u_trunk = u_up;
+        };
+        t_lists[u_trunk].push_back(i);
+      };
+      
+      // Finally, reconstruct each sub-tree with its new vertices, which leaves it balanced.
+      for(typename trunk_listing::iterator it = t_lists.begin(); it != t_lists.end(); ++it) {
+        std::vector<vertex_property> prop_list;
+        prop_list.reserve(it->second.size());
+        for(std::vector<std::size_t>::iterator id_it = it->second.begin(); id_it != it->second.end(); ++id_it) {
+          update_mu_upwards(get(m_position, new_props[*id_it]), it->first);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+          prop_list.push_back(std::move(new_props[*id_it]));
+#else
+          prop_list.push_back(new_props[*id_it]);
+#endif
+        };
+        while( out_degree(it->first, *m_tree) > 0 ) {
+          edge_type e = *(out_edges(it->first, *m_tree).first);
+          remove_branch(target(e, *m_tree), back_inserter(prop_list), *m_tree);
+        };
+        construct_node(it->first, prop_list.begin(), prop_list.end());
+      };
+    };
+    
+    /**
+     * Reconstructs the entire tree such that it is balanced. Single insertions only reconstruct 
+     * sub-trees of a limited size (see set_max_rebuild_size), which bounds the amount of work per 
+     * insertion, and re-balance the surroundings of the insertion point within that same bound, 
+     * but the upper levels of the tree can still become slowly unbalanced, and so, this function 
+     * can be called at convenient times (e.g., between planning queries) to restore the balance of the tree.
+     * \note This is a linearithmic-time operation, w.r.t. the number of vertices.
+     */
+    void rebalance() {
+      if(num_vertices(*m_tree) < 2)
+        return;
+      std::vector<vertex_property> prop_list;
+      remove_branch(m_root, back_inserter(prop_list), *m_tree);
+      m_vp_positions.clear();
+      construct_root(prop_list.begin(), prop_list.end());
     };
     
+    /**
+     * Sets the maximum size of the sub-trees that can be reconstructed by a single insertion. 
+     * Insertions that would require the reconstruction of a larger sub-tree to remain balanced 
+     * will instead expand the leaf in which the new vertex falls, and then reconstruct the largest 
+     * sub-tree around that leaf that fits within the limit (if it is unbalanced), such that the 
+     * amount of work per insertion is bounded (at the expense of a slow degradation of the balance 
+     * of the upper levels of the tree, see rebalance()).
+     * \param aMaxRebuildSize The maximum number of vertices in a reconstructed sub-tree (0: no limit, the default).
+     */
+    void set_max_rebuild_size(std::size_t aMaxRebuildSize) { m_max_rebuild_size = aMaxRebuildSize; };
+    
+    /**
+     * Returns the maximum size of the sub-trees that can be reconstructed by a single insertion.
+     * \return The maximum number of vertices in a reconstructed sub-tree (0: no limit).
+     */
+    std::size_t get_max_rebuild_size() const { return m_max_rebuild_size; };
+    
     
     /**
      * Erases the given vertex from the DVP-tree.
@@ -1091,6 +1599,7 @@ class dvp_tree_impl
 #else
         m_root = create_root(*v_first, *m_tree);
 #endif
+        record_vp_position(m_root);
         construct_node(m_root, ++v_first, v_last);
       };
     };
@@ -1197,6 +1706,7 @@ class dvp_tree_impl
 #else
         m_root = create_root(*v_first, *m_tree);
 #endif
+        record_vp_position(m_root);
         construct_node(m_root, ++v_first, v_last);
         return;
       };
@@ -1224,8 +1734,98 @@ class dvp_tree_impl
         remove_branch(m_root, back_inserter(prop_list), *m_tree);
         m_root = boost::graph_traits<tree_indexer>::null_vertex();
       };
+      m_vp_positions.clear();
     }; 
     
+    /// The layout record type used to export / import the structure of this DVP-tree.
+    typedef dvp_tree_layout_record<key_type, distance_type> layout_record;
+    
+    /**
+     * Exports the layout of this DVP-tree as a pre-order sequence of layout records, 
+     * such that the exact same tree can be re-created later with the import_layout function.
+     * \tparam OutputIterator The output-iterator type which can receive layout records.
+     * \param aOutput The output-iterator to which the layout records are written.
+     * \return The output-iterator after the last written record.
+     */
+    template <typename OutputIterator>
+    OutputIterator export_layout(OutputIterator aOutput) const {
+      if( ( num_vertices(*m_tree) == 0 ) || ( m_root == boost::graph_traits<tree_indexer>::null_vertex() ) )
+        return aOutput;
+      search_task_stack tasks;
+      tasks.push_back(std::pair< vertex_type, distance_type >(m_root, distance_type(0)));
+      while( !tasks.empty() ) {
+        std::pair< vertex_type, distance_type > cur = tasks.back();
+        tasks.pop_back();
+        *aOutput = layout_record(get(m_key, get_raw_vertex_property(*m_tree, cur.first)), 
+                                 out_degree(cur.first, *m_tree), cur.second);
+        ++aOutput;
+        // push the children in reverse, such that they are exported in order:
+        std::size_t first_child = tasks.size();
+        out_edge_iter ei, ei_end;
+        for(boost::tie(ei, ei_end) = out_edges(cur.first, *m_tree); ei != ei_end; ++ei)
+          tasks.push_back(std::pair< vertex_type, distance_type >(target(*ei, *m_tree), 
+                                                                   get(m_mu, get_raw_edge_property(*m_tree, *ei))));
+        std::reverse(tasks.begin() + first_child, tasks.end());
+      };
+      return aOutput;
+    };
+    
+    /**
+     * Imports a layout previously produced by export_layout into this (empty) DVP-tree. 
+     * None of the vantage-point partitions are recomputed, which makes this much cheaper 
+     * than re-constructing the tree from the same set of entries.
+     * \tparam InputIterator The input-iterator type from which the layout records are read.
+     * \tparam ElemPositionMap The property-map that associates position values to the keys of the layout records.
+     * \param aBegin The start of the range of layout records (pre-order).
+     * \param aEnd The end of the range of layout records (one-past-last).
+     * \param aElemPosition The property-map that takes a key and produces (or looks up) a position value.
+     * \throw std::invalid_argument If the DVP-tree is not empty or if the layout is not a valid pre-order tree layout 
+     *        (including a node with more children than the arity of the tree).
+     */
+    template <typename InputIterator, typename ElemPositionMap>
+    void import_layout(InputIterator aBegin, InputIterator aEnd, ElemPositionMap aElemPosition) {
+      if( aBegin == aEnd )
+        return;
+      if( ( num_vertices(*m_tree) != 0 ) && ( m_root != boost::graph_traits<tree_indexer>::null_vertex() ) )
+        throw std::invalid_argument("Cannot import a layout into a non-empty DVP-tree!");
+      
+      // stack of (node, number of children still to be imported):
+      std::vector< std::pair< vertex_type, std::size_t > > parents;
+      for(; aBegin != aEnd; ++aBegin) {
+        const layout_record& rec = *aBegin;
+        if( rec.child_count > Arity )
+          throw std::invalid_argument("Invalid DVP-tree layout, a node has more children than the arity of the tree!");
+        vertex_property vp;
+        put(m_key, vp, rec.key);
+        put(m_position, vp, get(aElemPosition, rec.key));
+        vertex_type new_node;
+        if( m_root == boost::graph_traits<tree_indexer>::null_vertex() ) {
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+          new_node = m_root = create_root(std::move(vp), *m_tree);
+#else
+          new_node = m_root = create_root(vp, *m_tree);
+#endif
+        } else {
+          if( parents.empty() )
+            throw std::invalid_argument("Invalid DVP-tree layout, more records than the tree structure allows!");
+          edge_property ep;
+          put(m_mu, ep, rec.mu);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+          new_node = add_child_vertex(parents.back().first, std::move(vp), std::move(ep), *m_tree).first;
+#else
+          new_node = add_child_vertex(parents.back().first, vp, ep, *m_tree).first;
+#endif
+          if( --(parents.back().second) == 0 )
+            parents.pop_back();
+        };
+        record_vp_position(new_node);
+        if( rec.child_count > 0 )
+          parents.push_back(std::pair< vertex_type, std::size_t >(new_node, rec.child_count));
+      };
+      if( !parents.empty() )
+        throw std::invalid_argument("Invalid DVP-tree layout, the sequence of records is incomplete!");
+    };
+    
     /**
      * Finds the nearest neighbor to a given position.
      * \param aPoint The position from which to find the nearest-neighbor of.
@@ -1235,7 +1835,7 @@ class dvp_tree_impl
       if(num_vertices(*m_tree) == 0) 
         return boost::graph_traits<tree_indexer>::null_vertex();
       nearest_search_result_set result_set(1, std::numeric_limits<distance_type>::infinity());
-      find_nearest_impl(aPoint, result_set);
+      find_knn_impl(aPoint, result_set);
       if(result_set.Neighbors.size())
         return result_set.Neighbors.front().second;
       else
@@ -1251,7 +1851,7 @@ class dvp_tree_impl
       if(num_vertices(*m_tree) == 0) 
         return boost::graph_traits<tree_indexer>::null_vertex();
       pred_succ_search_result_set result_set(1, std::numeric_limits<distance_type>::infinity());
-      find_nearest_impl(aPoint, result_set);
+      find_knn_impl(aPoint, result_set);
       std::pair< vertex_type, vertex_type > result;
       if( result_set.Pred.size() )
         result.first = result_set.Pred.front().second;
@@ -1280,7 +1880,7 @@ class dvp_tree_impl
       if(num_vertices(*m_tree) == 0) 
         return aOutputBegin;
       nearest_search_result_set result_set(K, R);
-      find_nearest_impl(aPoint, result_set);
+      find_knn_impl(aPoint, result_set);
       std::sort_heap(result_set.Neighbors.begin(), result_set.Neighbors.end(), priority_compare_type());
       for(typename priority_queue_type::const_iterator it = result_set.Neighbors.begin(); it != result_set.Neighbors.end(); ++it)
         *(aOutputBegin++) = it->second;
@@ -1307,7 +1907,7 @@ class dvp_tree_impl
       if(num_vertices(*m_tree) == 0) 
         return std::pair< OutputIterator, OutputIterator >(aPredBegin, aSuccBegin);
       pred_succ_search_result_set result_set(K, R);
-      find_nearest_impl(aPoint, result_set);
+      find_knn_impl(aPoint, result_set);
       std::sort_heap(result_set.Pred.begin(), result_set.Pred.end(), priority_compare_type());
       std::sort_heap(result_set.Succ.begin(), result_set.Succ.end(), priority_compare_type());
       for(typename priority_queue_type::const_iterator it = result_set.Pred.begin(); it != result_set.Pred.end(); ++it)
@@ -1369,6 +1969,114 @@ class dvp_tree_impl
     
     
     
+    /* Block of single nearest-neighbor queries, executed by one worker thread (with its own scratch buffers). */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    struct nearest_batch_block {
+      const self* p_parent;
+      RandomAccessPtIter pt_first;
+      RandomAccessOutIter out_first;
+      
+      nearest_batch_block(const self* aParent, RandomAccessPtIter aPtFirst, RandomAccessOutIter aOutFirst) : 
+                          p_parent(aParent), pt_first(aPtFirst), out_first(aOutFirst) { };
+      
+      void operator()(std::size_t, std::size_t first, std::size_t last) const {
+        search_task_stack tasks;
+        search_task_stack temp_invtasks;
+        nearest_search_result_set result_set(1, std::numeric_limits<distance_type>::infinity());
+        for(std::size_t i = first; i < last; ++i) {
+          result_set.reset(1, std::numeric_limits<distance_type>::infinity());
+          p_parent->find_knn_impl(*(pt_first + i), result_set, tasks, temp_invtasks);
+          if(result_set.Neighbors.size())
+            *(out_first + i) = result_set.Neighbors.front().second;
+          else
+            *(out_first + i) = boost::graph_traits<tree_indexer>::null_vertex();
+        };
+      };
+    };
+    
+    /* Block of K-nearest-neighbor queries, executed by one worker thread (with its own scratch buffers). */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    struct knn_batch_block {
+      const self* p_parent;
+      RandomAccessPtIter pt_first;
+      RandomAccessOutIter out_first;
+      std::size_t K;
+      distance_type R;
+      
+      knn_batch_block(const self* aParent, RandomAccessPtIter aPtFirst, RandomAccessOutIter aOutFirst, 
+                      std::size_t aK, distance_type aR) : 
+                      p_parent(aParent), pt_first(aPtFirst), out_first(aOutFirst), K(aK), R(aR) { };
+      
+      void operator()(std::size_t, std::size_t first, std::size_t last) const {
+        search_task_stack tasks;
+        search_task_stack temp_invtasks;
+        nearest_search_result_set result_set(K, R);
+        for(std::size_t i = first; i < last; ++i) {
+          result_set.reset(K, R);
+          p_parent->find_knn_impl(*(pt_first + i), result_set, tasks, temp_invtasks);
+          std::sort_heap(result_set.Neighbors.begin(), result_set.Neighbors.end(), priority_compare_type());
+          (*(out_first + i)).clear();
+          for(typename priority_queue_type::const_iterator it = result_set.Neighbors.begin(); it != result_set.Neighbors.end(); ++it)
+            (*(out_first + i)).push_back(it->second);
+        };
+      };
+    };
+    
+    /**
+     * Finds the nearest neighbor to each position of a batch of query points, with 
+     * the queries being distributed over the worker threads of the given thread-pool.
+     * \note No insertion or removal must occur on the DVP-tree while this function executes.
+     * \tparam RandomAccessPtIter A random-access iterator type to obtain the query points.
+     * \tparam RandomAccessOutIter A random-access iterator type to store the resulting tree vertex descriptors.
+     * \param aPool The thread-pool on which to execute the queries.
+     * \param aPtBegin The start of the range of query points.
+     * \param aPtEnd The end of the range of query points (one-past-last).
+     * \param aOutputBegin The start of the range in which to store the nearest-neighbor of each query 
+     *        point (or the null-vertex if none is found), must be as long as the range of query points.
+     */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    void find_nearest_batch(thread_pool& aPool, RandomAccessPtIter aPtBegin, RandomAccessPtIter aPtEnd, 
+                            RandomAccessOutIter aOutputBegin) const {
+      std::size_t query_count = aPtEnd - aPtBegin;
+      if(num_vertices(*m_tree) == 0) {
+        for(std::size_t i = 0; i < query_count; ++i)
+          *(aOutputBegin + i) = boost::graph_traits<tree_indexer>::null_vertex();
+        return;
+      };
+      aPool.for_each_block(query_count, 
+        nearest_batch_block<RandomAccessPtIter, RandomAccessOutIter>(this, aPtBegin, aOutputBegin));
+    };
+    
+    /**
+     * Finds the K nearest-neighbors to each position of a batch of query points, with 
+     * the queries being distributed over the worker threads of the given thread-pool.
+     * \note No insertion or removal must occur on the DVP-tree while this function executes.
+     * \tparam RandomAccessPtIter A random-access iterator type to obtain the query points.
+     * \tparam RandomAccessOutIter A random-access iterator type to the containers (e.g., std::vector) 
+     *         that will receive the sorted list of nearest-neighbors (by tree vertex descriptors).
+     * \param aPool The thread-pool on which to execute the queries.
+     * \param aPtBegin The start of the range of query points.
+     * \param aPtEnd The end of the range of query points (one-past-last).
+     * \param aOutputBegin The start of the range of containers (cleared and filled with push_back) in 
+     *        which to store the nearest-neighbors of each query point, must be as long as the range of query points.
+     * \param K The number of nearest-neighbors.
+     * \param R The maximum distance value for the nearest-neighbors.
+     */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    void find_k_nearest_batch(thread_pool& aPool, RandomAccessPtIter aPtBegin, RandomAccessPtIter aPtEnd, 
+                              RandomAccessOutIter aOutputBegin, std::size_t K, 
+                              distance_type R = std::numeric_limits<distance_type>::infinity()) const {
+      std::size_t query_count = aPtEnd - aPtBegin;
+      if(num_vertices(*m_tree) == 0) {
+        for(std::size_t i = 0; i < query_count; ++i)
+          (*(aOutputBegin + i)).clear();
+        return;
+      };
+      aPool.for_each_block(query_count, 
+        knn_batch_block<RandomAccessPtIter, RandomAccessOutIter>(this, aPtBegin, aOutputBegin, K, R));
+    };
+    
+    
     struct mutation_visitor {
       self* m_parent;
       
@@ -44,6 +44,8 @@
 #include <ReaK/ctrl/topologies/metric_space_concept.hpp>
 #include "any_sbmp_reporter.hpp"
 
+#include <string>
+
 
 
 namespace ReaK {
@@ -76,6 +78,7 @@ class fadprm_planner : public sample_based_planner<FreeSpaceType> {
     
   protected:
     double m_initial_relaxation;
+    std::string m_roadmap_cache_file;
     
   public:
     
@@ -89,6 +92,7 @@ class fadprm_planner : public sample_based_planner<FreeSpaceType> {
      * the function is likely to fail.
      * \param aQuery The query object that defines as input the parameters of the query, 
      *               and as output, the recorded solutions.
+     * \throw std::invalid_argument If the CONCURRENT_MOTION_GRAPH storage is requested (not supported by this planner).
      */
     virtual void solve_planning_query(planning_query<FreeSpaceType>& aQuery);
     
@@ -103,13 +107,40 @@ class fadprm_planner : public sample_based_planner<FreeSpaceType> {
      */
     void set_initial_relaxation(double aInitialRelaxation) { m_initial_relaxation = 0.0; };
     
+    /**
+     * Returns the name of the roadmap cache file used by this planner (empty if no roadmap cache is used).
+     * \return The name of the roadmap cache file used by this planner.
+     */
+    const std::string& get_roadmap_cache_file() const { return m_roadmap_cache_file; };
+    /**
+     * Sets the name of the roadmap cache file to be used by this planner. When set, the roadmap 
+     * (and its DVP-tree layout) saved in that file, if any, and if it was built in the same free-space 
+     * (see get_roadmap_environment_hash), is loaded before solving a query, and the start and goal of 
+     * the query are connected to their nearest neighbors in it. If the goal is then reachable through 
+     * the cached roadmap (every edge of the path being checked again), the query is answered without 
+     * any new sample. 
+     * Otherwise, the roadmap is grown as usual and saved back to that file, without the start and 
+     * goal of the query (see roadmap_cache.hpp). The roadmap cache is not used for steerable 
+     * spaces (the steering records of the edges are not cached).
+     * \param aRoadmapCacheFile The name of the roadmap cache file to be used by this planner (empty to disable it).
+     */
+    void set_roadmap_cache_file(const std::string& aRoadmapCacheFile) { m_roadmap_cache_file = aRoadmapCacheFile; };
+    /**
+     * Checks if a roadmap cache file is used by this planner.
+     * \return True if a roadmap cache file is used by this planner.
+     */
+    bool uses_roadmap_cache() const { 
+      return !m_roadmap_cache_file.empty() && !is_steerable_space<FreeSpaceType>::value; 
+    };
+    
     /**
      * Parametrized constructor.
      * \param aWorld A topology which represents the C-free (obstacle-free configuration space).
      * \param aMaxVertexCount The maximum number of samples to generate during the motion planning.
      * \param aProgressInterval The number of new samples between each "progress report".
      * \param aDataStructureFlags An integer flags representing the kind of motion graph data-structure to use in the 
-     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH.
+     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH
+     *                            (CONCURRENT_MOTION_GRAPH is not supported, see rrt_planner, an std::invalid_argument is thrown).
      *                            Any combination of those two and of KNN method flags to use for nearest
      *                            neighbor queries in the graph. KNN method flags can be LINEAR_SEARCH_KNN, 
      *                            DVP_BF2_TREE_KNN, DVP_BF4_TREE_KNN, DVP_COB2_TREE_KNN, or DVP_COB4_TREE_KNN.
@@ -133,7 +164,7 @@ class fadprm_planner : public sample_based_planner<FreeSpaceType> {
                              aDataStructureFlags, 0,
                              aSteerProgressTolerance, aConnectionTolerance, 
                              aSamplingRadius, aSpaceDimensionality, aReporter),
-                   m_initial_relaxation( 0.0 ) { };
+                   m_initial_relaxation( 0.0 ), m_roadmap_cache_file() { };
     
     virtual ~fadprm_planner() { };
     
@@ -38,6 +38,7 @@
 #include <boost/graph/graph_concepts.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/graph/properties.hpp>
+#include <boost/static_assert.hpp>
 
 #include <utility>  // for pair and move
 #include <vector>   // for vector
@@ -161,6 +162,11 @@ struct position_caching_policy {
  * \tparam PositionMap The property-map type that can map the vertex descriptors (which should be the value-type of the iterators) to a point (position).
  * \tparam Arity The arity of the tree, e.g., 2 means a binary-tree.
  * \tparam VPChooser The functor type to use to choose the vantage-point out of a set of vertices.
+ * \tparam TreeStorageTag A tree-storage tag which specifies the kind of tree structure to use for the DVP tree.
+ * \tparam PositionCachingPolicy The policy for caching the positions in the vertices of the tree (position_caching_policy or no_position_caching_policy).
+ * \tparam PositionStorage The policy for the storage of the positions used by the nearest-neighbor searches, 
+ *         either dvp_inline_positions (read from the tree vertices) or dvp_packed_positions (a separate packed 
+ *         array of whole points indexed by tree slot, which requires a tree storage with stable slots, see dvp_has_stable_tree_slots).
  */
 template <typename Key,
           typename Topology,
@@ -168,13 +174,15 @@ template <typename Key,
           unsigned int Arity = 2,
           typename VPChooser = random_vp_chooser,
           typename TreeStorageTag = boost::bfl_d_ary_tree_storage<Arity>,
-          typename PositionCachingPolicy = position_caching_policy>
+          typename PositionCachingPolicy = position_caching_policy,
+          typename PositionStorage = dvp_inline_positions>
 class dvp_tree
 {
   public:
     BOOST_CONCEPT_ASSERT((MetricSpaceConcept<Topology>));
+    BOOST_STATIC_ASSERT((dvp_is_position_storage_supported<PositionStorage, TreeStorageTag>::value));
     
-    typedef dvp_tree<Key, Topology, PositionMap, Arity, VPChooser, TreeStorageTag, PositionCachingPolicy> self;
+    typedef dvp_tree<Key, Topology, PositionMap, Arity, VPChooser, TreeStorageTag, PositionCachingPolicy, PositionStorage> self;
     
     typedef typename boost::property_traits<PositionMap>::value_type point_type;
     typedef double distance_type;
@@ -208,7 +216,8 @@ class dvp_tree
       ep_to_distance_map_type,
       vp_to_pos_map_type,
       Arity,
-      VPChooser> dvp_impl_type;
+      VPChooser,
+      PositionStorage> dvp_impl_type;
     
     tree_indexer m_tree;
     PositionMap m_position;
@@ -299,6 +308,61 @@ class dvp_tree
                aVPChooser
              ) { };
     
+    /**
+     * Construct the DVP-tree from a graph and a previously exported tree layout (see export_layout). 
+     * The vertices listed in the layout are placed exactly as they were when the layout was exported 
+     * (no vantage-point partition is recomputed), and any other vertex of the graph is then inserted 
+     * into the tree (e.g., the start and goal vertices added to a pre-built roadmap).
+     * \tparam Graph The graph type on which the vertices are taken from, should model the boost::VertexListGraphConcept.
+     * \tparam LayoutIterator The input-iterator type from which the layout records can be read.
+     * \param g The graph from which to take the vertices.
+     * \param aLayoutBegin The start of the range of layout records.
+     * \param aLayoutEnd The end of the range of layout records (one-past-last).
+     * \param aSpace The topology on which the positions of the vertices reside.
+     * \param aPosition The property-map that can be used to obtain the positions of the vertices.
+     * \param aVPChooser The vantage-point chooser functor (policy class).
+     */
+    template <typename Graph, typename LayoutIterator>
+    dvp_tree(const Graph& g, 
+             LayoutIterator aLayoutBegin,
+             LayoutIterator aLayoutEnd,
+             const shared_ptr<const Topology>& aSpace, 
+             PositionMap aPosition,
+             VPChooser aVPChooser = VPChooser()) :
+             m_tree(),
+             m_position(aPosition),
+             m_vp_key(
+               key_map_type(&vertex_properties::k),
+               get_raw_vertex_to_bundle_map(m_tree)
+             ),
+             m_vp_pos(
+               vertex_position_map(key_map_type(&vertex_properties::k), aPosition),
+               get_raw_vertex_to_bundle_map(m_tree)
+             ),
+             m_impl(
+               m_tree,
+               aSpace, 
+               m_vp_key,
+               ep_to_distance_map_type(
+                 distance_map_type(&edge_properties::d),
+                 get_raw_edge_to_bundle_map(m_tree)
+               ),
+               m_vp_pos,
+               aVPChooser
+             ) { 
+      boost::unordered_set<Key, detail::dvp_tree_key_hasher> layout_keys;
+      for(LayoutIterator it = aLayoutBegin; it != aLayoutEnd; ++it)
+        layout_keys.insert(it->key);
+      m_impl.import_layout(aLayoutBegin, aLayoutEnd, aPosition);
+      
+      std::vector<Key> remaining;
+      typename boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
+      for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi)
+        if( layout_keys.count(*vi) == 0 )
+          remaining.push_back(*vi);
+      insert(remaining.begin(), remaining.end());
+    };
+    
     dvp_tree(const self& rhs) :
              m_tree(rhs.m_tree),
              m_position(rhs.m_position),
@@ -360,6 +424,50 @@ class dvp_tree
      */
     double get_characteristic_size() const { return m_impl.get_characteristic_size(); };
     
+    /**
+     * Sets the approximation parameters of the nearest-neighbor queries (see dvp_tree_impl::set_approximation).
+     * \param aEpsilon The relative error allowed on the distances to the nearest-neighbors.
+     * \param aMaxVisits The maximum number of nodes visited by a query (0: no limit).
+     */
+    void set_approximation(double aEpsilon, std::size_t aMaxVisits = 0) { m_impl.set_approximation(aEpsilon, aMaxVisits); };
+    
+    /**
+     * Sets the maximum size of the sub-trees that can be reconstructed by a single insertion (see dvp_tree_impl::set_max_rebuild_size).
+     * \param aMaxRebuildSize The maximum number of vertices in a reconstructed sub-tree (0: no limit, the default).
+     */
+    void set_max_rebuild_size(std::size_t aMaxRebuildSize) { m_impl.set_max_rebuild_size(aMaxRebuildSize); };
+    
+    /**
+     * Returns the maximum size of the sub-trees that can be reconstructed by a single insertion (0: no limit).
+     */
+    std::size_t get_max_rebuild_size() const { return m_impl.get_max_rebuild_size(); };
+    
+    /**
+     * Reconstructs the entire tree such that it is balanced (see dvp_tree_impl::rebalance).
+     */
+    void rebalance() { m_impl.rebalance(); };
+    
+    /// The layout record type used to export / import the structure of this DVP-tree.
+    typedef dvp_tree_layout_record<Key, distance_type> layout_record;
+    
+    /**
+     * Exports the layout of this DVP-tree as a pre-order sequence of layout records (see dvp_tree_impl::export_layout).
+     * \tparam OutputIterator The output-iterator type which can receive layout records.
+     * \param aOutput The output-iterator to which the layout records are written.
+     * \return The output-iterator after the last written record.
+     */
+    template <typename OutputIterator>
+    OutputIterator export_layout(OutputIterator aOutput) const { return m_impl.export_layout(aOutput); };
+    
+    /**
+     * Imports a layout previously produced by export_layout into this (empty) DVP-tree (see dvp_tree_impl::import_layout).
+     * \tparam InputIterator The input-iterator type from which the layout records are read.
+     * \param aBegin The start of the range of layout records (pre-order).
+     * \param aEnd The end of the range of layout records (one-past-last).
+     */
+    template <typename InputIterator>
+    void import_layout(InputIterator aBegin, InputIterator aEnd) { m_impl.import_layout(aBegin, aEnd, m_position); };
+    
     /**
      * Inserts a key-value (vertex).
      * \param u The vertex to be added to the DVP-tree.
@@ -551,6 +659,60 @@ class dvp_tree
       return std::pair<OutputIterator, OutputIterator>(aPredBegin,aSuccBegin);
     };
     
+    /**
+     * Finds the nearest neighbor to each position of a batch of query points, with 
+     * the queries being distributed over the worker threads of the given thread-pool.
+     * \note No insertion or removal must occur on the DVP-tree while this function executes.
+     * \tparam RandomAccessPtIter A random-access iterator type to obtain the query points.
+     * \tparam RandomAccessOutIter A random-access iterator type to store the resulting vertices.
+     * \param aPool The thread-pool on which to execute the queries.
+     * \param aPtBegin The start of the range of query points.
+     * \param aPtEnd The end of the range of query points (one-past-last).
+     * \param aOutputBegin The start of the range in which to store the nearest-neighbor of each query point.
+     */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    void find_nearest_batch(thread_pool& aPool, RandomAccessPtIter aPtBegin, RandomAccessPtIter aPtEnd, 
+                            RandomAccessOutIter aOutputBegin) const {
+      typedef typename boost::graph_traits<tree_indexer>::vertex_descriptor TreeVertex;
+      std::vector< TreeVertex > v_list(aPtEnd - aPtBegin);
+      m_impl.find_nearest_batch(aPool, aPtBegin, aPtEnd, v_list.begin());
+      for(typename std::vector< TreeVertex >::iterator it = v_list.begin(); it != v_list.end(); ++it, ++aOutputBegin) {
+        if( *it != boost::graph_traits<tree_indexer>::null_vertex() )
+          *aOutputBegin = m_tree[*it].k;
+        else
+          *aOutputBegin = Key();
+      };
+    };
+    
+    /**
+     * Finds the K nearest-neighbors to each position of a batch of query points, with 
+     * the queries being distributed over the worker threads of the given thread-pool.
+     * \note No insertion or removal must occur on the DVP-tree while this function executes.
+     * \tparam RandomAccessPtIter A random-access iterator type to obtain the query points.
+     * \tparam RandomAccessOutIter A random-access iterator type to the containers (e.g., std::vector) 
+     *         that will receive the sorted list of nearest-neighbors.
+     * \param aPool The thread-pool on which to execute the queries.
+     * \param aPtBegin The start of the range of query points.
+     * \param aPtEnd The end of the range of query points (one-past-last).
+     * \param aOutputBegin The start of the range of containers (cleared and filled with push_back) in 
+     *        which to store the nearest-neighbors of each query point.
+     * \param K The number of nearest-neighbors.
+     * \param R The maximum distance value for the nearest-neighbors.
+     */
+    template <typename RandomAccessPtIter, typename RandomAccessOutIter>
+    void find_k_nearest_batch(thread_pool& aPool, RandomAccessPtIter aPtBegin, RandomAccessPtIter aPtEnd, 
+                              RandomAccessOutIter aOutputBegin, std::size_t K, 
+                              distance_type R = std::numeric_limits<distance_type>::infinity()) const {
+      typedef typename boost::graph_traits<tree_indexer>::vertex_descriptor TreeVertex;
+      std::vector< std::vector< TreeVertex > > v_lists(aPtEnd - aPtBegin);
+      m_impl.find_k_nearest_batch(aPool, aPtBegin, aPtEnd, v_lists.begin(), K, R);
+      for(std::size_t i = 0; i < v_lists.size(); ++i, ++aOutputBegin) {
+        (*aOutputBegin).clear();
+        for(typename std::vector< TreeVertex >::iterator it = v_lists[i].begin(); it != v_lists[i].end(); ++it)
+          (*aOutputBegin).push_back(m_tree[*it].k);
+      };
+    };
+    
     
 };
 
@@ -58,6 +58,8 @@
 
 
 
+#include <ReaK/ctrl/graph_alg/concurrent_adjacency_list.hpp>
+
 #include <ReaK/ctrl/topologies/metric_space_concept.hpp>
 
 #include <boost/mpl/if.hpp>
@@ -75,6 +77,22 @@ struct motion_segment_directionality {
     boost::bidirectionalS >::type type;
 };
 
+
+/**
+ * This meta-function gives the type of the concurrent motion-graph storage (see CONCURRENT_MOTION_GRAPH),
+ * i.e., an adjacency-list with stable vertex handles and lock-free vertex / edge insertions, which
+ * can be shared by several planning threads (e.g., through the type-erasure of any_motion_graphs.hpp).
+ * \tparam VertexProp The bundled vertex property type of the motion-graph.
+ * \tparam EdgeProp The bundled edge property type of the motion-graph.
+ * \tparam FreeSpaceType The free-space topology, used to determine the directionality of the motion segments.
+ */
+template <typename VertexProp, typename EdgeProp, typename FreeSpaceType>
+struct concurrent_motion_graph {
+  typedef graph::concurrent_adjacency_list<
+    typename motion_segment_directionality< FreeSpaceType >::type,
+    VertexProp, EdgeProp > type;
+};
+
 };
 
 };
@@ -191,6 +191,10 @@ class sample_based_planner : public planner_base<FreeSpaceType> {
     double m_connection_tol;
     double m_sampling_radius;
     std::size_t m_space_dimensionality;
+    std::size_t m_worker_count;
+    double m_knn_epsilon;
+    std::size_t m_knn_max_visits;
+    std::size_t m_knn_max_rebuild_size;
     
     any_sbmp_reporter_chain<space_type> m_reporter;
     
@@ -319,6 +323,51 @@ class sample_based_planner : public planner_base<FreeSpaceType> {
      */
     void set_space_dimensionality(std::size_t aSpaceDimensionality) { m_space_dimensionality = aSpaceDimensionality; };
     
+    /**
+     * Returns the number of worker threads used by this planner when the PARALLEL_PLANNING flag is set.
+     * \return The number of worker threads used by this planner (0 means the number of hardware threads).
+     */
+    std::size_t get_worker_count() const { return m_worker_count; };
+    /**
+     * Sets the number of worker threads to be used by this planner when the PARALLEL_PLANNING flag is set.
+     * \param aWorkerCount The number of worker threads to be used by this planner (0 means the number of hardware threads).
+     */
+    void set_worker_count(std::size_t aWorkerCount) { m_worker_count = aWorkerCount; };
+    
+    /**
+     * Returns the relative error allowed in the nearest-neighbor queries when an approximate KNN method is used.
+     * \return The relative error allowed in the nearest-neighbor queries.
+     */
+    double get_knn_epsilon() const { return m_knn_epsilon; };
+    /**
+     * Returns the maximum number of nodes visited by a nearest-neighbor query when an approximate KNN method is used.
+     * \return The maximum number of nodes visited by a nearest-neighbor query (0 means no limit).
+     */
+    std::size_t get_knn_max_visits() const { return m_knn_max_visits; };
+    /**
+     * Sets the parameters of the nearest-neighbor queries to be used when an approximate KNN method is used (e.g., DVP_BF2_APPROX_KNN).
+     * \param aEpsilon The relative error allowed in the nearest-neighbor queries.
+     * \param aMaxVisits The maximum number of nodes visited by a nearest-neighbor query (0 means no limit).
+     */
+    void set_knn_approximation(double aEpsilon, std::size_t aMaxVisits = 0) { 
+      m_knn_epsilon = aEpsilon; 
+      m_knn_max_visits = aMaxVisits; 
+    };
+    
+    /**
+     * Returns the maximum size of the sub-trees that a single insertion can reconstruct in the DVP-tree used 
+     * for the nearest-neighbor queries (see dvp_tree::set_max_rebuild_size).
+     * \return The maximum number of vertices in a sub-tree reconstructed by a single insertion (0 means no limit).
+     */
+    std::size_t get_knn_max_rebuild_size() const { return m_knn_max_rebuild_size; };
+    /**
+     * Sets the maximum size of the sub-trees that a single insertion can reconstruct in the DVP-tree used 
+     * for the nearest-neighbor queries (see dvp_tree::set_max_rebuild_size). The default (1024) bounds the 
+     * cost of each insertion, without a limit, an insertion can occasionally reconstruct the entire tree.
+     * \param aMaxRebuildSize The maximum number of vertices in a sub-tree reconstructed by a single insertion (0 means no limit).
+     */
+    void set_knn_max_rebuild_size(std::size_t aMaxRebuildSize) { m_knn_max_rebuild_size = aMaxRebuildSize; };
+    
     
     /**
      * Returns a const-reference to the path-planning reporter used by this planner.
@@ -418,6 +467,10 @@ class sample_based_planner : public planner_base<FreeSpaceType> {
                          m_connection_tol(aConnectionTolerance),
                          m_sampling_radius(aSamplingRadius),
                          m_space_dimensionality(aSpaceDimensionality),
+                         m_worker_count(0),
+                         m_knn_epsilon(0.5),
+                         m_knn_max_visits(0),
+                         m_knn_max_rebuild_size(1024),
                          m_reporter(aReporter) { };
     
     virtual ~sample_based_planner() { };
@@ -50,6 +50,8 @@ const std::size_t ADJ_LIST_MOTION_GRAPH     = 0;
 const std::size_t DVP_ADJ_LIST_MOTION_GRAPH = 1;
 /// This flag indicates that the motion-graph should be stored as a linked-tree (a tree with links, i.e., like a linked-list).
 const std::size_t LINKED_TREE_MOTION_GRAPH  = 2;
+/// This flag indicates that the motion-graph should be stored as a concurrent adjacency-list graph (stable handles, lock-free insertions), to be shared by several planning threads.
+const std::size_t CONCURRENT_MOTION_GRAPH   = 3;
 
 
 /// This mask indicates the nearest-neighbor method used during the motion-planning.
@@ -69,6 +71,55 @@ const std::size_t DVP_BF4_TREE_KNN         = 4 << 2;
 const std::size_t DVP_COB2_TREE_KNN        = 5 << 2;
 /// This flag indicates that the nearest-neighbor queries should be done via a DVP-tree laid out on a contiguous storage in cache-oblivious breadth-first layout of arity 4.
 const std::size_t DVP_COB4_TREE_KNN        = 6 << 2;
+/// This flag indicates that the nearest-neighbor queries should be done via an approximate (best-bin-first) search through a DVP-tree laid out as with DVP_BF2_TREE_KNN.
+const std::size_t DVP_BF2_APPROX_KNN       = 7 << 2;
+/// This flag indicates that the nearest-neighbor queries should be done via an approximate (best-bin-first) search through a DVP-tree laid out as with DVP_BF4_TREE_KNN.
+const std::size_t DVP_BF4_APPROX_KNN       = 8 << 2;
+/// This flag indicates that the nearest-neighbor queries should be done via an approximate (best-bin-first) search through a DVP-tree laid out as with DVP_COB2_TREE_KNN.
+const std::size_t DVP_COB2_APPROX_KNN      = 9 << 2;
+/// This flag indicates that the nearest-neighbor queries should be done via an approximate (best-bin-first) search through a DVP-tree laid out as with DVP_COB4_TREE_KNN.
+const std::size_t DVP_COB4_APPROX_KNN      = 10 << 2;
+
+/**
+ * This function checks if the nearest-neighbor method in the given data-structure flags is one of the approximate DVP-tree methods.
+ * \param aFlags The data-structure flags (containing one of the KNN method flags).
+ * \return True if the KNN method is one of the approximate DVP-tree methods.
+ */
+inline bool is_approximate_knn_method(std::size_t aFlags) {
+  std::size_t knn_method = aFlags & KNN_METHOD_MASK;
+  return (knn_method >= DVP_BF2_APPROX_KNN) && (knn_method <= DVP_COB4_APPROX_KNN);
+};
+
+/**
+ * This function returns the exact nearest-neighbor method that uses the same tree layout as the 
+ * nearest-neighbor method in the given data-structure flags (e.g., DVP_BF2_TREE_KNN for DVP_BF2_APPROX_KNN).
+ * \param aFlags The data-structure flags (containing one of the KNN method flags).
+ * \return The exact KNN method flag that uses the same tree layout.
+ */
+inline std::size_t get_exact_knn_method(std::size_t aFlags) {
+  std::size_t knn_method = aFlags & KNN_METHOD_MASK;
+  if(is_approximate_knn_method(knn_method))
+    return knn_method - (DVP_BF2_APPROX_KNN - DVP_BF2_TREE_KNN);
+  return knn_method;
+};
+
+/**
+ * This function returns the arity of the DVP-tree used by the nearest-neighbor method in the given data-structure flags.
+ * \param aFlags The data-structure flags (containing one of the KNN method flags).
+ * \return The arity of the DVP-tree used by the KNN method (0 if the KNN method does not use a DVP-tree layout).
+ */
+inline std::size_t get_knn_tree_arity(std::size_t aFlags) {
+  switch(get_exact_knn_method(aFlags)) {
+    case DVP_BF2_TREE_KNN:
+    case DVP_COB2_TREE_KNN:
+      return 2;
+    case DVP_BF4_TREE_KNN:
+    case DVP_COB4_TREE_KNN:
+      return 4;
+    default:
+      return 0;
+  };
+};
 
 
 
@@ -111,6 +162,19 @@ const std::size_t BIDIRECTIONAL_PLANNING       = 1 << 8;
 const std::size_t USE_BRANCH_AND_BOUND_PRUNING_FLAG = 0x01 << 10;
 
 
+/// This mask indicates how the expansions of the motion-graph should be executed during the motion planning.
+const std::size_t PLANNING_PARALLELISM_MASK = 0x1 << 11;
+
+/// This flag indicates that the motion-graph should be expanded sequentially (one expansion at a time).
+const std::size_t SEQUENTIAL_PLANNING       = 0;
+/// This flag indicates that the motion-graph should be expanded by several concurrent worker threads.
+/// The sampling, steering and collision-checking of the workers are done concurrently, while the 
+/// additions to the shared motion-graph (and associated NN structures) are synchronized.
+/// This requires the steering and collision-checking functions of the free-space to be reentrant.
+/// Only supported for some algorithms (RRT, SBA*), others ignore it.
+const std::size_t PARALLEL_PLANNING         = 1 << 11;
+
+
 
 
 
@@ -127,6 +191,8 @@ class planning_option_collection : public shared_object {
     double init_relax;
     double max_random_walk;
     double start_delay;
+    double knn_epsilon;
+    std::size_t knn_max_visits;
     
     planning_option_collection() : 
       planning_algo(0),
@@ -139,7 +205,9 @@ class planning_option_collection : public shared_object {
       init_SA_temp(0.0),
       init_relax(0.0),
       max_random_walk(1.0),
-      start_delay(20.0) { };
+      start_delay(20.0),
+      knn_epsilon(0.5),
+      knn_max_visits(0) { };
     
     
     std::string get_planning_algo_str() const {
@@ -171,6 +239,14 @@ class planning_option_collection : public shared_object {
           return "cob2";
         case DVP_COB4_TREE_KNN:
           return "cob4";
+        case DVP_BF2_APPROX_KNN:
+          return "bf2_approx";
+        case DVP_BF4_APPROX_KNN:
+          return "bf4_approx";
+        case DVP_COB2_APPROX_KNN:
+          return "cob2_approx";
+        case DVP_COB4_APPROX_KNN:
+          return "cob4_approx";
         default:
           return "";
       };
@@ -184,6 +260,8 @@ class planning_option_collection : public shared_object {
           return "dvp_adj_list";
         case LINKED_TREE_MOTION_GRAPH:
           return "linked_tree";
+        case CONCURRENT_MOTION_GRAPH:
+          return "concurrent";
         default:
           return "";
       };
@@ -199,6 +277,8 @@ class planning_option_collection : public shared_object {
         result += "_any";
       if( planning_options & PLAN_WITH_VORONOI_PULL )
         result += "_sa";
+      if( planning_options & PARALLEL_PLANNING )
+        result += "_par";
       return result;
     };
     
@@ -207,7 +287,7 @@ class planning_option_collection : public shared_object {
                    ReaK's RTTI and Serialization interfaces
 *******************************************************************************/
     
-    virtual void RK_CALL save(serialization::oarchive& A, unsigned int) const {
+    virtual void RK_CALL save(serialization::oarchive& A, unsigned int aVersion) const {
       shared_object::save(A,shared_object::getStaticObjectType()->TypeVersion());
       A & RK_SERIAL_SAVE_WITH_NAME(planning_algo)
         & RK_SERIAL_SAVE_WITH_NAME(max_vertices)
@@ -220,9 +300,12 @@ class planning_option_collection : public shared_object {
         & RK_SERIAL_SAVE_WITH_NAME(init_relax)
         & RK_SERIAL_SAVE_WITH_NAME(max_random_walk)
         & RK_SERIAL_SAVE_WITH_NAME(start_delay);
+      if(aVersion > 1)
+        A & RK_SERIAL_SAVE_WITH_NAME(knn_epsilon)
+          & RK_SERIAL_SAVE_WITH_NAME(knn_max_visits);
     };
     
-    virtual void RK_CALL load(serialization::iarchive& A, unsigned int) {
+    virtual void RK_CALL load(serialization::iarchive& A, unsigned int aVersion) {
       shared_object::load(A,shared_object::getStaticObjectType()->TypeVersion());
       A & RK_SERIAL_LOAD_WITH_NAME(planning_algo)
         & RK_SERIAL_LOAD_WITH_NAME(max_vertices)
@@ -235,9 +318,16 @@ class planning_option_collection : public shared_object {
         & RK_SERIAL_LOAD_WITH_NAME(init_relax)
         & RK_SERIAL_LOAD_WITH_NAME(max_random_walk)
         & RK_SERIAL_LOAD_WITH_NAME(start_delay);
+      if(aVersion > 1)
+        A & RK_SERIAL_LOAD_WITH_NAME(knn_epsilon)
+          & RK_SERIAL_LOAD_WITH_NAME(knn_max_visits);
+      else {
+        knn_epsilon = 0.5;
+        knn_max_visits = 0;
+      };
     };
     
-    RK_RTTI_MAKE_CONCRETE_1BASE(planning_option_collection,0xC2460019,1,"planning_option_collection",shared_object)
+    RK_RTTI_MAKE_CONCRETE_1BASE(planning_option_collection,0xC2460019,2,"planning_option_collection",shared_object)
     
     
 };
@@ -61,6 +61,7 @@ boost::program_options::options_description get_planning_option_po_desc() {
     
     ("no-lazy-connect", "if set, disable lazy connection strategy during planning.")
     ("bi-directional", "specify whether to use a bi-directional algorithm or not during planning. Only supported for some algorithms (RRT, RRT*, SBA*).")
+    ("parallel", "specify whether to expand the motion-graph with several concurrent worker threads during planning. Only supported for some algorithms (RRT, SBA*).")
     ("with-bnb", "specify whether to use a Branch-and-bound or not during planning to prune useless nodes from the motion-graph. Only supported for optimizing algorithms (RRT*, SBA*).")
     ("relaxation-factor", po::value< double >()->default_value(0.0), "specify the initial relaxation factor for the algorithm (default: 0.0). Only supported for heuristic-driven algorithms.")
 //     ("density-cutoff", po::value< double >()->default_value(0.0), "specify the density cutoff (default: 0.0). Only supported for density-driven algorithms.")
@@ -69,17 +70,19 @@ boost::program_options::options_description get_planning_option_po_desc() {
     
     ("knn-method", po::value< std::string >(), 
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
-     "specify the KNN method to use (supported options: linear, bf2, bf4, cob2, cob4) (default: bf2)"
+     "specify the KNN method to use (supported options: linear, bf2, bf4, cob2, cob4, bf2-approx, bf4-approx, cob2-approx, cob4-approx) (default: bf2)"
 #else
-     "specify the KNN method to use (supported options: linear, bf2, bf4) (default: bf2)"
+     "specify the KNN method to use (supported options: linear, bf2, bf4, bf2-approx, bf4-approx) (default: bf2)"
 #endif
     )
+    ("knn-epsilon", po::value< double >()->default_value(0.5), "specify the relative error allowed on the distances to the nearest-neighbors (default: 0.5). Only meaningful for the approximate KNN methods (e.g., bf2-approx).")
+    ("knn-max-visits", po::value< std::size_t >()->default_value(0), "specify the maximum number of nodes visited by a nearest-neighbor query (default: 0, i.e., no limit). Only meaningful for the approximate KNN methods (e.g., bf2-approx).")
     
     ("mg-storage", po::value< std::string >(), 
 #ifdef RK_PLANNERS_ENABLE_DVP_ADJ_LIST_LAYOUT
-     "specify the KNN method to use (supported options: adj-list, dvp-adj-list) (default: adj-list)"
+     "specify the KNN method to use (supported options: adj-list, dvp-adj-list, concurrent) (default: adj-list). Only the RRT planners accept the concurrent storage, the other planners reject it."
 #else
-     "specify the KNN method to use (supported options: adj-list) (default: adj-list)"
+     "specify the KNN method to use (supported options: adj-list, concurrent) (default: adj-list). Only the RRT planners accept the concurrent storage, the other planners reject it."
 #endif
     )
   ;
@@ -119,22 +122,39 @@ planning_option_collection get_planning_option_from_po(boost::program_options::v
   
   if(vm.count("knn-method")) {
     plan_options.knn_method = 0;
-    if((vm["knn-method"].as<std::string>() == "linear") && (vm["mg-storage"].as<std::string>() == "adj-list"))
+    if((vm["knn-method"].as<std::string>() == "linear") &&
+       ((vm["mg-storage"].as<std::string>() == "adj-list") || (vm["mg-storage"].as<std::string>() == "concurrent")))
       plan_options.knn_method |= LINEAR_SEARCH_KNN;
     else if(vm["knn-method"].as<std::string>() == "bf4")
       plan_options.knn_method |= DVP_BF4_TREE_KNN;
+    else if(vm["knn-method"].as<std::string>() == "bf2-approx")
+      plan_options.knn_method |= DVP_BF2_APPROX_KNN;
+    else if(vm["knn-method"].as<std::string>() == "bf4-approx")
+      plan_options.knn_method |= DVP_BF4_APPROX_KNN;
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
     else if(vm["knn-method"].as<std::string>() == "cob2")
       plan_options.knn_method |= DVP_COB2_TREE_KNN;
     else if(vm["knn-method"].as<std::string>() == "cob4")
       plan_options.knn_method |= DVP_COB4_TREE_KNN;
+    else if(vm["knn-method"].as<std::string>() == "cob2-approx")
+      plan_options.knn_method |= DVP_COB2_APPROX_KNN;
+    else if(vm["knn-method"].as<std::string>() == "cob4-approx")
+      plan_options.knn_method |= DVP_COB4_APPROX_KNN;
 #endif
     else
       plan_options.knn_method |= DVP_BF2_TREE_KNN;
   };
   
+  if(vm["knn-epsilon"].as<double>() != 0.5)
+    plan_options.knn_epsilon = vm["knn-epsilon"].as<double>();
+  if(vm["knn-max-visits"].as<std::size_t>() != 0)
+    plan_options.knn_max_visits = vm["knn-max-visits"].as<std::size_t>();
+  
   if( vm.count("mg-storage") ) {
     plan_options.store_policy = 0;
+    if(vm["mg-storage"].as<std::string>() == "concurrent")
+      plan_options.store_policy |= CONCURRENT_MOTION_GRAPH;
+    else
 #ifdef RK_PLANNERS_ENABLE_DVP_ADJ_LIST_LAYOUT
     if(vm["mg-storage"].as<std::string>() == "dvp-adj-list")
       plan_options.store_policy |= DVP_ADJ_LIST_MOTION_GRAPH;
@@ -149,6 +169,9 @@ planning_option_collection get_planning_option_from_po(boost::program_options::v
   if( vm.count("bi-directional") )
     plan_options.planning_options |= BIDIRECTIONAL_PLANNING;
   
+  if( vm.count("parallel") )
+    plan_options.planning_options |= PARALLEL_PLANNING;
+  
   if( vm.count("with-bnb") )
     plan_options.planning_options |= USE_BRANCH_AND_BOUND_PRUNING_FLAG;
   
@@ -75,17 +75,132 @@
 #include "vlist_sbmp_report.hpp"
 
 
+#include <ReaK/core/base/global_rng.hpp>
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/ctrl/topologies/subspace_concept.hpp>
+
 #include <boost/filesystem.hpp>
 
+#include <vector>
+#include <limits>
+
 
 namespace ReaK {
 
 namespace pp {
 
 
+/**
+ * This function creates a sample-based planner for point-to-point planning, as specified by the
+ * planning options (algorithm, storage policy, KNN method, etc.).
+ * \tparam Topology The topology type on which to plan.
+ * \param world_topo The topology on which to plan.
+ * \param plan_options The planning options.
+ * \param world_dimensionality The dimensionality of the topology (used for the neighborhood radii).
+ * \param report_chain The reporter chain that the planner should report to.
+ * \return The planner, or an empty pointer if the planning algorithm is not supported (or disabled).
+ */
+template <typename Topology>
+shared_ptr< sample_based_planner< Topology > > create_p2p_planner(const shared_ptr< Topology >& world_topo,
+                                                                   const planning_option_collection& plan_options,
+                                                                   std::size_t world_dimensionality,
+                                                                   any_sbmp_reporter_chain< Topology >& report_chain) {
+  
+  shared_ptr< sample_based_planner< Topology > > world_planner;
+  
+#ifndef RK_DISABLE_RRT_PLANNER
+  if( plan_options.planning_algo == 0 ) { // RRT
+    
+    world_planner = shared_ptr< sample_based_planner< Topology > >(
+      new rrt_planner< Topology >(
+        world_topo, plan_options.max_vertices, plan_options.prog_interval,
+        plan_options.store_policy | plan_options.knn_method,
+        plan_options.planning_options,
+        0.1, 0.05, report_chain));
+    
+  } else 
+#endif
+#ifndef RK_DISABLE_RRTSTAR_PLANNER
+  if( plan_options.planning_algo == 1 ) { // RRT*
+    
+    world_planner = shared_ptr< sample_based_planner< Topology > >(
+      new rrtstar_planner< Topology >(
+        world_topo, plan_options.max_vertices, plan_options.prog_interval,
+        plan_options.store_policy | plan_options.knn_method,
+        plan_options.planning_options,
+        0.1, 0.05, world_dimensionality, report_chain));
+    
+  } else 
+#endif
+#ifndef RK_DISABLE_PRM_PLANNER
+  if( plan_options.planning_algo == 2 ) { // PRM
+    
+    world_planner = shared_ptr< sample_based_planner< Topology > >(
+      new prm_planner< Topology >(
+        world_topo, plan_options.max_vertices, plan_options.prog_interval,
+        plan_options.store_policy | plan_options.knn_method,
+        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, report_chain));
+    
+  } else 
+#endif
+#ifndef RK_DISABLE_FADPRM_PLANNER
+  if( plan_options.planning_algo == 4 ) { // FADPRM
+    
+    shared_ptr< fadprm_planner< Topology > > tmp(
+      new fadprm_planner< Topology >(
+        world_topo, plan_options.max_vertices, plan_options.prog_interval,
+        plan_options.store_policy | plan_options.knn_method,
+        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, report_chain));
+    
+    tmp->set_initial_relaxation(plan_options.init_relax);
+    
+    world_planner = tmp;
+    
+  } else 
+#endif
+#ifndef RK_DISABLE_SBASTAR_PLANNER
+  if( plan_options.planning_algo == 3 ) { // SBA*
+    
+    shared_ptr< sbastar_planner< Topology > > tmp(
+      new sbastar_planner< Topology >(
+        world_topo, plan_options.max_vertices, plan_options.prog_interval,
+        plan_options.store_policy | plan_options.knn_method,
+        plan_options.planning_options,
+        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, report_chain));
+    
+    tmp->set_initial_density_threshold(0.0);
+    tmp->set_initial_relaxation(plan_options.init_relax);
+    tmp->set_initial_SA_temperature(plan_options.init_SA_temp);
+    
+    world_planner = tmp;
+    
+  } else 
+#endif
+  { };
+  
+  if( world_planner )
+    world_planner->set_knn_approximation(plan_options.knn_epsilon, plan_options.knn_max_visits);
+  
+  return world_planner;
+};
+
+
+
+/**
+ * This engine runs a number of Monte-Carlo trials of a planner on a point-to-point query and outputs
+ * the averaged progress records (vertex counts, times, costs) as well as the first solution event of
+ * each trial. Each trial re-seeds the random-number generator with the base seed plus the trial index.
+ * If the thread-count is not one, the trials are run concurrently on a thread-pool, each with its own
+ * planner, query, reporter chain and random-number stream, and the trial records are merged in trial
+ * order, such that the output files do not depend on the scheduling of the trials.
+ * \note Running trials concurrently requires the topology to be reentrant (see is_reentrant_space) 
+ *       and the random-number generator to be thread-local, otherwise the trials are run one at a time.
+ */
 struct monte_carlo_mp_engine {
   
   std::size_t mc_run_count;
+  std::size_t thread_count;  ///< Number of concurrent trials (1 for sequential, 0 for the number of hardware threads).
+  global_rng_type::result_type rng_seed;  ///< Base seed of the trials' random-number streams.
   
   std::ofstream timing_output;
   std::ofstream sol_events_output;
@@ -94,10 +209,138 @@ struct monte_carlo_mp_engine {
   std::stringstream cost_ss;
   std::stringstream sol_ss;
   
+  ReaKaux::mutex progress_mutex;
+  std::size_t completed_runs;
+  
+  std::vector< double > trial_best_costs;  ///< Best solution distance of each trial of the last run, in trial order.
+  
+  /// The outputs of the reporter chain of a single (concurrent) trial.
+  struct trial_record {
+    std::stringstream time_ss;
+    std::stringstream cost_ss;
+    std::stringstream sol_ss;
+    double best_cost;
+    
+    trial_record() : best_cost(std::numeric_limits<double>::infinity()) { };
+  };
+  
+  /// Accumulates the records of the trials (in the order that they are added).
+  struct trial_accumulator {
+    std::vector< double > vertex_counts;
+    std::vector< std::size_t > num_remaining_planners;
+    std::vector< std::size_t > num_successful_planners;
+    std::vector< double > time_values;
+    std::vector< double > best_costs;
+    std::vector< double > worst_costs;
+    std::vector< double > avg_costs;
+    
+    explicit trial_accumulator(std::size_t aNumRecords) : 
+      vertex_counts(aNumRecords, 0.0), num_remaining_planners(aNumRecords, 0),
+      num_successful_planners(aNumRecords, 0), time_values(aNumRecords, 0.0),
+      best_costs(aNumRecords, 1.0e10), worst_costs(aNumRecords, 0.0), avg_costs(aNumRecords, 0.0) { };
+    
+    void add_trial(std::istream& time_in, std::istream& cost_in, std::istream& sol_in, std::ostream& sol_events_out) {
+      std::size_t mc_num_records = vertex_counts.size();
+      std::size_t v_count = 0, t_val = 0; 
+      std::string tmp;
+      std::size_t j = 0;
+      while( (j < mc_num_records) && std::getline(time_in, tmp) && (tmp.size()) ) {
+        std::stringstream ss_tmp(tmp);
+        ss_tmp >> v_count >> t_val;
+        vertex_counts[j] = (double(v_count) + double(num_remaining_planners[j]) * vertex_counts[j]) / double(num_remaining_planners[j] + 1);
+        time_values[j] = (double(t_val) + double(num_remaining_planners[j]) * time_values[j]) / double(num_remaining_planners[j] + 1);
+        num_remaining_planners[j] += 1; 
+        ++j;
+      };
+      
+      double c_val = 1e10;
+      j = 0;
+      while( (j < mc_num_records) && std::getline(cost_in, tmp) && (tmp.size()) ) {
+        std::stringstream ss_tmp(tmp);
+        ss_tmp >> v_count >> c_val;
+        add_cost(j, c_val);
+        ++j;
+      };
+      
+      while(j < mc_num_records) {
+        add_cost(j, c_val);
+        ++j;
+      };
+      
+      std::string first_sol_event;
+      std::getline(sol_in, first_sol_event);
+      if(first_sol_event != "")
+        sol_events_out << first_sol_event << std::endl;
+    };
+    
+    void add_cost(std::size_t j, double c_val) {
+      if(c_val < best_costs[j])
+        best_costs[j] = c_val;
+      if(c_val > worst_costs[j])
+        worst_costs[j] = c_val;
+      if(c_val < 1.0e9) {
+        avg_costs[j] = (double(c_val) + double(num_successful_planners[j]) * avg_costs[j]) / double(num_successful_planners[j] + 1);
+        num_successful_planners[j] += 1;
+      };
+    };
+    
+    void print(std::ostream& timing_out) const {
+      for(std::size_t i = 0; i < vertex_counts.size(); ++i) {
+        timing_out << std::setw(9) << i 
+              << " " << std::setw(9) << vertex_counts[i] 
+              << " " << std::setw(9) << num_remaining_planners[i] 
+              << " " << std::setw(9) << num_successful_planners[i] 
+              << " " << std::setw(9) << time_values[i] 
+              << " " << std::setw(9) << best_costs[i] 
+              << " " << std::setw(9) << worst_costs[i] 
+              << " " << std::setw(9) << avg_costs[i] << std::endl; 
+      };
+    };
+  };
+  
+  /// A task that runs a single trial on its own planner, query and reporter chain.
+  template <typename Topology>
+  struct trial_task {
+    monte_carlo_mp_engine* p_engine;
+    trial_record* p_record;
+    std::size_t trial_id;
+    const shared_ptr< Topology >* p_world_topo;
+    const planning_option_collection* p_plan_options;
+    std::size_t world_dimensionality;
+    const typename topology_traits<Topology>::point_type* p_start;
+    const typename topology_traits<Topology>::point_type* p_goal;
+    
+    void operator()() const {
+      seed_global_rng(p_engine->rng_seed + global_rng_type::result_type(trial_id));
+      
+      p_record->cost_ss << std::fixed;
+      p_record->sol_ss << std::fixed;
+      any_sbmp_reporter_chain< Topology > report_chain;
+      report_chain.add_reporter( timing_sbmp_report<>(p_record->time_ss) );
+      report_chain.add_reporter( least_cost_sbmp_report<>(p_record->cost_ss, &(p_record->sol_ss)) );
+      
+      path_planning_p2p_query< Topology > pp_query("pp_query", *p_world_topo, *p_start, *p_goal, p_plan_options->max_results);
+      
+      shared_ptr< sample_based_planner< Topology > > planner = 
+        create_p2p_planner(*p_world_topo, *p_plan_options, world_dimensionality, report_chain);
+      if(planner)
+        planner->solve_planning_query(pp_query);
+      p_record->best_cost = pp_query.get_best_solution_distance();
+      
+      p_engine->report_completed_run();
+    };
+  };
+  
   monte_carlo_mp_engine(std::size_t aMCRuns, 
                         const std::string& aPlannerName,
-                        const std::string& aOutputPathStem) : 
-                        mc_run_count(aMCRuns) {
+                        const std::string& aOutputPathStem,
+                        std::size_t aThreadCount = 1,
+                        global_rng_type::result_type aRNGSeed = 0) : 
+                        mc_run_count(aMCRuns), thread_count(aThreadCount), 
+                        rng_seed(aRNGSeed), completed_runs(0) {
+    
+    if(rng_seed == 0)
+      rng_seed = boost::random::random_device()();
     
     boost::filesystem::create_directory(aOutputPathStem.c_str());
     
@@ -109,6 +352,11 @@ struct monte_carlo_mp_engine {
     std::cout << "Running " << aPlannerName << std::endl;
   };
   
+  void report_completed_run() {
+    ReaKaux::unique_lock< ReaKaux::mutex > lock_here(progress_mutex);
+    std::cout << "\r" << std::setw(10) << (completed_runs++) << std::flush;
+  };
+  
   template <typename Topology>
   shared_ptr< any_sbmp_reporter_chain< Topology > > create_reporter(shared_ptr< Topology >) {
     
@@ -121,23 +369,20 @@ struct monte_carlo_mp_engine {
     return report_chain;
   };
   
+  /**
+   * Runs the trials sequentially, re-using the given planner and query (and the reporter chain
+   * obtained from create_reporter).
+   */
   template <typename Topology>
   void operator()(const planning_option_collection& plan_options,
                   shared_ptr< sample_based_planner< Topology > > planner,
                   planning_query< Topology >& mc_query) {
-    std::size_t mc_num_records = plan_options.max_vertices / plan_options.prog_interval;
-    
-    std::vector< double > vertex_counts(mc_num_records, 0.0);
-    std::vector< std::size_t > num_remaining_planners(mc_num_records, 0);
-    std::vector< std::size_t > num_successful_planners(mc_num_records, 0);
-    std::vector< double > time_values(mc_num_records, 0.0);
-    std::vector< double > best_costs(mc_num_records, 1.0e10);
-    std::vector< double > worst_costs(mc_num_records, 0.0);
-    std::vector< double > avg_costs(mc_num_records, 0.0);
+    trial_accumulator accum(plan_options.max_vertices / plan_options.prog_interval);
     
     cost_ss << std::fixed;
     sol_ss << std::fixed;
     
+    trial_best_costs.clear();
     for(std::size_t i = 0; i < mc_run_count; ++i) {
       time_ss.clear();
       cost_ss.clear();
@@ -145,65 +390,68 @@ struct monte_carlo_mp_engine {
       
       std::cout << "\r" << std::setw(10) << i << std::flush;
       
+      seed_global_rng(rng_seed + global_rng_type::result_type(i));
       mc_query.reset_solution_records();
       planner->reset_internal_state();
       planner->solve_planning_query(mc_query);
+      trial_best_costs.push_back(mc_query.get_best_solution_distance());
       
-      std::size_t v_count = 0, t_val = 0; 
-      std::string tmp;
-      std::size_t j = 0;
-      while( std::getline(time_ss, tmp) && (tmp.size()) ) {
-        std::stringstream ss_tmp(tmp);
-        ss_tmp >> v_count >> t_val;
-        vertex_counts[j] = (double(v_count) + double(num_remaining_planners[j]) * vertex_counts[j]) / double(num_remaining_planners[j] + 1);
-        time_values[j] = (double(t_val) + double(num_remaining_planners[j]) * time_values[j]) / double(num_remaining_planners[j] + 1);
-        num_remaining_planners[j] += 1; 
-        ++j;
-      };
-      
-      double c_val = 1e10;
-      j = 0;
-      while( std::getline(cost_ss, tmp) && (tmp.size()) ) {
-        std::stringstream ss_tmp(tmp);
-        ss_tmp >> v_count >> c_val;
-        if(c_val < best_costs[j])
-          best_costs[j] = c_val;
-        if(c_val > worst_costs[j])
-          worst_costs[j] = c_val;
-        if(c_val < 1.0e9) {
-          avg_costs[j] = (double(c_val) + double(num_successful_planners[j]) * avg_costs[j]) / double(num_successful_planners[j] + 1);
-          num_successful_planners[j] += 1;
-        };
-        ++j;
-      };
-      
-      while(j < mc_num_records) {
-        if(c_val < best_costs[j])
-          best_costs[j] = c_val;
-        if(c_val > worst_costs[j])
-          worst_costs[j] = c_val;
-        if(c_val < 1.0e9) {
-          avg_costs[j] = (double(c_val) + double(num_successful_planners[j]) * avg_costs[j]) / double(num_successful_planners[j] + 1);
-          num_successful_planners[j] += 1;
-        };
-        ++j;
+      accum.add_trial(time_ss, cost_ss, sol_ss, sol_events_output);
+    };
+    accum.print(timing_output);
+    
+    std::cout << "Done!" << std::endl;
+  };
+  
+  /**
+   * Runs the trials concurrently on a thread-pool of thread_count workers. Each trial
+   * creates its own planner, point-to-point query and reporter chain, and the trial records
+   * are merged in trial order once all the trials are completed. All the trials plan in the 
+   * same topology, so, if it is not reentrant (see is_reentrant_space), a single worker is used.
+   */
+  template <typename Topology>
+  void operator()(const planning_option_collection& plan_options,
+                  const shared_ptr< Topology >& world_topo,
+                  std::size_t world_dimensionality,
+                  const typename topology_traits<Topology>::point_type& p_start,
+                  const typename topology_traits<Topology>::point_type& p_goal) {
+    trial_accumulator accum(plan_options.max_vertices / plan_options.prog_interval);
+    
+    std::size_t worker_count = thread_count;
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    if( !is_reentrant_space< Topology >::type::value )
+      worker_count = 1;
+#else
+    worker_count = 1;  // the trials' random-number streams would be shared.
+#endif
+    
+    std::vector< shared_ptr< trial_record > > records(mc_run_count);
+    completed_runs = 0;
+    {
+      thread_pool pool(worker_count);
+      for(std::size_t i = 0; i < mc_run_count; ++i) {
+        records[i] = shared_ptr< trial_record >(new trial_record());
+        trial_task< Topology > task;
+        task.p_engine = this;
+        task.p_record = records[i].get();
+        task.trial_id = i;
+        task.p_world_topo = &world_topo;
+        task.p_plan_options = &plan_options;
+        task.world_dimensionality = world_dimensionality;
+        task.p_start = &p_start;
+        task.p_goal = &p_goal;
+        pool.schedule(task);
       };
-      
-      std::string first_sol_event;
-      std::getline(sol_ss, first_sol_event);
-      if(first_sol_event != "")
-        sol_events_output << first_sol_event << std::endl;
+      pool.wait();
     };
-    for(std::size_t i = 0; i < mc_num_records; ++i) {
-      timing_output << std::setw(9) << i 
-            << " " << std::setw(9) << vertex_counts[i] 
-            << " " << std::setw(9) << num_remaining_planners[i] 
-            << " " << std::setw(9) << num_successful_planners[i] 
-            << " " << std::setw(9) << time_values[i] 
-            << " " << std::setw(9) << best_costs[i] 
-            << " " << std::setw(9) << worst_costs[i] 
-            << " " << std::setw(9) << avg_costs[i] << std::endl; 
+    
+    trial_best_costs.clear();
+    for(std::size_t i = 0; i < mc_run_count; ++i) {
+      accum.add_trial(records[i]->time_ss, records[i]->cost_ss, records[i]->sol_ss, sol_events_output);
+      trial_best_costs.push_back(records[i]->best_cost);
+      records[i].reset();
     };
+    accum.print(timing_output);
     
     std::cout << "Done!" << std::endl;
   };
@@ -335,77 +583,45 @@ void execute_p2p_planner(const shared_ptr< Topology >& world_topo,
   path_planning_p2p_query< Topology > pp_query("pp_query", world_topo, p_start, p_goal, plan_options.max_results);
   
   // Create the planner:
-  shared_ptr< sample_based_planner< Topology > > world_planner;
+  shared_ptr< sample_based_planner< Topology > > world_planner = 
+    create_p2p_planner(world_topo, plan_options, world_dimensionality, *p_report_chain);
   
-#ifndef RK_DISABLE_RRT_PLANNER
-  if( plan_options.planning_algo == 0 ) { // RRT
-    
-    world_planner = shared_ptr< sample_based_planner< Topology > >(
-      new rrt_planner< Topology >(
-        world_topo, plan_options.max_vertices, plan_options.prog_interval,
-        plan_options.store_policy | plan_options.knn_method,
-        plan_options.planning_options,
-        0.1, 0.05, *p_report_chain));
-    
-  } else 
-#endif
-#ifndef RK_DISABLE_RRTSTAR_PLANNER
-  if( plan_options.planning_algo == 1 ) { // RRT*
-    
-    world_planner = shared_ptr< sample_based_planner< Topology > >(
-      new rrtstar_planner< Topology >(
-        world_topo, plan_options.max_vertices, plan_options.prog_interval,
-        plan_options.store_policy | plan_options.knn_method,
-        plan_options.planning_options,
-        0.1, 0.05, world_dimensionality, *p_report_chain));
-    
-  } else 
-#endif
-#ifndef RK_DISABLE_PRM_PLANNER
-  if( plan_options.planning_algo == 2 ) { // PRM
-    
-    world_planner = shared_ptr< sample_based_planner< Topology > >(
-      new prm_planner< Topology >(
-        world_topo, plan_options.max_vertices, plan_options.prog_interval,
-        plan_options.store_policy | plan_options.knn_method,
-        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, *p_report_chain));
-    
-  } else 
-#endif
-#ifndef RK_DISABLE_FADPRM_PLANNER
-  if( plan_options.planning_algo == 4 ) { // FADPRM
-    
-    shared_ptr< fadprm_planner< Topology > > tmp(
-      new fadprm_planner< Topology >(
-        world_topo, plan_options.max_vertices, plan_options.prog_interval,
-        plan_options.store_policy | plan_options.knn_method,
-        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, *p_report_chain));
-    
-    tmp->set_initial_relaxation(plan_options.init_relax);
-    
-    world_planner = tmp;
-    
-  } else 
-#endif
-#ifndef RK_DISABLE_SBASTAR_PLANNER
-  if( plan_options.planning_algo == 3 ) { // SBA*
-    
-    shared_ptr< sbastar_planner< Topology > > tmp(
-      new sbastar_planner< Topology >(
-        world_topo, plan_options.max_vertices, plan_options.prog_interval,
-        plan_options.store_policy | plan_options.knn_method,
-        plan_options.planning_options,
-        0.1, 0.05, plan_options.max_random_walk, world_dimensionality, *p_report_chain));
-    
-    tmp->set_initial_density_threshold(0.0);
-    tmp->set_initial_relaxation(plan_options.init_relax);
-    tmp->set_initial_SA_temperature(plan_options.init_SA_temp);
-    
-    world_planner = tmp;
-    
-  } else 
-#endif
-  { };
+  if(!world_planner)
+    return;
+  
+  // Solve the planning problem:
+  engine(plan_options, world_planner, pp_query);
+  
+};
+
+
+
+/**
+ * This overload executes a point-to-point planner with the Monte-Carlo engine, running the
+ * trials concurrently if the engine's thread-count is not one (see monte_carlo_mp_engine).
+ */
+template <typename Topology>
+void execute_p2p_planner(const shared_ptr< Topology >& world_topo,
+                         const planning_option_collection& plan_options,
+                         std::size_t world_dimensionality,
+                         monte_carlo_mp_engine& engine,
+                         const typename topology_traits<Topology>::point_type& p_start,
+                         const typename topology_traits<Topology>::point_type& p_goal) {
+  
+  if(engine.thread_count != 1) {
+    engine(plan_options, world_topo, world_dimensionality, p_start, p_goal);
+    return;
+  };
+  
+  // Create the reporter chain.
+  shared_ptr< any_sbmp_reporter_chain< Topology > > p_report_chain = engine.create_reporter(world_topo);
+  
+  // Create the point-to-point query:
+  path_planning_p2p_query< Topology > pp_query("pp_query", world_topo, p_start, p_goal, plan_options.max_results);
+  
+  // Create the planner:
+  shared_ptr< sample_based_planner< Topology > > world_planner = 
+    create_p2p_planner(world_topo, plan_options, world_dimensionality, *p_report_chain);
   
   if(!world_planner)
     return;
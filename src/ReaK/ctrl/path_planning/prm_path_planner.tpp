@@ -55,8 +55,13 @@
 #include "path_planner_options.hpp"
 #include "any_motion_graphs.hpp"
 #include "density_plan_visitors.hpp"
+#include "roadmap_cache.hpp"
 
 #include <boost/graph/astar_search.hpp>
+#include <boost/graph/filtered_graph.hpp>
+
+#include <set>
+#include <stdexcept>
 
 namespace ReaK {
   
@@ -209,7 +214,9 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
 #define RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO(ARITY, TREE_STORAGE) \
   typedef typename boost::property_map< MotionGraphType, PointType BasicVertexProp::* >::type GraphPositionMap; \
   typedef dvp_tree<Vertex, SuperSpace, GraphPositionMap, ARITY, random_vp_chooser, TREE_STORAGE > SpacePartType; \
-  SpacePartType space_part(motion_graph, sup_space_ptr, get(&BasicVertexProp::position, motion_graph)); \
+  SpacePartType space_part(motion_graph, cached_layout.begin(), cached_layout.end(), sup_space_ptr, get(&BasicVertexProp::position, motion_graph)); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
     \
   typedef multi_dvp_tree_search<MotionGraphType, SpacePartType> NNFinderType; \
   NNFinderType nn_finder; \
@@ -232,6 +239,8 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   typedef typename boost::graph_traits<MotionGraphType>::vertex_descriptor Vertex; \
    \
   ALTGraph space_part(sup_space_ptr, pos_map); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
   MotionGraphType motion_graph = space_part.get_adjacency_list(); \
    \
   typedef multi_dvp_tree_search<MotionGraphType, ALTGraph> NNFinderType; \
@@ -247,6 +256,69 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   
   
   
+#define RK_PRM_PLANNER_LOAD_ROADMAP_CACHE \
+  typedef boost::data_member_property_map<double, EdgeProp > WeightMap; \
+  std::vector< dvp_tree_layout_record<Vertex, double> > cached_layout; \
+  bool roadmap_loaded = false; \
+  boost::uint64_t env_hash = ( this->uses_roadmap_cache() ? get_roadmap_environment_hash(*(this->m_space)) : 0 ); \
+  if( this->uses_roadmap_cache() && \
+      load_roadmap_cache(this->m_roadmap_cache_file, motion_graph, pos_map, dens_map, \
+                         WeightMap(&EdgeProp::weight), std::back_inserter(cached_layout), \
+                         get_knn_tree_arity(this->m_data_structure_flags), \
+                         get_exact_knn_method(this->m_data_structure_flags), env_hash) ) { \
+    roadmap_loaded = true; \
+    typename boost::graph_traits<MotionGraphType>::vertex_iterator vi, vi_end; \
+    for(boost::tie(vi, vi_end) = vertices(motion_graph); vi != vi_end; ++vi) { \
+      motion_graph[*vi].heuristic_value = aQuery.get_heuristic_to_goal(motion_graph[*vi].position); \
+      motion_graph[*vi].distance_accum = std::numeric_limits<double>::infinity(); \
+      motion_graph[*vi].predecessor = *vi; \
+    }; \
+  };
+  
+  
+#define RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE \
+  std::set<Vertex> query_nodes; \
+  query_nodes.insert(start_node); \
+  if( p2p_query_ptr ) \
+    query_nodes.insert(boost::any_cast<Vertex>(vis.m_goal_node)); \
+  bool solved_from_cache = false; \
+  if( roadmap_loaded && p2p_query_ptr ) { \
+    Vertex goal_node = boost::any_cast<Vertex>(vis.m_goal_node); \
+    connect_to_roadmap(start_node, false, motion_graph, *sup_space_ptr, vis, pos_map, nc_selector); \
+    connect_to_roadmap(goal_node, true, motion_graph, *sup_space_ptr, vis, pos_map, nc_selector); \
+    solved_from_cache = find_checked_roadmap_path(motion_graph, start_node, goal_node, \
+                                                  get(&VertexProp::heuristic_value, motion_graph), \
+                                                  get(&VertexProp::predecessor, motion_graph), \
+                                                  get(&VertexProp::distance_accum, motion_graph), \
+                                                  get(&VertexProp::key_value, motion_graph), \
+                                                  get(&EdgeProp::weight, motion_graph), \
+                                                  get(&VertexProp::astar_color, motion_graph), vis); \
+    if( solved_from_cache ) \
+      vis.publish_path(motion_graph); \
+  };
+  
+  
+#define RK_PRM_PLANNER_SAVE_ROADMAP_CACHE \
+  if( this->uses_roadmap_cache() ) \
+    save_roadmap_cache(this->m_roadmap_cache_file, \
+                       boost::make_filtered_graph(motion_graph, boost::keep_all(), \
+                                                  boost::is_not_in_subset< std::set<Vertex> >(query_nodes)), \
+                       pos_map, dens_map, \
+                       WeightMap(&EdgeProp::weight), cached_layout.begin(), cached_layout.end(), \
+                       get_knn_tree_arity(this->m_data_structure_flags), \
+                       get_exact_knn_method(this->m_data_structure_flags), env_hash);
+  
+  
+#define RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT \
+  if( this->uses_roadmap_cache() ) { \
+    for(typename std::set<Vertex>::const_iterator qi = query_nodes.begin(); qi != query_nodes.end(); ++qi) \
+      space_part.erase(*qi); \
+    cached_layout.clear(); \
+    space_part.export_layout(std::back_inserter(cached_layout)); \
+    RK_PRM_PLANNER_SAVE_ROADMAP_CACHE \
+  };
+  
+  
 #define RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL \
   ReaK::graph::generate_prm(motion_graph, *sup_space_ptr, \
                             vis, pos_map, get(random_sampler, *sup_space_ptr), \
@@ -254,6 +326,10 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   
   
   
+  // the concurrent motion-graph storage is only implemented for the RRT planner:
+  if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == CONCURRENT_MOTION_GRAPH)
+    throw std::invalid_argument("The PRM planner does not support the CONCURRENT_MOTION_GRAPH storage, use ADJ_LIST_MOTION_GRAPH instead!");
+  
   if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == ADJ_LIST_MOTION_GRAPH) {
     
     typedef boost::adjacency_list_BC< boost::vecBC, boost::vecBC, DirectionalityTag, VertexProp, EdgeProp> MotionGraphType;
@@ -261,9 +337,11 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
     
     MotionGraphType motion_graph;
     
+    RK_PRM_PLANNER_LOAD_ROADMAP_CACHE
+    
     RK_PRM_PLANNER_INITIALIZE_START_AND_GOAL
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == LINEAR_SEARCH_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == LINEAR_SEARCH_KNN) {
       
       typedef linear_neighbor_search<MotionGraphType> NNFinderType;
       NNFinderType nn_finder;
@@ -274,33 +352,73 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       any_knn_synchro NN_synchro;
       vis.m_nn_synchro = &NN_synchro;
       
-      RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+      RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+      
+      if( !solved_from_cache ) {
+        
+        RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+        
+        RK_PRM_PLANNER_SAVE_ROADMAP_CACHE
+        
+      };
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
       
-      RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+      RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+      
+      if( !solved_from_cache ) {
+        
+        RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+        
+        RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT
+        
+      };
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
       
-      RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+      RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+      
+      if( !solved_from_cache ) {
+        
+        RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+        
+        RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT
+        
+      };
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
       
-      RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+      RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+      
+      if( !solved_from_cache ) {
+        
+        RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+        
+        RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT
+        
+      };
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
       
-      RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+      RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+      
+      if( !solved_from_cache ) {
+        
+        RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
+        
+        RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT
+        
+      };
       
 #endif
       
@@ -310,7 +428,7 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
     
   } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == DVP_ADJ_LIST_MOTION_GRAPH) {
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_ALT_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
       
@@ -318,7 +436,7 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       
       RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_ALT_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
       
@@ -328,7 +446,7 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_ALT_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
       
@@ -336,7 +454,7 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       
       RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       RK_PRM_PLANNER_SETUP_ALT_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
       
@@ -353,6 +471,10 @@ void prm_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   };
   
 #undef RK_PRM_PLANNER_INITIALIZE_START_AND_GOAL
+#undef RK_PRM_PLANNER_LOAD_ROADMAP_CACHE
+#undef RK_PRM_PLANNER_SOLVE_FROM_ROADMAP_CACHE
+#undef RK_PRM_PLANNER_SAVE_ROADMAP_CACHE
+#undef RK_PRM_PLANNER_SAVE_ROADMAP_CACHE_WITH_LAYOUT
 #undef RK_PRM_PLANNER_SETUP_DVP_TREE_SYNCHRO
 #undef RK_PRM_PLANNER_SETUP_ALT_TREE_SYNCHRO
 #undef RK_PRM_PLANNER_MAKE_GENERATE_PRM_CALL
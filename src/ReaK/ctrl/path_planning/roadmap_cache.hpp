@@ -0,0 +1,669 @@
+/**
+ * \file roadmap_cache.hpp
+ *
+ * This library provides functions to save a probabilistic roadmap (the motion-graph of a PRM or
+ * FADPRM planner) to a compact binary file and to load it back, such that a roadmap can be built
+ * once and re-used by later planning queries (e.g., across runs of a program). The file contains
+ * the positions and densities of the vertices, the edges with their travel-costs and, optionally,
+ * the layout of the DVP-tree that indexes the vertices, such that the nearest-neighbor index
+ * can be re-created without re-computing any of its vantage-point partitions. The file is read
+ * through a read-only memory-mapping of it. The file records a hash of the environment (the 
+ * free-space topology, with its obstacles) in which the roadmap was built, such that a roadmap 
+ * is never re-used in a different environment.
+ *
+ * \author Sven Mikael Persson <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_ROADMAP_CACHE_HPP
+#define REAK_ROADMAP_CACHE_HPP
+
+#include <ReaK/core/base/defs.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+#include <ReaK/core/lin_alg/arithmetic_tuple.hpp>
+#include <ReaK/core/serialization/bin_archiver.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/astar_search.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// BGL-Extra includes:
+#include <boost/graph/more_property_maps.hpp>
+
+#include "dvp_tree_detail.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+#include <functional>
+
+
+namespace ReaK {
+
+namespace pp {
+
+
+namespace detail {
+
+  /* Header of a roadmap cache file, all the fields are stored in the native byte-order. */
+  struct roadmap_cache_header {
+    char magic[8];
+    boost::uint32_t byte_order;
+    boost::uint32_t version;
+    boost::uint64_t point_dimension;
+    boost::uint64_t vertex_count;
+    boost::uint64_t edge_count;
+    boost::uint64_t layout_count;
+    boost::uint32_t layout_arity;  // arity of the DVP-tree of the layout.
+    boost::uint32_t layout_kind;   // kind of DVP-tree of the layout (e.g., a KNN method flag), as given by the user.
+    boost::uint64_t environment_hash;  // hash of the environment in which the roadmap was built (see get_roadmap_environment_hash).
+  };
+
+  /* Edge record of a roadmap cache file, with the vertices given by their index in the file. */
+  struct roadmap_cache_edge {
+    boost::uint64_t source;
+    boost::uint64_t target;
+    double weight;
+  };
+
+  /* DVP-tree layout record of a roadmap cache file, with the key given by its vertex index in the file. */
+  struct roadmap_cache_layout_node {
+    boost::uint64_t key;
+    boost::uint64_t child_count;
+    double mu;
+  };
+
+  static const char roadmap_cache_magic[8] = {'R','K','R','D','M','A','P','\0'};
+  static const boost::uint32_t roadmap_cache_byte_order = 0x01020304;
+  static const boost::uint32_t roadmap_cache_version = 3;
+  
+  /* Adds the edge from u to v to a roadmap if the visitor finds that they can be connected, returns true if the edge was added. */
+  template <typename Vertex, typename EdgeProp, typename Graph, typename ConnectorVisitor>
+  bool try_roadmap_connection(Vertex u, Vertex v, Graph& g, const ConnectorVisitor& conn_vis) {
+    typedef typename boost::graph_traits<Graph>::edge_descriptor Edge;
+    
+    EdgeProp ep; bool can_connect;
+    boost::tie(can_connect, ep) = conn_vis.can_be_connected(u, v, g);
+    if(!can_connect)
+      return false;
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    std::pair<Edge, bool> e_new = add_edge(u, v, std::move(ep), g);
+#else
+    std::pair<Edge, bool> e_new = add_edge(u, v, ep, g);
+#endif
+    return e_new.second;
+  };
+  
+  /* A* heuristic that reads the heuristic value of a vertex from a property-map. */
+  template <typename HeuristicMap>
+  struct roadmap_heuristic {
+    HeuristicMap m_heuristic;
+    explicit roadmap_heuristic(HeuristicMap aHeuristic) : m_heuristic(aHeuristic) { };
+    template <typename Vertex>
+    double operator()(Vertex u) const { return get(m_heuristic, u); };
+  };
+
+};
+
+
+/**
+ * This function computes a hash of the environment in which a roadmap is built, to be recorded 
+ * in (and checked against) a roadmap cache file. The hash is computed (FNV-1a) over the binary 
+ * serialization of the given topology, such that any change to that topology (e.g., to the 
+ * obstacles or to the bounds of a free-space) gives a different hash, with high probability.
+ * \tparam Topology The topology type, should be serializable (e.g., a free-space of a planner).
+ * \param aSpace The topology in which the roadmap is built.
+ * \return The hash value of the environment.
+ */
+template <typename Topology>
+boost::uint64_t get_roadmap_environment_hash(const Topology& aSpace) {
+  std::stringstream ss;
+  {
+    serialization::bin_oarchive out(ss);
+    out << aSpace;
+  };
+  const std::string data = ss.str();
+  boost::uint64_t result = UINT64_C(14695981039346656037);
+  for(std::string::const_iterator it = data.begin(); it != data.end(); ++it) {
+    result ^= static_cast<unsigned char>(*it);
+    result *= UINT64_C(1099511628211);
+  };
+  return result;
+};
+
+
+/**
+ * This function saves a roadmap (motion-graph) to a roadmap cache file. The vertex, edge and
+ * DVP-tree layout records are written as flat arrays in the native byte-order. The file is 
+ * first written to a temporary file (in the same directory) which then replaces the target 
+ * file, such that a reader never sees a partially written roadmap.
+ * \tparam Graph The motion-graph type, should model the boost::VertexListGraphConcept and boost::EdgeListGraphConcept.
+ * \tparam PositionMap The property-map type that maps a vertex-property (bundle) to its position.
+ * \tparam DensityMap The property-map type that maps a vertex-property (bundle) to its density value.
+ * \tparam WeightMap The property-map type that maps an edge-property (bundle) to its travel-cost.
+ * \tparam LayoutIterator An input-iterator type over DVP-tree layout records (see dvp_tree_layout_record) keyed by graph vertices.
+ * \param aFileName The name of the file to which the roadmap is saved (overwritten if it exists).
+ * \param g The motion-graph to be saved.
+ * \param aPosition The property-map that maps a vertex-property (bundle) to its position.
+ * \param aDensity The property-map that maps a vertex-property (bundle) to its density value.
+ * \param aWeight The property-map that maps an edge-property (bundle) to its travel-cost.
+ * \param aLayoutBegin The start of the range of DVP-tree layout records (as exported by dvp_tree::export_layout).
+ * \param aLayoutEnd The end of the range of DVP-tree layout records (one-past-last).
+ * \param aLayoutArity The arity of the DVP-tree from which the layout was exported.
+ * \param aLayoutKind The kind of DVP-tree from which the layout was exported (e.g., its KNN method flag), 
+ *                    which is only compared to the kind expected when loading the roadmap.
+ * \param aEnvironmentHash The hash of the environment in which the roadmap was built (see get_roadmap_environment_hash).
+ * \throw std::runtime_error If the file cannot be written.
+ * \throw std::invalid_argument If a layout record has more children than the arity of the DVP-tree, 
+ *                              or if an edge or a layout record refers to a vertex that is not in the graph.
+ */
+template <typename Graph, typename PositionMap, typename DensityMap, typename WeightMap, typename LayoutIterator>
+void save_roadmap_cache(const std::string& aFileName, const Graph& g,
+                        PositionMap aPosition, DensityMap aDensity, WeightMap aWeight,
+                        LayoutIterator aLayoutBegin, LayoutIterator aLayoutEnd,
+                        std::size_t aLayoutArity, std::size_t aLayoutKind,
+                        boost::uint64_t aEnvironmentHash = 0) {
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef typename boost::graph_traits<Graph>::vertex_iterator VertexIter;
+  typedef typename boost::graph_traits<Graph>::edge_iterator EdgeIter;
+
+  typedef boost::unordered_map< Vertex, boost::uint64_t, detail::dvp_tree_key_hasher > IndexMap;
+  
+  IndexMap v_index;
+  std::vector<double> v_data;
+  std::size_t point_dim = 0;
+  VertexIter vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    vect_n<double> v_pos = to_vect<double>(get(aPosition, g[*vi]));
+    if(v_index.empty())
+      point_dim = v_pos.size();
+    else if(v_pos.size() != point_dim)
+      throw std::runtime_error("Cannot save a roadmap with points of different dimensions!");
+    boost::uint64_t new_index = v_index.size();
+    v_index[*vi] = new_index;
+    v_data.insert(v_data.end(), v_pos.begin(), v_pos.end());
+    v_data.push_back(get(aDensity, g[*vi]));
+  };
+
+  std::vector<detail::roadmap_cache_edge> e_data;
+  EdgeIter ei, ei_end;
+  for(boost::tie(ei, ei_end) = edges(g); ei != ei_end; ++ei) {
+    typename IndexMap::const_iterator u_it = v_index.find(source(*ei, g));
+    typename IndexMap::const_iterator v_it = v_index.find(target(*ei, g));
+    if( ( u_it == v_index.end() ) || ( v_it == v_index.end() ) )
+      throw std::invalid_argument("Cannot save a roadmap with an edge to a vertex that is not in the roadmap!");
+    detail::roadmap_cache_edge rec;
+    rec.source = u_it->second;
+    rec.target = v_it->second;
+    rec.weight = get(aWeight, g[*ei]);
+    e_data.push_back(rec);
+  };
+
+  std::vector<detail::roadmap_cache_layout_node> l_data;
+  for(; aLayoutBegin != aLayoutEnd; ++aLayoutBegin) {
+    if(aLayoutBegin->child_count > aLayoutArity)
+      throw std::invalid_argument("Cannot save a DVP-tree layout with more children per node than the arity of the tree!");
+    typename IndexMap::const_iterator k_it = v_index.find(aLayoutBegin->key);
+    if( k_it == v_index.end() )
+      throw std::invalid_argument("Cannot save a DVP-tree layout with a key that is not a vertex of the roadmap!");
+    detail::roadmap_cache_layout_node rec;
+    rec.key = k_it->second;
+    rec.child_count = aLayoutBegin->child_count;
+    rec.mu = aLayoutBegin->mu;
+    l_data.push_back(rec);
+  };
+
+  detail::roadmap_cache_header hdr;
+  std::memcpy(hdr.magic, detail::roadmap_cache_magic, sizeof(hdr.magic));
+  hdr.byte_order = detail::roadmap_cache_byte_order;
+  hdr.version = detail::roadmap_cache_version;
+  hdr.point_dimension = point_dim;
+  hdr.vertex_count = v_index.size();
+  hdr.edge_count = e_data.size();
+  hdr.layout_count = l_data.size();
+  hdr.layout_arity = static_cast<boost::uint32_t>(aLayoutArity);
+  hdr.layout_kind = static_cast<boost::uint32_t>(aLayoutKind);
+  hdr.environment_hash = aEnvironmentHash;
+
+  // write to a temporary file in the same directory, and then replace the target file by it:
+  const std::string tmp_file_name = aFileName + ".tmp";
+  {
+    std::ofstream out_file(tmp_file_name.c_str(), std::ios::binary | std::ios::trunc);
+    out_file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    if(!v_data.empty())
+      out_file.write(reinterpret_cast<const char*>(&v_data[0]), v_data.size() * sizeof(double));
+    if(!e_data.empty())
+      out_file.write(reinterpret_cast<const char*>(&e_data[0]), e_data.size() * sizeof(detail::roadmap_cache_edge));
+    if(!l_data.empty())
+      out_file.write(reinterpret_cast<const char*>(&l_data[0]), l_data.size() * sizeof(detail::roadmap_cache_layout_node));
+    out_file.close();
+    if(!out_file) {
+      std::remove(tmp_file_name.c_str());
+      throw std::runtime_error("Could not write the roadmap cache file '" + aFileName + "'!");
+    };
+  };
+  if(std::rename(tmp_file_name.c_str(), aFileName.c_str()) != 0) {
+    // some platforms (Windows) cannot rename over an existing file:
+    std::remove(aFileName.c_str());
+    if(std::rename(tmp_file_name.c_str(), aFileName.c_str()) != 0) {
+      std::remove(tmp_file_name.c_str());
+      throw std::runtime_error("Could not write the roadmap cache file '" + aFileName + "'!");
+    };
+  };
+};
+
+/**
+ * This function saves a roadmap (motion-graph) to a roadmap cache file, without a DVP-tree layout.
+ * \tparam Graph The motion-graph type, should model the boost::VertexListGraphConcept and boost::EdgeListGraphConcept.
+ * \tparam PositionMap The property-map type that maps a vertex-property (bundle) to its position.
+ * \tparam DensityMap The property-map type that maps a vertex-property (bundle) to its density value.
+ * \tparam WeightMap The property-map type that maps an edge-property (bundle) to its travel-cost.
+ * \param aFileName The name of the file to which the roadmap is saved (overwritten if it exists).
+ * \param g The motion-graph to be saved.
+ * \param aPosition The property-map that maps a vertex-property (bundle) to its position.
+ * \param aDensity The property-map that maps a vertex-property (bundle) to its density value.
+ * \param aWeight The property-map that maps an edge-property (bundle) to its travel-cost.
+ * \param aEnvironmentHash The hash of the environment in which the roadmap was built (see get_roadmap_environment_hash).
+ * \throw std::runtime_error If the file cannot be written.
+ */
+template <typename Graph, typename PositionMap, typename DensityMap, typename WeightMap>
+void save_roadmap_cache(const std::string& aFileName, const Graph& g,
+                        PositionMap aPosition, DensityMap aDensity, WeightMap aWeight,
+                        boost::uint64_t aEnvironmentHash = 0) {
+  typedef dvp_tree_layout_record< typename boost::graph_traits<Graph>::vertex_descriptor, double > LayoutRecord;
+  std::vector< LayoutRecord > no_layout;
+  save_roadmap_cache(aFileName, g, aPosition, aDensity, aWeight, no_layout.begin(), no_layout.end(), 0, 0, aEnvironmentHash);
+};
+
+
+/**
+ * This function loads a roadmap from a roadmap cache file into a motion-graph. The file is
+ * memory-mapped and entirely validated before any vertex is added to the graph, such that
+ * a missing, incompatible or truncated file leaves the graph untouched. A file is incompatible 
+ * if it was built in a different environment (i.e., with a different environment hash), if its 
+ * points do not have the dimension of the point-type (when that type has a fixed dimension), 
+ * or if it has a DVP-tree layout of a different arity or kind than the expected ones.
+ * \tparam Graph The motion-graph type, should model the boost::MutableGraphConcept with bundled properties.
+ * \tparam PositionMap The property-map type that maps a vertex-property (bundle) to its position.
+ * \tparam DensityMap The property-map type that maps a vertex-property (bundle) to its density value.
+ * \tparam WeightMap The property-map type that maps an edge-property (bundle) to its travel-cost.
+ * \tparam LayoutOutputIterator An output-iterator type that can receive DVP-tree layout records
+ *                              (see dvp_tree_layout_record) keyed by graph vertices.
+ * \param aFileName The name of the roadmap cache file.
+ * \param g The motion-graph to which the cached roadmap is added.
+ * \param aPosition The property-map that maps a vertex-property (bundle) to its position.
+ * \param aDensity The property-map that maps a vertex-property (bundle) to its density value.
+ * \param aWeight The property-map that maps an edge-property (bundle) to its travel-cost.
+ * \param aLayoutOutput The output-iterator to which the DVP-tree layout records of the roadmap are written.
+ * \param aLayoutArity The arity of the DVP-tree into which the layout will be imported, or 0 if no layout is 
+ *                     needed (any layout in the file is then ignored).
+ * \param aLayoutKind The kind of DVP-tree into which the layout will be imported (see save_roadmap_cache).
+ * \param aEnvironmentHash The hash of the current environment (see get_roadmap_environment_hash).
+ * \return True if the roadmap was loaded, false if the file does not exist or is not a valid (or compatible) roadmap cache.
+ */
+template <typename Graph, typename PositionMap, typename DensityMap, typename WeightMap, typename LayoutOutputIterator>
+bool load_roadmap_cache(const std::string& aFileName, Graph& g,
+                        PositionMap aPosition, DensityMap aDensity, WeightMap aWeight,
+                        LayoutOutputIterator aLayoutOutput,
+                        std::size_t aLayoutArity, std::size_t aLayoutKind,
+                        boost::uint64_t aEnvironmentHash = 0) {
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef typename Graph::vertex_bundled VertexProp;
+  typedef typename Graph::edge_bundled EdgeProp;
+  typedef typename boost::property_traits<PositionMap>::value_type PointType;
+
+  using namespace boost::interprocess;
+
+  {
+    std::ifstream test_file(aFileName.c_str(), std::ios::binary);
+    if(!test_file)
+      return false;
+  };
+
+  file_mapping f_map;
+  mapped_region f_region;
+  try {
+    file_mapping(aFileName.c_str(), read_only).swap(f_map);
+    mapped_region(f_map, read_only).swap(f_region);
+  } catch(interprocess_exception&) {
+    return false;
+  };
+  const char* data_ptr = static_cast<const char*>(f_region.get_address());
+  const std::size_t data_size = f_region.get_size();
+
+  detail::roadmap_cache_header hdr;
+  if(data_size < sizeof(hdr))
+    return false;
+  std::memcpy(&hdr, data_ptr, sizeof(hdr));
+  if( ( std::memcmp(hdr.magic, detail::roadmap_cache_magic, sizeof(hdr.magic)) != 0 ) ||
+      ( hdr.byte_order != detail::roadmap_cache_byte_order ) ||
+      ( hdr.version != detail::roadmap_cache_version ) ||
+      ( hdr.environment_hash != aEnvironmentHash ) )
+    return false;
+  if( ( hdr.layout_count != 0 ) && ( aLayoutArity != 0 ) && 
+      ( ( hdr.layout_arity != aLayoutArity ) || ( hdr.layout_kind != aLayoutKind ) ) )
+    return false;
+  
+  // a point-type with a fixed dimension must match the dimension of the stored points:
+  const std::size_t fixed_dim = to_vect<double>(PointType()).size();
+  if( ( fixed_dim != 0 ) && ( hdr.point_dimension != fixed_dim ) )
+    return false;
+
+  // the record counts are checked against the remaining size of the file before computing 
+  // the offsets of the arrays, such that no size computation can overflow:
+  if( hdr.point_dimension >= data_size / sizeof(double) )
+    return false;
+  const std::size_t v_rec_size = (hdr.point_dimension + 1) * sizeof(double);
+  std::size_t remaining_size = data_size - sizeof(hdr);
+  if( hdr.vertex_count > remaining_size / v_rec_size )
+    return false;
+  remaining_size -= hdr.vertex_count * v_rec_size;
+  if( hdr.edge_count > remaining_size / sizeof(detail::roadmap_cache_edge) )
+    return false;
+  remaining_size -= hdr.edge_count * sizeof(detail::roadmap_cache_edge);
+  if( ( remaining_size % sizeof(detail::roadmap_cache_layout_node) != 0 ) || 
+      ( hdr.layout_count != remaining_size / sizeof(detail::roadmap_cache_layout_node) ) )
+    return false;
+  const std::size_t v_offset = sizeof(hdr);
+  const std::size_t e_offset = v_offset + hdr.vertex_count * v_rec_size;
+  const std::size_t l_offset = e_offset + hdr.edge_count * sizeof(detail::roadmap_cache_edge);
+
+  for(std::size_t i = 0; i < hdr.edge_count; ++i) {
+    detail::roadmap_cache_edge rec;
+    std::memcpy(&rec, data_ptr + e_offset + i * sizeof(rec), sizeof(rec));
+    if( ( rec.source >= hdr.vertex_count ) || ( rec.target >= hdr.vertex_count ) )
+      return false;
+  };
+  // the layout must be a complete pre-order tree layout, with distinct keys and no more 
+  // children per node than the arity of the tree:
+  std::vector<bool> in_layout(hdr.layout_count != 0 ? hdr.vertex_count : 0, false);
+  std::size_t pending_nodes = (hdr.layout_count != 0 ? 1 : 0);
+  for(std::size_t i = 0; i < hdr.layout_count; ++i) {
+    detail::roadmap_cache_layout_node rec;
+    std::memcpy(&rec, data_ptr + l_offset + i * sizeof(rec), sizeof(rec));
+    if( ( rec.key >= hdr.vertex_count ) || in_layout[rec.key] || 
+        ( rec.child_count > hdr.layout_arity ) || ( pending_nodes == 0 ) )
+      return false;
+    in_layout[rec.key] = true;
+    pending_nodes = pending_nodes - 1 + rec.child_count;
+  };
+  if( pending_nodes != 0 )
+    return false;
+
+  std::vector<Vertex> v_list;
+  v_list.reserve(hdr.vertex_count);
+  vect_n<double> v_pos(hdr.point_dimension, 0.0);
+  for(std::size_t i = 0; i < hdr.vertex_count; ++i) {
+    const char* rec_ptr = data_ptr + v_offset + i * v_rec_size;
+    for(std::size_t j = 0; j < hdr.point_dimension; ++j)
+      std::memcpy(&v_pos[j], rec_ptr + j * sizeof(double), sizeof(double));
+    double dens = 0.0;
+    std::memcpy(&dens, rec_ptr + hdr.point_dimension * sizeof(double), sizeof(double));
+    VertexProp vp;
+    put(aPosition, vp, from_vect<PointType>(v_pos));
+    put(aDensity, vp, dens);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    v_list.push_back(add_vertex(std::move(vp), g));
+#else
+    v_list.push_back(add_vertex(vp, g));
+#endif
+  };
+
+  for(std::size_t i = 0; i < hdr.edge_count; ++i) {
+    detail::roadmap_cache_edge rec;
+    std::memcpy(&rec, data_ptr + e_offset + i * sizeof(rec), sizeof(rec));
+    EdgeProp ep;
+    put(aWeight, ep, rec.weight);
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    add_edge(v_list[rec.source], v_list[rec.target], std::move(ep), g);
+#else
+    add_edge(v_list[rec.source], v_list[rec.target], ep, g);
+#endif
+  };
+
+  for(std::size_t i = 0; ( aLayoutArity != 0 ) && ( i < hdr.layout_count ); ++i) {
+    detail::roadmap_cache_layout_node rec;
+    std::memcpy(&rec, data_ptr + l_offset + i * sizeof(rec), sizeof(rec));
+    *aLayoutOutput = dvp_tree_layout_record<Vertex, double>(v_list[rec.key], rec.child_count, rec.mu);
+    ++aLayoutOutput;
+  };
+
+  return true;
+};
+
+
+/**
+ * This function connects a vertex (e.g., the start or the goal of a query) to its neighborhood
+ * in a roadmap, such as one loaded from a roadmap cache file. The neighborhood is chosen by the
+ * same selector that the planner uses to connect new samples (e.g., the k nearest neighbors),
+ * and each connection is checked by the visitor. No vertex is added to the roadmap.
+ * \note This version applies to an undirected graph.
+ * \tparam Graph The motion-graph type, should model the boost::MutableGraphConcept with bundled properties.
+ * \tparam Topology The topology type on which the vertex positions lie.
+ * \tparam ConnectorVisitor The visitor type that can check the connections, should provide a 
+ *                          "can_be_connected" function (see planning_visitor_base).
+ * \tparam PositionMap The property-map type that maps a vertex-property (bundle) to its position.
+ * \tparam NcSelector A functor type that can select the neighborhood of a position in the graph (see neighborhood_functors.hpp).
+ * \param u The vertex to be connected to the roadmap.
+ * \param aTowardsVertex If true, the connections go from the neighbors to u (e.g., for a goal), 
+ *                       otherwise, they go from u to its neighbors (e.g., for a start).
+ * \param g The motion-graph that contains the roadmap and the vertex u.
+ * \param super_space The topology on which the vertex positions lie.
+ * \param conn_vis The visitor that checks the connections.
+ * \param aPosition The property-map that maps a vertex-property (bundle) to its position.
+ * \param select_neighborhood The functor that selects the neighborhood of a position in the graph.
+ * \return The number of edges that were added to connect the vertex.
+ */
+template <typename Graph, typename Topology, typename ConnectorVisitor, typename PositionMap, typename NcSelector>
+typename boost::enable_if< boost::is_undirected_graph<Graph>, std::size_t >::type 
+  connect_to_roadmap(typename boost::graph_traits<Graph>::vertex_descriptor u, bool aTowardsVertex, 
+                     Graph& g, const Topology& super_space, const ConnectorVisitor& conn_vis, 
+                     PositionMap aPosition, const NcSelector& select_neighborhood) {
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef typename Graph::edge_bundled EdgeProp;
+  
+  std::vector<Vertex> Nc;
+  select_neighborhood(get(aPosition, g[u]), std::back_inserter(Nc), g, super_space, boost::bundle_prop_to_vertex_prop(aPosition, g));
+  
+  std::size_t edge_count = 0;
+  for(typename std::vector<Vertex>::iterator it = Nc.begin(); it != Nc.end(); ++it) {
+    if(*it == u)
+      continue;
+    if( aTowardsVertex ? detail::try_roadmap_connection<Vertex, EdgeProp>(*it, u, g, conn_vis) 
+                       : detail::try_roadmap_connection<Vertex, EdgeProp>(u, *it, g, conn_vis) )
+      ++edge_count;
+  };
+  return edge_count;
+};
+
+/**
+ * This function connects a vertex (e.g., the start or the goal of a query) to its neighborhood
+ * in a roadmap, such as one loaded from a roadmap cache file. The neighborhood is chosen by the
+ * same selector that the planner uses to connect new samples (e.g., the k nearest neighbors),
+ * and each connection is checked by the visitor. No vertex is added to the roadmap.
+ * \note This version applies to a directed (bidirectional) graph, for which the connections to the 
+ *       predecessors or to the successors of the vertex are made, as given by aTowardsVertex.
+ * \tparam Graph The motion-graph type, should model the boost::MutableGraphConcept with bundled properties.
+ * \tparam Topology The topology type on which the vertex positions lie.
+ * \tparam ConnectorVisitor The visitor type that can check the connections, should provide a 
+ *                          "can_be_connected" function (see planning_visitor_base).
+ * \tparam PositionMap The property-map type that maps a vertex-property (bundle) to its position.
+ * \tparam NcSelector A functor type that can select the neighborhood of a position in the graph (see neighborhood_functors.hpp).
+ * \param u The vertex to be connected to the roadmap.
+ * \param aTowardsVertex If true, the connections go from the predecessors to u (e.g., for a goal), 
+ *                       otherwise, they go from u to its successors (e.g., for a start).
+ * \param g The motion-graph that contains the roadmap and the vertex u.
+ * \param super_space The topology on which the vertex positions lie.
+ * \param conn_vis The visitor that checks the connections.
+ * \param aPosition The property-map that maps a vertex-property (bundle) to its position.
+ * \param select_neighborhood The functor that selects the neighborhood of a position in the graph.
+ * \return The number of edges that were added to connect the vertex.
+ */
+template <typename Graph, typename Topology, typename ConnectorVisitor, typename PositionMap, typename NcSelector>
+typename boost::disable_if< boost::is_undirected_graph<Graph>, std::size_t >::type 
+  connect_to_roadmap(typename boost::graph_traits<Graph>::vertex_descriptor u, bool aTowardsVertex, 
+                     Graph& g, const Topology& super_space, const ConnectorVisitor& conn_vis, 
+                     PositionMap aPosition, const NcSelector& select_neighborhood) {
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef typename Graph::edge_bundled EdgeProp;
+  
+  std::vector<Vertex> Pred, Succ;
+  select_neighborhood(get(aPosition, g[u]), std::back_inserter(Pred), std::back_inserter(Succ), 
+                      g, super_space, boost::bundle_prop_to_vertex_prop(aPosition, g));
+  
+  std::size_t edge_count = 0;
+  const std::vector<Vertex>& Nc = ( aTowardsVertex ? Pred : Succ );
+  for(typename std::vector<Vertex>::const_iterator it = Nc.begin(); it != Nc.end(); ++it) {
+    if(*it == u)
+      continue;
+    if( aTowardsVertex ? detail::try_roadmap_connection<Vertex, EdgeProp>(*it, u, g, conn_vis) 
+                       : detail::try_roadmap_connection<Vertex, EdgeProp>(u, *it, g, conn_vis) )
+      ++edge_count;
+  };
+  return edge_count;
+};
+
+
+/**
+ * This function searches a roadmap for the shortest path between two of its vertices (A* search),
+ * without growing the roadmap. This is used to answer a query directly from a cached roadmap, once
+ * its start and goal are connected to it (see connect_to_roadmap). The path is recorded in the 
+ * predecessor and distance maps, as the PRM planners expect for registering their solutions.
+ * \tparam Graph The motion-graph type, should model the boost::VertexListGraphConcept and boost::IncidenceGraphConcept.
+ * \tparam HeuristicMap The property-map type of the heuristic value (to the goal) of each vertex.
+ * \tparam PredecessorMap The property-map type of the predecessor of each vertex.
+ * \tparam DistanceMap The property-map type of the accumulated distance (from the start) of each vertex.
+ * \tparam KeyMap The property-map type of the A* key-value (rank) of each vertex.
+ * \tparam WeightMap The property-map type of the travel-cost of each edge.
+ * \tparam ColorMap The property-map type of the A* color of each vertex.
+ * \param g The motion-graph that contains the roadmap.
+ * \param aStart The start vertex of the path.
+ * \param aGoal The goal vertex of the path.
+ * \param aHeuristic The property-map of the heuristic value (to the goal) of each vertex.
+ * \param aPredecessor The property-map of the predecessor of each vertex.
+ * \param aDistance The property-map of the accumulated distance (from the start) of each vertex.
+ * \param aKey The property-map of the A* key-value (rank) of each vertex.
+ * \param aWeight The property-map of the travel-cost of each edge.
+ * \param aColor The property-map of the A* color of each vertex.
+ * \return True if the goal is reachable from the start through the roadmap.
+ */
+template <typename Graph, typename HeuristicMap, typename PredecessorMap, typename DistanceMap, 
+          typename KeyMap, typename WeightMap, typename ColorMap>
+bool find_roadmap_path(const Graph& g, 
+                       typename boost::graph_traits<Graph>::vertex_descriptor aStart, 
+                       typename boost::graph_traits<Graph>::vertex_descriptor aGoal, 
+                       HeuristicMap aHeuristic, PredecessorMap aPredecessor, DistanceMap aDistance, 
+                       KeyMap aKey, WeightMap aWeight, ColorMap aColor) {
+  boost::astar_search(
+    g, aStart,
+    detail::roadmap_heuristic<HeuristicMap>(aHeuristic),
+    boost::default_astar_visitor(),
+    aPredecessor, aKey, aDistance, aWeight,
+    boost::identity_property_map(),
+    aColor,
+    std::less<double>(), std::plus<double>(),
+    std::numeric_limits< double >::infinity(),
+    double(0.0));
+  return ( get(aDistance, aGoal) < std::numeric_limits< double >::infinity() );
+};
+
+/**
+ * This function searches a roadmap for the shortest path between two of its vertices (see find_roadmap_path), 
+ * and checks every edge of that path with the visitor before reporting it, such that a cached roadmap 
+ * never yields a path that is invalid in the current environment. An edge that fails the check is given 
+ * an infinite travel-cost (excluding it from any later search) and the search is repeated, until a valid 
+ * path is found or the goal becomes unreachable.
+ * \tparam Graph The motion-graph type, should model the boost::VertexListGraphConcept and boost::IncidenceGraphConcept.
+ * \tparam HeuristicMap The property-map type of the heuristic value (to the goal) of each vertex.
+ * \tparam PredecessorMap The property-map type of the predecessor of each vertex.
+ * \tparam DistanceMap The property-map type of the accumulated distance (from the start) of each vertex.
+ * \tparam KeyMap The property-map type of the A* key-value (rank) of each vertex.
+ * \tparam WeightMap The property-map type of the travel-cost of each edge (must be writable).
+ * \tparam ColorMap The property-map type of the A* color of each vertex.
+ * \tparam ConnectorVisitor The visitor type that can check the connections, should provide a 
+ *                          "can_be_connected" function (see planning_visitor_base).
+ * \param g The motion-graph that contains the roadmap.
+ * \param aStart The start vertex of the path.
+ * \param aGoal The goal vertex of the path.
+ * \param aHeuristic The property-map of the heuristic value (to the goal) of each vertex.
+ * \param aPredecessor The property-map of the predecessor of each vertex.
+ * \param aDistance The property-map of the accumulated distance (from the start) of each vertex.
+ * \param aKey The property-map of the A* key-value (rank) of each vertex.
+ * \param aWeight The property-map of the travel-cost of each edge.
+ * \param aColor The property-map of the A* color of each vertex.
+ * \param conn_vis The visitor that checks the edges of the path.
+ * \return True if the goal is reachable from the start through valid edges of the roadmap.
+ */
+template <typename Graph, typename HeuristicMap, typename PredecessorMap, typename DistanceMap, 
+          typename KeyMap, typename WeightMap, typename ColorMap, typename ConnectorVisitor>
+bool find_checked_roadmap_path(Graph& g, 
+                               typename boost::graph_traits<Graph>::vertex_descriptor aStart, 
+                               typename boost::graph_traits<Graph>::vertex_descriptor aGoal, 
+                               HeuristicMap aHeuristic, PredecessorMap aPredecessor, DistanceMap aDistance, 
+                               KeyMap aKey, WeightMap aWeight, ColorMap aColor, 
+                               const ConnectorVisitor& conn_vis) {
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor Vertex;
+  typedef typename boost::graph_traits<Graph>::out_edge_iterator OutEdgeIter;
+  
+  while( find_roadmap_path(g, aStart, aGoal, aHeuristic, aPredecessor, aDistance, aKey, aWeight, aColor) ) {
+    bool all_edges_valid = true;
+    std::size_t path_length = 0;
+    for(Vertex v = aGoal; v != aStart; ) {
+      Vertex u = get(aPredecessor, v);
+      if( ( u == v ) || ( ++path_length > num_vertices(g) ) )
+        return false;  // <-- broken chain of predecessors.
+      if( !conn_vis.can_be_connected(u, v, g).first ) {
+        OutEdgeIter ei, ei_end;
+        for(boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+          if( target(*ei, g) == v )
+            put(aWeight, *ei, std::numeric_limits<double>::infinity());
+        };
+        all_edges_valid = false;
+      };
+      v = u;
+    };
+    if( all_edges_valid )
+      return true;
+  };
+  return false;
+};
+
+
+};
+
+};
+
+#endif
@@ -55,6 +55,7 @@
 #include "p2p_planning_query.hpp"
 #include "any_motion_graphs.hpp"
 #include "planning_visitors.hpp"
+#include <stdexcept>
 
 
 namespace ReaK {
@@ -67,6 +68,10 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   
   this->reset_internal_state();
   
+  // the parallel workers all check motions on the same free-space object.
+  if(((this->m_planning_method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) && !is_reentrant_space<FreeSpaceType>::type::value)
+    throw std::invalid_argument("The RRT planner cannot use PARALLEL_PLANNING on a free-space whose collision checks are not reentrant, use SEQUENTIAL_PLANNING instead!");
+  
   typedef typename subspace_traits<FreeSpaceType>::super_space_type SuperSpace;
   typedef typename topology_traits<SuperSpace>::point_type PointType;
   
@@ -87,6 +92,39 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   VertexProp vp_start;
   vp_start.position = aQuery.get_start_position();
   
+#ifdef RK_PLANNERS_ENABLE_VEBL_TREE
+  
+#define RK_RRT_PLANNER_DISPATCH_COB_KNN_METHODS(SETUP_SYNCHRO, CALL_FUNCTION) \
+  else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) { \
+    SETUP_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>) \
+    CALL_FUNCTION \
+  } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) { \
+    SETUP_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>) \
+    CALL_FUNCTION \
+  }
+  
+#else
+  
+#define RK_RRT_PLANNER_DISPATCH_COB_KNN_METHODS(SETUP_SYNCHRO, CALL_FUNCTION)
+  
+#endif
+  
+  // dispatches the KNN methods for the motion-graphs stored separately from their DVP-trees (or without one).
+#define RK_RRT_PLANNER_DISPATCH_KNN_METHODS(SETUP_SYNCHRO, CALL_FUNCTION) \
+  if(get_exact_knn_method(this->m_data_structure_flags) == LINEAR_SEARCH_KNN) { \
+    any_knn_synchro NN_synchro; \
+    vis.m_nn_synchro = &NN_synchro; \
+    linear_neighbor_search<MotionGraphType> nn_finder; \
+    CALL_FUNCTION \
+  } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) { \
+    SETUP_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>) \
+    CALL_FUNCTION \
+  } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) { \
+    SETUP_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>) \
+    CALL_FUNCTION \
+  } RK_RRT_PLANNER_DISPATCH_COB_KNN_METHODS(SETUP_SYNCHRO, CALL_FUNCTION)
+  
+  
   if((this->m_planning_method_flags & PLANNING_DIRECTIONALITY_MASK) == UNIDIRECTIONAL_PLANNING) {
     
     
@@ -95,6 +133,8 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   typedef typename boost::property_map< MotionGraphType, PointType BasicVertexProp::* >::type GraphPositionMap; \
   typedef dvp_tree<Vertex, SuperSpace, GraphPositionMap, ARITY, random_vp_chooser, TREE_STORAGE > SpacePartType; \
   SpacePartType space_part(motion_graph, sup_space_ptr, get(&BasicVertexProp::position, motion_graph)); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
    \
   typedef multi_dvp_tree_search<MotionGraphType, SpacePartType> NNFinderType; \
   NNFinderType nn_finder; \
@@ -111,6 +151,8 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   typedef typename ALTGraph::adj_list_type MotionGraphType; \
    \
   ALTGraph space_part(sup_space_ptr, pos_map); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
   MotionGraphType motion_graph = space_part.get_adjacency_list(); \
   vis.m_start_node = boost::any( create_root(vp_start, motion_graph) ); \
    \
@@ -123,10 +165,17 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   
   
 #define RK_RRT_PLANNER_CALL_RRT_FUNCTION \
-  ReaK::graph::generate_rrt( \
-    motion_graph, *sup_space_ptr, \
-    vis, pos_map, get(random_sampler, *sup_space_ptr), \
-    nn_finder);
+  if((this->m_planning_method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) { \
+    ReaK::graph::generate_parallel_rrt( \
+      motion_graph, *sup_space_ptr, \
+      vis, pos_map, get(random_sampler, *sup_space_ptr), \
+      nn_finder, this->m_worker_count); \
+  } else { \
+    ReaK::graph::generate_rrt( \
+      motion_graph, *sup_space_ptr, \
+      vis, pos_map, get(random_sampler, *sup_space_ptr), \
+      nn_finder); \
+  };
     
     
     if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == ADJ_LIST_MOTION_GRAPH) {
@@ -136,55 +185,28 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       MotionGraphType motion_graph;
       vis.m_start_node = boost::any( create_root(vp_start, motion_graph) );
       
-      if((this->m_data_structure_flags & KNN_METHOD_MASK) == LINEAR_SEARCH_KNN) {
-        
-        any_knn_synchro NN_synchro;
-        vis.m_nn_synchro = &NN_synchro;
-        linear_neighbor_search<MotionGraphType> nn_finder;
-        
-        RK_RRT_PLANNER_CALL_RRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
-        
-        RK_RRT_PLANNER_CALL_RRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
-        
-        RK_RRT_PLANNER_CALL_RRT_FUNCTION
+      RK_RRT_PLANNER_DISPATCH_KNN_METHODS(RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO, RK_RRT_PLANNER_CALL_RRT_FUNCTION)
       
-#ifdef RK_PLANNERS_ENABLE_VEBL_TREE
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
-        
-        RK_RRT_PLANNER_CALL_RRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
-        
-        RK_RRT_PLANNER_CALL_RRT_FUNCTION
-        
-#endif
-        
-      };
+    } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == CONCURRENT_MOTION_GRAPH) {
+      
+      typedef typename concurrent_motion_graph< VertexProp, EdgeProp, FreeSpaceType >::type MotionGraphType;
+      
+      MotionGraphType motion_graph;
+      vis.m_start_node = boost::any( create_root(vp_start, motion_graph) );
+      
+      RK_RRT_PLANNER_DISPATCH_KNN_METHODS(RK_RRT_PLANNER_SETUP_DVP_TREE_SYNCHRO, RK_RRT_PLANNER_CALL_RRT_FUNCTION)
     
 #ifdef RK_PLANNERS_ENABLE_DVP_ADJ_LIST_LAYOUT
       
     } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == DVP_ADJ_LIST_MOTION_GRAPH) {
       
-      if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+      if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_ALT_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
         
         RK_RRT_PLANNER_CALL_RRT_FUNCTION
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_ALT_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
         
@@ -192,13 +214,13 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_ALT_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
         
         RK_RRT_PLANNER_CALL_RRT_FUNCTION
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_ALT_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
         
@@ -230,7 +252,11 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   typedef typename boost::property_map< MotionGraphType, PointType BasicVertexProp::* >::type GraphPositionMap; \
   typedef dvp_tree<Vertex, SuperSpace, GraphPositionMap, ARITY, random_vp_chooser, TREE_STORAGE > SpacePartType; \
   SpacePartType space_part1(motion_graph1, sup_space_ptr, get(&BasicVertexProp::position, motion_graph1)); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part1.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part1.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
   SpacePartType space_part2(motion_graph2, sup_space_ptr, get(&BasicVertexProp::position, motion_graph2)); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part2.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part2.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
    \
   typedef multi_dvp_tree_search<MotionGraphType, SpacePartType> NNFinderType; \
   NNFinderType nn_finder; \
@@ -249,7 +275,11 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   typedef typename ALTGraph::adj_list_type MotionGraphType; \
    \
   ALTGraph space_part1(sup_space_ptr, pos_map); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part1.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part1.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
   ALTGraph space_part2(sup_space_ptr, pos_map); \
+  if(is_approximate_knn_method(this->m_data_structure_flags)) space_part2.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+  space_part2.set_max_rebuild_size(this->m_knn_max_rebuild_size); \
    \
   MotionGraphType motion_graph1 = space_part1.get_adjacency_list(); \
   MotionGraphType motion_graph2 = space_part2.get_adjacency_list(); \
@@ -267,10 +297,17 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
   
   
 #define RK_RRT_PLANNER_CALL_BIRRT_FUNCTION \
-  ReaK::graph::generate_bidirectional_rrt( \
-    motion_graph1, motion_graph2, *sup_space_ptr, \
-    vis, pos_map, get(random_sampler, *sup_space_ptr), \
-    nn_finder);
+  if((this->m_planning_method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) { \
+    ReaK::graph::generate_parallel_bidirectional_rrt( \
+      motion_graph1, motion_graph2, *sup_space_ptr, \
+      vis, pos_map, get(random_sampler, *sup_space_ptr), \
+      nn_finder, this->m_worker_count); \
+  } else { \
+    ReaK::graph::generate_bidirectional_rrt( \
+      motion_graph1, motion_graph2, *sup_space_ptr, \
+      vis, pos_map, get(random_sampler, *sup_space_ptr), \
+      nn_finder); \
+  };
     
     
     if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == ADJ_LIST_MOTION_GRAPH) {
@@ -283,55 +320,31 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       vis.m_start_node = boost::any( create_root(vp_start, motion_graph1) );
       vis.m_goal_node  = boost::any( create_root(vp_goal,  motion_graph2) );
       
-      if((this->m_data_structure_flags & KNN_METHOD_MASK) == LINEAR_SEARCH_KNN) {
-        
-        any_knn_synchro NN_synchro;
-        vis.m_nn_synchro = &NN_synchro;
-        linear_neighbor_search<MotionGraphType> nn_finder;
-        
-        RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
-        
-        RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
-        
-        RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
+      RK_RRT_PLANNER_DISPATCH_KNN_METHODS(RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO, RK_RRT_PLANNER_CALL_BIRRT_FUNCTION)
       
-#ifdef RK_PLANNERS_ENABLE_VEBL_TREE
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
-        
-        RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
-        
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
-        
-        RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
-        
-        RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
-        
-#endif
-        
-      };
+    } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == CONCURRENT_MOTION_GRAPH) {
+      
+      typedef typename concurrent_motion_graph< VertexProp, EdgeProp, FreeSpaceType >::type MotionGraphType;
+      
+      MotionGraphType motion_graph1;
+      MotionGraphType motion_graph2;
+      
+      vis.m_start_node = boost::any( create_root(vp_start, motion_graph1) );
+      vis.m_goal_node  = boost::any( create_root(vp_goal,  motion_graph2) );
+      
+      RK_RRT_PLANNER_DISPATCH_KNN_METHODS(RK_RRT_PLANNER_SETUP_TWO_DVP_TREE_SYNCHRO, RK_RRT_PLANNER_CALL_BIRRT_FUNCTION)
     
 #ifdef RK_PLANNERS_ENABLE_DVP_ADJ_LIST_LAYOUT
       
     } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == DVP_ADJ_LIST_MOTION_GRAPH) {
       
-      if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+      if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_TWO_ALT_TREE_SYNCHRO(2, boost::bfl_d_ary_tree_storage<2>)
         
         RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_TWO_ALT_TREE_SYNCHRO(4, boost::bfl_d_ary_tree_storage<4>)
         
@@ -339,13 +352,13 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_TWO_ALT_TREE_SYNCHRO(2, boost::vebl_d_ary_tree_storage<2>)
         
         RK_RRT_PLANNER_CALL_BIRRT_FUNCTION
         
-      } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+      } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
         
         RK_RRT_PLANNER_SETUP_TWO_ALT_TREE_SYNCHRO(4, boost::vebl_d_ary_tree_storage<4>)
         
@@ -365,6 +378,9 @@ void rrt_planner<FreeSpaceType>::solve_planning_query(planning_query<FreeSpaceTy
     
   };
   
+#undef RK_RRT_PLANNER_DISPATCH_KNN_METHODS
+#undef RK_RRT_PLANNER_DISPATCH_COB_KNN_METHODS
+  
   
   
 };
@@ -97,6 +97,7 @@ class rrtstar_planner : public sample_based_planner<FreeSpaceType> {
      * the function is likely to fail.
      * \param aQuery The query object that defines as input the parameters of the query, 
      *               and as output, the recorded solutions.
+     * \throw std::invalid_argument If the CONCURRENT_MOTION_GRAPH storage is requested (not supported by this planner).
      */
     virtual void solve_planning_query(planning_query<FreeSpaceType>& aQuery);
     
@@ -106,7 +107,8 @@ class rrtstar_planner : public sample_based_planner<FreeSpaceType> {
      * \param aMaxVertexCount The maximum number of samples to generate during the motion planning.
      * \param aProgressInterval The number of new samples between each "progress report".
      * \param aDataStructureFlags An integer flags representing the kind of motion graph data-structure to use in the 
-     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH.
+     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH
+     *                            (CONCURRENT_MOTION_GRAPH is not supported, see rrt_planner, an std::invalid_argument is thrown).
      *                            Any combination of those two and of KNN method flags to use for nearest
      *                            neighbor queries in the graph. KNN method flags can be LINEAR_SEARCH_KNN, 
      *                            DVP_BF2_TREE_KNN, DVP_BF4_TREE_KNN, DVP_COB2_TREE_KNN, or DVP_COB4_TREE_KNN.
@@ -58,6 +58,7 @@
 #include <ReaK/ctrl/graph_alg/neighborhood_functors.hpp>
 #include "any_motion_graphs.hpp"
 #include "planning_visitors.hpp"
+#include <stdexcept>
 
 namespace ReaK {
   
@@ -106,6 +107,8 @@ struct rrtstar_bundle_factory {
     struct space_part_type {
       template <typename GraphPositionMap>
       space_part_type(const type&, const shared_ptr<const super_space_type>&, GraphPositionMap) { };
+      void set_approximation(double, std::size_t) { };
+      void set_max_rebuild_size(std::size_t) { };
     };
     
     typedef linear_neighbor_search<type> nn_finder_type;
@@ -315,6 +318,8 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     typedef typename MGFactory::space_part_type     SpacePartType;                                      \
     typedef typename RRTStarFactory::basic_vertex_prop   BasicVProp;                                    \
     SpacePartType space_part(motion_graph, sup_space_ptr, get(&BasicVProp::position, motion_graph));    \
+    if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+    space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size);                                      \
                                                                                                         \
     typedef typename MGFactory::nn_finder_type      NNFinderType;                                       \
     NNFinderType nn_finder = MGFactory::get_nn_finder(motion_graph, space_part);                        \
@@ -332,6 +337,8 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     typedef typename RRTStarFactory::position_map        PosMap;                                        \
     typedef typename RRTStarFactory::vertex_prop         VProp;                                         \
     SpacePartType space_part(sup_space_ptr, PosMap(&VProp::position));                                  \
+    if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+    space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size);                                      \
                                                                                                         \
     MotionGraphType motion_graph = MGFactory::get_motion_graph(space_part);                             \
                                                                                                         \
@@ -352,9 +359,13 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
   typedef typename RRTStarFactory::visitor_type VisitorType;
   VisitorType vis(this, &aQuery);
   
+  // the concurrent motion-graph storage is only implemented for the RRT planner:
+  if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == CONCURRENT_MOTION_GRAPH)
+    throw std::invalid_argument("The RRT* planner does not support the CONCURRENT_MOTION_GRAPH storage, use ADJ_LIST_MOTION_GRAPH instead!");
+  
   if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == ADJ_LIST_MOTION_GRAPH) {
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == LINEAR_SEARCH_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == LINEAR_SEARCH_KNN) {
       
       typedef typename RRTStarFactory::ls_motion_graph MGFactory;
       
@@ -362,7 +373,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
       RRTStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, this->m_planning_method_flags);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       typedef typename RRTStarFactory::template dvp_motion_graph< 2, boost::bfl_d_ary_tree_storage<2> > MGFactory;
       
@@ -370,7 +381,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
       RRTStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, this->m_planning_method_flags);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       typedef typename RRTStarFactory::template dvp_motion_graph< 4, boost::bfl_d_ary_tree_storage<4> > MGFactory;
       
@@ -380,7 +391,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
         
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       typedef typename RRTStarFactory::template dvp_motion_graph< 2, boost::vebl_d_ary_tree_storage<2> > MGFactory;
       
@@ -388,7 +399,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
       RRTStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, this->m_planning_method_flags);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       typedef typename RRTStarFactory::template dvp_motion_graph< 4, boost::vebl_d_ary_tree_storage<4> > MGFactory;
       
@@ -404,7 +415,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     
   } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == DVP_ADJ_LIST_MOTION_GRAPH) {
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       typedef typename RRTStarFactory::template alt_motion_graph< 2, boost::bfl_d_ary_tree_storage<2> > MGFactory;
       
@@ -412,7 +423,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
       RRTStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, this->m_planning_method_flags);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       typedef typename RRTStarFactory::template alt_motion_graph< 4, boost::bfl_d_ary_tree_storage<4> > MGFactory;
       
@@ -422,7 +433,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       typedef typename RRTStarFactory::template alt_motion_graph< 2, boost::vebl_d_ary_tree_storage<2> > MGFactory;
       
@@ -430,7 +441,7 @@ void rrtstar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
       
       RRTStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, this->m_planning_method_flags);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       typedef typename RRTStarFactory::template alt_motion_graph< 4, boost::vebl_d_ary_tree_storage<4> > MGFactory;
       
@@ -109,6 +109,8 @@ class sbastar_planner : public sample_based_planner<FreeSpaceType> {
      * the function is likely to fail.
      * \param aQuery The query object that defines as input the parameters of the query, 
      *               and as output, the recorded solutions.
+     * \throw std::invalid_argument If the CONCURRENT_MOTION_GRAPH storage is requested (not supported by this planner).
+     * \throw std::invalid_argument If PARALLEL_PLANNING is requested on a free-space that is not reentrant (see is_reentrant_space).
      */
     virtual void solve_planning_query(planning_query<FreeSpaceType>& aQuery);
     
@@ -157,7 +159,8 @@ class sbastar_planner : public sample_based_planner<FreeSpaceType> {
      * \param aMaxVertexCount The maximum number of samples to generate during the motion planning.
      * \param aProgressInterval The number of new samples between each "progress report".
      * \param aDataStructureFlags An integer flags representing the kind of motion graph data-structure to use in the 
-     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH.
+     *                            planning algorithm. Can be ADJ_LIST_MOTION_GRAPH or DVP_ADJ_LIST_MOTION_GRAPH
+     *                            (CONCURRENT_MOTION_GRAPH is not supported, see rrt_planner, an std::invalid_argument is thrown).
      *                            Any combination of those two and of KNN method flags to use for nearest
      *                            neighbor queries in the graph. KNN method flags can be LINEAR_SEARCH_KNN, 
      *                            DVP_BF2_TREE_KNN, DVP_BF4_TREE_KNN, DVP_COB2_TREE_KNN, or DVP_COB4_TREE_KNN.
@@ -166,7 +169,10 @@ class sbastar_planner : public sample_based_planner<FreeSpaceType> {
      *                             The options available include EAGER_COLLISION_CHECKING or LAZY_COLLISION_CHECKING, 
      *                             NOMINAL_PLANNER_ONLY or any combination of PLAN_WITH_VORONOI_PULL, 
      *                             PLAN_WITH_NARROW_PASSAGE_PUSH and PLAN_WITH_ANYTIME_HEURISTIC, UNIDIRECTIONAL_PLANNING 
-     *                             or BIDIRECTIONAL_PLANNING, and USE_BRANCH_AND_BOUND_PRUNING_FLAG. 
+     *                             or BIDIRECTIONAL_PLANNING, SEQUENTIAL_PLANNING or PARALLEL_PLANNING (see set_worker_count, 
+     *                             only for the unidirectional SBA* and Lazy-SBA* without other options, 
+     *                             and only for free-spaces that are reentrant, see is_reentrant_space), 
+     *                             and USE_BRANCH_AND_BOUND_PRUNING_FLAG. 
      * \param aSteerProgressTolerance The steer progress tolerance to be used by this planner when making connections.
      * \param aConnectionTolerance The connection tolerance to be used by this planner when making connections.
      * \param aSamplingRadius The sampling radius to be used by this planner when doing random walks.
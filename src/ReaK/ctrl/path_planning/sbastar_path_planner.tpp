@@ -64,6 +64,7 @@
 #include <ReaK/ctrl/graph_alg/neighborhood_functors.hpp>
 #include "any_motion_graphs.hpp"
 #include "density_plan_visitors.hpp"
+#include <stdexcept>
 
 namespace ReaK {
   
@@ -112,6 +113,8 @@ struct sbastar_bundle_factory {
     struct space_part_type {
       template <typename GraphPositionMap>
       space_part_type(const type&, const shared_ptr<const super_space_type>&, GraphPositionMap) { };
+      void set_approximation(double, std::size_t) { };
+      void set_max_rebuild_size(std::size_t) { };
     };
     
     typedef linear_neighbor_search<type> nn_finder_type;
@@ -265,7 +268,7 @@ struct sbastar_bundle_factory {
   typename boost::disable_if< CallBidir >::type
     dispatched_make_call_to_planner(MotionGraphType& motion_graph, visitor_type& vis, NcSelector nc_selector, 
                                     shared_ptr<const super_space_type> s_ptr, std::size_t method_flags, 
-                                    double init_relax, double init_temp) {
+                                    double init_relax, double init_temp, std::size_t num_workers) {
     using namespace graph;
     
     if(((method_flags & ADDITIONAL_PLANNING_BIAS_MASK) & PLAN_WITH_ANYTIME_HEURISTIC) && (init_relax > 1e-6)) {
@@ -294,6 +297,8 @@ struct sbastar_bundle_factory {
       if((method_flags & COLLISION_CHECKING_POLICY_MASK) == EAGER_COLLISION_CHECKING) {
         if((method_flags & ADDITIONAL_PLANNING_BIAS_MASK) & PLAN_WITH_VORONOI_PULL) {
           generate_sbarrtstar( make_bundle(motion_graph, vis, nc_selector, s_ptr), get(random_sampler, *s_ptr), init_temp);
+        } else if((method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) {
+          generate_parallel_sbastar( make_bundle(motion_graph, vis, nc_selector, s_ptr), num_workers );
         } else { /* assume nominal method only. */
           generate_sbastar( make_bundle(motion_graph, vis, nc_selector, s_ptr) );
         };
@@ -307,6 +312,8 @@ struct sbastar_bundle_factory {
         } else { /* assume nominal method only. */
           if(method_flags & USE_BRANCH_AND_BOUND_PRUNING_FLAG) {
             generate_lazy_bnb_sbastar( make_bundle(motion_graph, vis, nc_selector, s_ptr) );
+          } else if((method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) {
+            generate_parallel_lazy_sbastar( make_bundle(motion_graph, vis, nc_selector, s_ptr), num_workers );
           } else { /* assume nominal method only. */
             generate_lazy_sbastar( make_bundle(motion_graph, vis, nc_selector, s_ptr) );
           };
@@ -321,7 +328,7 @@ struct sbastar_bundle_factory {
   typename boost::enable_if< CallBidir >::type
     dispatched_make_call_to_planner(MotionGraphType& motion_graph, visitor_type& vis, NcSelector nc_selector, 
                                     shared_ptr<const super_space_type> s_ptr, std::size_t method_flags, 
-                                    double init_relax, double init_temp) {
+                                    double init_relax, double init_temp, std::size_t num_workers) {
     using namespace graph;
     
     if(((method_flags & ADDITIONAL_PLANNING_BIAS_MASK) & PLAN_WITH_ANYTIME_HEURISTIC) && (init_relax > 1e-6)) {
@@ -376,8 +383,8 @@ struct sbastar_bundle_factory {
   static
   void make_call_to_planner(MotionGraphType& motion_graph, visitor_type& vis, NcSelector nc_selector, 
                             shared_ptr<const super_space_type> s_ptr, std::size_t method_flags, 
-                            double init_relax, double init_temp) {
-    dispatched_make_call_to_planner<is_bidir>(motion_graph, vis, nc_selector, s_ptr, method_flags, init_relax, init_temp);
+                            double init_relax, double init_temp, std::size_t num_workers) {
+    dispatched_make_call_to_planner<is_bidir>(motion_graph, vis, nc_selector, s_ptr, method_flags, init_relax, init_temp, num_workers);
   };
   
   
@@ -391,6 +398,10 @@ void sbastar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
   
   this->reset_internal_state();
   
+  // the parallel workers all check motions on the same free-space object.
+  if(((this->m_planning_method_flags & PLANNING_PARALLELISM_MASK) == PARALLEL_PLANNING) && !is_reentrant_space<FreeSpaceType>::type::value)
+    throw std::invalid_argument("The SBA* planner cannot use PARALLEL_PLANNING on a free-space whose collision checks are not reentrant, use SEQUENTIAL_PLANNING instead!");
+  
   double space_dim = double( this->get_space_dimensionality() );
   double space_Lc = aQuery.get_heuristic_to_goal( aQuery.get_start_position() );
   
@@ -408,6 +419,8 @@ void sbastar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     typedef typename MGFactory::space_part_type     SpacePartType;                                      \
     typedef typename SBAStarFactory::basic_vertex_prop   BasicVProp;                                    \
     SpacePartType space_part(motion_graph, sup_space_ptr, get(&BasicVProp::position, motion_graph));    \
+    if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+    space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size);                                      \
                                                                                                         \
     typedef typename MGFactory::nn_finder_type      NNFinderType;                                       \
     NNFinderType nn_finder = MGFactory::get_nn_finder(motion_graph, space_part);                        \
@@ -425,6 +438,8 @@ void sbastar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     typedef typename SBAStarFactory::position_map        PosMap;                                        \
     typedef typename SBAStarFactory::vertex_prop         VProp;                                         \
     SpacePartType space_part(sup_space_ptr, PosMap(&VProp::position));                                  \
+    if(is_approximate_knn_method(this->m_data_structure_flags)) space_part.set_approximation(this->m_knn_epsilon, this->m_knn_max_visits); \
+    space_part.set_max_rebuild_size(this->m_knn_max_rebuild_size);                                      \
                                                                                                         \
     MotionGraphType motion_graph = MGFactory::get_motion_graph(space_part);                             \
                                                                                                         \
@@ -445,54 +460,64 @@ void sbastar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
   typedef typename SBAStarFactory::visitor_type VisitorType;
   VisitorType vis( this, &aQuery, NULL, boost::any(), boost::any(), this->m_init_dens_threshold);
   
+  // the concurrent motion-graph storage is only implemented for the RRT planner (the parallel SBA* 
+  // workers share the adjacency-list storage, under the reader-writer lock of generate_parallel_sbastar):
+  if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == CONCURRENT_MOTION_GRAPH)
+    throw std::invalid_argument("The SBA* planner does not support the CONCURRENT_MOTION_GRAPH storage, use ADJ_LIST_MOTION_GRAPH instead!");
+  
   if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == ADJ_LIST_MOTION_GRAPH) {
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == LINEAR_SEARCH_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == LINEAR_SEARCH_KNN) {
       
       typedef typename SBAStarFactory::ls_motion_graph MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_LS_OR_DVP_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       typedef typename SBAStarFactory::template dvp_motion_graph< 2, boost::bfl_d_ary_tree_storage<2> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_LS_OR_DVP_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       typedef typename SBAStarFactory::template dvp_motion_graph< 4, boost::bfl_d_ary_tree_storage<4> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_LS_OR_DVP_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
         
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       typedef typename SBAStarFactory::template dvp_motion_graph< 2, boost::vebl_d_ary_tree_storage<2> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_LS_OR_DVP_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       typedef typename SBAStarFactory::template dvp_motion_graph< 4, boost::vebl_d_ary_tree_storage<4> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_LS_OR_DVP_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
 #endif
       
@@ -502,43 +527,47 @@ void sbastar_planner<FreeSpaceType>::solve_planning_query_impl(planning_query<Fr
     
   } else if((this->m_data_structure_flags & MOTION_GRAPH_STORAGE_MASK) == DVP_ADJ_LIST_MOTION_GRAPH) {
     
-    if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF2_TREE_KNN) {
+    if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF2_TREE_KNN) {
       
       typedef typename SBAStarFactory::template alt_motion_graph< 2, boost::bfl_d_ary_tree_storage<2> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_ALT_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_BF4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_BF4_TREE_KNN) {
       
       typedef typename SBAStarFactory::template alt_motion_graph< 4, boost::bfl_d_ary_tree_storage<4> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_ALT_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
 #ifdef RK_PLANNERS_ENABLE_VEBL_TREE
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB2_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB2_TREE_KNN) {
       
       typedef typename SBAStarFactory::template alt_motion_graph< 2, boost::vebl_d_ary_tree_storage<2> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_ALT_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
       
-    } else if((this->m_data_structure_flags & KNN_METHOD_MASK) == DVP_COB4_TREE_KNN) {
+    } else if(get_exact_knn_method(this->m_data_structure_flags) == DVP_COB4_TREE_KNN) {
       
       typedef typename SBAStarFactory::template alt_motion_graph< 4, boost::vebl_d_ary_tree_storage<4> > MGFactory;
       
       RK_SBASTAR_PLANNER_SETUP_ALT_SUPPORT_STRUCTURES
       
       SBAStarFactory::make_call_to_planner(motion_graph, vis, nc_selector, sup_space_ptr, 
-                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature);
+                                          this->m_planning_method_flags, this->m_init_relaxation, this->m_SA_init_temperature, 
+                                          this->m_worker_count);
         
 #endif
       
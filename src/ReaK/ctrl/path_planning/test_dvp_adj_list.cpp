@@ -42,16 +42,43 @@ typedef TopologyType::point_type PointType;
 
 struct WorldGridVertexProperties {
   PointType pos;
+  PointType extra_data[4];  // stands for the other data carried by the vertices of a motion-graph.
   
   WorldGridVertexProperties(PointType aPos = PointType()) : pos(aPos) { };
 };
 
 struct WorldGridEdgeProperties { };
 
+typedef boost::data_member_property_map< PointType, WorldGridVertexProperties > PositionMap;
 
-int main() {
+
+template <typename WorldPartition>
+double time_dvp_queries(const ReaK::shared_ptr<TopologyType>& m_space, unsigned int grid_size) {
+  typedef typename WorldPartition::adj_list_type WorldGrid;
+  
+  WorldPartition dvp(m_space, PositionMap(&WorldGridVertexProperties::pos));
+  WorldGrid g = dvp.get_adjacency_list();
   
-  typedef boost::data_member_property_map< PointType, WorldGridVertexProperties > PositionMap;
+  typedef ReaK::pp::point_distribution_traits< TopologyType >::random_sampler_type RandSampler;
+  RandSampler get_sample = get(ReaK::pp::random_sampler, *m_space);
+  
+  for(unsigned int j=0;j < grid_size;++j) {
+    WorldGridVertexProperties vp = WorldGridVertexProperties(get_sample(*m_space));
+    add_vertex(vp,g);
+  };
+  
+  ReaK::pp::multi_dvp_tree_search<WorldGrid, WorldPartition> nn_finder;
+  nn_finder.graph_tree_map[&g] = &dvp;
+  boost::posix_time::ptime t_start = boost::posix_time::microsec_clock::local_time();
+  for(unsigned int j=0;j<1000;++j) {
+    nn_finder(get_sample(*m_space),g,*m_space,get(&WorldGridVertexProperties::pos,g));
+  };
+  boost::posix_time::time_duration dt = boost::posix_time::microsec_clock::local_time() - t_start;
+  return dt.total_microseconds() * 0.001 / double(grid_size);
+};
+
+
+int main() {
   
   typedef ReaK::pp::dvp_adjacency_list< 
     WorldGridVertexProperties,
@@ -61,7 +88,31 @@ int main() {
     boost::bfl_d_ary_tree_storage<2>,
     boost::vecBC, boost::undirectedS, boost::vecBC > WorldPartition2BF;
   
-  typedef WorldPartition2BF::adj_list_type WorldGrid2BF;
+  typedef ReaK::pp::dvp_adjacency_list< 
+    WorldGridVertexProperties,
+    WorldGridEdgeProperties,
+    TopologyType, PositionMap,
+    2, ReaK::pp::random_vp_chooser,
+    boost::bfl_d_ary_tree_storage<2>,
+    boost::vecBC, boost::undirectedS, boost::vecBC,
+    ReaK::pp::dvp_packed_positions > WorldPartition2BFPacked;
+  
+  typedef ReaK::pp::dvp_adjacency_list< 
+    WorldGridVertexProperties,
+    WorldGridEdgeProperties,
+    TopologyType, PositionMap,
+    4, ReaK::pp::random_vp_chooser,
+    boost::bfl_d_ary_tree_storage<4>,
+    boost::vecBC, boost::undirectedS, boost::vecBC > WorldPartition4BF;
+  
+  typedef ReaK::pp::dvp_adjacency_list< 
+    WorldGridVertexProperties,
+    WorldGridEdgeProperties,
+    TopologyType, PositionMap,
+    4, ReaK::pp::random_vp_chooser,
+    boost::bfl_d_ary_tree_storage<4>,
+    boost::vecBC, boost::undirectedS, boost::vecBC,
+    ReaK::pp::dvp_packed_positions > WorldPartition4BFPacked;
   
   const unsigned int grid_sizes[] = {100, 200, 300, 400, 500, 800, 1000, 1100, 1300, 1500, 1700, 
                                      1900, 2000, 2200, 2500, 3000, 3500, 4000, 4500, 5000, 6000,
@@ -71,36 +122,25 @@ int main() {
 //                                     2000000, 5000000, 10000000, 20000000};
   
   std::ofstream outFile("test_vp_results/dvp_adj_list.dat");
-  outFile << "N\tVP2\t (all times in micro-seconds per query per vertex)" << std::endl;
+  outFile << "N\tVP2\tVP2-packed\tVP4\tVP4-packed\t (all times in micro-seconds per query per vertex)" << std::endl;
   
   for(int i=0;i<30;++i) {
     ReaK::shared_ptr<TopologyType> m_space = ReaK::shared_ptr<TopologyType>(new TopologyType("",ReaK::vect<double,6>(0.0,0.0,0.0,0.0,0.0,0.0),ReaK::vect<double,6>(1.0,1.0,1.0,1.0,1.0,1.0)));
     
-    WorldPartition2BF dvp2(m_space, PositionMap(&WorldGridVertexProperties::pos));
-    WorldGrid2BF g2 = dvp2.get_adjacency_list();
-    
-    typedef ReaK::pp::point_distribution_traits< TopologyType >::random_sampler_type RandSampler;
-    RandSampler get_sample = get(ReaK::pp::random_sampler, *m_space);
-    
-    for(unsigned int j=0;j < grid_sizes[i];++j) {
-      WorldGridVertexProperties vp = WorldGridVertexProperties(get_sample(*m_space));
-      add_vertex(vp,g2);
-    };
-    
     outFile << grid_sizes[i];
     std::cout << "N = " << grid_sizes[i] << std::endl;
     
-    {
-    ReaK::pp::multi_dvp_tree_search<WorldGrid2BF, WorldPartition2BF> nn_finder2;
-    nn_finder2.graph_tree_map[&g2] = &dvp2;
-    boost::posix_time::ptime t_start = boost::posix_time::microsec_clock::local_time();
-    for(unsigned int j=0;j<1000;++j) {
-      nn_finder2(get_sample(*m_space),g2,*m_space,get(&WorldGridVertexProperties::pos,g2));
-    };
-    boost::posix_time::time_duration dt = boost::posix_time::microsec_clock::local_time() - t_start;
-    outFile << "\t" << dt.total_microseconds() * 0.001 / double(grid_sizes[i]);
+    outFile << "\t" << time_dvp_queries<WorldPartition2BF>(m_space, grid_sizes[i]);
     std::cout << "VP2-fresh" << std::endl;
-    };
+    
+    outFile << "\t" << time_dvp_queries<WorldPartition2BFPacked>(m_space, grid_sizes[i]);
+    std::cout << "VP2-packed-fresh" << std::endl;
+    
+    outFile << "\t" << time_dvp_queries<WorldPartition4BF>(m_space, grid_sizes[i]);
+    std::cout << "VP4-fresh" << std::endl;
+    
+    outFile << "\t" << time_dvp_queries<WorldPartition4BFPacked>(m_space, grid_sizes[i]);
+    std::cout << "VP4-packed-fresh" << std::endl;
     
     outFile << std::endl;
   };
@@ -119,3 +159,4 @@ int main() {
 
 
 
+
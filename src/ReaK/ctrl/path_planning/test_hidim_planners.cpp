@@ -80,6 +80,8 @@ int main(int argc, char** argv) {
   mc_options.add_options()
     ("monte-carlo,m", "specify that monte-carlo runs should be performed (default is not).")
     ("mc-runs", po::value< std::size_t >()->default_value(100), "number of monte-carlo runs to average out (default is 100).")
+    ("mc-threads", po::value< std::size_t >()->default_value(1), "number of monte-carlo runs to perform concurrently, 0 for the number of hardware threads (default is 1).")
+    ("mc-seed", po::value< unsigned int >()->default_value(0), "base seed of the random-number streams of the monte-carlo runs, 0 for a random seed (default is 0).")
   ;
   
   po::options_description single_options("Single-run options");
@@ -212,7 +214,8 @@ int main(int argc, char** argv) {
   world_ND->set_goal_pos(goal_pt);
   
   if(vm.count("monte-carlo")) {
-    monte_carlo_mp_engine mc_eng(vm["mc-runs"].as<std::size_t>(), planner_name_str, output_path_name + "/" + space_ND_name);
+    monte_carlo_mp_engine mc_eng(vm["mc-runs"].as<std::size_t>(), planner_name_str, output_path_name + "/" + space_ND_name,
+                                 vm["mc-threads"].as<std::size_t>(), vm["mc-seed"].as<unsigned int>());
     try {
       execute_p2p_planner(world_ND, plan_options, RK_HIDIM_PLANNER_N, mc_eng, world_ND->get_start_pos(), world_ND->get_goal_pos());
     } catch(std::exception& e) {
@@ -30,11 +30,40 @@
 
 #include <ReaK/ctrl/path_planning/topological_search.hpp>
 #include <ReaK/ctrl/path_planning/metric_space_search.hpp>
+#include <ReaK/ctrl/path_planning/concurrent_dvp_tree.hpp>
 #include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
 #include <ReaK/core/lin_alg/vect_alg.hpp>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <vector>
+
+
+/* One worker of the concurrent benchmark: inserts its share of vertices, each followed by a few KNN queries. */
+template <typename ConcurrentPartition, typename VertexType, typename PointType>
+struct concurrent_dvp_worker {
+  ConcurrentPartition* p_part;
+  const std::vector< VertexType >* p_inserted;
+  const std::vector< PointType >* p_queries;
+  std::size_t first;
+  std::size_t last;
+  
+  concurrent_dvp_worker(ConcurrentPartition* aPart, const std::vector< VertexType >* aInserted, 
+                        const std::vector< PointType >* aQueries, std::size_t aFirst, std::size_t aLast) : 
+                        p_part(aPart), p_inserted(aInserted), p_queries(aQueries), first(aFirst), last(aLast) { };
+  
+  void operator()() const {
+    std::vector< VertexType > nn_result;
+    for(std::size_t i = first; i < last; ++i) {
+      p_part->insert((*p_inserted)[i]);
+      for(std::size_t j = 0; j < 4; ++j) {
+        nn_result.clear();
+        p_part->find_nearest((*p_queries)[4 * i + j], std::back_inserter(nn_result), 10);
+      };
+    };
+  };
+};
+
 
 int main() {
   typedef ReaK::pp::hyperbox_topology< ReaK::vect<double,6> > TopologyType;
@@ -123,6 +152,127 @@ int main() {
     */    
     outFile << std::endl;
   };
+  
+  
+  /* Throughput of the concurrent DVP-tree (mix of 1 insertion for 4 KNN queries) w.r.t. the thread count. */
+  {
+    typedef ReaK::pp::concurrent_dvp_tree<VertexType, 
+                                          TopologyType, 
+                                          boost::property_map<WorldGridType, boost::vertex_position_t>::type, 
+                                          4> ConcurrentPartition4;
+    typedef concurrent_dvp_worker< ConcurrentPartition4, VertexType, PointType > WorkerType;
+    
+    const unsigned int thread_counts[] = {1, 2, 4, 8, 16};
+    const std::size_t initial_count = 50000;
+    const std::size_t inserted_count = 50000;
+    
+    std::ofstream outConcFile("test_vp_results/dvp_concurrent_6.dat");
+    outConcFile << "Threads\tOps/s\tSpeedup\t (ops are 1 insertion or 1 10-NN query, with 4 queries per insertion)" << std::endl;
+    
+    TopologyType m_space("",ReaK::vect<double,6>(0.0,0.0,0.0,0.0,0.0,0.0),ReaK::vect<double,6>(1.0,1.0,1.0,1.0,1.0,1.0));
+    
+    double single_thread_rate = 0.0;
+    for(int i = 0; i < 5; ++i) {
+      // all vertices are created up-front such that the graph is not mutated by the workers.
+      WorldGridType grid;
+      boost::property_map<WorldGridType, boost::vertex_position_t>::type m_position(get(boost::vertex_position, grid));
+      std::vector< VertexType > initial_vertices;
+      std::vector< VertexType > inserted_vertices;
+      for(std::size_t j = 0; j < initial_count + inserted_count; ++j) {
+        VertexType v = add_vertex(grid);
+        put(m_position,v,m_space.random_point()); 
+        if(j < initial_count)
+          initial_vertices.push_back(v);
+        else
+          inserted_vertices.push_back(v);
+      };
+      std::vector< PointType > queries;
+      for(std::size_t j = 0; j < 4 * inserted_count; ++j)
+        queries.push_back(m_space.random_point());
+      
+      ConcurrentPartition4 part4(initial_vertices.begin(), initial_vertices.end(),
+                                 ReaK::shared_ptr<const TopologyType>(&m_space,ReaK::null_deleter()), m_position);
+      
+      boost::posix_time::ptime t_start = boost::posix_time::microsec_clock::local_time();
+      std::vector< ReaK::shared_ptr< ReaKaux::thread > > workers;
+      std::size_t first = 0;
+      for(unsigned int k = 0; k < thread_counts[i]; ++k) {
+        std::size_t last = first + (inserted_count - first) / (thread_counts[i] - k);
+        workers.push_back(ReaK::shared_ptr< ReaKaux::thread >(new ReaKaux::thread(
+          WorkerType(&part4, &inserted_vertices, &queries, first, last))));
+        first = last;
+      };
+      for(std::size_t k = 0; k < workers.size(); ++k)
+        workers[k]->join();
+      boost::posix_time::time_duration dt = boost::posix_time::microsec_clock::local_time() - t_start;
+      
+      double rate = double(5 * inserted_count) / (dt.total_microseconds() * 1e-6);
+      if(i == 0)
+        single_thread_rate = rate;
+      outConcFile << thread_counts[i] << "\t" << rate << "\t" << rate / single_thread_rate << std::endl;
+      std::cout << "Concurrent VP4 with " << thread_counts[i] << " threads" << std::endl;
+    };
+  };
+  
+  
+  /* Per-insertion latency histogram of the DVP-tree, with unbounded and bounded sub-tree reconstructions, 
+   * and the time of a bulk insertion of the same vertices. */
+  {
+    const std::size_t inserted_count = 100000;
+    const std::size_t max_rebuild_sizes[] = {0, 1024};
+    const double bucket_limits[] = {10.0, 100.0, 1000.0, 10000.0};  // in micro-seconds.
+    
+    std::ofstream outLatFile("test_vp_results/dvp_insert_latency_6.dat");
+    outLatFile << "MaxRebuild\t<10us\t<100us\t<1ms\t<10ms\t>=10ms\tMax(us)\tTotal(ms)" << std::endl;
+    
+    TopologyType m_space("",ReaK::vect<double,6>(0.0,0.0,0.0,0.0,0.0,0.0),ReaK::vect<double,6>(1.0,1.0,1.0,1.0,1.0,1.0));
+    WorldGridType grid;
+    boost::property_map<WorldGridType, boost::vertex_position_t>::type m_position(get(boost::vertex_position, grid));
+    std::vector< VertexType > inserted_vertices;
+    for(std::size_t j = 0; j < inserted_count; ++j) {
+      VertexType v = add_vertex(grid);
+      put(m_position,v,m_space.random_point()); 
+      inserted_vertices.push_back(v);
+    };
+    
+    for(int i = 0; i < 2; ++i) {
+      WorldPartition4 part4(inserted_vertices.begin(), inserted_vertices.begin(),  // <-- empty tree.
+                            ReaK::shared_ptr<const TopologyType>(&m_space,ReaK::null_deleter()), m_position);
+      part4.set_max_rebuild_size(max_rebuild_sizes[i]);
+      
+      std::size_t histogram[5] = {0, 0, 0, 0, 0};
+      double max_latency = 0.0;
+      boost::posix_time::ptime t_start = boost::posix_time::microsec_clock::local_time();
+      for(std::size_t j = 0; j < inserted_count; ++j) {
+        boost::posix_time::ptime t_insert = boost::posix_time::microsec_clock::local_time();
+        part4.insert(inserted_vertices[j]);
+        double latency = double((boost::posix_time::microsec_clock::local_time() - t_insert).total_microseconds());
+        std::size_t k = 0;
+        while((k < 4) && (latency >= bucket_limits[k]))
+          ++k;
+        ++histogram[k];
+        if(latency > max_latency)
+          max_latency = latency;
+      };
+      boost::posix_time::time_duration dt = boost::posix_time::microsec_clock::local_time() - t_start;
+      
+      outLatFile << max_rebuild_sizes[i];
+      for(std::size_t k = 0; k < 5; ++k)
+        outLatFile << "\t" << histogram[k];
+      outLatFile << "\t" << max_latency << "\t" << dt.total_microseconds() * 0.001 << std::endl;
+      std::cout << "VP4 insertions with max-rebuild-size " << max_rebuild_sizes[i] << std::endl;
+    };
+    
+    {
+      WorldPartition4 part4(inserted_vertices.begin(), inserted_vertices.begin(),  // <-- empty tree.
+                            ReaK::shared_ptr<const TopologyType>(&m_space,ReaK::null_deleter()), m_position);
+      boost::posix_time::ptime t_start = boost::posix_time::microsec_clock::local_time();
+      part4.insert(inserted_vertices.begin(), inserted_vertices.end());
+      boost::posix_time::time_duration dt = boost::posix_time::microsec_clock::local_time() - t_start;
+      outLatFile << "bulk\t\t\t\t\t\t\t" << dt.total_microseconds() * 0.001 << std::endl;
+      std::cout << "VP4 bulk insertion" << std::endl;
+    };
+  };
 
 };
 
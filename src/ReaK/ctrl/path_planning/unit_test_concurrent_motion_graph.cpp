@@ -0,0 +1,174 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <ReaK/core/base/thread_incl.hpp>
+#include <ReaK/ctrl/path_planning/motion_graph_structures.hpp>
+#include <ReaK/ctrl/path_planning/any_motion_graphs.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE concurrent_motion_graph
+#include <boost/test/unit_test.hpp>
+
+
+typedef ReaK::pp::hyperbox_topology< ReaK::vect<double,3> > test_space_type;
+typedef test_space_type::point_type test_point_type;
+
+typedef ReaK::pp::optimal_mg_vertex< test_space_type > test_vertex_prop;
+typedef ReaK::pp::optimal_mg_edge< test_space_type > test_edge_prop;
+
+typedef ReaK::pp::concurrent_motion_graph< test_vertex_prop, test_edge_prop, test_space_type >::type test_graph_type;
+typedef boost::graph_traits< test_graph_type >::vertex_descriptor test_vertex_type;
+typedef boost::graph_traits< test_graph_type >::edge_descriptor test_edge_type;
+
+typedef ReaK::pp::any_optimal_motion_graph< test_space_type, test_graph_type > test_te_graph_type;
+typedef ReaK::graph::any_graph::vertex_descriptor te_vertex_type;
+typedef ReaK::graph::any_graph::edge_descriptor te_edge_type;
+
+
+/* Grows a chain of vertices from the root, as a planning thread would, and reads it back through its own type-erased view. */
+struct concurrent_mg_grower {
+  test_graph_type* p_g;
+  test_vertex_type root;
+  int thread_id;
+  int count;
+  bool* p_ok;
+  
+  void operator()() {
+    using ReaK::graph::get_dyn_prop;
+    test_te_graph_type te_g(p_g);
+    test_vertex_type u = root;
+    bool ok = true;
+    for(int i = 0; i < count; ++i) {
+      test_vertex_prop vp;
+      vp.position = test_point_type(thread_id, i, 0.0);
+      vp.distance_accum = i + 1.0;
+      vp.predecessor = 0;
+      test_vertex_type v = add_vertex(vp, *p_g);
+      add_edge(u, v, test_edge_prop(1.0), *p_g);
+      te_vertex_type te_v = te_vertex_type(boost::any(v));
+      const test_point_type& p = get_dyn_prop<const test_point_type&>("vertex_position", te_v, te_g);
+      if( (p[0] != thread_id) || (p[1] != i) || 
+          (get_dyn_prop<const double&>("vertex_distance_accum", te_v, te_g) != i + 1.0) )
+        ok = false;
+      u = v;
+    };
+    *p_ok = ok;
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( concurrent_motion_graph_type_erased_test )
+{
+  using ReaK::graph::get_dyn_prop;
+  
+  test_graph_type g;
+  std::vector< test_vertex_type > vs;
+  for(int i = 0; i < 50; ++i) {
+    test_vertex_prop vp;
+    vp.position = test_point_type(i, 2.0 * i, 3.0 * i);
+    vp.distance_accum = i;
+    vp.predecessor = 0;
+    vs.push_back( add_vertex(vp, g) );
+  };
+  for(int i = 1; i < 50; ++i)
+    add_edge(vs[i-1], vs[i], test_edge_prop(0.5 * i), g);
+  
+  test_te_graph_type te_g(&g);
+  const ReaK::graph::any_graph& any_g = te_g;
+  BOOST_CHECK_EQUAL( num_vertices(any_g), 50 );
+  BOOST_CHECK_EQUAL( num_edges(any_g), 49 );
+  
+  std::size_t v_count = 0;
+  ReaK::graph::any_graph::vertex_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(any_g); vi != vi_end; ++vi) {
+    test_vertex_type v = boost::any_cast< test_vertex_type >(vi->base);
+    const test_point_type& p = get_dyn_prop<const test_point_type&>("vertex_position", *vi, any_g);
+    BOOST_CHECK_EQUAL( p[0], g[v].position[0] );
+    BOOST_CHECK_EQUAL( p[2], g[v].position[2] );
+    BOOST_CHECK_EQUAL( get_dyn_prop<const double&>("vertex_distance_accum", *vi, any_g), g[v].distance_accum );
+    ++v_count;
+  };
+  BOOST_CHECK_EQUAL( v_count, 50 );
+  
+  // properties written through the type-erased graph must reach the concurrent graph:
+  te_vertex_type te_v10 = te_vertex_type(boost::any(vs[10]));
+  get_dyn_prop<double&>("vertex_distance_accum", te_v10, any_g) = 42.0;
+  BOOST_CHECK_EQUAL( g[vs[10]].distance_accum, 42.0 );
+  
+  double weight_sum = 0.0;
+  ReaK::graph::any_graph::edge_iterator ei, ei_end;
+  for(boost::tie(ei, ei_end) = edges(any_g); ei != ei_end; ++ei) {
+    test_edge_type e = boost::any_cast< test_edge_type >(ei->base);
+    BOOST_CHECK( boost::any_cast< test_vertex_type >(source(*ei, any_g).base) == source(e, g) );
+    BOOST_CHECK( boost::any_cast< test_vertex_type >(target(*ei, any_g).base) == target(e, g) );
+    weight_sum += get_dyn_prop<const double&>("edge_weight", *ei, any_g);
+  };
+  BOOST_CHECK_CLOSE( weight_sum, 0.5 * 49 * 25, 1e-10 );
+  
+  BOOST_CHECK_EQUAL( out_degree(te_vertex_type(boost::any(vs[0])), any_g), 1 );
+  BOOST_CHECK_EQUAL( out_degree(te_vertex_type(boost::any(vs[20])), any_g), 2 );
+};
+
+
+BOOST_AUTO_TEST_CASE( concurrent_motion_graph_multithread_test )
+{
+  const int thread_count = 4;
+  const int per_thread = 2000;
+  
+  test_graph_type g;
+  test_vertex_prop vp;
+  vp.position = test_point_type(-1.0, -1.0, -1.0);
+  vp.distance_accum = 0.0;
+  vp.predecessor = 0;
+  test_vertex_type root = create_root(vp, g);
+  
+  bool ok[thread_count];
+  std::vector< ReaKaux::thread* > threads;
+  for(int t = 0; t < thread_count; ++t) {
+    concurrent_mg_grower grower;
+    grower.p_g = &g;
+    grower.root = root;
+    grower.thread_id = t;
+    grower.count = per_thread;
+    grower.p_ok = &ok[t];
+    threads.push_back(new ReaKaux::thread(grower));
+  };
+  for(int t = 0; t < thread_count; ++t) {
+    threads[t]->join();
+    delete threads[t];
+    BOOST_CHECK( ok[t] );
+  };
+  
+  test_te_graph_type te_g(&g);
+  const ReaK::graph::any_graph& any_g = te_g;
+  BOOST_CHECK_EQUAL( num_vertices(any_g), 1 + thread_count * per_thread );
+  BOOST_CHECK_EQUAL( num_edges(any_g), thread_count * per_thread );
+  BOOST_CHECK_EQUAL( out_degree(te_vertex_type(boost::any(root)), any_g), thread_count );
+};
+
+
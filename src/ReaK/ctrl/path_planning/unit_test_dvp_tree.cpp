@@ -0,0 +1,480 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <boost/property_map/property_map.hpp>
+
+#include <ReaK/ctrl/path_planning/metric_space_search.hpp>
+#include <ReaK/ctrl/path_planning/concurrent_dvp_tree.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+#include <ReaK/core/base/thread_pool.hpp>
+#include <ReaK/core/base/thread_incl.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE dvp_tree
+#include <boost/test/unit_test.hpp>
+
+
+typedef ReaK::pp::hyperbox_topology< ReaK::vect<double,6> > test_space_type;
+typedef test_space_type::point_type test_point_type;
+typedef boost::iterator_property_map< std::vector< test_point_type >::iterator, 
+                                      boost::identity_property_map > test_position_map;
+
+typedef ReaK::pp::dvp_tree< std::size_t, test_space_type, test_position_map, 2 > test_partition2;
+typedef ReaK::pp::dvp_tree< std::size_t, test_space_type, test_position_map, 4 > test_partition4;
+
+
+/* A Euclidean distance metric that counts its evaluations, as a measure of the work done by the tree. */
+struct counting_distance_metric : public ReaK::pp::euclidean_distance_metric {
+  static std::size_t eval_count;
+  
+  counting_distance_metric() { };
+  
+  template <typename Topology>
+  counting_distance_metric(const Topology&) { };
+  
+  template <typename Point, typename Topology>
+  double operator()(const Point& a, const Point& b, const Topology& s) const {
+    ++eval_count;
+    return ReaK::pp::euclidean_distance_metric::operator()(a, b, s);
+  };
+  
+  template <typename PointDiff, typename Topology>
+  double operator()(const PointDiff& a, const Topology& s) const {
+    ++eval_count;
+    return ReaK::pp::euclidean_distance_metric::operator()(a, s);
+  };
+};
+
+std::size_t counting_distance_metric::eval_count = 0;
+
+typedef ReaK::pp::hyperbox_topology< ReaK::vect<double,6>, counting_distance_metric > counting_space_type;
+
+
+/* A set of random points in the unit hyperbox, with the tree keys being their indices. */
+struct dvp_tree_fixture {
+  test_space_type space;
+  std::vector< test_point_type > points;
+  std::vector< std::size_t > keys;
+  
+  explicit dvp_tree_fixture(std::size_t aCount = 2000) : 
+    space("test_space", test_point_type(0.0,0.0,0.0,0.0,0.0,0.0), test_point_type(1.0,1.0,1.0,1.0,1.0,1.0)) {
+    for(std::size_t i = 0; i < aCount; ++i) {
+      points.push_back(space.random_point());
+      keys.push_back(i);
+    };
+  };
+  
+  ReaK::shared_ptr<const test_space_type> get_space() const {
+    return ReaK::shared_ptr<const test_space_type>(&space, ReaK::null_deleter());
+  };
+  
+  test_position_map get_position() {
+    return test_position_map(points.begin(), boost::identity_property_map());
+  };
+  
+  /* Returns the sorted distances from a point to all the points. */
+  std::vector<double> get_sorted_distances(const test_point_type& aPoint) const {
+    std::vector<double> result;
+    for(std::size_t i = 0; i < points.size(); ++i)
+      result.push_back(get(ReaK::pp::distance_metric, space)(aPoint, points[i], space));
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  
+  /* Returns the sorted distances from a point to a set of the points. */
+  std::vector<double> get_sorted_distances(const test_point_type& aPoint, const std::vector< std::size_t >& aKeys) const {
+    std::vector<double> result;
+    for(std::size_t i = 0; i < aKeys.size(); ++i)
+      result.push_back(get(ReaK::pp::distance_metric, space)(aPoint, points[aKeys[i]], space));
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+};
+
+
+template <typename Partition>
+void check_approx_knn_bound(dvp_tree_fixture& fix, double aEpsilon) {
+  Partition part(fix.keys.begin(), fix.keys.end(), fix.get_space(), fix.get_position());
+  part.set_approximation(aEpsilon);
+  
+  for(std::size_t q = 0; q < 100; ++q) {
+    test_point_type p = fix.space.random_point();
+    std::vector<double> exact_dists = fix.get_sorted_distances(p);
+    
+    // the nearest-neighbor must be within (1 + epsilon) of the exact nearest-neighbor.
+    std::size_t u = part.find_nearest(p);
+    BOOST_CHECK_LE( get(ReaK::pp::distance_metric, fix.space)(p, fix.points[u], fix.space), 
+                    (1.0 + aEpsilon) * exact_dists[0] + 1e-12 );
+    
+    // the i-th nearest-neighbor must be within (1 + epsilon) of the exact i-th nearest-neighbor.
+    std::vector< std::size_t > result;
+    part.find_nearest(p, std::back_inserter(result), 10);
+    BOOST_CHECK_EQUAL( result.size(), 10 );
+    std::vector<double> approx_dists = fix.get_sorted_distances(p, result);
+    for(std::size_t i = 0; i < approx_dists.size(); ++i) 
+      BOOST_CHECK_LE( approx_dists[i], (1.0 + aEpsilon) * exact_dists[i] + 1e-12 );
+  };
+};
+
+BOOST_AUTO_TEST_CASE( dvp_approx_knn_bound_test )
+{
+  dvp_tree_fixture fix;
+  
+  check_approx_knn_bound< test_partition2 >(fix, 0.0);
+  check_approx_knn_bound< test_partition2 >(fix, 0.5);
+  check_approx_knn_bound< test_partition2 >(fix, 2.0);
+  check_approx_knn_bound< test_partition4 >(fix, 0.0);
+  check_approx_knn_bound< test_partition4 >(fix, 0.5);
+  check_approx_knn_bound< test_partition4 >(fix, 2.0);
+};
+
+
+template <typename Partition>
+void check_approx_knn_visit_cap(dvp_tree_fixture& fix) {
+  Partition part(fix.keys.begin(), fix.keys.end(), fix.get_space(), fix.get_position());
+  
+  // each visited node contributes its vantage-point only, so a query cannot return more 
+  // neighbors than the number of nodes it is allowed to visit.
+  const std::size_t max_visits[] = {1, 4, 16};
+  for(std::size_t i = 0; i < 3; ++i) {
+    part.set_approximation(0.0, max_visits[i]);
+    for(std::size_t q = 0; q < 50; ++q) {
+      std::vector< std::size_t > result;
+      part.find_nearest(fix.space.random_point(), std::back_inserter(result), 50);
+      BOOST_CHECK_GE( result.size(), 1 );
+      BOOST_CHECK_LE( result.size(), max_visits[i] );
+    };
+  };
+  
+  // without a cap, the query visits as many nodes as needed.
+  part.set_approximation(0.0, 0);
+  std::vector< std::size_t > result;
+  part.find_nearest(fix.space.random_point(), std::back_inserter(result), 50);
+  BOOST_CHECK_EQUAL( result.size(), 50 );
+};
+
+BOOST_AUTO_TEST_CASE( dvp_approx_knn_visit_cap_test )
+{
+  dvp_tree_fixture fix;
+  
+  check_approx_knn_visit_cap< test_partition2 >(fix);
+  check_approx_knn_visit_cap< test_partition4 >(fix);
+};
+
+
+/* Returns the maximum number of distance evaluations done by a single insertion into a tree 
+ * which was made unbalanced by erasing a large part of its initial vertices. */
+template <unsigned int Arity>
+std::size_t get_max_insertion_work(std::size_t aMaxRebuildSize, std::size_t& aDepth) {
+  typedef ReaK::pp::dvp_tree< std::size_t, counting_space_type, test_position_map, Arity > partition_type;
+  const std::size_t initial_count = 2000;
+  const std::size_t inserted_count = 4000;
+  
+  counting_space_type space("counting_space", test_point_type(0.0,0.0,0.0,0.0,0.0,0.0), test_point_type(1.0,1.0,1.0,1.0,1.0,1.0));
+  std::vector< test_point_type > points;
+  std::vector< std::size_t > keys;
+  for(std::size_t i = 0; i < initial_count + inserted_count; ++i) {
+    points.push_back(space.random_point());
+    keys.push_back(i);
+  };
+  
+  partition_type part(keys.begin(), keys.begin() + initial_count, 
+                      ReaK::shared_ptr<const counting_space_type>(&space, ReaK::null_deleter()), 
+                      test_position_map(points.begin(), boost::identity_property_map()));
+  // insertions are not capped unless requested.
+  BOOST_CHECK_EQUAL( part.get_max_rebuild_size(), std::size_t(0) );
+  part.set_max_rebuild_size(aMaxRebuildSize);
+  
+  std::size_t erased_count = 0;
+  for(std::size_t i = 0; i < initial_count; ++i) {
+    if(points[i][0] < 0.7) {
+      part.erase(keys[i]);
+      ++erased_count;
+    };
+  };
+  
+  std::size_t max_work = 0;
+  for(std::size_t i = initial_count; i < initial_count + inserted_count; ++i) {
+    counting_distance_metric::eval_count = 0;
+    part.insert(keys[i]);
+    if(counting_distance_metric::eval_count > max_work)
+      max_work = counting_distance_metric::eval_count;
+  };
+  BOOST_CHECK_EQUAL( part.size(), initial_count + inserted_count - erased_count );
+  aDepth = part.depth();
+  return max_work;
+};
+
+template <unsigned int Arity>
+void check_bounded_insertion_work() {
+  const std::size_t max_rebuild_size = 16;
+  
+  // a single insertion computes one distance per level to find the leaf and one per level to update 
+  // the mu-values on the path to the root, and reconstructs a sub-tree of at most max-rebuild-size 
+  // vertices (plus the new one), which requires one distance per vertex per level of that sub-tree, 
+  // and, when capped, re-balances at most one other sub-tree of at most max-rebuild-size vertices.
+  std::size_t depth = 0;
+  std::size_t capped_work = get_max_insertion_work<Arity>(max_rebuild_size, depth);
+  std::size_t rebuild_levels = 1;
+  for(std::size_t n = 1; n < max_rebuild_size + 1; n *= Arity)
+    ++rebuild_levels;
+  const std::size_t work_bound = 2 * (max_rebuild_size + 1) * rebuild_levels + 2 * (depth + 1);
+  BOOST_CHECK_LE( capped_work, work_bound );
+  
+  // without a limit, some insertions reconstruct much larger sub-trees (e.g., the entire tree).
+  std::size_t uncapped_work = get_max_insertion_work<Arity>(0, depth);
+  BOOST_CHECK_GT( uncapped_work, work_bound );
+};
+
+BOOST_AUTO_TEST_CASE( dvp_bounded_insertion_test )
+{
+  for(std::size_t i = 0; i < 4; ++i) {
+    check_bounded_insertion_work<2>();
+    check_bounded_insertion_work<4>();
+  };
+};
+
+
+template <typename Partition>
+void check_batch_queries(dvp_tree_fixture& fix, std::size_t aTreeSize) {
+  Partition part(fix.keys.begin(), fix.keys.begin() + aTreeSize, fix.get_space(), fix.get_position());
+  
+  std::vector< test_point_type > queries;
+  for(std::size_t q = 0; q < 50; ++q)
+    queries.push_back(fix.space.random_point());
+  
+  // the pools are smaller and larger than the number of queries.
+  const std::size_t pool_sizes[] = {1, 2, 4, 7};
+  for(std::size_t i = 0; i < 4; ++i) {
+    ReaK::thread_pool pool(pool_sizes[i]);
+    for(std::size_t query_count = 0; query_count <= queries.size(); query_count += 5) {
+      std::vector< std::size_t > nn_results(query_count, std::size_t(-1));
+      part.find_nearest_batch(pool, queries.begin(), queries.begin() + query_count, nn_results.begin());
+      std::vector< std::vector< std::size_t > > knn_results(query_count, std::vector< std::size_t >(1, std::size_t(-1)));
+      part.find_k_nearest_batch(pool, queries.begin(), queries.begin() + query_count, knn_results.begin(), 10);
+      
+      for(std::size_t q = 0; q < query_count; ++q) {
+        if(aTreeSize == 0) {
+          BOOST_CHECK_EQUAL( nn_results[q], std::size_t() );
+          BOOST_CHECK( knn_results[q].empty() );
+          continue;
+        };
+        BOOST_CHECK_EQUAL( nn_results[q], part.find_nearest(queries[q]) );
+        std::vector< std::size_t > expected;
+        part.find_nearest(queries[q], std::back_inserter(expected), 10);
+        BOOST_CHECK_EQUAL( knn_results[q].size(), expected.size() );
+        BOOST_CHECK( knn_results[q] == expected );
+      };
+    };
+  };
+};
+
+BOOST_AUTO_TEST_CASE( dvp_batch_queries_test )
+{
+  dvp_tree_fixture fix;
+  
+  check_batch_queries< test_partition2 >(fix, fix.keys.size());
+  check_batch_queries< test_partition4 >(fix, fix.keys.size());
+  check_batch_queries< test_partition2 >(fix, 0);
+  check_batch_queries< test_partition4 >(fix, 0);
+};
+
+
+/* Checks that the packed position storage gives the same results as the inline storage, 
+ * with both trees built, and modified, with the same random vantage-points. */
+template <unsigned int Arity>
+void check_packed_positions(dvp_tree_fixture& fix) {
+  typedef ReaK::pp::dvp_tree< std::size_t, test_space_type, test_position_map, Arity, 
+                              ReaK::pp::random_vp_chooser, boost::bfl_d_ary_tree_storage<Arity>, 
+                              ReaK::pp::position_caching_policy, ReaK::pp::dvp_inline_positions > inline_partition;
+  typedef ReaK::pp::dvp_tree< std::size_t, test_space_type, test_position_map, Arity, 
+                              ReaK::pp::random_vp_chooser, boost::bfl_d_ary_tree_storage<Arity>, 
+                              ReaK::pp::position_caching_policy, ReaK::pp::dvp_packed_positions > packed_partition;
+  const std::size_t initial_count = fix.keys.size() / 2;
+  
+  ReaK::get_global_rng().seed(42);
+  inline_partition inline_part(fix.keys.begin(), fix.keys.begin() + initial_count, fix.get_space(), fix.get_position());
+  for(std::size_t i = 0; i < initial_count; i += 3)
+    inline_part.erase(fix.keys[i]);
+  inline_part.insert(fix.keys.begin() + initial_count, fix.keys.end());
+  
+  ReaK::get_global_rng().seed(42);
+  packed_partition packed_part(fix.keys.begin(), fix.keys.begin() + initial_count, fix.get_space(), fix.get_position());
+  for(std::size_t i = 0; i < initial_count; i += 3)
+    packed_part.erase(fix.keys[i]);
+  packed_part.insert(fix.keys.begin() + initial_count, fix.keys.end());
+  
+  BOOST_CHECK_EQUAL( packed_part.size(), inline_part.size() );
+  
+  for(std::size_t q = 0; q < 100; ++q) {
+    test_point_type p = fix.space.random_point();
+    BOOST_CHECK_EQUAL( packed_part.find_nearest(p), inline_part.find_nearest(p) );
+    
+    std::vector< std::size_t > inline_knn, packed_knn;
+    inline_part.find_nearest(p, std::back_inserter(inline_knn), 10);
+    packed_part.find_nearest(p, std::back_inserter(packed_knn), 10);
+    BOOST_CHECK_EQUAL( packed_knn.size(), 10 );
+    BOOST_CHECK( packed_knn == inline_knn );
+    
+    std::vector< std::size_t > inline_range, packed_range;
+    inline_part.find_in_range(p, std::back_inserter(inline_range), 0.3);
+    packed_part.find_in_range(p, std::back_inserter(packed_range), 0.3);
+    BOOST_CHECK( packed_range == inline_range );
+  };
+  
+  // the approximate searches also visit the same vertices, since the trees are identical.
+  inline_part.set_approximation(0.5);
+  packed_part.set_approximation(0.5);
+  for(std::size_t q = 0; q < 100; ++q) {
+    test_point_type p = fix.space.random_point();
+    std::vector< std::size_t > inline_knn, packed_knn;
+    inline_part.find_nearest(p, std::back_inserter(inline_knn), 10);
+    packed_part.find_nearest(p, std::back_inserter(packed_knn), 10);
+    BOOST_CHECK( packed_knn == inline_knn );
+  };
+};
+
+BOOST_AUTO_TEST_CASE( dvp_packed_positions_test )
+{
+  dvp_tree_fixture fix;
+  
+  check_packed_positions<2>(fix);
+  check_packed_positions<4>(fix);
+};
+
+
+typedef ReaK::pp::concurrent_dvp_tree< std::size_t, test_space_type, test_position_map, 4 > test_concurrent_partition;
+
+/* One worker of the concurrent test: inserts every n-th vertex, each followed by a KNN query whose results 
+ * must have been inserted already, and must be at least as close as the K nearest initial vertices. */
+struct concurrent_dvp_test_worker {
+  test_concurrent_partition* p_part;
+  dvp_tree_fixture* p_fix;
+  std::vector< ReaKaux::atomic<int> >* p_inserted;
+  std::size_t first;
+  std::size_t stride;
+  std::size_t initial_count;
+  int* p_error_count;
+  
+  void operator()() const {
+    const std::size_t K = 5;
+    std::vector< std::size_t > initial_keys(p_fix->keys.begin(), p_fix->keys.begin() + initial_count);
+    for(std::size_t i = first; i < p_fix->keys.size(); i += stride) {
+      (*p_inserted)[i].store(1, ReaKaux::memory_order_release);
+      p_part->insert(p_fix->keys[i]);
+      
+      const test_point_type& q = p_fix->points[(i * 7919) % p_fix->points.size()];
+      std::vector< std::size_t > result;
+      p_part->find_nearest(q, std::back_inserter(result), K);
+      std::vector<double> initial_dists = p_fix->get_sorted_distances(q, initial_keys);
+      std::vector<double> result_dists = p_fix->get_sorted_distances(q, result);
+      if(result.size() != K) {
+        ++(*p_error_count);
+        continue;
+      };
+      for(std::size_t j = 0; j < K; ++j) {
+        if(!(*p_inserted)[result[j]].load(ReaKaux::memory_order_acquire) || (result_dists[j] > initial_dists[j]))
+          ++(*p_error_count);
+      };
+    };
+  };
+};
+
+/* Returns the K nearest keys to a point, by linear search over the given keys. */
+std::vector< std::size_t > get_linear_knn(const dvp_tree_fixture& fix, const test_point_type& aPoint, 
+                                          const std::vector< std::size_t >& aKeys, std::size_t K) {
+  std::vector< std::pair< double, std::size_t > > cands;
+  for(std::size_t i = 0; i < aKeys.size(); ++i)
+    cands.push_back(std::make_pair(get(ReaK::pp::distance_metric, fix.space)(aPoint, fix.points[aKeys[i]], fix.space), aKeys[i]));
+  std::sort(cands.begin(), cands.end());
+  std::vector< std::size_t > result;
+  for(std::size_t i = 0; (i < K) && (i < cands.size()); ++i)
+    result.push_back(cands[i].second);
+  return result;
+};
+
+BOOST_AUTO_TEST_CASE( concurrent_dvp_tree_test )
+{
+  dvp_tree_fixture fix(4000);
+  const std::size_t initial_count = 1000;
+  const std::size_t thread_count = 4;
+  
+  std::vector< ReaKaux::atomic<int> > inserted(fix.keys.size());
+  for(std::size_t i = 0; i < fix.keys.size(); ++i)
+    inserted[i].store(i < initial_count ? 1 : 0);
+  
+  // a small write-buffer such that the flushes occur often, concurrently with the queries.
+  test_concurrent_partition part(fix.keys.begin(), fix.keys.begin() + initial_count, fix.get_space(), fix.get_position(), 16);
+  // flushes in chunks smaller than the write-buffer, such that queries interleave with a flush.
+  part.set_flush_chunk_size(4);
+  
+  std::vector< int > error_counts(thread_count, 0);
+  std::vector< ReaK::shared_ptr< ReaKaux::thread > > workers;
+  for(std::size_t k = 0; k < thread_count; ++k) {
+    concurrent_dvp_test_worker w = { &part, &fix, &inserted, initial_count + k, thread_count, initial_count, &error_counts[k] };
+    workers.push_back(ReaK::shared_ptr< ReaKaux::thread >(new ReaKaux::thread(w)));
+  };
+  for(std::size_t k = 0; k < workers.size(); ++k) {
+    workers[k]->join();
+    BOOST_CHECK_EQUAL( error_counts[k], 0 );
+  };
+  BOOST_CHECK_EQUAL( part.size(), fix.keys.size() );
+  part.flush();
+  BOOST_CHECK_EQUAL( part.size(), fix.keys.size() );
+  
+  // once all the insertions are done, the queries are exact (with or without buffered insertions).
+  std::vector< std::size_t > remaining = fix.keys;
+  for(std::size_t round = 0; round < 2; ++round) {
+    for(std::size_t q = 0; q < 100; ++q) {
+      test_point_type p = fix.space.random_point();
+      std::vector< std::size_t > result;
+      part.find_nearest(p, std::back_inserter(result), 10);
+      BOOST_CHECK( result == get_linear_knn(fix, p, remaining, 10) );
+      BOOST_CHECK_EQUAL( part.find_nearest(p), get_linear_knn(fix, p, remaining, 1).front() );
+      
+      std::vector< double > dists = fix.get_sorted_distances(p, remaining);
+      std::vector< std::size_t > in_range;
+      part.find_in_range(p, std::back_inserter(in_range), dists[20]);
+      BOOST_CHECK( in_range == get_linear_knn(fix, p, remaining, 20) );
+    };
+    
+    // erase some of the vertices (from the tree and from the write-buffer).
+    std::vector< std::size_t > kept;
+    for(std::size_t i = 0; i < remaining.size(); ++i) {
+      if(remaining[i] % (3 - round) == 0)
+        part.erase(remaining[i]);
+      else
+        kept.push_back(remaining[i]);
+    };
+    remaining.swap(kept);
+    BOOST_CHECK_EQUAL( part.size(), remaining.size() );
+  };
+};
+
+
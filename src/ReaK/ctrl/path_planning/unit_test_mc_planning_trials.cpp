@@ -0,0 +1,112 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <ReaK/ctrl/path_planning/planner_exec_engines.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/ctrl/topologies/no_obstacle_space.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE mc_planning_trials
+#include <boost/test/unit_test.hpp>
+
+
+typedef ReaK::vect<double,2> test_point_type;
+typedef ReaK::pp::no_obstacle_space< ReaK::pp::hyperbox_topology< test_point_type > > test_world_type;
+
+static const std::size_t test_trial_count = 8;
+static const ReaK::global_rng_type::result_type test_seed = 42;
+
+
+/* Runs the Monte-Carlo trials with the given number of threads, and returns the solutions file's lines. */
+static std::vector< std::string > run_mc_trials(const ReaK::shared_ptr< test_world_type >& world,
+                                                const ReaK::pp::planning_option_collection& plan_options,
+                                                std::size_t aThreadCount,
+                                                std::vector< double >& aBestCosts) {
+  using namespace ReaK;
+  using namespace pp;
+
+  std::string output_stem = "mc_trials_test_" + boost::lexical_cast<std::string>(aThreadCount);
+  {
+    monte_carlo_mp_engine engine(test_trial_count, "rrt", output_stem, aThreadCount, test_seed);
+    execute_p2p_planner(world, plan_options, 2, engine, test_point_type(0.1, 0.1), test_point_type(0.9, 0.9));
+    aBestCosts = engine.trial_best_costs;
+  };
+
+  std::vector< std::string > sol_lines;
+  std::ifstream sol_in((output_stem + "/rrt_solutions.txt").c_str());
+  std::string line;
+  while(std::getline(sol_in, line))
+    sol_lines.push_back(line);
+  sol_in.close();
+
+  boost::filesystem::remove_all(output_stem);
+  return sol_lines;
+};
+
+
+BOOST_AUTO_TEST_CASE( mc_trials_thread_count_test )
+{
+  using namespace ReaK;
+  using namespace pp;
+
+  shared_ptr< test_world_type > world(new test_world_type("test_world",
+    hyperbox_topology< test_point_type >("test_space", test_point_type(0.0,0.0), test_point_type(1.0,1.0)), 0.1));
+
+  planning_option_collection plan_options;
+  plan_options.planning_algo = 0;  // RRT
+  plan_options.max_vertices = 200;
+  plan_options.prog_interval = 10;
+  plan_options.max_results = 1;
+  plan_options.store_policy = ADJ_LIST_MOTION_GRAPH;
+  plan_options.knn_method = LINEAR_SEARCH_KNN;
+
+  std::vector< double > serial_costs, concurrent_costs;
+  std::vector< std::string > serial_sols = run_mc_trials(world, plan_options, 1, serial_costs);
+  std::vector< std::string > concurrent_sols = run_mc_trials(world, plan_options, 4, concurrent_costs);
+
+  // each trial must give the same results, whether the trials are run sequentially or concurrently:
+  BOOST_REQUIRE_EQUAL( serial_costs.size(), test_trial_count );
+  BOOST_REQUIRE_EQUAL( concurrent_costs.size(), test_trial_count );
+  for(std::size_t i = 0; i < test_trial_count; ++i)
+    BOOST_CHECK_EQUAL( serial_costs[i], concurrent_costs[i] );
+
+  BOOST_REQUIRE_EQUAL( serial_sols.size(), concurrent_sols.size() );
+  for(std::size_t i = 0; i < serial_sols.size(); ++i)
+    BOOST_CHECK_EQUAL( serial_sols[i], concurrent_sols[i] );
+
+  // and the trials must be seeded differently:
+  bool all_equal = true;
+  for(std::size_t i = 1; i < test_trial_count; ++i)
+    all_equal = all_equal && ( serial_costs[i] == serial_costs[0] );
+  BOOST_CHECK( !all_equal );
+};
+
+
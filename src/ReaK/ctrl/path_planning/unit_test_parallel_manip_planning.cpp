@@ -0,0 +1,108 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * This test is meant to be run in a build configured with REAK_ENABLE_THREAD_SANITIZER,
+ * the parallel planners must never let their workers share a manipulator free-space,
+ * because its collision checks write to the kinematic model and the proximity queries.
+ */
+
+#include <stdexcept>
+#include <limits>
+
+#include <ReaK/ctrl/path_planning/rrt_path_planner.tpp>
+#include <ReaK/ctrl/path_planning/sbastar_path_planner.tpp>
+#include <ReaK/ctrl/path_planning/path_planner_options.hpp>
+#include <ReaK/ctrl/path_planning/p2p_planning_query.hpp>
+#include <ReaK/ctrl/path_planning/basic_sbmp_reporters.hpp>
+#include <ReaK/ctrl/topologies/manip_free_workspace.hpp>
+#include <ReaK/ctrl/topologies/manip_free_dynamic_workspace.hpp>
+#include <ReaK/ctrl/topologies/Ndof_spaces.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/ctrl/topologies/no_obstacle_space.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE parallel_manip_planning
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+using namespace pp;
+
+typedef Ndof_rl_space<double, 3, 0>::type test_jt_space_type;
+typedef manip_quasi_static_env< test_jt_space_type > test_manip_world_type;
+typedef topology_traits< test_manip_world_type >::point_type test_manip_point_type;
+
+
+static shared_ptr< test_manip_world_type > make_test_manip_world() {
+  // the planners must refuse the parallel workers before doing any collision check,
+  // such that no model (applicator) is needed for this world.
+  return shared_ptr< test_manip_world_type >(new test_manip_world_type(
+    make_Ndof_rl_space<3>(vect<double,3>(-1.0, -1.0, -1.0), vect<double,3>(1.0, 1.0, 1.0), vect<double,3>(1.0, 1.0, 1.0))));
+};
+
+
+BOOST_AUTO_TEST_CASE( reentrant_space_traits_test )
+{
+  BOOST_CHECK( (is_reentrant_space< hyperbox_topology< vect<double,3> > >::type::value) );
+  BOOST_CHECK( (is_reentrant_space< no_obstacle_space< hyperbox_topology< vect<double,3> > > >::type::value) );
+  BOOST_CHECK( !(is_reentrant_space< test_manip_world_type >::type::value) );
+  BOOST_CHECK( !(is_reentrant_space< manip_dynamic_env< test_jt_space_type > >::type::value) );
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_rrt_manip_refused_test )
+{
+  shared_ptr< test_manip_world_type > world = make_test_manip_world();
+  test_manip_point_type start = world->get_super_space().origin();
+  test_manip_point_type goal = world->get_super_space().origin();
+
+  rrt_planner< test_manip_world_type > planner(world, 100, 10,
+    ADJ_LIST_MOTION_GRAPH | LINEAR_SEARCH_KNN, UNIDIRECTIONAL_PLANNING | PARALLEL_PLANNING, 0.1, 0.05,
+    any_sbmp_reporter_chain< test_manip_world_type >());
+  planner.set_worker_count(4);
+
+  path_planning_p2p_query< test_manip_world_type > query("parallel_rrt_query", world, start, goal, 1);
+  BOOST_CHECK_THROW( planner.solve_planning_query(query), std::invalid_argument );
+  BOOST_CHECK( query.get_best_solution_distance() == std::numeric_limits<double>::infinity() );
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_sbastar_manip_refused_test )
+{
+  shared_ptr< test_manip_world_type > world = make_test_manip_world();
+  test_manip_point_type start = world->get_super_space().origin();
+  test_manip_point_type goal = world->get_super_space().origin();
+
+  sbastar_planner< test_manip_world_type > planner(world, 100, 10,
+    ADJ_LIST_MOTION_GRAPH | LINEAR_SEARCH_KNN, LAZY_COLLISION_CHECKING | PARALLEL_PLANNING, 0.1, 0.05, 0.2, 3,
+    any_sbmp_reporter_chain< test_manip_world_type >());
+  planner.set_worker_count(4);
+
+  path_planning_p2p_query< test_manip_world_type > query("parallel_sbastar_query", world, start, goal, 1);
+  BOOST_CHECK_THROW( planner.solve_planning_query(query), std::invalid_argument );
+  BOOST_CHECK( query.get_best_solution_distance() == std::numeric_limits<double>::infinity() );
+};
+
+
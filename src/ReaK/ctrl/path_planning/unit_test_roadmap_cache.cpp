@@ -0,0 +1,493 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <set>
+#include <limits>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/filtered_graph.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <ReaK/ctrl/path_planning/roadmap_cache.hpp>
+#include <ReaK/ctrl/path_planning/metric_space_search.hpp>
+#include <ReaK/ctrl/path_planning/path_planner_options.hpp>
+#include <ReaK/ctrl/path_planning/prm_path_planner.tpp>
+#include <ReaK/ctrl/path_planning/fadprm_path_planner.tpp>
+#include <ReaK/ctrl/path_planning/p2p_planning_query.hpp>
+#include <ReaK/ctrl/path_planning/basic_sbmp_reporters.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+#include <ReaK/ctrl/topologies/no_obstacle_space.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+#include <ReaK/core/base/global_rng.hpp>
+
+#include <boost/ref.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE roadmap_cache
+#include <boost/test/unit_test.hpp>
+
+
+typedef ReaK::pp::hyperbox_topology< ReaK::vect<double,6> > test_space_type;
+typedef test_space_type::point_type test_point_type;
+
+template <typename PointType>
+struct test_vertex {
+  PointType position;
+  double density;
+};
+
+struct test_edge {
+  double weight;
+};
+
+typedef boost::adjacency_list< boost::vecS, boost::vecS, boost::undirectedS, 
+                               test_vertex<test_point_type>, test_edge > test_graph_type;
+typedef boost::graph_traits<test_graph_type>::vertex_descriptor test_vertex_type;
+
+typedef boost::data_member_property_map< test_point_type, test_vertex<test_point_type> > test_bundle_position_map;
+typedef boost::data_member_property_map< double, test_vertex<test_point_type> > test_bundle_density_map;
+typedef boost::data_member_property_map< double, test_edge > test_bundle_weight_map;
+
+typedef boost::property_map< test_graph_type, test_point_type test_vertex<test_point_type>::* >::type test_position_map;
+typedef ReaK::pp::dvp_tree< test_vertex_type, test_space_type, test_position_map, 2 > test_partition2;
+
+typedef ReaK::pp::dvp_tree_layout_record< test_vertex_type, double > test_layout_record;
+
+static const char* const test_file_name = "unit_test_roadmap_cache.rkrc";
+
+
+/* A random roadmap in the unit hyperbox, with each vertex connected to a few random vertices. */
+struct roadmap_cache_fixture {
+  test_space_type space;
+  test_graph_type g;
+  std::vector< test_layout_record > layout;
+  
+  roadmap_cache_fixture() : 
+    space("test_space", test_point_type(0.0,0.0,0.0,0.0,0.0,0.0), test_point_type(1.0,1.0,1.0,1.0,1.0,1.0)) {
+    for(std::size_t i = 0; i < 500; ++i) {
+      test_vertex<test_point_type> vp;
+      vp.position = space.random_point();
+      vp.density = 0.001 * i;
+      add_vertex(vp, g);
+    };
+    for(std::size_t i = 0; i < 500; ++i) {
+      for(std::size_t j = 1; j < 4; ++j) {
+        test_edge ep;
+        ep.weight = 0.5 * i + j;
+        add_edge(vertex(i, g), vertex((i * 7 + j * 31) % 500, g), ep, g);
+      };
+    };
+    test_partition2 part(g, get_space(), get(&test_vertex<test_point_type>::position, g));
+    part.export_layout(std::back_inserter(layout));
+    std::remove(test_file_name);
+  };
+  
+  ~roadmap_cache_fixture() {
+    std::remove(test_file_name);
+  };
+  
+  ReaK::shared_ptr<const test_space_type> get_space() const {
+    return ReaK::shared_ptr<const test_space_type>(&space, ReaK::null_deleter());
+  };
+  
+  void save(std::size_t aArity, std::size_t aKind) const {
+    ReaK::pp::save_roadmap_cache(test_file_name, g, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                                 test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                                 test_bundle_weight_map(&test_edge::weight), 
+                                 layout.begin(), layout.end(), aArity, aKind);
+  };
+  
+  static bool load(test_graph_type& aGraph, std::vector< test_layout_record >& aLayout, 
+                   std::size_t aArity, std::size_t aKind) {
+    return ReaK::pp::load_roadmap_cache(test_file_name, aGraph, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                                        test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                                        test_bundle_weight_map(&test_edge::weight), 
+                                        std::back_inserter(aLayout), aArity, aKind);
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( roadmap_cache_round_trip_test )
+{
+  using namespace ReaK;
+  using namespace pp;
+  
+  roadmap_cache_fixture f;
+  BOOST_CHECK_NO_THROW( f.save(2, DVP_BF2_TREE_KNN) );
+  
+  test_graph_type g2;
+  std::vector< test_layout_record > layout2;
+  BOOST_REQUIRE( roadmap_cache_fixture::load(g2, layout2, 2, DVP_BF2_TREE_KNN) );
+  
+  BOOST_REQUIRE_EQUAL( num_vertices(g2), num_vertices(f.g) );
+  for(std::size_t i = 0; i < num_vertices(f.g); ++i) {
+    for(std::size_t j = 0; j < 6; ++j)
+      BOOST_CHECK_EQUAL( g2[vertex(i, g2)].position[j], f.g[vertex(i, f.g)].position[j] );
+    BOOST_CHECK_EQUAL( g2[vertex(i, g2)].density, f.g[vertex(i, f.g)].density );
+  };
+  
+  BOOST_REQUIRE_EQUAL( num_edges(g2), num_edges(f.g) );
+  boost::graph_traits<test_graph_type>::edge_iterator ei, ei_end, ei2, ei2_end;
+  boost::tie(ei2, ei2_end) = edges(g2);
+  for(boost::tie(ei, ei_end) = edges(f.g); ei != ei_end; ++ei, ++ei2) {
+    BOOST_CHECK_EQUAL( source(*ei2, g2), source(*ei, f.g) );
+    BOOST_CHECK_EQUAL( target(*ei2, g2), target(*ei, f.g) );
+    BOOST_CHECK_EQUAL( g2[*ei2].weight, f.g[*ei].weight );
+  };
+  
+  BOOST_REQUIRE_EQUAL( layout2.size(), f.layout.size() );
+  for(std::size_t i = 0; i < layout2.size(); ++i) {
+    BOOST_CHECK_EQUAL( layout2[i].key, f.layout[i].key );
+    BOOST_CHECK_EQUAL( layout2[i].child_count, f.layout[i].child_count );
+    BOOST_CHECK_EQUAL( layout2[i].mu, f.layout[i].mu );
+  };
+  
+  // the tree imported from the cached layout must give the same neighbors as the original tree:
+  test_partition2 part1(f.g, f.get_space(), get(&test_vertex<test_point_type>::position, f.g));
+  test_partition2 part2(g2, layout2.begin(), layout2.end(), f.get_space(), get(&test_vertex<test_point_type>::position, g2));
+  for(std::size_t i = 0; i < 100; ++i) {
+    test_point_type p = f.space.random_point();
+    BOOST_CHECK_EQUAL( part2.find_nearest(p), part1.find_nearest(p) );
+    std::vector< test_vertex_type > nn1, nn2;
+    part1.find_nearest(p, std::back_inserter(nn1), 10);
+    part2.find_nearest(p, std::back_inserter(nn2), 10);
+    BOOST_CHECK( nn1 == nn2 );
+  };
+  
+  // a file without a layout loads a roadmap without a layout:
+  BOOST_CHECK_NO_THROW( ReaK::pp::save_roadmap_cache(test_file_name, f.g, 
+                          test_bundle_position_map(&test_vertex<test_point_type>::position),
+                          test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                          test_bundle_weight_map(&test_edge::weight)) );
+  test_graph_type g3;
+  std::vector< test_layout_record > layout3;
+  BOOST_CHECK( roadmap_cache_fixture::load(g3, layout3, 4, DVP_BF4_TREE_KNN) );
+  BOOST_CHECK_EQUAL( num_vertices(g3), num_vertices(f.g) );
+  BOOST_CHECK_EQUAL( num_edges(g3), num_edges(f.g) );
+  BOOST_CHECK( layout3.empty() );
+};
+
+
+BOOST_AUTO_TEST_CASE( roadmap_cache_rejection_test )
+{
+  using namespace ReaK;
+  using namespace pp;
+  
+  roadmap_cache_fixture f;
+  test_graph_type g2;
+  std::vector< test_layout_record > layout2;
+  
+  BOOST_CHECK( !roadmap_cache_fixture::load(g2, layout2, 2, DVP_BF2_TREE_KNN) );
+  
+  // a layout of a different arity or kind of tree is rejected, unless no layout is needed:
+  f.save(2, DVP_BF2_TREE_KNN);
+  BOOST_CHECK( !roadmap_cache_fixture::load(g2, layout2, 4, DVP_BF4_TREE_KNN) );
+  BOOST_CHECK( !roadmap_cache_fixture::load(g2, layout2, 2, DVP_COB2_TREE_KNN) );
+  BOOST_CHECK_EQUAL( num_vertices(g2), 0 );
+  BOOST_CHECK( roadmap_cache_fixture::load(g2, layout2, 0, LINEAR_SEARCH_KNN) );
+  BOOST_CHECK_EQUAL( num_vertices(g2), num_vertices(f.g) );
+  BOOST_CHECK( layout2.empty() );
+  
+  // a layout with more children per node than the arity cannot be saved or imported:
+  std::vector< test_layout_record > bad_layout = f.layout;
+  bad_layout[0].child_count = 3;
+  BOOST_CHECK_THROW( ReaK::pp::save_roadmap_cache(test_file_name, f.g, 
+                       test_bundle_position_map(&test_vertex<test_point_type>::position),
+                       test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                       test_bundle_weight_map(&test_edge::weight), 
+                       bad_layout.begin(), bad_layout.end(), 2, DVP_BF2_TREE_KNN), std::invalid_argument );
+  BOOST_CHECK_THROW( test_partition2(f.g, bad_layout.begin(), bad_layout.end(), f.get_space(), 
+                                     get(&test_vertex<test_point_type>::position, f.g)), std::invalid_argument );
+  
+  // a truncated file, or one with record counts that overflow the file size, is rejected:
+  f.save(2, DVP_BF2_TREE_KNN);
+  std::vector<char> file_data;
+  {
+    std::ifstream in_file(test_file_name, std::ios::binary);
+    file_data.assign(std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>());
+  };
+  {
+    std::ofstream out_file(test_file_name, std::ios::binary | std::ios::trunc);
+    out_file.write(&file_data[0], file_data.size() - 1);
+  };
+  test_graph_type g3;
+  std::vector< test_layout_record > layout3;
+  BOOST_CHECK( !roadmap_cache_fixture::load(g3, layout3, 2, DVP_BF2_TREE_KNN) );
+  {
+    pp::detail::roadmap_cache_header hdr;
+    std::memcpy(&hdr, &file_data[0], sizeof(hdr));
+    hdr.vertex_count = (~boost::uint64_t(0)) / sizeof(double) + 2;
+    std::ofstream out_file(test_file_name, std::ios::binary | std::ios::trunc);
+    out_file.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    out_file.write(&file_data[sizeof(hdr)], file_data.size() - sizeof(hdr));
+  };
+  BOOST_CHECK( !roadmap_cache_fixture::load(g3, layout3, 2, DVP_BF2_TREE_KNN) );
+  BOOST_CHECK_EQUAL( num_vertices(g3), 0 );
+  
+  // a roadmap of points of a different dimension is rejected:
+  typedef boost::adjacency_list< boost::vecS, boost::vecS, boost::undirectedS, 
+                                 test_vertex< vect<double,3> >, test_edge > small_graph_type;
+  small_graph_type g_small;
+  for(std::size_t i = 0; i < 10; ++i) {
+    test_vertex< vect<double,3> > vp;
+    vp.position = vect<double,3>(0.1 * i, 0.2 * i, 0.3 * i);
+    vp.density = 0.0;
+    add_vertex(vp, g_small);
+  };
+  ReaK::pp::save_roadmap_cache(test_file_name, g_small, 
+    boost::data_member_property_map< vect<double,3>, test_vertex< vect<double,3> > >(&test_vertex< vect<double,3> >::position),
+    boost::data_member_property_map< double, test_vertex< vect<double,3> > >(&test_vertex< vect<double,3> >::density),
+    test_bundle_weight_map(&test_edge::weight));
+  BOOST_CHECK( !roadmap_cache_fixture::load(g3, layout3, 2, DVP_BF2_TREE_KNN) );
+  BOOST_CHECK_EQUAL( num_vertices(g3), 0 );
+  
+  // a roadmap built in a different environment is rejected:
+  ReaK::pp::save_roadmap_cache(test_file_name, f.g, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                               test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                               test_bundle_weight_map(&test_edge::weight), 
+                               f.layout.begin(), f.layout.end(), 2, DVP_BF2_TREE_KNN, 42);
+  BOOST_CHECK( !ReaK::pp::load_roadmap_cache(test_file_name, g3, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                                             test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                                             test_bundle_weight_map(&test_edge::weight), 
+                                             std::back_inserter(layout3), 2, DVP_BF2_TREE_KNN, 43) );
+  BOOST_CHECK_EQUAL( num_vertices(g3), 0 );
+  BOOST_CHECK( ReaK::pp::load_roadmap_cache(test_file_name, g3, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                                            test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                                            test_bundle_weight_map(&test_edge::weight), 
+                                            std::back_inserter(layout3), 2, DVP_BF2_TREE_KNN, 42) );
+  BOOST_CHECK_EQUAL( num_vertices(g3), num_vertices(f.g) );
+  
+  // the file is written through a temporary file, which does not remain:
+  BOOST_CHECK( !std::ifstream((std::string(test_file_name) + ".tmp").c_str()) );
+  
+  // a layout that refers to a vertex that is not saved cannot be saved (and leaves the file untouched):
+  std::set< test_vertex_type > excluded;
+  excluded.insert(f.layout[0].key);
+  BOOST_CHECK_THROW( ReaK::pp::save_roadmap_cache(test_file_name, 
+                       boost::make_filtered_graph(f.g, boost::keep_all(), boost::is_not_in_subset< std::set< test_vertex_type > >(excluded)), 
+                       test_bundle_position_map(&test_vertex<test_point_type>::position),
+                       test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                       test_bundle_weight_map(&test_edge::weight), 
+                       f.layout.begin(), f.layout.end(), 2, DVP_BF2_TREE_KNN, 42), std::invalid_argument );
+  test_graph_type g4;
+  std::vector< test_layout_record > layout4;
+  BOOST_CHECK( ReaK::pp::load_roadmap_cache(test_file_name, g4, test_bundle_position_map(&test_vertex<test_point_type>::position),
+                                            test_bundle_density_map(&test_vertex<test_point_type>::density), 
+                                            test_bundle_weight_map(&test_edge::weight), 
+                                            std::back_inserter(layout4), 2, DVP_BF2_TREE_KNN, 42) );
+  BOOST_CHECK_EQUAL( num_vertices(g4), num_vertices(f.g) );
+};
+
+
+/* A connector visitor that rejects the connections between a given pair of vertices (in either direction). */
+struct blocked_edge_visitor {
+  test_vertex_type blocked_u, blocked_v;
+  
+  blocked_edge_visitor(test_vertex_type aU, test_vertex_type aV) : blocked_u(aU), blocked_v(aV) { };
+  
+  std::pair<bool, test_edge> can_be_connected(test_vertex_type u, test_vertex_type v, const test_graph_type&) const {
+    test_edge ep;
+    ep.weight = 1.0;
+    return std::pair<bool, test_edge>( !( ( ( u == blocked_u ) && ( v == blocked_v ) ) || 
+                                          ( ( u == blocked_v ) && ( v == blocked_u ) ) ), ep);
+  };
+};
+
+BOOST_AUTO_TEST_CASE( roadmap_cache_checked_path_test )
+{
+  using namespace ReaK;
+  using namespace pp;
+  
+  // a short path 0-1-2-3 and a longer path 0-4-5-3:
+  test_graph_type g;
+  for(std::size_t i = 0; i < 6; ++i)
+    add_vertex(test_vertex<test_point_type>(), g);
+  const std::size_t edge_list[][2] = {{0,1},{1,2},{2,3},{0,4},{4,5},{5,3}};
+  const double edge_weights[] = {1.0, 1.0, 1.0, 2.0, 2.0, 2.0};
+  for(std::size_t i = 0; i < 6; ++i) {
+    test_edge ep;
+    ep.weight = edge_weights[i];
+    add_edge(vertex(edge_list[i][0], g), vertex(edge_list[i][1], g), ep, g);
+  };
+  
+  std::vector< double > heuristic(6, 0.0), distance(6, 0.0), key(6, 0.0);
+  std::vector< test_vertex_type > predecessor(6);
+  std::vector< boost::default_color_type > color(6);
+  boost::property_map< test_graph_type, boost::vertex_index_t >::type index_map = get(boost::vertex_index, g);
+  
+  // if all edges are valid, the shortest path is found:
+  BOOST_CHECK( find_checked_roadmap_path(g, vertex(0, g), vertex(3, g), 
+    boost::make_iterator_property_map(heuristic.begin(), index_map), 
+    boost::make_iterator_property_map(predecessor.begin(), index_map), 
+    boost::make_iterator_property_map(distance.begin(), index_map), 
+    boost::make_iterator_property_map(key.begin(), index_map), 
+    get(&test_edge::weight, g), 
+    boost::make_iterator_property_map(color.begin(), index_map), 
+    blocked_edge_visitor(vertex(0, g), vertex(3, g))) );
+  BOOST_CHECK_EQUAL( distance[3], 3.0 );
+  BOOST_CHECK_EQUAL( predecessor[3], vertex(2, g) );
+  
+  // a cached edge that is no longer valid is excluded, and the path goes around it:
+  BOOST_CHECK( find_checked_roadmap_path(g, vertex(0, g), vertex(3, g), 
+    boost::make_iterator_property_map(heuristic.begin(), index_map), 
+    boost::make_iterator_property_map(predecessor.begin(), index_map), 
+    boost::make_iterator_property_map(distance.begin(), index_map), 
+    boost::make_iterator_property_map(key.begin(), index_map), 
+    get(&test_edge::weight, g), 
+    boost::make_iterator_property_map(color.begin(), index_map), 
+    blocked_edge_visitor(vertex(1, g), vertex(2, g))) );
+  BOOST_CHECK_EQUAL( distance[3], 6.0 );
+  BOOST_CHECK_EQUAL( predecessor[3], vertex(5, g) );
+  BOOST_CHECK_EQUAL( g[edge(vertex(1, g), vertex(2, g), g).first].weight, std::numeric_limits<double>::infinity() );
+  
+  // if no valid path remains, no path is reported:
+  BOOST_CHECK( !find_checked_roadmap_path(g, vertex(0, g), vertex(3, g), 
+    boost::make_iterator_property_map(heuristic.begin(), index_map), 
+    boost::make_iterator_property_map(predecessor.begin(), index_map), 
+    boost::make_iterator_property_map(distance.begin(), index_map), 
+    boost::make_iterator_property_map(key.begin(), index_map), 
+    get(&test_edge::weight, g), 
+    boost::make_iterator_property_map(color.begin(), index_map), 
+    blocked_edge_visitor(vertex(4, g), vertex(5, g))) );
+};
+
+
+
+typedef ReaK::pp::no_obstacle_space< ReaK::pp::hyperbox_topology< ReaK::vect<double,2> > > test_world_type;
+typedef ReaK::vect<double,2> test_world_point_type;
+
+typedef boost::adjacency_list< boost::vecS, boost::vecS, boost::undirectedS, 
+                               test_vertex<test_world_point_type>, test_edge > test_world_graph_type;
+
+/* A reporter that counts the samples added to the motion-graph (with a progress interval of one). */
+struct sample_counting_report : public ReaK::pp::no_sbmp_report {
+  std::size_t sample_count;
+  
+  sample_counting_report() : sample_count(0) { };
+  
+  void reset_internal_state() { sample_count = 0; };
+  
+  template <typename FreeSpaceType, typename MotionGraph, typename PositionMap>
+  void draw_motion_graph(const FreeSpaceType&, const MotionGraph&, PositionMap) { ++sample_count; };
+};
+
+static bool load_world_roadmap(test_world_graph_type& aGraph, const test_world_type& aWorld) {
+  std::vector< ReaK::pp::dvp_tree_layout_record< boost::graph_traits<test_world_graph_type>::vertex_descriptor, double > > layout;
+  return ReaK::pp::load_roadmap_cache(test_file_name, aGraph, 
+    boost::data_member_property_map< test_world_point_type, test_vertex<test_world_point_type> >(&test_vertex<test_world_point_type>::position),
+    boost::data_member_property_map< double, test_vertex<test_world_point_type> >(&test_vertex<test_world_point_type>::density),
+    test_bundle_weight_map(&test_edge::weight), std::back_inserter(layout), 0, 0, 
+    ReaK::pp::get_roadmap_environment_hash(aWorld));
+};
+
+static bool has_vertex_at(const test_world_graph_type& g, const test_world_point_type& p) {
+  boost::graph_traits<test_world_graph_type>::vertex_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    if( ( g[*vi].position[0] == p[0] ) && ( g[*vi].position[1] == p[1] ) )
+      return true;
+  };
+  return false;
+};
+
+
+/* Solves two queries with a planner using a roadmap cache, the second one must be answered through the cached roadmap. */
+template <typename Planner>
+void check_roadmap_cache_reuse(const ReaK::shared_ptr< test_world_type >& world, std::size_t aKNNMethod) {
+  using namespace ReaK;
+  using namespace pp;
+  
+  std::remove(test_file_name);
+  
+  sample_counting_report counter;
+  any_sbmp_reporter_chain< test_world_type > report_chain;
+  report_chain.add_reporter(boost::ref(counter));
+  
+  Planner planner(world, 300, 1, ADJ_LIST_MOTION_GRAPH | aKNNMethod, 0.1, 0.05, 0.2, 2, report_chain);
+  planner.set_roadmap_cache_file(test_file_name);
+  
+  // the first query builds the roadmap, which is saved without the start and goal of the query:
+  test_world_point_type start1(0.05, 0.05), goal1(0.95, 0.95);
+  path_planning_p2p_query< test_world_type > query1("query1", world, start1, goal1, 1);
+  planner.solve_planning_query(query1);
+  BOOST_CHECK( counter.sample_count > 0 );
+  
+  test_world_graph_type g1;
+  BOOST_REQUIRE( load_world_roadmap(g1, *world) );
+  BOOST_CHECK( num_vertices(g1) > 0 );
+  BOOST_CHECK( !has_vertex_at(g1, start1) );
+  BOOST_CHECK( !has_vertex_at(g1, goal1) );
+  
+  // a second query is answered through the cached roadmap, without any new sample:
+  test_world_point_type start2(0.1, 0.9), goal2(0.9, 0.1);
+  path_planning_p2p_query< test_world_type > query2("query2", world, start2, goal2, 1);
+  planner.solve_planning_query(query2);
+  BOOST_CHECK_EQUAL( counter.sample_count, 0 );
+  BOOST_CHECK( query2.get_best_solution_distance() < std::numeric_limits<double>::infinity() );
+  
+  test_world_graph_type g2;
+  BOOST_REQUIRE( load_world_roadmap(g2, *world) );
+  BOOST_CHECK_EQUAL( num_vertices(g2), num_vertices(g1) );
+  BOOST_CHECK_EQUAL( num_edges(g2), num_edges(g1) );
+  BOOST_CHECK( !has_vertex_at(g2, start2) );
+  BOOST_CHECK( !has_vertex_at(g2, goal2) );
+  
+  // a planner in a different environment does not re-use the cached roadmap:
+  shared_ptr< test_world_type > other_world(new test_world_type("test_world", 
+    hyperbox_topology< test_world_point_type >("test_space", test_world_point_type(0.0,0.0), test_world_point_type(2.0,2.0)), 0.2));
+  test_world_graph_type g3;
+  BOOST_CHECK( !load_world_roadmap(g3, *other_world) );
+  Planner other_planner(other_world, 300, 1, ADJ_LIST_MOTION_GRAPH | aKNNMethod, 0.1, 0.05, 0.2, 2, report_chain);
+  other_planner.set_roadmap_cache_file(test_file_name);
+  path_planning_p2p_query< test_world_type > query3("query3", other_world, start2, goal2, 1);
+  other_planner.solve_planning_query(query3);
+  BOOST_CHECK( counter.sample_count > 0 );
+  BOOST_CHECK( load_world_roadmap(g3, *other_world) );
+  
+  std::remove(test_file_name);
+};
+
+
+BOOST_AUTO_TEST_CASE( planner_roadmap_cache_reuse_test )
+{
+  using namespace ReaK;
+  using namespace pp;
+  
+  get_global_rng().seed(42);
+  
+  shared_ptr< test_world_type > world(new test_world_type("test_world", 
+    hyperbox_topology< test_world_point_type >("test_space", test_world_point_type(0.0,0.0), test_world_point_type(1.0,1.0)), 0.2));
+  
+  check_roadmap_cache_reuse< prm_planner< test_world_type > >(world, LINEAR_SEARCH_KNN);
+  check_roadmap_cache_reuse< prm_planner< test_world_type > >(world, DVP_BF2_TREE_KNN);
+  check_roadmap_cache_reuse< fadprm_planner< test_world_type > >(world, LINEAR_SEARCH_KNN);
+  check_roadmap_cache_reuse< fadprm_planner< test_world_type > >(world, DVP_BF2_TREE_KNN);
+};
+
+
@@ -255,6 +255,16 @@ class manip_dynamic_env : public named_object {
       return *this;
     };
     
+    /**
+     * Add a compiled 3D proxy query pair to the collision environment.
+     * \param aProxy The new compiled 3D proxy query pair to add to the collision environment.
+     * \return A reference back to 'this'.
+     */
+    self& operator<<(const shared_ptr< geom::proxy_compiled_pair_3D >& aProxy) {
+      m_prox_env.m_compiled_env_3D.push_back(aProxy);
+      return *this;
+    };
+    
     /**
      * Add a functor to update the proxy-query models for a given time value (parameter to functor call).
      * This builds a list of functors that will be called just before each proximity-queries in order to make sure 
@@ -308,6 +318,11 @@ struct is_reversible_space< manip_dynamic_env<BaseJointSpace> > : boost::mpl::tr
 template <typename BaseJointSpace>
 struct is_point_distribution< manip_dynamic_env<BaseJointSpace> > : boost::mpl::true_ { };
 
+/* The free-space checks apply the joint positions to the shared kinematic model and 
+ * use the mutable scratch of the proximity queries, they cannot run concurrently. */
+template <typename BaseJointSpace>
+struct is_reentrant_space< manip_dynamic_env<BaseJointSpace> > : boost::mpl::false_ { };
+
 template <typename BaseJointSpace>
 struct is_temporal_space< manip_dynamic_env<BaseJointSpace> > : boost::mpl::true_ { };
 
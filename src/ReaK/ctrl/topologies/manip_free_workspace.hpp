@@ -41,11 +41,13 @@
 #include "random_sampler_concept.hpp"
 #include "metric_space_concept.hpp"
 #include "reversible_space_concept.hpp"
+#include "subspace_concept.hpp"
 
 #include <ReaK/ctrl/interpolation/interpolated_topologies.hpp>
 #include "proxy_model_updater.hpp"
 
 #include <ReaK/geometry/proximity/proxy_query_model.hpp>  // for proxy-query class
+#include <ReaK/geometry/proximity/proxy_compiled_model_3D.hpp>  // for compiled proxy-query class
 
 #include "default_random_sampler.hpp"
 
@@ -53,6 +55,7 @@
 #include <boost/bind.hpp>
 #else
 #include <functional>
+#include <limits>
 #endif
 
 namespace ReaK {
@@ -72,9 +75,14 @@ class manip_dk_proxy_env_impl {
     
     std::vector< shared_ptr< geom::proxy_query_pair_2D > > m_proxy_env_2D;
     std::vector< shared_ptr< geom::proxy_query_pair_3D > > m_proxy_env_3D;
+    /// Compiled 3D pairs, checked without proximity finders (not serialized, they must be re-compiled after loading).
+    std::vector< shared_ptr< geom::proxy_compiled_pair_3D > > m_compiled_env_3D;
+    
+    /// Upper-bound on the distance travelled by any point of the manipulator per unit of joint-space distance (0 disables the continuous checks, not serialized).
+    double m_motion_bound;
     
     manip_dk_proxy_env_impl(const shared_ptr< proxy_model_applicator<BaseJointSpace> >& aApplicator = shared_ptr< proxy_model_applicator<BaseJointSpace> >()) :
-                            m_applicator(aApplicator) { };
+                            m_applicator(aApplicator), m_motion_bound(0.0) { };
     
     bool is_free(const point_type& pt, const BaseJointSpace& space) const {
       if(m_applicator)
@@ -94,9 +102,53 @@ class manip_dk_proxy_env_impl {
           return false;
       };
       
+      for( std::vector< shared_ptr< geom::proxy_compiled_pair_3D > >::const_iterator it = m_compiled_env_3D.begin(); it != m_compiled_env_3D.end(); ++it) {
+        (*it)->updateFromPoses();
+        if((*it)->checkCollision())
+          return false;
+      };
+      
       return true;
     };
     
+    template <typename InterpSpace>
+    struct interp_pose_setter {
+      const manip_dk_proxy_env_impl* parent;
+      const InterpSpace* interp_space;
+      const point_type* start;
+      const point_type* end;
+      void operator()(double t) const {
+        parent->m_applicator->apply_to_model(interp_space->move_position_toward(*start, t, *end), interp_space->get_super_space());
+      };
+    };
+    
+    /**
+     * Checks if the motion between two (nearby) points is collision-free. The 3D pairs are swept 
+     * continuously (by conservative advancement, see geom::proxy_query_pair_3D::findFirstContact()), 
+     * such that thin obstacles crossed between the two points are not missed, and all the pairs are 
+     * checked at the end point. Without a motion bound (or applicator), only the end point is checked.
+     * \param a The start point of the motion, assumed to be collision-free.
+     * \param b The end point of the motion.
+     * \param interp_space The interpolated space that generates the motion between the points.
+     * \return True if the motion from a to b is collision-free.
+     */
+    template <typename InterpSpace>
+    bool is_free_motion(const point_type& a, const point_type& b, const InterpSpace& interp_space) const {
+      if((m_applicator) && (m_motion_bound > 0.0)) {
+        interp_pose_setter<InterpSpace> setter;
+        setter.parent = this;
+        setter.interp_space = &interp_space;
+        setter.start = &a;
+        setter.end = &b;
+        double motion_bound = m_motion_bound * interp_space.distance(a, b);
+        for( std::vector< shared_ptr< geom::proxy_query_pair_3D > >::const_iterator it = m_proxy_env_3D.begin(); it != m_proxy_env_3D.end(); ++it) {
+          if((*it)->findFirstContact(setter, motion_bound) != std::numeric_limits<double>::infinity())
+            return false;
+        };
+      };
+      return is_free(b, interp_space.get_super_space());
+    };
+    
 };
 
 };
@@ -161,6 +213,34 @@ class manip_quasi_static_env : public named_object {
       bool operator()(const point_type& p) const { return parent->is_free(p); };
     };
     
+    /* Checks the motion from the last accepted point, the points must be given in the order of travel. */
+    struct is_free_motion_predicate {
+      const self* parent;
+      shared_ptr< point_type > last;
+      is_free_motion_predicate(const self* aParent, const point_type& aStart) : parent(aParent), last(new point_type(aStart)) { };
+      bool operator()(const point_type& p) const { 
+        if( !parent->m_space.is_in_bounds(p) || !parent->m_prox_env.is_free_motion(*last, p, parent->m_space) )
+          return false;
+        *last = p;
+        return true;
+      };
+    };
+    
+    /**
+     * Sets the upper-bound on the distance travelled by any point of the manipulator per unit of 
+     * distance in the joint-space. If positive, the motions between the points checked at every 
+     * minimum interval are swept continuously against the 3D proximity pairs, such that thin 
+     * obstacles are not tunnelled through. This bound is not serialized.
+     * \param aMotionBound The motion bound, or zero to only check the points at every minimum interval (default).
+     */
+    void set_motion_bound(double aMotionBound) { m_prox_env.m_motion_bound = aMotionBound; };
+    
+    /**
+     * Returns the upper-bound on the distance travelled by any point of the manipulator per unit of distance in the joint-space.
+     * \return The motion bound, zero if the motions are not swept continuously.
+     */
+    double get_motion_bound() const { return m_prox_env.m_motion_bound; };
+    
     //Topology concepts:
     
     /**
@@ -179,7 +259,13 @@ class manip_quasi_static_env : public named_object {
      * \return The collision-free distance between the two given points.
      */
     double distance(const point_type& p1, const point_type& p2) const {
-      return m_space.distance(p1, p2, min_interval, is_free_predicate(this));
+      if(m_prox_env.m_motion_bound <= 0.0)
+        return m_space.distance(p1, p2, min_interval, is_free_predicate(this));
+      is_free_motion_predicate pred(this, p1);
+      double result = m_space.distance(p1, p2, min_interval, pred);
+      if((result != std::numeric_limits<double>::infinity()) && !pred(p2))  // the last leg of the motion.
+        return std::numeric_limits<double>::infinity();
+      return result;
     };
     
     /**
@@ -215,7 +301,13 @@ class manip_quasi_static_env : public named_object {
      * far as it can get before a collision.
      */
     point_type move_position_toward(const point_type& p1, double fraction, const point_type& p2) const {
-      return m_space.move_position_toward(p1, fraction, p2, min_interval, is_free_predicate(this));
+      if(m_prox_env.m_motion_bound <= 0.0)
+        return m_space.move_position_toward(p1, fraction, p2, min_interval, is_free_predicate(this));
+      is_free_motion_predicate pred(this, p1);
+      point_type result = m_space.move_position_toward(p1, fraction, p2, min_interval, pred);
+      if(!pred(result))  // the last leg of the motion.
+        return *(pred.last);
+      return result;
     };
     
     /**
@@ -223,7 +315,13 @@ class manip_quasi_static_env : public named_object {
      * far as it can get before a collision.
      */
     point_type move_position_back_to(const point_type& p1, double fraction, const point_type& p2) const {
-      return m_space.move_position_back_to(p1, fraction, p2, min_interval, is_free_predicate(this));
+      if(m_prox_env.m_motion_bound <= 0.0)
+        return m_space.move_position_back_to(p1, fraction, p2, min_interval, is_free_predicate(this));
+      is_free_motion_predicate pred(this, p2);
+      point_type result = m_space.move_position_back_to(p1, fraction, p2, min_interval, pred);
+      if(!pred(result))  // the last leg of the motion.
+        return *(pred.last);
+      return result;
     };
     
     
@@ -275,6 +373,16 @@ class manip_quasi_static_env : public named_object {
       return *this;
     };
     
+    /**
+     * Add a compiled 3D proxy query pair to the collision environment.
+     * \param aProxy The new compiled 3D proxy query pair to add to the collision environment.
+     * \return A reference back to 'this'.
+     */
+    self& operator<<(const shared_ptr< geom::proxy_compiled_pair_3D >& aProxy) {
+      m_prox_env.m_compiled_env_3D.push_back(aProxy);
+      return *this;
+    };
+    
 /*******************************************************************************
                    ReaK's RTTI and Serialization interfaces
 *******************************************************************************/
@@ -312,6 +420,11 @@ struct is_reversible_space< manip_quasi_static_env<BaseJointSpace> > : boost::mp
 template <typename BaseJointSpace>
 struct is_point_distribution< manip_quasi_static_env<BaseJointSpace> > : boost::mpl::true_ { };
 
+/* The free-space checks apply the joint positions to the shared kinematic model and 
+ * use the mutable scratch of the proximity queries, they cannot run concurrently. */
+template <typename BaseJointSpace>
+struct is_reentrant_space< manip_quasi_static_env<BaseJointSpace> > : boost::mpl::false_ { };
+
 template <typename BaseJointSpace>
 struct is_metric_symmetric< manip_quasi_static_env<BaseJointSpace> > : 
   is_metric_symmetric< typename manip_quasi_static_env<BaseJointSpace>::super_space_type > { };
@@ -293,6 +293,35 @@ metric_space_traits< MetricSpace > >::type::distance_metric_type get(distance_me
 };
 
 
+/**
+ * This function computes the distances from one point to each point of a range, using a given 
+ * distance metric. This generic version simply calls the distance metric for each point, but 
+ * distance metrics that can compute such one-to-many distances more efficiently can overload 
+ * this function (it will be found by argument-dependent lookup).
+ * \tparam DistanceMetric The distance metric type, should model the DistanceMetricConcept.
+ * \tparam Point The point-type.
+ * \tparam ForwardIter A forward-iterator type for the range of elements.
+ * \tparam PositionMap A property-map type giving the position (point) associated to an element of the range.
+ * \tparam OutputIter An output-iterator type to which the distance values are written.
+ * \tparam Topology The topology.
+ * \param dist The distance metric.
+ * \param a The point from which the distances are measured.
+ * \param first The start of the range of elements.
+ * \param last The end of the range of elements.
+ * \param pos The position property-map.
+ * \param out The output-iterator to which the distance values are written, in the order of the range.
+ * \param s The topology or space on which the points lie.
+ * \return The output-iterator after the last distance value written.
+ */
+template <typename DistanceMetric, typename Point, typename ForwardIter, typename PositionMap, typename OutputIter, typename Topology>
+OutputIter get_distances(const DistanceMetric& dist, const Point& a, ForwardIter first, ForwardIter last, 
+                         PositionMap pos, OutputIter out, const Topology& s) {
+  for(; first != last; ++first, ++out)
+    *out = dist(a, get(pos, *first), s);
+  return out;
+};
+
+
 
 
 /**
@@ -43,6 +43,7 @@
 #include <ReaK/core/base/shared_object.hpp>
 
 #include <boost/concept_check.hpp>
+#include <boost/mpl/bool.hpp>
 
 /** Main namespace for ReaK */
 namespace ReaK {
@@ -87,6 +88,21 @@ struct SubSpaceConcept {
 
 
 
+/**
+ * This meta-function tells whether the collision checks of a sub-space (e.g., is_free or 
+ * the motion-segment checks) can be called concurrently from several threads on the same 
+ * space object. Most sub-spaces are pure functions of the points they are given, and thus 
+ * are reentrant by default. Sub-spaces that mutate an internal model during their checks 
+ * (e.g., applying the joint positions to a kinematic model before a proximity query) must 
+ * specialize this meta-function to false, and planners will refuse to run parallel workers 
+ * on them.
+ * \tparam Topology The topology type for which the reentrancy is sought.
+ */
+template <typename Topology>
+struct is_reentrant_space : boost::mpl::true_ { };
+
+
+
 struct subspace_map : public shared_object {
   typedef subspace_map self;
   
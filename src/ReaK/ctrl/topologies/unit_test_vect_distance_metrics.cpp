@@ -0,0 +1,163 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <ReaK/ctrl/topologies/vect_distance_metrics.hpp>
+#include <ReaK/ctrl/topologies/hyperbox_topology.hpp>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE vect_distance_metrics
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+using namespace ReaK::pp;
+
+
+/* Fills a vector with random components. */
+template <typename Vector>
+void fill_random(Vector& v, boost::random::mt19937& gen) {
+  boost::random::uniform_real_distribution<double> dist(-10.0, 10.0);
+  for(std::size_t i = 0; i < v.size(); ++i)
+    v[i] = dist(gen);
+};
+
+/* The scalar reference implementations of the distances. */
+double ref_norm2_dist(const double* a, const double* b, std::size_t n) {
+  double result = 0.0;
+  for(std::size_t i = 0; i < n; ++i)
+    result += (a[i] - b[i]) * (a[i] - b[i]);
+  return std::sqrt(result);
+};
+
+double ref_norm1_dist(const double* a, const double* b, std::size_t n) {
+  double result = 0.0;
+  for(std::size_t i = 0; i < n; ++i)
+    result += std::fabs(a[i] - b[i]);
+  return result;
+};
+
+double ref_inf_dist(const double* a, const double* b, std::size_t n) {
+  double result = 0.0;
+  for(std::size_t i = 0; i < n; ++i)
+    if(result < std::fabs(a[i] - b[i]))
+      result = std::fabs(a[i] - b[i]);
+  return result;
+};
+
+
+BOOST_AUTO_TEST_CASE( vect_distance_kernels_test )
+{
+  boost::random::mt19937 gen(42);
+  
+  // all the lengths up to 17 cover every combination of full SIMD blocks and tails (e.g., 7 and 14).
+  for(std::size_t n = 0; n <= 17; ++n) {
+    for(std::size_t k = 0; k < 20; ++k) {
+      vect_n<double> a(n), b(n);
+      fill_random(a, gen);
+      fill_random(b, gen);
+      const double* a_data = pp::detail::get_vect_data(a);
+      const double* b_data = pp::detail::get_vect_data(b);
+      
+      BOOST_CHECK_CLOSE( std::sqrt(pp::detail::vect_sqr_dist_kernel(a_data, b_data, n)) + 1.0, 
+                         ref_norm2_dist(a_data, b_data, n) + 1.0, 1e-10 );
+      BOOST_CHECK_CLOSE( pp::detail::vect_norm1_dist_kernel(a_data, b_data, n) + 1.0, 
+                         ref_norm1_dist(a_data, b_data, n) + 1.0, 1e-10 );
+      BOOST_CHECK_EQUAL( pp::detail::vect_inf_dist_kernel(a_data, b_data, n), 
+                         ref_inf_dist(a_data, b_data, n) );
+    };
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( vect_n_distance_metrics_test )
+{
+  boost::random::mt19937 gen(43);
+  typedef hyperbox_topology< vect_n<double> > space_type;
+  
+  for(std::size_t n = 1; n <= 17; ++n) {
+    space_type space("test_space", vect_n<double>(n, -10.0), vect_n<double>(n, 10.0));
+    
+    vect_n<double> a(n);
+    fill_random(a, gen);
+    std::vector< vect_n<double> > pts(5, vect_n<double>(n));
+    for(std::size_t k = 0; k < pts.size(); ++k)
+      fill_random(pts[k], gen);
+    
+    // the kernel-based metrics must agree with the generic difference-based metrics.
+    std::vector<double> d2(pts.size()), d1(pts.size()), dinf(pts.size());
+    get_distances(euclidean_distance_metric(), a, pts.begin(), pts.end(), boost::typed_identity_property_map< vect_n<double> >(), d2.begin(), space);
+    get_distances(manhattan_distance_metric(), a, pts.begin(), pts.end(), boost::typed_identity_property_map< vect_n<double> >(), d1.begin(), space);
+    get_distances(inf_norm_distance_metric(), a, pts.begin(), pts.end(), boost::typed_identity_property_map< vect_n<double> >(), dinf.begin(), space);
+    for(std::size_t k = 0; k < pts.size(); ++k) {
+      vect_n<double> diff = space.difference(a, pts[k]);
+      BOOST_CHECK_CLOSE( euclidean_distance_metric()(a, pts[k], space), euclidean_distance_metric()(diff, space), 1e-10 );
+      BOOST_CHECK_CLOSE( manhattan_distance_metric()(a, pts[k], space), manhattan_distance_metric()(diff, space), 1e-10 );
+      BOOST_CHECK_CLOSE( inf_norm_distance_metric()(a, pts[k], space), inf_norm_distance_metric()(diff, space), 1e-10 );
+      BOOST_CHECK_CLOSE( d2[k], euclidean_distance_metric()(diff, space), 1e-10 );
+      BOOST_CHECK_CLOSE( d1[k], manhattan_distance_metric()(diff, space), 1e-10 );
+      BOOST_CHECK_CLOSE( dinf[k], inf_norm_distance_metric()(diff, space), 1e-10 );
+    };
+    
+    // points of different sizes must be rejected.
+    vect_n<double> c(n + 1);
+    BOOST_CHECK_THROW( euclidean_distance_metric()(a, c, space), std::range_error );
+    BOOST_CHECK_THROW( manhattan_distance_metric()(a, c, space), std::range_error );
+    BOOST_CHECK_THROW( inf_norm_distance_metric()(a, c, space), std::range_error );
+    pts.push_back(c);
+    BOOST_CHECK_THROW( get_distances(euclidean_distance_metric(), a, pts.begin(), pts.end(), 
+                                     boost::typed_identity_property_map< vect_n<double> >(), d2.begin(), space), std::range_error );
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( vect_fixed_distance_metrics_test )
+{
+  boost::random::mt19937 gen(44);
+  
+  vect<double,7> a7, b7;
+  fill_random(a7, gen); fill_random(b7, gen);
+  hyperbox_topology< vect<double,7> > space7;
+  vect<double,7> diff7 = space7.difference(a7, b7);
+  BOOST_CHECK_CLOSE( euclidean_distance_metric()(a7, b7, space7), euclidean_distance_metric()(diff7, space7), 1e-10 );
+  BOOST_CHECK_CLOSE( manhattan_distance_metric()(a7, b7, space7), manhattan_distance_metric()(diff7, space7), 1e-10 );
+  BOOST_CHECK_CLOSE( inf_norm_distance_metric()(a7, b7, space7), inf_norm_distance_metric()(diff7, space7), 1e-10 );
+  
+  vect<double,14> a14, b14;
+  fill_random(a14, gen); fill_random(b14, gen);
+  hyperbox_topology< vect<double,14> > space14;
+  vect<double,14> diff14 = space14.difference(a14, b14);
+  BOOST_CHECK_CLOSE( euclidean_distance_metric()(a14, b14, space14), euclidean_distance_metric()(diff14, space14), 1e-10 );
+  BOOST_CHECK_CLOSE( manhattan_distance_metric()(a14, b14, space14), manhattan_distance_metric()(diff14, space14), 1e-10 );
+  BOOST_CHECK_CLOSE( inf_norm_distance_metric()(a14, b14, space14), inf_norm_distance_metric()(diff14, space14), 1e-10 );
+};
+
+
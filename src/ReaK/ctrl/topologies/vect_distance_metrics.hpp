@@ -36,7 +36,19 @@
 #include <ReaK/core/base/serializable.hpp>
 
 #include <cmath>
+#include <stdexcept>
 #include <ReaK/core/lin_alg/vect_concepts.hpp>
+#include <ReaK/core/lin_alg/vect_alg.hpp>
+
+#include <boost/mpl/and.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "metric_space_concept.hpp"
 
@@ -45,6 +57,180 @@ namespace ReaK {
 namespace pp {
   
 
+template <typename Vector>
+class vector_topology;  // forward-declaration.
+
+
+namespace detail {
+  
+  /* 
+   * The following are the raw distance kernels used for points that are stored as contiguous 
+   * arrays of doubles. They use the widest vector instructions enabled at compile-time 
+   * (AVX or SSE2), and a scalar loop for the remaining components (or when neither is enabled).
+   * The summation order differs from the naive loop, so results can differ in the last bits.
+   */
+  
+  /* Returns the squared Euclidean distance between two arrays of n doubles. */
+  inline double vect_sqr_dist_kernel(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+    double result = 0.0;
+#if defined(__AVX__)
+    __m256d acc = _mm256_setzero_pd();
+    for(; i + 4 <= n; i += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+      acc = _mm256_add_pd(acc, _mm256_mul_pd(d, d));
+    };
+    double acc_v[4];
+    _mm256_storeu_pd(acc_v, acc);
+    result = (acc_v[0] + acc_v[1]) + (acc_v[2] + acc_v[3]);
+#elif defined(__SSE2__)
+    __m128d acc = _mm_setzero_pd();
+    for(; i + 2 <= n; i += 2) {
+      __m128d d = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+      acc = _mm_add_pd(acc, _mm_mul_pd(d, d));
+    };
+    double acc_v[2];
+    _mm_storeu_pd(acc_v, acc);
+    result = acc_v[0] + acc_v[1];
+#endif
+    for(; i < n; ++i) {
+      double d = a[i] - b[i];
+      result += d * d;
+    };
+    return result;
+  };
+  
+  /* Returns the Manhattan distance between two arrays of n doubles. */
+  inline double vect_norm1_dist_kernel(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+    double result = 0.0;
+#if defined(__AVX__)
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d acc = _mm256_setzero_pd();
+    for(; i + 4 <= n; i += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+      acc = _mm256_add_pd(acc, _mm256_andnot_pd(sign_mask, d));
+    };
+    double acc_v[4];
+    _mm256_storeu_pd(acc_v, acc);
+    result = (acc_v[0] + acc_v[1]) + (acc_v[2] + acc_v[3]);
+#elif defined(__SSE2__)
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    __m128d acc = _mm_setzero_pd();
+    for(; i + 2 <= n; i += 2) {
+      __m128d d = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+      acc = _mm_add_pd(acc, _mm_andnot_pd(sign_mask, d));
+    };
+    double acc_v[2];
+    _mm_storeu_pd(acc_v, acc);
+    result = acc_v[0] + acc_v[1];
+#endif
+    using std::fabs;
+    for(; i < n; ++i)
+      result += fabs(a[i] - b[i]);
+    return result;
+  };
+  
+  /* Returns the infinity-norm distance between two arrays of n doubles. */
+  inline double vect_inf_dist_kernel(const double* a, const double* b, std::size_t n) {
+    std::size_t i = 0;
+    double result = 0.0;
+#if defined(__AVX__)
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d acc = _mm256_setzero_pd();
+    for(; i + 4 <= n; i += 4) {
+      __m256d d = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+      acc = _mm256_max_pd(acc, _mm256_andnot_pd(sign_mask, d));
+    };
+    double acc_v[4];
+    _mm256_storeu_pd(acc_v, acc);
+    for(std::size_t j = 0; j < 4; ++j)
+      if(result < acc_v[j])
+        result = acc_v[j];
+#elif defined(__SSE2__)
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    __m128d acc = _mm_setzero_pd();
+    for(; i + 2 <= n; i += 2) {
+      __m128d d = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+      acc = _mm_max_pd(acc, _mm_andnot_pd(sign_mask, d));
+    };
+    double acc_v[2];
+    _mm_storeu_pd(acc_v, acc);
+    result = (acc_v[0] < acc_v[1] ? acc_v[1] : acc_v[0]);
+#endif
+    using std::fabs;
+    for(; i < n; ++i) {
+      if(result < fabs(a[i] - b[i]))
+        result = fabs(a[i] - b[i]);
+    };
+    return result;
+  };
+  
+  
+  /* Tells if a point-type stores its components as a contiguous array of doubles. */
+  template <typename Point>
+  struct is_contiguous_double_vect : boost::mpl::false_ { };
+  
+  template <unsigned int Size>
+  struct is_contiguous_double_vect< vect<double,Size> > : boost::mpl::true_ { };
+  
+  template <typename Allocator>
+  struct is_contiguous_double_vect< vect_n<double,Allocator> > : boost::mpl::true_ { };
+  
+  /* Tells if the distance kernels can be used directly on two points of a topology, i.e., 
+   * if the points are contiguous doubles and the topology's difference is the vector difference. */
+  template <typename Point, typename Topology>
+  struct has_vect_distance_kernel : boost::mpl::and_< 
+    is_contiguous_double_vect<Point>,
+    boost::is_base_of< vector_topology<Point>, Topology > > { };
+  
+  template <typename Point>
+  inline const double* get_vect_data(const Point& a) {
+    return (a.size() == 0 ? static_cast<const double*>(0) : &a[0]);
+  };
+  
+  /* Returns the number of components that the kernels must process for two points, 
+   * and throws if the two points do not have the same number of components. */
+  template <typename Point>
+  inline std::size_t get_vect_kernel_size(const Point& a, const Point& b) {
+    if(a.size() != b.size())
+      throw std::range_error("Vector size mismatch.");
+    return a.size();
+  };
+  
+  /* Applies a distance kernel between one point and each point of a range. */
+  template <typename Kernel, typename Point, typename ForwardIter, typename PositionMap, typename OutputIter>
+  OutputIter apply_vect_distance_kernel(Kernel kernel, const Point& a, ForwardIter first, ForwardIter last, 
+                                        PositionMap pos, OutputIter out) {
+    const double* a_data = get_vect_data(a);
+    for(; first != last; ++first, ++out) {
+      const Point& b = get(pos, *first);
+      *out = kernel(a_data, get_vect_data(b), get_vect_kernel_size(a, b));
+    };
+    return out;
+  };
+  
+  struct vect_euclidean_kernel {
+    double operator()(const double* a, const double* b, std::size_t n) const {
+      using std::sqrt;
+      return sqrt(vect_sqr_dist_kernel(a, b, n));
+    };
+  };
+  
+  struct vect_norm1_kernel {
+    double operator()(const double* a, const double* b, std::size_t n) const {
+      return vect_norm1_dist_kernel(a, b, n);
+    };
+  };
+  
+  struct vect_inf_norm_kernel {
+    double operator()(const double* a, const double* b, std::size_t n) const {
+      return vect_inf_dist_kernel(a, b, n);
+    };
+  };
+  
+};
+
 
 
 /**
@@ -87,9 +273,26 @@ struct manhattan_distance_metric : public serialization::serializable {
    * \return The distance between two points on a topology.
    */
   template <typename Point, typename Topology>
-  double operator()(const Point& a, const Point& b, const Topology& s) const {
+  typename boost::disable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology& s) const {
     return this->operator()(s.difference(a, b),s);
   };
+  
+  /** 
+   * This function returns the distance between two points on a vector topology, for points 
+   * stored as contiguous doubles, without forming the point-difference.
+   * \tparam Point The point-type.
+   * \tparam Topology The topology.
+   * \param a The first point.
+   * \param b The second point.
+   * \return The distance between two points on a topology.
+   */
+  template <typename Point, typename Topology>
+  typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology&) const {
+    return detail::vect_norm1_kernel()(detail::get_vect_data(a), detail::get_vect_data(b), 
+                                              detail::get_vect_kernel_size(a, b));
+  };
       
 /*******************************************************************************
                    ReaK's RTTI and Serialization interfaces
@@ -102,6 +305,17 @@ struct manhattan_distance_metric : public serialization::serializable {
   RK_RTTI_MAKE_ABSTRACT_1BASE(manhattan_distance_metric,0xC2410001,1,"manhattan_distance_metric",serialization::serializable)
 };
 
+/**
+ * This function computes the distances from one point to each point of a range (see the generic 
+ * get_distances function), for points on a vector topology stored as contiguous doubles.
+ */
+template <typename Point, typename ForwardIter, typename PositionMap, typename OutputIter, typename Topology>
+typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+OutputIter >::type get_distances(const manhattan_distance_metric&, const Point& a, ForwardIter first, ForwardIter last, 
+                                 PositionMap pos, OutputIter out, const Topology&) {
+  return detail::apply_vect_distance_kernel(detail::vect_norm1_kernel(), a, first, last, pos, out);
+};
+
 typedef manhattan_distance_metric norm1_distance_metric;
 
 
@@ -146,9 +360,26 @@ struct euclidean_distance_metric : public serialization::serializable {
    * \return The distance between two points on a topology.
    */
   template <typename Point, typename Topology>
-  double operator()(const Point& a, const Point& b, const Topology& s) const {
+  typename boost::disable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology& s) const {
     return this->operator()(s.difference(a, b),s);
   };
+  
+  /** 
+   * This function returns the distance between two points on a vector topology, for points 
+   * stored as contiguous doubles, without forming the point-difference.
+   * \tparam Point The point-type.
+   * \tparam Topology The topology.
+   * \param a The first point.
+   * \param b The second point.
+   * \return The distance between two points on a topology.
+   */
+  template <typename Point, typename Topology>
+  typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology&) const {
+    return detail::vect_euclidean_kernel()(detail::get_vect_data(a), detail::get_vect_data(b), 
+                                              detail::get_vect_kernel_size(a, b));
+  };
       
 /*******************************************************************************
                    ReaK's RTTI and Serialization interfaces
@@ -161,6 +392,17 @@ struct euclidean_distance_metric : public serialization::serializable {
   RK_RTTI_MAKE_ABSTRACT_1BASE(euclidean_distance_metric,0xC2410002,1,"euclidean_distance_metric",serialization::serializable)
 };
 
+/**
+ * This function computes the distances from one point to each point of a range (see the generic 
+ * get_distances function), for points on a vector topology stored as contiguous doubles.
+ */
+template <typename Point, typename ForwardIter, typename PositionMap, typename OutputIter, typename Topology>
+typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+OutputIter >::type get_distances(const euclidean_distance_metric&, const Point& a, ForwardIter first, ForwardIter last, 
+                                 PositionMap pos, OutputIter out, const Topology&) {
+  return detail::apply_vect_distance_kernel(detail::vect_euclidean_kernel(), a, first, last, pos, out);
+};
+
 typedef euclidean_distance_metric norm2_distance_metric;
 
 
@@ -206,9 +448,26 @@ struct inf_norm_distance_metric : public serialization::serializable {
    * \return The distance between two points on a topology.
    */
   template <typename Point, typename Topology>
-  double operator()(const Point& a, const Point& b, const Topology& s) const {
+  typename boost::disable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology& s) const {
     return this->operator()(s.difference(a, b),s);
   };
+  
+  /** 
+   * This function returns the distance between two points on a vector topology, for points 
+   * stored as contiguous doubles, without forming the point-difference.
+   * \tparam Point The point-type.
+   * \tparam Topology The topology.
+   * \param a The first point.
+   * \param b The second point.
+   * \return The distance between two points on a topology.
+   */
+  template <typename Point, typename Topology>
+  typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+  double >::type operator()(const Point& a, const Point& b, const Topology&) const {
+    return detail::vect_inf_norm_kernel()(detail::get_vect_data(a), detail::get_vect_data(b), 
+                                              detail::get_vect_kernel_size(a, b));
+  };
       
 /*******************************************************************************
                    ReaK's RTTI and Serialization interfaces
@@ -221,6 +480,17 @@ struct inf_norm_distance_metric : public serialization::serializable {
   RK_RTTI_MAKE_ABSTRACT_1BASE(inf_norm_distance_metric,0xC2410003,1,"inf_norm_distance_metric",serialization::serializable)
 };
 
+/**
+ * This function computes the distances from one point to each point of a range (see the generic 
+ * get_distances function), for points on a vector topology stored as contiguous doubles.
+ */
+template <typename Point, typename ForwardIter, typename PositionMap, typename OutputIter, typename Topology>
+typename boost::enable_if< detail::has_vect_distance_kernel<Point, Topology>,
+OutputIter >::type get_distances(const inf_norm_distance_metric&, const Point& a, ForwardIter first, ForwardIter last, 
+                                 PositionMap pos, OutputIter out, const Topology&) {
+  return detail::apply_vect_distance_kernel(detail::vect_inf_norm_kernel(), a, first, last, pos, out);
+};
+
 
 /**
  * This class is a Euclidean distance metric functor which models the DistanceMetricConcept.
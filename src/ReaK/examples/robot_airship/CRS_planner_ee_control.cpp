@@ -261,6 +261,8 @@ void CRS_execute_ee_control_impl(const ReaK::kte::chaser_target_data& scene_data
     return;
   };
   
+  workspace_planner->set_knn_approximation(plan_options.knn_epsilon, plan_options.knn_max_visits);
+  
   pp_query.reset_solution_records();
   workspace_planner->solve_planning_query(pp_query);
   
@@ -224,6 +224,8 @@ void CRS_execute_static_planner_impl(const ReaK::kte::chaser_target_data& scene_
   if(!workspace_planner)
     return;
   
+  workspace_planner->set_knn_approximation(plan_options.knn_epsilon, plan_options.knn_max_visits);
+  
   pp_query.reset_solution_records();
   workspace_planner->solve_planning_query(pp_query);
   
@@ -55,7 +55,7 @@ void prox_ccylinder_box::computeProximity() {
   vect<double,3> cy_t = mCCylinder->getPose().rotateToGlobal(vect<double,3>(0.0,0.0,1.0));
   vect<double,3> bx_c = mBox->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
   
-  proximity_record_3D bxln_result = findProximityBoxToLine(mBox, cy_c, cy_t, 0.5 * mCCylinder->getLength());
+  proximity_record_3D bxln_result = findProximityBoxToLine(mBox, cy_c, cy_t, 0.5 * mCCylinder->getLength(), mLastLineParam);
   
   // add a sphere-sweep around the point-box solution.
   vect<double,3> diff_v = bxln_result.mPoint1 - bxln_result.mPoint2;
@@ -74,7 +74,8 @@ prox_ccylinder_box::prox_ccylinder_box(const shared_ptr< capped_cylinder >& aCCy
                                        const shared_ptr< box >& aBox) :
                                        proximity_finder_3D(),
                                        mCCylinder(aCCylinder),
-                                       mBox(aBox) { };
+                                       mBox(aBox),
+                                       mLastLineParam(std::numeric_limits<double>::quiet_NaN()) { };
     
     
 void RK_CALL prox_ccylinder_box::save(ReaK::serialization::oarchive& A, unsigned int) const {
@@ -53,6 +53,9 @@ class prox_ccylinder_box : public proximity_finder_3D {
     shared_ptr< capped_cylinder > mCCylinder;
     shared_ptr< box > mBox;
     
+    /// The position along the cylinder's axis of the last solution, used to warm-start the next query.
+    double mLastLineParam;
+    
     static void computeProximityOfLine(const shared_ptr< box >&, const vect<double,3>&, const vect<double,3>&, double, proximity_record_3D&);
     
   public:
@@ -0,0 +1,100 @@
+/**
+ * \file prox_convex_convex.hpp
+ *
+ * This library declares a class for proximity queries between two convex shapes, using GJK and EPA.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROX_CONVEX_CONVEX_HPP
+#define REAK_PROX_CONVEX_CONVEX_HPP
+
+#include "proximity_finder_3D.hpp"
+
+#include "prox_gjk_epa.hpp"
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class is for proximity queries between any two convex shapes (spheres, capped-cylinders, 
+ * cylinders, boxes or convex polytopes), using GJK and EPA on the support mappings of the shapes. 
+ * This is used for the pairs of shapes that do not have a dedicated proximity finder.
+ */
+class prox_convex_convex : public proximity_finder_3D {
+  protected:
+    
+    shared_ptr< shape_3D > mShape1;
+    shared_ptr< shape_3D > mShape2;
+    
+    /// The separation found by the last query, used to warm-start the next one.
+    vect<double,3> mLastSeparation;
+    
+  public:
+    
+    /** Returns the first shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape1() const;
+    /** Returns the second shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape2() const;
+    
+    /** This function performs the proximity query on its associated shapes. */
+    virtual void computeProximity();
+    
+    /** 
+     * Default constructor. 
+     * \param aShape1 The first convex shape involved in the proximity query.
+     * \param aShape2 The second convex shape involved in the proximity query.
+     */
+    prox_convex_convex(const shared_ptr< shape_3D >& aShape1 = shared_ptr< shape_3D >(),
+                       const shared_ptr< shape_3D >& aShape2 = shared_ptr< shape_3D >());
+    
+    /** Destructor. */
+    virtual ~prox_convex_convex() { };
+    
+    
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+    
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+    
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+    
+    RK_RTTI_MAKE_CONCRETE_1BASE(prox_convex_convex,0xC320001E,1,"prox_convex_convex",proximity_finder_3D)
+    
+};
+
+
+};
+
+};
+
+#endif
+
@@ -25,6 +25,9 @@
 
 #include <ReaK/core/optimization/line_search.hpp>
 
+#include <algorithm>
+#include <limits>
+
 /** Main namespace for ReaK */
 namespace ReaK {
 
@@ -106,11 +109,35 @@ namespace detail {
 
 
 proximity_record_3D findProximityBoxToLine(const shared_ptr< box >& aBox, const vect<double,3>& aCenter, const vect<double,3>& aTangent, double aHalfLength) {
+  double line_param = std::numeric_limits<double>::quiet_NaN();
+  return findProximityBoxToLine(aBox, aCenter, aTangent, aHalfLength, line_param);
+};
+
+proximity_record_3D findProximityBoxToLine(const shared_ptr< box >& aBox, const vect<double,3>& aCenter, const vect<double,3>& aTangent, double aHalfLength, double& aLineParam) {
   proximity_record_3D result;
   detail::ProxBoxToLineFunctor fct(aBox, aCenter, aTangent, result);
   double lb = -aHalfLength;
   double ub = aHalfLength;
+  if((aLineParam == aLineParam) && (aHalfLength > 0.0)) {
+    // the signed distance to a box is convex along the line, so the probes around the last 
+    // solution tell on which side of them the minimum is.
+    double delta = 0.05 * aHalfLength;
+    double t_prev = std::min(std::max(aLineParam, -aHalfLength), aHalfLength);
+    double t_lo = std::max(t_prev - delta, -aHalfLength);
+    double t_hi = std::min(t_prev + delta, aHalfLength);
+    double t_mid = 0.5 * (t_lo + t_hi);
+    double f_mid = fct(t_mid);
+    if(fct(t_lo) < f_mid) 
+      ub = t_mid;
+    else if(fct(t_hi) < f_mid)
+      lb = t_mid;
+    else {
+      lb = t_lo;
+      ub = t_hi;
+    };
+  };
   optim::golden_section_search(fct, lb, ub, 1e-3 * aHalfLength);
+  aLineParam = 0.5 * (lb + ub);
   return result;  // the result of the search should be found in the result object (filled in by 'fct').
 };
 
@@ -52,6 +52,19 @@ proximity_record_3D findProximityBoxToPoint(const shared_ptr< box >& aBox, const
 
 proximity_record_3D findProximityBoxToLine(const shared_ptr< box >& aBox, const vect<double,3>& aCenter, const vect<double,3>& aTangent, double aHalfLength);
 
+/**
+ * This function finds the proximity between a box and a line-segment, warm-started from the solution of a 
+ * previous query (e.g., on the same shapes, at the last time-step).
+ * \param aBox The box.
+ * \param aCenter The center of the line-segment (global).
+ * \param aTangent The unit direction of the line-segment (global).
+ * \param aHalfLength The half-length of the line-segment.
+ * \param aLineParam As input, the position along the segment of the last solution (NaN if there is none). 
+ *                   As output, the position along the segment of the solution.
+ * \return The proximity record, with mPoint1 on the box and mPoint2 on the line-segment.
+ */
+proximity_record_3D findProximityBoxToLine(const shared_ptr< box >& aBox, const vect<double,3>& aCenter, const vect<double,3>& aTangent, double aHalfLength, double& aLineParam);
+
 
 
 struct slack_minimize_func {
@@ -0,0 +1,658 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/prox_gjk_epa.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+#include <ReaK/geometry/shapes/cylinder.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+bool convex_support_3D::isSupported(const shape_3D& aShape) {
+  return (aShape.getObjectType() == sphere::getStaticObjectType()) ||
+         (aShape.getObjectType() == capped_cylinder::getStaticObjectType()) ||
+         (aShape.getObjectType() == cylinder::getStaticObjectType()) ||
+         (aShape.getObjectType() == box::getStaticObjectType()) ||
+         (aShape.getObjectType() == convex_polytope::getStaticObjectType());
+};
+
+convex_support_3D::convex_support_3D(const shape_3D& aShape) : mVertices(NULL) {
+  pose_3D<double> gbl_pose = aShape.getPose().getGlobalPose();
+  mCenter = gbl_pose.Position;
+  mAxes[0] = gbl_pose.Quat * vect<double,3>(1.0,0.0,0.0);
+  mAxes[1] = gbl_pose.Quat * vect<double,3>(0.0,1.0,0.0);
+  mAxes[2] = gbl_pose.Quat * vect<double,3>(0.0,0.0,1.0);
+  mDims[0] = 0.0; mDims[1] = 0.0; mDims[2] = 0.0;
+
+  if(aShape.getObjectType() == sphere::getStaticObjectType()) {
+    mKind = sphere_kind;
+    mDims[0] = static_cast<const sphere&>(aShape).getRadius();
+  } else if(aShape.getObjectType() == capped_cylinder::getStaticObjectType()) {
+    mKind = ccylinder_kind;
+    mDims[0] = static_cast<const capped_cylinder&>(aShape).getLength();
+    mDims[1] = static_cast<const capped_cylinder&>(aShape).getRadius();
+  } else if(aShape.getObjectType() == cylinder::getStaticObjectType()) {
+    mKind = cylinder_kind;
+    mDims[0] = static_cast<const cylinder&>(aShape).getLength();
+    mDims[1] = static_cast<const cylinder&>(aShape).getRadius();
+  } else if(aShape.getObjectType() == box::getStaticObjectType()) {
+    mKind = box_kind;
+    const box& bx = static_cast<const box&>(aShape);
+    mDims[0] = bx.getDimensions()[0];
+    mDims[1] = bx.getDimensions()[1];
+    mDims[2] = bx.getDimensions()[2];
+  } else if(aShape.getObjectType() == convex_polytope::getStaticObjectType()) {
+    mKind = polytope_kind;
+    mVertices = &(static_cast<const convex_polytope&>(aShape).getVertices());
+  } else
+    throw std::invalid_argument("The shape type is not supported by the convex support mapping!");
+};
+
+convex_support_3D::convex_support_3D(const vect<double,3>& aP0, const vect<double,3>& aP1, const vect<double,3>& aP2) :
+                                     mKind(triangle_kind), mCenter(aP0), mVertices(NULL) {
+  mDims[0] = 0.0; mDims[1] = 0.0; mDims[2] = 0.0;
+  mTriangle[0] = aP0;
+  mTriangle[1] = aP1;
+  mTriangle[2] = aP2;
+};
+
+vect<double,3> convex_support_3D::getCoreSupport(const vect<double,3>& aDir) const {
+  switch(mKind) {
+    case sphere_kind:
+      return mCenter;
+    case ccylinder_kind:
+      if(mAxes[2] * aDir < 0.0)
+        return mCenter - (0.5 * mDims[0]) * mAxes[2];
+      else
+        return mCenter + (0.5 * mDims[0]) * mAxes[2];
+    default:
+      return getSupport(aDir);
+  };
+};
+
+vect<double,3> convex_support_3D::getSupport(const vect<double,3>& aDir) const {
+  using std::sqrt;
+  switch(mKind) {
+    case sphere_kind:
+    case ccylinder_kind: {
+      double d_norm = norm_2(aDir);
+      vect<double,3> c = getCoreSupport(aDir);
+      if(d_norm > std::numeric_limits<double>::epsilon())
+        c += (getMargin() / d_norm) * aDir;
+      return c;
+    };
+    case cylinder_kind: {
+      vect<double,3> d_l = toLocal(aDir);
+      double rad_norm = sqrt(d_l[0] * d_l[0] + d_l[1] * d_l[1]);
+      vect<double,3> p_l(0.0, 0.0, (d_l[2] < 0.0 ? -0.5 : 0.5) * mDims[0]);
+      if(rad_norm > std::numeric_limits<double>::epsilon()) {
+        p_l[0] = mDims[1] * d_l[0] / rad_norm;
+        p_l[1] = mDims[1] * d_l[1] / rad_norm;
+      };
+      return toGlobal(p_l);
+    };
+    case box_kind: {
+      vect<double,3> d_l = toLocal(aDir);
+      return toGlobal(vect<double,3>((d_l[0] < 0.0 ? -0.5 : 0.5) * mDims[0],
+                                     (d_l[1] < 0.0 ? -0.5 : 0.5) * mDims[1],
+                                     (d_l[2] < 0.0 ? -0.5 : 0.5) * mDims[2]));
+    };
+    case polytope_kind: {
+      if(mVertices->empty())
+        return mCenter;
+      vect<double,3> d_l = toLocal(aDir);
+      std::size_t best_i = 0;
+      double best_d = (*mVertices)[0] * d_l;
+      for(std::size_t i = 1; i < mVertices->size(); ++i) {
+        double d = (*mVertices)[i] * d_l;
+        if(d > best_d) {
+          best_d = d;
+          best_i = i;
+        };
+      };
+      return toGlobal((*mVertices)[best_i]);
+    };
+    default: {
+      double d0 = mTriangle[0] * aDir;
+      double d1 = mTriangle[1] * aDir;
+      double d2 = mTriangle[2] * aDir;
+      if(d0 >= d1)
+        return (d0 >= d2 ? mTriangle[0] : mTriangle[2]);
+      return (d1 >= d2 ? mTriangle[1] : mTriangle[2]);
+    };
+  };
+};
+
+double convex_support_3D::getMargin() const {
+  if(mKind == sphere_kind)
+    return mDims[0];
+  if(mKind == ccylinder_kind)
+    return mDims[1];
+  return 0.0;
+};
+
+
+namespace {
+
+/* A vertex of the simplex, as a point of the Minkowski difference (w = a - b) with its origins on each shape. */
+struct gjk_vertex {
+  vect<double,3> w;
+  vect<double,3> a;
+  vect<double,3> b;
+};
+
+gjk_vertex gjk_support(const convex_support_3D& aShape1, const convex_support_3D& aShape2,
+                       const vect<double,3>& aDir, bool aUseCore) {
+  gjk_vertex result;
+  if(aUseCore) {
+    result.a = aShape1.getCoreSupport(aDir);
+    result.b = aShape2.getCoreSupport(-aDir);
+  } else {
+    result.a = aShape1.getSupport(aDir);
+    result.b = aShape2.getSupport(-aDir);
+  };
+  result.w = result.a - result.b;
+  return result;
+};
+
+/* Reduces a segment simplex to the sub-simplex that supports its closest point to the origin. */
+void gjk_closest_on_segment(gjk_vertex* aS, std::size_t& aN, double* aLambda) {
+  vect<double,3> ab = aS[1].w - aS[0].w;
+  double ab_sqr = ab * ab;
+  double t = (ab_sqr > 0.0 ? -(aS[0].w * ab) / ab_sqr : 0.0);
+  if(t <= 0.0) {
+    aN = 1;
+    aLambda[0] = 1.0;
+  } else if(t >= 1.0) {
+    aS[0] = aS[1];
+    aN = 1;
+    aLambda[0] = 1.0;
+  } else {
+    aLambda[0] = 1.0 - t;
+    aLambda[1] = t;
+  };
+};
+
+/* Reduces a triangle simplex to the sub-simplex that supports its closest point to the origin (from Ericson, Real-Time Collision Detection). */
+void gjk_closest_on_triangle(gjk_vertex* aS, std::size_t& aN, double* aLambda) {
+  const vect<double,3>& A = aS[0].w;
+  const vect<double,3>& B = aS[1].w;
+  const vect<double,3>& C = aS[2].w;
+  vect<double,3> ab = B - A;
+  vect<double,3> ac = C - A;
+
+  double d1 = -(ab * A);
+  double d2 = -(ac * A);
+  if((d1 <= 0.0) && (d2 <= 0.0)) {
+    aN = 1;
+    aLambda[0] = 1.0;
+    return;
+  };
+
+  double d3 = -(ab * B);
+  double d4 = -(ac * B);
+  if((d3 >= 0.0) && (d4 <= d3)) {
+    aS[0] = aS[1];
+    aN = 1;
+    aLambda[0] = 1.0;
+    return;
+  };
+
+  double vc = d1 * d4 - d3 * d2;
+  if((vc <= 0.0) && (d1 >= 0.0) && (d3 <= 0.0)) {
+    double v = d1 / (d1 - d3);
+    aN = 2;
+    aLambda[0] = 1.0 - v;
+    aLambda[1] = v;
+    return;
+  };
+
+  double d5 = -(ab * C);
+  double d6 = -(ac * C);
+  if((d6 >= 0.0) && (d5 <= d6)) {
+    aS[0] = aS[2];
+    aN = 1;
+    aLambda[0] = 1.0;
+    return;
+  };
+
+  double vb = d5 * d2 - d1 * d6;
+  if((vb <= 0.0) && (d2 >= 0.0) && (d6 <= 0.0)) {
+    double w = d2 / (d2 - d6);
+    aS[1] = aS[2];
+    aN = 2;
+    aLambda[0] = 1.0 - w;
+    aLambda[1] = w;
+    return;
+  };
+
+  double va = d3 * d6 - d5 * d4;
+  if((va <= 0.0) && ((d4 - d3) >= 0.0) && ((d5 - d6) >= 0.0)) {
+    double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    aS[0] = aS[1];
+    aS[1] = aS[2];
+    aN = 2;
+    aLambda[0] = 1.0 - w;
+    aLambda[1] = w;
+    return;
+  };
+
+  double denom = va + vb + vc;
+  if(denom <= 0.0) {
+    // degenerate (collinear) triangle, fall back to its longest edge.
+    aS[1] = aS[((ab * ab) >= (ac * ac) ? 1 : 2)];
+    aN = 2;
+    gjk_closest_on_segment(aS, aN, aLambda);
+    return;
+  };
+  aN = 3;
+  aLambda[1] = vb / denom;
+  aLambda[2] = vc / denom;
+  aLambda[0] = 1.0 - aLambda[1] - aLambda[2];
+};
+
+/* Reduces a tetrahedron simplex to the sub-simplex that supports its closest point to the origin, returns false if the origin is inside. */
+bool gjk_closest_on_tetrahedron(gjk_vertex* aS, std::size_t& aN, double* aLambda) {
+  static const std::size_t faces[4][4] = {{0,1,2,3}, {0,2,3,1}, {0,3,1,2}, {1,3,2,0}};
+
+  double best_dist = std::numeric_limits<double>::infinity();
+  gjk_vertex best_s[3];
+  std::size_t best_n = 0;
+  double best_lambda[3];
+
+  for(std::size_t f = 0; f < 4; ++f) {
+    const vect<double,3>& A = aS[faces[f][0]].w;
+    vect<double,3> nrm = (aS[faces[f][1]].w - A) % (aS[faces[f][2]].w - A);
+    double s_origin = -(nrm * A);
+    double s_opposite = nrm * (aS[faces[f][3]].w - A);
+    // a face is a candidate if the origin is on the other side of it than the opposite vertex,
+    //  or if the tetrahedron is flat (in which case all faces are candidates).
+    double tol = 1e-12 * (nrm * nrm);
+    if((s_origin * s_opposite > 0.0) && (std::fabs(s_opposite) > tol))
+      continue;
+    if((s_origin == 0.0) && (s_opposite != 0.0))
+      continue;
+
+    gjk_vertex s[3] = {aS[faces[f][0]], aS[faces[f][1]], aS[faces[f][2]]};
+    std::size_t n = 3;
+    double lambda[3];
+    gjk_closest_on_triangle(s, n, lambda);
+    vect<double,3> v = lambda[0] * s[0].w;
+    for(std::size_t i = 1; i < n; ++i)
+      v += lambda[i] * s[i].w;
+    double dist = v * v;
+    if(dist < best_dist) {
+      best_dist = dist;
+      best_n = n;
+      for(std::size_t i = 0; i < n; ++i) {
+        best_s[i] = s[i];
+        best_lambda[i] = lambda[i];
+      };
+    };
+  };
+
+  if(best_n == 0)
+    return false;
+
+  aN = best_n;
+  for(std::size_t i = 0; i < best_n; ++i) {
+    aS[i] = best_s[i];
+    aLambda[i] = best_lambda[i];
+  };
+  return true;
+};
+
+struct gjk_result {
+  gjk_vertex simplex[4];
+  std::size_t count;
+  double lambda[4];
+  vect<double,3> v;
+  bool intersect;
+};
+
+void gjk_run(const convex_support_3D& aShape1, const convex_support_3D& aShape2, bool aUseCore, 
+             const vect<double,3>& aInitDir, gjk_result& r) {
+  const double rel_tol = 1e-10;
+  const double abs_tol_sqr = 1e-24;
+  const std::size_t max_iter = 64;
+
+  r.simplex[0] = gjk_support(aShape1, aShape2, aInitDir, aUseCore);
+  r.count = 1;
+  r.lambda[0] = 1.0;
+  r.v = r.simplex[0].w;
+  r.intersect = false;
+
+  for(std::size_t it = 0; it < max_iter; ++it) {
+    double v_sqr = r.v * r.v;
+    if(v_sqr <= abs_tol_sqr) {
+      r.intersect = true;
+      return;
+    };
+
+    gjk_vertex w = gjk_support(aShape1, aShape2, -r.v, aUseCore);
+    if(v_sqr - r.v * w.w <= rel_tol * v_sqr)
+      return;
+    for(std::size_t i = 0; i < r.count; ++i)
+      if(norm_2_sqr(w.w - r.simplex[i].w) <= abs_tol_sqr)
+        return;
+
+    r.simplex[r.count++] = w;
+    bool outside = true;
+    switch(r.count) {
+      case 2:
+        gjk_closest_on_segment(r.simplex, r.count, r.lambda);
+        break;
+      case 3:
+        gjk_closest_on_triangle(r.simplex, r.count, r.lambda);
+        break;
+      default:
+        outside = gjk_closest_on_tetrahedron(r.simplex, r.count, r.lambda);
+        break;
+    };
+    if(!outside) {
+      r.intersect = true;
+      return;
+    };
+
+    vect<double,3> v_new = r.lambda[0] * r.simplex[0].w;
+    for(std::size_t i = 1; i < r.count; ++i)
+      v_new += r.lambda[i] * r.simplex[i].w;
+    double v_new_sqr = v_new * v_new;
+    r.v = v_new;
+    if(v_new_sqr >= v_sqr)  // no more progress (numerical limit).
+      return;
+  };
+};
+
+
+struct epa_face {
+  std::size_t i[3];
+  vect<double,3> n;
+  double d;
+  bool live;
+};
+
+bool epa_make_face(const std::vector< gjk_vertex >& aVerts, std::size_t aI0, std::size_t aI1, std::size_t aI2,
+                   const vect<double,3>& aInterior, epa_face& aFace) {
+  const vect<double,3>& A = aVerts[aI0].w;
+  vect<double,3> nrm = (aVerts[aI1].w - A) % (aVerts[aI2].w - A);
+  double nrm_len = norm_2(nrm);
+  if(nrm_len <= std::numeric_limits<double>::epsilon() * norm_2_sqr(aVerts[aI1].w - A))
+    return false;
+  nrm *= 1.0 / nrm_len;
+  aFace.i[0] = aI0;
+  aFace.i[1] = aI1;
+  aFace.i[2] = aI2;
+  if(nrm * (A - aInterior) < 0.0) {
+    nrm = -nrm;
+    aFace.i[1] = aI2;
+    aFace.i[2] = aI1;
+  };
+  aFace.n = nrm;
+  aFace.d = nrm * A;
+  aFace.live = true;
+  return true;
+};
+
+/* Completes a simplex that contains the origin into a tetrahedron, returns false if the Minkowski difference is flat. */
+bool epa_blow_up(const convex_support_3D& aShape1, const convex_support_3D& aShape2, gjk_result& r) {
+  const double tol = 1e-12;
+  static const vect<double,3> axes[6] = {
+    vect<double,3>(1.0,0.0,0.0), vect<double,3>(-1.0,0.0,0.0),
+    vect<double,3>(0.0,1.0,0.0), vect<double,3>(0.0,-1.0,0.0),
+    vect<double,3>(0.0,0.0,1.0), vect<double,3>(0.0,0.0,-1.0) };
+
+  if(r.count == 1) {
+    for(std::size_t k = 0; k < 6; ++k) {
+      gjk_vertex w = gjk_support(aShape1, aShape2, axes[k], false);
+      if(norm_2(w.w - r.simplex[0].w) > tol) {
+        r.simplex[r.count++] = w;
+        break;
+      };
+    };
+    if(r.count == 1)
+      return false;
+  };
+
+  if(r.count == 2) {
+    vect<double,3> u = r.simplex[1].w - r.simplex[0].w;
+    std::size_t k_min = 0;
+    for(std::size_t k = 1; k < 3; ++k)
+      if(std::fabs(u[k]) < std::fabs(u[k_min]))
+        k_min = k;
+    vect<double,3> d1 = u % axes[2 * k_min];
+    vect<double,3> d2 = u % d1;
+    vect<double,3> dirs[4] = {d1, -d1, d2, -d2};
+    for(std::size_t k = 0; k < 4; ++k) {
+      gjk_vertex w = gjk_support(aShape1, aShape2, dirs[k], false);
+      if(norm_2((w.w - r.simplex[0].w) % u) > tol * norm_2(u)) {
+        r.simplex[r.count++] = w;
+        break;
+      };
+    };
+    if(r.count == 2)
+      return false;
+  };
+
+  if(r.count == 3) {
+    vect<double,3> nrm = (r.simplex[1].w - r.simplex[0].w) % (r.simplex[2].w - r.simplex[0].w);
+    double nrm_len = norm_2(nrm);
+    gjk_vertex w = gjk_support(aShape1, aShape2, nrm, false);
+    if(std::fabs(nrm * (w.w - r.simplex[0].w)) <= tol * nrm_len) {
+      w = gjk_support(aShape1, aShape2, -nrm, false);
+      if(std::fabs(nrm * (w.w - r.simplex[0].w)) <= tol * nrm_len)
+        return false;
+    };
+    r.simplex[r.count++] = w;
+  };
+
+  return true;
+};
+
+void epa_add_edge(std::vector< std::pair<std::size_t, std::size_t> >& aEdges, std::size_t aA, std::size_t aB) {
+  for(std::size_t k = 0; k < aEdges.size(); ++k) {
+    if(((aEdges[k].first == aA) && (aEdges[k].second == aB)) ||
+       ((aEdges[k].first == aB) && (aEdges[k].second == aA))) {
+      aEdges[k] = aEdges.back();
+      aEdges.pop_back();
+      return;
+    };
+  };
+  aEdges.push_back(std::make_pair(aA, aB));
+};
+
+proximity_record_3D epa_touching_result(const gjk_result& r) {
+  proximity_record_3D result;
+  result.mPoint1 = r.lambda[0] * r.simplex[0].a;
+  result.mPoint2 = r.lambda[0] * r.simplex[0].b;
+  for(std::size_t i = 1; i < r.count; ++i) {
+    result.mPoint1 += r.lambda[i] * r.simplex[i].a;
+    result.mPoint2 += r.lambda[i] * r.simplex[i].b;
+  };
+  // the shapes are in contact but the penetration is too thin (or flat) to be measured, report it as the smallest penetration.
+  result.mDistance = -std::numeric_limits<double>::epsilon();
+  return result;
+};
+
+proximity_record_3D epa_run(const convex_support_3D& aShape1, const convex_support_3D& aShape2, gjk_result& r) {
+  const double tol = 1e-6;
+  const std::size_t max_iter = 128;
+
+  if(r.count < 4) {
+    // the origin is on the hull of the simplex, the barycentric weights from GJK are still valid for it.
+    gjk_result r_touch = r;
+    if(!epa_blow_up(aShape1, aShape2, r))
+      return epa_touching_result(r_touch);
+  };
+
+  std::vector< gjk_vertex > verts(r.simplex, r.simplex + 4);
+  vect<double,3> interior = 0.25 * (verts[0].w + verts[1].w + verts[2].w + verts[3].w);
+
+  std::vector< epa_face > faces;
+  faces.reserve(64);
+  static const std::size_t tet_faces[4][3] = {{0,1,2}, {0,2,3}, {0,3,1}, {1,3,2}};
+  for(std::size_t f = 0; f < 4; ++f) {
+    epa_face fc;
+    if(epa_make_face(verts, tet_faces[f][0], tet_faces[f][1], tet_faces[f][2], interior, fc))
+      faces.push_back(fc);
+  };
+
+  std::vector< std::pair<std::size_t, std::size_t> > edges;
+  std::size_t best = faces.size();
+  for(std::size_t it = 0; it < max_iter; ++it) {
+    best = faces.size();
+    for(std::size_t f = 0; f < faces.size(); ++f)
+      if(faces[f].live && ((best == faces.size()) || (faces[f].d < faces[best].d)))
+        best = f;
+    if(best == faces.size())
+      break;
+
+    gjk_vertex w = gjk_support(aShape1, aShape2, faces[best].n, false);
+    if((faces[best].n * w.w) - faces[best].d <= tol * (1.0 + faces[best].d))
+      break;
+
+    std::size_t w_i = verts.size();
+    verts.push_back(w);
+    edges.clear();
+    for(std::size_t f = 0; f < faces.size(); ++f) {
+      if(!faces[f].live)
+        continue;
+      if(faces[f].n * (w.w - verts[faces[f].i[0]].w) > 0.0) {
+        faces[f].live = false;
+        epa_add_edge(edges, faces[f].i[0], faces[f].i[1]);
+        epa_add_edge(edges, faces[f].i[1], faces[f].i[2]);
+        epa_add_edge(edges, faces[f].i[2], faces[f].i[0]);
+      };
+    };
+    for(std::size_t k = 0; k < edges.size(); ++k) {
+      epa_face fc;
+      if(epa_make_face(verts, edges[k].first, edges[k].second, w_i, interior, fc))
+        faces.push_back(fc);
+    };
+  };
+
+  if(best == faces.size()) {
+    gjk_result r_touch = r;
+    r_touch.count = 1;
+    r_touch.lambda[0] = 1.0;
+    return epa_touching_result(r_touch);
+  };
+
+  // barycentric coordinates of the projection of the origin on the closest face.
+  const epa_face& fc = faces[best];
+  const gjk_vertex& A = verts[fc.i[0]];
+  const gjk_vertex& B = verts[fc.i[1]];
+  const gjk_vertex& C = verts[fc.i[2]];
+  vect<double,3> p = fc.d * fc.n;
+  vect<double,3> v0 = B.w - A.w;
+  vect<double,3> v1 = C.w - A.w;
+  vect<double,3> v2 = p - A.w;
+  double d00 = v0 * v0;
+  double d01 = v0 * v1;
+  double d11 = v1 * v1;
+  double d20 = v2 * v0;
+  double d21 = v2 * v1;
+  double denom = d00 * d11 - d01 * d01;
+  double lv = (d11 * d20 - d01 * d21) / denom;
+  double lw = (d00 * d21 - d01 * d20) / denom;
+  double lu = 1.0 - lv - lw;
+
+  proximity_record_3D result;
+  result.mPoint1 = lu * A.a + lv * B.a + lw * C.a;
+  result.mPoint2 = lu * A.b + lv * B.b + lw * C.b;
+  result.mDistance = -fc.d;
+  return result;
+};
+
+};
+
+
+proximity_record_3D findProximityGJKEPA(const convex_support_3D& aShape1, const convex_support_3D& aShape2) {
+  vect<double,3> dir(0.0,0.0,0.0);
+  return findProximityGJKEPA(aShape1, aShape2, dir);
+};
+
+proximity_record_3D findProximityGJKEPA(const convex_support_3D& aShape1, const convex_support_3D& aShape2,
+                                        vect<double,3>& aSeparation) {
+  const double core_tol = 1e-10;
+  double margin1 = aShape1.getMargin();
+  double margin2 = aShape2.getMargin();
+  bool has_margins = (margin1 > 0.0) || (margin2 > 0.0);
+
+  // the first support point is taken along the last separation (pointing from the first shape to the second).
+  vect<double,3> init_dir = -aSeparation;
+  if(norm_2_sqr(init_dir) == 0.0)
+    init_dir = vect<double,3>(1.0,0.0,0.0);
+
+  gjk_result r;
+  gjk_run(aShape1, aShape2, has_margins, init_dir, r);
+
+  double dist = norm_2(r.v);
+  if(!r.intersect && (!has_margins || (dist > core_tol))) {
+    proximity_record_3D result;
+    result.mPoint1 = r.lambda[0] * r.simplex[0].a;
+    result.mPoint2 = r.lambda[0] * r.simplex[0].b;
+    for(std::size_t i = 1; i < r.count; ++i) {
+      result.mPoint1 += r.lambda[i] * r.simplex[i].a;
+      result.mPoint2 += r.lambda[i] * r.simplex[i].b;
+    };
+    if(has_margins) {
+      // the closest points of the cores are swept by the margins, along the normal between the cores.
+      vect<double,3> nrm = (-1.0 / dist) * r.v;
+      result.mPoint1 += margin1 * nrm;
+      result.mPoint2 -= margin2 * nrm;
+      dist -= margin1 + margin2;
+    };
+    result.mDistance = dist;
+    aSeparation = r.v;
+    return result;
+  };
+
+  if(has_margins) {
+    // the cores intersect, so the penetration must be found on the full shapes.
+    gjk_run(aShape1, aShape2, false, init_dir, r);
+    if(!r.intersect)
+      return epa_touching_result(r);
+  };
+
+  proximity_record_3D result = epa_run(aShape1, aShape2, r);
+  aSeparation = result.mPoint1 - result.mPoint2;
+  return result;
+};
+
+
+};
+
+};
+
@@ -0,0 +1,157 @@
+/**
+ * \file prox_gjk_epa.hpp
+ *
+ * This library declares the generic proximity query between two convex shapes, using the
+ * Gilbert-Johnson-Keerthi (GJK) algorithm for the distance between separated shapes, and the
+ * Expanding Polytope Algorithm (EPA) for the penetration depth of intersecting shapes. Both rely
+ * only on the support mapping of the shapes (the farthest point in a given direction), which is
+ * provided by the convex_support_3D class for all the convex shapes (and for single triangles,
+ * which are used for triangle meshes).
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROX_GJK_EPA_HPP
+#define REAK_PROX_GJK_EPA_HPP
+
+#include "proximity_record_3D.hpp"
+
+#include <ReaK/geometry/shapes/shape_3D.hpp>
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class is the support mapping of a convex shape, in the global frame, at the pose the shape
+ * had when the support mapping was created. Spheres and capped-cylinders are split into a core
+ * (a point or a segment) and a margin (the radius), such that GJK can work on the cores and only
+ * fall back to the full shapes (and EPA) when the cores themselves intersect.
+ */
+class convex_support_3D {
+  public:
+
+    enum support_kind {
+      sphere_kind = 0,
+      ccylinder_kind,
+      cylinder_kind,
+      box_kind,
+      polytope_kind,
+      triangle_kind
+    };
+
+  private:
+
+    int mKind;
+    vect<double,3> mAxes[3];   ///< Global directions of the local axes of the shape.
+    vect<double,3> mCenter;    ///< Global position of the shape (or first corner of a triangle).
+    double mDims[3];
+    const std::vector< vect<double,3> >* mVertices;
+    vect<double,3> mTriangle[3];
+
+    vect<double,3> toLocal(const vect<double,3>& aDir) const {
+      return vect<double,3>(mAxes[0] * aDir, mAxes[1] * aDir, mAxes[2] * aDir);
+    };
+    vect<double,3> toGlobal(const vect<double,3>& aPt) const {
+      return mCenter + aPt[0] * mAxes[0] + aPt[1] * mAxes[1] + aPt[2] * mAxes[2];
+    };
+
+  public:
+
+    /**
+     * Checks if a shape is supported (i.e., is a sphere, capped-cylinder, cylinder, box or convex polytope).
+     */
+    static bool isSupported(const shape_3D& aShape);
+
+    /**
+     * Creates the support mapping of a shape, at its current global pose.
+     * \param aShape The shape, which must outlive this object if it is a convex polytope.
+     * \throw std::invalid_argument If the shape is not supported (see isSupported()).
+     */
+    explicit convex_support_3D(const shape_3D& aShape);
+
+    /**
+     * Creates the support mapping of a triangle.
+     * \param aP0 The first corner of the triangle, in the global frame.
+     * \param aP1 The second corner of the triangle, in the global frame.
+     * \param aP2 The third corner of the triangle, in the global frame.
+     */
+    convex_support_3D(const vect<double,3>& aP0, const vect<double,3>& aP1, const vect<double,3>& aP2);
+
+    /**
+     * Returns the farthest point of the shape along a given (global) direction.
+     */
+    vect<double,3> getSupport(const vect<double,3>& aDir) const;
+
+    /**
+     * Returns the farthest point of the core of the shape along a given (global) direction.
+     */
+    vect<double,3> getCoreSupport(const vect<double,3>& aDir) const;
+
+    /**
+     * Returns the margin of the shape, i.e., the radius swept around its core.
+     */
+    double getMargin() const;
+
+};
+
+
+/**
+ * This function computes the proximity between two convex shapes, given by their support mappings.
+ * If the shapes are separated, the result is their distance and closest points (from GJK). If
+ * they intersect, the distance is the negative of the penetration depth and the points are the
+ * deepest points of each shape into the other (from EPA), as for the other proximity finders.
+ * \param aShape1 The support mapping of the first shape.
+ * \param aShape2 The support mapping of the second shape.
+ * \return The proximity record, with mPoint1 on the first shape and mPoint2 on the second shape.
+ */
+proximity_record_3D findProximityGJKEPA(const convex_support_3D& aShape1, const convex_support_3D& aShape2);
+
+/**
+ * This function computes the proximity between two convex shapes, given by their support mappings, 
+ * warm-started from the separation found by the previous call on the same pair of shapes. When the 
+ * shapes have barely moved, GJK then converges in one or two iterations.
+ * \param aShape1 The support mapping of the first shape.
+ * \param aShape2 The support mapping of the second shape.
+ * \param aSeparation As input, the separation returned by the last call (or zero if there is none). As output, 
+ *                    the closest point of the Minkowski difference (shape 1 minus shape 2) to the origin.
+ * \return The proximity record, with mPoint1 on the first shape and mPoint2 on the second shape.
+ */
+proximity_record_3D findProximityGJKEPA(const convex_support_3D& aShape1, const convex_support_3D& aShape2,
+                                        vect<double,3>& aSeparation);
+
+
+};
+
+};
+
+#endif
+
@@ -0,0 +1,149 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/prox_mesh_convex.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+namespace {
+
+double get_box_separation(const vect<double,3>& aLower1, const vect<double,3>& aUpper1,
+                          const vect<double,3>& aLower2, const vect<double,3>& aUpper2) {
+  double dist_sqr = 0.0;
+  for(std::size_t k = 0; k < 3; ++k) {
+    double gap = std::max(aLower1[k] - aUpper2[k], aLower2[k] - aUpper1[k]);
+    if(gap > 0.0)
+      dist_sqr += gap * gap;
+  };
+  if(dist_sqr == 0.0)
+    return -std::numeric_limits<double>::infinity();
+  return std::sqrt(dist_sqr);
+};
+
+};
+
+
+shared_ptr< shape_3D > prox_mesh_convex::getShape1() const {
+  return mMesh;
+};
+
+shared_ptr< shape_3D > prox_mesh_convex::getShape2() const {
+  return mShape;
+};
+    
+void prox_mesh_convex::computeProximity() {
+  if((!mMesh) || (!mShape)) {
+    mLastResult.mDistance = std::numeric_limits<double>::infinity();
+    mLastResult.mPoint1 = vect<double,3>(0.0,0.0,0.0);
+    mLastResult.mPoint2 = vect<double,3>(0.0,0.0,0.0);
+    return;
+  };
+  
+  mLastResult.mDistance = std::numeric_limits<double>::infinity();
+  mLastResult.mPoint1 = vect<double,3>(0.0,0.0,0.0);
+  mLastResult.mPoint2 = vect<double,3>(0.0,0.0,0.0);
+  
+  const std::vector< triangle_mesh::bvh_node >& tree = mMesh->getTree();
+  if(tree.empty())
+    return;
+  
+  pose_3D<double> ms_pose = mMesh->getPose().getGlobalPose();
+  vect<double,3> ms_axes[3] = { ms_pose.Quat * vect<double,3>(1.0,0.0,0.0),
+                                ms_pose.Quat * vect<double,3>(0.0,1.0,0.0),
+                                ms_pose.Quat * vect<double,3>(0.0,0.0,1.0) };
+  
+  // the exact box of the convex shape in the frame of the mesh, from its supports along the mesh axes.
+  convex_support_3D cvx(*mShape);
+  vect<double,3> cvx_lower, cvx_upper;
+  for(std::size_t k = 0; k < 3; ++k) {
+    cvx_upper[k] = ms_axes[k] * (cvx.getSupport(ms_axes[k]) - ms_pose.Position);
+    cvx_lower[k] = ms_axes[k] * (cvx.getSupport(-ms_axes[k]) - ms_pose.Position);
+  };
+  
+  mTraversalStack.clear();
+  mTraversalStack.push_back(0);
+  while(!mTraversalStack.empty()) {
+    const triangle_mesh::bvh_node& nd = tree[mTraversalStack.back()];
+    mTraversalStack.pop_back();
+    
+    if(nd.triangle != triangle_mesh::npos) {
+      vect<double,3> p[3];
+      for(std::size_t c = 0; c < 3; ++c) {
+        const vect<double,3>& v = mMesh->getTriangleVertex(nd.triangle, c);
+        p[c] = ms_pose.Position + v[0] * ms_axes[0] + v[1] * ms_axes[1] + v[2] * ms_axes[2];
+      };
+      proximity_record_3D tri_result = findProximityGJKEPA(convex_support_3D(p[0], p[1], p[2]), cvx);
+      if(tri_result.mDistance < mLastResult.mDistance)
+        mLastResult = tri_result;
+      continue;
+    };
+    
+    // push the farthest child first, such that the nearest child is visited first.
+    std::size_t c1 = &nd - &tree[0] + 1;
+    std::size_t c2 = nd.second_child;
+    double d1 = get_box_separation(tree[c1].lower, tree[c1].upper, cvx_lower, cvx_upper);
+    double d2 = get_box_separation(tree[c2].lower, tree[c2].upper, cvx_lower, cvx_upper);
+    if(d1 > d2) {
+      std::swap(c1, c2);
+      std::swap(d1, d2);
+    };
+    if(d2 < mLastResult.mDistance)
+      mTraversalStack.push_back(c2);
+    if(d1 < mLastResult.mDistance)
+      mTraversalStack.push_back(c1);
+  };
+};
+
+
+prox_mesh_convex::prox_mesh_convex(const shared_ptr< triangle_mesh >& aMesh,
+                                   const shared_ptr< shape_3D >& aShape) :
+                                   proximity_finder_3D(),
+                                   mMesh(aMesh),
+                                   mShape(aShape),
+                                   mTraversalStack() { };
+    
+    
+void RK_CALL prox_mesh_convex::save(ReaK::serialization::oarchive& A, unsigned int) const {
+  proximity_finder_3D::save(A,proximity_finder_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_SAVE_WITH_NAME(mMesh)
+    & RK_SERIAL_SAVE_WITH_NAME(mShape);
+};
+    
+void RK_CALL prox_mesh_convex::load(ReaK::serialization::iarchive& A, unsigned int) {
+  proximity_finder_3D::load(A,proximity_finder_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_LOAD_WITH_NAME(mMesh)
+    & RK_SERIAL_LOAD_WITH_NAME(mShape);
+};
+
+
+};
+
+};
+
@@ -0,0 +1,104 @@
+/**
+ * \file prox_mesh_convex.hpp
+ *
+ * This library declares a class for proximity queries between a triangle mesh and a convex shape.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROX_MESH_CONVEX_HPP
+#define REAK_PROX_MESH_CONVEX_HPP
+
+#include "proximity_finder_3D.hpp"
+
+#include "prox_gjk_epa.hpp"
+
+#include <ReaK/geometry/shapes/triangle_mesh.hpp>
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class is for proximity queries between a triangle mesh and a convex shape (see convex_support_3D). 
+ * The bounding-box hierarchy of the mesh is traversed (nearest boxes first) against the box of the 
+ * convex shape in the frame of the mesh, and GJK / EPA is run between the convex shape and each triangle 
+ * that could be closer than the best result so far.
+ */
+class prox_mesh_convex : public proximity_finder_3D {
+  protected:
+    
+    shared_ptr< triangle_mesh > mMesh;
+    shared_ptr< shape_3D > mShape;
+    
+    std::vector< std::size_t > mTraversalStack;
+    
+  public:
+    
+    /** Returns the first shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape1() const;
+    /** Returns the second shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape2() const;
+    
+    /** This function performs the proximity query on its associated shapes. */
+    virtual void computeProximity();
+    
+    /** 
+     * Default constructor. 
+     * \param aMesh The triangle mesh involved in the proximity query.
+     * \param aShape The convex shape involved in the proximity query.
+     */
+    prox_mesh_convex(const shared_ptr< triangle_mesh >& aMesh = shared_ptr< triangle_mesh >(),
+                     const shared_ptr< shape_3D >& aShape = shared_ptr< shape_3D >());
+    
+    /** Destructor. */
+    virtual ~prox_mesh_convex() { };
+    
+    
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+    
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+    
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+    
+    RK_RTTI_MAKE_CONCRETE_1BASE(prox_mesh_convex,0xC320001F,1,"prox_mesh_convex",proximity_finder_3D)
+    
+};
+
+
+};
+
+};
+
+#endif
+
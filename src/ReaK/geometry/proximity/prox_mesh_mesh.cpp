@@ -0,0 +1,178 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/prox_mesh_mesh.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+namespace {
+
+double get_box_separation(const vect<double,3>& aLower1, const vect<double,3>& aUpper1,
+                          const vect<double,3>& aLower2, const vect<double,3>& aUpper2) {
+  double dist_sqr = 0.0;
+  for(std::size_t k = 0; k < 3; ++k) {
+    double gap = std::max(aLower1[k] - aUpper2[k], aLower2[k] - aUpper1[k]);
+    if(gap > 0.0)
+      dist_sqr += gap * gap;
+  };
+  if(dist_sqr == 0.0)
+    return -std::numeric_limits<double>::infinity();
+  return std::sqrt(dist_sqr);
+};
+
+};
+
+
+shared_ptr< shape_3D > prox_mesh_mesh::getShape1() const {
+  return mMesh1;
+};
+
+shared_ptr< shape_3D > prox_mesh_mesh::getShape2() const {
+  return mMesh2;
+};
+    
+void prox_mesh_mesh::computeProximity() {
+  if((!mMesh1) || (!mMesh2)) {
+    mLastResult.mDistance = std::numeric_limits<double>::infinity();
+    mLastResult.mPoint1 = vect<double,3>(0.0,0.0,0.0);
+    mLastResult.mPoint2 = vect<double,3>(0.0,0.0,0.0);
+    return;
+  };
+  
+  mLastResult.mDistance = std::numeric_limits<double>::infinity();
+  mLastResult.mPoint1 = vect<double,3>(0.0,0.0,0.0);
+  mLastResult.mPoint2 = vect<double,3>(0.0,0.0,0.0);
+  
+  const std::vector< triangle_mesh::bvh_node >& tree1 = mMesh1->getTree();
+  const std::vector< triangle_mesh::bvh_node >& tree2 = mMesh2->getTree();
+  if(tree1.empty() || tree2.empty())
+    return;
+  
+  pose_3D<double> ms1_pose = mMesh1->getPose().getGlobalPose();
+  pose_3D<double> ms2_pose = mMesh2->getPose().getGlobalPose();
+  vect<double,3> ms1_axes[3] = { ms1_pose.Quat * vect<double,3>(1.0,0.0,0.0),
+                                 ms1_pose.Quat * vect<double,3>(0.0,1.0,0.0),
+                                 ms1_pose.Quat * vect<double,3>(0.0,0.0,1.0) };
+  vect<double,3> ms2_axes[3] = { ms2_pose.Quat * vect<double,3>(1.0,0.0,0.0),
+                                 ms2_pose.Quat * vect<double,3>(0.0,1.0,0.0),
+                                 ms2_pose.Quat * vect<double,3>(0.0,0.0,1.0) };
+  
+  // the transform of the second mesh relative to the first, to bound the boxes of the second mesh in the frame of the first.
+  double R12[3][3];
+  double abs_R12[3][3];
+  vect<double,3> p12;
+  for(std::size_t k = 0; k < 3; ++k) {
+    for(std::size_t l = 0; l < 3; ++l) {
+      R12[k][l] = ms1_axes[k] * ms2_axes[l];
+      abs_R12[k][l] = std::fabs(R12[k][l]);
+    };
+    p12[k] = ms1_axes[k] * (ms2_pose.Position - ms1_pose.Position);
+  };
+  
+  mTraversalStack.clear();
+  mTraversalStack.push_back(std::make_pair(std::size_t(0), std::size_t(0)));
+  while(!mTraversalStack.empty()) {
+    std::size_t i1 = mTraversalStack.back().first;
+    std::size_t i2 = mTraversalStack.back().second;
+    mTraversalStack.pop_back();
+    const triangle_mesh::bvh_node& nd1 = tree1[i1];
+    const triangle_mesh::bvh_node& nd2 = tree2[i2];
+    
+    vect<double,3> lower2, upper2;
+    for(std::size_t k = 0; k < 3; ++k) {
+      double c = p12[k];
+      double h = 0.0;
+      for(std::size_t l = 0; l < 3; ++l) {
+        c += R12[k][l] * 0.5 * (nd2.lower[l] + nd2.upper[l]);
+        h += abs_R12[k][l] * 0.5 * (nd2.upper[l] - nd2.lower[l]);
+      };
+      lower2[k] = c - h;
+      upper2[k] = c + h;
+    };
+    if(get_box_separation(nd1.lower, nd1.upper, lower2, upper2) >= mLastResult.mDistance)
+      continue;
+    
+    bool leaf1 = (nd1.triangle != triangle_mesh::npos);
+    bool leaf2 = (nd2.triangle != triangle_mesh::npos);
+    if(leaf1 && leaf2) {
+      vect<double,3> p1[3];
+      vect<double,3> p2[3];
+      for(std::size_t c = 0; c < 3; ++c) {
+        const vect<double,3>& v1 = mMesh1->getTriangleVertex(nd1.triangle, c);
+        p1[c] = ms1_pose.Position + v1[0] * ms1_axes[0] + v1[1] * ms1_axes[1] + v1[2] * ms1_axes[2];
+        const vect<double,3>& v2 = mMesh2->getTriangleVertex(nd2.triangle, c);
+        p2[c] = ms2_pose.Position + v2[0] * ms2_axes[0] + v2[1] * ms2_axes[1] + v2[2] * ms2_axes[2];
+      };
+      proximity_record_3D tri_result = findProximityGJKEPA(convex_support_3D(p1[0], p1[1], p1[2]),
+                                                           convex_support_3D(p2[0], p2[1], p2[2]));
+      if(tri_result.mDistance < mLastResult.mDistance)
+        mLastResult = tri_result;
+      continue;
+    };
+    
+    // descend into the larger box (or the only one that is not a leaf).
+    double span1 = (nd1.upper[0] - nd1.lower[0]) + (nd1.upper[1] - nd1.lower[1]) + (nd1.upper[2] - nd1.lower[2]);
+    double span2 = (upper2[0] - lower2[0]) + (upper2[1] - lower2[1]) + (upper2[2] - lower2[2]);
+    if(leaf2 || (!leaf1 && (span1 >= span2))) {
+      mTraversalStack.push_back(std::make_pair(nd1.second_child, i2));
+      mTraversalStack.push_back(std::make_pair(i1 + 1, i2));
+    } else {
+      mTraversalStack.push_back(std::make_pair(i1, nd2.second_child));
+      mTraversalStack.push_back(std::make_pair(i1, i2 + 1));
+    };
+  };
+};
+
+
+prox_mesh_mesh::prox_mesh_mesh(const shared_ptr< triangle_mesh >& aMesh1,
+                               const shared_ptr< triangle_mesh >& aMesh2) :
+                               proximity_finder_3D(),
+                               mMesh1(aMesh1),
+                               mMesh2(aMesh2),
+                               mTraversalStack() { };
+    
+    
+void RK_CALL prox_mesh_mesh::save(ReaK::serialization::oarchive& A, unsigned int) const {
+  proximity_finder_3D::save(A,proximity_finder_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_SAVE_WITH_NAME(mMesh1)
+    & RK_SERIAL_SAVE_WITH_NAME(mMesh2);
+};
+    
+void RK_CALL prox_mesh_mesh::load(ReaK::serialization::iarchive& A, unsigned int) {
+  proximity_finder_3D::load(A,proximity_finder_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_LOAD_WITH_NAME(mMesh1)
+    & RK_SERIAL_LOAD_WITH_NAME(mMesh2);
+};
+
+
+};
+
+};
+
@@ -0,0 +1,105 @@
+/**
+ * \file prox_mesh_mesh.hpp
+ *
+ * This library declares a class for proximity queries between two triangle meshes.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROX_MESH_MESH_HPP
+#define REAK_PROX_MESH_MESH_HPP
+
+#include "proximity_finder_3D.hpp"
+
+#include "prox_gjk_epa.hpp"
+
+#include <ReaK/geometry/shapes/triangle_mesh.hpp>
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class is for proximity queries between two triangle meshes. The bounding-box hierarchies of 
+ * both meshes are traversed together (the boxes of the second mesh being bounded in the frame of 
+ * the first mesh), and GJK / EPA is run between the pairs of triangles that could be closer than 
+ * the best result so far. The meshes are treated as surfaces, such that the penetration depth 
+ * between crossing triangles is only a measure of how much they cross.
+ */
+class prox_mesh_mesh : public proximity_finder_3D {
+  protected:
+    
+    shared_ptr< triangle_mesh > mMesh1;
+    shared_ptr< triangle_mesh > mMesh2;
+    
+    std::vector< std::pair< std::size_t, std::size_t > > mTraversalStack;
+    
+  public:
+    
+    /** Returns the first shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape1() const;
+    /** Returns the second shape involved in the proximity query. */
+    virtual shared_ptr< shape_3D > getShape2() const;
+    
+    /** This function performs the proximity query on its associated shapes. */
+    virtual void computeProximity();
+    
+    /** 
+     * Default constructor. 
+     * \param aMesh1 The first triangle mesh involved in the proximity query.
+     * \param aMesh2 The second triangle mesh involved in the proximity query.
+     */
+    prox_mesh_mesh(const shared_ptr< triangle_mesh >& aMesh1 = shared_ptr< triangle_mesh >(),
+                   const shared_ptr< triangle_mesh >& aMesh2 = shared_ptr< triangle_mesh >());
+    
+    /** Destructor. */
+    virtual ~prox_mesh_mesh() { };
+    
+    
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+    
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+    
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+    
+    RK_RTTI_MAKE_CONCRETE_1BASE(prox_mesh_mesh,0xC3200020,1,"prox_mesh_mesh",proximity_finder_3D)
+    
+};
+
+
+};
+
+};
+
+#endif
+
@@ -51,8 +51,8 @@ void prox_plane_box::computeProximity() {
   
   vect<double,3> bx_c = mBox->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
   vect<double,3> bx_x = mPlane->getPose().rotateFromGlobal(mBox->getPose().rotateToGlobal(vect<double,3>(1.0,0.0,0.0)));
-  vect<double,3> bx_y = mPlane->getPose().rotateFromGlobal(mBox->getPose().rotateToGlobal(vect<double,3>(1.0,0.0,0.0)));
-  vect<double,3> bx_z = mPlane->getPose().rotateFromGlobal(mBox->getPose().rotateToGlobal(vect<double,3>(1.0,0.0,0.0)));
+  vect<double,3> bx_y = mPlane->getPose().rotateFromGlobal(mBox->getPose().rotateToGlobal(vect<double,3>(0.0,1.0,0.0)));
+  vect<double,3> bx_z = mPlane->getPose().rotateFromGlobal(mBox->getPose().rotateToGlobal(vect<double,3>(0.0,0.0,1.0)));
   vect<double,3> pl_c = mPlane->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
   
   if(bx_x[2] > 0.0)
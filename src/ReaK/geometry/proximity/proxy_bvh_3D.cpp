@@ -0,0 +1,253 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_bvh_3D.hpp>
+
+#include <ReaK/geometry/shapes/plane.hpp>
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/cylinder.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+#include <ReaK/geometry/shapes/triangle_mesh.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace ReaK {
+
+namespace geom {
+
+
+aabb_3D::aabb_3D() : lower(std::numeric_limits<double>::infinity(),
+                           std::numeric_limits<double>::infinity(),
+                           std::numeric_limits<double>::infinity()),
+                     upper(-std::numeric_limits<double>::infinity(),
+                           -std::numeric_limits<double>::infinity(),
+                           -std::numeric_limits<double>::infinity()) { };
+
+aabb_3D aabb_3D::infinite() {
+  return aabb_3D(vect<double,3>(-std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity()),
+                 vect<double,3>(std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::infinity(),
+                                std::numeric_limits<double>::infinity()));
+};
+
+void aabb_3D::merge(const aabb_3D& rhs) {
+  for(std::size_t k = 0; k < 3; ++k) {
+    if(rhs.lower[k] < lower[k])
+      lower[k] = rhs.lower[k];
+    if(rhs.upper[k] > upper[k])
+      upper[k] = rhs.upper[k];
+  };
+};
+
+double aabb_3D::getSpan() const {
+  return (upper[0] - lower[0]) + (upper[1] - lower[1]) + (upper[2] - lower[2]);
+};
+
+
+double getAABBSeparation(const aabb_3D& aBox1, const aabb_3D& aBox2) {
+  double dist_sqr = 0.0;
+  for(std::size_t k = 0; k < 3; ++k) {
+    double gap = std::max(aBox1.lower[k] - aBox2.upper[k], aBox2.lower[k] - aBox1.upper[k]);
+    if(gap > 0.0)
+      dist_sqr += gap * gap;
+  };
+  if(dist_sqr == 0.0)
+    return -std::numeric_limits<double>::infinity();
+  return std::sqrt(dist_sqr);
+};
+
+
+aabb_3D computeShapeAABB(const shape_3D& aShape) {
+  if(aShape.getObjectType() == plane::getStaticObjectType())
+    return aabb_3D::infinite();
+  return computeShapeAABB(aShape, aShape.getPose().getGlobalPose());
+};
+
+aabb_3D computeShapeAABB(const shape_3D& aShape, const pose_3D<double>& aGlobalPose) {
+  if(aShape.getObjectType() == plane::getStaticObjectType())
+    return aabb_3D::infinite();
+
+  vect<double,3> half_ext;
+
+  if(aShape.getObjectType() == box::getStaticObjectType()) {
+    const box& bx = static_cast<const box&>(aShape);
+    vect<double,3> ax = aGlobalPose.Quat * vect<double,3>(0.5 * bx.getDimensions()[0], 0.0, 0.0);
+    vect<double,3> ay = aGlobalPose.Quat * vect<double,3>(0.0, 0.5 * bx.getDimensions()[1], 0.0);
+    vect<double,3> az = aGlobalPose.Quat * vect<double,3>(0.0, 0.0, 0.5 * bx.getDimensions()[2]);
+    for(std::size_t k = 0; k < 3; ++k)
+      half_ext[k] = std::fabs(ax[k]) + std::fabs(ay[k]) + std::fabs(az[k]);
+  } else if(aShape.getObjectType() == sphere::getStaticObjectType()) {
+    double r = static_cast<const sphere&>(aShape).getRadius();
+    half_ext = vect<double,3>(r, r, r);
+  } else if(aShape.getObjectType() == cylinder::getStaticObjectType()) {
+    // the disk caps only extend by the radius times the sine of the axis' angle to each global axis.
+    const cylinder& cy = static_cast<const cylinder&>(aShape);
+    vect<double,3> az = aGlobalPose.Quat * vect<double,3>(0.0, 0.0, 1.0);
+    for(std::size_t k = 0; k < 3; ++k)
+      half_ext[k] = 0.5 * cy.getLength() * std::fabs(az[k])
+                  + cy.getRadius() * std::sqrt(std::max(0.0, 1.0 - az[k] * az[k]));
+  } else if(aShape.getObjectType() == capped_cylinder::getStaticObjectType()) {
+    const capped_cylinder& cc = static_cast<const capped_cylinder&>(aShape);
+    vect<double,3> az = aGlobalPose.Quat * vect<double,3>(0.0, 0.0, 1.0);
+    for(std::size_t k = 0; k < 3; ++k)
+      half_ext[k] = 0.5 * cc.getLength() * std::fabs(az[k]) + cc.getRadius();
+  } else if(aShape.getObjectType() == convex_polytope::getStaticObjectType()) {
+    const std::vector< vect<double,3> >& verts = static_cast<const convex_polytope&>(aShape).getVertices();
+    if(verts.empty())
+      return aabb_3D(aGlobalPose.Position, aGlobalPose.Position);
+    aabb_3D result;
+    for(std::size_t i = 0; i < verts.size(); ++i) {
+      vect<double,3> v = aGlobalPose.Position + aGlobalPose.Quat * verts[i];
+      result.merge(aabb_3D(v, v));
+    };
+    return result;
+  } else if(aShape.getObjectType() == triangle_mesh::getStaticObjectType()) {
+    // the box around the rotated root box of the mesh' own hierarchy.
+    const std::vector< triangle_mesh::bvh_node >& tree = static_cast<const triangle_mesh&>(aShape).getTree();
+    if(tree.empty())
+      return aabb_3D(aGlobalPose.Position, aGlobalPose.Position);
+    vect<double,3> ax = aGlobalPose.Quat * vect<double,3>(0.5 * (tree[0].upper[0] - tree[0].lower[0]), 0.0, 0.0);
+    vect<double,3> ay = aGlobalPose.Quat * vect<double,3>(0.0, 0.5 * (tree[0].upper[1] - tree[0].lower[1]), 0.0);
+    vect<double,3> az = aGlobalPose.Quat * vect<double,3>(0.0, 0.0, 0.5 * (tree[0].upper[2] - tree[0].lower[2]));
+    for(std::size_t k = 0; k < 3; ++k)
+      half_ext[k] = std::fabs(ax[k]) + std::fabs(ay[k]) + std::fabs(az[k]);
+    vect<double,3> c = aGlobalPose.Position + aGlobalPose.Quat * (0.5 * (tree[0].lower + tree[0].upper));
+    return aabb_3D(c - half_ext, c + half_ext);
+  } else {
+    double r = aShape.getBoundingRadius();
+    half_ext = vect<double,3>(r, r, r);
+  };
+
+  return aabb_3D(aGlobalPose.Position - half_ext, aGlobalPose.Position + half_ext);
+};
+
+
+const std::size_t proxy_bvh_3D::npos;
+
+
+namespace {
+
+struct bvh_leaf_axis_less {
+  std::size_t axis;
+  explicit bvh_leaf_axis_less(std::size_t aAxis) : axis(aAxis) { };
+  bool operator()(const std::pair< vect<double,3>, std::size_t >& lhs,
+                  const std::pair< vect<double,3>, std::size_t >& rhs) const {
+    return lhs.first[axis] < rhs.first[axis];
+  };
+};
+
+};
+
+
+std::size_t proxy_bvh_3D::buildImpl(std::vector< std::pair< vect<double,3>, std::size_t > >& aLeaves, std::size_t aFirst, std::size_t aLast) {
+  std::size_t cur = mNodes.size();
+  mNodes.push_back(node());
+  mNodes[cur].second_child = npos;
+  mNodes[cur].shape = npos;
+
+  if(aLast - aFirst == 1) {
+    std::size_t i = aLeaves[aFirst].second;
+    pose_3D<double> gbl_pose = mShapes[i]->getPose().getGlobalPose();
+    mNodes[cur].shape = i;
+    mShapeNodes[i] = cur;
+    mNodes[cur].box = computeShapeAABB(*mShapes[i], gbl_pose);
+    mFrames[i].position = gbl_pose.Position;
+    mFrames[i].quat = gbl_pose.Quat;
+    return cur;
+  };
+
+  // split at the median of the centers, along the axis on which the centers are most spread out.
+  vect<double,3> c_lo = aLeaves[aFirst].first;
+  vect<double,3> c_hi = aLeaves[aFirst].first;
+  for(std::size_t i = aFirst + 1; i < aLast; ++i) {
+    for(std::size_t k = 0; k < 3; ++k) {
+      c_lo[k] = std::min(c_lo[k], aLeaves[i].first[k]);
+      c_hi[k] = std::max(c_hi[k], aLeaves[i].first[k]);
+    };
+  };
+  std::size_t axis = 0;
+  for(std::size_t k = 1; k < 3; ++k)
+    if(c_hi[k] - c_lo[k] > c_hi[axis] - c_lo[axis])
+      axis = k;
+
+  std::size_t mid = aFirst + (aLast - aFirst) / 2;
+  std::nth_element(aLeaves.begin() + aFirst, aLeaves.begin() + mid, aLeaves.begin() + aLast, bvh_leaf_axis_less(axis));
+
+  buildImpl(aLeaves, aFirst, mid);
+  std::size_t second = buildImpl(aLeaves, mid, aLast);
+  mNodes[cur].second_child = second;
+  mNodes[cur].box = mNodes[cur + 1].box;
+  mNodes[cur].box.merge(mNodes[second].box);
+  return cur;
+};
+
+void proxy_bvh_3D::build(const std::vector< shared_ptr< shape_3D > >& aShapes) {
+  mShapes = aShapes;
+  mNodes.clear();
+  mFrames.clear();
+  mFrames.resize(mShapes.size());
+  mShapeNodes.clear();
+  mShapeNodes.resize(mShapes.size(), npos);
+
+  std::vector< std::pair< vect<double,3>, std::size_t > > leaves;
+  leaves.reserve(mShapes.size());
+  for(std::size_t i = 0; i < mShapes.size(); ++i) {
+    if(!mShapes[i])
+      continue;
+    // unbounded shapes (planes) are placed by their origin, their boxes cover everything anyways.
+    leaves.push_back(std::make_pair(mShapes[i]->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0)), i));
+  };
+  if(leaves.empty())
+    return;
+
+  mNodes.reserve(2 * leaves.size() - 1);
+  buildImpl(leaves, 0, leaves.size());
+};
+
+void proxy_bvh_3D::refit() {
+  // nodes are in pre-order, so going backwards visits all children before their parents.
+  for(std::size_t i = mNodes.size(); i-- > 0; ) {
+    node& nd = mNodes[i];
+    if(nd.isLeaf()) {
+      pose_3D<double> gbl_pose = mShapes[nd.shape]->getPose().getGlobalPose();
+      nd.box = computeShapeAABB(*mShapes[nd.shape], gbl_pose);
+      mFrames[nd.shape].position = gbl_pose.Position;
+      mFrames[nd.shape].quat = gbl_pose.Quat;
+    } else {
+      nd.box = mNodes[i + 1].box;
+      nd.box.merge(mNodes[nd.second_child].box);
+    };
+  };
+};
+
+
+};
+
+};
+
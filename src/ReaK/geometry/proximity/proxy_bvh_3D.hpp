@@ -0,0 +1,204 @@
+/**
+ * \file proxy_bvh_3D.hpp
+ *
+ * This library declares an axis-aligned bounding-box hierarchy over a list of 3D shapes. It is
+ * used as the broad-phase of the proximity-query pairs, such that only the pairs of shapes whose
+ * bounding boxes are close enough are passed on to the narrow-phase proximity finders.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROXY_BVH_3D_HPP
+#define REAK_PROXY_BVH_3D_HPP
+
+#include <ReaK/geometry/shapes/shape_3D.hpp>
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/** This class represents an axis-aligned bounding box in the global frame. */
+struct aabb_3D {
+  vect<double,3> lower;
+  vect<double,3> upper;
+
+  /**
+   * Default constructor, creates an empty box (which is the identity for the merge operation).
+   */
+  aabb_3D();
+
+  aabb_3D(const vect<double,3>& aLower, const vect<double,3>& aUpper) : lower(aLower), upper(aUpper) { };
+
+  /**
+   * Creates a box that covers the entire space.
+   */
+  static aabb_3D infinite();
+
+  /**
+   * Grows this box such that it also covers the given box.
+   */
+  void merge(const aabb_3D& rhs);
+
+  /**
+   * Returns the sum of the side-lengths of the box, used to decide which box to descend into.
+   */
+  double getSpan() const;
+};
+
+/**
+ * This function computes a lower-bound on the distance between any two shapes that are contained
+ * in the given boxes. If the boxes overlap, no useful lower-bound exists (penetration depth can be
+ * anything), and negative infinity is returned.
+ * \param aBox1 The first box.
+ * \param aBox2 The second box.
+ * \return A lower-bound on the distance between the contents of both boxes.
+ */
+double getAABBSeparation(const aabb_3D& aBox1, const aabb_3D& aBox2);
+
+/**
+ * This function computes the global axis-aligned bounding box of a shape, at its current pose.
+ * Boxes, spheres, cylinders, capped-cylinders and convex polytopes get a tight box, triangle meshes
+ * get the box around their rotated root box, planes are treated as half-spaces (as in the plane
+ * proximity finders) and get an unbounded box, and any other shape gets the box around its bounding sphere.
+ * \param aShape The shape to bound.
+ * \return The global bounding box of the shape.
+ */
+aabb_3D computeShapeAABB(const shape_3D& aShape);
+
+/**
+ * This function computes the global axis-aligned bounding box of a shape, at a given global pose.
+ * \param aShape The shape to bound.
+ * \param aGlobalPose The global pose of the shape (as obtained from aShape.getPose().getGlobalPose()).
+ * \return The global bounding box of the shape.
+ */
+aabb_3D computeShapeAABB(const shape_3D& aShape, const pose_3D<double>& aGlobalPose);
+
+
+/**
+ * This class is a bounding-volume hierarchy of axis-aligned boxes over a list of shapes. The
+ * hierarchy is built once (top-down, median-split along the longest axis), and then refitted
+ * (bottom-up) to the current poses of the shapes before each query. Refitting keeps the boxes
+ * valid no matter how the shapes move, although the quality of the hierarchy can degrade if the
+ * shapes move far from their configuration at build time (which is rare for rigid or articulated models).
+ * The nodes are stored in a flat array in pre-order, such that the first child of a node immediately
+ * follows it.
+ */
+class proxy_bvh_3D {
+  public:
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct node {
+      aabb_3D box;
+      std::size_t second_child;  ///< Index of the second child (the first is the next node), or npos for a leaf.
+      std::size_t shape;         ///< Index of the shape in the shape list, or npos for a branch.
+
+      bool isLeaf() const { return shape != npos; };
+    };
+
+    /** This POD type holds the global pose of a shape, as recorded at the last build or refit. */
+    struct shape_frame {
+      vect<double,3> position;
+      quaternion<double> quat;
+    };
+
+  private:
+
+    std::vector< shared_ptr< shape_3D > > mShapes;
+    std::vector< node > mNodes;
+    std::vector< shape_frame > mFrames;
+    std::vector< std::size_t > mShapeNodes;
+
+    std::size_t buildImpl(std::vector< std::pair< vect<double,3>, std::size_t > >& aLeaves, std::size_t aFirst, std::size_t aLast);
+
+  public:
+
+    /**
+     * Default constructor, creates an empty hierarchy.
+     */
+    proxy_bvh_3D() : mShapes(), mNodes(), mFrames(), mShapeNodes() { };
+
+    /**
+     * Builds the hierarchy over the given list of shapes, null shapes are skipped.
+     * \param aShapes The list of shapes, the leaf indices refer to positions in this list.
+     */
+    void build(const std::vector< shared_ptr< shape_3D > >& aShapes);
+
+    /**
+     * Recomputes all the boxes of the hierarchy from the current poses of the shapes, and records
+     * those global poses (see getShapeFrame()).
+     */
+    void refit();
+
+    /**
+     * Removes all the shapes and nodes from the hierarchy.
+     */
+    void clear() { mShapes.clear(); mNodes.clear(); mFrames.clear(); mShapeNodes.clear(); };
+
+    /**
+     * Checks if the hierarchy has no nodes.
+     */
+    bool empty() const { return mNodes.empty(); };
+
+    /**
+     * Returns the size of the shape list given at build time (including the null shapes).
+     */
+    std::size_t getShapeCount() const { return mShapes.size(); };
+
+    /**
+     * Returns the node at a given index (the root node is at index 0).
+     */
+    const node& getNode(std::size_t i) const { return mNodes[i]; };
+
+    /**
+     * Returns the number of nodes in the hierarchy.
+     */
+    std::size_t getNodeCount() const { return mNodes.size(); };
+
+    /**
+     * Returns the global pose of a shape (by its index in the shape list), as of the last build or refit.
+     */
+    const shape_frame& getShapeFrame(std::size_t i) const { return mFrames[i]; };
+
+    /**
+     * Returns the index of the leaf node of a shape (by its index in the shape list), or npos for a null shape.
+     */
+    std::size_t getShapeNode(std::size_t i) const { return mShapeNodes[i]; };
+
+};
+
+
+};
+
+};
+
+#endif
+
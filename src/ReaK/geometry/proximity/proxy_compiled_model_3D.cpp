@@ -0,0 +1,479 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_compiled_model_3D.hpp>
+
+#include <ReaK/geometry/shapes/plane.hpp>
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/cylinder.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace ReaK {
+
+namespace geom {
+
+
+proxy_rigid_transform_3D proxy_rigid_transform_3D::identity() {
+  proxy_rigid_transform_3D result;
+  for(std::size_t i = 0; i < 9; ++i)
+    result.R[i] = 0.0;
+  result.R[0] = 1.0; result.R[4] = 1.0; result.R[8] = 1.0;
+  result.p[0] = 0.0; result.p[1] = 0.0; result.p[2] = 0.0;
+  return result;
+};
+
+proxy_rigid_transform_3D proxy_rigid_transform_3D::fromPose(const pose_3D<double>& aPose) {
+  proxy_rigid_transform_3D result;
+  rot_mat_3D<double> R = aPose.Quat.getRotMat();
+  for(std::size_t i = 0; i < 9; ++i)
+    result.R[i] = R[i];
+  result.p[0] = aPose.Position[0];
+  result.p[1] = aPose.Position[1];
+  result.p[2] = aPose.Position[2];
+  return result;
+};
+
+proxy_rigid_transform_3D compose(const proxy_rigid_transform_3D& aParent, const proxy_rigid_transform_3D& aChild) {
+  proxy_rigid_transform_3D result;
+  for(std::size_t j = 0; j < 3; ++j)
+    for(std::size_t i = 0; i < 3; ++i)
+      result.R[3 * j + i] = aParent.R[i] * aChild.R[3 * j] + aParent.R[3 + i] * aChild.R[3 * j + 1] + aParent.R[6 + i] * aChild.R[3 * j + 2];
+  for(std::size_t i = 0; i < 3; ++i)
+    result.p[i] = aParent.R[i] * aChild.p[0] + aParent.R[3 + i] * aChild.p[1] + aParent.R[6 + i] * aChild.p[2] + aParent.p[i];
+  return result;
+};
+
+
+const std::size_t proxy_compiled_model_3D::npos;
+
+
+void proxy_compiled_model_3D::compile(const proxy_query_model_3D& aModel) {
+  mPrimitives.clear();
+  mLinks.clear();
+
+  for(std::size_t i = 0; i < aModel.mShapeList.size(); ++i) {
+    const shared_ptr< shape_3D >& shp = aModel.mShapeList[i];
+    if(!shp)
+      continue;
+
+    primitive prim;
+    prim.shape = i;
+    prim.dims[0] = 0.0; prim.dims[1] = 0.0; prim.dims[2] = 0.0;
+    prim.bound = 0.0;
+    if(shp->getObjectType() == plane::getStaticObjectType()) {
+      prim.kind = plane_kind;
+      prim.dims[0] = static_cast<const plane&>(*shp).getDimensions()[0];
+      prim.dims[1] = static_cast<const plane&>(*shp).getDimensions()[1];
+      prim.bound = std::numeric_limits<double>::infinity();
+    } else if(shp->getObjectType() == sphere::getStaticObjectType()) {
+      prim.kind = sphere_kind;
+      prim.dims[0] = static_cast<const sphere&>(*shp).getRadius();
+      prim.bound = prim.dims[0];
+    } else if(shp->getObjectType() == capped_cylinder::getStaticObjectType()) {
+      prim.kind = ccylinder_kind;
+      prim.dims[0] = static_cast<const capped_cylinder&>(*shp).getLength();
+      prim.dims[1] = static_cast<const capped_cylinder&>(*shp).getRadius();
+      prim.bound = 0.5 * prim.dims[0] + prim.dims[1];
+    } else if(shp->getObjectType() == cylinder::getStaticObjectType()) {
+      prim.kind = cylinder_kind;
+      prim.dims[0] = static_cast<const cylinder&>(*shp).getLength();
+      prim.dims[1] = static_cast<const cylinder&>(*shp).getRadius();
+      prim.bound = std::sqrt(0.25 * prim.dims[0] * prim.dims[0] + prim.dims[1] * prim.dims[1]);
+    } else if(shp->getObjectType() == box::getStaticObjectType()) {
+      prim.kind = box_kind;
+      prim.dims[0] = static_cast<const box&>(*shp).getDimensions()[0];
+      prim.dims[1] = static_cast<const box&>(*shp).getDimensions()[1];
+      prim.dims[2] = static_cast<const box&>(*shp).getDimensions()[2];
+      prim.bound = 0.5 * std::sqrt(prim.dims[0] * prim.dims[0] + prim.dims[1] * prim.dims[1] + prim.dims[2] * prim.dims[2]);
+    } else
+      continue;
+
+    prim.local = proxy_rigid_transform_3D::fromPose(shp->getPose());
+    prim.link = npos;
+    shared_ptr< pose_3D<double> > parent = shp->getPose().Parent.lock();
+    if(parent) {
+      std::vector< shared_ptr< pose_3D<double> > >::iterator it = std::find(mLinks.begin(), mLinks.end(), parent);
+      prim.link = it - mLinks.begin();
+      if(it == mLinks.end())
+        mLinks.push_back(parent);
+    };
+    mPrimitives.push_back(prim);
+  };
+
+  mLinkTransforms.assign(mLinks.size(), proxy_rigid_transform_3D::identity());
+  mWorldTransforms.resize(mPrimitives.size());
+  updateFromPoses();
+};
+
+void proxy_compiled_model_3D::updateFromPoses() {
+  for(std::size_t i = 0; i < mLinks.size(); ++i)
+    mLinkTransforms[i] = proxy_rigid_transform_3D::fromPose(mLinks[i]->getGlobalPose());
+  setLinkTransforms(mLinkTransforms.empty() ? NULL : &mLinkTransforms[0]);
+};
+
+void proxy_compiled_model_3D::setLinkTransforms(const proxy_rigid_transform_3D* aLinkTransforms) {
+  for(std::size_t i = 0; i < mPrimitives.size(); ++i) {
+    if(mPrimitives[i].link == npos)
+      mWorldTransforms[i] = mPrimitives[i].local;
+    else
+      mWorldTransforms[i] = compose(aLinkTransforms[mPrimitives[i].link], mPrimitives[i].local);
+  };
+};
+
+
+
+namespace {
+
+/*
+ * Overlap tests between primitives, in world coordinates. The first primitive is always the one of lower kind.
+ * The columns of the rotation matrices are the local axes of the primitives, and planes are half-spaces
+ * below their local z = 0 surface.
+ */
+
+inline double dot3(const double* a, const double* b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+};
+
+inline double plane_height(const proxy_rigid_transform_3D& pl, const double* pt) {
+  double d[3] = {pt[0] - pl.p[0], pt[1] - pl.p[1], pt[2] - pl.p[2]};
+  return dot3(pl.R + 6, d);
+};
+
+// point expressed in the local frame of a transform.
+inline void to_local(const proxy_rigid_transform_3D& T, const double* pt, double* result) {
+  double d[3] = {pt[0] - T.p[0], pt[1] - T.p[1], pt[2] - T.p[2]};
+  result[0] = dot3(T.R, d);
+  result[1] = dot3(T.R + 3, d);
+  result[2] = dot3(T.R + 6, d);
+};
+
+// signed distance from a local point to a box of half-extents h.
+inline double box_signed_distance(const double* h, const double* q) {
+  double outside_sqr = 0.0;
+  double inside_max = -std::numeric_limits<double>::infinity();
+  for(std::size_t k = 0; k < 3; ++k) {
+    double d = std::fabs(q[k]) - h[k];
+    if(d > 0.0)
+      outside_sqr += d * d;
+    inside_max = std::max(inside_max, d);
+  };
+  if(outside_sqr > 0.0)
+    return std::sqrt(outside_sqr);
+  return inside_max;
+};
+
+// squared distance between a point and the segment c + t * a (t in [-hl, hl]).
+inline double point_segment_dist_sqr(const double* pt, const double* c, const double* a, double hl) {
+  double d[3] = {pt[0] - c[0], pt[1] - c[1], pt[2] - c[2]};
+  double t = std::max(-hl, std::min(hl, dot3(d, a)));
+  d[0] -= t * a[0]; d[1] -= t * a[1]; d[2] -= t * a[2];
+  return dot3(d, d);
+};
+
+// squared distance between the segments c1 + s * a1 and c2 + t * a2 (unit directions, s in [-hl1, hl1], t in [-hl2, hl2]).
+inline double segment_segment_dist_sqr(const double* c1, const double* a1, double hl1,
+                                       const double* c2, const double* a2, double hl2) {
+  double r[3] = {c1[0] - c2[0], c1[1] - c2[1], c1[2] - c2[2]};
+  double b = dot3(a1, a2);
+  double d = dot3(a1, r);
+  double e = dot3(a2, r);
+  double denom = 1.0 - b * b;
+  double s = 0.0;
+  if(denom > 1e-12)
+    s = std::max(-hl1, std::min(hl1, (b * e - d) / denom));
+  double t = std::max(-hl2, std::min(hl2, b * s + e));
+  s = std::max(-hl1, std::min(hl1, b * t - d));
+  double w[3] = {r[0] + s * a1[0] - t * a2[0], r[1] + s * a1[1] - t * a2[1], r[2] + s * a1[2] - t * a2[2]};
+  return dot3(w, w);
+};
+
+
+bool overlap_plane_sphere(const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D& pl,
+                          const proxy_compiled_model_3D::primitive& sp, const proxy_rigid_transform_3D& sp_T) {
+  return plane_height(pl, sp_T.p) < sp.dims[0];
+};
+
+bool overlap_plane_ccylinder(const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D& pl,
+                             const proxy_compiled_model_3D::primitive& cc, const proxy_rigid_transform_3D& cc_T) {
+  double na = dot3(pl.R + 6, cc_T.R + 6);
+  return plane_height(pl, cc_T.p) - 0.5 * cc.dims[0] * std::fabs(na) < cc.dims[1];
+};
+
+bool overlap_plane_cylinder(const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D& pl,
+                            const proxy_compiled_model_3D::primitive& cy, const proxy_rigid_transform_3D& cy_T) {
+  double na = dot3(pl.R + 6, cy_T.R + 6);
+  return plane_height(pl, cy_T.p) - 0.5 * cy.dims[0] * std::fabs(na)
+         - cy.dims[1] * std::sqrt(std::max(0.0, 1.0 - na * na)) < 0.0;
+};
+
+bool overlap_plane_box(const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D& pl,
+                       const proxy_compiled_model_3D::primitive& bx, const proxy_rigid_transform_3D& bx_T) {
+  double depth = 0.5 * (bx.dims[0] * std::fabs(dot3(pl.R + 6, bx_T.R))
+                      + bx.dims[1] * std::fabs(dot3(pl.R + 6, bx_T.R + 3))
+                      + bx.dims[2] * std::fabs(dot3(pl.R + 6, bx_T.R + 6)));
+  return plane_height(pl, bx_T.p) < depth;
+};
+
+bool overlap_sphere_sphere(const proxy_compiled_model_3D::primitive& sp1, const proxy_rigid_transform_3D& sp1_T,
+                           const proxy_compiled_model_3D::primitive& sp2, const proxy_rigid_transform_3D& sp2_T) {
+  double d[3] = {sp1_T.p[0] - sp2_T.p[0], sp1_T.p[1] - sp2_T.p[1], sp1_T.p[2] - sp2_T.p[2]};
+  double r = sp1.dims[0] + sp2.dims[0];
+  return dot3(d, d) < r * r;
+};
+
+bool overlap_sphere_ccylinder(const proxy_compiled_model_3D::primitive& sp, const proxy_rigid_transform_3D& sp_T,
+                              const proxy_compiled_model_3D::primitive& cc, const proxy_rigid_transform_3D& cc_T) {
+  double r = sp.dims[0] + cc.dims[1];
+  return point_segment_dist_sqr(sp_T.p, cc_T.p, cc_T.R + 6, 0.5 * cc.dims[0]) < r * r;
+};
+
+bool overlap_sphere_cylinder(const proxy_compiled_model_3D::primitive& sp, const proxy_rigid_transform_3D& sp_T,
+                             const proxy_compiled_model_3D::primitive& cy, const proxy_rigid_transform_3D& cy_T) {
+  double q[3];
+  to_local(cy_T, sp_T.p, q);
+  double dr = std::sqrt(q[0] * q[0] + q[1] * q[1]) - cy.dims[1];
+  double dz = std::fabs(q[2]) - 0.5 * cy.dims[0];
+  if((dr <= 0.0) || (dz <= 0.0))
+    return std::max(dr, dz) < sp.dims[0];
+  return dr * dr + dz * dz < sp.dims[0] * sp.dims[0];
+};
+
+bool overlap_sphere_box(const proxy_compiled_model_3D::primitive& sp, const proxy_rigid_transform_3D& sp_T,
+                        const proxy_compiled_model_3D::primitive& bx, const proxy_rigid_transform_3D& bx_T) {
+  double q[3];
+  to_local(bx_T, sp_T.p, q);
+  double h[3] = {0.5 * bx.dims[0], 0.5 * bx.dims[1], 0.5 * bx.dims[2]};
+  return box_signed_distance(h, q) < sp.dims[0];
+};
+
+bool overlap_ccylinder_ccylinder(const proxy_compiled_model_3D::primitive& cc1, const proxy_rigid_transform_3D& cc1_T,
+                                 const proxy_compiled_model_3D::primitive& cc2, const proxy_rigid_transform_3D& cc2_T) {
+  double r = cc1.dims[1] + cc2.dims[1];
+  return segment_segment_dist_sqr(cc1_T.p, cc1_T.R + 6, 0.5 * cc1.dims[0],
+                                  cc2_T.p, cc2_T.R + 6, 0.5 * cc2.dims[0]) < r * r;
+};
+
+bool overlap_ccylinder_box(const proxy_compiled_model_3D::primitive& cc, const proxy_rigid_transform_3D& cc_T,
+                           const proxy_compiled_model_3D::primitive& bx, const proxy_rigid_transform_3D& bx_T) {
+  // the signed distance to a box is convex and 1-Lipschitz, so it is minimized along the
+  //  segment by a golden-section search, with early exits on both sides.
+  double h[3] = {0.5 * bx.dims[0], 0.5 * bx.dims[1], 0.5 * bx.dims[2]};
+  double hl = 0.5 * cc.dims[0];
+  double c[3], a[3];
+  to_local(bx_T, cc_T.p, c);
+  a[0] = dot3(bx_T.R, cc_T.R + 6);
+  a[1] = dot3(bx_T.R + 3, cc_T.R + 6);
+  a[2] = dot3(bx_T.R + 6, cc_T.R + 6);
+
+  double f_c = box_signed_distance(h, c);
+  if(f_c < cc.dims[1])
+    return true;
+  if(f_c - hl >= cc.dims[1])
+    return false;
+
+  const double golden = 0.5 * (std::sqrt(5.0) - 1.0);
+  double lo = -hl, hi = hl;
+  double t1 = hi - golden * (hi - lo);
+  double t2 = lo + golden * (hi - lo);
+  double q[3];
+  q[0] = c[0] + t1 * a[0]; q[1] = c[1] + t1 * a[1]; q[2] = c[2] + t1 * a[2];
+  double f1 = box_signed_distance(h, q);
+  q[0] = c[0] + t2 * a[0]; q[1] = c[1] + t2 * a[1]; q[2] = c[2] + t2 * a[2];
+  double f2 = box_signed_distance(h, q);
+  while(hi - lo > 1e-6 * (1.0 + hl)) {
+    if((f1 < cc.dims[1]) || (f2 < cc.dims[1]))
+      return true;
+    // the minimum cannot be lower than the best value minus the remaining interval length.
+    if(std::min(f1, f2) - (hi - lo) >= cc.dims[1])
+      return false;
+    if(f1 < f2) {
+      hi = t2; t2 = t1; f2 = f1;
+      t1 = hi - golden * (hi - lo);
+      q[0] = c[0] + t1 * a[0]; q[1] = c[1] + t1 * a[1]; q[2] = c[2] + t1 * a[2];
+      f1 = box_signed_distance(h, q);
+    } else {
+      lo = t1; t1 = t2; f1 = f2;
+      t2 = lo + golden * (hi - lo);
+      q[0] = c[0] + t2 * a[0]; q[1] = c[1] + t2 * a[1]; q[2] = c[2] + t2 * a[2];
+      f2 = box_signed_distance(h, q);
+    };
+  };
+  return std::min(f1, f2) < cc.dims[1];
+};
+
+
+typedef bool (*overlap_test_ptr)(const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D&,
+                                 const proxy_compiled_model_3D::primitive&, const proxy_rigid_transform_3D&);
+
+// returns the kind of pair for two primitive kinds (lower kind first), or pair_kind_count if not covered.
+int get_pair_kind(int k1, int k2) {
+  typedef proxy_compiled_model_3D pcm;
+  typedef proxy_compiled_pair_3D pcp;
+  switch(k1) {
+    case pcm::plane_kind:
+      switch(k2) {
+        case pcm::sphere_kind:    return pcp::plane_sphere_pair;
+        case pcm::ccylinder_kind: return pcp::plane_ccylinder_pair;
+        case pcm::cylinder_kind:  return pcp::plane_cylinder_pair;
+        case pcm::box_kind:       return pcp::plane_box_pair;
+        default:                  return pcp::pair_kind_count;  // two planes never collide (as in prox_plane_plane).
+      };
+    case pcm::sphere_kind:
+      switch(k2) {
+        case pcm::sphere_kind:    return pcp::sphere_sphere_pair;
+        case pcm::ccylinder_kind: return pcp::sphere_ccylinder_pair;
+        case pcm::cylinder_kind:  return pcp::sphere_cylinder_pair;
+        case pcm::box_kind:       return pcp::sphere_box_pair;
+        default:                  return pcp::pair_kind_count;
+      };
+    case pcm::ccylinder_kind:
+      switch(k2) {
+        case pcm::ccylinder_kind: return pcp::ccylinder_ccylinder_pair;
+        case pcm::box_kind:       return pcp::ccylinder_box_pair;
+        default:                  return pcp::pair_kind_count;
+      };
+    default:
+      return pcp::pair_kind_count;  // no finders for cylinder-cylinder, cylinder-box and box-box.
+  };
+};
+
+template <overlap_test_ptr Test>
+bool check_pair_range(const std::vector< proxy_compiled_pair_3D::primitive_pair >& aPairs,
+                      std::size_t aBegin, std::size_t aEnd,
+                      const proxy_compiled_model_3D& aModel1, const proxy_compiled_model_3D& aModel2) {
+  for(std::size_t i = aBegin; i < aEnd; ++i) {
+    const proxy_compiled_pair_3D::primitive_pair& pr = aPairs[i];
+    const proxy_compiled_model_3D& m_a = (pr.first_in_model1 ? aModel1 : aModel2);
+    const proxy_compiled_model_3D& m_b = (pr.first_in_model1 ? aModel2 : aModel1);
+    // reject the pairs whose bounding spheres are apart (never the case with a plane) before the exact test.
+    const proxy_rigid_transform_3D& T_a = m_a.getWorldTransform(pr.first);
+    const proxy_rigid_transform_3D& T_b = m_b.getWorldTransform(pr.second);
+    double d[3] = {T_b.p[0] - T_a.p[0], T_b.p[1] - T_a.p[1], T_b.p[2] - T_a.p[2]};
+    double r = m_a.getPrimitive(pr.first).bound + m_b.getPrimitive(pr.second).bound;
+    if(d[0] * d[0] + d[1] * d[1] + d[2] * d[2] >= r * r)
+      continue;
+    if(Test(m_a.getPrimitive(pr.first), m_a.getWorldTransform(pr.first),
+            m_b.getPrimitive(pr.second), m_b.getWorldTransform(pr.second)))
+      return true;
+  };
+  return false;
+};
+
+};
+
+
+proxy_compiled_pair_3D::proxy_compiled_pair_3D(const proxy_query_pair_3D& aPair) :
+                                               mModel1(), mModel2(), mPairs() {
+  if(aPair.getModel1())
+    mModel1.compile(*aPair.getModel1());
+  if(aPair.getModel2())
+    mModel2.compile(*aPair.getModel2());
+  createPairTable();
+};
+
+void proxy_compiled_pair_3D::createPairTable() {
+  std::vector< std::pair< int, primitive_pair > > pairs;
+  for(std::size_t i = 0; i < mModel1.getPrimitiveCount(); ++i) {
+    for(std::size_t j = 0; j < mModel2.getPrimitiveCount(); ++j) {
+      int k1 = mModel1.getPrimitive(i).kind;
+      int k2 = mModel2.getPrimitive(j).kind;
+      primitive_pair pr;
+      if(k1 <= k2) {
+        pr.first = i; pr.second = j; pr.first_in_model1 = true;
+      } else {
+        pr.first = j; pr.second = i; pr.first_in_model1 = false;
+        std::swap(k1, k2);
+      };
+      int pk = get_pair_kind(k1, k2);
+      if(pk != pair_kind_count)
+        pairs.push_back(std::make_pair(pk, pr));
+    };
+  };
+
+  mPairs.clear();
+  mPairs.reserve(pairs.size());
+  for(int pk = 0; pk < pair_kind_count; ++pk) {
+    mKindOffsets[pk] = mPairs.size();
+    for(std::size_t i = 0; i < pairs.size(); ++i)
+      if(pairs[i].first == pk)
+        mPairs.push_back(pairs[i].second);
+  };
+  mKindOffsets[pair_kind_count] = mPairs.size();
+};
+
+bool proxy_compiled_pair_3D::checkCollision() const {
+#define RK_COMPILED_PROXY_CHECK_KIND(KIND, TEST) \
+  if(check_pair_range< TEST >(mPairs, mKindOffsets[KIND], mKindOffsets[KIND + 1], mModel1, mModel2)) \
+    return true;
+
+  RK_COMPILED_PROXY_CHECK_KIND(plane_sphere_pair, overlap_plane_sphere)
+  RK_COMPILED_PROXY_CHECK_KIND(plane_ccylinder_pair, overlap_plane_ccylinder)
+  RK_COMPILED_PROXY_CHECK_KIND(plane_cylinder_pair, overlap_plane_cylinder)
+  RK_COMPILED_PROXY_CHECK_KIND(plane_box_pair, overlap_plane_box)
+  RK_COMPILED_PROXY_CHECK_KIND(sphere_sphere_pair, overlap_sphere_sphere)
+  RK_COMPILED_PROXY_CHECK_KIND(sphere_ccylinder_pair, overlap_sphere_ccylinder)
+  RK_COMPILED_PROXY_CHECK_KIND(sphere_cylinder_pair, overlap_sphere_cylinder)
+  RK_COMPILED_PROXY_CHECK_KIND(sphere_box_pair, overlap_sphere_box)
+  RK_COMPILED_PROXY_CHECK_KIND(ccylinder_ccylinder_pair, overlap_ccylinder_ccylinder)
+  RK_COMPILED_PROXY_CHECK_KIND(ccylinder_box_pair, overlap_ccylinder_box)
+
+#undef RK_COMPILED_PROXY_CHECK_KIND
+  return false;
+};
+
+std::size_t proxy_compiled_pair_3D::checkCollisionBatch(const proxy_rigid_transform_3D* aConfigs, std::size_t aConfigCount, bool* aResults) {
+  const std::size_t link_count = mModel1.getLinkCount();
+  std::size_t collision_count = 0;
+  for(std::size_t i = 0; i < aConfigCount; ++i) {
+    mModel1.setLinkTransforms(aConfigs + i * link_count);
+    aResults[i] = checkCollision();
+    if(aResults[i])
+      ++collision_count;
+  };
+  return collision_count;
+};
+
+std::size_t proxy_compiled_pair_3D::checkCollisionBatch(const std::vector< proxy_rigid_transform_3D >& aConfigs, std::vector< char >& aResults) {
+  const std::size_t link_count = mModel1.getLinkCount();
+  const std::size_t config_count = (link_count == 0 ? 0 : aConfigs.size() / link_count);
+  aResults.resize(config_count);
+  std::size_t collision_count = 0;
+  for(std::size_t i = 0; i < config_count; ++i) {
+    mModel1.setLinkTransforms(&aConfigs[i * link_count]);
+    aResults[i] = checkCollision();
+    if(aResults[i])
+      ++collision_count;
+  };
+  return collision_count;
+};
+
+
+};
+
+};
+
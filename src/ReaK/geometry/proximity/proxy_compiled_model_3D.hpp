@@ -0,0 +1,284 @@
+/**
+ * \file proxy_compiled_model_3D.hpp
+ *
+ * This library declares a compiled (flat) form of the 3D proximity-query models and pairs. The shapes
+ * of a model are stored as contiguous arrays of primitive parameters with cached world transforms, and
+ * the pairs of primitives to check are sorted by type, such that collision checks run as tight loops
+ * without virtual calls, pose-chain walks or heap allocations. This is intended for the collision
+ * checks of motion planners, which make up most of their running time.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROXY_COMPILED_MODEL_3D_HPP
+#define REAK_PROXY_COMPILED_MODEL_3D_HPP
+
+#include "proxy_query_model.hpp"
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/** This POD type is a rigid transform in flat form, used by the compiled proximity models. */
+struct proxy_rigid_transform_3D {
+  double R[9];  ///< Rotation matrix, in column-major order (as rot_mat_3D).
+  double p[3];  ///< Translation.
+
+  /**
+   * Returns the identity transform.
+   */
+  static proxy_rigid_transform_3D identity();
+
+  /**
+   * Creates the transform equivalent to a pose (relative to its parent, the parent is ignored).
+   */
+  static proxy_rigid_transform_3D fromPose(const pose_3D<double>& aPose);
+};
+
+/**
+ * Composes two transforms, i.e., returns the transform of aChild (expressed relative to aParent) in the frame of aParent's parent.
+ */
+proxy_rigid_transform_3D compose(const proxy_rigid_transform_3D& aParent, const proxy_rigid_transform_3D& aChild);
+
+
+/**
+ * This class is the compiled form of a proxy_query_model_3D. Each shape becomes a primitive with flat
+ * parameters and a transform relative to its "link", which is the parent pose of the shape (e.g., the
+ * frame of a kinematic chain to which the shape is attached). The global transforms of the links are
+ * either read from the live poses (one pose-chain walk per link, instead of one per shape per pair), or
+ * given directly by the caller (see proxy_compiled_pair_3D::checkCollisionBatch).
+ * \note The shape parameters and poses relative to the links are copied at compile time, so the model must
+ *       be re-compiled if they change.
+ */
+class proxy_compiled_model_3D {
+  public:
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// The primitive kinds, in the same order of precedence as the proximity finders of proxy_query_pair_3D.
+    enum primitive_kind {
+      plane_kind = 0,
+      sphere_kind,
+      ccylinder_kind,
+      cylinder_kind,
+      box_kind,
+      primitive_kind_count
+    };
+
+    /** This POD type holds the flat parameters of a primitive shape. */
+    struct primitive {
+      int kind;
+      std::size_t link;                  ///< Index of the link of the primitive, or npos if attached to the global frame.
+      std::size_t shape;                 ///< Index of the shape in the original model.
+      proxy_rigid_transform_3D local;    ///< Transform of the primitive relative to its link.
+      double dims[3];                    ///< Plane: (x,y) dims, sphere: (radius), cylinders: (length, radius), box: (x,y,z) dims.
+      double bound;                      ///< Radius of the bounding sphere about the origin of the primitive (infinite for planes).
+    };
+
+  private:
+
+    std::vector< primitive > mPrimitives;
+    std::vector< shared_ptr< pose_3D<double> > > mLinks;
+    std::vector< proxy_rigid_transform_3D > mLinkTransforms;
+    std::vector< proxy_rigid_transform_3D > mWorldTransforms;
+
+  public:
+
+    /**
+     * Default constructor, creates an empty model.
+     */
+    proxy_compiled_model_3D() : mPrimitives(), mLinks(), mLinkTransforms(), mWorldTransforms() { };
+
+    /**
+     * Creates a compiled model from a proximity-query model.
+     */
+    explicit proxy_compiled_model_3D(const proxy_query_model_3D& aModel) :
+      mPrimitives(), mLinks(), mLinkTransforms(), mWorldTransforms() { compile(aModel); };
+
+    /**
+     * Compiles the given proximity-query model, replacing the current contents. Shapes of unsupported
+     * types (grids, arrows, composites, etc.) are skipped, as they are by the proximity finders.
+     * \param aModel The proximity-query model to compile.
+     */
+    void compile(const proxy_query_model_3D& aModel);
+
+    /**
+     * Returns the number of primitives in the model.
+     */
+    std::size_t getPrimitiveCount() const { return mPrimitives.size(); };
+
+    /**
+     * Returns the primitive at a given index.
+     */
+    const primitive& getPrimitive(std::size_t i) const { return mPrimitives[i]; };
+
+    /**
+     * Returns the current world transform of the primitive at a given index.
+     */
+    const proxy_rigid_transform_3D& getWorldTransform(std::size_t i) const { return mWorldTransforms[i]; };
+
+    /**
+     * Returns the number of links (distinct parent poses) of the model.
+     */
+    std::size_t getLinkCount() const { return mLinks.size(); };
+
+    /**
+     * Returns the parent pose that corresponds to a given link.
+     */
+    const shared_ptr< pose_3D<double> >& getLinkPose(std::size_t i) const { return mLinks[i]; };
+
+    /**
+     * Reads the global transforms of all the links from their live poses and updates the world transforms.
+     */
+    void updateFromPoses();
+
+    /**
+     * Sets the global transforms of all the links and updates the world transforms. This does not allocate.
+     * \param aLinkTransforms Pointer to the first of getLinkCount() link transforms.
+     */
+    void setLinkTransforms(const proxy_rigid_transform_3D* aLinkTransforms);
+
+};
+
+
+/**
+ * This class is the compiled form of a proxy_query_pair_3D. It holds the compiled models and a table of
+ * the pairs of primitives to check, sorted by the kind of each pair, such that each kind of check runs
+ * in a tight loop. The same pairs of shape types are covered as by the proximity finders of
+ * proxy_query_pair_3D, but with closed-form overlap tests (planes being half-spaces, as for the finders).
+ */
+class proxy_compiled_pair_3D {
+  public:
+
+    /** This POD type is an entry of the pair table, the first primitive always has the lower kind. */
+    struct primitive_pair {
+      std::size_t first;
+      std::size_t second;
+      bool first_in_model1;
+    };
+
+    /// The kinds of pairs, in the order in which they are sorted in the pair table.
+    enum pair_kind {
+      plane_sphere_pair = 0,
+      plane_ccylinder_pair,
+      plane_cylinder_pair,
+      plane_box_pair,
+      sphere_sphere_pair,
+      sphere_ccylinder_pair,
+      sphere_cylinder_pair,
+      sphere_box_pair,
+      ccylinder_ccylinder_pair,
+      ccylinder_box_pair,
+      pair_kind_count
+    };
+
+  private:
+
+    proxy_compiled_model_3D mModel1;
+    proxy_compiled_model_3D mModel2;
+
+    std::vector< primitive_pair > mPairs;
+    std::size_t mKindOffsets[pair_kind_count + 1];
+
+    void createPairTable();
+
+  public:
+
+    /**
+     * Default constructor, creates an empty pair.
+     */
+    proxy_compiled_pair_3D() : mModel1(), mModel2(), mPairs() {
+      createPairTable();
+    };
+
+    /**
+     * Creates a compiled pair from two proximity-query models.
+     */
+    proxy_compiled_pair_3D(const proxy_query_model_3D& aModel1, const proxy_query_model_3D& aModel2) :
+                           mModel1(aModel1), mModel2(aModel2), mPairs() {
+      createPairTable();
+    };
+
+    /**
+     * Creates a compiled pair from a proximity-query pair.
+     */
+    explicit proxy_compiled_pair_3D(const proxy_query_pair_3D& aPair);
+
+    const proxy_compiled_model_3D& getModel1() const { return mModel1; };
+    const proxy_compiled_model_3D& getModel2() const { return mModel2; };
+
+    /**
+     * Returns the number of pairs of primitives that are checked.
+     */
+    std::size_t getPairCount() const { return mPairs.size(); };
+
+    /**
+     * Reads the global transforms of the links of both models from their live poses.
+     */
+    void updateFromPoses() {
+      mModel1.updateFromPoses();
+      mModel2.updateFromPoses();
+    };
+
+    /**
+     * Checks if any pair of primitives is in collision, at the current transforms of both models.
+     * \return True if there is a collision.
+     */
+    bool checkCollision() const;
+
+    /**
+     * Checks many configurations of the first model against the second model (at its current transforms).
+     * Each configuration is given as the global transforms of all the links of the first model. No heap
+     * allocation is done.
+     * \param aConfigs Pointer to the first link transform of the first configuration, with getModel1().getLinkCount() transforms per configuration.
+     * \param aConfigCount The number of configurations.
+     * \param aResults Pointer to the array (with aConfigCount elements) that receives the collision flags.
+     * \return The number of configurations that are in collision.
+     */
+    std::size_t checkCollisionBatch(const proxy_rigid_transform_3D* aConfigs, std::size_t aConfigCount, bool* aResults);
+
+    /**
+     * Checks many configurations of the first model against the second model (at its current transforms).
+     * \param aConfigs The link transforms of the configurations, with getModel1().getLinkCount() transforms per configuration.
+     * \param aResults The vector that receives the collision flags (resized, which only allocates if it is too small).
+     * \return The number of configurations that are in collision.
+     */
+    std::size_t checkCollisionBatch(const std::vector< proxy_rigid_transform_3D >& aConfigs, std::vector< char >& aResults);
+
+};
+
+
+};
+
+};
+
+#endif
+
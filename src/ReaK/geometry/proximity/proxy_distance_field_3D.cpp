@@ -0,0 +1,237 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_distance_field_3D.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+namespace ReaK {
+
+namespace geom {
+
+
+proxy_distance_field_3D::proxy_distance_field_3D(const std::string& aName,
+                                                 const shared_ptr< grid_3D >& aGrid,
+                                                 double aMaxDistance) :
+                                                 named_object(), mGrid(aGrid),
+                                                 mMaxDistance(aMaxDistance), mValues() {
+  setName(aName);
+  updateLayout();
+};
+
+void proxy_distance_field_3D::updateLayout() {
+  mNodeCounts[0] = 0; mNodeCounts[1] = 0; mNodeCounts[2] = 0;
+  if(!mGrid)
+    return;
+  pose_3D<double> gp = mGrid->getPose().getGlobalPose();
+  mCenter = gp.Position;
+  mAxes[0] = gp.Quat * vect<double,3>(1.0,0.0,0.0);
+  mAxes[1] = gp.Quat * vect<double,3>(0.0,1.0,0.0);
+  mAxes[2] = gp.Quat * vect<double,3>(0.0,0.0,1.0);
+  for(std::size_t a = 0; a < 3; ++a) {
+    std::size_t n = mGrid->getSquareCounts()[a];
+    mSteps[a] = (n > 0 ? mGrid->getDimensions()[a] / double(n) : 0.0);
+    mNodeCounts[a] = n + 1;
+  };
+};
+
+void proxy_distance_field_3D::build(const proxy_query_model_3D& aModel) {
+  if(!mGrid)
+    throw std::invalid_argument("The distance field cannot be built without a grid!");
+  if((mGrid->getSquareCounts()[0] == 0) || (mGrid->getSquareCounts()[1] == 0) || (mGrid->getSquareCounts()[2] == 0))
+    throw std::invalid_argument("The grid of the distance field must have at least one square along each axis!");
+  updateLayout();
+
+  // a zero-radius sphere, moved to each node, gives the signed distance to the obstacles.
+  shared_ptr< pose_3D<double> > no_anchor;
+  shared_ptr< sphere > probe(new sphere("probe", no_anchor, pose_3D<double>(), 0.0));
+  shared_ptr< proxy_query_model_3D > probe_model(new proxy_query_model_3D("probe"));
+  probe_model->addShape(probe);
+  shared_ptr< proxy_query_model_3D > env_model(new proxy_query_model_3D(aModel.getName()));
+  env_model->mShapeList = aModel.mShapeList;
+  proxy_query_pair_3D probe_pair("probe_pair", probe_model, env_model);
+
+  mValues.resize(mNodeCounts[0] * mNodeCounts[1] * mNodeCounts[2]);
+  vect<double,3> lower = mCenter - 0.5 * mGrid->getDimensions()[0] * mAxes[0]
+                                 - 0.5 * mGrid->getDimensions()[1] * mAxes[1]
+                                 - 0.5 * mGrid->getDimensions()[2] * mAxes[2];
+  std::size_t idx = 0;
+  for(std::size_t k = 0; k < mNodeCounts[2]; ++k) {
+    for(std::size_t j = 0; j < mNodeCounts[1]; ++j) {
+      for(std::size_t i = 0; i < mNodeCounts[0]; ++i, ++idx) {
+        probe->setPose(pose_3D<double>(no_anchor, lower + (double(i) * mSteps[0]) * mAxes[0]
+                                                        + (double(j) * mSteps[1]) * mAxes[1]
+                                                        + (double(k) * mSteps[2]) * mAxes[2], quaternion<double>()));
+        shared_ptr< proximity_finder_3D > closest = probe_pair.findMinimumDistance();
+        double d = (closest ? closest->getLastResult().mDistance : mMaxDistance);
+        mValues[idx] = (d < mMaxDistance ? d : mMaxDistance);
+      };
+    };
+  };
+};
+
+void proxy_distance_field_3D::getGridCell(const vect<double,3>& aPoint, std::size_t* aCell, double* aFraction, vect<double,3>& aOutside) const {
+  // grid coordinates of the point (in units of squares, from the lower corner), clamped to the grid.
+  vect<double,3> diff = aPoint - mCenter;
+  aOutside = vect<double,3>(0.0,0.0,0.0);
+  for(std::size_t a = 0; a < 3; ++a) {
+    double half = 0.5 * mGrid->getDimensions()[a];
+    double x = mAxes[a] * diff;
+    if(x < -half) {
+      aOutside[a] = x + half;
+      x = -half;
+    } else if(x > half) {
+      aOutside[a] = x - half;
+      x = half;
+    };
+    double u = (x + half) / mSteps[a];
+    double fl = std::floor(u);
+    aCell[a] = (fl < double(mNodeCounts[a] - 2) ? std::size_t(fl > 0.0 ? fl : 0.0) : mNodeCounts[a] - 2);
+    aFraction[a] = u - double(aCell[a]);
+  };
+};
+
+double proxy_distance_field_3D::getDistanceAndGradient(const vect<double,3>& aPoint, vect<double,3>& aGradient) const {
+  aGradient = vect<double,3>(0.0,0.0,0.0);
+  if(mValues.empty())
+    return std::numeric_limits<double>::infinity();
+
+  vect<double,3> outside;
+  std::size_t c[3];
+  double t[3];
+  getGridCell(aPoint, c, t, outside);
+
+  double v000 = getNodeValue(c[0],   c[1],   c[2]);
+  double v100 = getNodeValue(c[0]+1, c[1],   c[2]);
+  double v010 = getNodeValue(c[0],   c[1]+1, c[2]);
+  double v110 = getNodeValue(c[0]+1, c[1]+1, c[2]);
+  double v001 = getNodeValue(c[0],   c[1],   c[2]+1);
+  double v101 = getNodeValue(c[0]+1, c[1],   c[2]+1);
+  double v011 = getNodeValue(c[0],   c[1]+1, c[2]+1);
+  double v111 = getNodeValue(c[0]+1, c[1]+1, c[2]+1);
+
+  // interpolate along x, then y, then z, keeping the partial derivatives along the way.
+  double v00 = v000 + t[0] * (v100 - v000);
+  double v10 = v010 + t[0] * (v110 - v010);
+  double v01 = v001 + t[0] * (v101 - v001);
+  double v11 = v011 + t[0] * (v111 - v011);
+  double v0 = v00 + t[1] * (v10 - v00);
+  double v1 = v01 + t[1] * (v11 - v01);
+  double result = v0 + t[2] * (v1 - v0);
+
+  double dx0 = (v100 - v000) + t[1] * ((v110 - v010) - (v100 - v000));
+  double dx1 = (v101 - v001) + t[1] * ((v111 - v011) - (v101 - v001));
+  double dx = (dx0 + t[2] * (dx1 - dx0)) / mSteps[0];
+  double dy = ((v10 - v00) + t[2] * ((v11 - v01) - (v10 - v00))) / mSteps[1];
+  double dz = (v1 - v0) / mSteps[2];
+  // the interpolated value does not vary along the axes on which the point was clamped.
+  if(outside[0] != 0.0) dx = 0.0;
+  if(outside[1] != 0.0) dy = 0.0;
+  if(outside[2] != 0.0) dz = 0.0;
+  aGradient = dx * mAxes[0] + dy * mAxes[1] + dz * mAxes[2];
+
+  double out_dist = norm_2(outside);
+  if(out_dist > 0.0) {
+    result += out_dist;
+    aGradient += (outside[0] * mAxes[0] + outside[1] * mAxes[1] + outside[2] * mAxes[2]) * (1.0 / out_dist);
+  };
+  return result;
+};
+
+double proxy_distance_field_3D::getDistance(const vect<double,3>& aPoint) const {
+  vect<double,3> grad;
+  return getDistanceAndGradient(aPoint, grad);
+};
+
+double proxy_distance_field_3D::getDistanceLowerBound(const vect<double,3>& aPoint) const {
+  if(mValues.empty())
+    return std::numeric_limits<double>::infinity();
+
+  vect<double,3> outside;
+  std::size_t c[3];
+  double t[3];
+  getGridCell(aPoint, c, t, outside);
+
+  // the signed distance changes no faster than the position, and the node values never exceed it (they
+  // are only truncated from above), so each corner of the cell bounds the distance at the clamped point.
+  double result = -std::numeric_limits<double>::infinity();
+  for(std::size_t n = 0; n < 8; ++n) {
+    std::size_t ci = (n & 1), cj = ((n >> 1) & 1), ck = ((n >> 2) & 1);
+    double dx = (t[0] - double(ci)) * mSteps[0];
+    double dy = (t[1] - double(cj)) * mSteps[1];
+    double dz = (t[2] - double(ck)) * mSteps[2];
+    double bound = getNodeValue(c[0] + ci, c[1] + cj, c[2] + ck) - std::sqrt(dx * dx + dy * dy + dz * dz);
+    if(bound > result)
+      result = bound;
+  };
+
+  // outside of the grid, any obstacle point (within the grid) lies beyond the clamped point as seen from the 
+  // point (the offset to the clamped point is normal to the grid), so their distances add up quadratically.
+  double out_dist = norm_2(outside);
+  if(out_dist > 0.0)
+    result = (result > 0.0 ? std::sqrt(result * result + out_dist * out_dist) : 0.0);
+  return result;
+};
+
+double proxy_distance_field_3D::getClearance(const shape_3D& aShape) const {
+  return getDistanceLowerBound(aShape.getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0))) - aShape.getBoundingRadius();
+};
+
+double proxy_distance_field_3D::getClearance(const proxy_query_model_3D& aModel) const {
+  double result = std::numeric_limits<double>::infinity();
+  for(std::size_t i = 0; i < aModel.mShapeList.size(); ++i) {
+    if(!aModel.mShapeList[i])
+      continue;
+    double d = getClearance(*aModel.mShapeList[i]);
+    if(d < result)
+      result = d;
+  };
+  return result;
+};
+
+
+void RK_CALL proxy_distance_field_3D::save(ReaK::serialization::oarchive& A, unsigned int) const {
+  named_object::save(A,named_object::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_SAVE_WITH_NAME(mGrid)
+    & RK_SERIAL_SAVE_WITH_NAME(mMaxDistance)
+    & RK_SERIAL_SAVE_WITH_NAME(mValues);
+};
+
+void RK_CALL proxy_distance_field_3D::load(ReaK::serialization::iarchive& A, unsigned int) {
+  named_object::load(A,named_object::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_LOAD_WITH_NAME(mGrid)
+    & RK_SERIAL_LOAD_WITH_NAME(mMaxDistance)
+    & RK_SERIAL_LOAD_WITH_NAME(mValues);
+  updateLayout();
+};
+
+
+};
+
+};
+
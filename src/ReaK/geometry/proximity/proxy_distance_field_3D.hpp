@@ -0,0 +1,208 @@
+/**
+ * \file proxy_distance_field_3D.hpp
+ *
+ * This library declares a signed distance field over a 3D grid, precomputed from the shapes of a
+ * proximity-query model (typically the static obstacles of an environment). Once built, the distance
+ * to the obstacles and its gradient are obtained at any point by trilinear interpolation, in constant
+ * time, which makes collision checks and clearance computations (through the bounding spheres of the
+ * shapes of another model) independent of the number and complexity of the obstacles.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_PROXY_DISTANCE_FIELD_3D_HPP
+#define REAK_PROXY_DISTANCE_FIELD_3D_HPP
+
+#include "proxy_query_model.hpp"
+
+#include <ReaK/geometry/shapes/grid_3D.hpp>
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class is a signed distance field of the shapes of a proximity-query model, sampled at the nodes
+ * of a grid (as described by a grid_3D, which can also be used to render it). The distance at each node is
+ * computed once, with the proximity finders (between a point and each shape), and is negative inside the shapes
+ * (the penetration depth). The distances are truncated to a maximum distance, beyond which the exact
+ * clearance is usually not relevant.
+ * \note The grid and the shapes are assumed to be static, the field must be re-built if any of them moves.
+ */
+class proxy_distance_field_3D : public named_object {
+  protected:
+
+    shared_ptr< grid_3D > mGrid;
+    double mMaxDistance;
+    std::vector< double > mValues;
+
+    /// Cached layout of the grid: global center and axes, node spacing and node counts.
+    vect<double,3> mCenter;
+    vect<double,3> mAxes[3];
+    vect<double,3> mSteps;
+    std::size_t mNodeCounts[3];
+
+    void updateLayout();
+
+    /// Computes the cell of the grid that contains a point (clamped to the grid), the fractions of the point 
+    /// along the axes of the cell, and the offset of the point from the grid (zero if within the grid).
+    void getGridCell(const vect<double,3>& aPoint, std::size_t* aCell, double* aFraction, vect<double,3>& aOutside) const;
+
+    double getNodeValue(std::size_t i, std::size_t j, std::size_t k) const {
+      return mValues[(k * mNodeCounts[1] + j) * mNodeCounts[0] + i];
+    };
+
+  public:
+
+    /**
+     * Returns the grid on which the distance field is sampled (with squares between the nodes).
+     */
+    const shared_ptr< grid_3D >& getGrid() const { return mGrid; };
+
+    /**
+     * Returns the distance beyond which the stored distances are truncated.
+     */
+    double getMaxDistance() const { return mMaxDistance; };
+
+    /**
+     * Checks if the distance field has been built (see build()).
+     */
+    bool isBuilt() const { return !mValues.empty(); };
+
+    /**
+     * Default constructor.
+     * \param aName The name of the object.
+     * \param aGrid The grid on which to sample the distance field, its nodes are the corners of its squares.
+     * \param aMaxDistance The distance beyond which the stored distances are truncated.
+     */
+    proxy_distance_field_3D(const std::string& aName = "",
+                            const shared_ptr< grid_3D >& aGrid = shared_ptr< grid_3D >(),
+                            double aMaxDistance = 1.0);
+
+    /**
+     * Default destructor.
+     */
+    virtual ~proxy_distance_field_3D() { };
+
+    /**
+     * Computes the distance field of the shapes of a proximity-query model, replacing the current contents.
+     * This evaluates the proximity finders once per node of the grid (pruned by the broad-phase of
+     * proxy_query_pair_3D), and is thus meant to be done once for a static environment.
+     * \param aModel The proximity-query model whose shapes are the obstacles.
+     * \throw std::invalid_argument If there is no grid, or if the grid has no squares along some axis.
+     */
+    void build(const proxy_query_model_3D& aModel);
+
+    /**
+     * Returns the signed distance to the obstacles at a given point, by trilinear interpolation of the
+     * nodes around it. A point outside of the grid is clamped to it, and its distance to the grid is
+     * added, which is a fair approximation when all the obstacles lie inside the grid.
+     * \param aPoint The point, in the global frame.
+     * \return The signed distance (negative within the obstacles), at most getMaxDistance() within the grid.
+     */
+    double getDistance(const vect<double,3>& aPoint) const;
+
+    /**
+     * Returns the signed distance to the obstacles at a given point, and its gradient (the derivative of
+     * the trilinear interpolation, which points away from the nearest obstacle).
+     * \param aPoint The point, in the global frame.
+     * \param aGradient Stores, as output, the gradient of the distance, in the global frame.
+     * \return The signed distance (see getDistance()).
+     */
+    double getDistanceAndGradient(const vect<double,3>& aPoint, vect<double,3>& aGradient) const;
+
+    /**
+     * Returns the gradient of the signed distance to the obstacles at a given point (see getDistanceAndGradient()).
+     */
+    vect<double,3> getGradient(const vect<double,3>& aPoint) const {
+      vect<double,3> result;
+      getDistanceAndGradient(aPoint, result);
+      return result;
+    };
+
+    /**
+     * Returns a lower-bound on the signed distance to the obstacles at a given point. Because the signed 
+     * distance cannot vary faster than the position, each node of the cell containing the point gives a bound 
+     * (its value minus its distance to the point), and the largest is returned. A point outside of the grid 
+     * is bounded by the distance to the grid combined with the bound at the clamped point, which requires
+     * that all the obstacles lie inside the grid.
+     * \param aPoint The point, in the global frame.
+     * \return A lower-bound on the signed distance (negative within, or possibly near, the obstacles).
+     */
+    double getDistanceLowerBound(const vect<double,3>& aPoint) const;
+
+    /**
+     * Returns a lower-bound on the clearance of a shape from the obstacles, from its bounding sphere
+     * (about the origin of the shape) and the lower-bound on the distance at its center (see getDistanceLowerBound()).
+     * \param aShape The shape, at its current pose.
+     * \return The distance of the bounding sphere of the shape, negative if it may penetrate the obstacles.
+     */
+    double getClearance(const shape_3D& aShape) const;
+
+    /**
+     * Returns a lower-bound on the clearance of the shapes of a proximity-query model from the obstacles,
+     * from their bounding spheres (see getClearance(const shape_3D&)).
+     * \param aModel The proximity-query model, with its shapes at their current poses.
+     * \return The smallest distance of the bounding spheres of the shapes (infinity if there are none).
+     */
+    double getClearance(const proxy_query_model_3D& aModel) const;
+
+    /**
+     * Checks if any bounding sphere of the shapes of a proximity-query model may be in collision with
+     * the obstacles. This is conservative: a collision can be reported for shapes that are only close.
+     * \param aModel The proximity-query model, with its shapes at their current poses.
+     * \param aMargin The additional clearance that is required from the obstacles.
+     * \return True if a collision is possible.
+     */
+    bool checkCollision(const proxy_query_model_3D& aModel, double aMargin = 0.0) const {
+      return (getClearance(aModel) < aMargin);
+    };
+
+
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+
+    RK_RTTI_MAKE_CONCRETE_1BASE(proxy_distance_field_3D,0xC3200021,1,"proxy_distance_field_3D",named_object)
+
+};
+
+
+};
+
+};
+
+#endif
+
@@ -39,6 +39,8 @@
 #include <ReaK/geometry/shapes/box.hpp>
 #include <ReaK/geometry/shapes/cylinder.hpp>
 #include <ReaK/geometry/shapes/capped_cylinder.hpp>
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+#include <ReaK/geometry/shapes/triangle_mesh.hpp>
 #include <ReaK/geometry/shapes/composite_shape_3D.hpp>
 
 
@@ -58,6 +60,9 @@
 #include <ReaK/geometry/proximity/prox_sphere_ccylinder.hpp>
 #include <ReaK/geometry/proximity/prox_sphere_cylinder.hpp>
 #include <ReaK/geometry/proximity/prox_sphere_box.hpp>
+#include <ReaK/geometry/proximity/prox_convex_convex.hpp>
+#include <ReaK/geometry/proximity/prox_mesh_convex.hpp>
+#include <ReaK/geometry/proximity/prox_mesh_mesh.hpp>
 #include <ReaK/geometry/proximity/prox_ccylinder_ccylinder.hpp>
 #include <ReaK/geometry/proximity/prox_ccylinder_cylinder.hpp>     // NOTE: not working.
 #include <ReaK/geometry/proximity/prox_ccylinder_box.hpp>
@@ -65,6 +70,10 @@
 #include <ReaK/geometry/proximity/prox_cylinder_box.hpp>           // NOTE: not working.
 #include <ReaK/geometry/proximity/prox_box_box.hpp>                // NOTE: not working.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 
 namespace ReaK {
 
@@ -214,9 +223,19 @@ bool proxy_query_pair_2D::gatherCollisionPoints(std::vector< proximity_record_2D
 
 void proxy_query_pair_3D::createProxFinderList() {
   mProxFinders.clear();
+  mFinderTable.clear();
+  mFinderShapes.clear();
+  mFinderCoherent.clear();
+  mCoherence.clear();
+  mBVH1.clear();
+  mBVH2.clear();
   if(!mModel1 || !mModel2)
     return;
   
+  mBVH1.build(mModel1->mShapeList);
+  mBVH2.build(mModel2->mShapeList);
+  mFinderTable.resize(mModel1->mShapeList.size() * mModel2->mShapeList.size(), proxy_bvh_3D::npos);
+  
   // for all shapes in mModel1
   for(std::size_t i = 0; i < mModel1->mShapeList.size(); ++i) {
     if(!mModel1->mShapeList[i])
@@ -227,8 +246,39 @@ void proxy_query_pair_3D::createProxFinderList() {
       if(!mModel2->mShapeList[j])
         continue;
       
+      const std::size_t prev_count = mProxFinders.size();
+      
+      // if one of the model is a triangle mesh?
+      if((mModel1->mShapeList[i]->getObjectType() == triangle_mesh::getStaticObjectType()) ||
+         (mModel2->mShapeList[j]->getObjectType() == triangle_mesh::getStaticObjectType())) {
+        shared_ptr<triangle_mesh> ms_geom;
+        shared_ptr<shape_3D> other_geom;
+        if(mModel1->mShapeList[i]->getObjectType() == triangle_mesh::getStaticObjectType()) {
+          ms_geom = rtti::rk_static_ptr_cast<triangle_mesh>(mModel1->mShapeList[i]);
+          other_geom = mModel2->mShapeList[j];
+        } else {
+          ms_geom = rtti::rk_static_ptr_cast<triangle_mesh>(mModel2->mShapeList[j]);
+          other_geom = mModel1->mShapeList[i];
+        };
+        // if the other is a triangle mesh..
+        if(other_geom->getObjectType() == triangle_mesh::getStaticObjectType()) {
+          shared_ptr<triangle_mesh> ms2_geom = rtti::rk_static_ptr_cast<triangle_mesh>(other_geom);
+          mProxFinders.push_back(shared_ptr< prox_mesh_mesh >(new prox_mesh_mesh(ms_geom, ms2_geom)));
+        }
+        // if the other is convex..
+        else if(convex_support_3D::isSupported(*other_geom)) {
+          mProxFinders.push_back(shared_ptr< prox_mesh_convex >(new prox_mesh_convex(ms_geom, other_geom)));
+        };
+      }
+      // if one of the model is a convex polytope?
+      else if((mModel1->mShapeList[i]->getObjectType() == convex_polytope::getStaticObjectType()) ||
+              (mModel2->mShapeList[j]->getObjectType() == convex_polytope::getStaticObjectType())) {
+        if(convex_support_3D::isSupported(*mModel1->mShapeList[i]) &&
+           convex_support_3D::isSupported(*mModel2->mShapeList[j]))
+          mProxFinders.push_back(shared_ptr< prox_convex_convex >(new prox_convex_convex(mModel1->mShapeList[i], mModel2->mShapeList[j])));
+      }
       // if one of the model is a plane?
-      if((mModel1->mShapeList[i]->getObjectType() == plane::getStaticObjectType()) ||
+      else if((mModel1->mShapeList[i]->getObjectType() == plane::getStaticObjectType()) ||
          (mModel2->mShapeList[j]->getObjectType() == plane::getStaticObjectType())) {
         shared_ptr<plane> pl_geom;
         shared_ptr<shape_3D> other_geom;
@@ -367,52 +417,171 @@ void proxy_query_pair_3D::createProxFinderList() {
           //mProxFinders.push_back(shared_ptr< prox_box_box >(new prox_box_box(bx_geom, bx2_geom)));
         };
       };
+      
+      if(mProxFinders.size() > prev_count) {
+        mFinderTable[i * mModel2->mShapeList.size() + j] = prev_count;
+        mFinderShapes.push_back(std::make_pair(i, j));
+        // the motion of a half-space is unbounded when it rotates.
+        mFinderCoherent.push_back((mModel1->mShapeList[i]->getObjectType() != plane::getStaticObjectType()) &&
+                                  (mModel2->mShapeList[j]->getObjectType() != plane::getStaticObjectType()));
+      };
     };
   };
   
+  resetCoherenceCache();
   return;
 };
 
+void proxy_query_pair_3D::resetCoherenceCache() const {
+  mCoherence.resize(mProxFinders.size());
+  for(std::size_t k = 0; k < mCoherence.size(); ++k)
+    mCoherence[k].valid = false;
+};
+
+
+namespace {
+
+/* Bounds the displacement of any point of a shape of a given radius (about its origin) between two global poses. */
+double get_shape_motion_bound(const proxy_bvh_3D::shape_frame& aFrom, const proxy_bvh_3D::shape_frame& aTo, double aRadius) {
+  double cos_half = std::fabs(aFrom.quat[0] * aTo.quat[0] + aFrom.quat[1] * aTo.quat[1] + 
+                              aFrom.quat[2] * aTo.quat[2] + aFrom.quat[3] * aTo.quat[3]);
+  double angle = (cos_half < 1.0 ? 2.0 * std::acos(cos_half) : 0.0);
+  return norm_2(aTo.position - aFrom.position) + angle * aRadius;
+};
+
+};
+
+double proxy_query_pair_3D::getCoherentLowerBound(std::size_t aFinder) const {
+  const coherence_record& rec = mCoherence[aFinder];
+  if(!rec.valid)
+    return -std::numeric_limits<double>::infinity();
+  std::size_t i = mFinderShapes[aFinder].first;
+  std::size_t j = mFinderShapes[aFinder].second;
+  return rec.distance 
+    - get_shape_motion_bound(rec.frame1, mBVH1.getShapeFrame(i), mModel1->mShapeList[i]->getBoundingRadius())
+    - get_shape_motion_bound(rec.frame2, mBVH2.getShapeFrame(j), mModel2->mShapeList[j]->getBoundingRadius());
+};
+
+void proxy_query_pair_3D::recordCoherence(std::size_t aFinder) const {
+  if(!mFinderCoherent[aFinder])
+    return;
+  coherence_record& rec = mCoherence[aFinder];
+  rec.distance = mProxFinders[aFinder]->getLastResult().mDistance;
+  rec.frame1 = mBVH1.getShapeFrame(mFinderShapes[aFinder].first);
+  rec.frame2 = mBVH2.getShapeFrame(mFinderShapes[aFinder].second);
+  rec.valid = true;
+};
+
 shared_ptr< proximity_finder_3D > proxy_query_pair_3D::findMinimumDistance() const {
-  if(mProxFinders.empty())
+  if(mProxFinders.empty() || mBVH1.empty() || mBVH2.empty())
     return shared_ptr< proximity_finder_3D >();
   
-  std::size_t min_i = 0;
-  mProxFinders[0]->computeProximity();
-  double min_dist = mProxFinders[0]->getLastResult().mDistance;
+  mBVH1.refit();
+  mBVH2.refit();
+  if(mThreadPool && (mThreadPool->size() > 1))
+    return findMinimumDistanceParallel();
+  const std::size_t n2 = mBVH2.getShapeCount();
   
-  for(std::size_t i = 1; i < mProxFinders.size(); ++i) {
+  std::size_t min_i = proxy_bvh_3D::npos;
+  double min_dist = std::numeric_limits<double>::infinity();
+  
+  mTraversalStack.clear();
+  mTraversalStack.push_back(std::make_pair(std::size_t(0), std::size_t(0)));
+  while(!mTraversalStack.empty()) {
+    std::size_t a = mTraversalStack.back().first;
+    std::size_t b = mTraversalStack.back().second;
+    mTraversalStack.pop_back();
     
-    vect<double,3> p1 = mProxFinders[i]->getShape1()->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
-    vect<double,3> p2 = mProxFinders[i]->getShape2()->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
-    if(norm_2(p2 - p1) - mProxFinders[i]->getShape1()->getBoundingRadius() 
-                       - mProxFinders[i]->getShape2()->getBoundingRadius() > min_dist)
+    const proxy_bvh_3D::node& na = mBVH1.getNode(a);
+    const proxy_bvh_3D::node& nb = mBVH2.getNode(b);
+    if(getAABBSeparation(na.box, nb.box) > min_dist)
       continue;
     
-    mProxFinders[i]->computeProximity();
-    if(min_dist > mProxFinders[i]->getLastResult().mDistance) {
-      min_i = i;
-      min_dist = mProxFinders[i]->getLastResult().mDistance;
+    if(na.isLeaf() && nb.isLeaf()) {
+      std::size_t k = mFinderTable[na.shape * n2 + nb.shape];
+      if((k == proxy_bvh_3D::npos) || (getCoherentLowerBound(k) > min_dist))
+        continue;
+      mProxFinders[k]->computeProximity();
+      recordCoherence(k);
+      double d = mProxFinders[k]->getLastResult().mDistance;
+      // ties go to the first finder, as in a plain linear scan.
+      if((d < min_dist) || ((d == min_dist) && (k < min_i))) {
+        min_i = k;
+        min_dist = d;
+      };
+      continue;
+    };
+    
+    // descend into the larger node, and visit the nearest child first (pushed last).
+    std::pair< std::size_t, std::size_t > c1, c2;
+    if(nb.isLeaf() || (!na.isLeaf() && (na.box.getSpan() >= nb.box.getSpan()))) {
+      c1 = std::make_pair(a + 1, b);
+      c2 = std::make_pair(na.second_child, b);
+    } else {
+      c1 = std::make_pair(a, b + 1);
+      c2 = std::make_pair(a, nb.second_child);
     };
+    if(getAABBSeparation(mBVH1.getNode(c1.first).box, mBVH2.getNode(c1.second).box) <
+       getAABBSeparation(mBVH1.getNode(c2.first).box, mBVH2.getNode(c2.second).box))
+      std::swap(c1, c2);
+    mTraversalStack.push_back(c1);
+    mTraversalStack.push_back(c2);
   };
   
+  if(min_i == proxy_bvh_3D::npos)
+    return shared_ptr< proximity_finder_3D >();
   return mProxFinders[min_i];
 };
     
 bool proxy_query_pair_3D::gatherCollisionPoints(std::vector< proximity_record_3D >& aOutput) const {
-  bool collision_found = false;
+  if(mProxFinders.empty() || mBVH1.empty() || mBVH2.empty())
+    return false;
   
-  for(std::size_t i = 0; i < mProxFinders.size(); ++i) {
+  mBVH1.refit();
+  mBVH2.refit();
+  const std::size_t n2 = mBVH2.getShapeCount();
+  
+  // collect the pairs whose boxes overlap.
+  mCandidates.clear();
+  mTraversalStack.clear();
+  mTraversalStack.push_back(std::make_pair(std::size_t(0), std::size_t(0)));
+  while(!mTraversalStack.empty()) {
+    std::size_t a = mTraversalStack.back().first;
+    std::size_t b = mTraversalStack.back().second;
+    mTraversalStack.pop_back();
     
-    vect<double,3> p1 = mProxFinders[i]->getShape1()->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
-    vect<double,3> p2 = mProxFinders[i]->getShape2()->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0));
-    if(norm_2(p2 - p1) - mProxFinders[i]->getShape1()->getBoundingRadius() 
-                       - mProxFinders[i]->getShape2()->getBoundingRadius() > 0.0)
+    const proxy_bvh_3D::node& na = mBVH1.getNode(a);
+    const proxy_bvh_3D::node& nb = mBVH2.getNode(b);
+    if(getAABBSeparation(na.box, nb.box) > 0.0)
       continue;
     
-    mProxFinders[i]->computeProximity();
-    if(mProxFinders[i]->getLastResult().mDistance < 0.0) {
-      aOutput.push_back(mProxFinders[i]->getLastResult());
+    if(na.isLeaf() && nb.isLeaf()) {
+      std::size_t k = mFinderTable[na.shape * n2 + nb.shape];
+      if(k != proxy_bvh_3D::npos)
+        mCandidates.push_back(k);
+    } else if(nb.isLeaf() || (!na.isLeaf() && (na.box.getSpan() >= nb.box.getSpan()))) {
+      mTraversalStack.push_back(std::make_pair(na.second_child, b));
+      mTraversalStack.push_back(std::make_pair(a + 1, b));
+    } else {
+      mTraversalStack.push_back(std::make_pair(a, nb.second_child));
+      mTraversalStack.push_back(std::make_pair(a, b + 1));
+    };
+  };
+  
+  // the records are reported in the order of the finders, regardless of the traversal order.
+  std::sort(mCandidates.begin(), mCandidates.end());
+  
+  if(mThreadPool && (mThreadPool->size() > 1))
+    return gatherCollisionPointsParallel(aOutput);
+  
+  bool collision_found = false;
+  for(std::size_t i = 0; i < mCandidates.size(); ++i) {
+    if(getCoherentLowerBound(mCandidates[i]) > 0.0)
+      continue;
+    mProxFinders[mCandidates[i]]->computeProximity();
+    recordCoherence(mCandidates[i]);
+    if(mProxFinders[mCandidates[i]]->getLastResult().mDistance < 0.0) {
+      aOutput.push_back(mProxFinders[mCandidates[i]]->getLastResult());
       collision_found = true;
     };
   };
@@ -421,6 +590,174 @@ bool proxy_query_pair_3D::gatherCollisionPoints(std::vector< proximity_record_3D
 };
 
 
+/* Evaluates the ranked candidates of one block (every block_count-th candidate, from the block_id-th), 
+ * and keeps the minimum of the block, while sharing the minimum of all blocks through the bound. */
+struct proxy_query_pair_3D::ranked_block_worker {
+  const proxy_query_pair_3D* parent;
+  ReaKaux::atomic< double >* bound;
+  std::size_t block_count;
+  
+  ranked_block_worker(const proxy_query_pair_3D* aParent, ReaKaux::atomic< double >* aBound, std::size_t aBlockCount) : 
+                      parent(aParent), bound(aBound), block_count(aBlockCount) { };
+  
+  void operator()(std::size_t aBlockId, std::size_t, std::size_t) const {
+    std::pair< double, std::size_t >& result = parent->mBlockResults[aBlockId];
+    result.first = std::numeric_limits<double>::infinity();
+    result.second = proxy_bvh_3D::npos;
+    for(std::size_t r = aBlockId; r < parent->mRankedCandidates.size(); r += block_count) {
+      // the candidates are sorted by lower-bound, so none of the remaining ones can be closer.
+      if(parent->mRankedCandidates[r].first > bound->load(ReaKaux::memory_order_relaxed))
+        break;
+      std::size_t k = parent->mRankedCandidates[r].second;
+      parent->mProxFinders[k]->computeProximity();
+      parent->recordCoherence(k);
+      double d = parent->mProxFinders[k]->getLastResult().mDistance;
+      if((d < result.first) || ((d == result.first) && (k < result.second))) {
+        result.first = d;
+        result.second = k;
+      };
+      double cur = bound->load(ReaKaux::memory_order_relaxed);
+      while((d < cur) && !bound->compare_exchange_weak(cur, d, ReaKaux::memory_order_relaxed)) { };
+    };
+  };
+};
+
+shared_ptr< proximity_finder_3D > proxy_query_pair_3D::findMinimumDistanceParallel() const {
+  
+  // rank all the finders by the lower-bound on their distance (from the boxes of their shapes, and from coherence).
+  mRankedCandidates.clear();
+  for(std::size_t k = 0; k < mProxFinders.size(); ++k) {
+    double lb = -std::numeric_limits<double>::infinity();
+    std::size_t na = mBVH1.getShapeNode(mFinderShapes[k].first);
+    std::size_t nb = mBVH2.getShapeNode(mFinderShapes[k].second);
+    if((na != proxy_bvh_3D::npos) && (nb != proxy_bvh_3D::npos))
+      lb = getAABBSeparation(mBVH1.getNode(na).box, mBVH2.getNode(nb).box);
+    lb = std::max(lb, getCoherentLowerBound(k));
+    mRankedCandidates.push_back(std::make_pair(lb, k));
+  };
+  std::sort(mRankedCandidates.begin(), mRankedCandidates.end());
+  
+  // a finder is only skipped if its lower-bound is strictly larger than a distance that was found, 
+  // so the finders that are tied for the minimum are always evaluated, whatever the scheduling.
+  ReaKaux::atomic< double > bound(std::numeric_limits<double>::infinity());
+  std::size_t blocks = mThreadPool->block_count(mRankedCandidates.size());
+  mBlockResults.resize(blocks);
+  mThreadPool->for_each_block(blocks, ranked_block_worker(this, &bound, blocks));
+  
+  std::size_t min_i = proxy_bvh_3D::npos;
+  double min_dist = std::numeric_limits<double>::infinity();
+  for(std::size_t i = 0; i < blocks; ++i) {
+    if((mBlockResults[i].first < min_dist) || 
+       ((mBlockResults[i].first == min_dist) && (mBlockResults[i].second < min_i))) {
+      min_dist = mBlockResults[i].first;
+      min_i = mBlockResults[i].second;
+    };
+  };
+  
+  if(min_i == proxy_bvh_3D::npos)
+    return shared_ptr< proximity_finder_3D >();
+  return mProxFinders[min_i];
+};
+
+
+/* Evaluates a contiguous range of the collision candidates, and flags those that are in collision. */
+struct proxy_query_pair_3D::candidate_block_worker {
+  const proxy_query_pair_3D* parent;
+  
+  explicit candidate_block_worker(const proxy_query_pair_3D* aParent) : parent(aParent) { };
+  
+  void operator()(std::size_t, std::size_t aFirst, std::size_t aLast) const {
+    for(std::size_t i = aFirst; i < aLast; ++i) {
+      std::size_t k = parent->mCandidates[i];
+      parent->mCandidateFlags[i] = 0;
+      if(parent->getCoherentLowerBound(k) > 0.0)
+        continue;
+      parent->mProxFinders[k]->computeProximity();
+      parent->recordCoherence(k);
+      if(parent->mProxFinders[k]->getLastResult().mDistance < 0.0)
+        parent->mCandidateFlags[i] = 1;
+    };
+  };
+};
+
+bool proxy_query_pair_3D::gatherCollisionPointsParallel(std::vector< proximity_record_3D >& aOutput) const {
+  mCandidateFlags.resize(mCandidates.size());
+  mThreadPool->for_each_block(mCandidates.size(), candidate_block_worker(this));
+  
+  // the records are appended serially, in the order of the finders.
+  bool collision_found = false;
+  for(std::size_t i = 0; i < mCandidates.size(); ++i) {
+    if(mCandidateFlags[i]) {
+      aOutput.push_back(mProxFinders[mCandidates[i]]->getLastResult());
+      collision_found = true;
+    };
+  };
+  
+  return collision_found;
+};
+
+
+namespace {
+
+struct rigid_frame_interpolator {
+  shared_ptr< pose_3D<double> > frame;
+  vect<double,3> start_pos;
+  vect<double,3> delta_pos;
+  quaternion<double> start_quat;
+  axis_angle<double> delta_rot;
+  
+  void operator()(double t) const {
+    frame->Position = start_pos + t * delta_pos;
+    frame->Quat = start_quat * axis_angle<double>(t * delta_rot.angle(), delta_rot.axis()).getQuaternion();
+  };
+};
+
+};
+
+double proxy_query_pair_3D::findFirstContact(const shared_ptr< pose_3D<double> >& aFrame, 
+                                             const pose_3D<double>& aStart, const pose_3D<double>& aEnd, 
+                                             double aTolerance, std::size_t aMaxIterations) const {
+  if(!aFrame)
+    return std::numeric_limits<double>::infinity();
+  
+  vect<double,3> saved_pos = aFrame->Position;
+  quaternion<double> saved_quat = aFrame->Quat;
+  
+  rigid_frame_interpolator interp;
+  interp.frame = aFrame;
+  interp.start_pos = aStart.Position;
+  interp.delta_pos = aEnd.Position - aStart.Position;
+  interp.start_quat = aStart.Quat;
+  interp.delta_rot = axis_angle<double>(invert(aStart.Quat) * aEnd.Quat);
+  interp(0.0);
+  
+  // the radius of the swept shapes about the frame's origin bounds the displacement due to the rotation.
+  vect<double,3> frame_origin = aFrame->transformToGlobal(vect<double,3>(0.0,0.0,0.0));
+  shared_ptr< const pose_3D<double> > frame_c = aFrame;
+  double max_radius = 0.0;
+  for(int m = 0; m < 2; ++m) {
+    const shared_ptr< proxy_query_model_3D >& model = (m == 0 ? mModel1 : mModel2);
+    if(!model)
+      continue;
+    for(std::size_t i = 0; i < model->mShapeList.size(); ++i) {
+      if((!model->mShapeList[i]) || (!model->mShapeList[i]->getPose().isParentPose(frame_c)))
+        continue;
+      double r = norm_2(model->mShapeList[i]->getPose().transformToGlobal(vect<double,3>(0.0,0.0,0.0)) - frame_origin)
+               + model->mShapeList[i]->getBoundingRadius();
+      if(r > max_radius)
+        max_radius = r;
+    };
+  };
+  double motion_bound = norm_2(interp.delta_pos) + std::fabs(interp.delta_rot.angle()) * max_radius;
+  
+  double result = findFirstContact(interp, motion_bound, aTolerance, aMaxIterations);
+  
+  aFrame->Position = saved_pos;
+  aFrame->Quat = saved_quat;
+  return result;
+};
+
+
 
 };
 
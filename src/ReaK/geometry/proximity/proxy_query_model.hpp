@@ -37,8 +37,12 @@
 #include <ReaK/geometry/shapes/shape_3D.hpp>
 #include "proximity_finder_2D.hpp"
 #include "proximity_finder_3D.hpp"
+#include "proxy_bvh_3D.hpp"
+
+#include <ReaK/core/base/thread_pool.hpp>
 
 #include <vector>
+#include <limits>
 
 /** Main namespace for ReaK */
 namespace ReaK {
@@ -192,7 +196,13 @@ class proxy_query_model_3D : public named_object {
 
 
 
-/** This class defines a proximity-query pair for 2D models. */
+/**
+ * This class defines a proximity-query pair for 3D models.
+ * \note This class is not reentrant: its queries are const, but they refit the bounding-volume hierarchies, 
+ *       record the temporal coherence, reuse scratch memory and update the last results of the proximity finders. 
+ *       A pair (and its models) must not be queried by several threads at once, use one pair per thread instead 
+ *       (see also setThreadPool() for the parallel evaluation of a single query).
+ */
 class proxy_query_pair_3D : public named_object {
   protected:
     
@@ -201,8 +211,45 @@ class proxy_query_pair_3D : public named_object {
     
     std::vector< shared_ptr< proximity_finder_3D > > mProxFinders;
     
+    /// Broad-phase hierarchies over the shapes of each model, refitted at each query.
+    mutable proxy_bvh_3D mBVH1;
+    mutable proxy_bvh_3D mBVH2;
+    /// Index of the proximity finder for each pair of shapes (i * n2 + j), or npos if there is none.
+    std::vector< std::size_t > mFinderTable;
+    /// Scratch memory for the dual-tree traversals, to avoid allocating at each query (this makes the queries non-reentrant).
+    mutable std::vector< std::pair< std::size_t, std::size_t > > mTraversalStack;
+    mutable std::vector< std::size_t > mCandidates;
+    
+    /** This POD type records the last distance computed by a proximity finder, with the global poses of its shapes at that time. */
+    struct coherence_record {
+      double distance;
+      bool valid;
+      proxy_bvh_3D::shape_frame frame1;
+      proxy_bvh_3D::shape_frame frame2;
+    };
+    /// Indices of the shapes (in each model) of each proximity finder, and whether their motion can be bounded (not for planes).
+    std::vector< std::pair< std::size_t, std::size_t > > mFinderShapes;
+    std::vector< bool > mFinderCoherent;
+    /// Last results of the proximity finders, used to skip the finders that cannot have come closer than needed.
+    mutable std::vector< coherence_record > mCoherence;
+    
+    /// Worker threads for the parallel evaluation of the proximity finders (serial evaluation if null).
+    shared_ptr< thread_pool > mThreadPool;
+    /// Scratch memory for the parallel evaluation: the (lower-bound, finder) pairs, the flags of colliding candidates and the per-block minimums.
+    mutable std::vector< std::pair< double, std::size_t > > mRankedCandidates;
+    mutable std::vector< char > mCandidateFlags;
+    mutable std::vector< std::pair< double, std::size_t > > mBlockResults;
+    
     void createProxFinderList();
     
+    double getCoherentLowerBound(std::size_t aFinder) const;
+    void recordCoherence(std::size_t aFinder) const;
+    
+    struct ranked_block_worker;
+    struct candidate_block_worker;
+    shared_ptr< proximity_finder_3D > findMinimumDistanceParallel() const;
+    bool gatherCollisionPointsParallel(std::vector< proximity_record_3D >& aOutput) const;
+    
   public:
     
     void setModelPair(const shared_ptr< proxy_query_model_3D >& aModel1, const shared_ptr< proxy_query_model_3D >& aModel2) {
@@ -211,13 +258,19 @@ class proxy_query_pair_3D : public named_object {
       createProxFinderList();
     };
     
+    const shared_ptr< proxy_query_model_3D >& getModel1() const { return mModel1; };
+    const shared_ptr< proxy_query_model_3D >& getModel2() const { return mModel2; };
+    
     /**
      * Default constructor.
      */
     proxy_query_pair_3D(const std::string& aName = "",
                         const shared_ptr< proxy_query_model_3D >& aModel1 = shared_ptr< proxy_query_model_3D >(), 
                         const shared_ptr< proxy_query_model_3D >& aModel2 = shared_ptr< proxy_query_model_3D >()) : 
-                        named_object(), mModel1(aModel1), mModel2(aModel2), mProxFinders() { 
+                        named_object(), mModel1(aModel1), mModel2(aModel2), mProxFinders(), 
+                        mBVH1(), mBVH2(), mFinderTable(), mTraversalStack(), mCandidates(), 
+                        mFinderShapes(), mFinderCoherent(), mCoherence(), mThreadPool(), 
+                        mRankedCandidates(), mCandidateFlags(), mBlockResults() { 
       this->setName(aName); 
       createProxFinderList();
     };
@@ -227,10 +280,100 @@ class proxy_query_pair_3D : public named_object {
      */
     virtual ~proxy_query_pair_3D() { };
     
+    /**
+     * Sets the thread pool used to evaluate the proximity finders in parallel. The finders are 
+     * then split across the worker threads, and the results are the same as for the serial evaluation 
+     * (except for the iterative finders that are warm-started, which can differ within their tolerance, 
+     * since the set of finders that get evaluated can change). 
+     * \param aThreadPool The thread pool to use, or null (or a pool with a single thread) for the serial evaluation.
+     * \note The shapes and their poses must not be modified while a query is running.
+     */
+    void setThreadPool(const shared_ptr< thread_pool >& aThreadPool) { mThreadPool = aThreadPool; };
+    
+    /**
+     * Returns the thread pool used to evaluate the proximity finders in parallel, if any.
+     */
+    const shared_ptr< thread_pool >& getThreadPool() const { return mThreadPool; };
+    
+    /**
+     * Finds the pair of shapes that are the closest to each other (or most penetrating). A dual-tree 
+     * traversal of the bounding-box hierarchies of both models is used to skip the pairs of shapes that 
+     * cannot be closer than the closest pair found so far. A pair of shapes is also skipped if its last 
+     * computed distance, minus the largest motion of its shapes since then, is still larger than that 
+     * (temporal coherence, see resetCoherenceCache()). With a thread pool (see setThreadPool()), the 
+     * pairs are instead sorted by these lower-bounds and evaluated by all the worker threads, which share 
+     * the closest distance found so far (atomically) to skip the pairs that cannot be closer.
+     * \return The proximity finder of the closest pair (with its last result up-to-date), or null if there is none. 
+     *         Ties are resolved in favor of the first finder, such that the result does not depend on the evaluation order.
+     */
     virtual shared_ptr< proximity_finder_3D > findMinimumDistance() const;
     
+    /**
+     * Collects the proximity records of all the pairs of shapes that are in collision. Only the pairs of shapes 
+     * whose bounding boxes overlap, and that have not been found far enough apart by a previous query (given 
+     * how much they moved since), are passed to their proximity finders. With a thread pool (see setThreadPool()), 
+     * these finders are evaluated by all the worker threads, and the records are still appended in the order of the finders.
+     * \param aOutput The vector to which the proximity records of the colliding pairs are appended.
+     * \return True if any collision was found.
+     */
     virtual bool gatherCollisionPoints(std::vector< proximity_record_3D >& aOutput) const;
     
+    /**
+     * Clears the last results recorded for the temporal coherence of the queries. This must be called 
+     * if the dimensions of any shape are changed (moving the shapes does not require this).
+     */
+    void resetCoherenceCache() const;
+    
+    /**
+     * Finds the first time of contact between the two models along a motion, by conservative advancement. 
+     * At each step, the minimum distance between the models is computed, and the time is advanced by the 
+     * largest step for which the models are guaranteed not to touch, given a bound on their relative motion.
+     * \tparam PoseSetter A callable type, as void(double), that moves the models to a given time (in [0,1]).
+     * \param aSetPoses The callable that moves the models to a given time, the models are left at the last time evaluated.
+     * \param aMotionBound An upper-bound on the distance travelled by any point of a model relative to the other, per unit of time.
+     * \param aTolerance The distance below which the models are considered to be in contact.
+     * \param aMaxIterations The maximum number of steps, after which the current time is returned as a conservative answer.
+     * \return The first time of contact in [0,1], or infinity if the models do not come into contact during the motion.
+     */
+    template <typename PoseSetter>
+    double findFirstContact(PoseSetter aSetPoses, double aMotionBound, 
+                            double aTolerance = 1e-4, std::size_t aMaxIterations = 1000) const {
+      double t = 0.0;
+      for(std::size_t i = 0; i < aMaxIterations; ++i) {
+        aSetPoses(t);
+        shared_ptr< proximity_finder_3D > tmp = findMinimumDistance();
+        if(!tmp)
+          return std::numeric_limits<double>::infinity();
+        double d = tmp->getLastResult().mDistance;
+        if(d < aTolerance)
+          return t;
+        if(aMotionBound <= 0.0)
+          return std::numeric_limits<double>::infinity();
+        if(t >= 1.0)
+          return std::numeric_limits<double>::infinity();
+        t += d / aMotionBound;
+        if(t > 1.0)
+          t = 1.0;
+      };
+      return t;
+    };
+    
+    /**
+     * Finds the first time of contact between the two models while a frame moves from one pose to 
+     * another (linear interpolation of the position, and constant-rate rotation about a fixed axis), 
+     * by conservative advancement. Any shape of either model that is attached to the frame is moved with it, 
+     * and the frame is restored to its current pose before returning.
+     * \param aFrame The frame that is moved.
+     * \param aStart The starting pose of the frame (relative to its parent).
+     * \param aEnd The final pose of the frame (relative to its parent).
+     * \param aTolerance The distance below which the models are considered to be in contact.
+     * \param aMaxIterations The maximum number of steps, after which the current time is returned as a conservative answer.
+     * \return The first time of contact in [0,1], or infinity if the models do not come into contact during the motion.
+     */
+    double findFirstContact(const shared_ptr< pose_3D<double> >& aFrame, 
+                            const pose_3D<double>& aStart, const pose_3D<double>& aEnd, 
+                            double aTolerance = 1e-4, std::size_t aMaxIterations = 1000) const;
+    
     
 /*******************************************************************************
                    ReaK's RTTI and Serialization interfaces
@@ -248,6 +391,8 @@ class proxy_query_pair_3D : public named_object {
       A & RK_SERIAL_LOAD_WITH_NAME(mModel1)
         & RK_SERIAL_LOAD_WITH_NAME(mModel2)
         & RK_SERIAL_LOAD_WITH_NAME(mProxFinders);
+      // the finders are rebuilt such that the broad-phase can index them.
+      createProxFinderList();
     };
 
     RK_RTTI_MAKE_CONCRETE_1BASE(proxy_query_pair_3D,0xC320001D,1,"proxy_query_pair_3D",named_object)
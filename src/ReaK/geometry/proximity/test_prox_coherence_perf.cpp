@@ -0,0 +1,200 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_query_model.hpp>
+#include <ReaK/geometry/proximity/prox_ccylinder_box.hpp>
+#include <ReaK/geometry/proximity/prox_convex_convex.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+
+#include <ReaK/core/base/chrono_incl.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+
+/*
+ * This program measures the effect of the temporal coherence of the proximity queries, over
+ * the trajectory of a three-link arm that moves among obstacles. The trajectory is recorded
+ * once (as the joint angles at each time-step), and then played back with the coherence cache
+ * of the proximity-query pair cleared at every step (cold), and with the cache kept (warm).
+ */
+
+using namespace ReaK;
+
+int main() {
+
+  using namespace ReaKaux::chrono;
+
+  const double pi = M_PI;
+  const std::size_t step_count = 5000;
+  const std::size_t pass_count = 5;
+
+  shared_ptr< pose_3D<double> > no_anchor;
+  quaternion<double> z_to_x = axis_angle<double>(0.5 * pi, vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+
+  // the arm: a base joint about z, then two joints about y, with a capped-cylinder on each link.
+  shared_ptr< pose_3D<double> > link1(new pose_3D<double>(no_anchor, vect<double,3>(0.0,0.0,0.3), quaternion<double>()));
+  shared_ptr< pose_3D<double> > link2(new pose_3D<double>(link1, vect<double,3>(0.6,0.0,0.0), quaternion<double>()));
+  shared_ptr< pose_3D<double> > link3(new pose_3D<double>(link2, vect<double,3>(0.5,0.0,0.0), quaternion<double>()));
+
+  shared_ptr< geom::proxy_query_model_3D > arm_model(new geom::proxy_query_model_3D("arm"));
+  arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("link1_geom", link1,
+    pose_3D<double>(no_anchor, vect<double,3>(0.3,0.0,0.0), z_to_x), 0.6, 0.06)));
+  shared_ptr< geom::capped_cylinder > link2_geom(new geom::capped_cylinder("link2_geom", link2,
+    pose_3D<double>(no_anchor, vect<double,3>(0.25,0.0,0.0), z_to_x), 0.5, 0.05));
+  arm_model->addShape(link2_geom);
+  arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("link3_geom", link3,
+    pose_3D<double>(no_anchor, vect<double,3>(0.1,0.0,0.0), z_to_x), 0.2, 0.04)));
+  arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("gripper_geom", link3,
+    pose_3D<double>(no_anchor, vect<double,3>(0.25,0.0,0.0), quaternion<double>()), vect<double,3>(0.1,0.12,0.04))));
+
+  // the environment: a table, a shelf, a pole, a ball and a wedge.
+  std::vector< vect<double,3> > wedge_verts;
+  wedge_verts.push_back(vect<double,3>(-0.1,-0.1,0.0));
+  wedge_verts.push_back(vect<double,3>( 0.1,-0.1,0.0));
+  wedge_verts.push_back(vect<double,3>(-0.1, 0.1,0.0));
+  wedge_verts.push_back(vect<double,3>( 0.1, 0.1,0.0));
+  wedge_verts.push_back(vect<double,3>(-0.1, 0.0,0.15));
+  wedge_verts.push_back(vect<double,3>( 0.1, 0.0,0.15));
+
+  shared_ptr< geom::proxy_query_model_3D > env_model(new geom::proxy_query_model_3D("environment"));
+  shared_ptr< geom::box > table_geom(new geom::box("table", no_anchor,
+    pose_3D<double>(no_anchor, vect<double,3>(0.8,0.0,-0.05), quaternion<double>()), vect<double,3>(0.8,1.6,0.1)));
+  env_model->addShape(table_geom);
+  env_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("shelf", no_anchor,
+    pose_3D<double>(no_anchor, vect<double,3>(0.0,0.9,0.6), quaternion<double>()), vect<double,3>(0.8,0.3,0.05))));
+  env_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("pole", no_anchor,
+    pose_3D<double>(no_anchor, vect<double,3>(-0.7,-0.5,0.5), quaternion<double>()), 1.0, 0.05)));
+  env_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball", no_anchor,
+    pose_3D<double>(no_anchor, vect<double,3>(0.9,-0.4,0.15), quaternion<double>()), 0.15)));
+  shared_ptr< geom::convex_polytope > wedge_geom(new geom::convex_polytope("wedge", no_anchor,
+    pose_3D<double>(no_anchor, vect<double,3>(0.6,0.4,0.0), quaternion<double>()), wedge_verts));
+  env_model->addShape(wedge_geom);
+
+  geom::proxy_query_pair_3D arm_env("arm_env", arm_model, env_model);
+
+  // record the trajectory (a smooth, non-periodic motion of the three joints).
+  std::vector< vect<double,3> > trajectory(step_count);
+  for(std::size_t i = 0; i < step_count; ++i) {
+    double t = 20.0 * double(i) / double(step_count);
+    trajectory[i] = vect<double,3>(1.5 * std::sin(0.37 * t),
+                                   0.4 + 0.5 * std::sin(0.61 * t + 0.3),
+                                   0.8 * std::sin(0.83 * t + 1.1));
+  };
+
+  try {
+
+    double cold_sum = 0.0;
+    double warm_sum = 0.0;
+    std::size_t mismatch_count = 0;
+    high_resolution_clock::duration dt_cold(0), dt_warm(0);
+
+    for(std::size_t pass = 0; pass < pass_count; ++pass) {
+      for(int warm = 0; warm < 2; ++warm) {
+        arm_env.resetCoherenceCache();
+        high_resolution_clock::time_point t1 = high_resolution_clock::now();
+        for(std::size_t i = 0; i < step_count; ++i) {
+          link1->Quat = axis_angle<double>(trajectory[i][0], vect<double,3>(0.0,0.0,1.0)).getQuaternion();
+          link2->Quat = axis_angle<double>(trajectory[i][1], vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+          link3->Quat = axis_angle<double>(trajectory[i][2], vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+          if(!warm)
+            arm_env.resetCoherenceCache();
+          shared_ptr< geom::proximity_finder_3D > closest = arm_env.findMinimumDistance();
+          double d = (closest ? closest->getLastResult().mDistance : 0.0);
+          if(warm) {
+            warm_sum += d;
+          } else {
+            cold_sum += d;
+          };
+        };
+        if(warm)
+          dt_warm += high_resolution_clock::now() - t1;
+        else
+          dt_cold += high_resolution_clock::now() - t1;
+      };
+    };
+
+    if(std::fabs(cold_sum - warm_sum) > 1e-4 * step_count * pass_count)
+      ++mismatch_count;
+
+    std::cout << "Minimum-distance queries along the arm trajectory (" << step_count << " steps, " << pass_count << " passes):" << std::endl;
+    std::cout << "  cold (no coherence cache): " << (duration_cast<nanoseconds>(dt_cold).count() / double(step_count * pass_count)) << " ns per query" << std::endl;
+    std::cout << "  warm (coherence cache):    " << (duration_cast<nanoseconds>(dt_warm).count() / double(step_count * pass_count)) << " ns per query" << std::endl;
+    std::cout << "  mean minimum distance, cold: " << (cold_sum / double(step_count * pass_count))
+              << ", warm: " << (warm_sum / double(step_count * pass_count)) << std::endl;
+
+    // the warm-starts of the iterative finders alone.
+    high_resolution_clock::duration dt_finders[4] = {high_resolution_clock::duration(0), high_resolution_clock::duration(0),
+                                                     high_resolution_clock::duration(0), high_resolution_clock::duration(0)};
+    geom::prox_ccylinder_box warm_cc_bx(link2_geom, table_geom);
+    geom::prox_convex_convex warm_cc_wd(link2_geom, wedge_geom);
+    for(std::size_t i = 0; i < step_count; ++i) {
+      link1->Quat = axis_angle<double>(trajectory[i][0], vect<double,3>(0.0,0.0,1.0)).getQuaternion();
+      link2->Quat = axis_angle<double>(trajectory[i][1], vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+      link3->Quat = axis_angle<double>(trajectory[i][2], vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+
+      high_resolution_clock::time_point t1 = high_resolution_clock::now();
+      geom::prox_ccylinder_box cold_cc_bx(link2_geom, table_geom);
+      cold_cc_bx.computeProximity();
+      dt_finders[0] += high_resolution_clock::now() - t1;
+
+      t1 = high_resolution_clock::now();
+      warm_cc_bx.computeProximity();
+      dt_finders[1] += high_resolution_clock::now() - t1;
+
+      t1 = high_resolution_clock::now();
+      geom::prox_convex_convex cold_cc_wd(link2_geom, wedge_geom);
+      cold_cc_wd.computeProximity();
+      dt_finders[2] += high_resolution_clock::now() - t1;
+
+      t1 = high_resolution_clock::now();
+      warm_cc_wd.computeProximity();
+      dt_finders[3] += high_resolution_clock::now() - t1;
+
+      if((std::fabs(cold_cc_bx.getLastResult().mDistance - warm_cc_bx.getLastResult().mDistance) > 1e-3) ||
+         (std::fabs(cold_cc_wd.getLastResult().mDistance - warm_cc_wd.getLastResult().mDistance) > 1e-6))
+        ++mismatch_count;
+    };
+    std::cout << "Proximity finders along the arm trajectory (ns per query, cold / warm-started):" << std::endl;
+    std::cout << "  ccylinder-box:    " << (duration_cast<nanoseconds>(dt_finders[0]).count() / double(step_count))
+              << " / " << (duration_cast<nanoseconds>(dt_finders[1]).count() / double(step_count)) << std::endl;
+    std::cout << "  ccylinder-wedge:  " << (duration_cast<nanoseconds>(dt_finders[2]).count() / double(step_count))
+              << " / " << (duration_cast<nanoseconds>(dt_finders[3]).count() / double(step_count)) << std::endl;
+
+    if(mismatch_count) {
+      std::cout << "The warm queries did not agree with the cold queries!" << std::endl;
+      return 1;
+    };
+
+  } catch(std::exception& e) {
+    std::cout << "An exception was raised during the benchmark: " << e.what() << std::endl;
+    return 1;
+  };
+
+  return 0;
+};
+
@@ -0,0 +1,175 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ReaK/geometry/proximity/proxy_query_model.hpp>
+#include <ReaK/geometry/proximity/proxy_compiled_model_3D.hpp>
+
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+
+#include <ReaK/core/base/chrono_incl.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+/*
+ * This program measures the collision checks of the compiled proximity models against those of the
+ * proximity-query pair, for a seven-link capsule arm among 30 boxes, at random configurations. The
+ * boxes are laid out sparsely (few collisions, most checks visit all the pairs) and densely (many
+ * collisions, most checks exit early), and every compiled check is compared to the proximity finders.
+ */
+
+using namespace ReaK;
+
+int main() {
+
+  using namespace ReaKaux::chrono;
+
+  const double pi = M_PI;
+  const std::size_t link_count = 7;
+  const std::size_t box_count = 30;
+  const std::size_t config_count = 20000;
+
+  shared_ptr< pose_3D<double> > no_anchor;
+  quaternion<double> z_to_x = axis_angle<double>(0.5 * pi, vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+
+  // the arm: joints alternating about z and about y, with a capsule on each link.
+  std::vector< shared_ptr< pose_3D<double> > > links;
+  shared_ptr< geom::proxy_query_model_3D > arm_model(new geom::proxy_query_model_3D("arm"));
+  for(std::size_t i = 0; i < link_count; ++i) {
+    links.push_back(shared_ptr< pose_3D<double> >(new pose_3D<double>(
+      (i == 0 ? no_anchor : links.back()), (i == 0 ? vect<double,3>(0.0,0.0,0.3) : vect<double,3>(0.25,0.0,0.0)), quaternion<double>())));
+    arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("link_geom", links.back(),
+      pose_3D<double>(no_anchor, vect<double,3>(0.125,0.0,0.0), z_to_x), 0.25, 0.04)));
+  };
+
+  // the random joint angles, and the corresponding global transforms of the links.
+  std::vector< vect<double,link_count> > configs(config_count);
+  std::vector< geom::proxy_rigid_transform_3D > link_transforms(config_count * link_count);
+  for(std::size_t i = 0; i < config_count; ++i) {
+    for(std::size_t j = 0; j < link_count; ++j) {
+      configs[i][j] = pi * (2.0 * std::rand() / double(RAND_MAX) - 1.0);
+      links[j]->Quat = axis_angle<double>(configs[i][j], (j % 2 == 0 ? vect<double,3>(0.0,0.0,1.0) : vect<double,3>(0.0,1.0,0.0))).getQuaternion();
+    };
+    for(std::size_t j = 0; j < link_count; ++j)
+      link_transforms[i * link_count + j] = geom::proxy_rigid_transform_3D::fromPose(links[j]->getGlobalPose());
+  };
+
+  const char* scene_names[2] = {"sparse", "dense"};
+  const double box_sizes[2] = {0.08, 0.3};
+  std::size_t mismatch_count = 0;
+
+  try {
+
+    for(std::size_t scene = 0; scene < 2; ++scene) {
+
+      // the boxes, scattered in the reach of the arm (but away from its base).
+      shared_ptr< geom::proxy_query_model_3D > env_model(new geom::proxy_query_model_3D("environment"));
+      for(std::size_t i = 0; i < box_count; ++i) {
+        double a = 2.0 * pi * std::rand() / double(RAND_MAX);
+        double r = 0.5 + 1.2 * std::rand() / double(RAND_MAX);
+        double h = 1.6 * std::rand() / double(RAND_MAX) - 0.5;
+        env_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("crate", no_anchor,
+          pose_3D<double>(no_anchor, vect<double,3>(r * std::cos(a), r * std::sin(a), h),
+                          axis_angle<double>(a, vect<double,3>(0.0,0.0,1.0)).getQuaternion()),
+          vect<double,3>(box_sizes[scene], box_sizes[scene], 1.5 * box_sizes[scene]))));
+      };
+
+      geom::proxy_query_pair_3D arm_env("arm_env", arm_model, env_model);
+      geom::proxy_compiled_pair_3D compiled(arm_env);
+
+      high_resolution_clock::duration dt_min_dist(0), dt_gather(0), dt_compiled(0), dt_batch(0);
+      std::vector< geom::proximity_record_3D > records;
+      std::vector< char > expected(config_count);
+      std::size_t collision_count = 0;
+      for(std::size_t i = 0; i < config_count; ++i) {
+        for(std::size_t j = 0; j < link_count; ++j)
+          links[j]->Quat = axis_angle<double>(configs[i][j], (j % 2 == 0 ? vect<double,3>(0.0,0.0,1.0) : vect<double,3>(0.0,1.0,0.0))).getQuaternion();
+
+        high_resolution_clock::time_point t1 = high_resolution_clock::now();
+        shared_ptr< geom::proximity_finder_3D > closest = arm_env.findMinimumDistance();
+        dt_min_dist += high_resolution_clock::now() - t1;
+        double d = (closest ? closest->getLastResult().mDistance : 1.0);
+
+        records.clear();
+        t1 = high_resolution_clock::now();
+        expected[i] = arm_env.gatherCollisionPoints(records);
+        dt_gather += high_resolution_clock::now() - t1;
+
+        t1 = high_resolution_clock::now();
+        compiled.updateFromPoses();
+        bool result = compiled.checkCollision();
+        dt_compiled += high_resolution_clock::now() - t1;
+
+        if(expected[i])
+          ++collision_count;
+        // configurations within the tolerance of the iterative finders are not counted as mismatches.
+        if((bool(expected[i]) != result) && (std::fabs(d) > 1e-4))
+          ++mismatch_count;
+      };
+
+      std::vector< char > results;
+      high_resolution_clock::time_point t1 = high_resolution_clock::now();
+      compiled.checkCollisionBatch(link_transforms, results);
+      dt_batch += high_resolution_clock::now() - t1;
+      for(std::size_t i = 0; i < config_count; ++i) {
+        compiled.updateFromPoses();
+        if(bool(results[i]) != bool(expected[i])) {
+          for(std::size_t j = 0; j < link_count; ++j)
+            links[j]->Quat = axis_angle<double>(configs[i][j], (j % 2 == 0 ? vect<double,3>(0.0,0.0,1.0) : vect<double,3>(0.0,1.0,0.0))).getQuaternion();
+          shared_ptr< geom::proximity_finder_3D > closest = arm_env.findMinimumDistance();
+          if(!closest || (std::fabs(closest->getLastResult().mDistance) > 1e-4))
+            ++mismatch_count;
+        };
+      };
+
+      double t_min_dist = duration_cast<nanoseconds>(dt_min_dist).count() / double(config_count);
+      double t_gather = duration_cast<nanoseconds>(dt_gather).count() / double(config_count);
+      double t_compiled = duration_cast<nanoseconds>(dt_compiled).count() / double(config_count);
+      double t_batch = duration_cast<nanoseconds>(dt_batch).count() / double(config_count);
+      std::cout << "Collision checks of the " << scene_names[scene] << " scene (" << config_count << " configurations, "
+                << (100.0 * collision_count / double(config_count)) << "% in collision, " << compiled.getPairCount() << " pairs):" << std::endl;
+      std::cout << "  findMinimumDistance:         " << t_min_dist << " ns per query" << std::endl;
+      std::cout << "  gatherCollisionPoints:       " << t_gather << " ns per query" << std::endl;
+      std::cout << "  compiled checkCollision:     " << t_compiled << " ns per query (x" << (t_min_dist / t_compiled)
+                << " vs. minimum-distance, x" << (t_gather / t_compiled) << " vs. gather)" << std::endl;
+      std::cout << "  compiled checkCollisionBatch: " << t_batch << " ns per query (x" << (t_min_dist / t_batch)
+                << " vs. minimum-distance, x" << (t_gather / t_batch) << " vs. gather)" << std::endl;
+    };
+
+    if(mismatch_count) {
+      std::cout << "The compiled checks did not agree with the proximity finders (" << mismatch_count << " mismatches)!" << std::endl;
+      return 1;
+    };
+
+  } catch(std::exception& e) {
+    std::cout << "An exception was raised during the benchmark: " << e.what() << std::endl;
+    return 1;
+  };
+
+  return 0;
+};
+
@@ -0,0 +1,249 @@
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/prox_gjk_epa.hpp>
+#include <ReaK/geometry/proximity/prox_sphere_sphere.hpp>
+#include <ReaK/geometry/proximity/prox_sphere_box.hpp>
+#include <ReaK/geometry/proximity/prox_sphere_ccylinder.hpp>
+#include <ReaK/geometry/proximity/prox_ccylinder_ccylinder.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE prox_gjk_epa
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+static const double test_tolerance = 1e-6;
+
+
+static double random_number(double aLow, double aHigh) {
+  return aLow + (aHigh - aLow) * (std::rand() / double(RAND_MAX));
+};
+
+static vect<double,3> random_vector(double aLow, double aHigh) {
+  return vect<double,3>(random_number(aLow, aHigh), random_number(aLow, aHigh), random_number(aLow, aHigh));
+};
+
+static vect<double,3> random_unit_vector() {
+  vect<double,3> v = random_vector(-1.0, 1.0);
+  while(norm_2(v) < 0.1)
+    v = random_vector(-1.0, 1.0);
+  return unit(v);
+};
+
+static quaternion<double> random_rotation() {
+  return axis_angle<double>(random_number(-M_PI, M_PI), random_unit_vector()).getQuaternion();
+};
+
+static pose_3D<double> random_pose(double aSpread) {
+  return pose_3D<double>(shared_ptr< pose_3D<double> >(), random_vector(-aSpread, aSpread), random_rotation());
+};
+
+
+/*
+ * Checks GJK/EPA against the analytic proximity finder of the same shapes. The distances (or penetration
+ * depths) must match, the points must realize that distance, and if the closest points are unique
+ * (aUniquePoints), they must match as well. Returns the analytic distance.
+ */
+static double check_against_analytic(geom::proximity_finder_3D& aFinder, bool aUniquePoints) {
+  aFinder.computeProximity();
+  const geom::proximity_record_3D& expected = aFinder.getLastResult();
+
+  geom::proximity_record_3D result = geom::findProximityGJKEPA(
+    geom::convex_support_3D(*aFinder.getShape1()), geom::convex_support_3D(*aFinder.getShape2()));
+
+  BOOST_CHECK_SMALL( result.mDistance - expected.mDistance, test_tolerance );
+  BOOST_CHECK_SMALL( norm_2(result.mPoint2 - result.mPoint1) - std::fabs(result.mDistance), test_tolerance );
+  if(aUniquePoints) {
+    BOOST_CHECK_SMALL( norm_2(result.mPoint1 - expected.mPoint1), test_tolerance );
+    BOOST_CHECK_SMALL( norm_2(result.mPoint2 - expected.mPoint2), test_tolerance );
+  };
+
+  return expected.mDistance;
+};
+
+
+BOOST_AUTO_TEST_CASE( gjk_epa_separated_test )
+{
+  std::srand(42);
+  std::size_t separated_count = 0;
+  for(std::size_t i = 0; i < 500; ++i) {
+    shared_ptr< geom::sphere > sp1(new geom::sphere("sphere1", shared_ptr< pose_3D<double> >(), random_pose(2.0), random_number(0.1, 0.5)));
+    shared_ptr< geom::sphere > sp2(new geom::sphere("sphere2", shared_ptr< pose_3D<double> >(), random_pose(2.0), random_number(0.1, 0.5)));
+    shared_ptr< geom::box > bx(new geom::box("box", shared_ptr< pose_3D<double> >(), random_pose(2.0), random_vector(0.2, 1.0)));
+    shared_ptr< geom::capped_cylinder > cc1(new geom::capped_cylinder("ccylinder1", shared_ptr< pose_3D<double> >(), random_pose(2.0), random_number(0.2, 1.0), random_number(0.05, 0.3)));
+    shared_ptr< geom::capped_cylinder > cc2(new geom::capped_cylinder("ccylinder2", shared_ptr< pose_3D<double> >(), random_pose(2.0), random_number(0.2, 1.0), random_number(0.05, 0.3)));
+
+    geom::prox_sphere_sphere sp_sp(sp1, sp2);
+    geom::prox_sphere_box sp_bx(sp1, bx);
+    geom::prox_sphere_ccylinder sp_cc(sp1, cc1);
+    geom::prox_ccylinder_ccylinder cc_cc(cc1, cc2);
+
+    // only the separated configurations are of interest here (the others are covered below).
+    sp_sp.computeProximity();
+    if(sp_sp.getLastResult().mDistance > 1e-3) {
+      check_against_analytic(sp_sp, true);
+      ++separated_count;
+    };
+    sp_bx.computeProximity();
+    if(sp_bx.getLastResult().mDistance > 1e-3)
+      check_against_analytic(sp_bx, true);
+    sp_cc.computeProximity();
+    if(sp_cc.getLastResult().mDistance > 1e-3)
+      check_against_analytic(sp_cc, true);
+    cc_cc.computeProximity();
+    if(cc_cc.getLastResult().mDistance > 1e-3)
+      check_against_analytic(cc_cc, false);
+  };
+  BOOST_CHECK( separated_count > 100 );
+};
+
+
+BOOST_AUTO_TEST_CASE( gjk_epa_touching_test )
+{
+  std::srand(43);
+  for(std::size_t i = 0; i < 200; ++i) {
+    // two spheres in contact at a single point.
+    pose_3D<double> p1 = random_pose(1.0);
+    double r1 = random_number(0.1, 0.5);
+    double r2 = random_number(0.1, 0.5);
+    pose_3D<double> p2(shared_ptr< pose_3D<double> >(), p1.Position + (r1 + r2) * random_unit_vector(), random_rotation());
+    shared_ptr< geom::sphere > sp1(new geom::sphere("sphere1", shared_ptr< pose_3D<double> >(), p1, r1));
+    shared_ptr< geom::sphere > sp2(new geom::sphere("sphere2", shared_ptr< pose_3D<double> >(), p2, r2));
+    geom::prox_sphere_sphere sp_sp(sp1, sp2);
+    BOOST_CHECK_SMALL( check_against_analytic(sp_sp, false), test_tolerance );
+
+    // a sphere resting on a face of a box.
+    pose_3D<double> pb = random_pose(1.0);
+    vect<double,3> dims = random_vector(0.2, 1.0);
+    vect<double,3> on_face(random_number(-0.4, 0.4) * dims[0], random_number(-0.4, 0.4) * dims[1], 0.5 * dims[2] + r1);
+    shared_ptr< geom::box > bx(new geom::box("box", shared_ptr< pose_3D<double> >(), pb, dims));
+    shared_ptr< geom::sphere > sp3(new geom::sphere("sphere3", shared_ptr< pose_3D<double> >(),
+      pose_3D<double>(shared_ptr< pose_3D<double> >(), pb.transformToGlobal(on_face), quaternion<double>()), r1));
+    geom::prox_sphere_box sp_bx(sp3, bx);
+    BOOST_CHECK_SMALL( check_against_analytic(sp_bx, false), test_tolerance );
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( gjk_epa_penetrating_test )
+{
+  std::srand(44);
+  for(std::size_t i = 0; i < 200; ++i) {
+    pose_3D<double> p1 = random_pose(1.0);
+    double r1 = random_number(0.2, 0.5);
+    double r2 = random_number(0.2, 0.5);
+
+    // two overlapping spheres (but with distinct centers, for a unique direction of penetration).
+    pose_3D<double> p2(shared_ptr< pose_3D<double> >(), p1.Position + random_number(0.2, 0.9) * (r1 + r2) * random_unit_vector(), random_rotation());
+    shared_ptr< geom::sphere > sp1(new geom::sphere("sphere1", shared_ptr< pose_3D<double> >(), p1, r1));
+    shared_ptr< geom::sphere > sp2(new geom::sphere("sphere2", shared_ptr< pose_3D<double> >(), p2, r2));
+    geom::prox_sphere_sphere sp_sp(sp1, sp2);
+    BOOST_CHECK( check_against_analytic(sp_sp, true) < 0.0 );
+
+    // a sphere sunk into a face of a box, with its center outside the box.
+    pose_3D<double> pb = random_pose(1.0);
+    vect<double,3> dims = random_vector(0.4, 1.0);
+    vect<double,3> sunk(random_number(-0.3, 0.3) * dims[0], random_number(-0.3, 0.3) * dims[1], 0.5 * dims[2] + random_number(0.2, 0.8) * r1);
+    shared_ptr< geom::box > bx(new geom::box("box", shared_ptr< pose_3D<double> >(), pb, dims));
+    shared_ptr< geom::sphere > sp3(new geom::sphere("sphere3", shared_ptr< pose_3D<double> >(),
+      pose_3D<double>(shared_ptr< pose_3D<double> >(), pb.transformToGlobal(sunk), quaternion<double>()), r1));
+    geom::prox_sphere_box sp_bx(sp3, bx);
+    BOOST_CHECK( check_against_analytic(sp_bx, true) < 0.0 );
+
+    // two crossing capped-cylinders.
+    shared_ptr< geom::capped_cylinder > cc1(new geom::capped_cylinder("ccylinder1", shared_ptr< pose_3D<double> >(), p1, 1.0, r1));
+    pose_3D<double> pc(shared_ptr< pose_3D<double> >(), p1.transformToGlobal(random_vector(-0.2, 0.2)), random_rotation());
+    shared_ptr< geom::capped_cylinder > cc2(new geom::capped_cylinder("ccylinder2", shared_ptr< pose_3D<double> >(), pc, 1.0, r2));
+    geom::prox_ccylinder_ccylinder cc_cc(cc1, cc2);
+    BOOST_CHECK( check_against_analytic(cc_cc, false) < 0.0 );
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( gjk_epa_degenerate_test )
+{
+  std::srand(45);
+  for(std::size_t i = 0; i < 200; ++i) {
+    pose_3D<double> pp = random_pose(1.0);
+    double r = random_number(0.1, 0.5);
+
+    // collinear vertices (with a repeated and an interior vertex), compared to a capped-cylinder of zero radius.
+    double len = random_number(0.2, 1.0);
+    std::vector< vect<double,3> > segment_pts;
+    segment_pts.push_back(vect<double,3>(0.0, 0.0, -0.5 * len));
+    segment_pts.push_back(vect<double,3>(0.0, 0.0, 0.1 * len));
+    segment_pts.push_back(vect<double,3>(0.0, 0.0, 0.5 * len));
+    segment_pts.push_back(vect<double,3>(0.0, 0.0, 0.5 * len));
+    shared_ptr< geom::convex_polytope > segment(new geom::convex_polytope("segment", shared_ptr< pose_3D<double> >(), pp, segment_pts));
+    shared_ptr< geom::capped_cylinder > line(new geom::capped_cylinder("line", shared_ptr< pose_3D<double> >(), pp, len, 0.0));
+
+    // coplanar vertices (a square, with its center), compared to a box of zero thickness.
+    double side = random_number(0.2, 1.0);
+    std::vector< vect<double,3> > square_pts;
+    square_pts.push_back(vect<double,3>(-0.5 * side, -0.5 * side, 0.0));
+    square_pts.push_back(vect<double,3>( 0.5 * side, -0.5 * side, 0.0));
+    square_pts.push_back(vect<double,3>( 0.5 * side,  0.5 * side, 0.0));
+    square_pts.push_back(vect<double,3>(-0.5 * side,  0.5 * side, 0.0));
+    square_pts.push_back(vect<double,3>(0.0, 0.0, 0.0));
+    shared_ptr< geom::convex_polytope > square(new geom::convex_polytope("square", shared_ptr< pose_3D<double> >(), pp, square_pts));
+    shared_ptr< geom::box > flat_box(new geom::box("flat_box", shared_ptr< pose_3D<double> >(), pp, vect<double,3>(side, side, 0.0)));
+
+    // spheres around them, separated, touching and penetrating (with the center off the segment or square).
+    double gaps[3] = { random_number(0.05, 0.5), 0.0, -random_number(0.2, 0.8) * r };
+    for(std::size_t j = 0; j < 3; ++j) {
+      vect<double,3> radial = unit(vect<double,3>(random_number(-1.0, 1.0), random_number(-1.0, 1.0), 0.0));
+      vect<double,3> c_seg = random_number(-0.4, 0.4) * len * vect<double,3>(0.0,0.0,1.0) + (r + gaps[j]) * radial;
+      shared_ptr< geom::sphere > sp_seg(new geom::sphere("sphere_seg", shared_ptr< pose_3D<double> >(),
+        pose_3D<double>(shared_ptr< pose_3D<double> >(), pp.transformToGlobal(c_seg), quaternion<double>()), r));
+
+      geom::prox_sphere_ccylinder sp_line(sp_seg, line);
+      sp_line.computeProximity();
+      geom::proximity_record_3D seg_result = geom::findProximityGJKEPA(geom::convex_support_3D(*sp_seg), geom::convex_support_3D(*segment));
+      BOOST_CHECK_SMALL( seg_result.mDistance - sp_line.getLastResult().mDistance, test_tolerance );
+      BOOST_CHECK_SMALL( seg_result.mDistance - gaps[j], test_tolerance );
+
+      vect<double,3> c_sq(random_number(-0.4, 0.4) * side, random_number(-0.4, 0.4) * side, r + gaps[j]);
+      shared_ptr< geom::sphere > sp_sq(new geom::sphere("sphere_sq", shared_ptr< pose_3D<double> >(),
+        pose_3D<double>(shared_ptr< pose_3D<double> >(), pp.transformToGlobal(c_sq), quaternion<double>()), r));
+
+      geom::prox_sphere_box sp_flat(sp_sq, flat_box);
+      sp_flat.computeProximity();
+      geom::proximity_record_3D sq_result = geom::findProximityGJKEPA(geom::convex_support_3D(*sp_sq), geom::convex_support_3D(*square));
+      BOOST_CHECK_SMALL( sq_result.mDistance - sp_flat.getLastResult().mDistance, test_tolerance );
+      BOOST_CHECK_SMALL( sq_result.mDistance - gaps[j], test_tolerance );
+    };
+  };
+};
+
+
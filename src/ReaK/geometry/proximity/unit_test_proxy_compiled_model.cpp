@@ -0,0 +1,184 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_compiled_model_3D.hpp>
+#include <ReaK/geometry/proximity/proxy_query_model.hpp>
+
+#include <ReaK/geometry/shapes/plane.hpp>
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE proxy_compiled_model
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+
+/* A seven-link arm of capsules, with a ball and a box at its end, among boxes, balls, a pole and a floor. */
+struct compiled_model_fixture {
+  shared_ptr< pose_3D<double> > no_anchor;
+  std::vector< shared_ptr< pose_3D<double> > > links;
+  shared_ptr< geom::proxy_query_model_3D > arm_model;
+  shared_ptr< geom::proxy_query_model_3D > env_model;
+  shared_ptr< geom::proxy_query_pair_3D > arm_env;
+  std::vector< geom::proximity_record_3D > records;
+  
+  compiled_model_fixture() : no_anchor() {
+    const double pi = M_PI;
+    quaternion<double> z_to_x = axis_angle<double>(0.5 * pi, vect<double,3>(0.0,1.0,0.0)).getQuaternion();
+    
+    arm_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("arm"));
+    for(std::size_t i = 0; i < 7; ++i) {
+      links.push_back(shared_ptr< pose_3D<double> >(new pose_3D<double>(
+        (i == 0 ? no_anchor : links.back()), (i == 0 ? vect<double,3>(0.0,0.0,0.3) : vect<double,3>(0.3,0.0,0.0)), quaternion<double>())));
+      arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("link_geom", links.back(),
+        pose_3D<double>(no_anchor, vect<double,3>(0.15,0.0,0.0), z_to_x), 0.3, 0.04)));
+    };
+    arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball_geom", links.back(),
+      pose_3D<double>(no_anchor, vect<double,3>(0.3,0.0,0.0), quaternion<double>()), 0.06)));
+    arm_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("gripper_geom", links.back(),
+      pose_3D<double>(no_anchor, vect<double,3>(0.4,0.0,0.0), axis_angle<double>(0.3, vect<double,3>(1.0,0.0,0.0)).getQuaternion()), 
+      vect<double,3>(0.1,0.12,0.04))));
+    
+    env_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("environment"));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::plane("floor", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(0.0,0.0,-0.2), quaternion<double>()), vect<double,2>(4.0,4.0))));
+    for(std::size_t i = 0; i < 12; ++i) {
+      double a = 2.0 * pi * double(i) / 12.0;
+      env_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("crate", no_anchor,
+        pose_3D<double>(no_anchor, vect<double,3>(1.1 * std::cos(a), 1.1 * std::sin(a), 0.1 + 0.1 * double(i % 4)), 
+                        axis_angle<double>(a + 0.2 * double(i % 3), vect<double,3>(0.3,0.2,1.0)).getQuaternion()), 
+        vect<double,3>(0.2 + 0.02 * double(i % 5), 0.15, 0.3))));
+    };
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(0.5,0.6,0.8), quaternion<double>()), 0.15)));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(-0.6,-0.2,1.0), quaternion<double>()), 0.1)));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("pole", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(-0.4,0.7,0.5), quaternion<double>()), 1.0, 0.05)));
+    
+    arm_env = shared_ptr< geom::proxy_query_pair_3D >(new geom::proxy_query_pair_3D("arm_env", arm_model, env_model));
+  };
+  
+  /* Sets random joint angles, alternating between joints about z and about y. */
+  void setRandomConfiguration() {
+    for(std::size_t i = 0; i < links.size(); ++i) {
+      double q = M_PI * (2.0 * std::rand() / double(RAND_MAX) - 1.0);
+      links[i]->Quat = axis_angle<double>(q, (i % 2 == 0 ? vect<double,3>(0.0,0.0,1.0) : vect<double,3>(0.0,1.0,0.0))).getQuaternion();
+    };
+  };
+  
+  /* Checks for a collision with the proximity finders. Returns false if the configuration is too close to contact to be decided. */
+  bool getReferenceCollision(bool& aCollision) {
+    shared_ptr< geom::proximity_finder_3D > closest = arm_env->findMinimumDistance();
+    if(closest && (std::fabs(closest->getLastResult().mDistance) < 1e-3))
+      return false;
+    records.clear();
+    aCollision = arm_env->gatherCollisionPoints(records);
+    return true;
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( compiled_model_structure_test )
+{
+  compiled_model_fixture f;
+  geom::proxy_compiled_pair_3D compiled(*f.arm_env);
+  BOOST_CHECK_EQUAL( compiled.getModel1().getPrimitiveCount(), 9 );
+  BOOST_CHECK_EQUAL( compiled.getModel1().getLinkCount(), 7 );
+  BOOST_CHECK_EQUAL( compiled.getModel2().getPrimitiveCount(), 16 );
+  BOOST_CHECK_EQUAL( compiled.getModel2().getLinkCount(), 0 );
+  // all pairs but gripper-crate (box-box, which has no proximity finder either).
+  BOOST_CHECK_EQUAL( compiled.getPairCount(), 9 * 16 - 12 );
+  for(std::size_t i = 0; i < compiled.getModel1().getLinkCount(); ++i)
+    BOOST_CHECK( compiled.getModel1().getLinkPose(i) == f.links[i] );
+};
+
+
+BOOST_AUTO_TEST_CASE( compiled_model_check_collision_test )
+{
+  compiled_model_fixture f;
+  geom::proxy_compiled_pair_3D compiled(*f.arm_env);
+  std::size_t collision_count = 0;
+  std::size_t free_count = 0;
+  for(std::size_t i = 0; i < 2000; ++i) {
+    f.setRandomConfiguration();
+    bool expected = false;
+    if(!f.getReferenceCollision(expected))
+      continue;
+    compiled.updateFromPoses();
+    BOOST_CHECK_EQUAL( compiled.checkCollision(), expected );
+    if(expected)
+      ++collision_count;
+    else
+      ++free_count;
+  };
+  // the random configurations must exercise both outcomes.
+  BOOST_CHECK( collision_count > 100 );
+  BOOST_CHECK( free_count > 100 );
+};
+
+
+BOOST_AUTO_TEST_CASE( compiled_model_check_collision_batch_test )
+{
+  compiled_model_fixture f;
+  geom::proxy_compiled_pair_3D compiled(*f.arm_env);
+  const std::size_t link_count = compiled.getModel1().getLinkCount();
+  
+  std::vector< geom::proxy_rigid_transform_3D > configs;
+  std::vector< char > expected;
+  std::size_t expected_count = 0;
+  for(std::size_t i = 0; i < 2000; ++i) {
+    f.setRandomConfiguration();
+    bool collision = false;
+    if(!f.getReferenceCollision(collision))
+      continue;
+    for(std::size_t j = 0; j < link_count; ++j)
+      configs.push_back(geom::proxy_rigid_transform_3D::fromPose(compiled.getModel1().getLinkPose(j)->getGlobalPose()));
+    expected.push_back(collision);
+    if(collision)
+      ++expected_count;
+  };
+  
+  std::vector< char > results;
+  BOOST_CHECK_EQUAL( compiled.checkCollisionBatch(configs, results), expected_count );
+  BOOST_REQUIRE_EQUAL( results.size(), expected.size() );
+  for(std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_CHECK_EQUAL( bool(results[i]), bool(expected[i]) );
+  
+  bool* flags = new bool[expected.size()];
+  BOOST_CHECK_EQUAL( compiled.checkCollisionBatch(&configs[0], expected.size(), flags), expected_count );
+  for(std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_CHECK_EQUAL( flags[i], bool(expected[i]) );
+  delete[] flags;
+};
+
+
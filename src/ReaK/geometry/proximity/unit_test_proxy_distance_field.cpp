@@ -0,0 +1,138 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_distance_field_3D.hpp>
+#include <ReaK/geometry/proximity/proxy_query_model.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+
+#include <cmath>
+#include <cstdlib>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE proxy_distance_field
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+
+/* Obstacles in the unit cube about the origin, with a distance field over a slightly larger grid, and a probe sphere. */
+struct distance_field_fixture {
+  shared_ptr< pose_3D<double> > no_anchor;
+  shared_ptr< geom::proxy_query_model_3D > env_model;
+  shared_ptr< geom::grid_3D > grid;
+  shared_ptr< geom::proxy_distance_field_3D > field;
+  shared_ptr< geom::sphere > probe;
+  shared_ptr< geom::proxy_query_pair_3D > probe_pair;
+  
+  distance_field_fixture() : no_anchor() {
+    env_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("environment"));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("box", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(0.2,-0.1,-0.3), 
+                      axis_angle<double>(0.4, vect<double,3>(0.0,0.0,1.0)).getQuaternion()), vect<double,3>(0.4,0.3,0.2))));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(-0.4,0.3,0.2), quaternion<double>()), 0.2)));
+    env_model->addShape(shared_ptr< geom::shape_3D >(new geom::capped_cylinder("pole", no_anchor,
+      pose_3D<double>(no_anchor, vect<double,3>(0.3,0.4,0.0), quaternion<double>()), 0.6, 0.08)));
+    
+    grid = shared_ptr< geom::grid_3D >(new geom::grid_3D("grid", no_anchor, pose_3D<double>(), 
+      vect<double,3>(1.6,1.6,1.6), vect<std::size_t,3>(32,32,32)));
+    field = shared_ptr< geom::proxy_distance_field_3D >(new geom::proxy_distance_field_3D("field", grid, 0.5));
+    field->build(*env_model);
+    
+    probe = shared_ptr< geom::sphere >(new geom::sphere("probe", no_anchor, pose_3D<double>(), 0.0));
+    shared_ptr< geom::proxy_query_model_3D > probe_model(new geom::proxy_query_model_3D("probe"));
+    probe_model->addShape(probe);
+    probe_pair = shared_ptr< geom::proxy_query_pair_3D >(new geom::proxy_query_pair_3D("probe_pair", probe_model, env_model));
+  };
+  
+  /* Computes the exact signed distance from a sphere at a point to the obstacles. */
+  double getExactDistance(const vect<double,3>& aPoint, double aRadius = 0.0) {
+    probe->setRadius(aRadius);
+    probe->setPose(pose_3D<double>(no_anchor, aPoint, quaternion<double>()));
+    shared_ptr< geom::proximity_finder_3D > closest = probe_pair->findMinimumDistance();
+    BOOST_REQUIRE( closest );
+    return closest->getLastResult().mDistance;
+  };
+  
+  static vect<double,3> getRandomPoint(double aHalfWidth) {
+    return vect<double,3>(aHalfWidth * (2.0 * std::rand() / double(RAND_MAX) - 1.0),
+                          aHalfWidth * (2.0 * std::rand() / double(RAND_MAX) - 1.0),
+                          aHalfWidth * (2.0 * std::rand() / double(RAND_MAX) - 1.0));
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( distance_field_inside_grid_test )
+{
+  distance_field_fixture f;
+  // the signed distance (truncated) changes no faster than the position, so the interpolation 
+  // between the nodes is within a cell diagonal of it.
+  const double cell_diag = std::sqrt(3.0) * 0.05;
+  std::size_t inside_count = 0;
+  for(std::size_t i = 0; i < 2000; ++i) {
+    vect<double,3> p = distance_field_fixture::getRandomPoint(0.8);
+    double exact = f.getExactDistance(p);
+    double trunc_exact = (exact < f.field->getMaxDistance() ? exact : f.field->getMaxDistance());
+    if(exact < 0.0)
+      ++inside_count;
+    BOOST_CHECK_SMALL( f.field->getDistance(p) - trunc_exact, cell_diag );
+    BOOST_CHECK_LE( f.field->getDistanceLowerBound(p), exact + 1e-9 );
+    BOOST_CHECK_GE( f.field->getDistanceLowerBound(p), trunc_exact - 2.0 * cell_diag );
+  };
+  BOOST_CHECK( inside_count > 0 );
+};
+
+
+BOOST_AUTO_TEST_CASE( distance_field_outside_grid_test )
+{
+  distance_field_fixture f;
+  for(std::size_t i = 0; i < 1000; ++i) {
+    vect<double,3> p = distance_field_fixture::getRandomPoint(2.0);
+    double exact = f.getExactDistance(p);
+    BOOST_CHECK_LE( f.field->getDistanceLowerBound(p), exact + 1e-9 );
+  };
+};
+
+
+BOOST_AUTO_TEST_CASE( distance_field_clearance_test )
+{
+  distance_field_fixture f;
+  std::size_t collision_count = 0;
+  for(std::size_t i = 0; i < 1000; ++i) {
+    vect<double,3> p = distance_field_fixture::getRandomPoint(1.2);
+    double r = 0.02 + 0.1 * std::rand() / double(RAND_MAX);
+    geom::sphere s("s", f.no_anchor, pose_3D<double>(f.no_anchor, p, quaternion<double>()), r);
+    double exact = f.getExactDistance(p, r);
+    BOOST_CHECK_LE( f.field->getClearance(s), exact + 1e-9 );
+    if(exact < 0.0)
+      ++collision_count;
+  };
+  BOOST_CHECK( collision_count > 0 );
+};
+
+
@@ -0,0 +1,322 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/proximity/proxy_query_model.hpp>
+
+#include <ReaK/geometry/shapes/sphere.hpp>
+#include <ReaK/geometry/shapes/box.hpp>
+#include <ReaK/geometry/shapes/capped_cylinder.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+
+#define BOOST_TEST_MODULE proxy_query_model
+#include <boost/test/unit_test.hpp>
+
+
+using namespace ReaK;
+
+static const double test_tolerance = 1e-6;
+
+
+/* A ball attached to a moving frame, and a thin wall (normal to x, 1cm thick) at the origin. */
+struct moving_ball_fixture {
+  shared_ptr< pose_3D<double> > no_anchor;
+  shared_ptr< pose_3D<double> > ball_frame;
+  shared_ptr< geom::proxy_query_model_3D > ball_model;
+  shared_ptr< geom::proxy_query_model_3D > wall_model;
+  shared_ptr< geom::proxy_query_pair_3D > ball_wall;
+  
+  moving_ball_fixture() : no_anchor() {
+    ball_frame = shared_ptr< pose_3D<double> >(new pose_3D<double>(no_anchor, vect<double,3>(-1.0,0.0,0.0), quaternion<double>()));
+    ball_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("ball"));
+    ball_model->addShape(shared_ptr< geom::shape_3D >(new geom::sphere("ball_geom", ball_frame, pose_3D<double>(), 0.1)));
+    wall_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("wall"));
+    wall_model->addShape(shared_ptr< geom::shape_3D >(new geom::box("wall_geom", no_anchor, pose_3D<double>(), 
+      vect<double,3>(0.01,2.0,2.0))));
+    ball_wall = shared_ptr< geom::proxy_query_pair_3D >(new geom::proxy_query_pair_3D("ball_wall", ball_model, wall_model));
+  };
+  
+  pose_3D<double> makePose(const vect<double,3>& aPosition, double aAngle = 0.0) const {
+    return pose_3D<double>(no_anchor, aPosition, axis_angle<double>(aAngle, vect<double,3>(0.0,0.0,1.0)).getQuaternion());
+  };
+};
+
+/* Moves the ball frame along a straight line, for the conservative advancement with a user-given motion bound. */
+struct ball_line_setter {
+  shared_ptr< pose_3D<double> > frame;
+  vect<double,3> start;
+  vect<double,3> end;
+  void operator()(double t) const { frame->Position = start + t * (end - start); };
+};
+
+
+BOOST_AUTO_TEST_CASE( first_contact_thin_wall_test )
+{
+  moving_ball_fixture f;
+  
+  // both ends of the motion are collision-free, the wall is crossed within this single step.
+  pose_3D<double> start = f.makePose(vect<double,3>(-1.0,0.0,0.0));
+  pose_3D<double> end = f.makePose(vect<double,3>(1.0,0.0,0.0));
+  *f.ball_frame = start;
+  BOOST_CHECK( f.ball_wall->findMinimumDistance()->getLastResult().mDistance > 0.5 );
+  *f.ball_frame = end;
+  BOOST_CHECK( f.ball_wall->findMinimumDistance()->getLastResult().mDistance > 0.5 );
+  
+  // the ball touches the wall when its center is at x = -0.105, that is, at t = 0.4475.
+  double t = f.ball_wall->findFirstContact(f.ball_frame, start, end);
+  BOOST_CHECK( t <= 0.4475 );
+  BOOST_CHECK( t > 0.4475 - 1e-3 );
+  
+  // the frame is restored to its pose prior to the query.
+  BOOST_CHECK( norm_2(f.ball_frame->Position - end.Position) < 1e-12 );
+  
+  // the same, in the other direction, and while rotating (the ball is at the frame's origin).
+  t = f.ball_wall->findFirstContact(f.ball_frame, f.makePose(vect<double,3>(1.0,0.5,0.0), 0.5), f.makePose(vect<double,3>(-1.0,-0.5,0.0), -1.0));
+  BOOST_CHECK( t <= 0.4475 );
+  BOOST_CHECK( t > 0.4475 - 1e-3 );
+  
+  // and with a user-given motion bound (the length of the motion).
+  ball_line_setter setter;
+  setter.frame = f.ball_frame;
+  setter.start = vect<double,3>(-1.0,0.3,0.2);
+  setter.end = vect<double,3>(1.0,0.3,0.2);
+  t = f.ball_wall->findFirstContact(setter, 2.0);
+  BOOST_CHECK( t <= 0.4475 );
+  BOOST_CHECK( t > 0.4475 - 1e-3 );
+};
+
+
+BOOST_AUTO_TEST_CASE( first_contact_miss_test )
+{
+  moving_ball_fixture f;
+  
+  // passing beside the wall (which spans y in [-1,1]).
+  double t = f.ball_wall->findFirstContact(f.ball_frame, f.makePose(vect<double,3>(-1.0,1.2,0.0)), f.makePose(vect<double,3>(1.0,1.2,0.0)));
+  BOOST_CHECK( t == std::numeric_limits<double>::infinity() );
+  
+  // stopping short of the wall.
+  t = f.ball_wall->findFirstContact(f.ball_frame, f.makePose(vect<double,3>(-1.0,0.0,0.0)), f.makePose(vect<double,3>(-0.2,0.0,0.0), 1.0));
+  BOOST_CHECK( t == std::numeric_limits<double>::infinity() );
+  
+  // moving away from the wall, while touching it at the start.
+  ball_line_setter setter;
+  setter.frame = f.ball_frame;
+  setter.start = vect<double,3>(0.105,0.0,0.0);
+  setter.end = vect<double,3>(1.0,0.0,0.0);
+  t = f.ball_wall->findFirstContact(setter, 0.895);
+  BOOST_CHECK( t == 0.0 );
+  setter.start = vect<double,3>(0.2,0.0,0.0);
+  t = f.ball_wall->findFirstContact(setter, 0.8);
+  BOOST_CHECK( t == std::numeric_limits<double>::infinity() );
+};
+
+
+
+static double random_number(double aLow, double aHigh) {
+  return aLow + (aHigh - aLow) * (std::rand() / double(RAND_MAX));
+};
+
+static vect<double,3> random_vector(double aLow, double aHigh) {
+  return vect<double,3>(random_number(aLow, aHigh), random_number(aLow, aHigh), random_number(aLow, aHigh));
+};
+
+static quaternion<double> random_rotation() {
+  vect<double,3> v = random_vector(-1.0, 1.0);
+  while(norm_2(v) < 0.1)
+    v = random_vector(-1.0, 1.0);
+  return axis_angle<double>(random_number(-M_PI, M_PI), unit(v)).getQuaternion();
+};
+
+static shared_ptr< geom::shape_3D > random_shape(const shared_ptr< pose_3D<double> >& aAnchor, double aSpread) {
+  pose_3D<double> p(shared_ptr< pose_3D<double> >(), random_vector(-aSpread, aSpread), random_rotation());
+  switch(std::rand() % 3) {
+    case 0:
+      return shared_ptr< geom::shape_3D >(new geom::sphere("ball", aAnchor, p, random_number(0.05, 0.3)));
+    case 1:
+      return shared_ptr< geom::shape_3D >(new geom::capped_cylinder("capsule", aAnchor, p, random_number(0.1, 0.6), random_number(0.03, 0.2)));
+    default:
+      return shared_ptr< geom::shape_3D >(new geom::box("crate", aAnchor, p, random_vector(0.05, 0.5)));
+  };
+};
+
+
+/* A random group of shapes (attached to a moving frame), among random shapes. */
+struct random_scene_fixture {
+  shared_ptr< pose_3D<double> > no_anchor;
+  shared_ptr< pose_3D<double> > group_frame;
+  shared_ptr< geom::proxy_query_model_3D > group_model;
+  shared_ptr< geom::proxy_query_model_3D > env_model;
+  
+  random_scene_fixture(std::size_t aGroupCount, std::size_t aEnvCount) : no_anchor() {
+    group_frame = shared_ptr< pose_3D<double> >(new pose_3D<double>(no_anchor, vect<double,3>(0.0,0.0,0.0), quaternion<double>()));
+    group_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("group"));
+    for(std::size_t i = 0; i < aGroupCount; ++i)
+      group_model->addShape(random_shape(group_frame, 0.5));
+    env_model = shared_ptr< geom::proxy_query_model_3D >(new geom::proxy_query_model_3D("environment"));
+    for(std::size_t j = 0; j < aEnvCount; ++j)
+      env_model->addShape(random_shape(no_anchor, 2.0));
+  };
+  
+  shared_ptr< geom::proxy_query_pair_3D > makePair() const {
+    return shared_ptr< geom::proxy_query_pair_3D >(new geom::proxy_query_pair_3D("group_env", group_model, env_model));
+  };
+  
+  void setRandomPose() {
+    group_frame->Position = random_vector(-1.5, 1.5);
+    group_frame->Quat = random_rotation();
+  };
+  
+  /* Moves the group by a small step, such that the temporal coherence is used. */
+  void moveStep(double aStep) {
+    group_frame->Position += random_vector(-aStep, aStep);
+    group_frame->Quat = group_frame->Quat * axis_angle<double>(aStep, vect<double,3>(0.0,0.0,1.0)).getQuaternion();
+  };
+  
+  /* Computes the minimum distance and the colliding records by evaluating every pair of shapes, 
+   * each with a new (not warm-started) proximity finder, in the order of the finders of a pair of the models. */
+  double getBruteForceResults(std::vector< geom::proximity_record_3D >& aCollisions) const {
+    double min_dist = std::numeric_limits<double>::infinity();
+    for(std::size_t i = 0; i < group_model->mShapeList.size(); ++i) {
+      shared_ptr< geom::proxy_query_model_3D > m1(new geom::proxy_query_model_3D("single_group"));
+      m1->addShape(group_model->mShapeList[i]);
+      for(std::size_t j = 0; j < env_model->mShapeList.size(); ++j) {
+        shared_ptr< geom::proxy_query_model_3D > m2(new geom::proxy_query_model_3D("single_env"));
+        m2->addShape(env_model->mShapeList[j]);
+        geom::proxy_query_pair_3D single_pair("single_pair", m1, m2);
+        shared_ptr< geom::proximity_finder_3D > tmp = single_pair.findMinimumDistance();
+        if(!tmp)
+          continue;
+        const geom::proximity_record_3D& rec = tmp->getLastResult();
+        if(rec.mDistance < min_dist)
+          min_dist = rec.mDistance;
+        if(rec.mDistance < 0.0)
+          aCollisions.push_back(rec);
+      };
+    };
+    return min_dist;
+  };
+};
+
+
+/* Checks that two queries (minimum distance and colliding records) give the same results. */
+static void check_same_results(double aDist1, const std::vector< geom::proximity_record_3D >& aRecords1, 
+                               double aDist2, const std::vector< geom::proximity_record_3D >& aRecords2) {
+  BOOST_CHECK_CLOSE_FRACTION( aDist1 + 10.0, aDist2 + 10.0, test_tolerance );
+  BOOST_REQUIRE_EQUAL( aRecords1.size(), aRecords2.size() );
+  for(std::size_t i = 0; i < aRecords1.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION( aRecords1[i].mDistance + 10.0, aRecords2[i].mDistance + 10.0, test_tolerance );
+    BOOST_CHECK( norm_2(aRecords1[i].mPoint1 - aRecords2[i].mPoint1) < 1e-4 );
+    BOOST_CHECK( norm_2(aRecords1[i].mPoint2 - aRecords2[i].mPoint2) < 1e-4 );
+  };
+};
+
+static double query_min_distance(const geom::proxy_query_pair_3D& aPair) {
+  shared_ptr< geom::proximity_finder_3D > tmp = aPair.findMinimumDistance();
+  if(!tmp)
+    return std::numeric_limits<double>::infinity();
+  return tmp->getLastResult().mDistance;
+};
+
+
+BOOST_AUTO_TEST_CASE( bvh_brute_force_test )
+{
+  std::srand(42);
+  std::size_t collision_count = 0;
+  for(std::size_t s = 0; s < 20; ++s) {
+    random_scene_fixture f(5, 15);
+    for(std::size_t c = 0; c < 10; ++c) {
+      f.setRandomPose();
+      std::vector< geom::proximity_record_3D > expected, records;
+      double expected_dist = f.getBruteForceResults(expected);
+      // new pairs, such that the iterative finders start from the same state as the brute-force ones.
+      double dist = query_min_distance(*f.makePair());
+      f.makePair()->gatherCollisionPoints(records);
+      check_same_results(expected_dist, expected, dist, records);
+      collision_count += records.size();
+    };
+  };
+  BOOST_CHECK( collision_count > 0 );
+};
+
+
+BOOST_AUTO_TEST_CASE( coherence_on_off_test )
+{
+  std::srand(43);
+  std::size_t collision_count = 0;
+  for(std::size_t s = 0; s < 10; ++s) {
+    random_scene_fixture f(5, 15);
+    shared_ptr< geom::proxy_query_pair_3D > coherent_pair = f.makePair();
+    shared_ptr< geom::proxy_query_pair_3D > fresh_pair = f.makePair();
+    f.setRandomPose();
+    for(std::size_t c = 0; c < 50; ++c) {
+      f.moveStep(0.02);
+      std::vector< geom::proximity_record_3D > coherent_records, fresh_records;
+      double coherent_dist = query_min_distance(*coherent_pair);
+      coherent_pair->gatherCollisionPoints(coherent_records);
+      fresh_pair->resetCoherenceCache();
+      double fresh_dist = query_min_distance(*fresh_pair);
+      fresh_pair->resetCoherenceCache();
+      fresh_pair->gatherCollisionPoints(fresh_records);
+      check_same_results(fresh_dist, fresh_records, coherent_dist, coherent_records);
+      collision_count += coherent_records.size();
+    };
+  };
+  BOOST_CHECK( collision_count > 0 );
+};
+
+
+BOOST_AUTO_TEST_CASE( parallel_serial_test )
+{
+  std::srand(44);
+  shared_ptr< thread_pool > pool(new thread_pool(4));
+  std::size_t collision_count = 0;
+  for(std::size_t s = 0; s < 10; ++s) {
+    random_scene_fixture f(6, 20);
+    shared_ptr< geom::proxy_query_pair_3D > serial_pair = f.makePair();
+    shared_ptr< geom::proxy_query_pair_3D > parallel_pair = f.makePair();
+    parallel_pair->setThreadPool(pool);
+    f.setRandomPose();
+    for(std::size_t c = 0; c < 30; ++c) {
+      // random jumps, and small steps that use the temporal coherence.
+      if(c % 10 == 0)
+        f.setRandomPose();
+      else
+        f.moveStep(0.02);
+      std::vector< geom::proximity_record_3D > serial_records, parallel_records;
+      double serial_dist = query_min_distance(*serial_pair);
+      serial_pair->gatherCollisionPoints(serial_records);
+      double parallel_dist = query_min_distance(*parallel_pair);
+      parallel_pair->gatherCollisionPoints(parallel_records);
+      check_same_results(serial_dist, serial_records, parallel_dist, parallel_records);
+      collision_count += serial_records.size();
+    };
+  };
+  BOOST_CHECK( collision_count > 0 );
+};
+
+
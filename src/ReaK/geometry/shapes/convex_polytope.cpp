@@ -0,0 +1,86 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/shapes/convex_polytope.hpp>
+
+namespace ReaK {
+
+namespace geom {
+
+
+void convex_polytope::updateBoundingRadius() {
+  mBoundingRadius = 0.0;
+  for(std::size_t i = 0; i < mVertices.size(); ++i) {
+    double r = norm_2(mVertices[i]);
+    if(r > mBoundingRadius)
+      mBoundingRadius = r;
+  };
+};
+
+double convex_polytope::getBoundingRadius() const { 
+  return mBoundingRadius;
+};
+
+vect<double,3> convex_polytope::getSupportPoint(const vect<double,3>& aDirection) const {
+  if(mVertices.empty())
+    return vect<double,3>(0.0,0.0,0.0);
+  std::size_t best_i = 0;
+  double best_d = mVertices[0] * aDirection;
+  for(std::size_t i = 1; i < mVertices.size(); ++i) {
+    double d = mVertices[i] * aDirection;
+    if(d > best_d) {
+      best_d = d;
+      best_i = i;
+    };
+  };
+  return mVertices[best_i];
+};
+
+
+convex_polytope::convex_polytope(const std::string& aName,
+                                 const shared_ptr< pose_3D<double> >& aAnchor,
+                                 const pose_3D<double>& aPose,
+                                 const std::vector< vect<double,3> >& aVertices) :
+                                 shape_3D(aName,aAnchor,aPose),
+                                 mVertices(aVertices), mBoundingRadius(0.0) { 
+  updateBoundingRadius();
+};
+    
+void RK_CALL convex_polytope::save(ReaK::serialization::oarchive& A, unsigned int) const {
+  shape_3D::save(A,shape_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_SAVE_WITH_NAME(mVertices);
+};
+
+void RK_CALL convex_polytope::load(ReaK::serialization::iarchive& A, unsigned int) {
+  shape_3D::load(A,shape_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_LOAD_WITH_NAME(mVertices);
+  updateBoundingRadius();
+};
+
+
+
+};
+
+
+};
+
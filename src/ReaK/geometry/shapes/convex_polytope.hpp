@@ -0,0 +1,124 @@
+/**
+ * \file convex_polytope.hpp
+ *
+ * This library declares a class to represent convex polytopes (convex hulls of a set of points).
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_CONVEX_POLYTOPE_HPP
+#define REAK_CONVEX_POLYTOPE_HPP
+
+#include "shape_3D.hpp"
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class represents a convex polytope, as the convex hull of a set of vertices (expressed relative 
+ * to the pose of the shape). The vertices do not need to be on the hull (interior points are harmless), 
+ * and the faces are not stored, since proximity queries only rely on the support mapping of the polytope.
+ */
+class convex_polytope : public shape_3D {
+  protected:
+    
+    std::vector< vect<double,3> > mVertices;
+    double mBoundingRadius;
+    
+    void updateBoundingRadius();
+    
+  public:
+    
+    /**
+     * This function returns the maximum radius of the shape (radius of the sphere that bounds the shape).
+     * \return The maximum radius of the shape.
+     */
+    virtual double getBoundingRadius() const;
+    
+    /**
+     * This function returns the vertices of the polytope.
+     * \return The vertices of the polytope.
+     */
+    const std::vector< vect<double,3> >& getVertices() const { return mVertices; };
+    /**
+     * This function sets the vertices of the polytope.
+     * \param aVertices The new vertices of the polytope.
+     */
+    void setVertices(const std::vector< vect<double,3> >& aVertices) { 
+      mVertices = aVertices; 
+      updateBoundingRadius();
+    };
+    
+    /**
+     * This function returns the vertex that is the farthest along a given direction (the support point).
+     * \param aDirection The direction, expressed relative to the pose of the polytope.
+     * \return The support point, expressed relative to the pose of the polytope.
+     */
+    vect<double,3> getSupportPoint(const vect<double,3>& aDirection) const;
+    
+    /**
+     * Default constructor.
+     * \param aName The name of the object.
+     * \param aAnchor The anchor object for the geometry.
+     * \param aPose The pose of the geometry (relative to the anchor).
+     * \param aVertices The vertices of the polytope.
+     */
+    convex_polytope(const std::string& aName = "",
+                    const shared_ptr< pose_3D<double> >& aAnchor = shared_ptr< pose_3D<double> >(),
+                    const pose_3D<double>& aPose = pose_3D<double>(),
+                    const std::vector< vect<double,3> >& aVertices = std::vector< vect<double,3> >());
+    
+    /**
+     * Default destructor.
+     */
+    virtual ~convex_polytope() { };
+    
+    
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+    
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+
+    RK_RTTI_MAKE_CONCRETE_1BASE(convex_polytope,0xC3100014,1,"convex_polytope",shape_3D)
+
+};
+
+
+};
+
+};
+
+#endif
+
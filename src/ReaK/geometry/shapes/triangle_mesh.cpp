@@ -0,0 +1,165 @@
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ReaK/geometry/shapes/triangle_mesh.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ReaK {
+
+namespace geom {
+
+
+const std::size_t triangle_mesh::npos;
+
+
+double triangle_mesh::getBoundingRadius() const { 
+  return mBoundingRadius;
+};
+
+
+namespace {
+
+struct mesh_centroid_axis_less {
+  std::size_t axis;
+  explicit mesh_centroid_axis_less(std::size_t aAxis) : axis(aAxis) { };
+  bool operator()(const std::pair< vect<double,3>, std::size_t >& lhs,
+                  const std::pair< vect<double,3>, std::size_t >& rhs) const {
+    return lhs.first[axis] < rhs.first[axis];
+  };
+};
+
+};
+
+
+std::size_t triangle_mesh::buildTree(std::vector< std::pair< vect<double,3>, std::size_t > >& aCentroids, std::size_t aFirst, std::size_t aLast) {
+  std::size_t cur = mTree.size();
+  mTree.push_back(bvh_node());
+  mTree[cur].second_child = npos;
+  mTree[cur].triangle = npos;
+  
+  if(aLast - aFirst == 1) {
+    std::size_t t = aCentroids[aFirst].second;
+    mTree[cur].triangle = t;
+    mTree[cur].lower = getTriangleVertex(t, 0);
+    mTree[cur].upper = getTriangleVertex(t, 0);
+    for(std::size_t c = 1; c < 3; ++c) {
+      for(std::size_t k = 0; k < 3; ++k) {
+        mTree[cur].lower[k] = std::min(mTree[cur].lower[k], getTriangleVertex(t, c)[k]);
+        mTree[cur].upper[k] = std::max(mTree[cur].upper[k], getTriangleVertex(t, c)[k]);
+      };
+    };
+    return cur;
+  };
+  
+  // split at the median of the centroids, along the axis on which they are most spread out.
+  vect<double,3> c_lo = aCentroids[aFirst].first;
+  vect<double,3> c_hi = aCentroids[aFirst].first;
+  for(std::size_t i = aFirst + 1; i < aLast; ++i) {
+    for(std::size_t k = 0; k < 3; ++k) {
+      c_lo[k] = std::min(c_lo[k], aCentroids[i].first[k]);
+      c_hi[k] = std::max(c_hi[k], aCentroids[i].first[k]);
+    };
+  };
+  std::size_t axis = 0;
+  for(std::size_t k = 1; k < 3; ++k)
+    if(c_hi[k] - c_lo[k] > c_hi[axis] - c_lo[axis])
+      axis = k;
+  
+  std::size_t mid = aFirst + (aLast - aFirst) / 2;
+  std::nth_element(aCentroids.begin() + aFirst, aCentroids.begin() + mid, aCentroids.begin() + aLast, mesh_centroid_axis_less(axis));
+  
+  buildTree(aCentroids, aFirst, mid);
+  std::size_t second = buildTree(aCentroids, mid, aLast);
+  mTree[cur].second_child = second;
+  for(std::size_t k = 0; k < 3; ++k) {
+    mTree[cur].lower[k] = std::min(mTree[cur + 1].lower[k], mTree[second].lower[k]);
+    mTree[cur].upper[k] = std::max(mTree[cur + 1].upper[k], mTree[second].upper[k]);
+  };
+  return cur;
+};
+
+void triangle_mesh::updateTree() {
+  mBoundingRadius = 0.0;
+  for(std::size_t i = 0; i < mVertices.size(); ++i) {
+    double r = norm_2(mVertices[i]);
+    if(r > mBoundingRadius)
+      mBoundingRadius = r;
+  };
+  
+  mTree.clear();
+  std::size_t tri_count = getTriangleCount();
+  if(tri_count == 0)
+    return;
+  std::vector< std::pair< vect<double,3>, std::size_t > > centroids;
+  centroids.reserve(tri_count);
+  for(std::size_t t = 0; t < tri_count; ++t)
+    centroids.push_back(std::make_pair((getTriangleVertex(t, 0) + getTriangleVertex(t, 1) + getTriangleVertex(t, 2)) * (1.0 / 3.0), t));
+  mTree.reserve(2 * tri_count - 1);
+  buildTree(centroids, 0, tri_count);
+};
+
+void triangle_mesh::setMesh(const std::vector< vect<double,3> >& aVertices, const std::vector< std::size_t >& aIndices) {
+  for(std::size_t i = 0; i < aIndices.size(); ++i)
+    if(aIndices[i] >= aVertices.size())
+      throw std::range_error("Triangle-mesh vertex index out of range!");
+  mVertices = aVertices;
+  mIndices = aIndices;
+  mIndices.resize(3 * (mIndices.size() / 3));
+  updateTree();
+};
+
+
+triangle_mesh::triangle_mesh(const std::string& aName,
+                             const shared_ptr< pose_3D<double> >& aAnchor,
+                             const pose_3D<double>& aPose,
+                             const std::vector< vect<double,3> >& aVertices,
+                             const std::vector< std::size_t >& aIndices) :
+                             shape_3D(aName,aAnchor,aPose),
+                             mVertices(), mIndices(), mTree(), mBoundingRadius(0.0) { 
+  setMesh(aVertices, aIndices);
+};
+    
+void RK_CALL triangle_mesh::save(ReaK::serialization::oarchive& A, unsigned int) const {
+  shape_3D::save(A,shape_3D::getStaticObjectType()->TypeVersion());
+  A & RK_SERIAL_SAVE_WITH_NAME(mVertices)
+    & RK_SERIAL_SAVE_WITH_NAME(mIndices);
+};
+
+void RK_CALL triangle_mesh::load(ReaK::serialization::iarchive& A, unsigned int) {
+  shape_3D::load(A,shape_3D::getStaticObjectType()->TypeVersion());
+  std::vector< vect<double,3> > vertices;
+  std::vector< std::size_t > indices;
+  A & RK_SERIAL_LOAD_WITH_ALIAS("mVertices",vertices)
+    & RK_SERIAL_LOAD_WITH_ALIAS("mIndices",indices);
+  setMesh(vertices, indices);
+};
+
+
+
+};
+
+
+};
+
@@ -0,0 +1,163 @@
+/**
+ * \file triangle_mesh.hpp
+ *
+ * This library declares a class to represent triangle meshes, along with a bounding-volume 
+ * hierarchy over their triangles.
+ *
+ * \author Mikael Persson, <mikael.s.persson@gmail.com>
+ * \date October 2026
+ */
+
+/*
+ *    Copyright 2026 Sven Mikael Persson
+ *
+ *    THIS SOFTWARE IS DISTRIBUTED UNDER THE TERMS OF THE GNU GENERAL PUBLIC LICENSE v3 (GPLv3).
+ *
+ *    This file is part of ReaK.
+ *
+ *    ReaK is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    ReaK is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with ReaK (as LICENSE in the root folder).  
+ *    If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAK_TRIANGLE_MESH_HPP
+#define REAK_TRIANGLE_MESH_HPP
+
+#include "shape_3D.hpp"
+
+#include <vector>
+
+/** Main namespace for ReaK */
+namespace ReaK {
+
+/** Main namespace for ReaK.Geometry */
+namespace geom {
+
+
+/**
+ * This class represents a triangle mesh (not necessarily convex, nor closed), as a list of vertices 
+ * (expressed relative to the pose of the shape) and a list of triangles (three vertex indices each). 
+ * The mesh is treated as a surface by proximity queries. An axis-aligned bounding-box hierarchy over 
+ * the triangles (in the frame of the mesh) is built whenever the mesh changes, such that proximity 
+ * queries only need to visit the triangles near the other shape.
+ */
+class triangle_mesh : public shape_3D {
+  public:
+    
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+    
+    /** This POD type is a node of the bounding-box hierarchy, stored in pre-order (first child follows its parent). */
+    struct bvh_node {
+      vect<double,3> lower;
+      vect<double,3> upper;
+      std::size_t second_child;  ///< Index of the second child, or npos for a leaf.
+      std::size_t triangle;      ///< Index of the triangle, or npos for a branch.
+    };
+    
+  protected:
+    
+    std::vector< vect<double,3> > mVertices;
+    std::vector< std::size_t > mIndices;
+    std::vector< bvh_node > mTree;
+    double mBoundingRadius;
+    
+    std::size_t buildTree(std::vector< std::pair< vect<double,3>, std::size_t > >& aCentroids, std::size_t aFirst, std::size_t aLast);
+    void updateTree();
+    
+  public:
+    
+    /**
+     * This function returns the maximum radius of the shape (radius of the sphere that bounds the shape).
+     * \return The maximum radius of the shape.
+     */
+    virtual double getBoundingRadius() const;
+    
+    /**
+     * This function returns the vertices of the mesh.
+     * \return The vertices of the mesh.
+     */
+    const std::vector< vect<double,3> >& getVertices() const { return mVertices; };
+    
+    /**
+     * This function returns the vertex indices of the triangles of the mesh (three per triangle).
+     * \return The vertex indices of the triangles.
+     */
+    const std::vector< std::size_t >& getIndices() const { return mIndices; };
+    
+    /**
+     * This function returns the number of triangles of the mesh.
+     */
+    std::size_t getTriangleCount() const { return mIndices.size() / 3; };
+    
+    /**
+     * This function returns a vertex of a triangle of the mesh.
+     * \param aTriangle The index of the triangle.
+     * \param aCorner The corner of the triangle (0, 1 or 2).
+     * \return The vertex, expressed relative to the pose of the mesh.
+     */
+    const vect<double,3>& getTriangleVertex(std::size_t aTriangle, std::size_t aCorner) const { 
+      return mVertices[mIndices[3 * aTriangle + aCorner]]; 
+    };
+    
+    /**
+     * This function sets the vertices and triangles of the mesh.
+     * \param aVertices The new vertices of the mesh.
+     * \param aIndices The new vertex indices of the triangles (three per triangle).
+     * \throw std::range_error If a vertex index is out of range.
+     */
+    void setMesh(const std::vector< vect<double,3> >& aVertices, const std::vector< std::size_t >& aIndices);
+    
+    /**
+     * This function returns the bounding-box hierarchy of the triangles (the root is at index 0).
+     */
+    const std::vector< bvh_node >& getTree() const { return mTree; };
+    
+    /**
+     * Default constructor.
+     * \param aName The name of the object.
+     * \param aAnchor The anchor object for the geometry.
+     * \param aPose The pose of the geometry (relative to the anchor).
+     * \param aVertices The vertices of the mesh.
+     * \param aIndices The vertex indices of the triangles (three per triangle).
+     */
+    triangle_mesh(const std::string& aName = "",
+                  const shared_ptr< pose_3D<double> >& aAnchor = shared_ptr< pose_3D<double> >(),
+                  const pose_3D<double>& aPose = pose_3D<double>(),
+                  const std::vector< vect<double,3> >& aVertices = std::vector< vect<double,3> >(),
+                  const std::vector< std::size_t >& aIndices = std::vector< std::size_t >());
+    
+    /**
+     * Default destructor.
+     */
+    virtual ~triangle_mesh() { };
+    
+    
+/*******************************************************************************
+                   ReaK's RTTI and Serialization interfaces
+*******************************************************************************/
+    
+    virtual void RK_CALL save(ReaK::serialization::oarchive& A, unsigned int) const;
+
+    virtual void RK_CALL load(ReaK::serialization::iarchive& A, unsigned int);
+
+    RK_RTTI_MAKE_CONCRETE_1BASE(triangle_mesh,0xC3100015,1,"triangle_mesh",shape_3D)
+
+};
+
+
+};
+
+};
+
+#endif
+